@@ -19,6 +19,22 @@
 #include <limits>
 #include <algorithm>
 
+// SIMD versions of the swap_XX_array loops, unless
+// ACE_DISABLE_CDR_SIMD_SWAP is defined.  On x86 the best of SSE2,
+// SSSE3 and AVX2 that the CPU supports is picked at run time, NEON is
+// used whenever the compiler targets it.
+#if !defined (ACE_DISABLE_CDR_SIMD_SWAP)
+# if (defined (__x86_64__) || defined (__i386__)) && defined (__GNUC__)
+#   define ACE_CDR_SIMD_SWAP
+#   define ACE_CDR_SIMD_SWAP_X86
+#   include <immintrin.h>
+# elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+#   define ACE_CDR_SIMD_SWAP
+#   define ACE_CDR_SIMD_SWAP_NEON
+#   include <arm_neon.h>
+# endif
+#endif /* ACE_DISABLE_CDR_SIMD_SWAP */
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 #if defined (NONNATIVE_LONGDOUBLE)
@@ -26,12 +42,184 @@ static constexpr ACE_INT16 max_eleven_bit = 0x3ff;
 static constexpr ACE_INT16 max_fifteen_bit = 0x3fff;
 #endif /* NONNATIVE_LONGDOUBLE */
 
+#if defined (ACE_CDR_SIMD_SWAP)
+namespace
+{
+  // A 16 byte vector holds whole elements of every size, so a byte
+  // shuffle within the vector swaps all of them at once.  The kernels
+  // are instantiated for K = 0..3, elements of 2 << K bytes, and return
+  // the number of bytes they swapped: <nbytes> rounded down to whole
+  // vectors.  The scalar loops do the rest.
+  typedef size_t (*Swap_Kernel) (char const *orig, char *target, size_t nbytes);
+
+  // Below this many bytes the scalar loops are as fast.
+  size_t const simd_swap_min = 64;
+
+#if defined (ACE_CDR_SIMD_SWAP_X86)
+  // Source byte of each byte of a vector for pshufb.
+  unsigned char const swap_masks[4][16] =
+  {
+    { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+    { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+    { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },
+    { 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }
+  };
+
+  // SSE2 has no byte shuffle: reorder the 16 bit words of each element
+  // first, then swap the bytes of every word.
+  template <int K> __attribute__ ((target ("sse2"))) size_t
+  swap_sse2 (char const *orig, char *target, size_t nbytes)
+  {
+    size_t const done = nbytes & ~static_cast<size_t> (15);
+    for (size_t i = 0; i < done; i += 16)
+      {
+        __m128i v =
+          _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig + i));
+        if (K == 1)
+          {
+            v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+            v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+          }
+        else if (K >= 2)
+          {
+            v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+            v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+            if (K == 3)
+              v = _mm_shuffle_epi32 (v, _MM_SHUFFLE (1, 0, 3, 2));
+          }
+        v = _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+        _mm_storeu_si128 (reinterpret_cast<__m128i *> (target + i), v);
+      }
+    return done;
+  }
+
+  template <int K> __attribute__ ((target ("ssse3"))) size_t
+  swap_ssse3 (char const *orig, char *target, size_t nbytes)
+  {
+    __m128i const mask =
+      _mm_loadu_si128 (reinterpret_cast<__m128i const *> (swap_masks[K]));
+    size_t const done = nbytes & ~static_cast<size_t> (15);
+    for (size_t i = 0; i < done; i += 16)
+      {
+        __m128i const v =
+          _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig + i));
+        _mm_storeu_si128 (reinterpret_cast<__m128i *> (target + i),
+                          _mm_shuffle_epi8 (v, mask));
+      }
+    return done;
+  }
+
+  // vpshufb shuffles within each 16 byte half, which is all we need.
+  template <int K> __attribute__ ((target ("avx2"))) size_t
+  swap_avx2 (char const *orig, char *target, size_t nbytes)
+  {
+    __m128i const mask =
+      _mm_loadu_si128 (reinterpret_cast<__m128i const *> (swap_masks[K]));
+    __m256i const mask2 = _mm256_broadcastsi128_si256 (mask);
+    size_t const wide = nbytes & ~static_cast<size_t> (31);
+    size_t i = 0;
+    for (; i < wide; i += 32)
+      {
+        __m256i const v =
+          _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (orig + i));
+        _mm256_storeu_si256 (reinterpret_cast<__m256i *> (target + i),
+                             _mm256_shuffle_epi8 (v, mask2));
+      }
+    if (nbytes - i >= 16)
+      {
+        __m128i const v =
+          _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig + i));
+        _mm_storeu_si128 (reinterpret_cast<__m128i *> (target + i),
+                          _mm_shuffle_epi8 (v, mask));
+        i += 16;
+      }
+    return i;
+  }
+
+  Swap_Kernel const sse2_kernels[4] =
+    { swap_sse2<0>, swap_sse2<1>, swap_sse2<2>, swap_sse2<3> };
+  Swap_Kernel const ssse3_kernels[4] =
+    { swap_ssse3<0>, swap_ssse3<1>, swap_ssse3<2>, swap_ssse3<3> };
+  Swap_Kernel const avx2_kernels[4] =
+    { swap_avx2<0>, swap_avx2<1>, swap_avx2<2>, swap_avx2<3> };
+
+  Swap_Kernel const *
+  select_swap_kernels ()
+  {
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx2"))
+      return avx2_kernels;
+    if (__builtin_cpu_supports ("ssse3"))
+      return ssse3_kernels;
+    if (__builtin_cpu_supports ("sse2"))
+      return sse2_kernels;
+    return nullptr;
+  }
+#else /* ACE_CDR_SIMD_SWAP_NEON */
+  template <int K> size_t
+  swap_neon (char const *orig, char *target, size_t nbytes)
+  {
+    size_t const done = nbytes & ~static_cast<size_t> (15);
+    for (size_t i = 0; i < done; i += 16)
+      {
+        uint8x16_t v = vld1q_u8 (reinterpret_cast<uint8_t const *> (orig + i));
+        if (K == 0)
+          v = vrev16q_u8 (v);
+        else if (K == 1)
+          v = vrev32q_u8 (v);
+        else
+          {
+            v = vrev64q_u8 (v);
+            if (K == 3)
+              v = vextq_u8 (v, v, 8);
+          }
+        vst1q_u8 (reinterpret_cast<uint8_t *> (target + i), v);
+      }
+    return done;
+  }
+
+  Swap_Kernel const neon_kernels[4] =
+    { swap_neon<0>, swap_neon<1>, swap_neon<2>, swap_neon<3> };
+
+  Swap_Kernel const *
+  select_swap_kernels ()
+  {
+    return neon_kernels;
+  }
+#endif /* ACE_CDR_SIMD_SWAP_X86 */
+
+  /// Swap the leading whole vectors of <nbytes> bytes of elements of
+  /// 2 << K bytes, return the number of bytes done.
+  inline size_t
+  simd_swap_array (int k, char const *orig, char *target, size_t nbytes)
+  {
+    if (nbytes < simd_swap_min)
+      return 0;
+
+    static Swap_Kernel const * const kernels = select_swap_kernels ();
+    return kernels == nullptr ? 0 : kernels[k] (orig, target, nbytes);
+  }
+}
+#endif /* ACE_CDR_SIMD_SWAP */
+
 // See comments in CDR_Base.inl about optimization cases for swap_XX_array.
 void
 ACE_CDR::swap_2_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_CDR_SIMD_SWAP)
+  size_t const done = simd_swap_array (0, orig, target, 2 * n);
+  if (done != 0)
+    {
+      orig += done;
+      target += done;
+      n -= done / 2;
+      if (n == 0)
+        return;
+    }
+#endif /* ACE_CDR_SIMD_SWAP */
+
   // We pretend that AMD64/GNU G++ systems have a Pentium CPU to
   // take advantage of the inline assembly implementation.
 
@@ -255,6 +443,18 @@ ACE_CDR::swap_4_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT (n > 0); The caller checks that n > 0
 
+#if defined (ACE_CDR_SIMD_SWAP)
+  size_t const done = simd_swap_array (1, orig, target, 4 * n);
+  if (done != 0)
+    {
+      orig += done;
+      target += done;
+      n -= done / 4;
+      if (n == 0)
+        return;
+    }
+#endif /* ACE_CDR_SIMD_SWAP */
+
 #if ACE_SIZEOF_LONG == 8
   // Later, we read from *orig in 64 bit chunks,
   // so make sure we don't generate unaligned readings.
@@ -453,6 +653,18 @@ ACE_CDR::swap_8_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_CDR_SIMD_SWAP)
+  size_t const done = simd_swap_array (2, orig, target, 8 * n);
+  if (done != 0)
+    {
+      orig += done;
+      target += done;
+      n -= done / 8;
+      if (n == 0)
+        return;
+    }
+#endif /* ACE_CDR_SIMD_SWAP */
+
   char const * const end = orig + 8*n;
   while (orig < end)
     {
@@ -467,6 +679,18 @@ ACE_CDR::swap_16_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_CDR_SIMD_SWAP)
+  size_t const done = simd_swap_array (3, orig, target, 16 * n);
+  if (done != 0)
+    {
+      orig += done;
+      target += done;
+      n -= done / 16;
+      if (n == 0)
+        return;
+    }
+#endif /* ACE_CDR_SIMD_SWAP */
+
   char const * const end = orig + 16*n;
   while (orig < end)
     {
@@ -185,6 +185,10 @@ ACE_OutputCDR::grow_and_adjust (size_t size,
       size_t cursize = this->current_->size ();
       if (this->current_->cont () != 0)
         cursize = this->current_->cont ()->size ();
+      else if (!this->current_is_writable_)
+        // The current block refers to data appended without a copy,
+        // its size says nothing about what is still to be written.
+        cursize = ACE_CDR::DEFAULT_BUFSIZE;
       size_t minsize = size;
 
 #if !defined (ACE_LACKS_CDR_ALIGNMENT)
@@ -667,6 +671,106 @@ ACE_OutputCDR::write_array (const void *x,
 }
 
 
+ACE_CDR::Boolean
+ACE_OutputCDR::write_array_external (
+  const void *x,
+  size_t size,
+  size_t align,
+  ACE_CDR::ULong length,
+  ACE_External_Data_Block::Release_Function release,
+  void *arg)
+{
+  size_t const nbytes = size * length;
+  char const *data = static_cast<char const *> (x);
+
+  bool copy = length == 0 || !this->good_bit_;
+#if defined (ACE_ENABLE_SWAP_ON_WRITE)
+  copy = copy || (this->do_byte_swap_ && size != 1);
+#endif /* ACE_ENABLE_SWAP_ON_WRITE */
+
+  if (copy)
+    {
+      ACE_CDR::Boolean const result =
+        this->write_array (x, size, align, length);
+      if (release != 0)
+        (*release) (data, nbytes, arg);
+      return result;
+    }
+
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  // Pad the stream up to the alignment of the elements; the block of
+  // the buffer starts right after it.
+  if (ACE_align_binary (this->current_alignment_, align)
+      != this->current_alignment_)
+    {
+      char *buf = 0;
+      if (this->adjust (0, align, buf) != 0)
+        {
+          if (release != 0)
+            (*release) (data, nbytes, arg);
+          return (this->good_bit_ = false);
+        }
+    }
+#else
+  ACE_UNUSED_ARG (align);
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  ACE_Message_Block *cont = 0;
+  if (release == 0)
+    {
+      ACE_NEW_NORETURN (cont,
+                        ACE_Message_Block (data, nbytes));
+      if (cont != 0 && cont->data_block () == 0)
+        {
+          cont->release ();
+          cont = 0;
+        }
+    }
+  else
+    {
+      ACE_Allocator *allocator = ACE_Allocator::instance ();
+      ACE_Data_Block *db = 0;
+      ACE_NEW_MALLOC_NORETURN (db,
+                               static_cast<ACE_Data_Block *> (
+                                 allocator->malloc (sizeof (ACE_External_Data_Block))),
+                               ACE_External_Data_Block (
+                                 data,
+                                 nbytes,
+                                 release,
+                                 arg,
+                                 this->current_->data_block ()->locking_strategy (),
+                                 allocator));
+      if (db == 0)
+        {
+          (*release) (data, nbytes, arg);
+          return (this->good_bit_ = false);
+        }
+
+      ACE_NEW_NORETURN (cont,
+                        ACE_Message_Block (db));
+      if (cont == 0)
+        db->release ();
+    }
+
+  if (cont == 0)
+    return (this->good_bit_ = false);
+
+  cont->wr_ptr (nbytes);
+
+  // Keep the blocks after the current one, the next write may reuse
+  // them.
+  cont->cont (this->current_->cont ());
+  this->current_->cont (cont);
+  this->current_ = cont;
+  this->current_is_writable_ = false;
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+  this->current_alignment_ =
+    (this->current_alignment_ + nbytes) % ACE_CDR::MAX_ALIGNMENT;
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+
+  return true;
+}
+
 ACE_CDR::Boolean
 ACE_OutputCDR::write_boolean_array (const ACE_CDR::Boolean* x,
                                     ACE_CDR::ULong length)
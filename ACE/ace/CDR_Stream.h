@@ -326,6 +326,30 @@ public:
   /// Write an octet array contained inside a MB, this can be optimized
   /// to minimize copies.
   ACE_CDR::Boolean write_octet_array_mb (const ACE_Message_Block* mb);
+
+  /**
+   * Append @a length elements of @a size bytes at @a x, aligned to
+   * @a align, without copying them: the stream gets a message block
+   * that refers to the buffer and the next write starts a new block.
+   * The buffer must not change while the stream, or any message block
+   * duplicated from it, uses it.
+   *
+   * If @a release is 0 the buffer is only borrowed and must stay
+   * valid as long as the stream uses it; ACE_Message_Block::clone()
+   * and write_octet_array_mb() copy such blocks.  Otherwise the
+   * stream takes over the buffer, see ACE_External_Data_Block, and
+   * @a release is called with @a arg once the last message block
+   * referring to it is released.  That also happens before returning
+   * if the data had to be copied after all (byte swapping, an empty
+   * array) or the stream failed.
+   */
+  ACE_CDR::Boolean write_array_external (
+    const void *x,
+    size_t size,
+    size_t align,
+    ACE_CDR::ULong length,
+    ACE_External_Data_Block::Release_Function release = 0,
+    void *arg = 0);
   //@}
 
   /**
@@ -324,6 +324,12 @@
 #   define ACE_DEFAULT_TIMER_WHEEL_RESOLUTION 100
 # endif /* ACE_DEFAULT_TIMER_WHEEL_RESOLUTION */
 
+// Default length of a tick of the ACE Timer Hierarchical Wheel, in
+// microseconds.
+# if !defined (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK)
+#   define ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK 1000
+# endif /* ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK */
+
 // Default size for ACE Timer Hash table
 # if !defined (ACE_DEFAULT_TIMER_HASH_TABLE_SIZE)
 #   define ACE_DEFAULT_TIMER_HASH_TABLE_SIZE 1024
@@ -393,6 +399,42 @@
 #define ACE_MAX_UDP_PACKET_SIZE 65507
 #endif
 
+// Largest chunk, in bytes, that ACE_Thread_Caching_Allocator keeps in
+// its per-thread caches; larger requests go to the backing allocator.
+#if !defined (ACE_DEFAULT_THREAD_CACHE_MAX_SIZE)
+#  define ACE_DEFAULT_THREAD_CACHE_MAX_SIZE 131072
+#endif /* ACE_DEFAULT_THREAD_CACHE_MAX_SIZE */
+
+// Number of chunks a thread moves between its cache and the shared
+// depot of ACE_Thread_Caching_Allocator at once.
+#if !defined (ACE_DEFAULT_THREAD_CACHE_MAGAZINE_SIZE)
+#  define ACE_DEFAULT_THREAD_CACHE_MAGAZINE_SIZE 32
+#endif /* ACE_DEFAULT_THREAD_CACHE_MAGAZINE_SIZE */
+
+// Upper bound on the bytes in one magazine of large chunks.
+#if !defined (ACE_DEFAULT_THREAD_CACHE_MAGAZINE_BYTES)
+#  define ACE_DEFAULT_THREAD_CACHE_MAGAZINE_BYTES 262144
+#endif /* ACE_DEFAULT_THREAD_CACHE_MAGAZINE_BYTES */
+
+// Number of full magazines per chunk size the shared depot of
+// ACE_Thread_Caching_Allocator keeps before it releases memory to the
+// backing allocator.
+#if !defined (ACE_DEFAULT_THREAD_CACHE_DEPOT_SIZE)
+#  define ACE_DEFAULT_THREAD_CACHE_DEPOT_SIZE 16
+#endif /* ACE_DEFAULT_THREAD_CACHE_DEPOT_SIZE */
+
+// Number of log records ACE_Log_Msg_Async can hold before its overflow
+// policy applies; rounded up to a power of two.
+#if !defined (ACE_DEFAULT_LOG_MSG_ASYNC_CAPACITY)
+#  define ACE_DEFAULT_LOG_MSG_ASYNC_CAPACITY 4096
+#endif /* ACE_DEFAULT_LOG_MSG_ASYNC_CAPACITY */
+
+// Most log records the writer thread of ACE_Log_Msg_Async writes with
+// a single writev() call.
+#if !defined (ACE_DEFAULT_LOG_MSG_ASYNC_BATCH)
+#  define ACE_DEFAULT_LOG_MSG_ASYNC_BATCH 64
+#endif /* ACE_DEFAULT_LOG_MSG_ASYNC_BATCH */
+
 /**
  * @name Default values to control CDR classes memory allocation strategies
  */
@@ -661,6 +661,31 @@ ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (size_t size,
                 ACE_TEXT ("failed inside ACE_Dev_Poll_Reactor::CTOR")));
 }
 
+ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (int mask_signals,
+                                            int s_queue,
+                                            bool)
+  : initialized_ (false)
+  , poll_fd_ (ACE_INVALID_HANDLE)
+#if defined (ACE_HAS_DEV_POLL)
+  , dp_fds_ (0)
+  , start_pfds_ (0)
+  , end_pfds_ (0)
+#endif  /* ACE_HAS_DEV_POLL */
+  , token_ (*this, s_queue)
+  , lock_adapter_ (token_)
+  , deactivated_ (0)
+  , timer_queue_ (0)
+  , delete_timer_queue_ (false)
+  , signal_handler_ (0)
+  , delete_signal_handler_ (false)
+  , notify_handler_ (0)
+  , delete_notify_handler_ (false)
+  , mask_signals_ (mask_signals)
+  , restart_ (0)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor");
+}
+
 ACE_Dev_Poll_Reactor::~ACE_Dev_Poll_Reactor ()
 {
   ACE_TRACE ("ACE_Dev_Poll_Reactor::~ACE_Dev_Poll_Reactor");
@@ -738,8 +763,7 @@ ACE_Dev_Poll_Reactor::open (size_t size,
 #if defined (ACE_HAS_EVENT_POLL)
 
   // Initialize epoll:
-  this->poll_fd_ = ::epoll_create (size);
-  if (this->poll_fd_ == -1)
+  if (result != -1 && this->open_poll_i (size) == -1)
     result = -1;
 
 #else
@@ -830,18 +854,20 @@ ACE_Dev_Poll_Reactor::close ()
 
   int result = 0;
 
-  if (this->poll_fd_ != ACE_INVALID_HANDLE)
-    {
-      result = ACE_OS::close (this->poll_fd_);
-    }
-
 #if defined (ACE_HAS_EVENT_POLL)
 
+  result = this->close_poll_i ();
+
   ACE_OS::memset (&this->event_, 0, sizeof (this->event_));
   this->event_.data.fd = ACE_INVALID_HANDLE;
 
 #else
 
+  if (this->poll_fd_ != ACE_INVALID_HANDLE)
+    {
+      result = ACE_OS::close (this->poll_fd_);
+    }
+
   delete [] this->dp_fds_;
   this->dp_fds_ = 0;
   this->start_pfds_ = 0;
@@ -887,6 +913,57 @@ ACE_Dev_Poll_Reactor::close ()
   return result;
 }
 
+#if defined (ACE_HAS_EVENT_POLL)
+int
+ACE_Dev_Poll_Reactor::open_poll_i (size_t size)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::open_poll_i");
+
+  this->poll_fd_ = ::epoll_create (size);
+  return this->poll_fd_ == ACE_INVALID_HANDLE ? -1 : 0;
+}
+
+int
+ACE_Dev_Poll_Reactor::close_poll_i ()
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::close_poll_i");
+
+  int result = 0;
+
+  if (this->poll_fd_ != ACE_INVALID_HANDLE)
+    {
+      result = ACE_OS::close (this->poll_fd_);
+      this->poll_fd_ = ACE_INVALID_HANDLE;
+    }
+
+  return result;
+}
+
+int
+ACE_Dev_Poll_Reactor::control_poll_i (int op,
+                                      ACE_HANDLE handle,
+                                      __uint32_t events)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::control_poll_i");
+
+  struct epoll_event epev;
+  ACE_OS::memset (&epev, 0, sizeof (epev));
+
+  epev.events  = events;
+  epev.data.fd = handle;
+
+  return ::epoll_ctl (this->poll_fd_, op, handle, &epev);
+}
+
+int
+ACE_Dev_Poll_Reactor::wait_poll_i (int timeout)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::wait_poll_i");
+
+  return ::epoll_wait (this->poll_fd_, &this->event_, 1, timeout);
+}
+#endif  /* ACE_HAS_EVENT_POLL */
+
 int
 ACE_Dev_Poll_Reactor::work_pending (const ACE_Time_Value & max_wait_time)
 {
@@ -946,10 +1023,7 @@ ACE_Dev_Poll_Reactor::work_pending_i (ACE_Time_Value * max_wait_time)
 #if defined (ACE_HAS_EVENT_POLL)
 
   // Wait for an event.
-  int const nfds = ::epoll_wait (this->poll_fd_,
-                                 &this->event_,
-                                 1,
-                                 static_cast<int> (timeout));
+  int const nfds = this->wait_poll_i (static_cast<int> (timeout));
 
 #else
 
@@ -1443,19 +1517,14 @@ ACE_Dev_Poll_Reactor::register_handler_i (ACE_HANDLE handle,
 
      Event_Tuple *info = this->handler_rep_.find (handle);
 
-     struct epoll_event epev;
-     ACE_OS::memset (&epev, 0, sizeof (epev));
-     static const int op = EPOLL_CTL_ADD;
-
-     epev.data.fd = handle;
-     epev.events  = this->reactor_mask_to_poll_event (mask);
+     __uint32_t events = this->reactor_mask_to_poll_event (mask);
      // All but the notify handler get registered with oneshot to facilitate
      // auto suspend before the upcall. See dispatch_io_event for more
      // information.
      if (event_handler != this->notify_handler_)
-       epev.events |= EPOLLONESHOT;
+       events |= EPOLLONESHOT;
 
-     if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+     if (this->control_poll_i (EPOLL_CTL_ADD, handle, events) == -1)
        {
          ACELIB_ERROR ((LM_ERROR, ACE_TEXT("%p\n"), ACE_TEXT("epoll_ctl")));
          (void) this->handler_rep_.unbind (handle);
@@ -1783,14 +1852,7 @@ ACE_Dev_Poll_Reactor::suspend_handler_i (ACE_HANDLE handle)
 
 #if defined (ACE_HAS_EVENT_POLL)
 
-  struct epoll_event epev;
-  ACE_OS::memset (&epev, 0, sizeof (epev));
-  static const int op = EPOLL_CTL_DEL;
-
-  epev.events  = 0;
-  epev.data.fd = handle;
-
-  if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+  if (this->control_poll_i (EPOLL_CTL_DEL, handle, 0) == -1)
     return -1;
   info->controlled = false;
 #else
@@ -1900,15 +1962,13 @@ ACE_Dev_Poll_Reactor::resume_handler_i (ACE_HANDLE handle)
 
 #if defined (ACE_HAS_EVENT_POLL)
 
-  struct epoll_event epev;
-  ACE_OS::memset (&epev, 0, sizeof (epev));
-  int op = EPOLL_CTL_ADD;
-  if (info->controlled)
-    op = EPOLL_CTL_MOD;
-  epev.events  = this->reactor_mask_to_poll_event (mask) | EPOLLONESHOT;
-  epev.data.fd = handle;
+  int const op = info->controlled ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+  __uint32_t events = this->reactor_mask_to_poll_event (mask);
+  // As in register_handler_i, the notify handler is never oneshot.
+  if (info->event_handler != this->notify_handler_)
+    events |= EPOLLONESHOT;
 
-  if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+  if (this->control_poll_i (op, handle, events) == -1)
     return -1;
   info->controlled = true;
 
@@ -2356,32 +2416,29 @@ ACE_Dev_Poll_Reactor::mask_ops_i (ACE_HANDLE handle,
         return -1;
 #elif defined (ACE_HAS_EVENT_POLL)
 
-      struct epoll_event epev;
-      ACE_OS::memset (&epev, 0, sizeof (epev));
       int op;
+      __uint32_t poll_events;
 
       // ACE_Event_Handler::NULL_MASK ???
       if (new_mask == 0)
         {
           op          = EPOLL_CTL_DEL;
-          epev.events = 0;
+          poll_events = 0;
         }
       else
         {
           op          = EPOLL_CTL_MOD;
-          epev.events = events | EPOLLONESHOT;
+          poll_events = events | EPOLLONESHOT;
         }
 
-      epev.data.fd = handle;
-
-      if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
+      if (this->control_poll_i (op, handle, poll_events) == -1)
         {
           // If a handle is closed, epoll removes it from the poll set
           // automatically - we may not know about it yet. If that's the
           // case, a mod operation will fail with ENOENT. Retry it as
           // an add. If it's any other failure, just fail outright.
           if (op != EPOLL_CTL_MOD || errno != ENOENT ||
-              ::epoll_ctl (this->poll_fd_, EPOLL_CTL_ADD, handle, &epev) == -1)
+              this->control_poll_i (EPOLL_CTL_ADD, handle, poll_events) == -1)
             return -1;
         }
       info->controlled = (op != EPOLL_CTL_DEL);
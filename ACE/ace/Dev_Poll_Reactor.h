@@ -908,6 +908,45 @@ public:
 protected:
   class Token_Guard;
 
+  /// Initialize the reactor's members without opening it.
+  /**
+   * Derived reactors that override the event demultiplexer hooks
+   * below must use this constructor and call open() from their own
+   * constructor, since the hooks are not virtually dispatched while
+   * the base class is being constructed.
+   */
+  ACE_Dev_Poll_Reactor (int mask_signals, int s_queue, bool);
+
+#if defined (ACE_HAS_EVENT_POLL)
+  /**
+   * @name Event demultiplexer hooks
+   *
+   * All interaction with the kernel event demultiplexer goes through
+   * these methods.  The default implementations use @c sys_epoll; a
+   * derived reactor may substitute another mechanism while reusing
+   * the handler repository, token and dispatching logic.
+   */
+  //@{
+  /// Create the demultiplexer and store its handle in @c poll_fd_.
+  virtual int open_poll_i (size_t size);
+
+  /// Release the demultiplexer referred to by @c poll_fd_.
+  virtual int close_poll_i ();
+
+  /// Add (@c EPOLL_CTL_ADD), modify (@c EPOLL_CTL_MOD) or remove
+  /// (@c EPOLL_CTL_DEL) interest in @a events for @a handle.
+  virtual int control_poll_i (int op, ACE_HANDLE handle, __uint32_t events);
+
+  /// Wait up to @a timeout milliseconds (-1 means forever) for a
+  /// single event and store it in @c event_.
+  /**
+   * @return The number of events retrieved, 0 on timeout, or -1 on
+   *         error.
+   */
+  virtual int wait_poll_i (int timeout);
+  //@}
+#endif  /* ACE_HAS_EVENT_POLL */
+
   /// Non-locking version of wait_pending().
   /**
    * Returns non-zero if there are I/O events "ready" for dispatching,
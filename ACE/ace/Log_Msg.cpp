@@ -2177,6 +2177,12 @@ ACE_Log_Msg::log (const ACE_TCHAR *format_str,
       // don't use verbose, however, to avoid recursive aborts if
       // something is hosed.
       log_record.print (ACE_Log_Msg::local_host_, 0, stderr);
+
+      // Let a custom backend that queues records write them out.
+      if (ACE_BIT_ENABLED (ACE_Log_Msg::flags_, ACE_Log_Msg::CUSTOM)
+          && ACE_Log_Msg_Manager::custom_backend_ != 0)
+        ACE_Log_Msg_Manager::custom_backend_->close ();
+
       ACE_OS::abort ();
     }
 
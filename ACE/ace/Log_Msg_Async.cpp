@@ -0,0 +1,552 @@
+#include "ace/Log_Msg_Async.h"
+#include "ace/ACE.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Record.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/os_include/os_limits.h"
+
+#if defined (ACE_HAS_THREADS)
+# include "ace/Thread.h"
+#endif /* ACE_HAS_THREADS */
+
+#if defined (ACE_USES_WCHAR)
+# include "ace/SString.h"
+#endif /* ACE_USES_WCHAR */
+
+#if defined (ACE_HAS_ALLOC_HOOKS)
+# include "ace/Malloc_Base.h"
+#endif /* ACE_HAS_ALLOC_HOOKS */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE (ACE_Log_Msg_Async)
+
+ACE_Log_Msg_Async::ACE_Log_Msg_Async (size_t capacity,
+                                      Overflow_Policy policy,
+                                      ACE_Log_Msg_Backend *target,
+                                      size_t batch)
+  : slots_ (0),
+    mask_ (0),
+    tail_ (0),
+    head_ (0),
+    policy_ (policy),
+    target_ (target),
+    handle_ (ACE_INVALID_HANDLE),
+    close_handle_ (false),
+    flush_mask_ (LM_CRITICAL | LM_ALERT | LM_EMERGENCY),
+    dropped_ (0),
+    reported_drops_ (0),
+    written_ (0),
+    open_ (false),
+    record_ (0),
+    record_flags_ (0),
+    batch_ (batch == 0
+            ? 1
+            : (batch >= static_cast<size_t> (ACE_IOV_MAX)
+               ? static_cast<size_t> (ACE_IOV_MAX) - 1
+               : batch)),
+    buffer_ (0),
+    buffer_size_ (0),
+    buffer_used_ (0),
+    iov_ (0),
+    iov_count_ (0)
+#if defined (ACE_HAS_THREADS)
+    , work_ (lock_)
+    , exited_ (lock_)
+    , writer_waiting_ (false)
+    , stop_ (false)
+    , writer_running_ (false)
+#endif /* ACE_HAS_THREADS */
+{
+  ACE_TRACE ("ACE_Log_Msg_Async::ACE_Log_Msg_Async");
+
+  size_t size = 2;
+  while (size < capacity)
+    size <<= 1;
+
+  ACE_NEW (this->slots_, Slot[size]);
+  this->mask_ = size - 1;
+  for (size_t i = 0; i < size; ++i)
+    {
+      this->slots_[i].sequence_.store (i, std::memory_order_relaxed);
+      this->slots_[i].long_text_ = 0;
+    }
+
+  // Room for a batch of typical records, and always for the longest
+  // one.
+  this->buffer_size_ =
+    this->batch_ * INLINE_TEXT + ACE_Log_Record::MAXVERBOSELOGMSGLEN;
+  ACE_NEW (this->buffer_, char[this->buffer_size_]);
+
+  // One more for the line about dropped records.
+  ACE_NEW (this->iov_, iovec[this->batch_ + 1]);
+  ACE_NEW (this->record_, ACE_Log_Record);
+
+  this->host_[0] = 0;
+}
+
+ACE_Log_Msg_Async::~ACE_Log_Msg_Async ()
+{
+  ACE_TRACE ("ACE_Log_Msg_Async::~ACE_Log_Msg_Async");
+
+  (void) this->close ();
+
+#if defined (ACE_HAS_THREADS)
+  {
+    ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+    this->stop_ = true;
+    this->work_.signal ();
+    while (this->writer_running_)
+      this->exited_.wait ();
+  }
+#endif /* ACE_HAS_THREADS */
+
+  if (this->slots_ != 0)
+    for (size_t i = 0; i <= this->mask_; ++i)
+      delete [] this->slots_[i].long_text_;
+
+  delete [] this->slots_;
+  delete [] this->buffer_;
+  delete [] this->iov_;
+  delete this->record_;
+}
+
+int
+ACE_Log_Msg_Async::open (const ACE_TCHAR *logger_key)
+{
+  ACE_TRACE ("ACE_Log_Msg_Async::open");
+
+  if (this->slots_ == 0 || this->buffer_ == 0
+      || this->iov_ == 0 || this->record_ == 0)
+    {
+      errno = ENOMEM;
+      return -1;
+    }
+
+  if (this->open_.load ())
+    this->close ();
+
+  // Taken here, the writer thread must not use ACE_Log_Msg.
+  const ACE_TCHAR *host = ACE_LOG_MSG->local_host ();
+  ACE_OS::strsncpy (this->host_,
+                    host == 0 ? ACE_TEXT ("") : host,
+                    sizeof this->host_ / sizeof (ACE_TCHAR));
+
+  if (this->target_ != 0)
+    {
+      if (this->target_->open (logger_key) == -1)
+        return -1;
+    }
+  else if (logger_key == 0)
+    {
+      this->handle_ = ACE_STDERR;
+      this->close_handle_ = false;
+    }
+  else
+    {
+      this->handle_ = ACE_OS::open (logger_key,
+                                    O_WRONLY | O_CREAT | O_APPEND,
+                                    ACE_DEFAULT_FILE_PERMS);
+      if (this->handle_ == ACE_INVALID_HANDLE)
+        return -1;
+      this->close_handle_ = true;
+    }
+
+#if defined (ACE_HAS_THREADS)
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->lock_, -1);
+    if (!this->writer_running_)
+      {
+        // Detached: the thread's own ACE_Log_Msg takes the ACE_Log_Msg
+        // lock when it exits, so it must not be joined.
+        if (ACE_Thread::spawn (ACE_Log_Msg_Async::writer_thread,
+                               this,
+                               THR_NEW_LWP | THR_DETACHED) == -1)
+          {
+            if (this->close_handle_)
+              ACE_OS::close (this->handle_);
+            this->handle_ = ACE_INVALID_HANDLE;
+            this->close_handle_ = false;
+            return -1;
+          }
+        this->writer_running_ = true;
+      }
+  }
+#endif /* ACE_HAS_THREADS */
+
+  this->open_.store (true);
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async::reset ()
+{
+  ACE_TRACE ("ACE_Log_Msg_Async::reset");
+  return this->close ();
+}
+
+int
+ACE_Log_Msg_Async::close ()
+{
+  ACE_TRACE ("ACE_Log_Msg_Async::close");
+
+  if (!this->open_.exchange (false))
+    return 0;
+
+  this->drain ();
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->write_lock_, -1);
+
+  int result = 0;
+  if (this->target_ != 0)
+    result = this->target_->close ();
+
+  if (this->close_handle_)
+    result = ACE_OS::close (this->handle_);
+  this->handle_ = ACE_INVALID_HANDLE;
+  this->close_handle_ = false;
+
+  return result;
+}
+
+ssize_t
+ACE_Log_Msg_Async::log (ACE_Log_Record &log_record)
+{
+  if (!this->open_.load (std::memory_order_relaxed))
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  // Called with the ACE_Log_Msg lock held, which is recursive.
+  u_long const flags = ACE_LOG_MSG->flags ();
+
+  while (!this->push (log_record, flags))
+    {
+      if (this->policy_ != BLOCK)
+        {
+          ++this->dropped_;
+          errno = EWOULDBLOCK;
+          return -1;
+        }
+
+      // Make room by writing records on this thread.
+      ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->write_lock_, -1);
+      this->write_batch ();
+    }
+
+#if defined (ACE_HAS_THREADS)
+  if (ACE_BIT_ENABLED (this->flush_mask_.load (std::memory_order_relaxed),
+                       log_record.type ()))
+    this->drain ();
+  else
+    this->wake_writer ();
+#else
+  this->drain ();
+#endif /* ACE_HAS_THREADS */
+
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async::flush ()
+{
+  ACE_TRACE ("ACE_Log_Msg_Async::flush");
+  this->drain ();
+  return 0;
+}
+
+void
+ACE_Log_Msg_Async::flush_priorities (u_long mask)
+{
+  this->flush_mask_.store (mask);
+}
+
+u_long
+ACE_Log_Msg_Async::flush_priorities () const
+{
+  return this->flush_mask_.load ();
+}
+
+size_t
+ACE_Log_Msg_Async::dropped () const
+{
+  return this->dropped_.load ();
+}
+
+size_t
+ACE_Log_Msg_Async::written () const
+{
+  return this->written_.load ();
+}
+
+bool
+ACE_Log_Msg_Async::push (ACE_Log_Record &log_record, u_long flags)
+{
+  // Claim a slot: it is free once its sequence equals our position.
+  size_t pos = this->tail_.load (std::memory_order_relaxed);
+  Slot *slot = 0;
+  for (;;)
+    {
+      slot = &this->slots_[pos & this->mask_];
+      size_t const sequence = slot->sequence_.load (std::memory_order_acquire);
+      if (sequence == pos)
+        {
+          if (this->tail_.compare_exchange_weak (pos,
+                                                 pos + 1,
+                                                 std::memory_order_relaxed))
+            break;
+        }
+      else if (sequence < pos)
+        return false;
+      else
+        pos = this->tail_.load (std::memory_order_relaxed);
+    }
+
+  slot->type_ = log_record.type ();
+  slot->time_stamp_ = log_record.time_stamp ();
+  slot->pid_ = log_record.pid ();
+  slot->flags_ = flags;
+
+  const ACE_TCHAR *text = log_record.msg_data ();
+  size_t const length = ACE_OS::strlen (text);
+  if (length < INLINE_TEXT)
+    ACE_OS::memcpy (slot->text_, text, (length + 1) * sizeof (ACE_TCHAR));
+  else
+    {
+      ACE_NEW_NORETURN (slot->long_text_, ACE_TCHAR[length + 1]);
+      if (slot->long_text_ != 0)
+        ACE_OS::memcpy (slot->long_text_, text,
+                        (length + 1) * sizeof (ACE_TCHAR));
+      else
+        ACE_OS::strsncpy (slot->text_, text, INLINE_TEXT);
+    }
+
+  // Publish the record to the consumer.
+  slot->sequence_.store (pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool
+ACE_Log_Msg_Async::pending () const
+{
+  size_t const pos = this->head_.load (std::memory_order_relaxed);
+  return this->slots_[pos & this->mask_].sequence_.load (
+    std::memory_order_acquire) == pos + 1;
+}
+
+bool
+ACE_Log_Msg_Async::pop ()
+{
+  size_t const pos = this->head_.load (std::memory_order_relaxed);
+  Slot &slot = this->slots_[pos & this->mask_];
+  if (slot.sequence_.load (std::memory_order_acquire) != pos + 1)
+    return false;
+
+  this->record_->type (slot.type_);
+  this->record_->time_stamp (slot.time_stamp_);
+  this->record_->pid (slot.pid_);
+  this->record_flags_ = slot.flags_;
+  if (slot.long_text_ != 0)
+    {
+      this->record_->msg_data (slot.long_text_);
+      delete [] slot.long_text_;
+      slot.long_text_ = 0;
+    }
+  else
+    this->record_->msg_data (slot.text_);
+
+  // Free the slot for the producer one lap ahead.
+  slot.sequence_.store (pos + this->mask_ + 1, std::memory_order_release);
+  this->head_.store (pos + 1, std::memory_order_relaxed);
+  return true;
+}
+
+size_t
+ACE_Log_Msg_Async::write_batch ()
+{
+  this->buffer_used_ = 0;
+  this->iov_count_ = 0;
+
+  if (this->policy_ == REPORT_DROPS)
+    {
+      size_t const drops = this->dropped_.load ();
+      if (drops != this->reported_drops_)
+        {
+          this->format_drops (drops - this->reported_drops_);
+          this->reported_drops_ = drops;
+        }
+    }
+
+  size_t count = 0;
+  for (; count < this->batch_ && this->pop (); ++count)
+    {
+      if (this->target_ != 0)
+        this->target_->log (*this->record_);
+      else
+        this->format_record ();
+    }
+
+  this->write_buffer ();
+  this->written_ += count;
+  return count;
+}
+
+void
+ACE_Log_Msg_Async::format_record ()
+{
+  // Keep room for the longest record.
+  if (this->buffer_size_ - this->buffer_used_
+      < ACE_Log_Record::MAXVERBOSELOGMSGLEN)
+    this->write_buffer ();
+
+  char *text = this->buffer_ + this->buffer_used_;
+  size_t length = 0;
+
+#if defined (ACE_USES_WCHAR)
+  ACE_TCHAR verbose[ACE_Log_Record::MAXVERBOSELOGMSGLEN];
+  if (this->record_->format_msg (this->host_[0] == 0 ? 0 : this->host_,
+                                 this->record_flags_,
+                                 verbose,
+                                 ACE_Log_Record::MAXVERBOSELOGMSGLEN) != 0)
+    return;
+  ACE_Wide_To_Ascii narrow (verbose);
+  length = ACE_OS::strlen (narrow.char_rep ());
+  if (length >= ACE_Log_Record::MAXVERBOSELOGMSGLEN)
+    length = ACE_Log_Record::MAXVERBOSELOGMSGLEN - 1;
+  ACE_OS::memcpy (text, narrow.char_rep (), length);
+#else
+  if (this->record_->format_msg (this->host_[0] == 0 ? 0 : this->host_,
+                                 this->record_flags_,
+                                 text,
+                                 ACE_Log_Record::MAXVERBOSELOGMSGLEN) != 0)
+    return;
+  length = ACE_OS::strlen (text);
+#endif /* ACE_USES_WCHAR */
+
+  this->iov_[this->iov_count_].iov_base = text;
+  this->iov_[this->iov_count_].iov_len = length;
+  ++this->iov_count_;
+  this->buffer_used_ += length;
+}
+
+void
+ACE_Log_Msg_Async::format_drops (size_t drops)
+{
+  this->record_->type (LM_WARNING);
+  this->record_->time_stamp (ACE_OS::gettimeofday ());
+  this->record_->pid (ACE_OS::getpid ());
+  this->record_flags_ = 0;
+
+  ACE_TCHAR text[64];
+  ACE_OS::snprintf (text,
+                    sizeof text / sizeof (ACE_TCHAR),
+                    ACE_TEXT ("ACE_Log_Msg_Async: %lu log records dropped\n"),
+                    static_cast<unsigned long> (drops));
+  this->record_->msg_data (text);
+
+  if (this->target_ != 0)
+    this->target_->log (*this->record_);
+  else
+    this->format_record ();
+}
+
+void
+ACE_Log_Msg_Async::write_buffer ()
+{
+  // Errors are not reported, that would need ACE_Log_Msg.
+  if (this->iov_count_ > 0 && this->handle_ != ACE_INVALID_HANDLE)
+    (void) ACE::writev_n (this->handle_, this->iov_, this->iov_count_);
+
+  this->iov_count_ = 0;
+  this->buffer_used_ = 0;
+}
+
+void
+ACE_Log_Msg_Async::drain ()
+{
+  ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->write_lock_);
+  while (this->write_batch () > 0)
+    continue;
+}
+
+void
+ACE_Log_Msg_Async::wake_writer ()
+{
+#if defined (ACE_HAS_THREADS)
+  // Pairs with the fence in run_writer(): either the writer sees the
+  // record we published or we see that it is going to sleep.
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+  if (this->writer_waiting_.load (std::memory_order_relaxed))
+    {
+      ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+      this->work_.signal ();
+    }
+#endif /* ACE_HAS_THREADS */
+}
+
+ACE_THR_FUNC_RETURN
+ACE_Log_Msg_Async::writer_thread (void *arg)
+{
+  static_cast<ACE_Log_Msg_Async *> (arg)->run_writer ();
+  return 0;
+}
+
+void
+ACE_Log_Msg_Async::run_writer ()
+{
+#if defined (ACE_HAS_THREADS)
+  for (;;)
+    {
+      size_t written = 0;
+      {
+        ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->write_lock_);
+        written = this->write_batch ();
+      }
+      if (written > 0)
+        continue;
+
+      ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+      if (this->stop_)
+        break;
+
+      this->writer_waiting_.store (true, std::memory_order_relaxed);
+      std::atomic_thread_fence (std::memory_order_seq_cst);
+      if (!this->pending ())
+        this->work_.wait ();
+      this->writer_waiting_.store (false, std::memory_order_relaxed);
+    }
+
+  // Nothing of this object may be touched once the destructor sees
+  // this.
+  ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+  this->writer_running_ = false;
+  this->exited_.signal ();
+#endif /* ACE_HAS_THREADS */
+}
+
+void
+ACE_Log_Msg_Async::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Log_Msg_Async::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("capacity_ = %B\n"), this->mask_ + 1));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("policy_ = %d\n"), this->policy_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("batch_ = %B\n"), this->batch_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("queued = %B\n"),
+                 this->tail_.load () - this->head_.load ()));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("dropped_ = %B\n"), this->dropped_.load ()));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("written_ = %B\n"), this->written_.load ()));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
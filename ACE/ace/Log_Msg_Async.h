@@ -0,0 +1,291 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async.h
+ *
+ *  ACE_Log_Msg_Backend that writes log records from a thread of its
+ *  own.
+ */
+//=============================================================================
+
+#ifndef ACE_LOG_MSG_ASYNC_H
+#define ACE_LOG_MSG_ASYNC_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Log_Msg_Backend.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Basic_Types.h"
+#include "ace/Default_Constants.h"
+#include "ace/Time_Value.h"
+#include "ace/Log_Record.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Null_Mutex.h"
+#include "ace/os_include/os_netdb.h"
+#include "ace/os_include/sys/os_uio.h"
+
+#if defined (ACE_HAS_THREADS)
+# include "ace/Condition_Thread_Mutex.h"
+#endif /* ACE_HAS_THREADS */
+
+#include <atomic>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Log_Msg_Async
+ *
+ * @brief An ACE_Log_Msg_Backend that hands log records to a writer
+ * thread instead of writing them on the logging thread.
+ *
+ * log() copies the already formatted record into a bounded ring and
+ * returns; it does not wait for a disk or syslog.  A writer thread,
+ * started by the first open(), takes the records out in batches,
+ * adds the ACE_Log_Msg::VERBOSE or VERBOSE_LITE prefix that was in
+ * effect when each record was logged and writes a whole batch with
+ * one writev() to the log file.  If a @c target backend is given the
+ * records are passed to its log() method instead, e.g. to move syslog
+ * off the logging threads.  The target must not log through
+ * ACE_Log_Msg.
+ *
+ * Producers claim ring slots with a compare-and-swap and publish them
+ * with a release store, so logging threads take no lock of this
+ * class unless the ring is full.  Then the overflow policy decides:
+ * with BLOCK the logging thread writes queued records itself until
+ * there is room, otherwise the record is dropped and counted.
+ *
+ * Records of the priorities in flush_priorities() (by default
+ * LM_CRITICAL, LM_ALERT and LM_EMERGENCY) are written, together with
+ * everything queued before them, before log() returns.  close() does
+ * the same for all queued records, and ACE_Log_Msg closes its custom
+ * backend before it aborts the program, so the lines leading up to
+ * an abort are not lost.  Flushing never waits for the writer
+ * thread, which matters because ACE_Log_Msg holds its lock while it
+ * calls the backend.
+ *
+ * To use it, install it with ACE_Log_Msg::msg_backend() and open
+ * ACE_Log_Msg with the ACE_Log_Msg::CUSTOM flag; the logger key given
+ * to ACE_Log_Msg::open() is the name of the file to append to.  As
+ * with the other backends, open(), reset() and close() must not run
+ * concurrently with log(), which ACE_Log_Msg ensures.  The writer
+ * thread stops when the object is destroyed, which must not happen
+ * while the ACE_Log_Msg lock is held.
+ *
+ * Without thread support the records are written by log() itself.
+ */
+class ACE_Export ACE_Log_Msg_Async : public ACE_Log_Msg_Backend
+{
+public:
+  /// What log() does with a record when the ring is full.
+  enum Overflow_Policy
+  {
+    /// Write queued records on the logging thread until there is
+    /// room.
+    BLOCK,
+    /// Discard the record; dropped() counts it.
+    DROP,
+    /// Discard the record, and have the writer log how many records
+    /// were dropped once it catches up.
+    REPORT_DROPS
+  };
+
+  /**
+   * @param capacity Number of records the ring holds, rounded up to
+   *        a power of two.
+   * @param policy What to do with records that do not fit.
+   * @param target Backend to pass the records to; if 0 they are
+   *        written to the file named by open().  Not owned.
+   * @param batch Most records written at once.
+   */
+  ACE_Log_Msg_Async (size_t capacity = ACE_DEFAULT_LOG_MSG_ASYNC_CAPACITY,
+                     Overflow_Policy policy = BLOCK,
+                     ACE_Log_Msg_Backend *target = 0,
+                     size_t batch = ACE_DEFAULT_LOG_MSG_ASYNC_BATCH);
+
+  /// Close the backend and stop the writer thread.
+  virtual ~ACE_Log_Msg_Async ();
+
+  /**
+   * Start the writer thread.  @a logger_key names the file the
+   * records are appended to; if it is 0 they go to stderr.  With a
+   * target backend @a logger_key is passed to its open() instead.
+   */
+  virtual int open (const ACE_TCHAR *logger_key);
+
+  /// Same as close(), ACE_Log_Msg calls open() again afterwards.
+  virtual int reset ();
+
+  /// Write the queued records and close the file (or the target
+  /// backend).  The writer thread is kept for the next open().
+  virtual int close ();
+
+  /**
+   * Queue @a log_record for the writer thread.
+   *
+   * @retval 0 The record was queued (or written).
+   * @retval -1 The record was dropped or the backend is not open;
+   *            errno is EWOULDBLOCK or ESHUTDOWN.
+   */
+  virtual ssize_t log (ACE_Log_Record &log_record);
+
+  /// Write all records queued so far before returning.
+  int flush ();
+
+  /// Priorities (a mask of ACE_Log_Priority values) whose records are
+  /// written before log() returns.
+  void flush_priorities (u_long mask);
+  u_long flush_priorities () const;
+
+  /// Number of records dropped because the ring was full.
+  size_t dropped () const;
+
+  /// Number of records written so far.
+  size_t written () const;
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  enum
+  {
+    /// Characters of a message kept in its slot, longer messages are
+    /// copied to the heap.
+    INLINE_TEXT = 256
+  };
+
+  /// One record in the ring.
+  struct Slot
+  {
+    /// Position of the record this slot holds or expects next; see
+    /// push() and pop().
+    std::atomic<size_t> sequence_;
+
+    ACE_UINT32 type_;
+    ACE_Time_Value time_stamp_;
+    long pid_;
+
+    /// ACE_Log_Msg flags when the record was logged.
+    u_long flags_;
+
+    /// Message text, in <text_> or <long_text_>.
+    ACE_TCHAR *long_text_;
+    ACE_TCHAR text_[INLINE_TEXT];
+  };
+
+  /// Copy @a log_record into the next free slot; false if the ring is
+  /// full.
+  bool push (ACE_Log_Record &log_record, u_long flags);
+
+  /// Take the oldest record, if there is one, out of the ring into
+  /// <record_> and <record_flags_> (<write_lock_> held).
+  bool pop ();
+
+  /// True if a record is waiting to be taken out.
+  bool pending () const;
+
+  /// Write up to <batch_> queued records and return how many
+  /// (<write_lock_> held).
+  size_t write_batch ();
+
+  /// Format <record_> into the batch.
+  void format_record ();
+
+  /// Add a line saying that @a drops records were lost to the batch.
+  void format_drops (size_t drops);
+
+  /// Write the formatted batch to the file.
+  void write_buffer ();
+
+  /// Write all queued records on the calling thread.
+  void drain ();
+
+  /// Wake the writer thread if it sleeps.
+  void wake_writer ();
+
+  /// Writer thread.
+  static ACE_THR_FUNC_RETURN writer_thread (void *arg);
+  void run_writer ();
+
+  Slot *slots_;
+  size_t mask_;
+
+  /// Next position producers write to.
+  std::atomic<size_t> tail_;
+
+  /// Next position to take a record from, only advanced with
+  /// <write_lock_> held.
+  std::atomic<size_t> head_;
+
+  Overflow_Policy const policy_;
+  ACE_Log_Msg_Backend *target_;
+
+  /// File the records are written to and whether we opened it.
+  ACE_HANDLE handle_;
+  bool close_handle_;
+
+  /// Host name used for ACE_Log_Msg::VERBOSE, taken by open().
+  ACE_TCHAR host_[MAXHOSTNAMELEN + 1];
+
+  std::atomic<u_long> flush_mask_;
+
+  std::atomic<size_t> dropped_;
+  size_t reported_drops_;
+  std::atomic<size_t> written_;
+
+  /// True between open() and close().
+  std::atomic<bool> open_;
+
+  /// Serializes taking records out of the ring and writing them,
+  /// between the writer thread and threads that flush.
+  ACE_SYNCH_MUTEX write_lock_;
+
+  // = Consumer state, protected by <write_lock_>.
+
+  /// Last record taken out of the ring.
+  ACE_Log_Record *record_;
+  u_long record_flags_;
+
+  /// Formatted records of the current batch.
+  size_t const batch_;
+  char *buffer_;
+  size_t buffer_size_;
+  size_t buffer_used_;
+  iovec *iov_;
+  int iov_count_;
+
+#if defined (ACE_HAS_THREADS)
+  /// Serializes sleeping and waking the writer; never held while
+  /// writing.
+  ACE_Thread_Mutex lock_;
+
+  /// Signaled when records arrive or the writer should stop.
+  ACE_Condition_Thread_Mutex work_;
+
+  /// Signaled when the writer thread is done.
+  ACE_Condition_Thread_Mutex exited_;
+
+  /// Whether the writer sleeps on <work_>.
+  std::atomic<bool> writer_waiting_;
+
+  /// Set by the destructor to stop the writer thread.
+  bool stop_;
+
+  /// True while the writer thread runs.
+  bool writer_running_;
+#endif /* ACE_HAS_THREADS */
+
+  ACE_Log_Msg_Async (const ACE_Log_Msg_Async &) = delete;
+  ACE_Log_Msg_Async &operator= (const ACE_Log_Msg_Async &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOG_MSG_ASYNC_H */
@@ -181,7 +181,9 @@ ACE_MEM_Acceptor::accept (ACE_MEM_Stream &new_stream,
     this->preferred_strategy_;
 #else
     // We don't support MT.
-    ACE_MEM_IO::Reactive;
+    this->preferred_strategy_ == ACE_MEM_IO::MT
+      ? ACE_MEM_IO::Reactive
+      : this->preferred_strategy_;
 #endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
   if (ACE::send (new_handle, &client_signaling,
                  sizeof (ACE_INT16)) == -1)
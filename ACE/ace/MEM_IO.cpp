@@ -1,6 +1,16 @@
 // MEM_IO.cpp
 #include "ace/MEM_IO.h"
 #include "ace/Handle_Set.h"
+#include "ace/ACE.h"
+#include "ace/Min_Max.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+#include <new>
+
+#if defined (ACE_LINUX)
+# include <linux/futex.h>
+# include <sys/syscall.h>
+#endif /* ACE_LINUX */
 
 #if (ACE_HAS_POSITION_INDEPENDENT_POINTERS == 1)
 
@@ -94,6 +104,403 @@ ACE_Reactive_MEM_IO::send_buf (ACE_MEM_SAP_Node *buf,
   return ACE_Utils::truncate_cast<ssize_t> (buf->size ());
 }
 
+static_assert ((ACE_MEM_IO_RING_SIZE & (ACE_MEM_IO_RING_SIZE - 1)) == 0,
+               "ACE_MEM_IO_RING_SIZE must be a power of two");
+
+namespace
+{
+  /// Least number of polls before an ACE_Ring_MEM_IO sleeps.
+  int const ring_min_spin = 16;
+
+  /// Longest sleep between checks of the socket of the peer.
+  ACE_Time_Value const ring_max_sleep (1, 0);
+
+  inline void
+  ring_pause ()
+  {
+#if defined (__GNUC__) && (defined (__i386__) || defined (__x86_64__))
+    __builtin_ia32_pause ();
+#endif /* __GNUC__ && (__i386__ || __x86_64__) */
+  }
+
+  /// Sleep for up to @a interval unless @a word no longer holds
+  /// @a value.  The futex is not private, the peer is another process.
+  inline void
+  ring_sleep (std::atomic<ACE_UINT32> &word,
+              ACE_UINT32 value,
+              const ACE_Time_Value &interval)
+  {
+#if defined (ACE_LINUX)
+    static_assert (sizeof (std::atomic<ACE_UINT32>) == sizeof (ACE_UINT32),
+                   "futex word must be a plain 32 bit integer");
+    timespec_t ts = interval;
+    ::syscall (SYS_futex,
+               reinterpret_cast<ACE_UINT32 *> (&word),
+               FUTEX_WAIT,
+               value,
+               &ts,
+               0,
+               0);
+#else
+    // Without futexes, nap briefly and let the caller check again.
+    if (word.load (std::memory_order_acquire) == value)
+      {
+        ACE_Time_Value nap (0, 100);
+        ACE_OS::sleep (interval < nap ? interval : nap);
+      }
+#endif /* ACE_LINUX */
+  }
+
+  inline void
+  ring_wake (std::atomic<ACE_UINT32> &word)
+  {
+#if defined (ACE_LINUX)
+    ::syscall (SYS_futex,
+               reinterpret_cast<ACE_UINT32 *> (&word),
+               FUTEX_WAKE,
+               1,
+               0,
+               0,
+               0);
+#else
+    ACE_UNUSED_ARG (word);
+#endif /* ACE_LINUX */
+  }
+
+  /// Copy @a n bytes into @a ring at @a pos, wrapping around.
+  inline void
+  ring_put (ACE_Ring_MEM_IO::Ring *ring,
+            ACE_UINT64 pos,
+            const char *buf,
+            size_t n)
+  {
+    size_t const offset = static_cast<size_t> (pos & (ring->size_ - 1));
+    size_t const first = ace_min (n, ring->size_ - offset);
+    ACE_OS::memcpy (ring->data () + offset, buf, first);
+    ACE_OS::memcpy (ring->data (), buf + first, n - first);
+  }
+
+  /// Copy @a n bytes out of @a ring at @a pos, wrapping around.
+  inline void
+  ring_get (ACE_Ring_MEM_IO::Ring *ring,
+            ACE_UINT64 pos,
+            char *buf,
+            size_t n)
+  {
+    size_t const offset = static_cast<size_t> (pos & (ring->size_ - 1));
+    size_t const first = ace_min (n, ring->size_ - offset);
+    ACE_OS::memcpy (buf, ring->data () + offset, first);
+    ACE_OS::memcpy (buf + first, ring->data (), n - first);
+  }
+}
+
+ACE_Ring_MEM_IO::~ACE_Ring_MEM_IO ()
+{
+}
+
+int
+ACE_Ring_MEM_IO::init (ACE_HANDLE handle,
+                       const ACE_TCHAR *name,
+                       MALLOC_OPTIONS *options)
+{
+  ACE_TRACE ("ACE_Ring_MEM_IO::init");
+  this->handle_ = handle;
+
+  if (this->create_shm_malloc (name, options) == -1)
+    return -1;
+
+  void *to_server_ptr = 0;
+  void *to_client_ptr = 0;
+
+  // As with ACE_MT_MEM_IO, the side that finds no rings in the new
+  // file is the server and creates them.
+  if (this->shm_malloc_->find ("ring_to_server", to_server_ptr) == -1)
+    {
+      size_t const ring_bytes = sizeof (Ring) + ACE_MEM_IO_RING_SIZE;
+      void *ptr = 0;
+      ACE_ALLOCATOR_RETURN (ptr,
+                            this->shm_malloc_->malloc (2 * ring_bytes),
+                            -1);
+
+      to_server_ptr = ptr;
+      to_client_ptr = static_cast<char *> (ptr) + ring_bytes;
+
+      Ring *rings[2] = { new (to_server_ptr) Ring,
+                         new (to_client_ptr) Ring };
+      for (Ring *ring : rings)
+        {
+          ring->head_.store (0, std::memory_order_relaxed);
+          ring->tail_.store (0, std::memory_order_relaxed);
+          ring->data_seq_.store (0, std::memory_order_relaxed);
+          ring->data_waiting_.store (0, std::memory_order_relaxed);
+          ring->space_seq_.store (0, std::memory_order_relaxed);
+          ring->space_waiting_.store (0, std::memory_order_relaxed);
+          ring->closed_.store (0, std::memory_order_relaxed);
+          ring->size_ = ACE_MEM_IO_RING_SIZE;
+        }
+
+      if (this->shm_malloc_->bind ("ring_to_server", to_server_ptr) == -1
+          || this->shm_malloc_->bind ("ring_to_client", to_client_ptr) == -1)
+        return -1;
+
+      this->recv_ring_ = static_cast<Ring *> (to_server_ptr);
+      this->send_ring_ = static_cast<Ring *> (to_client_ptr);
+    }
+  else
+    {
+      if (this->shm_malloc_->find ("ring_to_client", to_client_ptr) == -1)
+        return -1;
+
+      this->recv_ring_ = static_cast<Ring *> (to_client_ptr);
+      this->send_ring_ = static_cast<Ring *> (to_server_ptr);
+    }
+
+  return 0;
+}
+
+int
+ACE_Ring_MEM_IO::fini ()
+{
+  // Tell the peer, in whatever it is waiting for.
+  Ring *rings[2] = { this->recv_ring_, this->send_ring_ };
+  for (Ring *ring : rings)
+    {
+      if (ring == 0)
+        continue;
+
+      ring->closed_.store (1, std::memory_order_release);
+      ring->data_seq_.fetch_add (1, std::memory_order_release);
+      ring_wake (ring->data_seq_);
+      ring->space_seq_.fetch_add (1, std::memory_order_release);
+      ring_wake (ring->space_seq_);
+    }
+
+  this->recv_ring_ = 0;
+  this->send_ring_ = 0;
+
+  return ACE_MEM_SAP::fini ();
+}
+
+ssize_t
+ACE_Ring_MEM_IO::recv_buf (ACE_MEM_SAP_Node *&buf,
+                           int,
+                           const ACE_Time_Value *)
+{
+  buf = 0;
+  ACE_NOTSUP_RETURN (-1);
+}
+
+ssize_t
+ACE_Ring_MEM_IO::send_buf (ACE_MEM_SAP_Node *buf,
+                           int,
+                           const ACE_Time_Value *)
+{
+  this->release_buffer (buf);
+  ACE_NOTSUP_RETURN (-1);
+}
+
+ssize_t
+ACE_Ring_MEM_IO::send (const void *buf,
+                       size_t n,
+                       const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Ring_MEM_IO::send");
+
+  Ring *const ring = this->send_ring_;
+  if (ring == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ACE_Time_Value deadline;
+  if (timeout != 0)
+    deadline = ACE_OS::gettimeofday () + *timeout;
+
+  const char *const data = static_cast<const char *> (buf);
+  size_t sent = 0;
+
+  while (sent < n)
+    {
+      if (ring->closed_.load (std::memory_order_acquire) != 0)
+        {
+          errno = EPIPE;
+          break;
+        }
+
+      // Only we move the head, the reader moves the tail.
+      ACE_UINT64 const head = ring->head_.load (std::memory_order_relaxed);
+      ACE_UINT64 const tail = ring->tail_.load (std::memory_order_acquire);
+      size_t const room = ring->size_ - static_cast<size_t> (head - tail);
+
+      if (room == 0)
+        {
+          if (this->wait (false, timeout == 0 ? 0 : &deadline) == -1)
+            break;
+          continue;
+        }
+
+      size_t const chunk = ace_min (room, n - sent);
+      ring_put (ring, head, data + sent, chunk);
+      ring->head_.store (head + chunk, std::memory_order_release);
+      sent += chunk;
+
+      this->wake (ring->data_seq_, ring->data_waiting_);
+    }
+
+  if (sent == 0 && n != 0)
+    return -1;
+
+  return ACE_Utils::truncate_cast<ssize_t> (sent);
+}
+
+ssize_t
+ACE_Ring_MEM_IO::recv (void *buf,
+                       size_t n,
+                       const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Ring_MEM_IO::recv");
+
+  Ring *const ring = this->recv_ring_;
+  if (ring == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ACE_Time_Value deadline;
+  if (timeout != 0)
+    deadline = ACE_OS::gettimeofday () + *timeout;
+
+  for (;;)
+    {
+      // Only we move the tail, the writer moves the head.
+      ACE_UINT64 const tail = ring->tail_.load (std::memory_order_relaxed);
+      ACE_UINT64 const head = ring->head_.load (std::memory_order_acquire);
+
+      if (head != tail)
+        {
+          size_t const chunk =
+            ace_min (static_cast<size_t> (head - tail), n);
+          ring_get (ring, tail, static_cast<char *> (buf), chunk);
+          ring->tail_.store (tail + chunk, std::memory_order_release);
+
+          this->wake (ring->space_seq_, ring->space_waiting_);
+
+          return ACE_Utils::truncate_cast<ssize_t> (chunk);
+        }
+
+      if (ring->closed_.load (std::memory_order_acquire) != 0)
+        return 0;
+
+      if (this->wait (true, timeout == 0 ? 0 : &deadline) == -1)
+        return errno == EPIPE ? 0 : -1;
+    }
+}
+
+int
+ACE_Ring_MEM_IO::wait (bool for_data, const ACE_Time_Value *deadline)
+{
+  Ring *const ring = for_data ? this->recv_ring_ : this->send_ring_;
+  std::atomic<ACE_UINT32> &seq =
+    for_data ? ring->data_seq_ : ring->space_seq_;
+  std::atomic<ACE_UINT32> &waiting =
+    for_data ? ring->data_waiting_ : ring->space_waiting_;
+
+  auto ready = [ring, for_data] () -> bool
+    {
+      if (ring->closed_.load (std::memory_order_acquire) != 0)
+        return true;
+
+      ACE_UINT64 const head = ring->head_.load (std::memory_order_acquire);
+      ACE_UINT64 const tail = ring->tail_.load (std::memory_order_acquire);
+      return for_data ? head != tail : head - tail < ring->size_;
+    };
+
+  // Poll first, a peer on another core usually answers quickly.
+  for (int i = 0; i != this->spin_; ++i)
+    {
+      if (ready ())
+        {
+          // Polling was enough, allow more of it next time.
+          if (this->spin_ < ACE_MEM_IO_RING_SPIN)
+            this->spin_ = ace_min (2 * this->spin_, ACE_MEM_IO_RING_SPIN);
+          return 0;
+        }
+      ring_pause ();
+    }
+
+  // It was not, poll less next time.
+  this->spin_ = ace_max (this->spin_ / 2, ring_min_spin);
+
+  for (;;)
+    {
+      ACE_UINT32 const value = seq.load (std::memory_order_acquire);
+
+      // Announce the sleep before the last check, the peer checks
+      // the flag after it moved its counter.
+      waiting.store (1, std::memory_order_relaxed);
+      std::atomic_thread_fence (std::memory_order_seq_cst);
+
+      if (ready ())
+        {
+          waiting.store (0, std::memory_order_relaxed);
+          return 0;
+        }
+
+      ACE_Time_Value interval = ring_max_sleep;
+      if (deadline != 0)
+        {
+          ACE_Time_Value const now = ACE_OS::gettimeofday ();
+          if (now >= *deadline)
+            {
+              waiting.store (0, std::memory_order_relaxed);
+              errno = ETIME;
+              return -1;
+            }
+          interval = ace_min (interval, *deadline - now);
+        }
+
+      ring_sleep (seq, value, interval);
+      waiting.store (0, std::memory_order_relaxed);
+
+      if (ready ())
+        return 0;
+
+      if (this->peer_gone ())
+        {
+          errno = EPIPE;
+          return -1;
+        }
+    }
+}
+
+void
+ACE_Ring_MEM_IO::wake (std::atomic<ACE_UINT32> &seq,
+                       std::atomic<ACE_UINT32> &waiting)
+{
+  // Pairs with the fence in wait (): either the peer sees our counter
+  // before it sleeps or we see its flag.
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+  if (waiting.load (std::memory_order_relaxed) != 0)
+    {
+      seq.fetch_add (1, std::memory_order_release);
+      ring_wake (seq);
+    }
+}
+
+bool
+ACE_Ring_MEM_IO::peer_gone () const
+{
+  if (this->handle_ == ACE_INVALID_HANDLE)
+    return false;
+
+  // Nothing is sent through the socket, it only becomes readable
+  // when the peer closed it.
+  ACE_Time_Value const poll = ACE_Time_Value::zero;
+  return ACE::handle_read_ready (this->handle_, &poll) == 1;
+}
+
 #if defined (ACE_WIN32) || !defined (_ACE_USE_SV_SEM)
 int
 ACE_MT_MEM_IO::Simple_Queue::write (ACE_MEM_SAP_Node *new_node)
@@ -348,6 +755,7 @@ ACE_MEM_IO::init (const ACE_TCHAR *name,
 
   delete this->deliver_strategy_;
   this->deliver_strategy_ = 0;
+  this->ring_ = 0;
   switch (type)
     {
     case ACE_MEM_IO::Reactive:
@@ -362,6 +770,12 @@ ACE_MEM_IO::init (const ACE_TCHAR *name,
                       -1);
       break;
 #endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
+    case ACE_MEM_IO::Ring:
+      ACE_NEW_RETURN (this->ring_,
+                      ACE_Ring_MEM_IO (),
+                      -1);
+      this->deliver_strategy_ = this->ring_;
+      break;
     default:
       return -1;
     }
@@ -400,6 +814,29 @@ ACE_MEM_IO::send (const ACE_Message_Block *message_block,
       return -1;                  // Something went seriously wrong.
     }
 
+  if (this->ring_ != 0)
+    {
+      // Copy each block straight into the ring.
+      ssize_t sent = 0;
+      for (const ACE_Message_Block *mb = message_block;
+           mb != 0;
+           mb = mb->cont () != 0 ? mb->cont () : mb->next ())
+        {
+          if (mb->length () == 0)
+            continue;
+
+          ssize_t const n =
+            this->ring_->send (mb->rd_ptr (), mb->length (), timeout);
+          if (n <= 0)
+            return sent == 0 ? n : sent;
+
+          sent += n;
+          if (static_cast<size_t> (n) != mb->length ())
+            break;
+        }
+      return sent;
+    }
+
   size_t len = message_block->total_length ();
 
   if (len != 0)
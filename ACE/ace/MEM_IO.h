@@ -27,6 +27,19 @@
 #include "ace/Process_Semaphore.h"
 #include "ace/Process_Mutex.h"
 
+#include <atomic>
+
+/// Bytes of each of the two rings of an ACE_Ring_MEM_IO, a power of
+/// two.
+#if !defined (ACE_MEM_IO_RING_SIZE)
+# define ACE_MEM_IO_RING_SIZE (256 * 1024)
+#endif /* ACE_MEM_IO_RING_SIZE */
+
+/// Most times an ACE_Ring_MEM_IO polls its ring before it sleeps.
+#if !defined (ACE_MEM_IO_RING_SPIN)
+# define ACE_MEM_IO_RING_SPIN 4096
+#endif /* ACE_MEM_IO_RING_SPIN */
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class ACE_Export ACE_Reactive_MEM_IO : public ACE_MEM_SAP
@@ -141,6 +154,133 @@ private:
 };
 #endif /* ACE_WIN32 || !_ACE_USE_SV_SEM */
 
+/**
+ * @class ACE_Ring_MEM_IO
+ *
+ * @brief Exchanges data through two single producer, single consumer
+ * byte rings in the shared memory file, one per direction.
+ *
+ * The sender copies the data straight into the ring the peer reads
+ * from, there is no allocation from the shared memory pool and no
+ * system call while the reader keeps up.  A side that finds its ring
+ * empty (or full) polls it for a while, adapting the number of polls
+ * to how often that was enough, and then sleeps on a futex in the
+ * ring (on Linux, other platforms sleep for short periods) until the
+ * peer wakes it up.  The socket is only used to notice a peer that
+ * went away without closing the stream.
+ *
+ * Each ring has one writer and one reader, so a stream must not be
+ * written, or read, by several threads at the same time.  As with
+ * ACE_MT_MEM_IO the socket does not become readable when data
+ * arrives, so the strategy is meant for threads that block in recv
+ * and not for the reactor.
+ */
+class ACE_Export ACE_Ring_MEM_IO : public ACE_MEM_SAP
+{
+public:
+  /// One direction of the stream, in the shared memory file.  The
+  /// data follows the header.
+  struct Ring
+  {
+    /// Bytes written so far, only changed by the writer.  The
+    /// padding keeps it off the cache line of the reader's counter.
+    std::atomic<ACE_UINT64> head_;
+    char head_pad_[64 - sizeof (ACE_UINT64)];
+
+    /// Bytes read so far, only changed by the reader.
+    std::atomic<ACE_UINT64> tail_;
+    char tail_pad_[64 - sizeof (ACE_UINT64)];
+
+    /// Futex the reader sleeps on, and whether it does.
+    std::atomic<ACE_UINT32> data_seq_;
+    std::atomic<ACE_UINT32> data_waiting_;
+
+    /// Futex the writer sleeps on, and whether it does.
+    std::atomic<ACE_UINT32> space_seq_;
+    std::atomic<ACE_UINT32> space_waiting_;
+
+    /// Set once either side closed the stream.
+    std::atomic<ACE_UINT32> closed_;
+
+    /// Bytes of data, a power of two.
+    ACE_UINT32 size_;
+
+    char *data ();
+  };
+
+  ACE_Ring_MEM_IO ();
+
+  virtual ~ACE_Ring_MEM_IO ();
+
+  /**
+   * Initialize the MEM_SAP object.  The side that creates the shared
+   * memory file also creates the rings in it.
+   */
+  virtual int init (ACE_HANDLE handle,
+                    const ACE_TCHAR *name,
+                    MALLOC_OPTIONS *options);
+
+  /// Mark the rings closed, wake up the peer and detach from the
+  /// shared memory.
+  virtual int fini ();
+
+  /// Not supported, the data does not go through ACE_MEM_SAP_Node
+  /// buffers.
+  virtual ssize_t recv_buf (ACE_MEM_SAP_Node *&buf,
+                            int flags,
+                            const ACE_Time_Value *timeout);
+
+  /// Not supported, the data does not go through ACE_MEM_SAP_Node
+  /// buffers.
+  virtual ssize_t send_buf (ACE_MEM_SAP_Node *buf,
+                            int flags,
+                            const ACE_Time_Value *timeout);
+
+  /**
+   * Copy @a n bytes into the ring of the peer, waiting up to
+   * @a timeout for room.  Returns the number of bytes sent, which is
+   * less than @a n only if the time ran out, or -1 with @c errno
+   * ETIME if nothing could be sent in time and EPIPE if the stream is
+   * closed.
+   */
+  ssize_t send (const void *buf,
+                size_t n,
+                const ACE_Time_Value *timeout);
+
+  /**
+   * Copy up to @a n bytes from our ring into @a buf, waiting up to
+   * @a timeout for data.  Returns the number of bytes received, 0 once
+   * the stream is closed and the ring empty, or -1 with @c errno ETIME.
+   */
+  ssize_t recv (void *buf,
+                size_t n,
+                const ACE_Time_Value *timeout);
+
+private:
+  /// Wait until there is data in the ring we read from, or room in
+  /// the one we write to if @a for_data is false, or the stream is
+  /// closed.  Polls first and then sleeps.  Returns -1 with @c errno
+  /// ETIME once the absolute time @a deadline passed and EPIPE if the
+  /// peer went away.
+  int wait (bool for_data, const ACE_Time_Value *deadline);
+
+  /// Wake up the peer if it sleeps on @a seq.
+  void wake (std::atomic<ACE_UINT32> &seq,
+             std::atomic<ACE_UINT32> &waiting);
+
+  /// True if the socket shows that the peer is gone.
+  bool peer_gone () const;
+
+  /// Ring we read from.
+  Ring *recv_ring_;
+
+  /// Ring we write to.
+  Ring *send_ring_;
+
+  /// Current number of polls before sleeping.
+  int spin_;
+};
+
 /**
  * @class ACE_MEM_IO
  *
@@ -179,7 +319,8 @@ public:
   typedef enum
   {
     Reactive,
-    MT
+    MT,
+    Ring
   }  Signal_Strategy;
 
   /**
@@ -287,6 +428,10 @@ private:
   /// Actual deliverying mechanism.
   ACE_MEM_SAP *deliver_strategy_;
 
+  /// The deliver strategy if it is the ring one, its data does not go
+  /// through <recv_buffer_>.
+  ACE_Ring_MEM_IO *ring_;
+
   /// Internal pointer for support recv/send.
   ACE_MEM_SAP_Node *recv_buffer_;
 
@@ -9,6 +9,20 @@ ACE_Reactive_MEM_IO::ACE_Reactive_MEM_IO ()
 {
 }
 
+ACE_INLINE char *
+ACE_Ring_MEM_IO::Ring::data ()
+{
+  return reinterpret_cast<char *> (this + 1);
+}
+
+ACE_INLINE
+ACE_Ring_MEM_IO::ACE_Ring_MEM_IO ()
+  : recv_ring_ (0),
+    send_ring_ (0),
+    spin_ (ACE_MEM_IO_RING_SPIN)
+{
+}
+
 #if defined (ACE_WIN32) || !defined (_ACE_USE_SV_SEM)
 ACE_INLINE
 ACE_MT_MEM_IO::Simple_Queue::Simple_Queue ()
@@ -78,6 +92,7 @@ ACE_Reactive_MEM_IO::get_buf_len (const ACE_OFF_T off, ACE_MEM_SAP_Node *&buf)
 ACE_INLINE
 ACE_MEM_IO::ACE_MEM_IO ()
   : deliver_strategy_ (0),
+    ring_ (0),
     recv_buffer_ (0),
     buf_size_ (0),
     cur_offset_ (0)
@@ -132,6 +147,12 @@ ACE_MEM_IO::send (const void *buf,
       return 0;
     }
 
+  if (this->ring_ != 0)
+    {
+      ACE_UNUSED_ARG (flags);
+      return this->ring_->send (buf, len, timeout);
+    }
+
   ACE_MEM_SAP_Node *sbuf =
     this->deliver_strategy_->acquire_buffer (
       ACE_Utils::truncate_cast<ssize_t> (len));
@@ -160,6 +181,12 @@ ACE_MEM_IO::recv (void *buf,
 {
   ACE_TRACE ("ACE_MEM_IO::recv");
 
+  if (this->ring_ != 0)
+    {
+      ACE_UNUSED_ARG (flags);
+      return this->ring_->recv (buf, len, timeout);
+    }
+
   size_t count = 0;
 
   size_t buf_len = this->buf_size_ - this->cur_offset_;
@@ -1135,6 +1135,42 @@ ACE_Data_Block::clone (ACE_Message_Block::Message_Flags mask) const
   return nb;
 }
 
+ACE_External_Data_Block::ACE_External_Data_Block (const char *buffer,
+                                                  size_t size,
+                                                  Release_Function release,
+                                                  void *arg,
+                                                  ACE_Lock *locking_strategy,
+                                                  ACE_Allocator *data_block_allocator)
+  : ACE_Data_Block (size,
+                    ACE_Message_Block::MB_DATA,
+                    buffer,
+                    0,
+                    locking_strategy,
+                    ACE_Message_Block::DONT_DELETE,
+                    data_block_allocator),
+    buffer_ (buffer),
+    buffer_size_ (size),
+    release_ (release),
+    arg_ (arg)
+{
+  ACE_TRACE ("ACE_External_Data_Block::ACE_External_Data_Block");
+}
+
+ACE_External_Data_Block::~ACE_External_Data_Block ()
+{
+  if (this->release_ != 0)
+    (*this->release_) (this->buffer_, this->buffer_size_, this->arg_);
+}
+
+ACE_Data_Block *
+ACE_External_Data_Block::clone (ACE_Message_Block::Message_Flags) const
+{
+  ACE_TRACE ("ACE_External_Data_Block::clone");
+
+  // The buffer does not change, sharing it is as good as a copy.
+  return const_cast<ACE_External_Data_Block *> (this)->duplicate ();
+}
+
 ACE_Data_Block *
 ACE_Data_Block::clone_nocopy (ACE_Message_Block::Message_Flags mask,
                               size_t max_size) const
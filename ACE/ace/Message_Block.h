@@ -854,6 +854,58 @@ private:
   ACE_Data_Block (const ACE_Data_Block &);
 };
 
+/**
+ * @class ACE_External_Data_Block
+ *
+ * @brief An ACE_Data_Block for a buffer that belongs to someone else,
+ * who is told through a callback when the buffer is no longer used.
+ *
+ * The buffer is never freed or written by the block.  It must not
+ * change while any block refers to it, so clone() only adds a
+ * reference instead of copying the data.  When the last reference
+ * is released the destructor calls the release function with the
+ * buffer, its size and the argument given to the constructor.
+ *
+ * The block is deleted through @a data_block_allocator, so it must be
+ * allocated from it, e.g. with ACE_NEW_MALLOC.
+ */
+class ACE_Export ACE_External_Data_Block : public ACE_Data_Block
+{
+public:
+  /// Called once the buffer is no longer used.
+  typedef void (*Release_Function) (const char *buffer,
+                                    size_t size,
+                                    void *arg);
+
+  /// Refer to the @a size bytes at @a buffer and call @a release (if
+  /// it is not 0) with @a arg once the block is deleted.
+  ACE_External_Data_Block (const char *buffer,
+                           size_t size,
+                           Release_Function release,
+                           void *arg,
+                           ACE_Lock *locking_strategy = 0,
+                           ACE_Allocator *data_block_allocator = 0);
+
+  /// Calls the release function.
+  virtual ~ACE_External_Data_Block ();
+
+  /// Return a "shallow" copy, the buffer is not copied.
+  virtual ACE_Data_Block *clone (ACE_Message_Block::Message_Flags mask = 0) const;
+
+private:
+  /// The buffer and size given to the constructor; base() and size()
+  /// may have been changed since.
+  const char *buffer_;
+  size_t buffer_size_;
+
+  Release_Function release_;
+  void *arg_;
+
+  // = Disallow these operations.
+  ACE_External_Data_Block &operator= (const ACE_External_Data_Block &);
+  ACE_External_Data_Block (const ACE_External_Data_Block &);
+};
+
 ACE_END_VERSIONED_NAMESPACE_DECL
 
 #if defined (__ACE_INLINE__)
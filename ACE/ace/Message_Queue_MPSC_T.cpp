@@ -0,0 +1,435 @@
+#ifndef ACE_MESSAGE_QUEUE_MPSC_T_CPP
+#define ACE_MESSAGE_QUEUE_MPSC_T_CPP
+
+#include "ace/Message_Queue_MPSC_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Log_Category.h"
+#include "ace/Notification_Strategy.h"
+#include "ace/Truncate.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tyc(ACE_Message_Queue_MPSC)
+
+// Producers push onto <inbox_> with a compare-and-swap and add the
+// message to <bytes_>, <length_> and <count_> *before* pushing, so a
+// consumer can never take the counters below zero.  The consumer
+// empties the inbox with a single exchange, reverses it into FIFO
+// order and appends it to the list of ACE_Message_Queue, adding it to
+// that list's counters and to the <synced_*_> values since the atomic
+// counters already include it.  Every other change the base class
+// makes to its counters is folded into the atomic counters by
+// sync_i(), which is idempotent, so the nested calls between the base
+// class' _i methods do not count anything twice.
+//
+// A consumer about to sleep on the empty queue increments <waiters_>
+// and then looks at the inbox again (both sequentially consistent);
+// a producer pushes and then reads <waiters_>.  Either the consumer
+// sees the new message or the producer sees the waiter and signals it
+// under the lock, so no wakeup is lost.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::ACE_Message_Queue_MPSC (size_t hwm,
+                                                                            size_t lwm,
+                                                                            ACE_Notification_Strategy *ns)
+  : BASE (hwm, lwm, ns),
+    inbox_ (0),
+    bytes_ (0),
+    length_ (0),
+    count_ (0),
+    synced_bytes_ (0),
+    synced_length_ (0),
+    synced_count_ (0),
+    hwm_ (hwm),
+    queue_state_ (ACE_Message_Queue_Base::ACTIVATED),
+    waiters_ (0)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::ACE_Message_Queue_MPSC");
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Message_Queue_MPSC ()
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Message_Queue_MPSC");
+
+  // The base class destructor would only release the list, not the
+  // inbox.
+  this->close ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::open (size_t hwm,
+                                                          size_t lwm,
+                                                          ACE_Notification_Strategy *ns)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::open");
+
+  if (BASE::open (hwm, lwm, ns) == -1)
+    return -1;
+
+  this->inbox_ = 0;
+  this->bytes_ = 0;
+  this->length_ = 0;
+  this->count_ = 0;
+  this->synced_bytes_ = 0;
+  this->synced_length_ = 0;
+  this->synced_count_ = 0;
+  this->hwm_ = hwm;
+  this->queue_state_ = this->state_;
+  return 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail (ACE_Message_Block *new_item,
+                                                                  ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail");
+
+  if (new_item == 0)
+    return -1;
+
+  if (this->queue_state_.load (std::memory_order_acquire)
+        == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  // Chains and a full queue take the locked path, which waits for the
+  // queue to drain below the high water mark.
+  if (new_item->next () != 0
+      || this->bytes_.load (std::memory_order_relaxed)
+           >= this->hwm_.load (std::memory_order_relaxed))
+    return BASE::enqueue_tail (new_item, timeout);
+
+  size_t mb_bytes = 0;
+  size_t mb_length = 0;
+  new_item->total_size_and_length (mb_bytes, mb_length);
+  this->bytes_.fetch_add (mb_bytes);
+  this->length_.fetch_add (mb_length);
+  size_t const count = this->count_.fetch_add (1) + 1;
+
+  ACE_Message_Block *top = this->inbox_.load (std::memory_order_relaxed);
+  do
+    new_item->next (top);
+  while (!this->inbox_.compare_exchange_weak (top, new_item));
+
+  this->wake_consumer ();
+
+  ACE_Notification_Strategy *notifier = this->notification_strategy_;
+  if (notifier != 0)
+    notifier->notify ();
+
+  return ACE_Utils::truncate_cast<int> (count);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::wake_consumer ()
+{
+  if (this->waiters_.load () > 0)
+    {
+      ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+      this->signal_dequeue_waiters ();
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::drain_i ()
+{
+  ACE_Message_Block *item = this->inbox_.exchange (0);
+  if (item == 0)
+    return;
+
+  // The inbox is linked newest first; reverse it, fixing up the prev
+  // pointers as we go.
+  ACE_Message_Block *const last = item;
+  ACE_Message_Block *first = 0;
+  size_t bytes = 0;
+  size_t length = 0;
+  size_t count = 0;
+  while (item != 0)
+    {
+      ACE_Message_Block *const next = item->next ();
+      item->next (first);
+      if (first != 0)
+        first->prev (item);
+      first = item;
+      item->total_size_and_length (bytes, length);
+      ++count;
+      item = next;
+    }
+
+  first->prev (this->tail_);
+  if (this->tail_ == 0)
+    this->head_ = first;
+  else
+    this->tail_->next (first);
+  this->tail_ = last;
+
+  // Already included in the atomic counters by enqueue_tail().
+  this->cur_bytes_ += bytes;
+  this->cur_length_ += length;
+  this->cur_count_ += count;
+  this->synced_bytes_ += bytes;
+  this->synced_length_ += length;
+  this->synced_count_ += count;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::sync_i ()
+{
+  // Unsigned arithmetic wraps, so adding the difference also handles
+  // counters that went down.
+  if (this->cur_bytes_ != this->synced_bytes_)
+    {
+      this->bytes_.fetch_add (this->cur_bytes_ - this->synced_bytes_);
+      this->synced_bytes_ = this->cur_bytes_;
+    }
+  if (this->cur_length_ != this->synced_length_)
+    {
+      this->length_.fetch_add (this->cur_length_ - this->synced_length_);
+      this->synced_length_ = this->cur_length_;
+    }
+  if (this->cur_count_ != this->synced_count_)
+    {
+      this->count_.fetch_add (this->cur_count_ - this->synced_count_);
+      this->synced_count_ = this->cur_count_;
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_i (ACE_Message_Block *new_item)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_i");
+
+  this->drain_i ();
+  int const result = BASE::enqueue_i (new_item);
+  this->sync_i ();
+  return result == -1 ? -1 : ACE_Utils::truncate_cast<int> (this->count_.load ());
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_deadline_i (ACE_Message_Block *new_item)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_deadline_i");
+
+  this->drain_i ();
+  int const result = BASE::enqueue_deadline_i (new_item);
+  this->sync_i ();
+  return result == -1 ? -1 : ACE_Utils::truncate_cast<int> (this->count_.load ());
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail_i (ACE_Message_Block *new_item)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail_i");
+
+  // Everything in the inbox was enqueued before <new_item>.
+  this->drain_i ();
+  int const result = BASE::enqueue_tail_i (new_item);
+  this->sync_i ();
+  return result == -1 ? -1 : ACE_Utils::truncate_cast<int> (this->count_.load ());
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_head_i (ACE_Message_Block *new_item)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::enqueue_head_i");
+
+  int const result = BASE::enqueue_head_i (new_item);
+  this->sync_i ();
+  return result == -1 ? -1 : ACE_Utils::truncate_cast<int> (this->count_.load ());
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head_i (ACE_Message_Block *&first_item)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head_i");
+
+  if (this->head_ == 0)
+    this->drain_i ();
+  int const result = BASE::dequeue_head_i (first_item);
+  this->sync_i ();
+  return result == -1 ? -1 : ACE_Utils::truncate_cast<int> (this->count_.load ());
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dequeue_prio_i (ACE_Message_Block *&dequeued)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dequeue_prio_i");
+
+  this->drain_i ();
+  int const result = BASE::dequeue_prio_i (dequeued);
+  this->sync_i ();
+  return result == -1 ? -1 : ACE_Utils::truncate_cast<int> (this->count_.load ());
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dequeue_tail_i (ACE_Message_Block *&dequeued)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dequeue_tail_i");
+
+  this->drain_i ();
+  int const result = BASE::dequeue_tail_i (dequeued);
+  this->sync_i ();
+  return result == -1 ? -1 : ACE_Utils::truncate_cast<int> (this->count_.load ());
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dequeue_deadline_i (ACE_Message_Block *&dequeued)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dequeue_deadline_i");
+
+  this->drain_i ();
+  int const result = BASE::dequeue_deadline_i (dequeued);
+  this->sync_i ();
+  return result == -1 ? -1 : ACE_Utils::truncate_cast<int> (this->count_.load ());
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::flush_i ()
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::flush_i");
+
+  this->drain_i ();
+  int const result = BASE::flush_i ();
+  this->sync_i ();
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::is_full_i ()
+{
+  return this->bytes_.load () >= this->high_water_mark_;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::is_empty_i ()
+{
+  if (this->head_ == 0)
+    this->drain_i ();
+  return this->tail_ == 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::deactivate_i (int pulse)
+{
+  int const previous_state = BASE::deactivate_i (pulse);
+  this->queue_state_.store (this->state_, std::memory_order_release);
+  return previous_state;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::activate_i ()
+{
+  int const previous_state = BASE::activate_i ();
+  this->queue_state_.store (this->state_, std::memory_order_release);
+  return previous_state;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::wait_not_empty_cond (ACE_Time_Value *timeout)
+{
+  if (!this->is_empty_i ())
+    return 0;
+
+  // Announce ourselves before the base class looks at the inbox again.
+  ++this->waiters_;
+  int const result = BASE::wait_not_empty_cond (timeout);
+  --this->waiters_;
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::is_full ()
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::is_full");
+  return this->bytes_.load () >= this->hwm_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::is_empty ()
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::is_empty");
+  return this->count_.load () == 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_bytes ()
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_bytes");
+  return this->bytes_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_length ()
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_length");
+  return this->length_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_count ()
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_count");
+  return this->count_.load ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_bytes (size_t new_value)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_bytes");
+  ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+
+  this->drain_i ();
+  this->cur_bytes_ = new_value;
+  this->sync_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_length (size_t new_value)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::message_length");
+  ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+
+  this->drain_i ();
+  this->cur_length_ = new_value;
+  this->sync_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::high_water_mark (size_t hwm)
+{
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::high_water_mark");
+  ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+
+  this->high_water_mark_ = hwm;
+  this->hwm_ = hwm;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY>::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("total bytes = %B\n")
+                 ACE_TEXT ("total length = %B\n")
+                 ACE_TEXT ("total messages = %B\n")
+                 ACE_TEXT ("waiting consumers = %d\n"),
+                 this->bytes_.load (),
+                 this->length_.load (),
+                 this->count_.load (),
+                 this->waiters_.load ()));
+  BASE::dump ();
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_MESSAGE_QUEUE_MPSC_T_CPP */
@@ -0,0 +1,190 @@
+/* -*- C++ -*- */
+
+//=============================================================================
+/**
+ *  @file    Message_Queue_MPSC_T.h
+ *
+ *  ACE_Message_Queue variant whose enqueue_tail() does not take the
+ *  queue lock.
+ */
+//=============================================================================
+
+#ifndef ACE_MESSAGE_QUEUE_MPSC_T_H
+#define ACE_MESSAGE_QUEUE_MPSC_T_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/Message_Queue_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include <atomic>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Message_Queue_MPSC
+ *
+ * @brief An ACE_Message_Queue whose producers do not contend on the
+ * queue lock.
+ *
+ * enqueue_tail() (and therefore ACE_Task::putq()) pushes the message
+ * onto a lock-free inbox with a single compare-and-swap and keeps the
+ * message, byte and length counts in atomic counters, so any number
+ * of producer threads can enqueue concurrently without serializing on
+ * each other.  The consumer side moves the whole inbox into the
+ * ordinary ACE_Message_Queue list with one atomic exchange whenever
+ * that list runs empty, preserving FIFO order.
+ *
+ * The queue lock is only taken by producers when they have to block
+ * because the queue is full, or when a consumer is sleeping on the
+ * empty queue and has to be woken up; both use the queue's condition
+ * variables, which are futex based on Linux.  Consumers still take
+ * the lock, so dequeueing from several threads is safe, but with a
+ * single consumer thread the lock is never contended.
+ *
+ * All other operations (enqueue_head(), enqueue_prio(),
+ * enqueue_deadline(), chained messages, dequeue_prio(),
+ * dequeue_tail(), ...) keep the behavior of ACE_Message_Queue: they
+ * first move the inbox into the list and then run under the lock.
+ *
+ * The high water mark is a soft limit: producers that find the queue
+ * below it enqueue without further checks, so the queue can overshoot
+ * it by up to one message per producer thread.
+ *
+ * ACE_Message_Queue_Iterator and ACE_Message_Queue_Reverse_Iterator
+ * only see messages that a consumer operation has already moved out
+ * of the inbox.
+ *
+ * This queue can be passed to an ACE_Task or ACE_Stream module in
+ * place of the default ACE_Message_Queue.
+ */
+template <ACE_SYNCH_DECL, class TIME_POLICY = ACE_System_Time_Policy>
+class ACE_Message_Queue_MPSC : public ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>
+{
+public:
+  typedef ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY> BASE;
+
+  /// Initialize the queue, see ACE_Message_Queue for the parameters.
+  ACE_Message_Queue_MPSC (size_t hwm = ACE_Message_Queue_Base::DEFAULT_HWM,
+                          size_t lwm = ACE_Message_Queue_Base::DEFAULT_LWM,
+                          ACE_Notification_Strategy *ns = 0);
+
+  /// Releases all resources from the message queue.
+  virtual ~ACE_Message_Queue_MPSC ();
+
+  virtual int open (size_t hwm = ACE_Message_Queue_Base::DEFAULT_HWM,
+                    size_t lwm = ACE_Message_Queue_Base::DEFAULT_LWM,
+                    ACE_Notification_Strategy *ns = 0);
+
+  /**
+   * Enqueue @a new_item at the end of the queue without taking the
+   * queue lock unless the queue is full.  Chained messages (with
+   * next() set) take the locked path of ACE_Message_Queue.
+   *
+   * @retval >0 The number of messages on the queue after adding
+   *            this one.
+   * @retval -1 On failure.  errno is set to ESHUTDOWN if the queue is
+   *            deactivated and to EWOULDBLOCK if @a timeout elapsed.
+   */
+  virtual int enqueue_tail (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /// True if the queue holds at least the high water mark of bytes;
+  /// does not take the lock.
+  virtual bool is_full ();
+
+  /// True if the queue holds no messages; does not take the lock.
+  virtual bool is_empty ();
+
+  /// Number of bytes, length and messages in the queue; do not take
+  /// the lock.
+  virtual size_t message_bytes ();
+  virtual size_t message_length ();
+  virtual size_t message_count ();
+
+  virtual void message_bytes (size_t new_size);
+  virtual void message_length (size_t new_length);
+
+  virtual void high_water_mark (size_t hwm);
+  using BASE::high_water_mark;
+
+  /// Dump the state of an object.
+  virtual void dump () const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  // = Hooks into ACE_Message_Queue that keep the atomic counters and
+  //   the inbox in step with the locked list.
+  virtual int enqueue_i (ACE_Message_Block *new_item);
+  virtual int enqueue_deadline_i (ACE_Message_Block *new_item);
+  virtual int enqueue_tail_i (ACE_Message_Block *new_item);
+  virtual int enqueue_head_i (ACE_Message_Block *new_item);
+  virtual int dequeue_head_i (ACE_Message_Block *&first_item);
+  virtual int dequeue_prio_i (ACE_Message_Block *&dequeued);
+  virtual int dequeue_tail_i (ACE_Message_Block *&first_item);
+  virtual int dequeue_deadline_i (ACE_Message_Block *&first_item);
+  virtual int flush_i ();
+  virtual bool is_full_i ();
+  virtual bool is_empty_i ();
+  virtual int deactivate_i (int pulse = 0);
+  virtual int activate_i ();
+  virtual int wait_not_empty_cond (ACE_Time_Value *timeout);
+
+  /// Move all messages from the inbox to the end of the locked list
+  /// (assumes the lock is held).
+  void drain_i ();
+
+  /// Fold the changes ACE_Message_Queue made to its list counters
+  /// into the atomic counters (assumes the lock is held).
+  void sync_i ();
+
+  /// Wake a consumer sleeping on the empty queue, if there is one
+  /// (must be called without the lock held).
+  void wake_consumer ();
+
+  /// Last pushed message; the inbox is linked newest to oldest
+  /// through ACE_Message_Block::next().
+  std::atomic<ACE_Message_Block *> inbox_;
+
+  /// Number of bytes, length and messages in the inbox plus the list.
+  std::atomic<size_t> bytes_;
+  std::atomic<size_t> length_;
+  std::atomic<size_t> count_;
+
+  /// Values of the list counters last folded into the atomic
+  /// counters by sync_i() (protected by the lock).
+  size_t synced_bytes_;
+  size_t synced_length_;
+  size_t synced_count_;
+
+  /// Copies of the high water mark and the queue state that producers
+  /// read without the lock.
+  std::atomic<size_t> hwm_;
+  std::atomic<int> queue_state_;
+
+  /// Number of consumers sleeping in wait_not_empty_cond().
+  std::atomic<int> waiters_;
+
+private:
+  ACE_Message_Queue_MPSC (const ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY> &) = delete;
+  void operator= (const ACE_Message_Queue_MPSC<ACE_SYNCH_USE, TIME_POLICY> &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Message_Queue_MPSC_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Message_Queue_MPSC_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_MESSAGE_QUEUE_MPSC_T_H */
@@ -196,6 +196,14 @@ namespace ACE_OS
                        unsigned long &bytes_received);
 #endif
 
+#if defined (ACE_HAS_RECVMMSG)
+  ACE_NAMESPACE_INLINE_FUNCTION
+  int recvmmsg (ACE_HANDLE handle,
+                struct mmsghdr *msgvec,
+                unsigned int vlen,
+                int flags);
+#endif /* ACE_HAS_RECVMMSG */
+
   ACE_NAMESPACE_INLINE_FUNCTION
   ssize_t recvv (ACE_HANDLE handle,
                  iovec *iov,
@@ -228,6 +236,14 @@ namespace ACE_OS
                        unsigned long &bytes_sent);
 #endif
 
+#if defined (ACE_HAS_SENDMMSG)
+  ACE_NAMESPACE_INLINE_FUNCTION
+  int sendmmsg (ACE_HANDLE handle,
+                struct mmsghdr *msgvec,
+                unsigned int vlen,
+                int flags);
+#endif /* ACE_HAS_SENDMMSG */
+
   ACE_NAMESPACE_INLINE_FUNCTION
   ssize_t sendto (ACE_HANDLE handle,
                   const char *buf,
@@ -503,6 +503,18 @@ ACE_OS::recvmsg (ACE_HANDLE handle, struct msghdr *msg, int flags)
 #endif /* ACE_LACKS_RECVMSG */
 }
 
+#if defined (ACE_HAS_RECVMMSG)
+ACE_INLINE int
+ACE_OS::recvmmsg (ACE_HANDLE handle,
+                  struct mmsghdr *msgvec,
+                  unsigned int vlen,
+                  int flags)
+{
+  ACE_OS_TRACE ("ACE_OS::recvmmsg");
+  ACE_SOCKCALL_RETURN (::recvmmsg (handle, msgvec, vlen, flags, 0), int, -1);
+}
+#endif /* ACE_HAS_RECVMMSG */
+
 ACE_INLINE ssize_t
 ACE_OS::recvv (ACE_HANDLE handle,
                iovec *buffers,
@@ -664,6 +676,18 @@ ACE_OS::sendmsg (ACE_HANDLE handle,
 #endif /* ACE_LACKS_SENDMSG */
 }
 
+#if defined (ACE_HAS_SENDMMSG)
+ACE_INLINE int
+ACE_OS::sendmmsg (ACE_HANDLE handle,
+                  struct mmsghdr *msgvec,
+                  unsigned int vlen,
+                  int flags)
+{
+  ACE_OS_TRACE ("ACE_OS::sendmmsg");
+  ACE_SOCKCALL_RETURN (::sendmmsg (handle, msgvec, vlen, flags), int, -1);
+}
+#endif /* ACE_HAS_SENDMMSG */
+
 ACE_INLINE ssize_t
 ACE_OS::sendto (ACE_HANDLE handle,
                 const char *buf,
@@ -9,12 +9,15 @@
       || !defined (ACE_HAS_WINSOCK2) || (ACE_HAS_WINSOCK2 == 0) \
       || defined (ACE_USE_SELECT_REACTOR_FOR_REACTOR_IMPL) \
       || defined (ACE_USE_TP_REACTOR_FOR_REACTOR_IMPL) \
-      || defined (ACE_USE_DEV_POLL_REACTOR_FOR_REACTOR_IMPL)
+      || defined (ACE_USE_DEV_POLL_REACTOR_FOR_REACTOR_IMPL) \
+      || defined (ACE_USE_URING_REACTOR_FOR_REACTOR_IMPL)
 #  if defined (ACE_USE_TP_REACTOR_FOR_REACTOR_IMPL)
 #    include "ace/TP_Reactor.h"
 #  else
 #    if defined (ACE_USE_DEV_POLL_REACTOR_FOR_REACTOR_IMPL)
 #      include "ace/Dev_Poll_Reactor.h"
+#    elif defined (ACE_USE_URING_REACTOR_FOR_REACTOR_IMPL)
+#      include "ace/Uring_Reactor.h"
 #    else
 #      include "ace/Select_Reactor.h"
 #    endif /* ACE_USE_DEV_POLL_REACTOR_FOR_REACTOR_IMPL */
@@ -53,7 +56,8 @@ ACE_Reactor::ACE_Reactor (ACE_Reactor_Impl *impl,
       || !defined (ACE_HAS_WINSOCK2) || (ACE_HAS_WINSOCK2 == 0) \
       || defined (ACE_USE_SELECT_REACTOR_FOR_REACTOR_IMPL) \
       || defined (ACE_USE_TP_REACTOR_FOR_REACTOR_IMPL) \
-      || defined (ACE_USE_DEV_POLL_REACTOR_FOR_REACTOR_IMPL)
+      || defined (ACE_USE_DEV_POLL_REACTOR_FOR_REACTOR_IMPL) \
+      || defined (ACE_USE_URING_REACTOR_FOR_REACTOR_IMPL)
 #  if defined (ACE_USE_TP_REACTOR_FOR_REACTOR_IMPL)
       ACE_NEW (impl,
                ACE_TP_Reactor);
@@ -61,6 +65,9 @@ ACE_Reactor::ACE_Reactor (ACE_Reactor_Impl *impl,
 #    if defined (ACE_USE_DEV_POLL_REACTOR_FOR_REACTOR_IMPL)
       ACE_NEW (impl,
                ACE_Dev_Poll_Reactor);
+#    elif defined (ACE_USE_URING_REACTOR_FOR_REACTOR_IMPL)
+      ACE_NEW (impl,
+               ACE_Uring_Reactor);
 #    else
       ACE_NEW (impl,
                ACE_Select_Reactor);
@@ -220,11 +220,35 @@ int
 ACE_SOCK_Acceptor::shared_open (const ACE_Addr &local_sap,
                                 int protocol_family,
                                 int backlog,
-                                int ipv6_only)
+                                int ipv6_only,
+                                int reuse_port)
 {
   ACE_TRACE ("ACE_SOCK_Acceptor::shared_open");
   int error = 0;
 
+  // SO_REUSEPORT only lets the sockets share the address if it is
+  // set on each of them before they are bound.
+  if (reuse_port != 0)
+    {
+#if defined (SO_REUSEPORT)
+      int one = 1;
+      if (this->set_option (SOL_SOCKET,
+                            SO_REUSEPORT,
+                            &one,
+                            sizeof one) == -1)
+        error = 1;
+#else
+      errno = ENOTSUP;
+      error = 1;
+#endif /* SO_REUSEPORT */
+      if (error != 0)
+        {
+          ACE_Errno_Guard g (errno);
+          this->close ();
+          return -1;
+        }
+    }
+
 #if !defined (ACE_HAS_IPV6)
   ACE_UNUSED_ARG (ipv6_only);
 #else /* defined (ACE_HAS_IPV6) */
@@ -319,7 +343,8 @@ ACE_SOCK_Acceptor::open (const ACE_Addr &local_sap,
                          int protocol_family,
                          int backlog,
                          int protocol,
-                         int ipv6_only)
+                         int ipv6_only,
+                         int reuse_port)
 {
   ACE_TRACE ("ACE_SOCK_Acceptor::open");
 
@@ -338,7 +363,8 @@ ACE_SOCK_Acceptor::open (const ACE_Addr &local_sap,
     return this->shared_open (local_sap,
                               protocol_family,
                               backlog,
-                              ipv6_only);
+                              ipv6_only,
+                              reuse_port);
 }
 
 ACE_SOCK_Acceptor::ACE_SOCK_Acceptor (const ACE_Addr &local_sap,
@@ -374,7 +400,8 @@ ACE_SOCK_Acceptor::open (const ACE_Addr &local_sap,
                          int protocol_family,
                          int backlog,
                          int protocol,
-                         int ipv6_only)
+                         int ipv6_only,
+                         int reuse_port)
 {
   ACE_TRACE ("ACE_SOCK_Acceptor::open");
 
@@ -398,7 +425,8 @@ ACE_SOCK_Acceptor::open (const ACE_Addr &local_sap,
     return this->shared_open (local_sap,
                               protocol_family,
                               backlog,
-                              ipv6_only);
+                              ipv6_only,
+                              reuse_port);
 }
 
 // General purpose routine for performing server ACE_SOCK creation.
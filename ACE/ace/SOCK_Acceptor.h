@@ -75,6 +75,10 @@ public:
    * @a ipv6_only is used when opening a IPv6 acceptor. If non-zero,
    * the socket will only accept connections from IPv6 peers. If zero
    * the socket will accept both IPv4 and v6 if it is able to.
+   * If @a reuse_port is non-zero the @c SO_REUSEPORT option is set
+   * before binding, so that several sockets can listen on the same
+   * address and the kernel spreads the connections over them.  The
+   * open fails with @c ENOTSUP where @c SO_REUSEPORT is not defined.
    * @retval Returns 0 on success and
    * -1 on failure.
    */
@@ -83,7 +87,8 @@ public:
             int protocol_family = PF_UNSPEC,
             int backlog = ACE_DEFAULT_BACKLOG,
             int protocol = 0,
-            int ipv6_only = 0);
+            int ipv6_only = 0,
+            int reuse_port = 0);
 
   /// Initialize a passive-mode QoS-enabled acceptor socket.  Returns 0
   /// on success and -1 on failure.
@@ -95,7 +100,8 @@ public:
             int protocol_family = PF_UNSPEC,
             int backlog = ACE_DEFAULT_BACKLOG,
             int protocol = 0,
-            int ipv6_only = 0);
+            int ipv6_only = 0,
+            int reuse_port = 0);
 
   /// Close the socket.  Returns 0 on success and -1 on failure.
   int close ();
@@ -169,7 +175,8 @@ protected:
   int shared_open (const ACE_Addr &local_sap,
                    int protocol_family,
                    int backlog,
-                   int ipv6_only);
+                   int ipv6_only,
+                   int reuse_port = 0);
 
 private:
   /// Do not allow this function to percolate up to this interface...
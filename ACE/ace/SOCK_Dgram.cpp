@@ -8,6 +8,8 @@
 #include "ace/OS_NS_ctype.h"
 #include "ace/os_include/net/os_if.h"
 #include "ace/Truncate.h"
+#include "ace/Message_Block.h"
+#include "ace/Min_Max.h"
 #if defined (ACE_HAS_ALLOC_HOOKS)
 # include "ace/Malloc_Base.h"
 #endif /* ACE_HAS_ALLOC_HOOKS */
@@ -574,6 +576,243 @@ ACE_SOCK_Dgram::send (const void *buf,
     }
 }
 
+#if defined (ACE_HAS_RECVMMSG) || defined (ACE_HAS_SENDMMSG)
+// Maximum number of datagrams passed to one <recvmmsg> or <sendmmsg>
+// call; larger requests are split.
+static unsigned int const ACE_SOCK_DGRAM_MMSG_MAX = 64;
+#endif /* ACE_HAS_RECVMMSG || ACE_HAS_SENDMMSG */
+
+ssize_t
+ACE_SOCK_Dgram::recv_n_msgs (ACE_Message_Block *msgs[],
+                             size_t count,
+                             ACE_INET_Addr addrs[],
+                             int flags,
+                             const ACE_Time_Value *timeout) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::recv_n_msgs");
+
+  if (count == 0)
+    return 0;
+
+  if (timeout != 0
+      && ACE::handle_read_ready (this->get_handle (), timeout) != 1)
+    return -1;
+
+  size_t received = 0;
+
+#if defined (ACE_HAS_RECVMMSG)
+  mmsghdr hdrs[ACE_SOCK_DGRAM_MMSG_MAX];
+  iovec iov[ACE_SOCK_DGRAM_MMSG_MAX];
+
+  while (received < count)
+    {
+      unsigned int const chunk =
+        static_cast<unsigned int> (ACE_MIN (count - received,
+                                            static_cast<size_t> (ACE_SOCK_DGRAM_MMSG_MAX)));
+
+      ACE_OS::memset (hdrs, 0, chunk * sizeof (mmsghdr));
+      for (unsigned int i = 0; i < chunk; ++i)
+        {
+          ACE_Message_Block *mb = msgs[received + i];
+          iov[i].iov_base = mb->wr_ptr ();
+          iov[i].iov_len = mb->space ();
+          hdrs[i].msg_hdr.msg_iov = &iov[i];
+          hdrs[i].msg_hdr.msg_iovlen = 1;
+          if (addrs != 0)
+            {
+              hdrs[i].msg_hdr.msg_name = addrs[received + i].get_addr ();
+              hdrs[i].msg_hdr.msg_namelen = addrs[received + i].get_size ();
+            }
+        }
+
+      // Only wait for the very first datagram; after that take what
+      // is already queued on the socket.
+      int const chunk_flags =
+        received == 0 ? flags | MSG_WAITFORONE : flags | MSG_DONTWAIT;
+      int const n = ACE_OS::recvmmsg (this->get_handle (),
+                                      hdrs,
+                                      chunk,
+                                      chunk_flags);
+      if (n == -1)
+        {
+          if (received == 0)
+            return -1;
+          break;
+        }
+
+      for (int i = 0; i < n; ++i)
+        {
+          msgs[received + i]->wr_ptr (hdrs[i].msg_len);
+          if (addrs != 0)
+            {
+              ACE_INET_Addr &addr = addrs[received + i];
+              addr.set_size (static_cast<int> (hdrs[i].msg_hdr.msg_namelen));
+              addr.set_type (((sockaddr *) addr.get_addr ())->sa_family);
+            }
+        }
+
+      received += n;
+      if (static_cast<unsigned int> (n) < chunk)
+        break;
+    }
+#else
+  ACE_INET_Addr from;
+
+  for (; received < count; ++received)
+    {
+      int recv_flags = flags;
+      if (received > 0)
+        {
+# if defined (MSG_DONTWAIT)
+          recv_flags |= MSG_DONTWAIT;
+# else
+          // No way to poll for more datagrams without blocking.
+          break;
+# endif /* MSG_DONTWAIT */
+        }
+
+      ACE_Message_Block *mb = msgs[received];
+      ssize_t const n = this->recv (mb->wr_ptr (),
+                                    mb->space (),
+                                    addrs != 0 ? addrs[received] : from,
+                                    recv_flags);
+      if (n == -1)
+        {
+          if (received == 0)
+            return -1;
+          break;
+        }
+      mb->wr_ptr (static_cast<size_t> (n));
+    }
+#endif /* ACE_HAS_RECVMMSG */
+
+  return static_cast<ssize_t> (received);
+}
+
+ssize_t
+ACE_SOCK_Dgram::send_n_msgs (const iovec iov[],
+                             const int iovcnt[],
+                             size_t count,
+                             const ACE_Addr &addr,
+                             int flags) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::send_n_msgs");
+
+  size_t sent = 0;
+
+#if defined (ACE_HAS_SENDMMSG)
+  mmsghdr hdrs[ACE_SOCK_DGRAM_MMSG_MAX];
+
+  while (sent < count)
+    {
+      unsigned int const chunk =
+        static_cast<unsigned int> (ACE_MIN (count - sent,
+                                            static_cast<size_t> (ACE_SOCK_DGRAM_MMSG_MAX)));
+
+      ACE_OS::memset (hdrs, 0, chunk * sizeof (mmsghdr));
+      const iovec *msg_iov = iov;
+      for (unsigned int i = 0; i < chunk; ++i)
+        {
+          hdrs[i].msg_hdr.msg_iov = const_cast<iovec *> (msg_iov);
+          hdrs[i].msg_hdr.msg_iovlen = iovcnt[sent + i];
+          hdrs[i].msg_hdr.msg_name = addr.get_addr ();
+          hdrs[i].msg_hdr.msg_namelen = addr.get_size ();
+          msg_iov += iovcnt[sent + i];
+        }
+
+      int const n = ACE_OS::sendmmsg (this->get_handle (),
+                                      hdrs,
+                                      chunk,
+                                      flags);
+      if (n == -1)
+        {
+          if (sent == 0)
+            return -1;
+          break;
+        }
+
+      for (int i = 0; i < n; ++i)
+        iov += iovcnt[sent + i];
+
+      sent += n;
+      if (static_cast<unsigned int> (n) < chunk)
+        break;
+    }
+#else
+  for (; sent < count; ++sent)
+    {
+      if (this->send (iov, iovcnt[sent], addr, flags) == -1)
+        {
+          if (sent == 0)
+            return -1;
+          break;
+        }
+      iov += iovcnt[sent];
+    }
+#endif /* ACE_HAS_SENDMMSG */
+
+  return static_cast<ssize_t> (sent);
+}
+
+ssize_t
+ACE_SOCK_Dgram::send_n_msgs (ACE_Message_Block *const msgs[],
+                             size_t count,
+                             const ACE_Addr &addr,
+                             int flags) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::send_n_msgs");
+
+  // Gather as many datagrams as fit in one iovec array at a time.
+  iovec iov[ACE_IOV_MAX];
+  int iovcnt[ACE_IOV_MAX];
+  size_t sent = 0;
+
+  while (sent < count)
+    {
+      size_t n_iov = 0;
+      size_t n_msgs = 0;
+
+      while (sent + n_msgs < count)
+        {
+          size_t blocks = 0;
+          for (const ACE_Message_Block *mb = msgs[sent + n_msgs];
+               mb != 0;
+               mb = mb->cont ())
+            ++blocks;
+
+          if (n_iov + blocks > ACE_IOV_MAX)
+            break;
+
+          for (const ACE_Message_Block *mb = msgs[sent + n_msgs];
+               mb != 0;
+               mb = mb->cont ())
+            {
+              iov[n_iov].iov_base = mb->rd_ptr ();
+              iov[n_iov].iov_len = mb->length ();
+              ++n_iov;
+            }
+          iovcnt[n_msgs++] = static_cast<int> (blocks);
+        }
+
+      if (n_msgs == 0)
+        {
+          // A single datagram with more than ACE_IOV_MAX blocks.
+          errno = EMSGSIZE;
+          break;
+        }
+
+      ssize_t const n = this->send_n_msgs (iov, iovcnt, n_msgs, addr, flags);
+      if (n == -1)
+        break;
+
+      sent += n;
+      if (static_cast<size_t> (n) < n_msgs)
+        break;
+    }
+
+  return sent == 0 && count != 0 ? -1 : static_cast<ssize_t> (sent);
+}
+
 int
 ACE_SOCK_Dgram::set_nic (const ACE_TCHAR *net_if,
                          int addr_family)
@@ -27,6 +27,7 @@
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class ACE_Time_Value;
+class ACE_Message_Block;
 
 /**
  * @class ACE_SOCK_Dgram
@@ -163,6 +164,47 @@ public:
                 int flags,
                 const ACE_Time_Value *timeout) const;
 
+  /**
+   * Receive up to @a count datagrams with as few system calls as
+   * possible (uses <recvmmsg(2)> where available).  Datagram @c i is
+   * stored at @c msgs[i]->wr_ptr(), truncated to @c msgs[i]->space(),
+   * and the write pointer is advanced past it.  If @a addrs is not 0
+   * the sender of datagram @c i is stored in @c addrs[i].  Only the
+   * wait for the first datagram is subject to @a timeout (0 means
+   * block, as with the other <recv> methods); the call returns as soon
+   * as no more datagrams are queued on the socket.  Returns the number
+   * of datagrams received, or -1 with @c errno set if none could be
+   * received (@c errno == ETIME on timeout).
+   */
+  ssize_t recv_n_msgs (ACE_Message_Block *msgs[],
+                       size_t count,
+                       ACE_INET_Addr addrs[] = 0,
+                       int flags = 0,
+                       const ACE_Time_Value *timeout = 0) const;
+
+  /**
+   * Send @a count datagrams to @a addr with as few system calls as
+   * possible (uses <sendmmsg(2)> where available).  Datagram @c i is
+   * made up of the data of the message block chain @c msgs[i] (linked
+   * through @c cont()).  Returns the number of datagrams sent, which
+   * may be less than @a count if the socket would block, or -1 with
+   * @c errno set if none could be sent.
+   */
+  ssize_t send_n_msgs (ACE_Message_Block *const msgs[],
+                       size_t count,
+                       const ACE_Addr &addr,
+                       int flags = 0) const;
+
+  /**
+   * Gather version of the above: datagram @c i is made up of the next
+   * @c iovcnt[i] entries of @a iov.
+   */
+  ssize_t send_n_msgs (const iovec iov[],
+                       const int iovcnt[],
+                       size_t count,
+                       const ACE_Addr &addr,
+                       int flags = 0) const;
+
   /// Send <buffer_count> worth of @a buffers to @a addr using overlapped
   /// I/O (uses <WSASendTo>).  Returns 0 on success.
   ssize_t send (const iovec buffers[],
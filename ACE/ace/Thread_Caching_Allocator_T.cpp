@@ -0,0 +1,421 @@
+#ifndef ACE_THREAD_CACHING_ALLOCATOR_T_CPP
+#define ACE_THREAD_CACHING_ALLOCATOR_T_CPP
+
+#include "ace/Thread_Caching_Allocator_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE_Tc(ACE_Thread_Caching_Allocator)
+
+// Every chunk starts with a HEADER holding its size class (or
+// UNCACHED); the pointer handed out is just past it.  Free chunks are
+// linked through the first word of that payload, and the first chunk
+// of a magazine in the depot links to the next magazine through its
+// second word, which is why the smallest class is 16 bytes.
+//
+// Bonwick's magazine scheme keeps the per-thread <previous_>
+// magazine either empty or full: malloc() swaps in a non-empty
+// <previous_> before it goes to the depot, free() swaps in an empty
+// one before it hands a full magazine to the depot, so a thread that
+// alternates between allocating and freeing around a magazine
+// boundary does not bounce magazines through the depot.
+
+template <class ACE_LOCK>
+ACE_Thread_Caching_Allocator<ACE_LOCK>::Thread_Cache::Thread_Cache ()
+  : owner_ (0),
+    prev_ (0),
+    next_ (0)
+{
+  for (int c = 0; c < CLASS_COUNT; ++c)
+    {
+      this->loaded_[c].head_ = 0;
+      this->loaded_[c].rounds_ = 0;
+      this->previous_[c].head_ = 0;
+      this->previous_[c].rounds_ = 0;
+    }
+}
+
+template <class ACE_LOCK>
+ACE_Thread_Caching_Allocator<ACE_LOCK>::Thread_Cache::~Thread_Cache ()
+{
+  // Thread exit; the allocator has not released this cache yet.
+  if (this->owner_ != 0)
+    this->owner_->release_cache (this);
+}
+
+template <class ACE_LOCK>
+ACE_Thread_Caching_Allocator<ACE_LOCK>::ACE_Thread_Caching_Allocator (size_t max_size,
+                                                                      size_t magazine_size,
+                                                                      size_t depot_size,
+                                                                      ACE_Allocator *backing,
+                                                                      bool delete_backing)
+  : max_size_ (max_size),
+    depot_size_ (depot_size),
+    backing_ (backing),
+    delete_backing_ (delete_backing),
+    caches_ (0)
+{
+  ACE_TRACE ("ACE_Thread_Caching_Allocator<ACE_LOCK>::ACE_Thread_Caching_Allocator");
+
+  if (this->backing_ == 0)
+    {
+      this->backing_ = ACE_Allocator::instance ();
+      this->delete_backing_ = false;
+    }
+
+  size_t const largest =
+    static_cast<size_t> (1) << (MIN_SHIFT + CLASS_COUNT - 1);
+  if (this->max_size_ > largest)
+    this->max_size_ = largest;
+  if (magazine_size == 0)
+    magazine_size = 1;
+
+  for (int c = 0; c < CLASS_COUNT; ++c)
+    {
+      size_t const rounds =
+        ACE_DEFAULT_THREAD_CACHE_MAGAZINE_BYTES >> (c + MIN_SHIFT);
+      this->capacity_[c] = rounds == 0 ? 1 : rounds;
+      if (this->capacity_[c] > magazine_size)
+        this->capacity_[c] = magazine_size;
+      this->depot_[c] = 0;
+      this->depot_count_[c] = 0;
+    }
+}
+
+template <class ACE_LOCK>
+ACE_Thread_Caching_Allocator<ACE_LOCK>::~ACE_Thread_Caching_Allocator ()
+{
+  ACE_TRACE ("ACE_Thread_Caching_Allocator<ACE_LOCK>::~ACE_Thread_Caching_Allocator");
+
+  // All caches, including the calling thread's, are deleted by
+  // release_all(); make sure ACE_TSS does not delete ours again.  The
+  // caches of other threads are no longer reachable through <cache_>
+  // once its key is freed.
+  Thread_Cache *mine = this->cache_.ts_object (0);
+  if (mine != 0 && mine->owner_ == 0)
+    delete mine;
+  this->release_all (true);
+
+  if (this->delete_backing_)
+    delete this->backing_;
+  this->backing_ = 0;
+}
+
+template <class ACE_LOCK> int
+ACE_Thread_Caching_Allocator<ACE_LOCK>::size_class (size_t nbytes) const
+{
+  if (nbytes > this->max_size_)
+    return -1;
+
+  int c = 0;
+  for (size_t size = static_cast<size_t> (1) << MIN_SHIFT;
+       size < nbytes;
+       size <<= 1)
+    ++c;
+  return c;
+}
+
+template <class ACE_LOCK> typename ACE_Thread_Caching_Allocator<ACE_LOCK>::Thread_Cache *
+ACE_Thread_Caching_Allocator<ACE_LOCK>::cache ()
+{
+  Thread_Cache *cache = this->cache_;
+  if (cache != 0 && cache->owner_ == 0)
+    {
+      ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, 0);
+      cache->owner_ = this;
+      cache->prev_ = 0;
+      cache->next_ = this->caches_;
+      if (this->caches_ != 0)
+        this->caches_->prev_ = cache;
+      this->caches_ = cache;
+    }
+  return cache;
+}
+
+template <class ACE_LOCK> void *
+ACE_Thread_Caching_Allocator<ACE_LOCK>::allocate_chunk (int c)
+{
+  size_t const size = static_cast<size_t> (1) << (c + MIN_SHIFT);
+  char *raw = static_cast<char *> (this->backing_->malloc (HEADER + size));
+  if (raw == 0)
+    return 0;
+  *reinterpret_cast<size_t *> (raw) = static_cast<size_t> (c);
+  return raw + HEADER;
+}
+
+template <class ACE_LOCK> void *
+ACE_Thread_Caching_Allocator<ACE_LOCK>::malloc (size_t nbytes)
+{
+  int const c = this->size_class (nbytes);
+  if (c < 0)
+    {
+      char *raw =
+        static_cast<char *> (this->backing_->malloc (HEADER + nbytes));
+      if (raw == 0)
+        return 0;
+      *reinterpret_cast<size_t *> (raw) = UNCACHED;
+      return raw + HEADER;
+    }
+
+  Thread_Cache *cache = this->cache ();
+  if (cache == 0)
+    return this->allocate_chunk (c);
+
+  Magazine &loaded = cache->loaded_[c];
+  if (loaded.rounds_ == 0)
+    {
+      Magazine &previous = cache->previous_[c];
+      if (previous.rounds_ != 0)
+        {
+          Magazine const tmp = loaded;
+          loaded = previous;
+          previous = tmp;
+        }
+      else
+        {
+          loaded = this->get_magazine (c);
+          if (loaded.rounds_ == 0)
+            return this->allocate_chunk (c);
+        }
+    }
+
+  void *chunk = loaded.head_;
+  loaded.head_ = *static_cast<void **> (chunk);
+  --loaded.rounds_;
+  return chunk;
+}
+
+template <class ACE_LOCK> void *
+ACE_Thread_Caching_Allocator<ACE_LOCK>::calloc (size_t nbytes,
+                                                char initial_value)
+{
+  void *ptr = this->malloc (nbytes);
+  if (ptr != 0)
+    ACE_OS::memset (ptr, initial_value, nbytes);
+  return ptr;
+}
+
+template <class ACE_LOCK> void *
+ACE_Thread_Caching_Allocator<ACE_LOCK>::calloc (size_t n_elem,
+                                                size_t elem_size,
+                                                char initial_value)
+{
+  if (elem_size != 0 && n_elem > ~static_cast<size_t> (0) / elem_size)
+    {
+      errno = ENOMEM;
+      return 0;
+    }
+  return this->calloc (n_elem * elem_size, initial_value);
+}
+
+template <class ACE_LOCK> void
+ACE_Thread_Caching_Allocator<ACE_LOCK>::free (void *ptr)
+{
+  if (ptr == 0)
+    return;
+
+  char *raw = static_cast<char *> (ptr) - HEADER;
+  size_t const c = *reinterpret_cast<size_t *> (raw);
+  if (c == UNCACHED)
+    {
+      this->backing_->free (raw);
+      return;
+    }
+
+  Thread_Cache *cache = this->cache ();
+  if (cache == 0)
+    {
+      this->backing_->free (raw);
+      return;
+    }
+
+  Magazine &loaded = cache->loaded_[c];
+  if (loaded.rounds_ == this->capacity_[c])
+    {
+      Magazine &previous = cache->previous_[c];
+      if (previous.rounds_ != 0)
+        this->put_magazine (static_cast<int> (c), previous);
+      previous = loaded;
+      loaded.head_ = 0;
+      loaded.rounds_ = 0;
+    }
+
+  *static_cast<void **> (ptr) = loaded.head_;
+  loaded.head_ = ptr;
+  ++loaded.rounds_;
+}
+
+template <class ACE_LOCK> typename ACE_Thread_Caching_Allocator<ACE_LOCK>::Magazine
+ACE_Thread_Caching_Allocator<ACE_LOCK>::get_magazine (int c)
+{
+  Magazine magazine;
+  magazine.head_ = 0;
+  magazine.rounds_ = 0;
+
+  ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, magazine);
+  if (this->depot_[c] != 0)
+    {
+      magazine.head_ = this->depot_[c];
+      magazine.rounds_ = this->capacity_[c];
+      this->depot_[c] = static_cast<void **> (magazine.head_)[1];
+      --this->depot_count_[c];
+    }
+  return magazine;
+}
+
+template <class ACE_LOCK> void
+ACE_Thread_Caching_Allocator<ACE_LOCK>::put_magazine (int c,
+                                                      Magazine const &magazine)
+{
+  {
+    ACE_GUARD (ACE_LOCK, ace_mon, this->lock_);
+    if (this->depot_count_[c] < this->depot_size_)
+      {
+        static_cast<void **> (magazine.head_)[1] = this->depot_[c];
+        this->depot_[c] = magazine.head_;
+        ++this->depot_count_[c];
+        return;
+      }
+  }
+
+  // The depot is full, give the memory back.
+  Magazine surplus = magazine;
+  this->release_magazine (surplus);
+}
+
+template <class ACE_LOCK> void
+ACE_Thread_Caching_Allocator<ACE_LOCK>::release_magazine (Magazine &magazine)
+{
+  while (magazine.head_ != 0)
+    {
+      void *chunk = magazine.head_;
+      magazine.head_ = *static_cast<void **> (chunk);
+      this->backing_->free (static_cast<char *> (chunk) - HEADER);
+    }
+  magazine.rounds_ = 0;
+}
+
+template <class ACE_LOCK> void
+ACE_Thread_Caching_Allocator<ACE_LOCK>::release_cache (Thread_Cache *cache)
+{
+  ACE_GUARD (ACE_LOCK, ace_mon, this->lock_);
+
+  if (cache->prev_ != 0)
+    cache->prev_->next_ = cache->next_;
+  else
+    this->caches_ = cache->next_;
+  if (cache->next_ != 0)
+    cache->next_->prev_ = cache->prev_;
+  cache->owner_ = 0;
+
+  // Full magazines go to the depot while it has room, the rest is
+  // freed.
+  for (int c = 0; c < CLASS_COUNT; ++c)
+    {
+      Magazine *magazines[2] = { &cache->loaded_[c], &cache->previous_[c] };
+      for (int i = 0; i < 2; ++i)
+        {
+          Magazine &magazine = *magazines[i];
+          if (magazine.rounds_ == this->capacity_[c]
+              && this->depot_count_[c] < this->depot_size_)
+            {
+              static_cast<void **> (magazine.head_)[1] = this->depot_[c];
+              this->depot_[c] = magazine.head_;
+              ++this->depot_count_[c];
+              magazine.head_ = 0;
+              magazine.rounds_ = 0;
+            }
+          else
+            this->release_magazine (magazine);
+        }
+    }
+}
+
+template <class ACE_LOCK> void
+ACE_Thread_Caching_Allocator<ACE_LOCK>::release_all (bool delete_caches)
+{
+  ACE_GUARD (ACE_LOCK, ace_mon, this->lock_);
+
+  while (this->caches_ != 0)
+    {
+      Thread_Cache *cache = this->caches_;
+      this->caches_ = cache->next_;
+      for (int c = 0; c < CLASS_COUNT; ++c)
+        {
+          this->release_magazine (cache->loaded_[c]);
+          this->release_magazine (cache->previous_[c]);
+        }
+      cache->owner_ = 0;
+      cache->prev_ = 0;
+      cache->next_ = 0;
+      if (delete_caches)
+        delete cache;
+    }
+
+  for (int c = 0; c < CLASS_COUNT; ++c)
+    {
+      while (this->depot_[c] != 0)
+        {
+          Magazine magazine;
+          magazine.head_ = this->depot_[c];
+          magazine.rounds_ = this->capacity_[c];
+          this->depot_[c] = static_cast<void **> (magazine.head_)[1];
+          this->release_magazine (magazine);
+        }
+      this->depot_count_[c] = 0;
+    }
+}
+
+template <class ACE_LOCK> int
+ACE_Thread_Caching_Allocator<ACE_LOCK>::remove ()
+{
+  ACE_TRACE ("ACE_Thread_Caching_Allocator<ACE_LOCK>::remove");
+
+  this->release_all (false);
+  return this->backing_->remove ();
+}
+
+template <class ACE_LOCK> size_t
+ACE_Thread_Caching_Allocator<ACE_LOCK>::depot_depth (size_t nbytes)
+{
+  int const c = this->size_class (nbytes);
+  if (c < 0)
+    return 0;
+
+  ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, 0);
+  return this->depot_count_[c] * this->capacity_[c];
+}
+
+template <class ACE_LOCK> void
+ACE_Thread_Caching_Allocator<ACE_LOCK>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Thread_Caching_Allocator<ACE_LOCK>::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("max_size_ = %B\ndepot_size_ = %B\n"),
+                 this->max_size_,
+                 this->depot_size_));
+  for (int c = 0; c < CLASS_COUNT; ++c)
+    if (this->depot_count_[c] != 0)
+      ACELIB_DEBUG ((LM_DEBUG,
+                     ACE_TEXT ("%B bytes: %B magazines of %B in the depot\n"),
+                     static_cast<size_t> (1) << (c + MIN_SHIFT),
+                     this->depot_count_[c],
+                     this->capacity_[c]));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_THREAD_CACHING_ALLOCATOR_T_CPP */
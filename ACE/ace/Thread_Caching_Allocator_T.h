@@ -0,0 +1,218 @@
+// -*- C++ -*-
+
+//==========================================================================
+/**
+ *  @file    Thread_Caching_Allocator_T.h
+ *
+ *  Allocator with per-thread caches of free chunks in front of another
+ *  ACE_Allocator.
+ */
+//==========================================================================
+
+#ifndef ACE_THREAD_CACHING_ALLOCATOR_T_H
+#define ACE_THREAD_CACHING_ALLOCATOR_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Malloc_Allocator.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Malloc.h"
+#include "ace/TSS_T.h"
+#include "ace/Default_Constants.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Thread_Caching_Allocator
+ *
+ * @brief A thread caching front-end for another ACE_Allocator.
+ *
+ * Requests up to @a max_size bytes are rounded up to a power of two
+ * and served from a cache of free chunks of that size which belongs
+ * to the calling thread, so neither malloc() nor free() take a lock
+ * in the common case.  Each thread keeps two "magazines" per size: a
+ * thread that runs out (or frees more than two magazines' worth)
+ * exchanges a whole magazine with a depot shared by all threads,
+ * which is the only place the ACE_LOCK is taken.  Only when the depot
+ * has nothing to give, or already holds @a depot_size magazines of
+ * a size, does the allocator call the backing allocator.
+ *
+ * Chunks may be freed by a thread other than the one that allocated
+ * them; they then go into the freeing thread's cache.  When a thread
+ * exits its cached chunks go back to the depot.
+ *
+ * Larger requests are passed straight to the backing allocator, which
+ * must be thread-safe itself, e.g. ACE_New_Allocator or an
+ * ACE_Allocator_Adapter around an ACE_Malloc with a real lock.
+ *
+ * Each chunk carries a small header, so the memory must be released
+ * through this allocator.  remove() and the destructor release the
+ * caches of all threads and must not run concurrently with other
+ * calls on the allocator.
+ *
+ * @sa ACE_Cached_Allocator, ACE_Dynamic_Cached_Allocator
+ */
+template <class ACE_LOCK>
+class ACE_Thread_Caching_Allocator : public ACE_New_Allocator
+{
+public:
+  enum
+  {
+    /// Smallest chunk size, as a power of two.
+    MIN_SHIFT = 4,
+    /// Number of chunk sizes, 16 bytes up to 1 MiB.
+    CLASS_COUNT = 17
+  };
+
+  /**
+   * @param max_size Largest request that is cached, at most 1 MiB.
+   * @param magazine_size Number of chunks moved between a thread and
+   *        the depot at once.  It is reduced for large chunks so that
+   *        a magazine holds at most
+   *        ACE_DEFAULT_THREAD_CACHE_MAGAZINE_BYTES.
+   * @param depot_size Number of full magazines per chunk size the
+   *        depot keeps before it frees chunks to @a backing.
+   * @param backing Allocator that provides the memory; defaults to
+   *        ACE_Allocator::instance().
+   * @param delete_backing If true @a backing is deleted by the
+   *        destructor.
+   */
+  ACE_Thread_Caching_Allocator (size_t max_size = ACE_DEFAULT_THREAD_CACHE_MAX_SIZE,
+                                size_t magazine_size = ACE_DEFAULT_THREAD_CACHE_MAGAZINE_SIZE,
+                                size_t depot_size = ACE_DEFAULT_THREAD_CACHE_DEPOT_SIZE,
+                                ACE_Allocator *backing = 0,
+                                bool delete_backing = false);
+
+  /// Release all cached chunks to the backing allocator.
+  virtual ~ACE_Thread_Caching_Allocator ();
+
+  virtual void *malloc (size_t nbytes);
+  virtual void *calloc (size_t nbytes, char initial_value = '\0');
+  virtual void *calloc (size_t n_elem,
+                        size_t elem_size,
+                        char initial_value = '\0');
+  virtual void free (void *ptr);
+
+  /// Release all cached chunks, then call remove() on the backing
+  /// allocator.
+  virtual int remove ();
+
+  /// Number of free chunks able to hold @a nbytes that are held by
+  /// the depot (not counting the per-thread caches).
+  size_t depot_depth (size_t nbytes);
+
+  /// Dump the state of an object.
+  virtual void dump () const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+  /// A list of free chunks of one size, linked through their first
+  /// word.
+  struct Magazine
+  {
+    void *head_;
+    size_t rounds_;
+  };
+
+  /**
+   * @class Thread_Cache
+   *
+   * @brief The chunks cached by one thread; created on the thread's
+   * first call and handed back to the depot when the thread exits.
+   */
+  class Thread_Cache
+  {
+  public:
+    Thread_Cache ();
+    ~Thread_Cache ();
+
+    /// Allocator this cache belongs to, 0 until first use.
+    ACE_Thread_Caching_Allocator<ACE_LOCK> *owner_;
+
+    /// Doubly linked list of all caches of <owner_>.
+    Thread_Cache *prev_;
+    Thread_Cache *next_;
+
+    /// The magazine chunks are taken from and the one before it.
+    Magazine loaded_[CLASS_COUNT];
+    Magazine previous_[CLASS_COUNT];
+  };
+
+private:
+  /// Size class for @a nbytes, or -1 if it is not cached.
+  int size_class (size_t nbytes) const;
+
+  /// The calling thread's cache.
+  Thread_Cache *cache ();
+
+  /// Give the magazines of @a cache back and unlink it (takes the
+  /// lock).
+  void release_cache (Thread_Cache *cache);
+
+  /// Full magazine of class @a c from the depot, or a magazine with
+  /// no rounds if it has none (takes the lock).
+  Magazine get_magazine (int c);
+
+  /// Hand a full magazine of class @a c to the depot, freeing its
+  /// chunks if the depot is full (takes the lock).
+  void put_magazine (int c, Magazine const &magazine);
+
+  /// Free the chunks of @a magazine to the backing allocator.
+  void release_magazine (Magazine &magazine);
+
+  /// Allocate a new chunk of class @a c from the backing allocator.
+  void *allocate_chunk (int c);
+
+  /// Release every cached chunk and unlink all thread caches, deleting
+  /// them if @a delete_caches (takes the lock).
+  void release_all (bool delete_caches);
+
+  /// Header in front of every chunk, keeps the size class.
+  static size_t const HEADER =
+    ACE_MALLOC_ROUNDUP (sizeof (size_t), ACE_MALLOC_ALIGN);
+
+  /// Marks chunks that came straight from the backing allocator.
+  static size_t const UNCACHED = ~static_cast<size_t> (0);
+
+  size_t max_size_;
+  size_t depot_size_;
+
+  /// Magazine capacity for each class.
+  size_t capacity_[CLASS_COUNT];
+
+  ACE_Allocator *backing_;
+  bool delete_backing_;
+
+  /// Serializes the depot and the list of thread caches.
+  ACE_LOCK lock_;
+
+  /// Full magazines per class, linked through the second word of
+  /// their first chunk.
+  void *depot_[CLASS_COUNT];
+  size_t depot_count_[CLASS_COUNT];
+
+  /// All thread caches of this allocator.
+  Thread_Cache *caches_;
+
+  ACE_TSS<Thread_Cache> cache_;
+
+  // = Disallow these operations.
+  ACE_Thread_Caching_Allocator (const ACE_Thread_Caching_Allocator<ACE_LOCK> &) = delete;
+  void operator= (const ACE_Thread_Caching_Allocator<ACE_LOCK> &) = delete;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Thread_Caching_Allocator_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Thread_Caching_Allocator_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_THREAD_CACHING_ALLOCATOR_T_H */
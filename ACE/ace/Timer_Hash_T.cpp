@@ -753,10 +753,12 @@ ACE_Timer_Hash_T<TYPE, FUNCTOR, ACE_LOCK, BUCKET, TIME_POLICY>::get_first ()
 template <class TYPE, class FUNCTOR, class ACE_LOCK, class BUCKET, typename TIME_POLICY> void
 ACE_Timer_Hash_T<TYPE, FUNCTOR, ACE_LOCK, BUCKET, TIME_POLICY>::free_node (ACE_Timer_Node_T<TYPE> *node)
 {
-  Base_Timer_Queue::free_node (node);
-
+  // Get the token before the free list may delete the node.
   Hash_Token<TYPE> *h =
     reinterpret_cast<Hash_Token<TYPE> *> (const_cast<void *> (node->get_act ()));
+
+  Base_Timer_Queue::free_node (node);
+
   this->token_list_.add (h);
 }
 
@@ -817,6 +819,12 @@ ACE_Timer_Hash_T<TYPE, FUNCTOR, ACE_LOCK, BUCKET, TIME_POLICY>::expire (const AC
 
           ACE_ASSERT (h->pos_ == i);
 
+          // Get the dispatch info before the node may be freed.
+          ACE_Timer_Node_Dispatch_Info_T<TYPE> info;
+          expired->get_dispatch_info (info);
+
+          info.act_ = h->act_;
+
           // Check if this is an interval timer.
           if (expired->get_interval () > ACE_Time_Value::zero)
             {
@@ -834,13 +842,6 @@ ACE_Timer_Hash_T<TYPE, FUNCTOR, ACE_LOCK, BUCKET, TIME_POLICY>::expire (const AC
               this->free_node (expired);
             }
 
-          ACE_Timer_Node_Dispatch_Info_T<TYPE> info;
-
-          // Get the dispatch info
-          expired->get_dispatch_info (info);
-
-          info.act_ = h->act_;
-
           const void *upcall_act = 0;
 
           this->preinvoke (info, cur_time, upcall_act);
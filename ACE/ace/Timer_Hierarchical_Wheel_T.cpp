@@ -0,0 +1,1021 @@
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Guard_T.h"
+#include "ace/Timer_Hierarchical_Wheel_T.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Design/implementation notes for ACE_Timer_Hierarchical_Wheel_T.
+//
+// All the lists are circular doubly-linked lists with a dummy root
+// node, kept in lists_: first the list of due timers, then the
+// SLOT_COUNT slots of each level, then the overflow list.
+//
+// Let now_tick_ be the tick the wheel has advanced to.  A timer due
+// at tick T >= now_tick_ is kept in the level of the most significant
+// SLOT_BITS digit in which T and now_tick_ differ, in the slot given
+// by that digit of T; if they only differ above the top level, it is
+// kept in the overflow list.  Hence all the slots of a level before
+// (and for the levels above 0, at) the current digit of now_tick_ are
+// empty, and every timer of a lower level expires before every timer
+// of a higher one.  When now_tick_ reaches the first tick of a slot of
+// a higher level, that slot is "cascaded": its timers are placed again
+// relative to the new now_tick_, which puts them in lower levels.
+//
+// The slots of level 0 hold the timers of a single tick, in order of
+// increasing timer value; the other slots and the overflow list are
+// not sorted.  Advancing the wheel moves the due timers of the level 0
+// slots it passes to the list of due timers, which is sorted, and
+// which remove_first() takes timers from.  Timers scheduled for a tick
+// the wheel has already passed go to the due list directly.
+
+/**
+* Default Constructor that uses the default tick and doesn't do any
+* preallocation.
+*
+* @param upcall_functor A pointer to a functor to use instead of the default
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_T
+(FUNCTOR* upcall_functor
+ , TIME_POLICY const & time_policy
+ )
+  : Base_Timer_Queue (upcall_functor, 0, time_policy)
+, lists_ (0)
+, tick_ (0)
+, now_tick_ (0)
+, earliest_ (0)
+, timer_count_ (0)
+, slabs_ (0)
+, slab_count_ (0)
+, slab_max_ (0)
+, free_head_ (0)
+, free_tail_ (0)
+, iterator_ (0)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::ACE_Timer_Hierarchical_Wheel_T");
+  this->open_i (0, ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK);
+}
+
+/**
+* Constructor that sets up the wheel and also may preallocate
+* some nodes.
+*
+* @param tick           The length of a tick in microseconds
+* @param prealloc       The number of nodes to preallocate
+* @param upcall_functor A pointer to a functor to use instead of the default
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_T
+  (u_int tick,
+   size_t prealloc,
+   FUNCTOR* upcall_functor,
+   TIME_POLICY const & time_policy)
+: Base_Timer_Queue (upcall_functor, 0, time_policy)
+, lists_ (0)
+, tick_ (0)
+, now_tick_ (0)
+, earliest_ (0)
+, timer_count_ (0)
+, slabs_ (0)
+, slab_count_ (0)
+, slab_max_ (0)
+, free_head_ (0)
+, free_tail_ (0)
+, iterator_ (0)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::ACE_Timer_Hierarchical_Wheel_T");
+  this->open_i (prealloc, tick);
+}
+
+/**
+* Initialize the queue: create the root nodes of all the lists and
+* preallocate @a prealloc nodes.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::open_i
+  (size_t prealloc, u_int tick)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::open_i");
+
+  this->tick_ = tick == 0 ? 1 : tick;
+  this->now_tick_ = this->to_tick (this->gettimeofday_static ());
+
+  ACE_OS::memset (this->occupied_, 0, sizeof this->occupied_);
+
+  ACE_NEW (this->lists_, ACE_Timer_Node_T<TYPE> [LIST_COUNT]);
+
+  for (u_int i = 0; i < LIST_COUNT; ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* root = &this->lists_[i];
+      root->set_prev (root);
+      root->set_next (root);
+    }
+
+  while (this->slab_count_ * SLAB_SIZE < prealloc)
+    if (this->grow_slabs () == -1)
+      break;
+
+  ACE_NEW (iterator_, Iterator (*this));
+}
+
+/// Destructor just cleans up its memory
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::~ACE_Timer_Hierarchical_Wheel_T ()
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::~ACE_Timer_Hierarchical_Wheel_T");
+
+  delete iterator_;
+
+  this->close ();
+
+  delete [] this->lists_;
+
+  for (size_t i = 0; i < this->slab_count_; ++i)
+    delete [] this->slabs_[i];
+  delete [] this->slabs_;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::close ()
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::close");
+
+  // Remove any remaining nodes
+  for (u_int i = 0; i < LIST_COUNT; ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* root = &this->lists_[i];
+      while (root->get_next () != root)
+        {
+          ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+
+          // Free the node before calling back to the handler, so that
+          // a handler cancelling its timers in handle_close() doesn't
+          // find it.
+          TYPE eh = n->get_type ();
+          const void *act = n->get_act ();
+          this->unlink (n);
+          this->free_node (n);
+          this->upcall_functor ().deletion (*this, eh, act);
+        }
+    }
+
+  return 0;
+}
+
+/**
+* Adds a slab of nodes to the end of the list of unused nodes.
+*
+* @return 0 on success, -1 if memory ran out.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::grow_slabs ()
+{
+  if (this->slab_count_ == this->slab_max_)
+    {
+      size_t const new_max = this->slab_max_ == 0 ? 8 : 2 * this->slab_max_;
+      ACE_Timer_Node_T<TYPE>** new_slabs = 0;
+      ACE_NEW_RETURN (new_slabs, ACE_Timer_Node_T<TYPE>* [new_max], -1);
+
+      for (size_t i = 0; i < this->slab_count_; ++i)
+        new_slabs[i] = this->slabs_[i];
+
+      delete [] this->slabs_;
+      this->slabs_ = new_slabs;
+      this->slab_max_ = new_max;
+    }
+
+  ACE_Timer_Node_T<TYPE>* slab = 0;
+  ACE_NEW_RETURN (slab, ACE_Timer_Node_T<TYPE> [SLAB_SIZE], -1);
+
+  // The timer id of a node never changes; it is its index in the slabs.
+  long const base = static_cast<long> (this->slab_count_ * SLAB_SIZE);
+  for (u_int i = 0; i < SLAB_SIZE; ++i)
+    {
+      slab[i].set_timer_id (base + i);
+      slab[i].set_prev (0);
+      slab[i].set_next (i + 1 < SLAB_SIZE ? &slab[i + 1] : 0);
+    }
+
+  this->slabs_[this->slab_count_++] = slab;
+
+  if (this->free_tail_ == 0)
+    this->free_head_ = slab;
+  else
+    this->free_tail_->set_next (slab);
+  this->free_tail_ = &slab[SLAB_SIZE - 1];
+
+  return 0;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::alloc_node ()
+{
+  if (this->free_head_ == 0 && this->grow_slabs () == -1)
+    return 0;
+
+  ACE_Timer_Node_T<TYPE>* n = this->free_head_;
+  this->free_head_ = n->get_next ();
+  if (this->free_head_ == 0)
+    this->free_tail_ = 0;
+  n->set_next (0);
+  return n;
+}
+
+/// Unused nodes are appended to the list, so that the timer id of a
+/// cancelled or expired timer is not reused before all the other
+/// unused nodes have been.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::free_node (ACE_Timer_Node_T<TYPE>* n)
+{
+  n->set_prev (0);
+  n->set_next (0);
+  if (this->free_tail_ == 0)
+    this->free_head_ = n;
+  else
+    this->free_tail_->set_next (n);
+  this->free_tail_ = n;
+}
+
+/// Finds a scheduled node by timer_id.  Nodes that are not scheduled
+/// are not linked into any list and have a null previous pointer.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::find_node (long timer_id) const
+{
+  if (timer_id < 0)
+    return 0;
+
+  size_t const slab = static_cast<size_t> (timer_id) / SLAB_SIZE;
+  if (slab >= this->slab_count_)
+    return 0;
+
+  ACE_Timer_Node_T<TYPE>* n =
+    &this->slabs_[slab][static_cast<size_t> (timer_id) % SLAB_SIZE];
+  return n->get_prev () != 0 ? n : 0;
+}
+
+/// Converts an absolute time to a tick count.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_UINT64
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::to_tick
+  (const ACE_Time_Value& t) const
+{
+  if (t < ACE_Time_Value::zero)
+    return 0;
+
+  ACE_UINT64 usec;
+  t.to_usec (usec);
+  return usec / this->tick_;
+}
+
+/// Returns the root node of slot @a index of level @a level.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::slot
+  (u_int level, u_int index) const
+{
+  return &this->lists_[1 + level * SLOT_COUNT + index];
+}
+
+/**
+* Finds the first non-empty slot of @a level at or after @a from,
+* clearing the bits of the empty slots passed on the way.
+*
+* @return The slot index, or -1 if there is none.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next_slot
+  (u_int level, u_int from) const
+{
+  u_int index = from;
+  while (index < SLOT_COUNT)
+    {
+      ACE_UINT64 &word = this->occupied_[level][index / 64];
+      ACE_UINT64 const bits = word >> (index % 64);
+
+      if (bits == 0)
+        {
+          // Skip to the next word.
+          index = (index | 63) + 1;
+        }
+      else if ((bits & 1) == 0)
+        {
+          ++index;
+        }
+      else
+        {
+          ACE_Timer_Node_T<TYPE>* root = this->slot (level, index);
+          if (root->get_next () != root)
+            return static_cast<int> (index);
+          word &= ~(static_cast<ACE_UINT64> (1) << (index % 64));
+          ++index;
+        }
+    }
+  return -1;
+}
+
+/**
+* Check to see if the wheel is empty
+*
+* @return True if empty
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::is_empty () const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::is_empty");
+  return this->timer_count_ == 0;
+}
+
+/**
+* @return The value of the earliest node, or ACE_Time_Value::zero if
+*         the queue is empty.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> const ACE_Time_Value &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::earliest_time () const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::earliest_time");
+  ACE_Timer_Node_T<TYPE>* n = this->get_first_i ();
+  if (n != 0)
+    return n->get_timer_value ();
+  return ACE_Time_Value::zero;
+}
+
+/**
+* Creates a ACE_Timer_Node_T based on the input parameters.  Then inserts
+* the node into the wheel.  Then returns a timer_id.
+*
+*  @param type            The data of the timer node
+*  @param act             Asynchronous Completion Token (AKA magic cookie)
+*  @param future_time     The time the timer is scheduled for (absolute time)
+*  @param interval        If not ACE_Time_Value::zero, then this is a periodic
+*                         timer and interval is the time period
+*
+*  @return Unique identifier (can be used to cancel the timer).
+*          -1 on failure.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> long
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::schedule_i (const TYPE& type,
+                                                                     const void* act,
+                                                                     const ACE_Time_Value& future_time,
+                                                                     const ACE_Time_Value& interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::schedule_i");
+
+  ACE_Timer_Node_T<TYPE>* n = this->alloc_node ();
+
+  if (n != 0)
+    {
+      long const id = n->get_timer_id ();
+      n->set (type, act, future_time, interval, 0, 0, id);
+      this->insert (n);
+      return id;
+    }
+
+  // Failure return
+  errno = ENOMEM;
+  return -1;
+}
+
+/**
+* Puts an expired interval timer back into the wheel.
+*
+* @param n The timer node to reschedule
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reschedule (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reschedule");
+  this->insert (n);
+}
+
+/// The shared scheduling functionality between schedule() and reschedule()
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::insert (ACE_Timer_Node_T<TYPE>* n)
+{
+  if (this->timer_count_++ == 0)
+    {
+      // The wheel is empty, so it can be moved to the current time
+      // (or back to the timer, if it is earlier) for free.
+      ACE_UINT64 const now = this->to_tick (this->gettimeofday_static ());
+      ACE_UINT64 const tick = this->to_tick (n->get_timer_value ());
+      this->now_tick_ = tick < now ? tick : now;
+    }
+
+  this->place (n);
+}
+
+/// Links @a n into the list it belongs to relative to now_tick_.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::place (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_Time_Value const & expire = n->get_timer_value ();
+  ACE_UINT64 const tick = this->to_tick (expire);
+
+  if (tick < this->now_tick_)
+    {
+      this->link_sorted (&this->lists_[DUE_LIST], n);
+      return;
+    }
+
+  ACE_UINT64 const diff = tick ^ this->now_tick_;
+  u_int level = 0;
+  while (level < LEVEL_COUNT
+         && (diff >> ((level + 1) * SLOT_BITS)) != 0)
+    ++level;
+
+  if (level == LEVEL_COUNT)
+    {
+      this->link (&this->lists_[OVERFLOW_LIST], n);
+    }
+  else
+    {
+      u_int const index =
+        static_cast<u_int> (tick >> (level * SLOT_BITS)) & (SLOT_COUNT - 1);
+      this->occupied_[level][index / 64] |=
+        static_cast<ACE_UINT64> (1) << (index % 64);
+
+      if (level == 0)
+        this->link_sorted (this->slot (0, index), n);
+      else
+        this->link (this->slot (level, index), n);
+    }
+
+  if (this->earliest_ != 0 && expire < this->earliest_->get_timer_value ())
+    this->earliest_ = n;
+}
+
+/// Appends @a n to the list of @a root.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::link
+  (ACE_Timer_Node_T<TYPE>* root, ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_Timer_Node_T<TYPE>* last = root->get_prev ();
+  n->set_prev (last);
+  n->set_next (root);
+  last->set_next (n);
+  root->set_prev (n);
+}
+
+/// Inserts @a n into the sorted list of @a root.  We search backwards
+/// from the tail of the list because timers are mostly scheduled in
+/// increasing order.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::link_sorted
+  (ACE_Timer_Node_T<TYPE>* root, ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_Time_Value const & expire = n->get_timer_value ();
+  ACE_Timer_Node_T<TYPE>* p = root->get_prev ();
+  while (p != root && p->get_timer_value () > expire)
+    p = p->get_prev ();
+
+  // insert after
+  n->set_prev (p);
+  n->set_next (p->get_next ());
+  p->get_next ()->set_prev (n);
+  p->set_next (n);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::unlink (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::unlink");
+  --this->timer_count_;
+  if (n == this->earliest_)
+    this->earliest_ = 0;
+  n->get_prev ()->set_next (n->get_next ());
+  n->get_next ()->set_prev (n->get_prev ());
+  n->set_prev (0);
+  n->set_next (0);
+}
+
+/**
+* Moves the timers of the current level 0 slot whose values are <=
+* @a cur_time to the list of due timers.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::collect
+  (const ACE_Time_Value& cur_time)
+{
+  u_int const index =
+    static_cast<u_int> (this->now_tick_) & (SLOT_COUNT - 1);
+  ACE_Timer_Node_T<TYPE>* root = this->slot (0, index);
+  ACE_Timer_Node_T<TYPE>* due = &this->lists_[DUE_LIST];
+
+  // The slot is sorted, so the due timers are at its head.
+  for (ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+       n != root && n->get_timer_value () <= cur_time;
+       n = root->get_next ())
+    {
+      if (n == this->earliest_)
+        this->earliest_ = 0;
+      n->get_prev ()->set_next (n->get_next ());
+      n->get_next ()->set_prev (n->get_prev ());
+      this->link_sorted (due, n);
+    }
+}
+
+/**
+* Places the timers of the current slot of @a level (or of the overflow
+* list, if @a level is LEVEL_COUNT) again.  Called when now_tick_ has
+* just reached the first tick of that slot, so the timers all end up in
+* lower levels.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cascade (u_int level)
+{
+  ACE_Timer_Node_T<TYPE>* root = 0;
+  if (level == LEVEL_COUNT)
+    root = &this->lists_[OVERFLOW_LIST];
+  else
+    root = this->slot (level,
+                       static_cast<u_int> (this->now_tick_ >> (level * SLOT_BITS))
+                       & (SLOT_COUNT - 1));
+
+  if (root->get_next () == root)
+    return;
+
+  // Detach the list first: timers of the overflow list may go back
+  // into it.
+  ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+  root->get_prev ()->set_next (0);
+  root->set_next (root);
+  root->set_prev (root);
+
+  while (n != 0)
+    {
+      ACE_Timer_Node_T<TYPE>* next = n->get_next ();
+      this->place (n);
+      n = next;
+    }
+}
+
+/**
+* Advances now_tick_ to the tick of @a cur_time, cascading the slots of
+* the higher levels and moving the timers that are due at @a cur_time
+* to the list of due timers on the way.  Ticks whose slots are all
+* empty are skipped without visiting them.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::advance
+  (const ACE_Time_Value& cur_time)
+{
+  ACE_UINT64 const target = this->to_tick (cur_time);
+
+  for (;;)
+    {
+      this->collect (cur_time);
+
+      if (this->now_tick_ >= target)
+        return;
+
+      // Find the next tick at which something happens: the first tick
+      // of the next occupied slot of the lowest level that has one.
+      ACE_UINT64 next = 0;
+      u_int level = 0;
+      for (; level < LEVEL_COUNT; ++level)
+        {
+          u_int const shift = level * SLOT_BITS;
+          u_int const current =
+            static_cast<u_int> (this->now_tick_ >> shift) & (SLOT_COUNT - 1);
+          int const index = this->next_slot (level, current + 1);
+          if (index != -1)
+            {
+              ACE_UINT64 const span =
+                static_cast<ACE_UINT64> (1) << (shift + SLOT_BITS);
+              next = (this->now_tick_ & ~(span - 1))
+                | (static_cast<ACE_UINT64> (index) << shift);
+              break;
+            }
+        }
+
+      if (level == LEVEL_COUNT)
+        {
+          ACE_Timer_Node_T<TYPE>* overflow = &this->lists_[OVERFLOW_LIST];
+          if (overflow->get_next () == overflow)
+            {
+              // Nothing left in the wheel.
+              this->now_tick_ = target;
+              return;
+            }
+
+          ACE_UINT64 const span =
+            static_cast<ACE_UINT64> (1) << (LEVEL_COUNT * SLOT_BITS);
+          next = (this->now_tick_ | (span - 1)) + 1;
+        }
+
+      if (next > target)
+        {
+          // No timer is due before cur_time.
+          this->now_tick_ = target;
+          return;
+        }
+
+      this->now_tick_ = next;
+      if (level > 0)
+        this->cascade (level);
+    }
+}
+
+/**
+* Returns the earliest node of the wheel, not counting the list of due
+* timers.  The result is cached until the wheel changes.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::find_earliest_i () const
+{
+  if (this->earliest_ != 0)
+    return this->earliest_;
+
+  // Every timer of a lower level expires before every timer of a
+  // higher one, so the first occupied slot holds the earliest timer.
+  ACE_Timer_Node_T<TYPE>* root = 0;
+  for (u_int level = 0; level < LEVEL_COUNT && root == 0; ++level)
+    {
+      u_int const current =
+        static_cast<u_int> (this->now_tick_ >> (level * SLOT_BITS))
+        & (SLOT_COUNT - 1);
+      int const index =
+        this->next_slot (level, level == 0 ? current : current + 1);
+      if (index != -1)
+        {
+          root = this->slot (level, static_cast<u_int> (index));
+
+          // Level 0 slots are sorted.
+          if (level == 0)
+            {
+              this->earliest_ = root->get_next ();
+              return this->earliest_;
+            }
+        }
+    }
+
+  if (root == 0)
+    root = &this->lists_[OVERFLOW_LIST];
+
+  ACE_Timer_Node_T<TYPE>* first = 0;
+  for (ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+       n != root;
+       n = n->get_next ())
+    {
+      if (first == 0 || n->get_timer_value () < first->get_timer_value ())
+        first = n;
+    }
+
+  this->earliest_ = first;
+  return first;
+}
+
+/**
+* Find the timer node by using the id as an index.  Then use
+* set_interval() on the node to update the interval.
+*
+* @param timer_id The timer identifier
+* @param interval The new interval
+*
+* @return 0 if successful, -1 if no.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reset_interval (long timer_id,
+                                                                         const ACE_Time_Value &interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reset_interval");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+  ACE_Timer_Node_T<TYPE>* n = this->find_node (timer_id);
+  if (n != 0)
+    {
+      // The interval will take effect the next time this node is expired.
+      n->set_interval (interval);
+      return 0;
+    }
+  return -1;
+}
+
+/**
+* Goes through every list and removes all the nodes with the correct
+* type value.
+*
+* @param type       The value to search for.
+* @param skip_close If this non-zero, the cancellation method of the
+*                   functor will not be called for each cancelled timer.
+*
+* @return Number of timers cancelled
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (const TYPE& type, int skip_close)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+
+  int num_canceled = 0; // Note : Technically this can overflow.
+  int cookie = 0;
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  for (u_int i = 0; i < LIST_COUNT && !this->is_empty (); ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* root = &this->lists_[i];
+      for (ACE_Timer_Node_T<TYPE>* n = root->get_next (); n != root; )
+        {
+          ACE_Timer_Node_T<TYPE>* tmp = n;
+          n = n->get_next ();
+
+          if (tmp->get_type () == type)
+            {
+              ++num_canceled;
+              this->unlink (tmp);
+              this->free_node (tmp);
+            }
+        }
+    }
+
+  // Call the close hooks.
+
+  // cancel_type() called once per <type>.
+  this->upcall_functor ().cancel_type (*this,
+                                       type,
+                                       skip_close,
+                                       cookie);
+
+  for (int i = 0;
+       i < num_canceled;
+       ++i)
+    {
+      // cancel_timer() called once per <timer>.
+      this->upcall_functor ().cancel_timer (*this,
+                                            type,
+                                            skip_close,
+                                            cookie);
+    }
+
+  return num_canceled;
+}
+
+/**
+* Cancels the single timer that is specified by the timer_id.  The
+* timer_id is the index of the node in the slabs.
+*
+* @param timer_id   Timer Identifier
+* @param act        Asychronous Completion Token (AKA magic cookie):
+*                   If this is non-zero, stores the magic cookie of
+*                   the cancelled timer here.
+* @param skip_close If this non-zero, the cancellation method of the
+*                   functor will not be called.
+*
+* @return 1 for sucess and 0 if the timer_id wasn't found (or was
+*         found to be invalid)
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (long timer_id,
+                                                                 const void **act,
+                                                                 int skip_close)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+  ACE_Timer_Node_T<TYPE>* n = this->find_node (timer_id);
+  if (n != 0)
+    {
+      // Call the close hooks.
+      int cookie = 0;
+
+      // cancel_type() called once per <type>.
+      this->upcall_functor ().cancel_type (*this,
+                                           n->get_type (),
+                                           skip_close,
+                                           cookie);
+
+      // cancel_timer() called once per <timer>.
+      this->upcall_functor ().cancel_timer (*this,
+                                            n->get_type (),
+                                            skip_close,
+                                            cookie);
+      if (act != 0)
+        *act = n->get_act ();
+
+      this->unlink (n);
+      this->free_node (n);
+
+      return 1;
+    }
+  return 0;
+}
+
+/**
+* Dumps out the tick, the current tick and the contents of the wheel.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ntick_ = %Q"), this->tick_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nnow_tick_ = %Q"), this->now_tick_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ntimer_count_ = %B"), this->timer_count_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nlists_ =\n")));
+
+  for (u_int i = 0; i < LIST_COUNT; ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* root = &this->lists_[i];
+      if (root->get_next () == root)
+        continue;
+
+      ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("%d\n"), i));
+      for (ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+           n != root;
+           n = n->get_next ())
+        {
+          n->dump ();
+        }
+    }
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+/**
+* Removes the earliest node.
+*
+* @return The earliest timer node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::remove_first ()
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::remove_first");
+  ACE_Timer_Node_T<TYPE>* n = this->get_first_i ();
+  if (n != 0)
+    this->unlink (n);
+  return n;
+}
+
+/**
+* Returns the earliest node without removing it
+*
+* @return The earliest timer node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::get_first ()
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::get_first");
+  return this->get_first_i ();
+}
+
+/// The due timers expire before all the timers in the wheel.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::get_first_i () const
+{
+  ACE_Timer_Node_T<TYPE>* due = &this->lists_[DUE_LIST];
+  if (due->get_next () != due)
+    return due->get_next ();
+  if (this->is_empty ())
+    return 0;
+  return this->find_earliest_i ();
+}
+
+/**
+* @return The iterator
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Queue_Iterator_T<TYPE> &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::iter ()
+{
+  this->iterator_->first ();
+  return *this->iterator_;
+}
+
+/**
+* Advances the wheel before letting the base class dispatch the
+* earliest timer, which is then at the head of the list of due timers
+* if it is due at all.
+*
+* @param cur_time The time to expire timers up to.
+* @param info     Set to the dispatch information of the expired timer.
+*
+* @return 1 if a timer was expired, 0 otherwise.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::dispatch_info_i
+  (const ACE_Time_Value& cur_time,
+   ACE_Timer_Node_Dispatch_Info_T<TYPE> &info)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::dispatch_info_i");
+
+  if (this->is_empty ())
+    return 0;
+
+  this->advance (cur_time);
+
+  return Base_Timer_Queue::dispatch_info_i (cur_time, info);
+}
+
+///////////////////////////////////////////////////////////////////////////
+// ACE_Timer_Hierarchical_Wheel_Iterator_T
+
+/**
+* Just initializes the iterator with a ACE_Timer_Hierarchical_Wheel_T
+* and then calls first() to initialize the rest of itself.
+*
+* @param wheel A reference for a timer queue to iterate over
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_Iterator_T
+(Wheel& wheel)
+: timer_wheel_ (wheel)
+{
+  this->first();
+}
+
+/**
+* Destructor, at this level does nothing.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::~ACE_Timer_Hierarchical_Wheel_Iterator_T ()
+{
+}
+
+/**
+* Positions the iterator at the first node of the first non-empty list.
+*
+* If the wheel is empty, list_ will be equal to the number of lists
+* and current_node_ will be 0.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::first ()
+{
+  this->goto_next (0);
+}
+
+/**
+* Positions the iterator at the next node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next ()
+{
+  if (this->isdone ())
+    return;
+
+  ACE_Timer_Node_T<TYPE>* n = this->current_node_->get_next ();
+  ACE_Timer_Node_T<TYPE>* root = &this->timer_wheel_.lists_[this->list_];
+  if (n == root)
+    this->goto_next (this->list_ + 1);
+  else
+    this->current_node_ = n;
+}
+
+/// Helper class for common functionality of next() and first()
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::goto_next (u_int start_list)
+{
+  for (u_int i = start_list; i < Wheel::LIST_COUNT; ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* root = &this->timer_wheel_.lists_[i];
+      ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+      if (n != root)
+        {
+          this->list_ = i;
+          this->current_node_ = n;
+          return;
+        }
+    }
+
+  // empty
+  this->list_ = Wheel::LIST_COUNT;
+  this->current_node_ = 0;
+}
+
+/**
+* @return True when we there aren't any more items.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::isdone () const
+{
+  return this->current_node_ == 0;
+}
+
+/**
+* @return The node at the current position in the sequence or 0 if the wheel
+*         is empty
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::item ()
+{
+  return this->current_node_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP */
@@ -0,0 +1,295 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Timer_Hierarchical_Wheel_T.h
+ *
+ *  Hierarchical timing wheel implementation of ACE_Timer_Queue_T.
+ */
+//=============================================================================
+
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Timer_Queue_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Forward declaration
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+class ACE_Timer_Hierarchical_Wheel_T;
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_Iterator_T
+ *
+ * @brief Iterates over an ACE_Timer_Hierarchical_Wheel_T.
+ *
+ * This is a generic iterator that can be used to visit every
+ * node of a timer queue.  Be aware that it doesn't traverse
+ * in the order of timeout values.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_Iterator_T
+  : public ACE_Timer_Queue_Iterator_T <TYPE>
+{
+public:
+  typedef ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Wheel;
+  typedef ACE_Timer_Node_T<TYPE> Node;
+
+  /// Constructor
+  ACE_Timer_Hierarchical_Wheel_Iterator_T (Wheel &);
+
+  /// Destructor
+  virtual ~ACE_Timer_Hierarchical_Wheel_Iterator_T ();
+
+  /// Positions the iterator at the first node in the Timer Queue
+  virtual void first ();
+
+  /// Positions the iterator at the next node in the Timer Queue
+  virtual void next ();
+
+  /// Returns true when there are no more nodes in the sequence
+  virtual bool isdone () const;
+
+  /// Returns the node at the current position in the sequence
+  virtual ACE_Timer_Node_T<TYPE>* item ();
+
+protected:
+  /// The wheel we are iterating over.
+  Wheel& timer_wheel_;
+
+  /// Index of the list of the current node.
+  u_int list_;
+
+  /// The current node.
+  ACE_Timer_Node_T<TYPE>* current_node_;
+
+private:
+  void goto_next (u_int start_list);
+};
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_T
+ *
+ * @brief Provides a hierarchical timing wheel version of
+ * ACE_Timer_Queue.
+ *
+ * Time is divided into ticks of a fixed length.  The wheel has
+ * @c LEVEL_COUNT levels of @c SLOT_COUNT slots each; a slot of level
+ * @e k covers @c SLOT_COUNT^k ticks, so a wheel with a 1 millisecond
+ * tick spans about 49 days.  Timers further out are kept in an
+ * overflow list.  As time advances, the slots of the higher levels
+ * are cascaded into the lower ones, so every timer is moved at most
+ * @c LEVEL_COUNT times during its life.  This is the scheme of
+ * George Varghese and Tony Lauck's paper "Hashed and Hierarchical
+ * Timing Wheels: Efficient Data Structures for Implementing a Timer
+ * Facility".
+ *
+ * Scheduling and cancelling a timer take constant time, unlike with
+ * ACE_Timer_Heap_T, and unlike ACE_Timer_Wheel_T the cost does not
+ * grow when many timers are scheduled far beyond one revolution of
+ * the wheel.  Expiry is done per tick: all the timers of a tick are
+ * moved to a list of due timers at once, and empty slots are skipped
+ * using a bitmap of the occupied slots.  Timers still expire in the
+ * exact order of their timeout values and never before them; the
+ * tick only determines the granularity of the internal bookkeeping.
+ *
+ * Timer nodes are allocated in slabs of @c SLAB_SIZE nodes owned by
+ * the queue.  The timer id of a node is its index in the slabs, so
+ * cancelling a timer needs no search.  Released nodes are reused in
+ * FIFO order, which keeps stale timer ids from being reused quickly.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_T
+  : public ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>
+{
+public:
+  /// Type of iterator
+  typedef ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Iterator;
+  /// Iterator is a friend
+  friend class ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>;
+  typedef ACE_Timer_Node_T<TYPE> Node;
+  /// Type inherited from
+  typedef ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Base_Timer_Queue;
+
+  enum
+  {
+    /// Number of bits of the tick count handled by each level.
+    SLOT_BITS = 8,
+    /// Number of slots of each level.
+    SLOT_COUNT = 1 << SLOT_BITS,
+    /// Number of levels of the wheel.
+    LEVEL_COUNT = 4,
+    /// Number of nodes allocated at a time.
+    SLAB_SIZE = 256
+  };
+
+  /// Default constructor, uses a tick of
+  /// ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK microseconds.
+  ACE_Timer_Hierarchical_Wheel_T (FUNCTOR* upcall_functor = 0,
+                                  TIME_POLICY const & time_policy = TIME_POLICY());
+
+  /**
+   * Constructor that sets the length of a tick in microseconds and
+   * preallocates room for @a prealloc timers.
+   */
+  ACE_Timer_Hierarchical_Wheel_T (u_int tick,
+                                  size_t prealloc = 0,
+                                  FUNCTOR* upcall_functor = 0,
+                                  TIME_POLICY const & time_policy = TIME_POLICY());
+
+  /// Destructor
+  virtual ~ACE_Timer_Hierarchical_Wheel_T ();
+
+  /// True if queue is empty, else false.
+  virtual bool is_empty () const;
+
+  /// Returns the time of the earliest node in the queue.
+  /// Must be called on a non-empty queue.
+  virtual const ACE_Time_Value& earliest_time () const;
+
+  /// Changes the interval of a timer (and can make it periodic or non
+  /// periodic by setting it to ACE_Time_Value::zero or not).
+  virtual int reset_interval (long timer_id,
+                              const ACE_Time_Value& interval);
+
+  /// Cancel all timer associated with @a type.  If @a dont_call_handle_close is
+  /// 0 then the <functor> will be invoked.  Returns number of timers
+  /// cancelled.
+  virtual int cancel (const TYPE& type,
+                      int dont_call_handle_close = 1);
+
+  /// Cancel the single timer that matches the @a timer_id value (which
+  /// was returned from the <schedule> method).  If act is non-NULL
+  /// then it will be set to point to the ``magic cookie'' argument
+  /// passed in when the timer was registered.  This makes it possible
+  /// to free up the memory and avoid memory leaks.  If
+  /// @a dont_call_handle_close is 0 then the <functor> will be invoked.
+  /// Returns 1 if cancellation succeeded and 0 if the @a timer_id
+  /// wasn't found.
+  virtual int cancel (long timer_id,
+                      const void** act = 0,
+                      int dont_call_handle_close = 1);
+
+  /**
+   * Destroy timer queue. Cancels all timers.
+   */
+  virtual int close ();
+
+  /// Returns a pointer to this <ACE_Timer_Queue_T>'s iterator.
+  virtual ACE_Timer_Queue_Iterator_T<TYPE> & iter ();
+
+  /// Removes the earliest node from the queue and returns it
+  virtual ACE_Timer_Node_T<TYPE>* remove_first ();
+
+  /// Dump the state of an object.
+  virtual void dump () const;
+
+  /// Reads the earliest node from the queue and returns it.
+  virtual ACE_Timer_Node_T<TYPE>* get_first ();
+
+protected:
+  /// Schedules a timer.
+  virtual long schedule_i (const TYPE& type,
+                           const void* act,
+                           const ACE_Time_Value& future_time,
+                           const ACE_Time_Value& interval);
+
+  /// Advances the wheel to @a current_time before dispatching the
+  /// earliest due timer.
+  virtual int dispatch_info_i (const ACE_Time_Value &current_time,
+                               ACE_Timer_Node_Dispatch_Info_T<TYPE> &info);
+
+  /// Takes a node from the slabs.
+  virtual ACE_Timer_Node_T<TYPE> *alloc_node ();
+
+  /// Returns a node to the slabs.
+  virtual void free_node (ACE_Timer_Node_T<TYPE> *);
+
+private:
+  enum
+  {
+    /// Number of lists: the due list, the slots and the overflow list.
+    LIST_COUNT = LEVEL_COUNT * SLOT_COUNT + 2,
+    /// Index of the list of due timers in @c lists_.
+    DUE_LIST = 0,
+    /// Index of the overflow list in @c lists_.
+    OVERFLOW_LIST = LIST_COUNT - 1
+  };
+
+  // The following are documented in the .cpp file.
+  void open_i (size_t prealloc, u_int tick);
+  virtual void reschedule (ACE_Timer_Node_T<TYPE> *);
+  ACE_Timer_Node_T<TYPE>* find_node (long timer_id) const;
+  ACE_Timer_Node_T<TYPE>* get_first_i () const;
+  ACE_Timer_Node_T<TYPE>* find_earliest_i () const;
+  ACE_Timer_Node_T<TYPE>* slot (u_int level, u_int index) const;
+  ACE_UINT64 to_tick (const ACE_Time_Value& t) const;
+  int next_slot (u_int level, u_int from) const;
+  void insert (ACE_Timer_Node_T<TYPE>* n);
+  void place (ACE_Timer_Node_T<TYPE>* n);
+  void advance (const ACE_Time_Value& cur_time);
+  void collect (const ACE_Time_Value& cur_time);
+  void cascade (u_int level);
+  void link (ACE_Timer_Node_T<TYPE>* root, ACE_Timer_Node_T<TYPE>* n);
+  void link_sorted (ACE_Timer_Node_T<TYPE>* root, ACE_Timer_Node_T<TYPE>* n);
+  void unlink (ACE_Timer_Node_T<TYPE>* n);
+  int grow_slabs ();
+
+  /// The root (dummy) nodes of all the lists: the list of due timers,
+  /// the slots of each level and the overflow list.
+  ACE_Timer_Node_T<TYPE>* lists_;
+
+  /// Bitmaps of the slots of each level that may be non-empty.
+  /// Bits are set when a node is placed in a slot and cleared lazily
+  /// when the slot is found to be empty.
+  mutable ACE_UINT64 occupied_[LEVEL_COUNT][SLOT_COUNT / 64];
+
+  /// Length of a tick in microseconds.
+  ACE_UINT64 tick_;
+
+  /// The tick the wheel has advanced to.
+  ACE_UINT64 now_tick_;
+
+  /// Earliest node in the wheel (not counting the due list), or 0 if
+  /// it has to be searched for.
+  mutable ACE_Timer_Node_T<TYPE>* earliest_;
+
+  /// The total number of timers currently scheduled.
+  size_t timer_count_;
+
+  /// The slabs the nodes are allocated from.
+  ACE_Timer_Node_T<TYPE>** slabs_;
+
+  /// Number of slabs in @c slabs_.
+  size_t slab_count_;
+
+  /// Capacity of @c slabs_.
+  size_t slab_max_;
+
+  /// First and last unused node; unused nodes are linked through
+  /// their next pointer.
+  ACE_Timer_Node_T<TYPE>* free_head_;
+  ACE_Timer_Node_T<TYPE>* free_tail_;
+
+  /// Iterator used by iter().
+  Iterator* iterator_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Timer_Hierarchical_Wheel_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Timer_Hierarchical_Wheel_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_H */
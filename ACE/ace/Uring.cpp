@@ -0,0 +1,306 @@
+#include "ace/Uring.h"
+
+#if defined (ACE_HAS_IO_URING)
+
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_mman.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Time_Value.h"
+
+#include /**/ <sys/syscall.h>
+#include /**/ <signal.h>
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Uring.inl"
+#endif /* __ACE_INLINE__ */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Uring)
+
+ACE_Uring::ACE_Uring ()
+  : ring_fd_ (ACE_INVALID_HANDLE)
+  , features_ (0)
+  , sq_ring_ (MAP_FAILED)
+  , sq_ring_size_ (0)
+  , sqes_ (0)
+  , sqes_size_ (0)
+  , sq_khead_ (0)
+  , sq_ktail_ (0)
+  , sq_mask_ (0)
+  , sq_entries_ (0)
+  , sq_array_ (0)
+  , sqe_head_ (0)
+  , sqe_tail_ (0)
+  , cq_ring_ (MAP_FAILED)
+  , cq_ring_size_ (0)
+  , cq_khead_ (0)
+  , cq_ktail_ (0)
+  , cq_mask_ (0)
+  , cqes_ (0)
+{
+}
+
+ACE_Uring::~ACE_Uring ()
+{
+  (void) this->close ();
+}
+
+int
+ACE_Uring::open (unsigned int entries, unsigned int cq_entries)
+{
+  ACE_TRACE ("ACE_Uring::open");
+
+  if (this->ring_fd_ != ACE_INVALID_HANDLE)
+    {
+      errno = EBUSY;
+      return -1;
+    }
+
+  struct io_uring_params params;
+  ACE_OS::memset (&params, 0, sizeof (params));
+  if (cq_entries != 0)
+    {
+      params.flags |= IORING_SETUP_CQSIZE;
+      params.cq_entries = cq_entries;
+    }
+
+  int const fd = static_cast<int> (::syscall (__NR_io_uring_setup,
+                                              entries,
+                                              &params));
+  if (fd < 0)
+    return -1;
+
+  this->ring_fd_ = fd;
+  this->features_ = params.features;
+
+  if (ACE_BIT_DISABLED (params.features, IORING_FEAT_EXT_ARG))
+    {
+      (void) this->close ();
+      errno = ENOTSUP;
+      return -1;
+    }
+
+  this->sq_ring_size_ =
+    params.sq_off.array + params.sq_entries * sizeof (unsigned int);
+  this->cq_ring_size_ =
+    params.cq_off.cqes + params.cq_entries * sizeof (struct io_uring_cqe);
+
+  bool const single_mmap =
+    ACE_BIT_ENABLED (params.features, IORING_FEAT_SINGLE_MMAP);
+  if (single_mmap)
+    {
+      if (this->cq_ring_size_ > this->sq_ring_size_)
+        this->sq_ring_size_ = this->cq_ring_size_;
+      this->cq_ring_size_ = this->sq_ring_size_;
+    }
+
+  this->sq_ring_ = ACE_OS::mmap (0,
+                                 this->sq_ring_size_,
+                                 PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE,
+                                 this->ring_fd_,
+                                 IORING_OFF_SQ_RING);
+  if (this->sq_ring_ == MAP_FAILED)
+    {
+      (void) this->close ();
+      return -1;
+    }
+
+  if (single_mmap)
+    this->cq_ring_ = this->sq_ring_;
+  else
+    {
+      this->cq_ring_ = ACE_OS::mmap (0,
+                                     this->cq_ring_size_,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE,
+                                     this->ring_fd_,
+                                     IORING_OFF_CQ_RING);
+      if (this->cq_ring_ == MAP_FAILED)
+        {
+          (void) this->close ();
+          return -1;
+        }
+    }
+
+  this->sqes_size_ = params.sq_entries * sizeof (struct io_uring_sqe);
+  void *sqes = ACE_OS::mmap (0,
+                             this->sqes_size_,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE,
+                             this->ring_fd_,
+                             IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+    {
+      (void) this->close ();
+      return -1;
+    }
+  this->sqes_ = static_cast<struct io_uring_sqe *> (sqes);
+
+  char *sq = static_cast<char *> (this->sq_ring_);
+  this->sq_khead_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.head);
+  this->sq_ktail_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.tail);
+  this->sq_mask_ = *reinterpret_cast<unsigned int *> (sq + params.sq_off.ring_mask);
+  this->sq_entries_ = *reinterpret_cast<unsigned int *> (sq + params.sq_off.ring_entries);
+  this->sq_array_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.array);
+
+  // The indirection array is always used as an identity mapping, which
+  // lets flush() publish entries by just moving the tail.
+  for (unsigned int i = 0; i < this->sq_entries_; ++i)
+    this->sq_array_[i] = i;
+
+  this->sqe_head_ = this->sqe_tail_ = *this->sq_ktail_;
+
+  char *cq = static_cast<char *> (this->cq_ring_);
+  this->cq_khead_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.head);
+  this->cq_ktail_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.tail);
+  this->cq_mask_ = *reinterpret_cast<unsigned int *> (cq + params.cq_off.ring_mask);
+  this->cqes_ = reinterpret_cast<struct io_uring_cqe *> (cq + params.cq_off.cqes);
+
+  return 0;
+}
+
+int
+ACE_Uring::close ()
+{
+  ACE_TRACE ("ACE_Uring::close");
+
+  if (this->sqes_ != 0)
+    {
+      (void) ACE_OS::munmap (this->sqes_, this->sqes_size_);
+      this->sqes_ = 0;
+    }
+
+  if (this->cq_ring_ != MAP_FAILED && this->cq_ring_ != this->sq_ring_)
+    (void) ACE_OS::munmap (this->cq_ring_, this->cq_ring_size_);
+  this->cq_ring_ = MAP_FAILED;
+
+  if (this->sq_ring_ != MAP_FAILED)
+    {
+      (void) ACE_OS::munmap (this->sq_ring_, this->sq_ring_size_);
+      this->sq_ring_ = MAP_FAILED;
+    }
+
+  this->sq_khead_ = this->sq_ktail_ = this->sq_array_ = 0;
+  this->cq_khead_ = this->cq_ktail_ = 0;
+  this->cqes_ = 0;
+  this->sq_entries_ = this->sq_mask_ = this->cq_mask_ = 0;
+  this->sqe_head_ = this->sqe_tail_ = 0;
+
+  int result = 0;
+  if (this->ring_fd_ != ACE_INVALID_HANDLE)
+    {
+      result = ACE_OS::close (this->ring_fd_);
+      this->ring_fd_ = ACE_INVALID_HANDLE;
+    }
+
+  return result;
+}
+
+unsigned int
+ACE_Uring::flush ()
+{
+  if (this->sqe_head_ != this->sqe_tail_)
+    {
+      this->sqe_head_ = this->sqe_tail_;
+      __atomic_store_n (this->sq_ktail_, this->sqe_tail_, __ATOMIC_RELEASE);
+    }
+
+  return this->sqe_tail_ - __atomic_load_n (this->sq_khead_, __ATOMIC_ACQUIRE);
+}
+
+int
+ACE_Uring::enter (unsigned int to_submit,
+                  unsigned int wait_nr,
+                  const ACE_Time_Value *timeout)
+{
+  unsigned int flags = 0;
+  struct io_uring_getevents_arg arg;
+  struct __kernel_timespec ts;
+  void *argp = 0;
+  size_t argsz = 0;
+
+  if (wait_nr != 0)
+    {
+      flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+
+      ACE_OS::memset (&arg, 0, sizeof (arg));
+      arg.sigmask_sz = _NSIG / 8;
+      if (timeout != 0)
+        {
+          ts.tv_sec = timeout->sec ();
+          ts.tv_nsec = timeout->usec () * 1000;
+          arg.ts = reinterpret_cast<ACE_UINT64> (&ts);
+        }
+      argp = &arg;
+      argsz = sizeof (arg);
+    }
+
+  long const result = ::syscall (__NR_io_uring_enter,
+                                 this->ring_fd_,
+                                 to_submit,
+                                 wait_nr,
+                                 flags,
+                                 argp,
+                                 argsz);
+  if (result < 0)
+    return -1;
+
+  return static_cast<int> (result);
+}
+
+int
+ACE_Uring::submit ()
+{
+  unsigned int const pending = this->flush ();
+  if (pending == 0)
+    return 0;
+
+  return this->enter (pending, 0);
+}
+
+int
+ACE_Uring::register_buffers (const iovec *iov, unsigned int count)
+{
+  ACE_TRACE ("ACE_Uring::register_buffers");
+
+  long const result = ::syscall (__NR_io_uring_register,
+                                 this->ring_fd_,
+                                 IORING_REGISTER_BUFFERS,
+                                 iov,
+                                 count);
+  return result < 0 ? -1 : 0;
+}
+
+int
+ACE_Uring::unregister_buffers ()
+{
+  ACE_TRACE ("ACE_Uring::unregister_buffers");
+
+  long const result = ::syscall (__NR_io_uring_register,
+                                 this->ring_fd_,
+                                 IORING_UNREGISTER_BUFFERS,
+                                 0,
+                                 0);
+  return result < 0 ? -1 : 0;
+}
+
+void
+ACE_Uring::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Uring::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("ring_fd_ = %d"), this->ring_fd_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nsq_entries_ = %u"), this->sq_entries_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\ncq_ready = %u\n"), this->cq_ready ()));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_IO_URING */
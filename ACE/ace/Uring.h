@@ -0,0 +1,170 @@
+// -*- C++ -*-
+
+//==========================================================================
+/**
+ *  @file    Uring.h
+ *
+ *  Thin wrapper around a Linux @c io_uring submission/completion ring
+ *  pair, used by the io_uring based reactor and proactor.
+ */
+//==========================================================================
+
+#ifndef ACE_URING_H
+#define ACE_URING_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_IO_URING)
+
+#include "ace/Basic_Types.h"
+#include "ace/os_include/os_stddef.h"
+#include "ace/os_include/sys/os_uio.h"
+#include /**/ <linux/io_uring.h>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Time_Value;
+
+/**
+ * @class ACE_Uring
+ *
+ * @brief Maps and drives a single @c io_uring instance.
+ *
+ * The raw system calls are used directly so that no third-party
+ * library (liburing) is required.  The class itself performs no
+ * locking: callers that share a ring between threads must serialize
+ * access to the submission queue and, separately, to the completion
+ * queue.  Calls to enter() may be made concurrently, since the kernel
+ * serializes submission internally.
+ *
+ * @note Timed waits rely on @c IORING_FEAT_EXT_ARG, so open() fails
+ *       with @c ENOTSUP on kernels older than 5.11.
+ */
+class ACE_Export ACE_Uring
+{
+public:
+  ACE_Uring ();
+
+  /// Unmaps the rings and closes the ring descriptor.
+  ~ACE_Uring ();
+
+  /// Create a ring with room for @a entries submissions.  The
+  /// completion queue is sized to @a cq_entries, or to the kernel
+  /// default (twice @a entries) if @a cq_entries is 0.
+  int open (unsigned int entries, unsigned int cq_entries = 0);
+
+  /// Unmap the rings and close the ring descriptor.
+  int close ();
+
+  /// The ring file descriptor.
+  ACE_HANDLE get_handle () const;
+
+  /// Feature bits (@c IORING_FEAT_*) reported by the kernel.
+  ACE_UINT32 features () const;
+
+  /// Return a cleared submission queue entry to fill in, or 0 if the
+  /// submission queue is full.  The entry is not handed to the kernel
+  /// until the next flush()/enter().
+  struct io_uring_sqe *get_sqe ();
+
+  /// Publish all entries obtained through get_sqe() to the kernel and
+  /// return the number of entries it has not consumed yet.
+  unsigned int flush ();
+
+  /**
+   * Submit @a to_submit entries and, if @a wait_nr is non-zero, wait
+   * for at least @a wait_nr completions.  A null @a timeout waits
+   * forever.
+   *
+   * @return The number of entries consumed by the kernel, or -1 with
+   *         @c errno set.  A wait that times out fails with @c ETIME.
+   */
+  int enter (unsigned int to_submit,
+             unsigned int wait_nr,
+             const ACE_Time_Value *timeout = 0);
+
+  /// Flush and submit any prepared entries without waiting.
+  int submit ();
+
+  /// Return the oldest unconsumed completion, or 0 if there is none.
+  struct io_uring_cqe *peek_cqe ();
+
+  /// Mark the completion returned by peek_cqe() as consumed.
+  void cqe_seen ();
+
+  /// Number of completions ready to be consumed.
+  unsigned int cq_ready () const;
+
+  /**
+   * Register @a count buffers with the kernel so that they can be the
+   * target of @c IORING_OP_READ_FIXED / @c IORING_OP_WRITE_FIXED
+   * requests, which then skip the per-request page pinning.  The
+   * buffer index used by those requests is the position in @a iov.
+   * Only one set of buffers may be registered at a time.
+   */
+  int register_buffers (const iovec *iov, unsigned int count);
+
+  /// Release the buffers registered by register_buffers().
+  int unregister_buffers ();
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  ACE_Uring (const ACE_Uring &) = delete;
+  ACE_Uring &operator= (const ACE_Uring &) = delete;
+
+  /// The ring file descriptor.
+  ACE_HANDLE ring_fd_;
+
+  /// Feature bits returned by io_uring_setup().
+  ACE_UINT32 features_;
+
+  /// @name Submission queue
+  //@{
+  void *sq_ring_;
+  size_t sq_ring_size_;
+  struct io_uring_sqe *sqes_;
+  size_t sqes_size_;
+  unsigned int *sq_khead_;
+  unsigned int *sq_ktail_;
+  unsigned int sq_mask_;
+  unsigned int sq_entries_;
+  unsigned int *sq_array_;
+
+  /// Entries handed out by get_sqe() and not yet published.
+  unsigned int sqe_head_;
+  unsigned int sqe_tail_;
+  //@}
+
+  /// @name Completion queue
+  //@{
+  void *cq_ring_;
+  size_t cq_ring_size_;
+  unsigned int *cq_khead_;
+  unsigned int *cq_ktail_;
+  unsigned int cq_mask_;
+  struct io_uring_cqe *cqes_;
+  //@}
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Uring.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif /* ACE_HAS_IO_URING */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_URING_H */
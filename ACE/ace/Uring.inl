@@ -0,0 +1,54 @@
+// -*- C++ -*-
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE ACE_HANDLE
+ACE_Uring::get_handle () const
+{
+  return this->ring_fd_;
+}
+
+ACE_INLINE ACE_UINT32
+ACE_Uring::features () const
+{
+  return this->features_;
+}
+
+ACE_INLINE struct io_uring_sqe *
+ACE_Uring::get_sqe ()
+{
+  unsigned int const head = __atomic_load_n (this->sq_khead_, __ATOMIC_ACQUIRE);
+
+  if (this->sqe_tail_ - head >= this->sq_entries_)
+    return 0;
+
+  struct io_uring_sqe *sqe = &this->sqes_[this->sqe_tail_ & this->sq_mask_];
+  ++this->sqe_tail_;
+  ACE_OS::memset (sqe, 0, sizeof (*sqe));
+  return sqe;
+}
+
+ACE_INLINE struct io_uring_cqe *
+ACE_Uring::peek_cqe ()
+{
+  unsigned int const head = *this->cq_khead_;
+  if (head == __atomic_load_n (this->cq_ktail_, __ATOMIC_ACQUIRE))
+    return 0;
+
+  return &this->cqes_[head & this->cq_mask_];
+}
+
+ACE_INLINE void
+ACE_Uring::cqe_seen ()
+{
+  __atomic_store_n (this->cq_khead_, *this->cq_khead_ + 1, __ATOMIC_RELEASE);
+}
+
+ACE_INLINE unsigned int
+ACE_Uring::cq_ready () const
+{
+  return __atomic_load_n (this->cq_ktail_, __ATOMIC_ACQUIRE) - *this->cq_khead_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
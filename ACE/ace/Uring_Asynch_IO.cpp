@@ -0,0 +1,243 @@
+#include "ace/Uring_Asynch_IO.h"
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_AIO_CALLS)
+
+#include "ace/Uring_Proactor.h"
+#include "ace/Addr.h"
+#include "ace/Flag_Manip.h"
+#include "ace/Log_Category.h"
+#include "ace/Message_Block.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_sys_socket.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_Uring_Asynch_Accept::ACE_Uring_Asynch_Accept (ACE_Uring_Proactor *uring_proactor)
+  : ACE_POSIX_Asynch_Operation (uring_proactor),
+    uring_proactor_ (uring_proactor)
+{
+}
+
+ACE_Uring_Asynch_Accept::~ACE_Uring_Asynch_Accept ()
+{
+  this->cancel ();
+}
+
+int
+ACE_Uring_Asynch_Accept::accept (ACE_Message_Block &message_block,
+                                 size_t bytes_to_read,
+                                 ACE_HANDLE accept_handle,
+                                 const void *act,
+                                 int priority,
+                                 int signal_number,
+                                 int addr_family)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Accept::accept");
+
+  // Sanity check: make sure that enough space has been allocated by
+  // the caller.
+  size_t address_size = sizeof (sockaddr_in);
+#if defined (ACE_HAS_IPV6)
+  if (addr_family == AF_INET6)
+    address_size = sizeof (sockaddr_in6);
+#else
+  ACE_UNUSED_ARG (addr_family);
+#endif
+  if (message_block.space () < bytes_to_read + 2 * address_size)
+    {
+      ACE_OS::last_error (ENOBUFS);
+      return -1;
+    }
+
+  ACE_Asynch_Accept_Result_Impl *impl =
+    this->uring_proactor_->create_asynch_accept_result (this->handler_proxy_,
+                                                        this->handle_,
+                                                        accept_handle,
+                                                        message_block,
+                                                        bytes_to_read,
+                                                        act,
+                                                        ACE_INVALID_HANDLE,
+                                                        priority,
+                                                        signal_number);
+  ACE_POSIX_Asynch_Result *result =
+    dynamic_cast<ACE_POSIX_Asynch_Result *> (impl);
+  if (result == 0)
+    {
+      delete impl;
+      return -1;
+    }
+
+  if (this->uring_proactor_->start_accept (result, this->handle_, this) == -1)
+    {
+      delete result;
+      return -1;
+    }
+
+  return 0;
+}
+
+int
+ACE_Uring_Asynch_Accept::cancel ()
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Accept::cancel");
+
+  return this->uring_proactor_->cancel_owned (this);
+}
+
+// *********************************************************************
+
+ACE_Uring_Asynch_Connect::ACE_Uring_Asynch_Connect (ACE_Uring_Proactor *uring_proactor)
+  : ACE_POSIX_Asynch_Operation (uring_proactor),
+    uring_proactor_ (uring_proactor)
+{
+}
+
+ACE_Uring_Asynch_Connect::~ACE_Uring_Asynch_Connect ()
+{
+  this->cancel ();
+}
+
+int
+ACE_Uring_Asynch_Connect::open (const ACE_Handler::Proxy_Ptr &handler_proxy,
+                                ACE_HANDLE handle,
+                                const void *completion_key,
+                                ACE_Proactor *proactor)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Connect::open");
+
+  // Ignore the result; connect operations are usually opened without
+  // a handle.
+  (void) ACE_POSIX_Asynch_Operation::open (handler_proxy,
+                                           handle,
+                                           completion_key,
+                                           proactor);
+  return 0;
+}
+
+int
+ACE_Uring_Asynch_Connect::connect (ACE_HANDLE connect_handle,
+                                   const ACE_Addr &remote_sap,
+                                   const ACE_Addr &local_sap,
+                                   int reuse_addr,
+                                   const void *act,
+                                   int priority,
+                                   int signal_number)
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Connect::connect");
+
+  ACE_Asynch_Connect_Result_Impl *impl =
+    this->uring_proactor_->create_asynch_connect_result (this->handler_proxy_,
+                                                         connect_handle,
+                                                         act,
+                                                         ACE_INVALID_HANDLE,
+                                                         priority,
+                                                         signal_number);
+  ACE_POSIX_Asynch_Result *result =
+    dynamic_cast<ACE_POSIX_Asynch_Result *> (impl);
+  if (result == 0)
+    {
+      delete impl;
+      return -1;
+    }
+
+  if (this->prepare_i (result, remote_sap, local_sap, reuse_addr) == 0
+      && this->uring_proactor_->start_connect (result, remote_sap, this) == 0)
+    return 0;
+
+  // As with ACE_POSIX_Asynch_Connect, failures to set up the connect
+  // are reported through the completion handler.
+  if (result->error () == 0)
+    result->set_error (errno);
+  result->set_bytes_transferred (0);
+
+  if (this->uring_proactor_->post_completion (result) == 0)
+    return 0;
+
+  if (result->aio_fildes != ACE_INVALID_HANDLE)
+    ACE_OS::closesocket (result->aio_fildes);
+  delete result;
+  return -1;
+}
+
+int
+ACE_Uring_Asynch_Connect::cancel ()
+{
+  ACE_TRACE ("ACE_Uring_Asynch_Connect::cancel");
+
+  return this->uring_proactor_->cancel_owned (this);
+}
+
+int
+ACE_Uring_Asynch_Connect::prepare_i (ACE_POSIX_Asynch_Result *result,
+                                     const ACE_Addr &remote_sap,
+                                     const ACE_Addr &local_sap,
+                                     int reuse_addr)
+{
+  ACE_HANDLE handle = result->aio_fildes;
+
+  if (handle == ACE_INVALID_HANDLE)
+    {
+      int const protocol_family = remote_sap.get_type ();
+
+      handle = ACE_OS::socket (protocol_family, SOCK_STREAM, 0);
+      result->aio_fildes = handle;
+      if (handle == ACE_INVALID_HANDLE)
+        {
+          result->set_error (errno);
+          ACELIB_ERROR_RETURN
+            ((LM_ERROR,
+              ACE_TEXT ("ACE_Uring_Asynch_Connect::prepare_i: %p\n"),
+              ACE_TEXT ("socket")),
+             -1);
+        }
+
+      int one = 1;
+      if (protocol_family != PF_UNIX
+          && reuse_addr != 0
+          && ACE_OS::setsockopt (handle,
+                                 SOL_SOCKET,
+                                 SO_REUSEADDR,
+                                 (const char*) &one,
+                                 sizeof one) == -1)
+        {
+          result->set_error (errno);
+          ACELIB_ERROR_RETURN
+            ((LM_ERROR,
+              ACE_TEXT ("ACE_Uring_Asynch_Connect::prepare_i: %p\n"),
+              ACE_TEXT ("setsockopt")),
+             -1);
+        }
+    }
+
+  if (local_sap != ACE_Addr::sap_any)
+    {
+      sockaddr *laddr = reinterpret_cast<sockaddr *> (local_sap.get_addr ());
+      if (ACE_OS::bind (handle, laddr, local_sap.get_size ()) == -1)
+        {
+          result->set_error (errno);
+          ACELIB_ERROR_RETURN
+            ((LM_ERROR,
+              ACE_TEXT ("ACE_Uring_Asynch_Connect::prepare_i: %p\n"),
+              ACE_TEXT ("bind")),
+             -1);
+        }
+    }
+
+  // Leave the handle in the same state as ACE_POSIX_Asynch_Connect
+  // does; the ring completes the connect either way.
+  if (ACE::set_flags (handle, ACE_NONBLOCK) != 0)
+    {
+      result->set_error (errno);
+      ACELIB_ERROR_RETURN
+        ((LM_ERROR,
+          ACE_TEXT ("ACE_Uring_Asynch_Connect::prepare_i: %p\n"),
+          ACE_TEXT ("set_flags")),
+         -1);
+    }
+
+  return 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_IO_URING && ACE_HAS_AIO_CALLS */
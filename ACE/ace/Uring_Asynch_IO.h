@@ -0,0 +1,128 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Uring_Asynch_IO.h
+ *
+ *  Asynchronous accept and connect operations of the ACE_Uring_Proactor.
+ */
+//=============================================================================
+
+#ifndef ACE_URING_ASYNCH_IO_H
+#define ACE_URING_ASYNCH_IO_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_AIO_CALLS)
+
+#include "ace/POSIX_Asynch_IO.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Uring_Proactor;
+
+/**
+ * @class ACE_Uring_Asynch_Accept
+ *
+ * @brief Asynchronous accept that is started on the proactor's ring.
+ *
+ * Completions are reported with the ordinary
+ * ACE_POSIX_Asynch_Accept_Result.  As on the other POSIX proactors, no
+ * initial data is read.  Unlike ACE_POSIX_Asynch_Accept, the listen
+ * handle stays owned by the caller.
+ */
+class ACE_Export ACE_Uring_Asynch_Accept :
+  public virtual ACE_Asynch_Accept_Impl,
+  public ACE_POSIX_Asynch_Operation
+{
+public:
+  /// Constructor.
+  ACE_Uring_Asynch_Accept (ACE_Uring_Proactor *uring_proactor);
+
+  /// Destructor.  Cancels the outstanding accepts.
+  virtual ~ACE_Uring_Asynch_Accept ();
+
+  /**
+   * Start an asynchronous accept.  @a message_block must have room for
+   * @a bytes_to_read bytes plus two addresses of @a addr_family, to be
+   * compatible with the other implementations; @a accept_handle is
+   * ignored and a new handle is always created.
+   */
+  int accept (ACE_Message_Block &message_block,
+              size_t bytes_to_read,
+              ACE_HANDLE accept_handle,
+              const void *act,
+              int priority,
+              int signal_number = 0,
+              int addr_family = AF_INET);
+
+  /// Cancel all the outstanding accepts started by this object.
+  int cancel ();
+
+private:
+  ACE_Uring_Proactor *uring_proactor_;
+};
+
+/**
+ * @class ACE_Uring_Asynch_Connect
+ *
+ * @brief Asynchronous connect that is started on the proactor's ring.
+ */
+class ACE_Export ACE_Uring_Asynch_Connect :
+  public virtual ACE_Asynch_Connect_Impl,
+  public ACE_POSIX_Asynch_Operation
+{
+public:
+  /// Constructor.
+  ACE_Uring_Asynch_Connect (ACE_Uring_Proactor *uring_proactor);
+
+  /// Destructor.  Cancels the outstanding connects.
+  virtual ~ACE_Uring_Asynch_Connect ();
+
+  /// No handle is needed to open a connect operation.
+  int open (const ACE_Handler::Proxy_Ptr &handler_proxy,
+            ACE_HANDLE handle,
+            const void *completion_key,
+            ACE_Proactor *proactor = 0);
+
+  /**
+   * Start an asynchronous connect.
+   *
+   * @arg connect_handle   will be used for the connect call.  If
+   *                       ACE_INVALID_HANDLE is specified, a new
+   *                       handle will be created.
+   */
+  int connect (ACE_HANDLE connect_handle,
+               const ACE_Addr &remote_sap,
+               const ACE_Addr &local_sap,
+               int reuse_addr,
+               const void *act,
+               int priority,
+               int signal_number = 0);
+
+  /// Cancel all the outstanding connects started by this object.
+  int cancel ();
+
+private:
+  /// Create, configure and bind the handle of @a result as needed.
+  int prepare_i (ACE_POSIX_Asynch_Result *result,
+                 const ACE_Addr &remote_sap,
+                 const ACE_Addr &local_sap,
+                 int reuse_addr);
+
+  ACE_Uring_Proactor *uring_proactor_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_IO_URING && ACE_HAS_AIO_CALLS */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_URING_ASYNCH_IO_H */
@@ -0,0 +1,731 @@
+#include "ace/Uring_Proactor.h"
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_AIO_CALLS)
+
+#include "ace/Uring_Asynch_IO.h"
+#include "ace/Addr.h"
+#include "ace/Countdown_Time.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Message_Block.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Reverse_Lock_T.h"
+#include "ace/Time_Value.h"
+
+#include <memory>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Uring_Proactor)
+
+namespace
+{
+  /// user_data of the no-op submitted for each posted completion.
+  const ACE_UINT64 wakeup_user_data = 0;
+
+  /// user_data of submissions whose completions carry no result.
+  const ACE_UINT64 ignored_user_data = ~static_cast<ACE_UINT64> (0);
+
+  /// user_data of the operation in slot @a index, never equal to
+  /// either of the above.
+  inline ACE_UINT64
+  make_user_data (size_t index, ACE_UINT32 generation)
+  {
+    return (static_cast<ACE_UINT64> (generation) << 32)
+      | static_cast<ACE_UINT32> (index + 1);
+  }
+
+  inline size_t
+  user_data_index (ACE_UINT64 user_data)
+  {
+    return static_cast<size_t> (static_cast<ACE_UINT32> (user_data) - 1);
+  }
+
+  inline ACE_UINT32
+  user_data_generation (ACE_UINT64 user_data)
+  {
+    return static_cast<ACE_UINT32> (user_data >> 32);
+  }
+
+  /// Stream operations use the current file position, file
+  /// operations the offset they were started with.
+  inline ACE_UINT64
+  io_offset (ACE_POSIX_Asynch_Result *result)
+  {
+    if (dynamic_cast<ACE_Asynch_Read_File_Result_Impl *> (result) != 0
+        || dynamic_cast<ACE_Asynch_Write_File_Result_Impl *> (result) != 0)
+      return result->aio_offset;
+
+    return ~static_cast<ACE_UINT64> (0);
+  }
+}
+
+ACE_Uring_Proactor::ACE_Uring_Proactor (size_t max_aio_operations)
+  : slots_ (0),
+    slots_size_ (0),
+    free_slot_ (0),
+    slots_used_ (0),
+    fixed_buffers_ (0),
+    fixed_buffers_size_ (0),
+    waiters_ (0)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::ACE_Uring_Proactor");
+
+  if (max_aio_operations == 0)
+    max_aio_operations = ACE_AIO_DEFAULT_SIZE;
+
+  ACE_NEW (this->slots_, Slot[max_aio_operations]);
+  this->slots_size_ = max_aio_operations;
+  for (size_t i = 0; i < max_aio_operations; ++i)
+    {
+      this->slots_[i].result = 0;
+      this->slots_[i].handle = ACE_INVALID_HANDLE;
+      this->slots_[i].owner = 0;
+      this->slots_[i].type = SLOT_FREE;
+      this->slots_[i].addr = 0;
+      this->slots_[i].next_free = i + 1;
+      this->slots_[i].generation = 0;
+    }
+
+  // Every outstanding operation, wakeup and cancellation may leave a
+  // completion behind, so size the completion queue for the worst case
+  // of all slots being busy.
+  unsigned int cq_entries = 2 * ACE_URING_PROACTOR_ENTRIES;
+  if (cq_entries < 2 * max_aio_operations)
+    cq_entries = static_cast<unsigned int> (2 * max_aio_operations);
+
+  if (this->ring_.open (ACE_URING_PROACTOR_ENTRIES, cq_entries) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%N:%l:(%P | %t)::%p\n"),
+                   ACE_TEXT ("ACE_Uring_Proactor: ring open failed")));
+}
+
+ACE_Uring_Proactor::~ACE_Uring_Proactor ()
+{
+  this->close ();
+}
+
+ACE_POSIX_Proactor::Proactor_Type
+ACE_Uring_Proactor::get_impl_type ()
+{
+  return PROACTOR_URING;
+}
+
+int
+ACE_Uring_Proactor::close ()
+{
+  ACE_TRACE ("ACE_Uring_Proactor::close");
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+  this->close_i ();
+  return 0;
+}
+
+void
+ACE_Uring_Proactor::close_i ()
+{
+  if (this->ring_.get_handle () != ACE_INVALID_HANDLE)
+    {
+      // The kernel may still be using the buffers of outstanding
+      // operations, so withdraw them and wait (briefly) for them to go
+      // away before the results and their buffers can be released.
+      for (size_t i = 0; i < this->slots_size_; ++i)
+        if (this->slots_[i].type != SLOT_FREE)
+          (void) this->cancel_slot_i (i);
+
+      ACE_Time_Value const max_wait (1);
+      while (this->slots_used_ > 0)
+        {
+          struct io_uring_cqe *cqe = 0;
+          while ((cqe = this->ring_.peek_cqe ()) != 0)
+            {
+              ACE_UINT64 const user_data = cqe->user_data;
+              this->ring_.cqe_seen ();
+
+              if (user_data == wakeup_user_data
+                  || user_data == ignored_user_data)
+                continue;
+
+              size_t const index = user_data_index (user_data);
+              if (this->stale_i (index, user_data))
+                continue;
+
+              delete this->slots_[index].result;
+              this->free_slot_i (index);
+            }
+
+          if (this->slots_used_ == 0
+              || this->ring_.enter (this->ring_.flush (), 1, &max_wait) == -1)
+            break;
+        }
+
+      if (this->fixed_buffers_ != 0)
+        (void) this->ring_.unregister_buffers ();
+
+      (void) this->ring_.close ();
+    }
+
+  for (size_t i = 0; i < this->slots_size_; ++i)
+    if (this->slots_[i].type != SLOT_FREE)
+      {
+        delete this->slots_[i].result;
+        this->free_slot_i (i);
+      }
+
+  ACE_POSIX_Asynch_Result *result = 0;
+  while (this->result_queue_.dequeue_head (result) == 0)
+    delete result;
+
+  delete [] this->fixed_buffers_;
+  this->fixed_buffers_ = 0;
+  this->fixed_buffers_size_ = 0;
+}
+
+int
+ACE_Uring_Proactor::handle_events (ACE_Time_Value &wait_time)
+{
+  // Decrement <wait_time> with the amount of time spent in the method
+  return this->handle_events_i (&wait_time);
+}
+
+int
+ACE_Uring_Proactor::handle_events ()
+{
+  return this->handle_events_i (0);
+}
+
+int
+ACE_Uring_Proactor::handle_events_i (ACE_Time_Value *timeout)
+{
+  ACE_Countdown_Time countdown (timeout);
+
+  for (;;)
+    {
+      ACE_POSIX_Asynch_Result *result = 0;
+      size_t bytes_transferred = 0;
+      u_long error = 0;
+
+      {
+        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+        if (this->ring_.get_handle () == ACE_INVALID_HANDLE)
+          {
+            errno = ESHUTDOWN;
+            return -1;
+          }
+
+        struct io_uring_cqe *cqe = this->ring_.peek_cqe ();
+        if (cqe == 0)
+          {
+            unsigned int const pending = this->ring_.flush ();
+            ++this->waiters_;
+
+            int rc = 0;
+            {
+              ACE_Reverse_Lock<ACE_SYNCH_MUTEX> reverse (this->lock_);
+              ACE_MT (ACE_GUARD_RETURN (ACE_Reverse_Lock<ACE_SYNCH_MUTEX>,
+                                        rguard, reverse, -1));
+
+              rc = this->ring_.enter (pending, 1, timeout);
+            }
+
+            --this->waiters_;
+
+            if (rc == -1)
+              {
+                if (errno == ETIME || errno == EINTR)
+                  return 0;
+                if (errno != EBUSY && errno != EAGAIN)
+                  ACELIB_ERROR_RETURN ((LM_ERROR,
+                                        ACE_TEXT ("%N:%l:(%P | %t)::%p\n"),
+                                        ACE_TEXT ("ACE_Uring_Proactor::")
+                                        ACE_TEXT ("handle_events: ")
+                                        ACE_TEXT ("io_uring_enter failed")),
+                                       -1);
+              }
+
+            countdown.update ();
+            continue;
+          }
+
+        ACE_UINT64 const user_data = cqe->user_data;
+        int const res = cqe->res;
+        this->ring_.cqe_seen ();
+
+        if (user_data == ignored_user_data)
+          continue;
+
+        if (user_data == wakeup_user_data)
+          {
+            // One posted result per wakeup.
+            if (this->result_queue_.dequeue_head (result) != 0)
+              continue;
+
+            bytes_transferred = result->bytes_transferred ();
+            error = result->error ();
+          }
+        else
+          {
+            size_t const index = user_data_index (user_data);
+            if (this->stale_i (index, user_data))
+              continue;
+
+            Slot &slot = this->slots_[index];
+            result = slot.result;
+
+            if (res >= 0)
+              {
+                if (slot.type == SLOT_IO)
+                  bytes_transferred = static_cast<size_t> (res);
+                else if (slot.type == SLOT_ACCEPT)
+                  result->aio_fildes = res;
+              }
+            else
+              {
+                error = static_cast<u_long> (-res);
+                if (slot.type == SLOT_ACCEPT)
+                  result->aio_fildes = ACE_INVALID_HANDLE;
+              }
+
+            this->free_slot_i (index);
+          }
+      }
+
+      // Call the application code.
+      this->application_specific_code (result,
+                                       bytes_transferred,
+                                       0, // No completion key.
+                                       error);
+      return 1;
+    }
+}
+
+int
+ACE_Uring_Proactor::post_completion (ACE_POSIX_Asynch_Result *result)
+{
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  if (result == 0 || this->ring_.get_handle () == ACE_INVALID_HANDLE)
+    return -1;
+
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    return -1;
+
+  if (this->result_queue_.enqueue_tail (result) == -1)
+    {
+      // The no-op is harmless on its own.
+      sqe->opcode = IORING_OP_NOP;
+      sqe->user_data = ignored_user_data;
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("%N:%l:ACE_Uring_Proactor::")
+                            ACE_TEXT ("post_completion failed\n")),
+                           -1);
+    }
+
+  sqe->opcode = IORING_OP_NOP;
+  sqe->user_data = wakeup_user_data;
+
+  return this->kick_i ();
+}
+
+int
+ACE_Uring_Proactor::start_aio (ACE_POSIX_Asynch_Result *result,
+                               ACE_POSIX_Proactor::Opcode op)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::start_aio");
+
+  ACE_UINT64 const offset = io_offset (result);
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  int const buf_index =
+    this->find_fixed_buffer_i (const_cast<void *> (result->aio_buf),
+                               result->aio_nbytes);
+
+  ACE_UINT8 opcode = 0;
+  switch (op)
+    {
+    case ACE_POSIX_Proactor::ACE_OPCODE_READ:
+      opcode = buf_index >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+      break;
+
+    case ACE_POSIX_Proactor::ACE_OPCODE_WRITE:
+      opcode = buf_index >= 0 ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+      break;
+
+    default:
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("%N:%l:(%P|%t)::")
+                            ACE_TEXT ("start_aio: Invalid op code %d\n"),
+                            op),
+                           -1);
+    }
+
+  ssize_t const index =
+    this->allocate_slot_i (result, result->aio_fildes, SLOT_IO, 0);
+  if (index == -1)
+    return -1;
+
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    {
+      this->free_slot_i (static_cast<size_t> (index));
+      return -1;
+    }
+
+  sqe->opcode = opcode;
+  sqe->fd = result->aio_fildes;
+  sqe->addr = reinterpret_cast<ACE_UINT64> (result->aio_buf);
+  sqe->len = static_cast<ACE_UINT32> (result->aio_nbytes);
+  sqe->off = offset;
+  if (buf_index >= 0)
+    sqe->buf_index = static_cast<ACE_UINT16> (buf_index);
+  sqe->user_data =
+    make_user_data (static_cast<size_t> (index),
+                    this->slots_[index].generation);
+
+  return this->kick_i ();
+}
+
+int
+ACE_Uring_Proactor::start_accept (ACE_POSIX_Asynch_Result *result,
+                                  ACE_HANDLE listen_handle,
+                                  const void *owner)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::start_accept");
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  ssize_t const index =
+    this->allocate_slot_i (result, listen_handle, SLOT_ACCEPT, owner);
+  if (index == -1)
+    return -1;
+
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    {
+      this->free_slot_i (static_cast<size_t> (index));
+      return -1;
+    }
+
+  sqe->opcode = IORING_OP_ACCEPT;
+  sqe->fd = listen_handle;
+  sqe->user_data =
+    make_user_data (static_cast<size_t> (index),
+                    this->slots_[index].generation);
+
+  return this->kick_i ();
+}
+
+int
+ACE_Uring_Proactor::start_connect (ACE_POSIX_Asynch_Result *result,
+                                   const ACE_Addr &remote_sap,
+                                   const void *owner)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::start_connect");
+
+  int const addr_size = remote_sap.get_size ();
+  char *addr = 0;
+  ACE_NEW_RETURN (addr, char[addr_size], -1);
+  ACE_OS::memcpy (addr, remote_sap.get_addr (), addr_size);
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  ssize_t const index =
+    this->allocate_slot_i (result, result->aio_fildes, SLOT_CONNECT, owner);
+  if (index == -1)
+    {
+      delete [] addr;
+      return -1;
+    }
+  this->slots_[index].addr = addr;
+
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    {
+      this->free_slot_i (static_cast<size_t> (index));
+      return -1;
+    }
+
+  sqe->opcode = IORING_OP_CONNECT;
+  sqe->fd = result->aio_fildes;
+  sqe->addr = reinterpret_cast<ACE_UINT64> (addr);
+  sqe->off = static_cast<ACE_UINT64> (addr_size);
+  sqe->user_data =
+    make_user_data (static_cast<size_t> (index),
+                    this->slots_[index].generation);
+
+  return this->kick_i ();
+}
+
+int
+ACE_Uring_Proactor::cancel_aio (ACE_HANDLE handle)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::cancel_aio");
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  int num_cancelled = 0;
+  for (size_t i = 0; i < this->slots_size_; ++i)
+    if (this->slots_[i].type == SLOT_IO
+        && this->slots_[i].handle == handle
+        && this->cancel_slot_i (i) == 0)
+      ++num_cancelled;
+
+  if (num_cancelled == 0)
+    return 1;  // ALLDONE
+
+  // Cancellations are not worth batching.
+  return this->ring_.submit () == -1 ? -1 : 0;  // CANCELLED
+}
+
+int
+ACE_Uring_Proactor::cancel_owned (const void *owner)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::cancel_owned");
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  int num_cancelled = 0;
+  for (size_t i = 0; i < this->slots_size_; ++i)
+    if (this->slots_[i].type != SLOT_FREE
+        && this->slots_[i].owner == owner
+        && this->cancel_slot_i (i) == 0)
+      ++num_cancelled;
+
+  if (num_cancelled == 0)
+    return 1;  // ALLDONE
+
+  return this->ring_.submit () == -1 ? -1 : 0;  // CANCELLED
+}
+
+ACE_Asynch_Accept_Impl *
+ACE_Uring_Proactor::create_asynch_accept ()
+{
+  ACE_Asynch_Accept_Impl *implementation = 0;
+  ACE_NEW_RETURN (implementation,
+                  ACE_Uring_Asynch_Accept (this),
+                  0);
+  return implementation;
+}
+
+ACE_Asynch_Connect_Impl *
+ACE_Uring_Proactor::create_asynch_connect ()
+{
+  ACE_Asynch_Connect_Impl *implementation = 0;
+  ACE_NEW_RETURN (implementation,
+                  ACE_Uring_Asynch_Connect (this),
+                  0);
+  return implementation;
+}
+
+int
+ACE_Uring_Proactor::register_buffers (ACE_Message_Block *message_block)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::register_buffers");
+
+  unsigned int count = 0;
+  for (ACE_Message_Block *mb = message_block; mb != 0; mb = mb->cont ())
+    ++count;
+
+  if (count == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  iovec *iov = 0;
+  ACE_NEW_RETURN (iov, iovec[count], -1);
+  std::unique_ptr<iovec[]> iov_holder (iov);
+
+  Fixed_Buffer *buffers = 0;
+  ACE_NEW_RETURN (buffers, Fixed_Buffer[count], -1);
+  std::unique_ptr<Fixed_Buffer[]> buffers_holder (buffers);
+
+  unsigned int i = 0;
+  for (ACE_Message_Block *mb = message_block; mb != 0; mb = mb->cont (), ++i)
+    {
+      buffers[i].base = mb->base ();
+      buffers[i].size = mb->size ();
+      iov[i].iov_base = mb->base ();
+      iov[i].iov_len = mb->size ();
+    }
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  if (this->fixed_buffers_ != 0)
+    {
+      if (this->ring_.unregister_buffers () == -1)
+        return -1;
+
+      delete [] this->fixed_buffers_;
+      this->fixed_buffers_ = 0;
+      this->fixed_buffers_size_ = 0;
+    }
+
+  if (this->ring_.register_buffers (iov, count) == -1)
+    return -1;
+
+  this->fixed_buffers_ = buffers_holder.release ();
+  this->fixed_buffers_size_ = count;
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::unregister_buffers ()
+{
+  ACE_TRACE ("ACE_Uring_Proactor::unregister_buffers");
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  if (this->fixed_buffers_ == 0)
+    return 0;
+
+  if (this->ring_.unregister_buffers () == -1)
+    return -1;
+
+  delete [] this->fixed_buffers_;
+  this->fixed_buffers_ = 0;
+  this->fixed_buffers_size_ = 0;
+  return 0;
+}
+
+ssize_t
+ACE_Uring_Proactor::allocate_slot_i (ACE_POSIX_Asynch_Result *result,
+                                     ACE_HANDLE handle,
+                                     Slot_Type type,
+                                     const void *owner)
+{
+  if (this->ring_.get_handle () == ACE_INVALID_HANDLE)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  if (this->free_slot_ >= this->slots_size_)
+    {
+      errno = EAGAIN;
+      return -1;
+    }
+
+  size_t const index = this->free_slot_;
+  Slot &slot = this->slots_[index];
+  this->free_slot_ = slot.next_free;
+
+  slot.result = result;
+  slot.handle = handle;
+  slot.owner = owner;
+  slot.type = type;
+  slot.addr = 0;
+  ++this->slots_used_;
+
+  return static_cast<ssize_t> (index);
+}
+
+void
+ACE_Uring_Proactor::free_slot_i (size_t index)
+{
+  Slot &slot = this->slots_[index];
+
+  delete [] slot.addr;
+  slot.addr = 0;
+  slot.result = 0;
+  slot.handle = ACE_INVALID_HANDLE;
+  slot.owner = 0;
+  slot.type = SLOT_FREE;
+  slot.next_free = this->free_slot_;
+  ++slot.generation;
+  this->free_slot_ = index;
+  --this->slots_used_;
+}
+
+struct io_uring_sqe *
+ACE_Uring_Proactor::get_sqe_i ()
+{
+  struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+  if (sqe == 0)
+    {
+      // The submission queue is full; hand what we have to the kernel.
+      if (this->ring_.submit () == -1)
+        return 0;
+
+      sqe = this->ring_.get_sqe ();
+      if (sqe == 0)
+        errno = EAGAIN;
+    }
+
+  return sqe;
+}
+
+int
+ACE_Uring_Proactor::kick_i ()
+{
+  if (this->waiters_ > 0)
+    return this->ring_.submit () == -1 ? -1 : 0;
+
+  // The next thread to wait submits the entry along with its wait.
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::cancel_slot_i (size_t index)
+{
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    return -1;
+
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  // Keyed by the generation too: if the operation completes before
+  // the cancellation is processed, the cancellation must not hit the
+  // next operation started in the slot.
+  sqe->addr = make_user_data (index, this->slots_[index].generation);
+  sqe->user_data = ignored_user_data;
+  return 0;
+}
+
+bool
+ACE_Uring_Proactor::stale_i (size_t index, ACE_UINT64 user_data) const
+{
+  return index >= this->slots_size_
+    || this->slots_[index].type == SLOT_FREE
+    || this->slots_[index].generation != user_data_generation (user_data);
+}
+
+int
+ACE_Uring_Proactor::find_fixed_buffer_i (const void *buf, size_t len) const
+{
+  const char *p = static_cast<const char *> (buf);
+
+  for (unsigned int i = 0; i < this->fixed_buffers_size_; ++i)
+    {
+      const Fixed_Buffer &fb = this->fixed_buffers_[i];
+      if (p >= fb.base && p + len <= fb.base + fb.size)
+        return static_cast<int> (i);
+    }
+
+  return -1;
+}
+
+void
+ACE_Uring_Proactor::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Uring_Proactor::dump");
+
+  this->ring_.dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("slots_size_ = %B"), this->slots_size_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nslots_used_ = %B"), this->slots_used_));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("\nfixed_buffers_size_ = %u\n"),
+                 this->fixed_buffers_size_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_IO_URING && ACE_HAS_AIO_CALLS */
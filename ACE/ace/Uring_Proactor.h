@@ -0,0 +1,258 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Uring_Proactor.h
+ *
+ *  Linux @c io_uring based Proactor implementation.
+ */
+//=============================================================================
+
+#ifndef ACE_URING_PROACTOR_H
+#define ACE_URING_PROACTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_AIO_CALLS)
+
+#include "ace/POSIX_Proactor.h"
+#include "ace/Uring.h"
+#include "ace/Unbounded_Queue.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Null_Mutex.h"
+
+#if !defined (ACE_URING_PROACTOR_ENTRIES)
+/// Default number of submission queue entries of the proactor's ring.
+#  define ACE_URING_PROACTOR_ENTRIES 256
+#endif /* ACE_URING_PROACTOR_ENTRIES */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Addr;
+class ACE_Message_Block;
+
+/**
+ * @class ACE_Uring_Proactor
+ *
+ * @brief Proactor that starts and completes asynchronous operations
+ *        through a Linux @c io_uring.
+ *
+ * The stream and file operations and their result classes are the
+ * ordinary ACE_POSIX_Asynch_* ones; only the way the operations are
+ * started and their completions are collected differs.  Unlike the
+ * @c aio_* based proactors, socket operations are asynchronous in the
+ * kernel, and accepts and connects are started on the ring as well
+ * instead of being emulated by the pseudo-asynchronous reactor task
+ * (see ACE_Uring_Asynch_Accept and ACE_Uring_Asynch_Connect).
+ *
+ * Any number of threads may run the event loop.  Each call to
+ * handle_events() dispatches at most one completion.
+ *
+ * Message blocks can be registered with register_buffers(); reads
+ * into and writes from them are then started as fixed-buffer requests,
+ * which saves the kernel from pinning the pages on every request.
+ *
+ * @note Requires Linux 5.11 or later.
+ */
+class ACE_Export ACE_Uring_Proactor : public ACE_POSIX_Proactor
+{
+public:
+  /// Constructor defines max number asynchronous operations that can
+  /// be outstanding at the same time.
+  ACE_Uring_Proactor (size_t max_aio_operations = ACE_AIO_DEFAULT_SIZE);
+
+  /// Destructor.
+  virtual ~ACE_Uring_Proactor ();
+
+  virtual Proactor_Type get_impl_type ();
+
+  /// Close down the Proactor.  Outstanding operations are dropped
+  /// without being completed.
+  virtual int close ();
+
+  /**
+   * Dispatch a single completion.  If @a wait_time elapses before
+   * any completion arrives, return 0.  Return 1 when a completion is
+   * dispatched, -1 on errors with errno set accordingly.
+   */
+  virtual int handle_events (ACE_Time_Value &wait_time);
+
+  /// Block until a single completion has been dispatched.
+  virtual int handle_events ();
+
+  virtual int post_completion (ACE_POSIX_Asynch_Result *result);
+
+  virtual int start_aio (ACE_POSIX_Asynch_Result *result, Opcode op);
+
+  virtual int cancel_aio (ACE_HANDLE h);
+
+  /// Accept and connect operations that complete on the ring.
+  //@{
+  virtual ACE_Asynch_Accept_Impl *create_asynch_accept ();
+  virtual ACE_Asynch_Connect_Impl *create_asynch_connect ();
+  //@}
+
+  /**
+   * Register the data buffers of the message blocks in the
+   * @a message_block chain (linked through @c cont()) as fixed
+   * buffers.  Replaces any previous registration.  Must not be called
+   * while operations using previously registered buffers are
+   * outstanding.
+   */
+  int register_buffers (ACE_Message_Block *message_block);
+
+  /// Drop the registration made by register_buffers().
+  int unregister_buffers ();
+
+  /// @name Used by ACE_Uring_Asynch_Accept and ACE_Uring_Asynch_Connect
+  //@{
+  /// Start accepting a connection on @a listen_handle for @a result.
+  int start_accept (ACE_POSIX_Asynch_Result *result,
+                    ACE_HANDLE listen_handle,
+                    const void *owner);
+
+  /// Start connecting @c result->aio_fildes to @a remote_sap.
+  int start_connect (ACE_POSIX_Asynch_Result *result,
+                     const ACE_Addr &remote_sap,
+                     const void *owner);
+
+  /**
+   * Cancel all operations started by @a owner.  Returns 0 if
+   * cancellation was requested for at least one operation (each of
+   * them completes with @c ECANCELED unless it completes first), 1 if
+   * there was none.
+   */
+  int cancel_owned (const void *owner);
+  //@}
+
+  /// Dump the state of an object.
+  void dump () const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /**
+   * Dispatch a single completion.  Waits at most @a timeout, or
+   * forever if @a timeout is 0.
+   */
+  int handle_events_i (ACE_Time_Value *timeout);
+
+private:
+  /// Kinds of operations that can be outstanding on the ring.
+  enum Slot_Type
+  {
+    SLOT_FREE,
+    SLOT_IO,
+    SLOT_ACCEPT,
+    SLOT_CONNECT
+  };
+
+  /// State of one outstanding operation.  The slot index (plus one),
+  /// tagged with the slot's generation, is the @c user_data of the
+  /// operation's submission.
+  struct Slot
+  {
+    ACE_POSIX_Asynch_Result *result;
+    ACE_HANDLE handle;
+    const void *owner;
+    Slot_Type type;
+
+    /// Copy of the peer address of a connect, which must stay valid
+    /// until the request completes.
+    char *addr;
+
+    /// Next free slot.
+    size_t next_free;
+
+    /// Incremented whenever the slot is freed, so that a cancellation
+    /// or completion of an earlier operation in the slot never matches
+    /// the operation that reuses it.
+    ACE_UINT32 generation;
+  };
+
+  /// A buffer registered with register_buffers().
+  struct Fixed_Buffer
+  {
+    char *base;
+    size_t size;
+  };
+
+  /// Take a free slot for @a result; returns the slot index or -1 with
+  /// errno set to @c EAGAIN if all slots are in use.
+  ssize_t allocate_slot_i (ACE_POSIX_Asynch_Result *result,
+                           ACE_HANDLE handle,
+                           Slot_Type type,
+                           const void *owner);
+
+  /// Return slot @a index to the free list.
+  void free_slot_i (size_t index);
+
+  /// Return a submission entry, submitting queued entries to make
+  /// room if the submission queue is full.
+  struct io_uring_sqe *get_sqe_i ();
+
+  /// Submit the queued entries if another thread is waiting in the
+  /// ring; otherwise leave them for the next wait.
+  int kick_i ();
+
+  /// Queue the cancellation of the operation in slot @a index.
+  int cancel_slot_i (size_t index);
+
+  /// True if the completion with @a user_data, for slot @a index, is
+  /// not that of the operation currently in the slot.
+  bool stale_i (size_t index, ACE_UINT64 user_data) const;
+
+  /// Index of the registered buffer that contains [@a buf, @a buf +
+  /// @a len), or -1.
+  int find_fixed_buffer_i (const void *buf, size_t len) const;
+
+  /// Free all the resources; called with @c lock_ held.
+  void close_i ();
+
+private:
+  /// The ring.
+  ACE_Uring ring_;
+
+  /// Serializes access to the ring queues and all other members.
+  ACE_SYNCH_MUTEX lock_;
+
+  /// Outstanding operations.
+  Slot *slots_;
+
+  /// Number of entries in @c slots_.
+  size_t slots_size_;
+
+  /// Head of the free slot list; @c slots_size_ if the list is empty.
+  size_t free_slot_;
+
+  /// Number of slots in use.
+  size_t slots_used_;
+
+  /// Results posted with post_completion(), dispatched one per
+  /// wakeup completion.
+  ACE_Unbounded_Queue<ACE_POSIX_Asynch_Result *> result_queue_;
+
+  /// Buffers registered with register_buffers().
+  Fixed_Buffer *fixed_buffers_;
+
+  /// Number of entries in @c fixed_buffers_.
+  unsigned int fixed_buffers_size_;
+
+  /// Number of threads blocked in the ring.
+  int waiters_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_IO_URING && ACE_HAS_AIO_CALLS */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_URING_PROACTOR_H */
@@ -0,0 +1,382 @@
+#include "ace/Uring_Reactor.h"
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_EVENT_POLL)
+
+#include "ace/ACE.h"
+#include "ace/Countdown_Time.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Reverse_Lock_T.h"
+#include "ace/Time_Value.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Uring_Reactor)
+
+namespace
+{
+  /// user_data of submissions whose completions carry no event.
+  const ACE_UINT64 ignored_user_data = ~static_cast<ACE_UINT64> (0);
+
+  inline ACE_UINT64
+  make_user_data (ACE_HANDLE handle, ACE_UINT32 generation)
+  {
+    return (static_cast<ACE_UINT64> (generation) << 32)
+      | static_cast<ACE_UINT32> (handle);
+  }
+
+  inline ACE_UINT32
+  poll_mask (__uint32_t events)
+  {
+    ACE_UINT32 const mask = events & ~static_cast<__uint32_t> (EPOLLONESHOT);
+#if defined (ACE_BYTE_ORDER) && ACE_BYTE_ORDER == ACE_BIG_ENDIAN
+    // The kernel reads poll32_events as two swapped 16 bit halves on
+    // big endian hosts.
+    return (mask << 16) | (mask >> 16);
+#else
+    return mask;
+#endif /* ACE_BYTE_ORDER == ACE_BIG_ENDIAN */
+  }
+}
+
+ACE_Uring_Reactor::ACE_Uring_Reactor (ACE_Sig_Handler *sh,
+                                      ACE_Timer_Queue *tq,
+                                      int disable_notify_pipe,
+                                      ACE_Reactor_Notify *notify,
+                                      int mask_signals,
+                                      int s_queue)
+  : ACE_Dev_Poll_Reactor (mask_signals, s_queue, true)
+  , ring_ ()
+  , ring_lock_ ()
+  , requests_ (0)
+  , requests_size_ (0)
+  , waiting_ (false)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::ACE_Uring_Reactor");
+
+  if (this->open (ACE::max_handles (),
+                  false,
+                  sh,
+                  tq,
+                  disable_notify_pipe,
+                  notify) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%p\n"),
+                   ACE_TEXT ("ACE_Uring_Reactor::open ")
+                   ACE_TEXT ("failed inside ACE_Uring_Reactor::CTOR")));
+}
+
+ACE_Uring_Reactor::ACE_Uring_Reactor (size_t size,
+                                      bool restart,
+                                      ACE_Sig_Handler *sh,
+                                      ACE_Timer_Queue *tq,
+                                      int disable_notify_pipe,
+                                      ACE_Reactor_Notify *notify,
+                                      int mask_signals,
+                                      int s_queue)
+  : ACE_Dev_Poll_Reactor (mask_signals, s_queue, true)
+  , ring_ ()
+  , ring_lock_ ()
+  , requests_ (0)
+  , requests_size_ (0)
+  , waiting_ (false)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::ACE_Uring_Reactor");
+
+  if (this->open (size,
+                  restart,
+                  sh,
+                  tq,
+                  disable_notify_pipe,
+                  notify) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%p\n"),
+                   ACE_TEXT ("ACE_Uring_Reactor::open ")
+                   ACE_TEXT ("failed inside ACE_Uring_Reactor::CTOR")));
+}
+
+ACE_Uring_Reactor::~ACE_Uring_Reactor ()
+{
+  ACE_TRACE ("ACE_Uring_Reactor::~ACE_Uring_Reactor");
+
+  // The base class destructor can no longer reach our hooks, so shut
+  // down while they are still in effect.
+  (void) this->close ();
+}
+
+int
+ACE_Uring_Reactor::open_poll_i (size_t size)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::open_poll_i");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->ring_lock_, -1);
+
+  ACE_NEW_RETURN (this->requests_, Poll_Request[size], -1);
+  ACE_OS::memset (this->requests_, 0, size * sizeof (Poll_Request));
+  this->requests_size_ = size;
+
+  if (this->ring_.open (ACE_URING_REACTOR_ENTRIES) == -1)
+    {
+      delete [] this->requests_;
+      this->requests_ = 0;
+      this->requests_size_ = 0;
+      return -1;
+    }
+
+  this->poll_fd_ = this->ring_.get_handle ();
+  return 0;
+}
+
+int
+ACE_Uring_Reactor::close_poll_i ()
+{
+  ACE_TRACE ("ACE_Uring_Reactor::close_poll_i");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->ring_lock_, -1);
+
+  // Closing the ring cancels all outstanding poll requests.
+  int const result = this->ring_.close ();
+
+  delete [] this->requests_;
+  this->requests_ = 0;
+  this->requests_size_ = 0;
+  this->poll_fd_ = ACE_INVALID_HANDLE;
+
+  return result;
+}
+
+int
+ACE_Uring_Reactor::control_poll_i (int op,
+                                   ACE_HANDLE handle,
+                                   __uint32_t events)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::control_poll_i");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->ring_lock_, -1);
+
+  if (this->requests_ == 0)
+    {
+      errno = EBADF;
+      return -1;
+    }
+
+  if (handle < 0 || static_cast<size_t> (handle) >= this->requests_size_)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  switch (op)
+    {
+    case EPOLL_CTL_ADD:
+    case EPOLL_CTL_MOD:
+      if (this->disarm_i (handle) == -1)
+        return -1;
+      this->requests_[handle].events = events;
+      if (this->arm_i (handle) == -1)
+        return -1;
+      return this->kick_i ();
+
+    case EPOLL_CTL_DEL:
+      if (this->disarm_i (handle) == -1)
+        return -1;
+      // An outstanding poll request holds a reference to the file, so
+      // make sure the removal reaches the kernel before the caller
+      // closes the handle.
+      return this->ring_.submit () == -1 ? -1 : 0;
+
+    default:
+      errno = EINVAL;
+      return -1;
+    }
+}
+
+int
+ACE_Uring_Reactor::wait_poll_i (int timeout)
+{
+  ACE_TRACE ("ACE_Uring_Reactor::wait_poll_i");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, guard, this->ring_lock_, -1);
+
+  ACE_Time_Value tv;
+  if (timeout >= 0)
+    tv.msec (static_cast<long> (timeout));
+  ACE_Time_Value * const max_wait = timeout >= 0 ? &tv : 0;
+  ACE_Countdown_Time countdown (max_wait);
+
+  for (;;)
+    {
+      // Completions left over from the previous wait are handed out
+      // without entering the kernel.
+      if (this->reap_i () == 1)
+        return 1;
+
+      unsigned int const pending = this->ring_.flush ();
+      this->waiting_ = true;
+
+      int result = 0;
+      {
+        ACE_Reverse_Lock<ACE_SYNCH_MUTEX> reverse (this->ring_lock_);
+        ACE_GUARD_RETURN (ACE_Reverse_Lock<ACE_SYNCH_MUTEX>, rguard, reverse, -1);
+
+        result = this->ring_.enter (pending, 1, max_wait);
+      }
+
+      this->waiting_ = false;
+
+      if (result == -1)
+        {
+          if (errno == ETIME)
+            return this->reap_i ();
+          if (errno != EBUSY)
+            return -1;
+        }
+
+      // Only stale completions may have arrived; keep waiting for the
+      // remainder of the timeout.
+      countdown.update ();
+      if (max_wait != 0 && *max_wait == ACE_Time_Value::zero)
+        return this->reap_i ();
+    }
+}
+
+int
+ACE_Uring_Reactor::arm_i (ACE_HANDLE handle)
+{
+  Poll_Request &request = this->requests_[handle];
+
+  struct io_uring_sqe *sqe = this->get_sqe_i ();
+  if (sqe == 0)
+    return -1;
+
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = handle;
+  sqe->poll32_events = poll_mask (request.events);
+  sqe->user_data = make_user_data (handle, request.generation);
+
+  request.armed = true;
+  return 0;
+}
+
+int
+ACE_Uring_Reactor::disarm_i (ACE_HANDLE handle)
+{
+  Poll_Request &request = this->requests_[handle];
+
+  if (request.armed)
+    {
+      struct io_uring_sqe *sqe = this->get_sqe_i ();
+      if (sqe == 0)
+        return -1;
+
+      sqe->opcode = IORING_OP_POLL_REMOVE;
+      sqe->fd = -1;
+      sqe->addr = make_user_data (handle, request.generation);
+      sqe->user_data = ignored_user_data;
+      request.armed = false;
+    }
+
+  // Whether or not a request was outstanding, a completion for it may
+  // already sit in the completion queue; make sure it is discarded.
+  ++request.generation;
+  return 0;
+}
+
+struct io_uring_sqe *
+ACE_Uring_Reactor::get_sqe_i ()
+{
+  struct io_uring_sqe *sqe = this->ring_.get_sqe ();
+  if (sqe == 0)
+    {
+      // The submission queue is full; hand what we have to the kernel.
+      if (this->ring_.submit () == -1)
+        return 0;
+
+      sqe = this->ring_.get_sqe ();
+      if (sqe == 0)
+        errno = EAGAIN;
+    }
+
+  return sqe;
+}
+
+int
+ACE_Uring_Reactor::kick_i ()
+{
+  if (this->waiting_)
+    return this->ring_.submit () == -1 ? -1 : 0;
+
+  // The next wait will submit the entry along with its wait.
+  return 0;
+}
+
+int
+ACE_Uring_Reactor::reap_i ()
+{
+  struct io_uring_cqe *cqe = 0;
+
+  while ((cqe = this->ring_.peek_cqe ()) != 0)
+    {
+      ACE_UINT64 const user_data = cqe->user_data;
+      int const res = cqe->res;
+      this->ring_.cqe_seen ();
+
+      if (user_data == ignored_user_data)
+        continue;
+
+      ACE_HANDLE const handle =
+        static_cast<ACE_HANDLE> (user_data & 0xffffffffu);
+      ACE_UINT32 const generation = static_cast<ACE_UINT32> (user_data >> 32);
+
+      if (handle < 0 || static_cast<size_t> (handle) >= this->requests_size_)
+        continue;
+
+      Poll_Request &request = this->requests_[handle];
+      if (!request.armed || request.generation != generation)
+        continue;   // Stale completion of a replaced request.
+
+      request.armed = false;
+
+      // Handlers registered without EPOLLONESHOT are re-armed right
+      // away.  The new request goes to the kernel with the next wait
+      // and, like any poll request, first checks the current state of
+      // the handle, which gives them level-triggered semantics.
+      if (ACE_BIT_DISABLED (request.events, EPOLLONESHOT))
+        (void) this->arm_i (handle);
+
+      if (res == -ECANCELED)
+        continue;
+
+      // Report failures of the poll request itself (such as a handle
+      // that was closed without being removed) the way epoll does.
+      this->event_.data.fd = handle;
+      this->event_.events = res < 0
+        ? static_cast<__uint32_t> (EPOLLERR)
+        : static_cast<__uint32_t> (res);
+      return 1;
+    }
+
+  return 0;
+}
+
+void
+ACE_Uring_Reactor::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Uring_Reactor::dump");
+
+  ACE_Dev_Poll_Reactor::dump ();
+  this->ring_.dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("requests_size_ = %B\n"),
+                 this->requests_size_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_IO_URING && ACE_HAS_EVENT_POLL */
@@ -0,0 +1,165 @@
+// -*- C++ -*-
+
+// =========================================================================
+/**
+ *  @file    Uring_Reactor.h
+ *
+ *  Linux @c io_uring based Reactor implementation.
+ */
+// =========================================================================
+
+#ifndef ACE_URING_REACTOR_H
+#define ACE_URING_REACTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_EVENT_POLL)
+
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Uring.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Null_Mutex.h"
+
+#if !defined (ACE_URING_REACTOR_ENTRIES)
+/// Default number of submission queue entries of the reactor's ring.
+#  define ACE_URING_REACTOR_ENTRIES 1024
+#endif /* ACE_URING_REACTOR_ENTRIES */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Uring_Reactor
+ *
+ * @brief An @c io_uring based reactor.
+ *
+ * The Uring reactor shares the handler repository, token handling and
+ * dispatching rules of the ACE_Dev_Poll_Reactor (one event per token
+ * acquisition, handlers automatically suspended around the upcall),
+ * but demultiplexes through poll requests on an @c io_uring instead of
+ * @c sys_epoll:
+ *
+ * - Re-arming a handler after its upcall only queues a submission
+ *   entry; queued entries are handed to the kernel by the same
+ *   @c io_uring_enter() call that waits for the next event, so the
+ *   steady-state cost per dispatched event is one system call rather
+ *   than an @c epoll_ctl() plus an @c epoll_wait().
+ * - Completions retrieved by one wait are consumed one at a time by
+ *   subsequent event loop iterations without entering the kernel.
+ * - Handlers that are never suspended (the notification handler) are
+ *   re-armed as their completions are consumed, again without a
+ *   system call of their own.  Multishot polls are deliberately not
+ *   used for them: they only report new wakeups, whereas the
+ *   notification pipe relies on level-triggered readiness.
+ *
+ * If a thread is blocked in the ring when another thread changes the
+ * interest set, the change is submitted immediately so it cannot be
+ * delayed by the wait.
+ *
+ * @note Requires Linux 5.11 or later.
+ */
+class ACE_Export ACE_Uring_Reactor : public ACE_Dev_Poll_Reactor
+{
+public:
+  /// Initialize ACE_Uring_Reactor with the default size.
+  ACE_Uring_Reactor (ACE_Sig_Handler * = 0,
+                     ACE_Timer_Queue * = 0,
+                     int disable_notify_pipe = 0,
+                     ACE_Reactor_Notify *notify = 0,
+                     int mask_signals = 1,
+                     int s_queue = ACE_DEV_POLL_TOKEN::FIFO);
+
+  /// Initialize ACE_Uring_Reactor with size @a size.
+  /**
+   * @see ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor() for the meaning
+   *      of @a size.
+   */
+  ACE_Uring_Reactor (size_t size,
+                     bool restart = false,
+                     ACE_Sig_Handler * = 0,
+                     ACE_Timer_Queue * = 0,
+                     int disable_notify_pipe = 0,
+                     ACE_Reactor_Notify *notify = 0,
+                     int mask_signals = 1,
+                     int s_queue = ACE_DEV_POLL_TOKEN::FIFO);
+
+  /// Close down and release all resources.
+  virtual ~ACE_Uring_Reactor ();
+
+  /// Dump the state of an object.
+  virtual void dump () const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// @name Event demultiplexer hooks
+  //@{
+  virtual int open_poll_i (size_t size);
+  virtual int close_poll_i ();
+  virtual int control_poll_i (int op, ACE_HANDLE handle, __uint32_t events);
+  virtual int wait_poll_i (int timeout);
+  //@}
+
+private:
+  /// Poll request state for a single handle.
+  struct Poll_Request
+  {
+    /// Incremented whenever a poll request is replaced or withdrawn,
+    /// so that completions of stale requests can be recognized.
+    ACE_UINT32 generation;
+
+    /// Events requested, including @c EPOLLONESHOT.
+    __uint32_t events;
+
+    /// A poll request is outstanding in the kernel.
+    bool armed;
+  };
+
+  /// Queue a poll request for @a handle.
+  int arm_i (ACE_HANDLE handle);
+
+  /// Withdraw the outstanding poll request for @a handle, if any.
+  int disarm_i (ACE_HANDLE handle);
+
+  /// Return a submission entry, submitting queued entries to make
+  /// room if the submission queue is full.
+  struct io_uring_sqe *get_sqe_i ();
+
+  /// Submit queued entries right away if another thread is waiting
+  /// in the ring; otherwise leave them for the next wait.
+  int kick_i ();
+
+  /// Consume completions until one that must be dispatched is found
+  /// and stored in @c event_.  Returns 1 if an event was found, else 0.
+  int reap_i ();
+
+private:
+  /// The ring.  Its descriptor doubles as @c poll_fd_.
+  ACE_Uring ring_;
+
+  /// Serializes access to the submission queue and @c requests_.
+  ACE_SYNCH_MUTEX ring_lock_;
+
+  /// Poll request state, indexed by handle.
+  Poll_Request *requests_;
+
+  /// Number of entries in @c requests_.
+  size_t requests_size_;
+
+  /// True while a thread is blocked in the ring.
+  bool waiting_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* ACE_HAS_IO_URING && ACE_HAS_EVENT_POLL */
+
+#include /**/ "ace/post.h"
+
+#endif  /* ACE_URING_REACTOR_H */
@@ -0,0 +1,186 @@
+// This program measures the byte swapping of CDR arrays, which is what
+// demarshaling a sequence from a peer of the other byte order costs.
+//
+// For arrays of 1KB up to 64MB, doubling the size each time, and each
+// element size it reports the throughput in MB/sec of
+//
+// memcpy -- copying the array, the upper bound,
+// element -- ACE_CDR::swap_N () called for every element,
+// array -- ACE_CDR::swap_N_array (), which uses SIMD instructions
+//    where the platform has them,
+// cdr -- ACE_InputCDR::read_*_array () from a stream in the other
+//    byte order.
+//
+// Usage: cdr_swap [-b min bytes] [-m max bytes] [-t bytes per test]
+//
+// Each test swaps at least <bytes per test> bytes (default 256MB), and
+// at least one array.
+
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/CDR_Stream.h"
+
+static size_t min_bytes = 1024;
+static size_t max_bytes = 64 * 1024 * 1024;
+static size_t test_bytes = 256 * 1024 * 1024;
+
+// Keeps the compiler from dropping the work.
+static unsigned int checksum = 0;
+
+static double
+mbytes_per_sec (ACE_High_Res_Timer &timer, size_t bytes, size_t loops)
+{
+  ACE_hrtime_t usecs;
+  timer.elapsed_microseconds (usecs);
+  if (usecs == 0)
+    usecs = 1;
+  return static_cast<double> (bytes) * loops / usecs;
+}
+
+static void
+swap_elements (size_t size, char const *orig, char *target, size_t n)
+{
+  for (size_t i = 0; i < n; ++i, orig += size, target += size)
+    switch (size)
+      {
+      case 2: ACE_CDR::swap_2 (orig, target); break;
+      case 4: ACE_CDR::swap_4 (orig, target); break;
+      case 8: ACE_CDR::swap_8 (orig, target); break;
+      default: ACE_CDR::swap_16 (orig, target); break;
+      }
+}
+
+static void
+swap_array (size_t size, char const *orig, char *target, size_t n)
+{
+  switch (size)
+    {
+    case 2: ACE_CDR::swap_2_array (orig, target, n); break;
+    case 4: ACE_CDR::swap_4_array (orig, target, n); break;
+    case 8: ACE_CDR::swap_8_array (orig, target, n); break;
+    default: ACE_CDR::swap_16_array (orig, target, n); break;
+    }
+}
+
+static void
+read_array (size_t size, char const *orig, char *target, size_t n)
+{
+  ACE_InputCDR cdr (orig, size * n, !ACE_CDR_BYTE_ORDER);
+  switch (size)
+    {
+    case 2:
+      cdr.read_ushort_array (reinterpret_cast<ACE_CDR::UShort *> (target),
+                             static_cast<ACE_CDR::ULong> (n));
+      break;
+    case 4:
+      cdr.read_ulong_array (reinterpret_cast<ACE_CDR::ULong *> (target),
+                            static_cast<ACE_CDR::ULong> (n));
+      break;
+    case 8:
+      cdr.read_ulonglong_array (reinterpret_cast<ACE_CDR::ULongLong *> (target),
+                                static_cast<ACE_CDR::ULong> (n));
+      break;
+    default:
+      cdr.read_longdouble_array (reinterpret_cast<ACE_CDR::LongDouble *> (target),
+                                 static_cast<ACE_CDR::ULong> (n));
+      break;
+    }
+}
+
+static void
+copy_array (size_t size, char const *orig, char *target, size_t n)
+{
+  ACE_OS::memcpy (target, orig, size * n);
+}
+
+static double
+measure (void (*fn) (size_t, char const *, char *, size_t),
+         size_t size,
+         char const *orig,
+         char *target,
+         size_t bytes)
+{
+  size_t const loops = test_bytes / bytes > 0 ? test_bytes / bytes : 1;
+  size_t const n = bytes / size;
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  for (size_t i = 0; i < loops; ++i)
+    {
+      fn (size, orig, target, n);
+      checksum += static_cast<unsigned char> (target[i % bytes]);
+    }
+  timer.stop ();
+
+  return mbytes_per_sec (timer, bytes, loops);
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("b:m:t:"));
+  int c;
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'b':
+        min_bytes = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      case 'm':
+        max_bytes = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      case 't':
+        test_bytes = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-b min bytes] [-m max bytes] ")
+                           ACE_TEXT ("[-t bytes per test]\n"),
+                           argv[0]),
+                          1);
+      }
+
+  if (min_bytes < 16 || max_bytes < min_bytes)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("need 16 <= min bytes <= max bytes\n")),
+                      1);
+
+  // Aligned the way a CDR stream aligns its data.
+  char *orig_buf = new char[max_bytes + ACE_CDR::MAX_ALIGNMENT];
+  char *target_buf = new char[max_bytes + ACE_CDR::MAX_ALIGNMENT];
+  char *orig = ACE_ptr_align_binary (orig_buf, ACE_CDR::MAX_ALIGNMENT);
+  char *target = ACE_ptr_align_binary (target_buf, ACE_CDR::MAX_ALIGNMENT);
+  for (size_t i = 0; i < max_bytes; ++i)
+    orig[i] = static_cast<char> (i * 31 + 7);
+
+  ACE_High_Res_Timer::global_scale_factor ();
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("MB/sec\n%10s %4s %10s %10s %10s %10s\n"),
+              ACE_TEXT ("bytes"), ACE_TEXT ("size"),
+              ACE_TEXT ("memcpy"), ACE_TEXT ("element"),
+              ACE_TEXT ("array"), ACE_TEXT ("cdr")));
+
+  for (size_t bytes = min_bytes; bytes <= max_bytes; bytes *= 2)
+    for (size_t size = 2; size <= 16; size *= 2)
+      {
+        double const copy = measure (copy_array, size, orig, target, bytes);
+        double const element =
+          measure (swap_elements, size, orig, target, bytes);
+        double const array = measure (swap_array, size, orig, target, bytes);
+        double const cdr = measure (read_array, size, orig, target, bytes);
+
+        ACE_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("%10B %4B %10.0f %10.0f %10.0f %10.0f\n"),
+                    bytes, size, copy, element, array, cdr));
+      }
+
+  delete [] target_buf;
+  delete [] orig_buf;
+
+  return checksum == 0xffffffff ? 1 : 0;
+}
@@ -0,0 +1,213 @@
+// This program compares the performance of the timer queue
+// implementations of ACE: ACE_Timer_Heap, ACE_Timer_Wheel,
+// ACE_Timer_Hierarchical_Wheel, ACE_Timer_Hash and ACE_Timer_List.
+//
+// For each queue it measures the time per operation of
+//
+// schedule -- scheduling <timers> timers at random times in the next
+//    <range> seconds,
+// cancel -- cancelling all of them in random order,
+// expire -- expiring all of them at once after scheduling them
+//    again,
+// churn -- scheduling and cancelling a timer while <timers> timers
+//    are outstanding, which is what an ORB does for request timeouts.
+//
+// Usage: timer_queue [-n timers] [-r range] [-c churn iterations]
+//                    [-l list timers]
+//
+// Scheduling is O(n) for ACE_Timer_List, so it only gets
+// <list timers> timers and churn iterations (default 10000).
+
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/Recursive_Thread_Mutex.h"
+#include "ace/Event_Handler.h"
+#include "ace/Timer_Heap.h"
+#include "ace/Timer_Wheel.h"
+#include "ace/Timer_Hierarchical_Wheel.h"
+#include "ace/Timer_Hash.h"
+#include "ace/Timer_List.h"
+
+static int timers = 100000;
+static int range = 30;
+static int churn_iterations = 1000000;
+static int list_timers = 10000;
+
+class Null_Handler : public ACE_Event_Handler
+{
+public:
+  virtual int handle_timeout (const ACE_Time_Value &, const void *)
+  {
+    return 0;
+  }
+};
+
+static double
+usecs_per_op (ACE_High_Res_Timer &timer, int ops)
+{
+  ACE_hrtime_t usecs;
+  timer.elapsed_microseconds (usecs);
+  return ops > 0 ? static_cast<double> (usecs) / ops : 0.0;
+}
+
+static void
+run (ACE_Timer_Queue *tq, const ACE_TCHAR *name, int count, int iterations)
+{
+  Null_Handler handler;
+  ACE_High_Res_Timer timer;
+
+  ACE_Time_Value *times = new ACE_Time_Value[count];
+  long *ids = new long[count];
+  int *order = new int[count];
+
+  ACE_Time_Value const now = tq->gettimeofday ();
+  ACE_UINT64 const range_usecs =
+    static_cast<ACE_UINT64> (range) * ACE_ONE_SECOND_IN_USECS;
+  for (int i = 0; i < count; ++i)
+    {
+      ACE_UINT64 const usecs =
+        ((static_cast<ACE_UINT64> (ACE_OS::rand ()) << 16)
+         ^ static_cast<ACE_UINT64> (ACE_OS::rand ())) % range_usecs;
+      times[i] = now;
+      times[i] += ACE_Time_Value (static_cast<time_t> (usecs / ACE_ONE_SECOND_IN_USECS),
+                                  static_cast<suseconds_t> (usecs % ACE_ONE_SECOND_IN_USECS));
+      order[i] = i;
+    }
+
+  // Random order for the cancellations.
+  for (int i = count - 1; i > 0; --i)
+    {
+      int const j = ACE_OS::rand () % (i + 1);
+      int const tmp = order[i];
+      order[i] = order[j];
+      order[j] = tmp;
+    }
+
+  timer.start ();
+  for (int i = 0; i < count; ++i)
+    ids[i] = tq->schedule (&handler, 0, times[i]);
+  timer.stop ();
+  double const schedule = usecs_per_op (timer, count);
+
+  timer.start ();
+  for (int i = 0; i < count; ++i)
+    tq->cancel (ids[order[i]]);
+  timer.stop ();
+  double const cancel = usecs_per_op (timer, count);
+
+  for (int i = 0; i < count; ++i)
+    tq->schedule (&handler, 0, times[i]);
+
+  timer.start ();
+  int const expired =
+    tq->expire (now + ACE_Time_Value (range + 1));
+  timer.stop ();
+  double const expire = usecs_per_op (timer, expired);
+
+  // Keep <count> timers outstanding; each iteration cancels the
+  // oldest one and schedules a new one <range> seconds later.
+  ACE_Time_Value const timeout (range);
+  for (int i = 0; i < count; ++i)
+    ids[i] = tq->schedule (&handler, 0, now + timeout);
+
+  timer.start ();
+  for (int i = 0; i < iterations; ++i)
+    {
+      int const slot = i % count;
+      tq->cancel (ids[slot]);
+      ids[slot] = tq->schedule (&handler, 0, now + timeout);
+    }
+  timer.stop ();
+  double const churn = usecs_per_op (timer, iterations);
+
+  for (int i = 0; i < count; ++i)
+    tq->cancel (ids[i]);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-30s %8d %10.3f %10.3f %10.3f %10.3f\n"),
+              name, count, schedule, cancel, expire, churn));
+
+  delete [] order;
+  delete [] ids;
+  delete [] times;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:r:c:l:"));
+  int c;
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        timers = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'r':
+        range = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'c':
+        churn_iterations = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'l':
+        list_timers = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-n timers] [-r range] ")
+                           ACE_TEXT ("[-c churn iterations] [-l list timers]\n"),
+                           argv[0]),
+                          1);
+      }
+
+  if (timers < 1 || range < 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("timers and range must be positive\n")),
+                      1);
+
+  ACE_High_Res_Timer::global_scale_factor ();
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("usecs per operation, timers spread over %d secs\n")
+              ACE_TEXT ("%-30s %8s %10s %10s %10s %10s\n"),
+              range,
+              ACE_TEXT ("queue"), ACE_TEXT ("timers"),
+              ACE_TEXT ("schedule"), ACE_TEXT ("cancel"),
+              ACE_TEXT ("expire"), ACE_TEXT ("churn")));
+
+  {
+    ACE_Timer_Heap tq (timers, true);
+    run (&tq, ACE_TEXT ("ACE_Timer_Heap"), timers, churn_iterations);
+  }
+  {
+    ACE_Timer_Wheel tq (ACE_DEFAULT_TIMER_WHEEL_SIZE,
+                        ACE_DEFAULT_TIMER_WHEEL_RESOLUTION,
+                        timers);
+    run (&tq, ACE_TEXT ("ACE_Timer_Wheel"), timers, churn_iterations);
+  }
+  {
+    ACE_Timer_Hierarchical_Wheel tq (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK,
+                                     timers);
+    run (&tq, ACE_TEXT ("ACE_Timer_Hierarchical_Wheel"), timers, churn_iterations);
+  }
+  {
+    ACE_Timer_Hash tq;
+    run (&tq, ACE_TEXT ("ACE_Timer_Hash"), timers, churn_iterations);
+  }
+  {
+    ACE_Timer_Hash_Heap tq;
+    run (&tq, ACE_TEXT ("ACE_Timer_Hash_Heap"), timers, churn_iterations);
+  }
+  {
+    ACE_Timer_List tq;
+    run (&tq,
+         ACE_TEXT ("ACE_Timer_List"),
+         list_timers < timers ? list_timers : timers,
+         list_timers < churn_iterations ? list_timers : churn_iterations);
+  }
+
+  return 0;
+}
@@ -842,6 +842,198 @@ CDR_Test_Types::test_get_placeholder (ACE_InputCDR &cdr) const
 }
 
 
+// Compare the swap_XX_array functions, which use SIMD instructions
+// where available, with swapping one element at a time, for all
+// lengths up to a few vectors and every alignment of source and target.
+static int
+swap_array_test ()
+{
+  static size_t const max_length = 80;
+  static size_t const sizes[] = { 2, 4, 8, 16 };
+
+  char orig[16 * max_length + 16];
+  char target[16 * max_length + 16];
+  char expected[16];
+
+  for (size_t i = 0; i < sizeof (orig); ++i)
+    orig[i] = static_cast<char> (i * 7 + 1);
+
+  for (size_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); ++s)
+    {
+      size_t const size = sizes[s];
+      for (size_t length = 1; length <= max_length; ++length)
+        for (size_t src_offset = 0; src_offset < 16; src_offset += 2)
+          for (size_t dst_offset = 0; dst_offset < 16; dst_offset += 2)
+            {
+              char const *src = orig + src_offset;
+              char *dst = target + dst_offset;
+              switch (size)
+                {
+                case 2: ACE_CDR::swap_2_array (src, dst, length); break;
+                case 4: ACE_CDR::swap_4_array (src, dst, length); break;
+                case 8: ACE_CDR::swap_8_array (src, dst, length); break;
+                default: ACE_CDR::swap_16_array (src, dst, length); break;
+                }
+
+              for (size_t i = 0; i < length; ++i)
+                {
+                  char const *element = src + i * size;
+                  switch (size)
+                    {
+                    case 2: ACE_CDR::swap_2 (element, expected); break;
+                    case 4: ACE_CDR::swap_4 (element, expected); break;
+                    case 8: ACE_CDR::swap_8 (element, expected); break;
+                    default: ACE_CDR::swap_16 (element, expected); break;
+                    }
+                  if (ACE_OS::memcmp (expected, dst + i * size, size) != 0)
+                    ACE_ERROR_RETURN ((LM_ERROR,
+                                       ACE_TEXT ("swap_%B_array of %B ")
+                                       ACE_TEXT ("elements at offsets %B/%B ")
+                                       ACE_TEXT ("wrong at element %B\n"),
+                                       size, length, src_offset,
+                                       dst_offset, i),
+                                      1);
+                }
+            }
+    }
+
+  return 0;
+}
+
+// Counts the buffers given back by write_array_external().
+static int released = 0;
+
+static void
+release_buffer (const char *, size_t, void *arg)
+{
+  ++released;
+  ++*static_cast<int *> (arg);
+}
+
+// Append buffers without copying them, read them back and check
+// that the release function is called once the last message block
+// that refers to a buffer is gone.
+static int
+external_array_test ()
+{
+  static ACE_CDR::ULong const count = 1000;
+  ACE_CDR::Double doubles[count];
+  ACE_CDR::Octet octets[101];
+  for (ACE_CDR::ULong i = 0; i < count; ++i)
+    doubles[i] = i * 1.5;
+  for (size_t i = 0; i < sizeof (octets); ++i)
+    octets[i] = static_cast<ACE_CDR::Octet> (i);
+
+  int doubles_released = 0;
+  int empty_released = 0;
+  released = 0;
+
+  ACE_Message_Block *copy = 0;
+  {
+    ACE_OutputCDR out;
+    out.write_octet (1);
+    if (!out.write_array_external (doubles,
+                                   ACE_CDR::LONGLONG_SIZE,
+                                   ACE_CDR::LONGLONG_ALIGN,
+                                   count,
+                                   release_buffer,
+                                   &doubles_released))
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("write_array_external failed\n")),
+                        1);
+    out.write_ushort (2);
+    out.write_array_external (octets,
+                              ACE_CDR::OCTET_SIZE,
+                              ACE_CDR::OCTET_ALIGN,
+                              sizeof (octets));
+    out.write_array_external (doubles,
+                              ACE_CDR::LONGLONG_SIZE,
+                              ACE_CDR::LONGLONG_ALIGN,
+                              0,
+                              release_buffer,
+                              &empty_released);
+    out.write_ulong (3);
+
+    if (!out.good_bit ())
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("output stream failed\n")), 1);
+
+    if (released != 1 || empty_released != 1)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("%d buffers released while writing\n"),
+                         released),
+                        1);
+
+    // The last write did not start a block as large as the buffer.
+    if (out.current ()->size () >= sizeof (doubles))
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("block after the buffer has %B bytes\n"),
+                         out.current ()->size ()),
+                        1);
+
+    size_t const expected = 8 + sizeof (doubles) + 2 + sizeof (octets) + 1 + 4;
+    if (out.total_length () != expected)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("stream has %B bytes, expected %B\n"),
+                         out.total_length (),
+                         expected),
+                        1);
+
+    bool found = false;
+    for (const ACE_Message_Block *i = out.begin (); i != out.end (); i = i->cont ())
+      found = found || i->rd_ptr () == reinterpret_cast<char *> (doubles);
+    if (!found)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("buffer was copied into the stream\n")),
+                        1);
+
+    ACE_InputCDR in (out);
+    ACE_CDR::Octet o = 0;
+    ACE_CDR::UShort us = 0;
+    ACE_CDR::ULong ul = 0;
+    ACE_CDR::Double d[count];
+    ACE_CDR::Octet oct[sizeof (octets)];
+    in.read_octet (o);
+    in.read_double_array (d, count);
+    in.read_ushort (us);
+    in.read_octet_array (oct, sizeof (oct));
+    in.read_ulong (ul);
+    if (!in.good_bit ()
+        || o != 1 || us != 2 || ul != 3
+        || ACE_OS::memcmp (d, doubles, sizeof (d)) != 0
+        || ACE_OS::memcmp (oct, octets, sizeof (oct)) != 0)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("data read back does not match\n")),
+                        1);
+
+    // A clone shares the buffer that was handed over, and copies the
+    // borrowed one.
+    copy = out.begin ()->clone ();
+    for (const ACE_Message_Block *i = copy; i != 0; i = i->cont ())
+      if (i->rd_ptr () == reinterpret_cast<char *> (octets))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("clone refers to a borrowed buffer\n")),
+                          1);
+  }
+
+  int status = 0;
+  if (doubles_released != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("buffer released while a clone uses it\n")));
+      status = 1;
+    }
+
+  ACE_Message_Block::release (copy);
+  if (doubles_released != 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("buffer released %d times\n"),
+                  doubles_released));
+      status = 1;
+    }
+  return status;
+}
+
 int
 run_main (int argc, ACE_TCHAR *argv[])
 {
@@ -1026,7 +1218,21 @@ run_main (int argc, ACE_TCHAR *argv[])
     return 1;
 
   ACE_DEBUG ((LM_DEBUG,
-              ACE_TEXT ("Placeholder/Replace - no errors\n\n")));
+              ACE_TEXT ("Placeholder/Replace - no errors\n\n")
+              ACE_TEXT ("Testing array byte swapping\n\n")));
+
+  if (swap_array_test () != 0)
+    return 1;
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("Array byte swapping - no errors\n\n")
+              ACE_TEXT ("Testing external arrays\n\n")));
+
+  if (external_array_test () != 0)
+    return 1;
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("External arrays - no errors\n\n")));
 
   ACE_END_TEST;
   return 0;
@@ -0,0 +1,283 @@
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async_Test.cpp
+ *
+ *  Test of ACE_Log_Msg_Async: records logged from several threads all
+ *  reach the file, long records survive, flush priorities write a
+ *  record before log() returns, the overflow policies drop and count
+ *  records, and the backend works behind ACE_Log_Msg.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Async.h"
+#include "ace/Log_Record.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+static const ACE_TCHAR *file_name =
+  ACE_LOG_DIRECTORY ACE_TEXT ("Log_Msg_Async_Test.txt");
+
+static ssize_t
+log_line (ACE_Log_Msg_Async &backend,
+          ACE_Log_Priority priority,
+          const ACE_TCHAR *text)
+{
+  ACE_Log_Record record (priority,
+                         ACE_OS::gettimeofday (),
+                         ACE_OS::getpid ());
+  record.msg_data (text);
+  return backend.log (record);
+}
+
+/// Number of lines in the file, and how many of them contain @a match.
+static int
+count_lines (int &matches, const char *match = 0)
+{
+  matches = 0;
+  FILE *fp = ACE_OS::fopen (file_name, ACE_TEXT ("r"));
+  if (fp == 0)
+    return -1;
+
+  int lines = 0;
+  char line[ACE_Log_Record::MAXVERBOSELOGMSGLEN];
+  while (ACE_OS::fgets (line, sizeof line, fp) != 0)
+    {
+      ++lines;
+      if (match != 0 && ACE_OS::strstr (line, match) != 0)
+        ++matches;
+    }
+  ACE_OS::fclose (fp);
+  return lines;
+}
+
+static int
+open_backend (ACE_Log_Msg_Async &backend)
+{
+  ACE_OS::unlink (file_name);
+  if (backend.open (file_name) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), file_name), -1);
+  return 0;
+}
+
+static const int THREADS = 4;
+static const int RECORDS = 2000;
+
+static ACE_THR_FUNC_RETURN
+log_records (void *arg)
+{
+  ACE_Log_Msg_Async *backend = static_cast<ACE_Log_Msg_Async *> (arg);
+  ACE_TCHAR text[64];
+  for (int i = 0; i < RECORDS; ++i)
+    {
+      ACE_OS::snprintf (text, 64, ACE_TEXT ("record %d\n"), i);
+      log_line (*backend, LM_DEBUG, text);
+    }
+  return 0;
+}
+
+static int
+threads_test ()
+{
+  int status = 0;
+  ACE_Log_Msg_Async backend (64);
+  if (open_backend (backend) == -1)
+    return 1;
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (THREADS,
+                                                log_records,
+                                                &backend) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  // Longer than what fits in a ring slot.
+  ACE_TCHAR long_text[1024];
+  for (int i = 0; i < 1000; ++i)
+    long_text[i] = ACE_TEXT ('x');
+  long_text[1000] = ACE_TEXT ('\n');
+  long_text[1001] = 0;
+  log_line (backend, LM_INFO, long_text);
+
+  backend.flush ();
+
+  int matches = 0;
+  char long_match[1001];
+  ACE_OS::memset (long_match, 'x', 1000);
+  long_match[1000] = 0;
+  int const lines = count_lines (matches, long_match);
+  if (lines != THREADS * RECORDS + 1 || matches != 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d lines with %d long ones, expected %d with 1\n"),
+                  lines, matches, THREADS * RECORDS + 1));
+      status = 1;
+    }
+  if (backend.written () != static_cast<size_t> (THREADS * RECORDS + 1)
+      || backend.dropped () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B written, %B dropped\n"),
+                  backend.written (), backend.dropped ()));
+      status = 1;
+    }
+  return status;
+}
+
+static int
+flush_test ()
+{
+  int status = 0;
+  ACE_Log_Msg_Async backend;
+  if (open_backend (backend) == -1)
+    return 1;
+
+  // The writer thread may or may not have written these yet, but the
+  // critical record is written with everything before it.
+  for (int i = 0; i < 10; ++i)
+    log_line (backend, LM_DEBUG, ACE_TEXT ("before\n"));
+  log_line (backend, LM_CRITICAL, ACE_TEXT ("critical\n"));
+
+  int matches = 0;
+  int const lines = count_lines (matches, "critical");
+  if (lines != 11 || matches != 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d lines after a critical record, expected 11\n"),
+                  lines));
+      status = 1;
+    }
+
+  // close() writes what is still queued.
+  backend.flush_priorities (0);
+  log_line (backend, LM_CRITICAL, ACE_TEXT ("last\n"));
+  backend.close ();
+  if (count_lines (matches, "last") != 12 || matches != 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("close() did not write the queued record\n")));
+      status = 1;
+    }
+
+  if (log_line (backend, LM_DEBUG, ACE_TEXT ("closed\n")) != -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("log() succeeded on a closed backend\n")));
+      status = 1;
+    }
+  return status;
+}
+
+static int
+overflow_test (ACE_Log_Msg_Async::Overflow_Policy policy,
+               const ACE_TCHAR *name)
+{
+  int status = 0;
+  ACE_Log_Msg_Async backend (4, policy);
+  if (open_backend (backend) == -1)
+    return 1;
+
+  int const total = 10000;
+  int failed = 0;
+  for (int i = 0; i < total; ++i)
+    if (log_line (backend, LM_DEBUG, ACE_TEXT ("overflow\n")) == -1)
+      ++failed;
+  backend.flush ();
+
+  size_t const written = backend.written ();
+  size_t const dropped = backend.dropped ();
+  int matches = 0;
+  int const lines = count_lines (matches, "dropped");
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%s: %B written, %B dropped\n"),
+              name, written, dropped));
+
+  if (written + dropped != static_cast<size_t> (total)
+      || dropped != static_cast<size_t> (failed))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: %B written + %B dropped != %d\n"),
+                  name, written, dropped, total));
+      status = 1;
+    }
+  if (policy == ACE_Log_Msg_Async::BLOCK && dropped != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%s dropped records\n"), name));
+      status = 1;
+    }
+  if (lines != static_cast<int> (written) + matches)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: %d lines for %B records\n"),
+                  name, lines, written));
+      status = 1;
+    }
+  if (policy != ACE_Log_Msg_Async::REPORT_DROPS && matches != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%s reported drops\n"), name));
+      status = 1;
+    }
+  if (policy == ACE_Log_Msg_Async::REPORT_DROPS
+      && (dropped == 0) != (matches == 0))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: %B dropped, %d reports\n"),
+                  name, dropped, matches));
+      status = 1;
+    }
+  return status;
+}
+
+static int
+log_msg_test ()
+{
+  int status = 0;
+  ACE_Log_Msg_Async backend;
+  if (open_backend (backend) == -1)
+    return 1;
+
+  ACE_Log_Msg_Backend *old_backend = ACE_Log_Msg::msg_backend (&backend);
+  ACE_LOG_MSG->set_flags (ACE_Log_Msg::CUSTOM);
+  for (int i = 0; i < 100; ++i)
+    ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("through ACE_Log_Msg %d\n"), i));
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::CUSTOM);
+  ACE_Log_Msg::msg_backend (old_backend);
+
+  backend.flush ();
+  int matches = 0;
+  int const lines = count_lines (matches, "through ACE_Log_Msg");
+  if (lines != 100 || matches != 100)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d of 100 records logged through ACE_Log_Msg\n"),
+                  matches));
+      status = 1;
+    }
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Async_Test"));
+
+  int status = 0;
+#if defined (ACE_HAS_THREADS)
+  status += threads_test ();
+#endif /* ACE_HAS_THREADS */
+  status += flush_test ();
+  status += overflow_test (ACE_Log_Msg_Async::BLOCK, ACE_TEXT ("BLOCK"));
+  status += overflow_test (ACE_Log_Msg_Async::DROP, ACE_TEXT ("DROP"));
+  status += overflow_test (ACE_Log_Msg_Async::REPORT_DROPS,
+                           ACE_TEXT ("REPORT_DROPS"));
+  status += log_msg_test ();
+
+  ACE_OS::unlink (file_name);
+
+  ACE_END_TEST;
+  return status;
+}
@@ -320,12 +320,16 @@ test_reactive (const ACE_TCHAR *prog,
 
 int
 test_concurrent (const ACE_TCHAR *prog,
-                 ACE_MEM_Addr &server_addr)
+                 ACE_MEM_Addr &server_addr,
+                 ACE_MEM_IO::Signal_Strategy strategy)
 {
-  ACE_DEBUG ((LM_DEBUG, "Testing Multithreaded MEM_Stream\n\n"));
+  if (strategy == ACE_MEM_IO::Ring)
+    ACE_DEBUG ((LM_DEBUG, "Testing Ring MEM_Stream\n\n"));
+  else
+    ACE_DEBUG ((LM_DEBUG, "Testing Multithreaded MEM_Stream\n\n"));
 
   int status = 0;
-  client_strategy = ACE_MEM_IO::MT;     // Echo_Handler uses this.
+  client_strategy = strategy;           // Echo_Handler uses this.
 
   ACE_Accept_Strategy<Echo_Handler, ACE_MEM_ACCEPTOR> accept_strategy;
   ACE_Creation_Strategy<Echo_Handler> create_strategy;
@@ -348,7 +352,7 @@ test_concurrent (const ACE_TCHAR *prog,
   // is capable of passing messages of 1MB.
   acceptor.acceptor ().init_buffer_size (1024 * 1024);
   acceptor.acceptor ().mmap_prefix (ACE_TEXT ("MEM_Acceptor_"));
-  acceptor.acceptor ().preferred_strategy (ACE_MEM_IO::MT);
+  acceptor.acceptor ().preferred_strategy (strategy);
 
   ACE_MEM_Addr local_addr;
   if (acceptor.acceptor ().get_local_addr (local_addr) == -1)
@@ -367,7 +371,10 @@ test_concurrent (const ACE_TCHAR *prog,
     ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n()")));
 #else
   ACE_Process_Options opts;
-  opts.command_line (ACE_TEXT ("%") ACE_TEXT_PRIs ACE_TEXT (" -p%d -m"), prog, sport);
+  opts.command_line (ACE_TEXT ("%") ACE_TEXT_PRIs ACE_TEXT (" -p%d %") ACE_TEXT_PRIs,
+                     prog,
+                     sport,
+                     strategy == ACE_MEM_IO::Ring ? ACE_TEXT ("-g") : ACE_TEXT ("-m"));
   if (ACE_Process_Manager::instance ()->spawn_n (NUMBER_OF_MT_CONNECTIONS,
                                                  opts) == -1)
     ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n()")));
@@ -429,7 +436,17 @@ run_main (int argc, ACE_TCHAR *argv[])
 #endif /* !ACE_WIN32 && _ACE_USE_SV_SEM */
       reset_handler (NUMBER_OF_MT_CONNECTIONS);
 
-      test_concurrent (argc > 0 ? argv[0] : ACE_TEXT ("MEM_Stream_Test"), server_addr);
+      test_concurrent (argc > 0 ? argv[0] : ACE_TEXT ("MEM_Stream_Test"),
+                       server_addr,
+                       ACE_MEM_IO::MT);
+
+      ACE_Reactor::instance ()->reset_reactor_event_loop ();
+
+      reset_handler (NUMBER_OF_MT_CONNECTIONS);
+
+      test_concurrent (argc > 0 ? argv[0] : ACE_TEXT ("MEM_Stream_Test"),
+                       server_addr,
+                       ACE_MEM_IO::Ring);
 
 #endif // ACE_LACKS_ACCEPT
       ACE_END_TEST;
@@ -439,7 +456,7 @@ run_main (int argc, ACE_TCHAR *argv[])
     {
       // We end up here if this is a child process spawned for one of
       // the test passes.  command line is: -p <port> -r (reactive) |
-      // -m (multithreaded)
+      // -m (multithreaded) | -g (ring)
 
       ACE_TCHAR lognm[MAXPATHLEN];
       int mypid (ACE_OS::getpid ());
@@ -447,7 +464,7 @@ run_main (int argc, ACE_TCHAR *argv[])
                         ACE_TEXT ("MEM_Stream_Test-%d"), mypid);
       ACE_START_TEST (lognm);
 
-      ACE_Get_Opt opts (argc, argv, ACE_TEXT ("p:rm"));
+      ACE_Get_Opt opts (argc, argv, ACE_TEXT ("p:rmg"));
       int opt, iport, status;
       ACE_MEM_IO::Signal_Strategy model = ACE_MEM_IO::Reactive;
 
@@ -468,9 +485,13 @@ run_main (int argc, ACE_TCHAR *argv[])
               model = ACE_MEM_IO::MT;
               break;
 
+            case 'g':
+              model = ACE_MEM_IO::Ring;
+              break;
+
             default:
               ACE_ERROR_RETURN ((LM_ERROR,
-                                 ACE_TEXT ("Invalid option (-p <port> -r | -m)\n")),
+                                 ACE_TEXT ("Invalid option (-p <port> -r | -m | -g)\n")),
                                 1);
             }
         }
@@ -0,0 +1,440 @@
+//=============================================================================
+/**
+ *  @file    Message_Queue_MPSC_Test.cpp
+ *
+ *    This is a test of ACE_Message_Queue_MPSC, the ACE_Message_Queue
+ *    whose enqueue_tail() does not take the queue lock:
+ *    0) the single threaded semantics (FIFO order, counters, the
+ *       locked operations that have to see the lock-free inbox),
+ *    1) timeouts, the high water mark and deactivation,
+ *    2) several producer tasks putting messages on one consumer
+ *       task's queue, checking that every producer's messages arrive
+ *       complete and in order, and comparing the time taken with the
+ *       same run over an ACE_Message_Queue.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Message_Queue_MPSC_T.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined (ACE_HAS_THREADS)
+
+using MPSC_QUEUE = ACE_Message_Queue_MPSC<ACE_MT_SYNCH>;
+
+static const int PRODUCERS = 8;
+static const int MESSAGES_PER_PRODUCER = 50000;
+
+static ACE_Message_Block *
+make_block (int producer, int seq)
+{
+  ACE_Message_Block *mb = 0;
+  ACE_NEW_RETURN (mb, ACE_Message_Block (2 * sizeof (int)), 0);
+  ACE_OS::memcpy (mb->wr_ptr (), &producer, sizeof (int));
+  mb->wr_ptr (sizeof (int));
+  ACE_OS::memcpy (mb->wr_ptr (), &seq, sizeof (int));
+  mb->wr_ptr (sizeof (int));
+  return mb;
+}
+
+static void
+read_block (ACE_Message_Block *mb, int &producer, int &seq)
+{
+  ACE_OS::memcpy (&producer, mb->rd_ptr (), sizeof (int));
+  ACE_OS::memcpy (&seq, mb->rd_ptr () + sizeof (int), sizeof (int));
+}
+
+static int
+expect_seq (ACE_Message_Block *mb, int expected, const ACE_TCHAR *what)
+{
+  int producer = 0;
+  int seq = -1;
+  if (mb != 0)
+    read_block (mb, producer, seq);
+  if (seq != expected)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: got message %d, expected %d\n"),
+                  what, seq, expected));
+      if (mb != 0)
+        mb->release ();
+      return 1;
+    }
+  if (mb != 0)
+    mb->release ();
+  return 0;
+}
+
+static int
+semantics_test ()
+{
+  int status = 0;
+  MPSC_QUEUE queue;
+  ACE_Message_Block *mb = 0;
+  ACE_Time_Value no_wait (ACE_OS::gettimeofday ());
+
+  for (int i = 0; i < 10; ++i)
+    if (queue.enqueue_tail (make_block (0, i)) != i + 1)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("enqueue_tail of message %d returned the ")
+                    ACE_TEXT ("wrong count\n"),
+                    i));
+        status = 1;
+      }
+
+  if (queue.message_count () != 10
+      || queue.message_bytes () != 10 * 2 * sizeof (int)
+      || queue.message_length () != 10 * 2 * sizeof (int)
+      || queue.is_empty ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("wrong counters after enqueue: %B messages, ")
+                  ACE_TEXT ("%B bytes, %B length\n"),
+                  queue.message_count (),
+                  queue.message_bytes (),
+                  queue.message_length ()));
+      status = 1;
+    }
+
+  // ungetq() must go in front of the messages still in the inbox.
+  queue.enqueue_head (make_block (0, -2));
+  if (queue.peek_dequeue_head (mb, &no_wait) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("peek_dequeue_head")));
+      status = 1;
+    }
+  else
+    {
+      int producer = 0;
+      int seq = 0;
+      read_block (mb, producer, seq);
+      if (seq != -2)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("peek_dequeue_head returned %d\n"),
+                      seq));
+          status = 1;
+        }
+    }
+
+  // Messages pushed after the head was drained come after the others.
+  queue.enqueue_tail (make_block (0, 10));
+  mb = 0;
+  queue.dequeue_tail (mb, &no_wait);
+  status += expect_seq (mb, 10, ACE_TEXT ("dequeue_tail"));
+
+  mb = 0;
+  queue.dequeue_head (mb, &no_wait);
+  status += expect_seq (mb, -2, ACE_TEXT ("dequeue_head after ungetq"));
+
+  for (int i = 0; i < 5; ++i)
+    {
+      mb = 0;
+      queue.dequeue_head (mb, &no_wait);
+      status += expect_seq (mb, i, ACE_TEXT ("dequeue_head"));
+    }
+
+  // A higher priority message goes in front of the rest.
+  ACE_Message_Block *prio = make_block (0, -3);
+  prio->msg_priority (10);
+  queue.enqueue_prio (prio);
+  mb = 0;
+  queue.dequeue_head (mb, &no_wait);
+  status += expect_seq (mb, -3, ACE_TEXT ("dequeue_head after enqueue_prio"));
+
+  // A chained message takes the locked path but keeps its place.
+  ACE_Message_Block *chain = make_block (0, 10);
+  chain->next (make_block (0, 11));
+  queue.enqueue_tail (chain);
+  if (queue.message_count () != 7)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("expected 7 messages after the chain, have %B\n"),
+                  queue.message_count ()));
+      status = 1;
+    }
+
+  for (int i = 5; i < 12; ++i)
+    {
+      mb = 0;
+      queue.dequeue_head (mb, &no_wait);
+      status += expect_seq (mb, i, ACE_TEXT ("dequeue_head of the rest"));
+    }
+
+  if (!queue.is_empty ()
+      || queue.message_count () != 0
+      || queue.message_bytes () != 0
+      || queue.message_length () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("queue not empty at the end: %B messages, ")
+                  ACE_TEXT ("%B bytes\n"),
+                  queue.message_count (),
+                  queue.message_bytes ()));
+      status = 1;
+    }
+
+  for (int i = 0; i < 3; ++i)
+    queue.enqueue_tail (make_block (0, i));
+  int const flushed = queue.flush ();
+  if (flushed != 3 || queue.message_count () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("flush released %d messages, %B left\n"),
+                  flushed,
+                  queue.message_count ()));
+      status = 1;
+    }
+
+  // Whatever is left in the inbox is released by the destructor.
+  for (int i = 0; i < 3; ++i)
+    queue.enqueue_tail (make_block (0, i));
+
+  return status;
+}
+
+static ACE_THR_FUNC_RETURN
+deactivate_later (void *arg)
+{
+  ACE_OS::sleep (ACE_Time_Value (0, 200000));
+  static_cast<MPSC_QUEUE *> (arg)->deactivate ();
+  return 0;
+}
+
+static int
+blocking_test ()
+{
+  int status = 0;
+  MPSC_QUEUE queue (4 * sizeof (int), 4 * sizeof (int));
+  ACE_Message_Block *mb = 0;
+
+  // Empty queue, time out.
+  ACE_Time_Value timeout (ACE_OS::gettimeofday () + ACE_Time_Value (0, 50000));
+  if (queue.dequeue_head (mb, &timeout) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("dequeue_head on the empty queue did not ")
+                  ACE_TEXT ("time out\n")));
+      status = 1;
+    }
+
+  // Two messages fill the queue; the third one has to wait.
+  queue.enqueue_tail (make_block (0, 0));
+  queue.enqueue_tail (make_block (0, 1));
+  if (!queue.is_full ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("queue should be full\n")));
+      status = 1;
+    }
+  ACE_Message_Block *third = make_block (0, 2);
+  timeout = ACE_OS::gettimeofday () + ACE_Time_Value (0, 50000);
+  if (queue.enqueue_tail (third, &timeout) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("enqueue_tail on the full queue did not ")
+                  ACE_TEXT ("time out\n")));
+      status = 1;
+    }
+
+  mb = 0;
+  queue.dequeue_head (mb);
+  status += expect_seq (mb, 0, ACE_TEXT ("dequeue_head from the full queue"));
+  if (queue.enqueue_tail (third) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("enqueue_tail")));
+      status = 1;
+      third->release ();
+    }
+  queue.flush ();
+
+  // A consumer blocked on the empty queue is woken by deactivate().
+  if (ACE_Thread_Manager::instance ()->spawn (deactivate_later, &queue) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+  mb = 0;
+  if (queue.dequeue_head (mb) != -1 || errno != ESHUTDOWN)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("dequeue_head was not shut down by ")
+                  ACE_TEXT ("deactivate()\n")));
+      status = 1;
+    }
+  ACE_Thread_Manager::instance ()->wait ();
+
+  ACE_Message_Block *late = make_block (0, 0);
+  if (queue.enqueue_tail (late) != -1 || errno != ESHUTDOWN)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("enqueue_tail succeeded on a deactivated ")
+                  ACE_TEXT ("queue\n")));
+      status = 1;
+    }
+  else
+    late->release ();
+
+  return status;
+}
+
+class Consumer : public ACE_Task<ACE_MT_SYNCH>
+{
+public:
+  Consumer (ACE_Message_Queue<ACE_MT_SYNCH> *queue)
+    : ACE_Task<ACE_MT_SYNCH> (0, queue), errors_ (0)
+  {
+    for (int i = 0; i < PRODUCERS; ++i)
+      this->next_[i] = 0;
+  }
+
+  int svc () override;
+
+  int errors_;
+  int next_[PRODUCERS];
+};
+
+int
+Consumer::svc ()
+{
+  for (int received = 0;
+       received < PRODUCERS * MESSAGES_PER_PRODUCER;
+       ++received)
+    {
+      ACE_Message_Block *mb = 0;
+      if (this->getq (mb) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("(%t) %p\n"),
+                           ACE_TEXT ("getq")),
+                          -1);
+
+      int producer = 0;
+      int seq = 0;
+      read_block (mb, producer, seq);
+      mb->release ();
+
+      if (producer < 0 || producer >= PRODUCERS
+          || seq != this->next_[producer])
+        {
+          if (this->errors_++ < 10)
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("(%t) producer %d: got message %d\n"),
+                        producer,
+                        seq));
+        }
+      else
+        ++this->next_[producer];
+    }
+  return 0;
+}
+
+class Producer : public ACE_Task<ACE_MT_SYNCH>
+{
+public:
+  Producer (Consumer &consumer) : consumer_ (consumer), id_ (0) {}
+
+  int svc () override;
+
+  Consumer &consumer_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> id_;
+};
+
+int
+Producer::svc ()
+{
+  int const id = static_cast<int> (this->id_++);
+  for (int i = 0; i < MESSAGES_PER_PRODUCER; ++i)
+    if (this->consumer_.putq (make_block (id, i)) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("(%t) %p\n"),
+                         ACE_TEXT ("putq")),
+                        -1);
+  return 0;
+}
+
+static int
+producers_test (ACE_Message_Queue<ACE_MT_SYNCH> *queue, const ACE_TCHAR *name)
+{
+  Consumer consumer (queue);
+  Producer producer (consumer);
+  ACE_High_Res_Timer timer;
+
+  timer.start ();
+  if (consumer.activate (THR_NEW_LWP | THR_JOINABLE, 1) == -1
+      || producer.activate (THR_NEW_LWP | THR_JOINABLE, PRODUCERS) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("activate")), 1);
+  producer.wait ();
+  consumer.wait ();
+  timer.stop ();
+
+  ACE_hrtime_t usecs;
+  timer.elapsed_microseconds (usecs);
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%s: %d producers, %d messages in %Q usec\n"),
+              name,
+              PRODUCERS,
+              PRODUCERS * MESSAGES_PER_PRODUCER,
+              usecs));
+
+  int status = consumer.errors_ != 0;
+  for (int i = 0; i < PRODUCERS; ++i)
+    if (consumer.next_[i] != MESSAGES_PER_PRODUCER)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%s: received %d messages from producer %d\n"),
+                    name,
+                    consumer.next_[i],
+                    i));
+        status = 1;
+      }
+  if (queue->message_count () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%s: %B messages left\n"),
+                  name,
+                  queue->message_count ()));
+      status = 1;
+    }
+  return status;
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Message_Queue_MPSC_Test"));
+
+  int status = 0;
+
+#if defined (ACE_HAS_THREADS)
+  status += semantics_test ();
+  status += blocking_test ();
+
+  // Large enough not to block the producers, so the runs compare the
+  // enqueue paths.
+  size_t const hwm = 2 * PRODUCERS * MESSAGES_PER_PRODUCER * 4 * sizeof (int);
+  {
+    MPSC_QUEUE queue (hwm, hwm);
+    status += producers_test (&queue, ACE_TEXT ("ACE_Message_Queue_MPSC"));
+  }
+  {
+    ACE_Message_Queue<ACE_MT_SYNCH> queue (hwm, hwm);
+    status += producers_test (&queue, ACE_TEXT ("ACE_Message_Queue"));
+  }
+  {
+    // And one where the producers have to wait for the consumer.
+    MPSC_QUEUE queue (64 * 2 * sizeof (int), 32 * 2 * sizeof (int));
+    status += producers_test (&queue,
+                              ACE_TEXT ("ACE_Message_Queue_MPSC (small)"));
+  }
+#else
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
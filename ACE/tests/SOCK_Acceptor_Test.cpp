@@ -80,6 +80,67 @@ test_accept (ACE_Addr listen_addr, int v6_only)
   return status;
 }
 
+static int
+test_reuse_port ()
+{
+#if defined (SO_REUSEPORT)
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("(%P|%t) starting listen with SO_REUSEPORT\n")));
+
+  ACE_INET_Addr listen_addr (static_cast<u_short> (0), ACE_LOCALHOST);
+  ACE_SOCK_Acceptor first;
+  ACE_INET_Addr listening_at;
+  if (first.open (listen_addr,
+                  0,
+                  PF_UNSPEC,
+                  ACE_DEFAULT_BACKLOG,
+                  0,
+                  0,
+                  1) == -1
+      || first.get_local_addr (listening_at) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%P|%t) %p\n"),
+                       ACE_TEXT ("open with SO_REUSEPORT")),
+                      1);
+
+  // A second socket may listen on the same port only if it sets the
+  // option too.
+  int status = 0;
+  ACE_SOCK_Acceptor plain;
+  if (plain.open (listening_at) != -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%P|%t) second open without ")
+                  ACE_TEXT ("SO_REUSEPORT succeeded\n")));
+      plain.close ();
+      status = 1;
+    }
+
+  ACE_SOCK_Acceptor second;
+  if (second.open (listening_at,
+                   0,
+                   PF_UNSPEC,
+                   ACE_DEFAULT_BACKLOG,
+                   0,
+                   0,
+                   1) == -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%P|%t) %p\n"),
+                  ACE_TEXT ("second open with SO_REUSEPORT")));
+      status = 1;
+    }
+
+  second.close ();
+  first.close ();
+  return status;
+#else
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("(%P|%t) SO_REUSEPORT is not supported\n")));
+  return 0;
+#endif /* SO_REUSEPORT */
+}
+
 int
 run_main (int, ACE_TCHAR *[])
 {
@@ -91,6 +152,8 @@ run_main (int, ACE_TCHAR *[])
     status = 1;
   if (test_accept (ACE_Addr::sap_any, 0) != 0)
     status = 1;
+  if (test_reuse_port () != 0)
+    status = 1;
 
   ACE_END_TEST;
   return status;
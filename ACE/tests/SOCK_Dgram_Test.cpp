@@ -7,6 +7,9 @@
  *
  *   This test uses the same test setup as SOCK_Test.
  *
+ *   Also tests sending and receiving batches of datagrams with
+ *   ACE_SOCK_Dgram::send_n_msgs() and ACE_SOCK_Dgram::recv_n_msgs().
+ *
  *  @author Brian Buesker (bbuesker@qualcomm.com)
  */
 //=============================================================================
@@ -21,9 +24,12 @@
 #include "ace/Log_Msg.h"
 #include "ace/Time_Value.h"
 #include "ace/OS_NS_unistd.h"
+#include "ace/Message_Block.h"
+#include "ace/OS_NS_stdio.h"
 
 #define SERVER_PORT 20000
 #define TEST_DATA ACE_TEXT ("UDP Open Test")
+#define BATCH_SIZE 100
 
 static void *
 client (void *arg)
@@ -357,6 +363,158 @@ spawn (int proto)
   return 0;
 }
 
+// Send BATCH_SIZE numbered datagrams in one go, half of them as
+// message block chains and half of them gathered from iovecs, and
+// receive them back in batches.
+static int
+test_batch (int proto)
+{
+  ACE_INET_Addr any_addr;
+  if (proto == AF_INET)
+    any_addr.set (static_cast<u_short> (0), ACE_LOCALHOST, 1, proto);
+#if defined (ACE_HAS_IPV6)
+  else
+    any_addr.set (static_cast<u_short> (0), ACE_IPV6_LOCALHOST, 1, proto);
+#endif /* ACE_HAS_IPV6 */
+
+  ACE_SOCK_Dgram sender (any_addr, proto);
+  ACE_SOCK_Dgram receiver (any_addr, proto);
+  ACE_INET_Addr sender_addr, receiver_addr;
+  if (sender.get_handle () == ACE_INVALID_HANDLE
+      || receiver.get_handle () == ACE_INVALID_HANDLE
+      || sender.get_local_addr (sender_addr) == -1
+      || receiver.get_local_addr (receiver_addr) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%P|%t) %p\n"),
+                       ACE_TEXT ("batch test open")),
+                      1);
+
+  // Datagram i is "<i>:" followed by i bytes of 'x'; the first half is
+  // sent as a chain of two message blocks.
+  int const half = BATCH_SIZE / 2;
+  ACE_Message_Block heads[BATCH_SIZE / 2];
+  ACE_Message_Block tails[BATCH_SIZE / 2];
+  ACE_Message_Block *chains[BATCH_SIZE / 2];
+  char data[BATCH_SIZE][BATCH_SIZE + 8];
+  size_t lengths[BATCH_SIZE];
+  for (int i = 0; i < BATCH_SIZE; ++i)
+    {
+      int const len = ACE_OS::sprintf (data[i], "%d:", i);
+      ACE_OS::memset (data[i] + len, 'x', i);
+      lengths[i] = len + i;
+      if (i < half)
+        {
+          heads[i].init (data[i], len);
+          heads[i].wr_ptr (len);
+          tails[i].init (data[i] + len, i);
+          tails[i].wr_ptr (i);
+          heads[i].cont (&tails[i]);
+          chains[i] = &heads[i];
+        }
+    }
+
+  iovec iov[BATCH_SIZE / 2];
+  int iovcnt[BATCH_SIZE / 2];
+  for (int i = 0; i < half; ++i)
+    {
+      iov[i].iov_base = data[half + i];
+      iov[i].iov_len = lengths[half + i];
+      iovcnt[i] = 1;
+    }
+
+  int errors = 0;
+  ssize_t sent = sender.send_n_msgs (chains, half, receiver_addr);
+  if (sent != half)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%P|%t) send_n_msgs (chains) returned %b; should be %d\n"),
+                  sent,
+                  half));
+      ++errors;
+    }
+  sent = sender.send_n_msgs (iov, iovcnt, half, receiver_addr);
+  if (sent != half)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%P|%t) send_n_msgs (iovec) returned %b; should be %d\n"),
+                  sent,
+                  half));
+      ++errors;
+    }
+
+  ACE_Message_Block *blocks[BATCH_SIZE];
+  ACE_INET_Addr from[BATCH_SIZE];
+  for (int i = 0; i < BATCH_SIZE; ++i)
+    ACE_NEW_RETURN (blocks[i], ACE_Message_Block (BATCH_SIZE + 8), 1);
+
+  int received = 0;
+  int calls = 0;
+  while (received < BATCH_SIZE)
+    {
+      ACE_Time_Value timeout (2);
+      ssize_t const n = receiver.recv_n_msgs (blocks + received,
+                                              BATCH_SIZE - received,
+                                              from + received,
+                                              0,
+                                              &timeout);
+      if (n <= 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%P|%t) %p after %d datagrams\n"),
+                      ACE_TEXT ("recv_n_msgs"),
+                      received));
+          ++errors;
+          break;
+        }
+      received += static_cast<int> (n);
+      ++calls;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("(%P|%t) proto %d: received %d datagrams in %d calls\n"),
+              proto,
+              received,
+              calls));
+
+  for (int i = 0; i < received; ++i)
+    {
+      if (blocks[i]->length () != lengths[i]
+          || ACE_OS::memcmp (blocks[i]->rd_ptr (), data[i], lengths[i]) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%P|%t) datagram %d has wrong contents\n"),
+                      i));
+          ++errors;
+        }
+      if (from[i] != sender_addr)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%P|%t) datagram %d has wrong sender\n"),
+                      i));
+          ++errors;
+        }
+    }
+
+  for (int i = 0; i < BATCH_SIZE; ++i)
+    blocks[i]->release ();
+
+  // Nothing is left, so a non-blocking batch receive must fail.
+  ACE_Message_Block extra (BATCH_SIZE + 8);
+  ACE_Message_Block *extra_ptr = &extra;
+  ACE_Time_Value no_wait (ACE_Time_Value::zero);
+  if (receiver.recv_n_msgs (&extra_ptr, 1, 0, 0, &no_wait) != -1
+      || errno != ETIME)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%P|%t) recv_n_msgs on an empty socket did not time out\n")));
+      ++errors;
+    }
+
+  sender.close ();
+  receiver.close ();
+  return errors == 0 ? 0 : 1;
+}
+
 int run_main (int, ACE_TCHAR *[])
 {
   ACE_START_TEST (ACE_TEXT ("SOCK_Dgram_Test"));
@@ -370,6 +528,14 @@ int run_main (int, ACE_TCHAR *[])
       retval = spawn (AF_INET6);
     }
 
+#endif /* ACE_HAS_IPV6 */
+
+  if (retval == 0)
+    retval = test_batch (AF_INET);
+
+#if defined (ACE_HAS_IPV6)
+  if (retval == 0)
+    retval = test_batch (AF_INET6);
 #endif /* ACE_HAS_IPV6 */
 
   ACE_END_TEST;
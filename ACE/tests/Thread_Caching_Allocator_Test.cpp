@@ -0,0 +1,339 @@
+//=============================================================================
+/**
+ *  @file    Thread_Caching_Allocator_Test.cpp
+ *
+ *  Test of ACE_Thread_Caching_Allocator: chunk sizes, the depot,
+ *  chunks freed by other threads, returning the caches of exited
+ *  threads, and that every chunk goes back to the backing allocator.
+ *  Also compares its speed with ACE_Dynamic_Cached_Allocator when
+ *  several threads allocate at once.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Thread_Caching_Allocator_T.h"
+#include "ace/Malloc_T.h"
+#include "ace/Barrier.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_string.h"
+
+using ALLOCATOR = ACE_Thread_Caching_Allocator<ACE_SYNCH_MUTEX>;
+
+/// Backing allocator that counts outstanding chunks.
+class Counting_Allocator : public ACE_New_Allocator
+{
+public:
+  void *malloc (size_t nbytes) override
+  {
+    void *ptr = ACE_New_Allocator::malloc (nbytes);
+    if (ptr != 0)
+      ++this->outstanding_;
+    return ptr;
+  }
+
+  void free (void *ptr) override
+  {
+    if (ptr != 0)
+      --this->outstanding_;
+    ACE_New_Allocator::free (ptr);
+  }
+
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> outstanding_;
+};
+
+static const size_t sizes[] = { 1, 8, 16, 17, 100, 512, 1000, 4096, 65536, 131072, 200000 };
+static const size_t size_count = sizeof (sizes) / sizeof (sizes[0]);
+
+static int
+check_pattern (const char *ptr, size_t nbytes, char pattern)
+{
+  for (size_t i = 0; i < nbytes; ++i)
+    if (ptr[i] != pattern)
+      return 1;
+  return 0;
+}
+
+static int
+single_thread_test ()
+{
+  int status = 0;
+  Counting_Allocator backing;
+  {
+    ALLOCATOR allocator (ACE_DEFAULT_THREAD_CACHE_MAX_SIZE, 8, 2, &backing);
+
+    // Every size, including the uncached one, is usable.
+    void *ptrs[size_count];
+    for (size_t i = 0; i < size_count; ++i)
+      {
+        ptrs[i] = allocator.malloc (sizes[i]);
+        if (ptrs[i] == 0)
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("malloc (%B) failed\n"),
+                             sizes[i]),
+                            1);
+        ACE_OS::memset (ptrs[i], static_cast<int> (i), sizes[i]);
+      }
+    for (size_t i = 0; i < size_count; ++i)
+      {
+        if (check_pattern (static_cast<char *> (ptrs[i]), sizes[i],
+                           static_cast<char> (i)))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("chunk of %B bytes was overwritten\n"),
+                        sizes[i]));
+            status = 1;
+          }
+        allocator.free (ptrs[i]);
+      }
+
+    // calloc() clears, and catches overflows.
+    char *zeroed = static_cast<char *> (allocator.calloc (100, static_cast<size_t> (10)));
+    if (zeroed == 0 || check_pattern (zeroed, 1000, 0))
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("calloc did not clear memory\n")));
+        status = 1;
+      }
+    allocator.free (zeroed);
+    if (allocator.calloc (~static_cast<size_t> (0) / 2, static_cast<size_t> (4)) != 0)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("calloc overflow not detected\n")));
+        status = 1;
+      }
+
+    // A freed chunk is reused right away.
+    void *first = allocator.malloc (64);
+    allocator.free (first);
+    void *second = allocator.malloc (64);
+    if (first != second)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("freed chunk was not reused\n")));
+        status = 1;
+      }
+    allocator.free (second);
+
+    // Freeing more than two magazines fills the depot, but only up to
+    // its two magazines; the thread keeps two more and the rest goes
+    // back to the backing allocator.
+    void *many[64];
+    for (int i = 0; i < 64; ++i)
+      many[i] = allocator.malloc (64);
+    for (int i = 0; i < 64; ++i)
+      allocator.free (many[i]);
+    if (allocator.depot_depth (64) != 2 * 8)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("depot holds %B chunks, expected 16\n"),
+                    allocator.depot_depth (64)));
+        status = 1;
+      }
+    long const expected = 4 * 8 + static_cast<long> (size_count - 1);
+    if (backing.outstanding_.value () != expected)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%d chunks outstanding, expected %d\n"),
+                    backing.outstanding_.value (),
+                    expected));
+        status = 1;
+      }
+
+    // And the depot gives them out again.
+    for (int i = 0; i < 64; ++i)
+      many[i] = allocator.malloc (64);
+    if (allocator.depot_depth (64) != 0)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("depot still holds %B chunks\n"),
+                    allocator.depot_depth (64)));
+        status = 1;
+      }
+    for (int i = 0; i < 64; ++i)
+      allocator.free (many[i]);
+  }
+
+  if (backing.outstanding_.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d chunks not returned by the destructor\n"),
+                  backing.outstanding_.value ()));
+      status = 1;
+    }
+  return status;
+}
+
+#if defined (ACE_HAS_THREADS)
+
+static const int THREADS = 4;
+static const int CHUNKS = 2000;
+
+struct Exchange
+{
+  ACE_Allocator *allocator_;
+  ACE_Barrier *barrier_;
+  char *chunks_[THREADS][CHUNKS];
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> next_id_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> errors_;
+};
+
+static size_t
+chunk_size (int id, int i)
+{
+  return 16 + static_cast<size_t> ((id * 7 + i * 13) % 2000);
+}
+
+// Each thread allocates chunks, then checks and frees the chunks of
+// the next thread, so every chunk is freed by another thread.
+static ACE_THR_FUNC_RETURN
+exchange_chunks (void *arg)
+{
+  Exchange *exchange = static_cast<Exchange *> (arg);
+  int const id = static_cast<int> (exchange->next_id_++);
+
+  for (int round = 0; round < 10; ++round)
+    {
+      for (int i = 0; i < CHUNKS; ++i)
+        {
+          size_t const size = chunk_size (id, i);
+          char *chunk = static_cast<char *> (exchange->allocator_->malloc (size));
+          if (chunk != 0)
+            ACE_OS::memset (chunk, id + 1, size);
+          exchange->chunks_[id][i] = chunk;
+        }
+
+      exchange->barrier_->wait ();
+
+      int const other = (id + 1) % THREADS;
+      for (int i = 0; i < CHUNKS; ++i)
+        {
+          char *chunk = exchange->chunks_[other][i];
+          if (chunk == 0
+              || check_pattern (chunk, chunk_size (other, i),
+                                static_cast<char> (other + 1)))
+            ++exchange->errors_;
+          exchange->allocator_->free (chunk);
+        }
+
+      exchange->barrier_->wait ();
+    }
+  return 0;
+}
+
+static int
+multi_thread_test ()
+{
+  int status = 0;
+  Counting_Allocator backing;
+  {
+    ALLOCATOR allocator (ACE_DEFAULT_THREAD_CACHE_MAX_SIZE,
+                         ACE_DEFAULT_THREAD_CACHE_MAGAZINE_SIZE,
+                         ACE_DEFAULT_THREAD_CACHE_DEPOT_SIZE,
+                         &backing);
+    ACE_Barrier barrier (THREADS);
+    Exchange exchange;
+    exchange.allocator_ = &allocator;
+    exchange.barrier_ = &barrier;
+
+    if (ACE_Thread_Manager::instance ()->spawn_n (THREADS,
+                                                  exchange_chunks,
+                                                  &exchange) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+    ACE_Thread_Manager::instance ()->wait ();
+
+    if (exchange.errors_.value () != 0)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%d chunks were corrupted\n"),
+                    exchange.errors_.value ()));
+        status = 1;
+      }
+
+    // The exited threads gave their full magazines to the depot.
+    size_t depot = 0;
+    for (size_t size = 16; size <= 2048; size *= 2)
+      depot += allocator.depot_depth (size);
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("%B chunks in the depot, %d allocated from ")
+                ACE_TEXT ("the backing allocator\n"),
+                depot,
+                backing.outstanding_.value ()));
+    if (depot == 0)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("exited threads did not return their caches\n")));
+        status = 1;
+      }
+  }
+
+  if (backing.outstanding_.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d chunks not returned after the threads exited\n"),
+                  backing.outstanding_.value ()));
+      status = 1;
+    }
+  return status;
+}
+
+static const int SPEED_LOOPS = 200000;
+
+static ACE_THR_FUNC_RETURN
+churn (void *arg)
+{
+  ACE_Allocator *allocator = static_cast<ACE_Allocator *> (arg);
+  void *held[16];
+  for (int i = 0; i < SPEED_LOOPS; ++i)
+    {
+      for (int j = 0; j < 16; ++j)
+        held[j] = allocator->malloc (512);
+      for (int j = 0; j < 16; ++j)
+        allocator->free (held[j]);
+    }
+  return 0;
+}
+
+static void
+speed_test (ACE_Allocator *allocator, const ACE_TCHAR *name)
+{
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  ACE_Thread_Manager::instance ()->spawn_n (THREADS, churn, allocator);
+  ACE_Thread_Manager::instance ()->wait ();
+  timer.stop ();
+
+  ACE_hrtime_t usecs;
+  timer.elapsed_microseconds (usecs);
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("%s: %d threads, %d malloc/free pairs each in %Q usec\n"),
+              name,
+              THREADS,
+              SPEED_LOOPS * 16,
+              usecs));
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Thread_Caching_Allocator_Test"));
+
+  int status = single_thread_test ();
+
+#if defined (ACE_HAS_THREADS)
+  status += multi_thread_test ();
+
+  {
+    ALLOCATOR allocator;
+    speed_test (&allocator, ACE_TEXT ("ACE_Thread_Caching_Allocator"));
+  }
+  {
+    ACE_Dynamic_Cached_Allocator<ACE_SYNCH_MUTEX> allocator (THREADS * 16, 512);
+    speed_test (&allocator, ACE_TEXT ("ACE_Dynamic_Cached_Allocator"));
+  }
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
@@ -3,9 +3,10 @@
 /**
  *  @file    Timer_Queue_Test.cpp
  *
- *    This is a simple test of <ACE_Timer_Queue> and four of its
+ *    This is a simple test of <ACE_Timer_Queue> and five of its
  *    subclasses (<ACE_Timer_List>, <ACE_Timer_Heap>,
- *    <ACE_Timer_Wheel>, and <ACE_Timer_Hash>).  The test sets up a
+ *    <ACE_Timer_Wheel>, <ACE_Timer_Hierarchical_Wheel> and
+ *    <ACE_Timer_Hash>).  The test sets up a
  *    bunch of timers and then adds them to a timer queue. The
  *    functionality of the timer queue is then tested. No command
  *    line arguments are needed to run the test.
@@ -23,6 +24,7 @@
 #include "ace/Timer_List.h"
 #include "ace/Timer_Heap.h"
 #include "ace/Timer_Wheel.h"
+#include "ace/Timer_Hierarchical_Wheel.h"
 #include "ace/Timer_Hash.h"
 #include "ace/Timer_Queue.h"
 #include "ace/Time_Policy.h"
@@ -576,6 +578,97 @@ test_unique_timer_heap_ids ()
   return;
 }
 
+struct Order_Handler : public ACE_Event_Handler
+{
+  Order_Handler () : count_ (0), in_order_ (true) { }
+
+  int handle_timeout (const ACE_Time_Value &current_time,
+                      const void *arg) override
+  {
+    // The act points to the value the timer was scheduled for.
+    const ACE_Time_Value &value = *static_cast<const ACE_Time_Value *> (arg);
+    if (value > current_time || value < this->last_)
+      this->in_order_ = false;
+    this->last_ = value;
+    ++this->count_;
+    return 0;
+  }
+
+  ACE_Time_Value last_;
+  int count_;
+  bool in_order_;
+};
+
+// Check that ACE_Timer_Hierarchical_Wheel expires timers in order
+// when they are spread over all the levels of the wheel and its
+// overflow list.  A tick of 1 usec makes the levels span 256 usecs,
+// 65 msecs, 16 secs and 71 minutes.
+static void
+test_hierarchical_wheel_order ()
+{
+  const int TIMERS = 4000;
+  ACE_Timer_Hierarchical_Wheel wheel (1);
+  Order_Handler handler;
+  ACE_Time_Value *times = 0;
+  long *ids = 0;
+  ACE_NEW (times, ACE_Time_Value[TIMERS]);
+  ACE_NEW (ids, long[TIMERS]);
+
+  ACE_Time_Value const start = wheel.gettimeofday ();
+  ACE_Time_Value last = start;
+
+  for (int i = 0; i < TIMERS; ++i)
+    {
+      // Offsets from a few usecs up to about four hours.
+      ACE_UINT64 usecs = static_cast<ACE_UINT64> (ACE_OS::rand ()) % 1000;
+      for (int j = i % 4; j > 0; --j)
+        usecs = usecs * 256 + ACE_OS::rand () % 256;
+      times[i] = start;
+      times[i] += ACE_Time_Value (usecs / ACE_ONE_SECOND_IN_USECS,
+                                  usecs % ACE_ONE_SECOND_IN_USECS);
+      if (times[i] > last)
+        last = times[i];
+      ids[i] = wheel.schedule (&handler, &times[i], times[i]);
+      ACE_TEST_ASSERT (ids[i] != -1);
+    }
+
+  // Cancel every tenth timer.
+  int cancelled = 0;
+  for (int i = 0; i < TIMERS; i += 10, ++cancelled)
+    ACE_TEST_ASSERT (wheel.cancel (ids[i]) == 1);
+  ACE_TEST_ASSERT (wheel.cancel (ids[0]) == 0);
+
+  // Expire in steps of growing size, checking the earliest time on
+  // the way.
+  ACE_Time_Value now = start;
+  ACE_Time_Value step (0, 1);
+  while (!wheel.is_empty ())
+    {
+      ACE_Time_Value const earliest = wheel.earliest_time ();
+      ACE_TEST_ASSERT (earliest >= handler.last_);
+      now += step;
+      step *= 2;
+      if (step > ACE_Time_Value (60))
+        step = ACE_Time_Value (60);
+      int const expired = wheel.expire (now);
+      ACE_TEST_ASSERT (expired >= 0);
+      ACE_TEST_ASSERT ((expired > 0) == (earliest <= now));
+    }
+  ACE_TEST_ASSERT (now >= last);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("hierarchical wheel expired %d of %d timers %s\n"),
+              handler.count_,
+              TIMERS - cancelled,
+              handler.in_order_ ? ACE_TEXT ("in order")
+                                : ACE_TEXT ("OUT OF ORDER")));
+  ACE_TEST_ASSERT (handler.in_order_);
+  ACE_TEST_ASSERT (handler.count_ == TIMERS - cancelled);
+
+  delete [] ids;
+  delete [] times;
+}
+
 /**
  * @class Timer_Queue_Stack
  *
@@ -656,6 +749,21 @@ run_main (int argc, ACE_TCHAR *argv[])
                                      ACE_TEXT ("ACE_Timer_Wheel (preallocated)"),
                                      tq_stack),
                   -1);
+  // Timer_Hierarchical_Wheel without preallocated memory
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel,
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (non-preallocated)"),
+                                     tq_stack),
+                  -1);
+
+  // Timer_Hierarchical_Wheel with preallocated memory.
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_TICK,
+                                                                       max_iterations),
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (preallocated)"),
+                                     tq_stack),
+                  -1);
+
   // Timer_Heap without preallocated memory.
   ACE_NEW_RETURN (tq_stack,
                   Timer_Queue_Stack (new ACE_Timer_Heap,
@@ -720,6 +828,11 @@ run_main (int argc, ACE_TCHAR *argv[])
       ACE_TEXT ("**** starting unique IDs test for ACE_Timer_Heap\n")));
   test_unique_timer_heap_ids ();
 
+  ACE_DEBUG
+    ((LM_DEBUG,
+      ACE_TEXT ("**** starting expiry order test for ACE_Timer_Hierarchical_Wheel\n")));
+  test_hierarchical_wheel_order ();
+
   ACE_END_TEST;
   return 0;
 }
@@ -0,0 +1,461 @@
+//=============================================================================
+/**
+ *  @file    Uring_Proactor_Test.cpp
+ *
+ *  This test exercises the ACE_Uring_Proactor: file reads and writes
+ *  into registered and unregistered buffers, asynchronous accept and
+ *  connect, stream reads and writes over the connection, cancellation
+ *  of an outstanding read and timers.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_sys_socket.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Proactor.h"
+#include "ace/Uring_Proactor.h"
+#include "ace/Asynch_IO.h"
+#include "ace/Message_Block.h"
+#include "ace/INET_Addr.h"
+#include "ace/SOCK_Acceptor.h"
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_AIO_CALLS)
+
+static const char message[] = "Hello there! Hope you get this message";
+static const size_t message_size = sizeof (message);
+
+static const size_t file_offset = 4096;
+
+class Test_Handler : public ACE_Handler
+{
+public:
+  Test_Handler ();
+
+  ~Test_Handler () override;
+
+  void handle_read_file (const ACE_Asynch_Read_File::Result &result) override;
+  void handle_write_file (const ACE_Asynch_Write_File::Result &result) override;
+  void handle_accept (const ACE_Asynch_Accept::Result &result) override;
+  void handle_connect (const ACE_Asynch_Connect::Result &result) override;
+  void handle_read_stream (const ACE_Asynch_Read_Stream::Result &result) override;
+  void handle_write_stream (const ACE_Asynch_Write_Stream::Result &result) override;
+  void handle_time_out (const ACE_Time_Value &tv, const void *act) override;
+
+  /// Number of completions still expected.
+  int pending_;
+
+  /// Number of failed checks.
+  int errors_;
+
+  ACE_HANDLE accepted_;
+  ACE_HANDLE connected_;
+  bool canceled_;
+  bool timed_out_;
+};
+
+Test_Handler::Test_Handler ()
+  : pending_ (0),
+    errors_ (0),
+    accepted_ (ACE_INVALID_HANDLE),
+    connected_ (ACE_INVALID_HANDLE),
+    canceled_ (false),
+    timed_out_ (false)
+{
+}
+
+Test_Handler::~Test_Handler ()
+{
+  if (this->accepted_ != ACE_INVALID_HANDLE)
+    ACE_OS::closesocket (this->accepted_);
+  if (this->connected_ != ACE_INVALID_HANDLE)
+    ACE_OS::closesocket (this->connected_);
+}
+
+void
+Test_Handler::handle_read_file (const ACE_Asynch_Read_File::Result &result)
+{
+  --this->pending_;
+
+  ACE_Message_Block &mb = result.message_block ();
+  if (!result.success () || result.bytes_transferred () != message_size)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("File read at %u failed: %d bytes, error %d\n"),
+                  result.offset (),
+                  static_cast<int> (result.bytes_transferred ()),
+                  static_cast<int> (result.error ())));
+      ++this->errors_;
+    }
+  else if (ACE_OS::memcmp (mb.rd_ptr (), message, message_size) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("File read at %u returned the wrong data\n"),
+                  result.offset ()));
+      ++this->errors_;
+    }
+  else
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("File read at %u ok\n"),
+                result.offset ()));
+}
+
+void
+Test_Handler::handle_write_file (const ACE_Asynch_Write_File::Result &result)
+{
+  --this->pending_;
+
+  if (!result.success () || result.bytes_transferred () != message_size)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("File write at %u failed: %d bytes, error %d\n"),
+                  result.offset (),
+                  static_cast<int> (result.bytes_transferred ()),
+                  static_cast<int> (result.error ())));
+      ++this->errors_;
+    }
+}
+
+void
+Test_Handler::handle_accept (const ACE_Asynch_Accept::Result &result)
+{
+  --this->pending_;
+
+  if (!result.success () || result.accept_handle () == ACE_INVALID_HANDLE)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Accept failed: error %d\n"),
+                  static_cast<int> (result.error ())));
+      ++this->errors_;
+      return;
+    }
+
+  this->accepted_ = result.accept_handle ();
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Accepted handle %d\n"), this->accepted_));
+}
+
+void
+Test_Handler::handle_connect (const ACE_Asynch_Connect::Result &result)
+{
+  --this->pending_;
+
+  if (!result.success ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Connect failed: error %d\n"),
+                  static_cast<int> (result.error ())));
+      ++this->errors_;
+      if (result.connect_handle () != ACE_INVALID_HANDLE)
+        ACE_OS::closesocket (result.connect_handle ());
+      return;
+    }
+
+  this->connected_ = result.connect_handle ();
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Connected handle %d\n"), this->connected_));
+}
+
+void
+Test_Handler::handle_read_stream (const ACE_Asynch_Read_Stream::Result &result)
+{
+  --this->pending_;
+
+  ACE_Message_Block &mb = result.message_block ();
+  if (result.error () == ECANCELED)
+    {
+      ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Stream read canceled\n")));
+      this->canceled_ = true;
+    }
+  else if (!result.success ()
+           || result.bytes_transferred () != message_size
+           || ACE_OS::memcmp (mb.rd_ptr (), message, message_size) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Stream read failed: %d bytes, error %d\n"),
+                  static_cast<int> (result.bytes_transferred ()),
+                  static_cast<int> (result.error ())));
+      ++this->errors_;
+    }
+  else
+    ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Stream read ok\n")));
+
+  mb.release ();
+}
+
+void
+Test_Handler::handle_write_stream (const ACE_Asynch_Write_Stream::Result &result)
+{
+  --this->pending_;
+
+  if (!result.success () || result.bytes_transferred () != message_size)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Stream write failed: %d bytes, error %d\n"),
+                  static_cast<int> (result.bytes_transferred ()),
+                  static_cast<int> (result.error ())));
+      ++this->errors_;
+    }
+
+  result.message_block ().release ();
+}
+
+void
+Test_Handler::handle_time_out (const ACE_Time_Value &, const void *)
+{
+  --this->pending_;
+  this->timed_out_ = true;
+}
+
+// Run the event loop until all expected completions have arrived.
+static int
+run_until_done (ACE_Proactor &proactor, Test_Handler &handler)
+{
+  ACE_Time_Value const deadline =
+    ACE_OS::gettimeofday () + ACE_Time_Value (10);
+
+  while (handler.pending_ > 0)
+    {
+      if (ACE_OS::gettimeofday () > deadline)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("Timed out with %d completions ")
+                           ACE_TEXT ("outstanding\n"),
+                           handler.pending_),
+                          -1);
+
+      ACE_Time_Value tv (1);
+      if (proactor.handle_events (tv) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%p\n"),
+                           ACE_TEXT ("handle_events")),
+                          -1);
+    }
+
+  return 0;
+}
+
+static int
+test_file_io (ACE_Proactor &proactor, ACE_Uring_Proactor &impl)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing file I/O\n")));
+
+  ACE_TCHAR file_name[MAXPATHLEN];
+  ACE_OS::snprintf (file_name, MAXPATHLEN,
+                    ACE_TEXT ("Uring_Proactor_Test_%d.tmp"),
+                    static_cast<int> (ACE_OS::getpid ()));
+
+  ACE_HANDLE const handle =
+    ACE_OS::open (file_name, O_RDWR | O_CREAT | O_TRUNC, ACE_DEFAULT_FILE_PERMS);
+  if (handle == ACE_INVALID_HANDLE)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), file_name), -1);
+  ACE_OS::unlink (file_name);
+
+  Test_Handler handler;
+  ACE_Asynch_Read_File reader;
+  ACE_Asynch_Write_File writer;
+  int status = 0;
+
+  if (reader.open (handler, handle, 0, &proactor) == -1
+      || writer.open (handler, handle, 0, &proactor) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")));
+      ACE_OS::close (handle);
+      return -1;
+    }
+
+  // The first two blocks are registered with the ring, the last one
+  // is not.
+  ACE_Message_Block out (message_size);
+  ACE_Message_Block in (message_size);
+  ACE_Message_Block plain (message_size);
+  out.cont (&in);
+  out.copy (message, message_size);
+
+  if (impl.register_buffers (&out) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("register_buffers")));
+      status = -1;
+    }
+
+  handler.pending_ = 2;
+  if (writer.write (out, message_size, 0) == -1
+      || writer.write (out, message_size, file_offset) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("write")));
+      status = -1;
+    }
+  else if (run_until_done (proactor, handler) == -1)
+    status = -1;
+
+  handler.pending_ = 2;
+  if (status == 0
+      && (reader.read (in, message_size, 0) == -1
+          || reader.read (plain, message_size, file_offset) == -1))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("read")));
+      status = -1;
+    }
+  else if (status == 0 && run_until_done (proactor, handler) == -1)
+    status = -1;
+
+  out.cont (0);
+
+  if (impl.unregister_buffers () == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("unregister_buffers")));
+      status = -1;
+    }
+
+  ACE_OS::close (handle);
+  return status == 0 && handler.errors_ == 0 ? 0 : -1;
+}
+
+static int
+test_stream_io (ACE_Proactor &proactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing accept, connect and stream I/O\n")));
+
+  ACE_SOCK_Acceptor acceptor;
+  ACE_INET_Addr listen_addr (static_cast<u_short> (0), ACE_LOCALHOST);
+  if (acceptor.open (listen_addr, 1) == -1
+      || acceptor.get_local_addr (listen_addr) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("listen")), -1);
+
+  Test_Handler handler;
+  ACE_Asynch_Accept accept;
+  ACE_Asynch_Connect connect;
+
+  if (accept.open (handler, acceptor.get_handle (), 0, &proactor) == -1
+      || connect.open (handler, ACE_INVALID_HANDLE, 0, &proactor) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), -1);
+
+  ACE_Message_Block accept_mb (2 * sizeof (sockaddr_in) + 64);
+
+  handler.pending_ = 2;
+  if (accept.accept (accept_mb, 0) == -1
+      || connect.connect (ACE_INVALID_HANDLE,
+                         listen_addr,
+                         ACE_Addr::sap_any,
+                         1) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("start")), -1);
+
+  if (run_until_done (proactor, handler) == -1 || handler.errors_ != 0)
+    return -1;
+
+  ACE_Asynch_Read_Stream reader;
+  ACE_Asynch_Write_Stream writer;
+  if (reader.open (handler, handler.accepted_, 0, &proactor) == -1
+      || writer.open (handler, handler.connected_, 0, &proactor) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), -1);
+
+  ACE_Message_Block *in = 0;
+  ACE_Message_Block *out = 0;
+  ACE_NEW_RETURN (in, ACE_Message_Block (message_size), -1);
+  ACE_NEW_RETURN (out, ACE_Message_Block (message_size), -1);
+  out->copy (message, message_size);
+
+  handler.pending_ = 2;
+  if (reader.read (*in, message_size) == -1)
+    {
+      in->release ();
+      out->release ();
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("read")), -1);
+    }
+  if (writer.write (*out, message_size) == -1)
+    {
+      out->release ();
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("write")), -1);
+    }
+
+  if (run_until_done (proactor, handler) == -1 || handler.errors_ != 0)
+    return -1;
+
+  // Nothing more is sent, so this read stays outstanding until it is
+  // canceled.
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing cancel\n")));
+  ACE_NEW_RETURN (in, ACE_Message_Block (message_size), -1);
+
+  handler.pending_ = 1;
+  if (reader.read (*in, message_size) == -1)
+    {
+      in->release ();
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("read")), -1);
+    }
+  if (reader.cancel () != 0)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("Read was not canceled\n")));
+
+  if (run_until_done (proactor, handler) == -1)
+    return -1;
+
+  if (!handler.canceled_)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("Canceled read did not complete ")
+                       ACE_TEXT ("with ECANCELED\n")),
+                      -1);
+
+  return handler.errors_ == 0 ? 0 : -1;
+}
+
+static int
+test_timer (ACE_Proactor &proactor)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Testing timers\n")));
+
+  Test_Handler handler;
+  handler.pending_ = 1;
+  if (proactor.schedule_timer (handler, 0, ACE_Time_Value (0, 10000)) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("schedule_timer")),
+                      -1);
+
+  if (run_until_done (proactor, handler) == -1 || !handler.timed_out_)
+    return -1;
+
+  return 0;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Proactor_Test"));
+
+  int status = 0;
+
+  ACE_Uring_Proactor *impl = 0;
+  ACE_NEW_RETURN (impl, ACE_Uring_Proactor, -1);
+  ACE_Proactor proactor (impl, true);
+
+  if (test_file_io (proactor, *impl) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("File I/O test failed\n")));
+      status = 1;
+    }
+
+  if (test_stream_io (proactor) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Stream I/O test failed\n")));
+      status = 1;
+    }
+
+  if (test_timer (proactor) == -1)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Timer test failed\n")));
+      status = 1;
+    }
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Proactor_Test"));
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("ACE_Uring_Proactor is UNSUPPORTED on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_IO_URING && ACE_HAS_AIO_CALLS */
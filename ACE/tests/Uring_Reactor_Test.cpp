@@ -0,0 +1,387 @@
+
+//=============================================================================
+/**
+ *  @file    Uring_Reactor_Test.cpp
+ *
+ *  This test exercises the ACE_Uring_Reactor: dispatch order of
+ *  timers and I/O events, suspension and resumption of handlers,
+ *  re-arming of handlers across many events, notifications and
+ *  handler removal.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Reactor.h"
+#include "ace/Uring_Reactor.h"
+#include "ace/Pipe.h"
+#include "ace/ACE.h"
+
+#if defined (ACE_HAS_IO_URING) && defined (ACE_HAS_EVENT_POLL)
+
+static const char *message = "Hello there! Hope you get this message";
+
+static const int pipe_count = 32;
+static const int writes_per_pipe = 100;
+
+class Order_Handler : public ACE_Event_Handler
+{
+public:
+  Order_Handler (ACE_Reactor &reactor);
+
+  ~Order_Handler () override;
+
+  int handle_timeout (const ACE_Time_Value &tv,
+                      const void *arg) override;
+
+  int handle_input (ACE_HANDLE fd) override;
+
+  int handle_output (ACE_HANDLE fd) override;
+
+  ACE_HANDLE get_handle () const override;
+
+  ACE_Pipe pipe_;
+
+  int dispatch_order_;
+  bool ok_;           // Constructed and initialized ok
+};
+
+Order_Handler::Order_Handler (ACE_Reactor &reactor)
+  : ACE_Event_Handler (&reactor),
+    dispatch_order_ (1),
+    ok_ (false)
+{
+  if (0 != this->pipe_.open ())
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("pipe")));
+  else if (0 != this->reactor ()->register_handler
+             (this->pipe_.read_handle (),
+              this,
+              ACE_Event_Handler::READ_MASK | ACE_Event_Handler::WRITE_MASK))
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("register")));
+  else
+    this->ok_ = true;
+}
+
+Order_Handler::~Order_Handler ()
+{
+  this->pipe_.close ();
+}
+
+ACE_HANDLE
+Order_Handler::get_handle () const
+{
+  return this->pipe_.read_handle ();
+}
+
+int
+Order_Handler::handle_timeout (const ACE_Time_Value &, const void *)
+{
+  int const me = this->dispatch_order_++;
+  if (me != 1)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("handle_timeout should be #1; it's %d\n"),
+                me));
+  return 0;
+}
+
+int
+Order_Handler::handle_output (ACE_HANDLE)
+{
+  int const me = this->dispatch_order_++;
+  if (me != 2)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("handle_output should be #2; it's %d\n"),
+                me));
+
+  // Don't want to continually see writeable; only verify its relative order.
+  this->reactor ()->mask_ops (this->pipe_.read_handle (),
+                              ACE_Event_Handler::WRITE_MASK,
+                              ACE_Reactor::CLR_MASK);
+  return 0;
+}
+
+int
+Order_Handler::handle_input (ACE_HANDLE fd)
+{
+  int const me = this->dispatch_order_++;
+  if (me != 3)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("handle_input should be #3; it's %d\n"),
+                me));
+
+  char buffer[BUFSIZ];
+  ssize_t const result = ACE::recv (fd, buffer, sizeof buffer - 1);
+  if (result != ssize_t (ACE_OS::strlen (message)))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Handler recv'd %b bytes; expected %B\n"),
+                  result, ACE_OS::strlen (message)));
+      return -1;
+    }
+  buffer[result] = '\0';
+
+  if (ACE_OS::strcmp (buffer, message) != 0)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("Handler text mismatch; received \"%C\"; ")
+                ACE_TEXT ("expected \"%C\"\n"),
+                buffer, message));
+
+  this->reactor ()->end_reactor_event_loop ();
+  return 0;
+}
+
+static bool
+test_dispatch_order (ACE_Reactor &reactor)
+{
+  Order_Handler handler (reactor);
+  if (!handler.ok_)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Error initializing test; abort.\n")));
+      return false;
+    }
+
+  bool ok_to_go = true;
+
+  ssize_t const result =
+    ACE::send_n (handler.pipe_.write_handle (),
+                 message,
+                 ACE_OS::strlen (message));
+  if (result != ssize_t (ACE_OS::strlen (message)))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Handler sent %b bytes; should be %B\n"),
+                  result, ACE_OS::strlen (message)));
+      ok_to_go = false;
+    }
+
+  if (-1 == reactor.schedule_timer (&handler, 0, ACE_Time_Value (0)))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("schedule_timer")));
+      ok_to_go = false;
+    }
+
+  // Suspend the handlers - only the timer should be dispatched
+  ACE_Time_Value tv (1);
+  reactor.suspend_handlers ();
+  reactor.run_reactor_event_loop (tv);
+
+  if (handler.dispatch_order_ != 2)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Incorrect number fired %d\n"),
+                  handler.dispatch_order_));
+      ok_to_go = false;
+    }
+
+  handler.dispatch_order_ = 1;
+  if (-1 == reactor.schedule_timer (&handler, 0, ACE_Time_Value (0)))
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("schedule_timer")));
+      ok_to_go = false;
+    }
+
+  // Resume the handlers - things should work now
+  reactor.resume_handlers ();
+
+  if (ok_to_go)
+    {
+      tv.set (1, 0);
+      reactor.run_reactor_event_loop (tv);
+    }
+
+  if (0 != reactor.remove_handler (handler.pipe_.read_handle (),
+                                   ACE_Event_Handler::ALL_EVENTS_MASK |
+                                   ACE_Event_Handler::DONT_CALL))
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("%p\n"),
+                ACE_TEXT ("remove_handler pipe")));
+
+  if (handler.dispatch_order_ != 4)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("Incorrect number fired %d\n"),
+                  handler.dispatch_order_));
+      ok_to_go = false;
+    }
+
+  reactor.reset_reactor_event_loop ();
+  return ok_to_go;
+}
+
+/**
+ * Reads single bytes from a pipe; every read requires the reactor to
+ * re-arm the handle.
+ */
+class Count_Handler : public ACE_Event_Handler
+{
+public:
+  Count_Handler ();
+
+  ~Count_Handler () override;
+
+  int handle_input (ACE_HANDLE fd) override;
+
+  int handle_close (ACE_HANDLE, ACE_Reactor_Mask) override;
+
+  int handle_exception (ACE_HANDLE) override;
+
+  ACE_Pipe pipe_;
+  int reads_;
+  int closes_;
+  int notifies_;
+};
+
+Count_Handler::Count_Handler ()
+  : reads_ (0),
+    closes_ (0),
+    notifies_ (0)
+{
+}
+
+Count_Handler::~Count_Handler ()
+{
+  this->pipe_.close ();
+}
+
+int
+Count_Handler::handle_input (ACE_HANDLE fd)
+{
+  char c;
+  ssize_t const n = ACE::recv (fd, &c, 1);
+  if (n != 1)
+    return -1;
+
+  ++this->reads_;
+  return 0;
+}
+
+int
+Count_Handler::handle_close (ACE_HANDLE, ACE_Reactor_Mask)
+{
+  ++this->closes_;
+  return 0;
+}
+
+int
+Count_Handler::handle_exception (ACE_HANDLE)
+{
+  ++this->notifies_;
+  return 0;
+}
+
+static bool
+test_rearm (ACE_Reactor &reactor)
+{
+  Count_Handler handlers[pipe_count];
+  bool ok = true;
+
+  for (int i = 0; i < pipe_count; ++i)
+    {
+      if (handlers[i].pipe_.open () != 0
+          || reactor.register_handler (handlers[i].pipe_.read_handle (),
+                                       &handlers[i],
+                                       ACE_Event_Handler::READ_MASK) != 0)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("register")));
+          return false;
+        }
+    }
+
+  // Fill every pipe with one byte per expected upcall; each upcall
+  // consumes one byte, so each handle must be re-armed many times.
+  for (int w = 0; w < writes_per_pipe; ++w)
+    for (int i = 0; i < pipe_count; ++i)
+      if (ACE::send_n (handlers[i].pipe_.write_handle (), "x", 1) != 1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("send_n")));
+          ok = false;
+        }
+
+  for (int i = 0; i < pipe_count; ++i)
+    reactor.notify (&handlers[i]);
+
+  int const expected = pipe_count * (writes_per_pipe + 1);
+  int dispatched = 0;
+  while (dispatched < expected)
+    {
+      ACE_Time_Value tv (2);
+      int const n = reactor.handle_events (tv);
+      if (n <= 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("handle_events returned %d after %d of %d ")
+                      ACE_TEXT ("dispatches\n"),
+                      n, dispatched, expected));
+          ok = false;
+          break;
+        }
+      dispatched += n;
+    }
+
+  for (int i = 0; i < pipe_count; ++i)
+    {
+      if (handlers[i].reads_ != writes_per_pipe || handlers[i].notifies_ != 1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Handler %d: %d reads, %d notifies\n"),
+                      i, handlers[i].reads_, handlers[i].notifies_));
+          ok = false;
+        }
+
+      if (reactor.remove_handler (handlers[i].pipe_.read_handle (),
+                                  ACE_Event_Handler::READ_MASK) != 0
+          || handlers[i].closes_ != 1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("Handler %d: remove_handler failed\n"),
+                      i));
+          ok = false;
+        }
+    }
+
+  // Nothing is registered any more; writes must not be dispatched.
+  ACE::send_n (handlers[0].pipe_.write_handle (), "x", 1);
+  ACE_Time_Value tv (0, 100000);
+  if (reactor.handle_events (tv) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Event dispatched to removed handler\n")));
+      ok = false;
+    }
+
+  return ok;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Reactor_Test"));
+  int result = 0;
+
+  ACE_Uring_Reactor uring_reactor_impl;
+  if (!uring_reactor_impl.initialized ())
+    {
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%p; io_uring is not usable on this system\n"),
+                  ACE_TEXT ("ACE_Uring_Reactor")));
+      ACE_END_TEST;
+      return 0;
+    }
+
+  ACE_Reactor uring_reactor (&uring_reactor_impl);
+
+  if (!test_dispatch_order (uring_reactor))
+    ++result;
+
+  if (!test_rearm (uring_reactor))
+    ++result;
+
+  ACE_END_TEST;
+  return result;
+}
+#else
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Uring_Reactor_Test"));
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("ACE_Uring_Reactor is UNSUPPORTED on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+#endif /* ACE_HAS_IO_URING && ACE_HAS_EVENT_POLL */
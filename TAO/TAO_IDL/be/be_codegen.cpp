@@ -3015,6 +3015,12 @@ TAO_CodeGen::gen_var_file_includes ()
       this->client_header_
     );
 
+  this->gen_cond_file_include (
+      idl_global->aggregate_seen_ && be_global->cdr_support (),
+      "tao/CDR_Native_Layout_T.h",
+      this->client_header_
+    );
+
   this->gen_cond_file_include (
       idl_global->array_seen_,
       "tao/Array_VarOut_T.h",
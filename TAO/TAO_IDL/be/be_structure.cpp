@@ -13,6 +13,9 @@
 
 #include "be_structure.h"
 #include "be_field.h"
+#include "be_array.h"
+#include "be_typedef.h"
+#include "be_predefined_type.h"
 #include "be_codegen.h"
 #include "be_helper.h"
 #include "be_visitor.h"
@@ -144,6 +147,202 @@ be_structure::gen_ostream_operator (TAO_OutStream *os,
       << "}" << be_nl;
 }
 
+size_t
+be_structure::cdr_block_size (size_t &alignment)
+{
+  // be_exception is a subclass, exceptions are marshaled with
+  // their repository id.
+  if (this->node_type () != AST_Decl::NT_struct
+      || this->nfields () == 0)
+    {
+      return 0;
+    }
+
+  size_t size = 0;
+  size_t first_alignment = 1;
+  alignment = 1;
+
+  AST_Field **f = nullptr;
+  ACE_CDR::ULong const count = this->nfields ();
+
+  for (ACE_CDR::ULong i = 0; i < count; ++i)
+    {
+      this->field (f, i);
+
+      size_t member_size = 0;
+      size_t member_alignment = 1;
+      be_structure *nested = nullptr;
+
+      if (!be_structure::cdr_block ((*f)->field_type (),
+                                    member_size,
+                                    member_alignment,
+                                    nested))
+        {
+          return 0;
+        }
+
+      if (i == 0)
+        {
+          first_alignment = member_alignment;
+        }
+
+      size = (size + member_alignment - 1) & ~(member_alignment - 1);
+      size += member_size;
+
+      if (member_alignment > alignment)
+        {
+          alignment = member_alignment;
+        }
+    }
+
+  // CDR aligns the block to its first member, and a sequence puts
+  // the next element right after the last member.
+  if (first_alignment != alignment || size % alignment != 0)
+    {
+      return 0;
+    }
+
+  return size;
+}
+
+void
+be_structure::gen_cdr_native_layout (TAO_OutStream *os)
+{
+  size_t alignment = 1;
+  size_t const size = this->cdr_block_size (alignment);
+
+  if (size == 0)
+    {
+      return;
+    }
+
+  *os << be_nl
+      << "namespace TAO" << be_nl
+      << "{" << be_idt_nl
+      << "template<>" << be_nl
+      << "struct CDR_Native_Layout< ::" << this->name () << ">" << be_nl
+      << "{" << be_idt_nl
+      << "static constexpr size_t alignment = "
+      << static_cast<ACE_CDR::ULong> (alignment) << ";"
+      << be_nl
+      << "static constexpr bool value =" << be_idt_nl
+      << "sizeof (::" << this->name () << ") == "
+      << static_cast<ACE_CDR::ULong> (size);
+
+  size_t offset = 0;
+  AST_Field **f = nullptr;
+  ACE_CDR::ULong const count = this->nfields ();
+
+  for (ACE_CDR::ULong i = 0; i < count; ++i)
+    {
+      this->field (f, i);
+
+      size_t member_size = 0;
+      size_t member_alignment = 1;
+      be_structure *nested = nullptr;
+
+      be_structure::cdr_block ((*f)->field_type (),
+                               member_size,
+                               member_alignment,
+                               nested);
+
+      offset = (offset + member_alignment - 1) & ~(member_alignment - 1);
+
+      *os << be_nl
+          << "&& offsetof (::" << this->name () << ", "
+          << (*f)->local_name () << ") == "
+          << static_cast<ACE_CDR::ULong> (offset);
+
+      if (nested != nullptr)
+        {
+          *os << be_nl
+              << "&& CDR_Native_Layout< ::" << nested->name ()
+              << ">::value";
+        }
+
+      offset += member_size;
+    }
+
+  *os << ";" << be_uidt << be_uidt_nl
+      << "};" << be_uidt_nl
+      << "}" << be_nl;
+}
+
+bool
+be_structure::cdr_block (AST_Type *t,
+                         size_t &size,
+                         size_t &alignment,
+                         be_structure *&nested)
+{
+  if (t->node_type () == AST_Decl::NT_typedef)
+    {
+      t = dynamic_cast<AST_Typedef*> (t)->primitive_base_type ();
+    }
+
+  switch (t->node_type ())
+    {
+    case AST_Decl::NT_pre_defined:
+      // Chars and booleans may be translated or normalized, and the
+      // size of long double differs between platforms.
+      switch (dynamic_cast<AST_PredefinedType*> (t)->pt ())
+        {
+        case AST_PredefinedType::PT_octet:
+        case AST_PredefinedType::PT_int8:
+        case AST_PredefinedType::PT_uint8:
+          size = alignment = 1;
+          return true;
+        case AST_PredefinedType::PT_short:
+        case AST_PredefinedType::PT_ushort:
+          size = alignment = 2;
+          return true;
+        case AST_PredefinedType::PT_long:
+        case AST_PredefinedType::PT_ulong:
+        case AST_PredefinedType::PT_float:
+          size = alignment = 4;
+          return true;
+        case AST_PredefinedType::PT_longlong:
+        case AST_PredefinedType::PT_ulonglong:
+        case AST_PredefinedType::PT_double:
+          size = alignment = 8;
+          return true;
+        default:
+          return false;
+        }
+    case AST_Decl::NT_array:
+      {
+        AST_Array *array = dynamic_cast<AST_Array*> (t);
+
+        if (!be_structure::cdr_block (array->base_type (),
+                                      size,
+                                      alignment,
+                                      nested))
+          {
+            return false;
+          }
+
+        for (ACE_CDR::ULong i = 0; i < array->n_dims (); ++i)
+          {
+            AST_Expression::AST_ExprValue *ev = array->dims ()[i]->ev ();
+
+            if (ev == nullptr || ev->et != AST_Expression::EV_ulong)
+              {
+                return false;
+              }
+
+            size *= ev->u.ulval;
+          }
+
+        return true;
+      }
+    case AST_Decl::NT_struct:
+      nested = dynamic_cast<be_structure*> (t);
+      size = nested->cdr_block_size (alignment);
+      return size != 0;
+    default:
+      return false;
+    }
+}
+
 void
 be_structure::destroy ()
 {
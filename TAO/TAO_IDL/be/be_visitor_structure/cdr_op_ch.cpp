@@ -67,6 +67,17 @@ be_visitor_structure_cdr_op_ch::visit_structure (be_structure *node)
                         -1);
     }
 
+  // After the scope, the specialization uses those of the structs
+  // declared in it.
+  size_t alignment = 1;
+  if (node->cdr_block_size (alignment) != 0)
+    {
+      *os << be_global->core_versioning_begin () << be_nl;
+
+      node->gen_cdr_native_layout (os);
+
+      *os << be_global->core_versioning_end () << be_nl;
+    }
 
   node->cli_hdr_cdr_op_gen (true);
   return 0;
@@ -58,6 +58,20 @@ be_visitor_structure_cdr_op_cs::visit_structure (be_structure *node)
       << be_uidt_nl
       << "{" << be_idt_nl;
 
+  // Copy the struct as one block if its C++ layout is the CDR one.
+  size_t alignment = 1;
+  bool const native_layout = node->cdr_block_size (alignment) != 0;
+
+  if (native_layout)
+    {
+      *os << "if (TAO::is_native_layout< ::" << node->name ()
+          << "> (strm))" << be_idt_nl
+          << "{" << be_idt_nl
+          << "return TAO::write_native_layout (strm, &_tao_aggregate, 1);"
+          << be_uidt_nl
+          << "}" << be_uidt << be_nl_2;
+    }
+
   be_visitor_context new_ctx (*this->ctx_);
   be_visitor_cdr_op_field_decl field_decl (&new_ctx);
 
@@ -112,6 +126,16 @@ be_visitor_structure_cdr_op_cs::visit_structure (be_structure *node)
     }
   else
     {
+      if (native_layout)
+        {
+          *os << "if (TAO::is_native_layout< ::" << node->name ()
+              << "> (strm))" << be_idt_nl
+              << "{" << be_idt_nl
+              << "return TAO::read_native_layout (strm, &_tao_aggregate, 1);"
+              << be_uidt_nl
+              << "}" << be_uidt << be_nl_2;
+        }
+
       new_ctx.sub_state (TAO_CodeGen::TAO_CDR_INPUT);
 
       if (field_decl.visit_scope (node) == -1)
@@ -43,11 +43,32 @@ public:
   virtual void gen_ostream_operator (TAO_OutStream *os,
                                      bool use_underscore);
 
+  /// Size of the CDR encoding if it is one block that the C++ layout
+  /// may match: all members are octets, integers, floating point
+  /// numbers or arrays or structs of those, and CDR adds no padding
+  /// before the first member or after the last one.  Sets
+  /// @a alignment to the alignment of the block.  Returns 0 if the
+  /// struct has to be marshaled member by member.
+  size_t cdr_block_size (size_t &alignment);
+
+  /// Generate the TAO::CDR_Native_Layout specialization, which checks
+  /// the C++ layout against the CDR one.
+  void gen_cdr_native_layout (TAO_OutStream *os);
+
   /// Cleanup method.
   virtual void destroy ();
 
   /// Visiting.
   virtual int accept (be_visitor *visitor);
+
+private:
+  /// CDR size and alignment of a member of type @a t for
+  /// cdr_block_size(), false if it is not one block.  @a nested is
+  /// set to the struct the member holds, if any.
+  static bool cdr_block (AST_Type *t,
+                         size_t &size,
+                         size_t &alignment,
+                         be_structure *&nested);
 };
 
 #endif
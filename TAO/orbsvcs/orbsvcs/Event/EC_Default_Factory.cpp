@@ -2,6 +2,7 @@
 #include "orbsvcs/Event/EC_Default_Factory.h"
 #include "orbsvcs/Event/EC_Reactive_Dispatching.h"
 #include "orbsvcs/Event/EC_MT_Dispatching.h"
+#include "orbsvcs/Event/EC_Hashed_Dispatching.h"
 #include "orbsvcs/Event/EC_Basic_Filter_Builder.h"
 #include "orbsvcs/Event/EC_Prefix_Filter_Builder.h"
 #include "orbsvcs/Event/EC_ConsumerAdmin.h"
@@ -90,6 +91,8 @@ TAO_EC_Default_Factory::init (int argc, ACE_TCHAR* argv[])
                 this->dispatching_ = 0;
               else if (ACE_OS::strcasecmp (opt, ACE_TEXT("mt")) == 0)
                 this->dispatching_ = 1;
+              else if (ACE_OS::strcasecmp (opt, ACE_TEXT("hashed")) == 0)
+                this->dispatching_ = 3;
               else
                   this->unsupported_option_value (ACE_TEXT("-ECDispatching"), opt);
               arg_shifter.consume_arg ();
@@ -141,6 +144,22 @@ TAO_EC_Default_Factory::init (int argc, ACE_TCHAR* argv[])
             }
         }
 
+      else if (ACE_OS::strcasecmp (arg, ACE_TEXT("-ECDispatchingQueueSize")) == 0)
+        {
+          arg_shifter.consume_arg ();
+
+          if (arg_shifter.is_parameter_next ())
+            {
+              const ACE_TCHAR* opt = arg_shifter.get_current ();
+              int const size = ACE_OS::atoi (opt);
+              if (size < 0)
+                this->unsupported_option_value (ACE_TEXT("-ECDispatchingQueueSize"), opt);
+              else
+                this->dispatching_queue_size_ = size;
+              arg_shifter.consume_arg ();
+            }
+        }
+
       else if (ACE_OS::strcasecmp (arg, ACE_TEXT("-ECFiltering")) == 0)
         {
           arg_shifter.consume_arg ();
@@ -550,6 +569,18 @@ TAO_EC_Default_Factory::create_dispatching (TAO_EC_Event_Channel_Base *)
                                         this->dispatching_threads_force_active_,
                                         so);
     }
+  else if (this->dispatching_ == 3)
+    {
+      TAO_EC_Queue_Full_Service_Object* so =
+        this->find_service_object (this->queue_full_service_object_name_.fast_rep(),
+                                   TAO_EC_DEFAULT_QUEUE_FULL_SERVICE_OBJECT_NAME);
+      return new TAO_EC_Hashed_Dispatching (this->dispatching_threads_,
+                                            this->dispatching_threads_flags_,
+                                            this->dispatching_threads_priority_,
+                                            this->dispatching_threads_force_active_,
+                                            this->dispatching_queue_size_,
+                                            so);
+    }
   return nullptr;
 }
 
@@ -159,6 +159,7 @@ protected:
   int dispatching_threads_flags_; //! flags for thread creation; default: TAO_EC_DEFAULT_DISPATCHING_THREADS_FLAGS
   int dispatching_threads_priority_; //! dispatching thread priority; default: TAO_EC_DEFAULT_DISPATCHING_THREADS_PRIORITY
   int dispatching_threads_force_active_; //! create threads with innocuous default values if creation with requested values fails
+  int dispatching_queue_size_; //! events each hashed dispatching queue holds, 0 for the built-in limit; default: TAO_EC_DEFAULT_DISPATCHING_QUEUE_SIZE
   ACE_TString queue_full_service_object_name_; //! name of ACE_Service_Object which should be invoked when output queue becomes full
   TAO_EC_Queue_Full_Service_Object* find_service_object (const ACE_TCHAR* wanted,
                                                          const ACE_TCHAR* fallback);
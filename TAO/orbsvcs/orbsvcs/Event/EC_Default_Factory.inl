@@ -17,6 +17,7 @@ TAO_EC_Default_Factory::TAO_EC_Default_Factory ()
      dispatching_threads_flags_ (TAO_EC_DEFAULT_DISPATCHING_THREADS_FLAGS),
      dispatching_threads_priority_ (TAO_EC_DEFAULT_DISPATCHING_THREADS_PRIORITY),
      dispatching_threads_force_active_ (TAO_EC_DEFAULT_DISPATCHING_THREADS_FORCE_ACTIVE),
+     dispatching_queue_size_ (TAO_EC_DEFAULT_DISPATCHING_QUEUE_SIZE),
      queue_full_service_object_name_ (TAO_EC_DEFAULT_QUEUE_FULL_SERVICE_OBJECT_NAME),
      orbid_ (TAO_EC_DEFAULT_ORB_ID),
      consumer_control_ (TAO_EC_DEFAULT_CONSUMER_CONTROL),
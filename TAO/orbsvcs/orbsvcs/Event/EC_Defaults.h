@@ -101,6 +101,10 @@
 # define TAO_EC_DEFAULT_DISPATCHING_THREADS_FORCE_ACTIVE 1
 #endif /* TAO_EC_DEFAULT_DISPATCHING_THREADS_FORCE_ACTIVE */
 
+#ifndef TAO_EC_DEFAULT_DISPATCHING_QUEUE_SIZE
+# define TAO_EC_DEFAULT_DISPATCHING_QUEUE_SIZE 0 /* TAO_EC_QUEUE_HWM */
+#endif /* TAO_EC_DEFAULT_DISPATCHING_QUEUE_SIZE */
+
 #ifndef TAO_EC_DEFAULT_ORB_ID
 # define TAO_EC_DEFAULT_ORB_ID "" /* */
 #endif /* TAO_EC_DEFAULT_ORB_ID */
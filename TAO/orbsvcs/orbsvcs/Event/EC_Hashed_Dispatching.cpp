@@ -0,0 +1,126 @@
+#include "orbsvcs/Log_Macros.h"
+#include "orbsvcs/Event/EC_Hashed_Dispatching.h"
+
+#include "ace/Basic_Types.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_EC_Hashed_Dispatching::TAO_EC_Hashed_Dispatching (int nthreads,
+                                                      int thread_creation_flags,
+                                                      int thread_priority,
+                                                      int force_activate,
+                                                      size_t queue_size,
+                                                      TAO_EC_Queue_Full_Service_Object* service_object)
+  :  ntasks_ (nthreads > 0 ? nthreads : 1),
+     thread_creation_flags_ (thread_creation_flags),
+     thread_priority_ (thread_priority),
+     force_activate_ (force_activate),
+     tasks_ (nullptr),
+     active_ (false)
+{
+  ACE_NEW (this->tasks_, TAO_EC_Dispatching_Task*[this->ntasks_]);
+  for (int i = 0; i < this->ntasks_; ++i)
+    {
+      ACE_NEW (this->tasks_[i],
+               TAO_EC_Dispatching_Task (&this->thread_manager_,
+                                        service_object));
+      if (queue_size != 0)
+        {
+          ACE_Message_Queue<ACE_SYNCH> *queue = this->tasks_[i]->msg_queue ();
+          queue->high_water_mark (queue_size);
+          if (queue->low_water_mark () > queue_size)
+            queue->low_water_mark (queue_size);
+        }
+    }
+}
+
+TAO_EC_Hashed_Dispatching::~TAO_EC_Hashed_Dispatching ()
+{
+  for (int i = 0; i < this->ntasks_; ++i)
+    delete this->tasks_[i];
+  delete [] this->tasks_;
+}
+
+void
+TAO_EC_Hashed_Dispatching::activate ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  if (this->active_)
+    return;
+
+  this->active_ = true;
+
+  for (int i = 0; i < this->ntasks_; ++i)
+    {
+      if (this->tasks_[i]->activate (this->thread_creation_flags_,
+                                     1,
+                                     1,
+                                     this->thread_priority_) == -1)
+        {
+          if (this->force_activate_ != 0)
+            {
+              ORBSVCS_DEBUG ((LM_DEBUG,
+                          "EC (%P|%t) activating hashed dispatching queue %d at"
+                          " default priority\n",
+                          i));
+              if (this->tasks_[i]->activate (THR_BOUND, 1) == -1)
+                ORBSVCS_ERROR ((LM_ERROR,
+                            "EC (%P|%t) cannot activate hashed dispatching queue %d.\n",
+                            i));
+            }
+        }
+    }
+}
+
+void
+TAO_EC_Hashed_Dispatching::shutdown ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  if (!this->active_)
+    return;
+
+  for (int i = 0; i < this->ntasks_; ++i)
+    {
+      this->tasks_[i]->putq (new TAO_EC_Shutdown_Task_Command);
+    }
+  this->thread_manager_.wait ();
+}
+
+void
+TAO_EC_Hashed_Dispatching::push (TAO_EC_ProxyPushSupplier* proxy,
+                                 RtecEventComm::PushConsumer_ptr consumer,
+                                 const RtecEventComm::EventSet& event,
+                                 TAO_EC_QOS_Info& qos_info)
+{
+  RtecEventComm::EventSet event_copy = event;
+  this->push_nocopy (proxy, consumer, event_copy, qos_info);
+}
+
+void
+TAO_EC_Hashed_Dispatching::push_nocopy (TAO_EC_ProxyPushSupplier* proxy,
+                                        RtecEventComm::PushConsumer_ptr consumer,
+                                        RtecEventComm::EventSet& event,
+                                        TAO_EC_QOS_Info&)
+{
+  // Double checked locking....
+  if (!this->active_)
+    this->activate ();
+
+  this->task (proxy)->push (proxy, consumer, event);
+}
+
+TAO_EC_Dispatching_Task *
+TAO_EC_Hashed_Dispatching::task (TAO_EC_ProxyPushSupplier *proxy) const
+{
+  // The proxy stands for the consumer for as long as it is connected.
+  // The low bits of a heap address are always the same, so mix the
+  // rest before taking the modulo.
+  ACE_UINT64 hash = reinterpret_cast<uintptr_t> (proxy) >> 4;
+  hash *= ACE_UINT64_LITERAL (0x9E3779B97F4A7C15);
+  hash ^= hash >> 32;
+  return this->tasks_[hash % static_cast<ACE_UINT64> (this->ntasks_)];
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
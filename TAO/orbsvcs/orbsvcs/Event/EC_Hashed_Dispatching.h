@@ -0,0 +1,101 @@
+// -*- C++ -*-
+
+/**
+ *  @file   EC_Hashed_Dispatching.h
+ */
+
+#ifndef TAO_EC_HASHED_DISPATCHING_H
+#define TAO_EC_HASHED_DISPATCHING_H
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Event/EC_Dispatching.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Event/EC_Dispatching_Task.h"
+
+#include <atomic>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_EC_Hashed_Dispatching
+ *
+ * @brief Dispatching strategy that keeps the events of each consumer
+ *        in order.
+ *
+ * This strategy uses a fixed number of threads, each one servicing a
+ * queue of its own.  Each consumer is hashed onto one of the queues,
+ * so its events are pushed in the order they arrived, by a single
+ * thread, while different consumers are spread across the threads.
+ * Unlike the MT strategy the suppliers do not contend on a single
+ * queue, and unlike the TPC strategy the number of threads does not
+ * grow with the number of consumers.
+ */
+class TAO_RTEvent_Serv_Export TAO_EC_Hashed_Dispatching : public TAO_EC_Dispatching
+{
+public:
+  /// Constructor
+  /// It will create @a nthreads queues, each serviced by a thread.
+  /// If @a queue_size is not 0 each queue is full after that many
+  /// events, and @a queue_full_service_object decides whether to wait
+  /// or to discard the event.
+  TAO_EC_Hashed_Dispatching (int nthreads,
+                             int thread_creation_flags,
+                             int thread_priority,
+                             int force_activate,
+                             size_t queue_size,
+                             TAO_EC_Queue_Full_Service_Object* queue_full_service_object);
+
+  /// Destructor
+  virtual ~TAO_EC_Hashed_Dispatching ();
+
+  // = The EC_Dispatching methods.
+  virtual void activate ();
+  virtual void shutdown ();
+  virtual void push (TAO_EC_ProxyPushSupplier* proxy,
+                     RtecEventComm::PushConsumer_ptr consumer,
+                     const RtecEventComm::EventSet& event,
+                     TAO_EC_QOS_Info& qos_info);
+  virtual void push_nocopy (TAO_EC_ProxyPushSupplier* proxy,
+                            RtecEventComm::PushConsumer_ptr consumer,
+                            RtecEventComm::EventSet& event,
+                            TAO_EC_QOS_Info& qos_info);
+
+private:
+  /// The task that dispatches the events for @a proxy.
+  TAO_EC_Dispatching_Task *task (TAO_EC_ProxyPushSupplier *proxy) const;
+
+  /// Use our own thread manager.
+  ACE_Thread_Manager thread_manager_;
+
+  /// The number of tasks, each with one thread.
+  int ntasks_;
+
+  /// The flags (THR_BOUND, THR_NEW_LWP, etc.) used to create the
+  /// dispatching threads.
+  int thread_creation_flags_;
+
+  /// The priority of the dispatching threads.
+  int thread_priority_;
+
+  /// If activation at the requested priority fails then we fallback on
+  /// the defaults for thread activation.
+  int force_activate_;
+
+  /// The dispatching tasks
+  TAO_EC_Dispatching_Task **tasks_;
+
+  /// Synchronize access to internal data
+  TAO_SYNCH_MUTEX lock_;
+
+  /// Are the threads running?  Read without the lock on every push.
+  std::atomic<bool> active_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_EC_HASHED_DISPATCHING_H */
@@ -1,6 +1,5 @@
 #include "orbsvcs/Log/Hash_Iterator_i.h"
 #include "orbsvcs/Log/Log_Constraint_Interpreter.h"
-#include "orbsvcs/Log/Log_Constraint_Visitors.h"
 #include "orbsvcs/DsLogAdminC.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -68,11 +67,8 @@ TAO_Hash_Iterator_i::get (CORBA::ULong position, CORBA::ULong how_many)
        ((this->iter_ != this->iter_end_) && (count < how_many));
        ++this->iter_)
     {
-      // Use an evaluator.
-      TAO_Log_Constraint_Visitor visitor (this->iter_->item ());
-
       // Does it match the constraint?
-      if (interpreter.evaluate (visitor) == 1)
+      if (interpreter.evaluate (this->iter_->item ()) == 1)
         {
           if (++current_position >= position)
             {
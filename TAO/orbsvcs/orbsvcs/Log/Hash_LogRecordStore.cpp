@@ -4,7 +4,6 @@
 #include "orbsvcs/Log/Hash_LogRecordStore.h"
 #include "orbsvcs/Log/Hash_Iterator_i.h"
 #include "orbsvcs/Log/Log_Constraint_Interpreter.h"
-#include "orbsvcs/Log/Log_Constraint_Visitors.h"
 #include "orbsvcs/Time_Utilities.h"
 #include "tao/Utils/PolicyList_Destroyer.h"
 #include "tao/AnyTypeCode/Any_Unknown_IDL_Type.h"
@@ -279,11 +278,8 @@ TAO_Hash_LogRecordStore::set_records_attribute (
 
   for ( ; iter != iter_end; ++iter)
     {
-      // Use an evaluator.
-      TAO_Log_Constraint_Visitor evaluator (iter->item ());
-
       // Does it match the constraint?
-      if (interpreter.evaluate (evaluator) == 1)
+      if (interpreter.evaluate (iter->item ()) == 1)
         {
           set_record_attribute (iter->item ().id, attr_list);
           ++count;
@@ -369,11 +365,8 @@ TAO_Hash_LogRecordStore::query_i (const char *constraint,
 
   for ( ; ((iter != iter_end) && (count < how_many)); ++iter)
     {
-      // Use an evaluator.
-      TAO_Log_Constraint_Visitor evaluator (iter->item ());
-
       // Does it match the constraint?
-      if (interpreter.evaluate (evaluator) == 1)
+      if (interpreter.evaluate (iter->item ()) == 1)
         {
           if (TAO_debug_level > 0)
             {
@@ -478,11 +471,8 @@ TAO_Hash_LogRecordStore::match (const char* grammar,
 
   for ( ; iter != iter_end; ++iter)
     {
-      // Use an evaluator.
-      TAO_Log_Constraint_Visitor evaluator (iter->item ());
-
       // Does it match the constraint?
-      if (interpreter.evaluate (evaluator) == 1)
+      if (interpreter.evaluate (iter->item ()) == 1)
         {
           ++count;
         }
@@ -508,11 +498,8 @@ TAO_Hash_LogRecordStore::delete_records (const char *grammar,
 
   while (iter != iter_end)
     {
-      // Use an evaluator.
-      TAO_Log_Constraint_Visitor evaluator (iter->item ());
-
       // Does it match the constraint?
-      if (interpreter.evaluate (evaluator) == 1)
+      if (interpreter.evaluate (iter->item ()) == 1)
         {
           this->remove_i (iter++);
           ++count;
@@ -1,8 +1,124 @@
 #include "orbsvcs/Log/Log_Constraint_Interpreter.h"
 #include "orbsvcs/Log/Log_Constraint_Visitors.h"
+#include "ace/ETCL/ETCL_y.h"
+#include "ace/OS_NS_string.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+namespace
+{
+  /// The fields of a log record a compiled constraint reads.
+  enum Log_Record_Field
+  {
+    ID,
+    TIME,
+    INFO,
+    ATTRIBUTE
+  };
+
+  /**
+   * Names the fields as TAO_Log_Constraint_Visitor finds them: `id',
+   * `time' and `info', then the record's attributes.  The visitor
+   * reads `~' the other way round and `exist' as a lookup of the
+   * operand's value, so constraints using them are left to it.
+   */
+  class Log_Record_Resolver : public TAO_ETCL_Field_Resolver
+  {
+  public:
+    int resolve (ETCL_Constraint *node,
+                 bool,
+                 CORBA::ULong &kind,
+                 ACE_CString &name) override
+    {
+      const char *id = 0;
+      ETCL_Identifier *ident = dynamic_cast<ETCL_Identifier *> (node);
+      ETCL_Component *component = dynamic_cast<ETCL_Component *> (node);
+
+      if (ident != 0)
+        {
+          id = ident->value ();
+        }
+      else if (component != 0 && component->component () == 0)
+        {
+          id = component->identifier ()->value ();
+        }
+      else
+        {
+          return -1;
+        }
+
+      if (ACE_OS::strcmp (id, "id") == 0)
+        {
+          kind = ID;
+        }
+      else if (ACE_OS::strcmp (id, "time") == 0)
+        {
+          kind = TIME;
+        }
+      else if (ACE_OS::strcmp (id, "info") == 0)
+        {
+          kind = INFO;
+        }
+      else
+        {
+          kind = ATTRIBUTE;
+        }
+
+      name = id;
+      return 0;
+    }
+
+    bool supports (int op) const override
+    {
+      return op != ETCL_TWIDDLE && op != ETCL_EXIST;
+    }
+  };
+
+  /// A log record as the compiled constraint reads it.
+  class Log_Record : public TAO_ETCL_Record
+  {
+  public:
+    explicit Log_Record (const DsLogAdmin::LogRecord &rec)
+      : rec_ (rec)
+    {
+    }
+
+    int field (CORBA::ULong kind,
+               const char *name,
+               TAO_ETCL_Value &value) const override
+    {
+      switch (kind)
+        {
+        case ID:
+          value.set (static_cast<CORBA::ULong> (this->rec_.id));
+          return 0;
+        case TIME:
+          value.set (static_cast<CORBA::ULong> (this->rec_.time));
+          return 0;
+        case INFO:
+          return value.set (this->rec_.info);
+        default:
+          break;
+        }
+
+      CORBA::ULong const length = this->rec_.attr_list.length ();
+
+      for (CORBA::ULong i = 0; i < length; ++i)
+        {
+          if (ACE_OS::strcmp (this->rec_.attr_list[i].name.in (), name) == 0)
+            {
+              return value.set (this->rec_.attr_list[i].value);
+            }
+        }
+
+      return -1;
+    }
+
+  private:
+    const DsLogAdmin::LogRecord &rec_;
+  };
+}
+
 TAO_Log_Constraint_Interpreter::TAO_Log_Constraint_Interpreter (
     const char *constraints
   )
@@ -22,6 +138,9 @@ TAO_Log_Constraint_Interpreter::TAO_Log_Constraint_Interpreter (
           throw DsLogAdmin::InvalidConstraint ();
         }
     }
+
+  Log_Record_Resolver resolver;
+  this->program_.compile (this->root_, resolver);
 }
 
 TAO_Log_Constraint_Interpreter::~TAO_Log_Constraint_Interpreter ()
@@ -39,4 +158,17 @@ TAO_Log_Constraint_Interpreter::evaluate (
   return retval;
 }
 
+CORBA::Boolean
+TAO_Log_Constraint_Interpreter::evaluate (const DsLogAdmin::LogRecord &rec)
+{
+  if (this->program_.compiled ())
+    {
+      Log_Record const record (rec);
+      return this->program_.evaluate (record);
+    }
+
+  TAO_Log_Constraint_Visitor evaluator (rec);
+  return this->evaluate (evaluator);
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -21,6 +21,7 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "ace/ETCL/ETCL_Constraint.h"
+#include "tao/ETCL/TAO_ETCL_Program.h"
 #include "orbsvcs/DsLogAdminC.h"
 #include "orbsvcs/Log/log_serv_export.h"
 
@@ -51,6 +52,15 @@ public:
   /// Returns true if the constraint is evaluated successfully by
   /// the evaluator.
   CORBA::Boolean evaluate (TAO_Log_Constraint_Visitor &evaluator);
+
+  /// Returns true if @a rec satisfies the constraint, using the
+  /// compiled constraint when there is one and a visitor otherwise.
+  CORBA::Boolean evaluate (const DsLogAdmin::LogRecord &rec);
+
+private:
+  /// The constraint compiled, empty if it uses something that only
+  /// the visitor evaluates.
+  TAO_ETCL_Program program_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
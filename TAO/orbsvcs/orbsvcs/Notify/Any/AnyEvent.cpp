@@ -34,6 +34,12 @@ TAO_Notify_AnyEvent_No_Copy::convert (CosNotification::StructuredEvent& notifica
   TAO_Notify_Event::translate (*this->event_, notification);
 }
 
+const CORBA::Any*
+TAO_Notify_AnyEvent_No_Copy::any () const
+{
+  return this->event_;
+}
+
 CORBA::Boolean
 TAO_Notify_AnyEvent_No_Copy::do_match (CosNotifyFilter::Filter_ptr filter) const
 {
@@ -49,6 +49,9 @@ public:
   /// Convert to CosNotification::Structured type
   virtual void convert (CosNotification::StructuredEvent& notification) const;
 
+  /// The Any event.
+  virtual const CORBA::Any* any () const;
+
   /// Push event to consumer
   virtual void push (TAO_Notify_Consumer* consumer) const;
 
@@ -36,6 +36,8 @@ TAO_Notify_PushConsumer::init (CosEventComm::PushConsumer_ptr push_consumer)
       {
         this->push_consumer_ = CosEventComm::PushConsumer::_duplicate (push_consumer);
 
+        this->init_pipeline (push_consumer);
+
         this->publish_ =
           CosNotifyComm::NotifyPublish::_narrow (push_consumer);
       }
@@ -119,6 +121,30 @@ TAO_Notify_PushConsumer::push (const CosNotification::StructuredEvent& event)
   this->push_consumer_->push (any);
 }
 
+void
+TAO_Notify_PushConsumer::sendc (const TAO_Notify_Event* event,
+                                Notify_Pipeline::Consumer_ptr consumer,
+                                Notify_Pipeline::AMI_ConsumerHandler_ptr handler)
+{
+  last_ping_ = ACE_OS::gettimeofday ();
+
+  const CORBA::Any* payload = event->any ();
+
+  if (payload != 0)
+    {
+      consumer->sendc_push (handler, *payload);
+    }
+  else
+    {
+      CosNotification::StructuredEvent notification;
+      event->convert (notification);
+
+      CORBA::Any any;
+      TAO_Notify_Event::translate (notification, any);
+      consumer->sendc_push (handler, any);
+    }
+}
+
 /// Push a batch of events to this consumer.
 void
 TAO_Notify_PushConsumer::push (const CosNotification::EventBatch& event)
@@ -36,6 +36,7 @@ TAO_Notify_Consumer::TAO_Notify_Consumer (TAO_Notify_ProxySupplier* proxy)
 , max_batch_size_ (CosNotification::MaximumBatchSize, 0)
 , timer_id_ (-1)
 , timer_ (0)
+, sync_push_ (false)
 {
   Request_Queue* pending_events = 0;
   ACE_NEW (pending_events, TAO_Notify_Consumer::Request_Queue ());
@@ -162,6 +163,20 @@ TAO_Notify_Consumer::deliver (TAO_Notify_Method_Request_Event * request)
   // Increment reference counts (safely) to prevent this object and its proxy
   // from being deleted while the push is in progress.
   TAO_Notify_Proxy::Ptr proxy_guard (this->proxy ());
+
+  bool const pipelined = this->pipeline_.get () != 0;
+  if (pipelined && ! this->start_sync_push ())
+    {
+      // The consumer is behind, the pipeline sends the queue as fast
+      // as the replies allow, unless it's waiting for a retry.
+      this->enqueue_request (request);
+      if (! this->is_suspended_ && this->timer_id_ == -1)
+        {
+          this->dispatch_pending ();
+        }
+      return;
+    }
+
   bool queued = enqueue_if_necessary (request);
   if (!queued)
     {
@@ -223,6 +238,11 @@ TAO_Notify_Consumer::deliver (TAO_Notify_Method_Request_Event * request)
           }
         }
     }
+
+  if (pipelined)
+    {
+      this->end_sync_push ();
+    }
 }
 
 TAO_Notify_Consumer::DispatchStatus
@@ -239,6 +259,22 @@ TAO_Notify_Consumer::dispatch_request (TAO_Notify_Method_Request_Event * request
                     request->sequence ()
                     ));
     }
+  catch (const CORBA::Exception&)
+    {
+      result = this->exception_status (request);
+    }
+
+  return result;
+}
+
+TAO_Notify_Consumer::DispatchStatus
+TAO_Notify_Consumer::exception_status (TAO_Notify_Method_Request_Event * request)
+{
+  DispatchStatus result = DISPATCH_SUCCESS;
+  try
+    {
+      throw;
+    }
   catch (const CORBA::OBJECT_NOT_EXIST& ex)
     {
       if (DEBUG_LEVEL  > 0)
@@ -485,7 +521,9 @@ TAO_Notify_Consumer::dispatch_pending ()
   bool ok = true;
   while (ok
          && !this->proxy_supplier ()->has_shutdown ()
-         && !this->pending_events().is_empty ())
+         && !this->pending_events().is_empty ()
+         && (this->pipeline_.get () == 0
+             || (!this->sync_push_ && !this->pipeline_->full ())))
     {
       if (! dispatch_from_queue ( this->pending_events(), ace_mon))
         {
@@ -504,6 +542,11 @@ TAO_Notify_Consumer::dispatch_from_queue (
   ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon)
 {
 // FUZZ: enable check_for_ACE_Guard
+  if (this->pipeline_.get () != 0)
+    {
+      return this->dispatch_to_pipeline (requests, ace_mon);
+    }
+
   bool result = true;
   TAO_Notify_Method_Request_Event_Queueable * request = 0;
   if (requests.dequeue_head (request) == 0)
@@ -588,6 +631,268 @@ TAO_Notify_Consumer::dispatch_from_queue (
   return result;
 }
 
+void
+TAO_Notify_Consumer::init_pipeline (CORBA::Object_ptr consumer)
+{
+  TAO_Notify_Properties *properties = TAO_Notify_PROPERTIES::instance ();
+  CORBA::ULong const depth = properties->pipeline_depth ();
+
+  // The replies come to the ORB that sent the requests, which only
+  // the main ORB is sure to run.  Collocated consumers are pushed
+  // synchronously anyway.
+  if (depth == 0
+      || properties->separate_dispatching_orb ()
+      || CORBA::is_nil (consumer)
+      || consumer->_is_collocated ())
+    {
+      return;
+    }
+
+  PortableServer::POA_var poa = properties->default_poa ();
+
+  if (CORBA::is_nil (poa.in ()))
+    {
+      return;
+    }
+
+  TAO_Notify_Pipeline *pipeline = 0;
+  ACE_NEW_THROW_EX (pipeline,
+                    TAO_Notify_Pipeline (this, depth, poa.in ()),
+                    CORBA::NO_MEMORY ());
+  this->pipeline_.reset (pipeline);
+
+  this->pipeline_consumer_ =
+    Notify_Pipeline::Consumer::_unchecked_narrow (consumer);
+}
+
+void
+TAO_Notify_Consumer::sendc (const TAO_Notify_Event *,
+                            Notify_Pipeline::Consumer_ptr,
+                            Notify_Pipeline::AMI_ConsumerHandler_ptr)
+{
+  throw CORBA::NO_IMPLEMENT ();
+}
+
+bool
+TAO_Notify_Consumer::start_sync_push ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, *this->proxy_lock (), false);
+  if (this->sync_push_
+      || ! this->pending_events ().is_empty ()
+      || ! this->pipeline_->idle ())
+    {
+      return false;
+    }
+  this->sync_push_ = true;
+  return true;
+}
+
+void
+TAO_Notify_Consumer::end_sync_push ()
+{
+  bool pending = false;
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, *this->proxy_lock ());
+    this->sync_push_ = false;
+    pending = ! this->pending_events ().is_empty ();
+  }
+
+  if (pending && ! this->is_suspended_ && this->timer_id_ == -1)
+    {
+      this->dispatch_pending ();
+    }
+}
+
+// FUZZ: disable check_for_ACE_Guard
+bool
+TAO_Notify_Consumer::dispatch_to_pipeline (
+  Request_Queue & requests,
+  ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon)
+{
+// FUZZ: enable check_for_ACE_Guard
+  TAO_Notify_Method_Request_Event_Queueable * request = 0;
+  if (requests.dequeue_head (request) != 0)
+    {
+      return true;
+    }
+
+  TAO_Notify_Pipeline::Handler * handler = this->pipeline_->send (request);
+
+  ace_mon.release ();
+  DispatchStatus status = DISPATCH_SUCCESS;
+  try
+    {
+      this->sendc (request->event (),
+                   this->pipeline_consumer_.in (),
+                   handler->reference ());
+      if (DEBUG_LEVEL  > 8)
+        ORBSVCS_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("Consumer %d sent event %d.\n"),
+                    static_cast<int> (this->proxy ()->id ()),
+                    request->sequence ()
+                    ));
+    }
+  catch (const CORBA::Exception&)
+    {
+      status = this->exception_status (request);
+    }
+  ace_mon.acquire ();
+
+  if (status == DISPATCH_SUCCESS)
+    {
+      // In flight, the reply completes it.
+      return true;
+    }
+
+  // The request never left, nor will a reply come.
+  unsigned long order = 0;
+  this->pipeline_->reply (handler, order);
+  return this->pipeline_done (request, order, status, ace_mon);
+}
+
+void
+TAO_Notify_Consumer::pipeline_reply (TAO_Notify_Pipeline::Handler * handler,
+                                     Messaging::ExceptionHolder * excep_holder)
+{
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, *this->proxy_lock ());
+
+    unsigned long order = 0;
+    TAO_Notify_Method_Request_Event_Queueable * request =
+      this->pipeline_->reply (handler, order);
+
+    if (request == 0)
+      {
+        return;
+      }
+
+    DispatchStatus status = DISPATCH_SUCCESS;
+    if (excep_holder != 0)
+      {
+        ace_mon.release ();
+        try
+          {
+            excep_holder->raise_exception ();
+          }
+        catch (const CORBA::Exception&)
+          {
+            status = this->exception_status (request);
+          }
+        ace_mon.acquire ();
+      }
+
+    if (! this->pipeline_done (request, order, status, ace_mon))
+      {
+        this->schedule_timer (true);
+        return;
+      }
+  }
+
+  if (! this->is_suspended_ && this->timer_id_ == -1)
+    {
+      this->dispatch_pending ();
+    }
+}
+
+// FUZZ: disable check_for_ACE_Guard
+bool
+TAO_Notify_Consumer::pipeline_done (
+  TAO_Notify_Method_Request_Event_Queueable * request,
+  unsigned long order,
+  DispatchStatus status,
+  ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon)
+{
+// FUZZ: enable check_for_ACE_Guard
+  switch (status)
+    {
+    case DISPATCH_RETRY:
+      {
+        if (DEBUG_LEVEL  > 0)
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("(%P|%t) Consumer %d: Will retry %d\n"),
+                      static_cast<int> (this->proxy ()->id ()),
+                      request->sequence ()
+                      ));
+        // Sent again once the requests sent after it have their
+        // replies, so that the retries keep their order.
+        this->pipeline_->hold (request, order);
+        break;
+      }
+    case DISPATCH_FAIL_TIMEOUT:
+    case DISPATCH_FAIL:
+      {
+        if (DEBUG_LEVEL  > 0)
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("(%P|%t) Consumer %d: Failed. ")
+                      ACE_TEXT ("Discarding event %d.\n"),
+                      static_cast<int> (this->proxy ()->id ()),
+                      request->sequence ()
+                      ));
+        ace_mon.release ();
+        request->complete ();
+        request->release ();
+        ace_mon.acquire ();
+        while ((request = this->pipeline_->take_held ()) != 0)
+          {
+            ace_mon.release ();
+            request->complete ();
+            request->release ();
+            ace_mon.acquire ();
+          }
+        while (this->pending_events ().dequeue_head (request) == 0)
+          {
+            ace_mon.release ();
+            request->complete ();
+            request->release ();
+            ace_mon.acquire ();
+          }
+        ace_mon.release ();
+        try
+          {
+            this->proxy_supplier ()->destroy (status == DISPATCH_FAIL_TIMEOUT);
+          }
+        catch (const CORBA::Exception&)
+          {
+            // todo is there something reasonable to do here?
+          }
+        ace_mon.acquire ();
+        break;
+      }
+    case DISPATCH_DISCARD:
+      if (DEBUG_LEVEL  > 0)
+        ORBSVCS_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("(%P|%t) Consumer %d: Error during ")
+                    ACE_TEXT ("dispatch. Discarding event:%d.\n"),
+                    static_cast<int> (this->proxy ()->id ()),
+                    request->sequence ()
+                    ));
+      // Fall through
+    case DISPATCH_SUCCESS:
+      {
+        ace_mon.release ();
+        request->complete ();
+        request->release ();
+        ace_mon.acquire ();
+        break;
+      }
+    }
+
+  if (this->pipeline_->in_flight () != 0)
+    {
+      return true;
+    }
+
+  // The last reply is in, the held requests go back to the head of
+  // the queue, the first sent first, to be retried.
+  bool result = true;
+  while ((request = this->pipeline_->take_held ()) != 0)
+    {
+      this->pending_events ().enqueue_head (request);
+      result = false;
+    }
+  return result;
+}
+
 /// @todo: rather than is_error, use pacing interval so it will be configurable
 /// @todo: find some way to use batch buffering strategy for sequence consumers.
 void
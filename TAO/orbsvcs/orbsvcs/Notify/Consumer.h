@@ -22,6 +22,7 @@
 #include "orbsvcs/Notify/Peer.h"
 #include "orbsvcs/Notify/Event.h"
 #include "orbsvcs/Notify/Timer.h"
+#include "orbsvcs/Notify/Pipeline.h"
 #include "ace/Event_Handler.h"
 #include "ace/Atomic_Op.h"
 
@@ -120,6 +121,10 @@ typedef TAO_Notify_Refcountable_Guard_T< TAO_Notify_Consumer > Ptr;
   /// have not been passed to this consumer for delivery yet.
   size_t pending_count ();
 
+  /// Handle the reply to a request sent by the pipeline.
+  void pipeline_reply (TAO_Notify_Pipeline::Handler * handler,
+                       Messaging::ExceptionHolder * excep_holder);
+
 protected:
   /// This method is called by the is_alive() method.  It should provide
   /// the connected consumer or nil if there is none.
@@ -129,6 +134,17 @@ protected:
 
   DispatchStatus dispatch_request (TAO_Notify_Method_Request_Event * request);
 
+  /// Send the events to @a consumer with AMI if the -PipelineDepth
+  /// option asks for it.  Called by the derived classes that
+  /// implement sendc.
+  void init_pipeline (CORBA::Object_ptr consumer);
+
+  /// Push @a event to @a consumer with AMI, the reply going to
+  /// @a handler.
+  virtual void sendc (const TAO_Notify_Event * event,
+                      Notify_Pipeline::Consumer_ptr consumer,
+                      Notify_Pipeline::AMI_ConsumerHandler_ptr handler);
+
 // FUZZ: disable check_for_ACE_Guard
   /**
    * \brief Attempt to dispatch event from a queue.
@@ -153,6 +169,35 @@ protected:
   virtual bool enqueue_if_necessary(
     TAO_Notify_Method_Request_Event * request);
 
+  /// True if nothing is queued, in the pipeline nor being pushed, in
+  /// which case the caller pushes its event synchronously and then
+  /// calls end_sync_push.  Otherwise the consumer is behind and the
+  /// event goes through the pipeline.
+  bool start_sync_push ();
+
+  /// Send what was queued during the synchronous push.
+  void end_sync_push ();
+
+  /// Send the request at the head of the queue through the pipeline.
+  /// The same contract as dispatch_from_queue.
+  // FUZZ: disable check_for_ACE_Guard
+  bool dispatch_to_pipeline (
+    Request_Queue & requests,
+    ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon);
+
+  /// Act on the @a status of a request sent through the pipeline in
+  /// @a order, false if requests were put back in the queue to be
+  /// retried.
+  bool pipeline_done (
+    TAO_Notify_Method_Request_Event_Queueable * request,
+    unsigned long order,
+    DispatchStatus status,
+    ACE_Guard <TAO_SYNCH_MUTEX> & ace_mon);
+  // FUZZ: enable check_for_ACE_Guard
+
+  /// The status of the push that raised the exception being handled.
+  DispatchStatus exception_status (TAO_Notify_Method_Request_Event * request);
+
   // Dispatch updates
   virtual void dispatch_updates_i (const CosNotification::EventTypeSeq& added,
                                    const CosNotification::EventTypeSeq& removed);
@@ -205,6 +250,16 @@ private:
   /// Events pending to be delivered.
   ACE_Auto_Ptr<Request_Queue> pending_events_;
 
+  /// The requests sent with AMI, if pipelined.
+  ACE_Auto_Ptr<TAO_Notify_Pipeline> pipeline_;
+
+  /// The consumer, narrowed for the sendc_ operations.
+  Notify_Pipeline::Consumer_var pipeline_consumer_;
+
+  /// A synchronous push is in progress, the pipeline waits for it to
+  /// keep the events in order.
+  bool sync_push_;
+
   CORBA::Object_var rtt_obj_;
 };
 
@@ -219,6 +219,11 @@ TAO_CosNotify_Service::init (int argc, ACE_TCHAR *argv[])
         if (current_arg != 0)
           arg_shifter.consume_arg ();
       }
+      else if (0 != (current_arg = arg_shifter.get_the_parameter (ACE_TEXT("-PipelineDepth"))))
+        {
+          properties->pipeline_depth (ACE_OS::atoi (current_arg));
+          arg_shifter.consume_arg ();
+        }
       else
       {
         ORBSVCS_ERROR ((LM_ERROR,
@@ -78,6 +78,8 @@ TAO_Notify_Constraint_Expr::load_child (
     this->constr_expr.event_types[len].domain_name = CORBA::string_dup (domain);
     this->constr_expr.event_types[len].type_name = CORBA::string_dup (type);
 
+    // The filters are restored before the admins that add them, which
+    // is when the indexes are dropped.
     this->interpreter.build_tree (this->constr_expr);
   }
 
@@ -201,6 +203,8 @@ TAO_Notify_ETCL_Filter::add_constraint_i
     throw CORBA::INTERNAL ();
 
   auto_expr.release ();
+
+  this->drop_indexes ();
 }
 
 
@@ -326,6 +330,8 @@ TAO_Notify_ETCL_Filter::modify_constraints (
       delete constr_saved[index];
     }
 
+  this->drop_indexes ();
+
   this->self_change ();
 }
 
@@ -427,6 +433,8 @@ TAO_Notify_ETCL_Filter::remove_all_constraints_i ()
     }
 
   this->constraint_expr_list_.unbind_all ();
+
+  this->drop_indexes ();
 }
 
 void
@@ -462,11 +470,14 @@ TAO_Notify_ETCL_Filter::match_structured (
   CONSTRAINT_EXPR_LIST::ITERATOR iter (this->constraint_expr_list_);
   CONSTRAINT_EXPR_LIST::ENTRY *entry;
 
-  TAO_Notify_Constraint_Visitor visitor;
+  // Compiled constraints read the event in place, the visitor is
+  // only filled in for the first constraint that needs it.
+  std::unique_ptr <TAO_Notify_Constraint_Visitor> visitor;
 
-  if (visitor.bind_structured_event (filterable_data) != 0)
+  // The compiled constraints must not accept the events the visitor
+  // refuses to bind.
+  if (!TAO_Notify_Constraint_Interpreter::bindable (filterable_data))
     {
-      // Maybe throw some kind of exception here, or lower down,
       return 0;
     }
 
@@ -474,7 +485,35 @@ TAO_Notify_ETCL_Filter::match_structured (
     {
       if (iter.next (entry) != 0)
         {
-          if (entry->int_id_->interpreter.evaluate (visitor) == 1)
+          TAO_Notify_Constraint_Interpreter &interpreter =
+            entry->int_id_->interpreter;
+
+          if (interpreter.compiled ())
+            {
+              if (interpreter.evaluate (filterable_data) == 1)
+                {
+                  return 1;
+                }
+
+              continue;
+            }
+
+          if (visitor.get () == 0)
+            {
+              TAO_Notify_Constraint_Visitor *v = 0;
+              ACE_NEW_THROW_EX (v,
+                                TAO_Notify_Constraint_Visitor (),
+                                CORBA::NO_MEMORY ());
+              visitor.reset (v);
+
+              if (visitor->bind_structured_event (filterable_data) != 0)
+                {
+                  // Maybe throw some kind of exception here, or lower down,
+                  return 0;
+                }
+            }
+
+          if (interpreter.evaluate (*visitor) == 1)
             {
               return 1;
             }
@@ -484,6 +523,48 @@ TAO_Notify_ETCL_Filter::match_structured (
   return 0;
 }
 
+void
+TAO_Notify_ETCL_Filter::filter_key (TAO_Notify_Filter_Key &key)
+{
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::INTERNAL ());
+
+  // Without constraints the filter matches nothing.
+  key = TAO_Notify_Filter_Key (TAO_Notify_Filter_Key::NONE);
+
+  CONSTRAINT_EXPR_LIST::ITERATOR iter (this->constraint_expr_list_);
+  CONSTRAINT_EXPR_LIST::ENTRY *entry = 0;
+
+  for (; iter.next (entry) != 0; iter.advance ())
+    {
+      key.merge_or (entry->int_id_->interpreter.key ());
+    }
+}
+
+void
+TAO_Notify_ETCL_Filter::add_index (
+  const TAO_Notify_Filter_Index::Changes_Ptr &changes)
+{
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::INTERNAL ());
+
+  this->indexes_.insert (changes);
+}
+
+void
+TAO_Notify_ETCL_Filter::drop_indexes ()
+{
+  ACE_Unbounded_Set_Iterator<TAO_Notify_Filter_Index::Changes_Ptr>
+    iter (this->indexes_);
+
+  for (TAO_Notify_Filter_Index::Changes_Ptr *changes = 0;
+       iter.next (changes) != 0;
+       iter.advance ())
+    {
+      ++**changes;
+    }
+}
+
 CORBA::Boolean
 TAO_Notify_ETCL_Filter::match_typed (
                             const CosNotification::PropertySeq & /* filterable_data */)
@@ -90,6 +90,14 @@ public:
   TAO_Notify::Topology_Object* load_child (const ACE_CString &type,
     CORBA::Long id, const TAO_Notify::NVPList& attrs);
 
+  /// What the constraints require of the events the filter accepts,
+  /// for the TAO_Notify_Filter_Index.
+  void filter_key (TAO_Notify_Filter_Key &key);
+
+  /// Drop the indexes counted by @a changes whenever the constraints
+  /// change.  Called as the filter is added to a channel.
+  void add_index (const TAO_Notify_Filter_Index::Changes_Ptr &changes);
+
 protected:
   virtual char * constraint_grammar ();
 
@@ -131,6 +139,9 @@ private:
 
   void remove_all_constraints_i ();
 
+  /// Drop the indexes of the channels the filter was added to.
+  void drop_indexes ();
+
   /// Lock to serialize access to data members.
   TAO_SYNCH_MUTEX lock_;
 
@@ -150,6 +161,11 @@ private:
   TAO_Notify_Object::ID id_;
 
   ACE_CString grammar_;
+
+  /// The changes of the channels the filter was added to.  They are
+  /// kept until the filter goes away, at worst dropping the indexes
+  /// of a channel that no longer uses it.
+  ACE_Unbounded_Set<TAO_Notify_Filter_Index::Changes_Ptr> indexes_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -50,6 +50,19 @@ TAO_Notify_Event::translate (const CosNotification::StructuredEvent& notificatio
 {
   any <<= notification;   // is the typecode set by this operation or do we need to set it explicity.
 }
+
+const CosNotification::StructuredEvent*
+TAO_Notify_Event::structured () const
+{
+  return 0;
+}
+
+const CORBA::Any*
+TAO_Notify_Event::any () const
+{
+  return 0;
+}
+
 /// Unmarshal an event from a CDR. (for persistence)
 //static
 TAO_Notify_Event *
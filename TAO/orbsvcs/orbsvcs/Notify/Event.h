@@ -67,6 +67,12 @@ public:
   /// Convert to CosNotification::Structured type
   virtual void convert (CosNotification::StructuredEvent& notification) const = 0;
 
+  /// The structured event, or 0 if this is not one.
+  virtual const CosNotification::StructuredEvent* structured () const;
+
+  /// The Any event, or 0 if this is not one.
+  virtual const CORBA::Any* any () const;
+
   /// Push event to consumer
   virtual void push (TAO_Notify_Consumer* consumer) const = 0;
 
@@ -104,6 +104,7 @@ void
 TAO_Notify_Event_Manager::connect (TAO_Notify_ProxySupplier* proxy_supplier)
 {
   this->consumer_map().connect (proxy_supplier);
+  this->filter_index_.changed ();
 
   // Inform about offered types.
   TAO_Notify_EventTypeSeq removed;
@@ -114,6 +115,7 @@ void
 TAO_Notify_Event_Manager::disconnect (TAO_Notify_ProxySupplier* proxy_supplier)
 {
   this->consumer_map().disconnect (proxy_supplier);
+  this->filter_index_.changed ();
 }
 
 void
@@ -180,6 +182,8 @@ TAO_Notify_Event_Manager::subscribe (TAO_Notify_ProxySupplier* proxy_supplier, c
       if (result == 1)
         new_seq.insert (*event_type);
     }
+
+  this->filter_index_.changed ();
 }
 
 void
@@ -196,6 +200,8 @@ TAO_Notify_Event_Manager::un_subscribe (TAO_Notify_ProxySupplier* proxy_supplier
       if (result == 1)
         last_seq.insert (*event_type);
     }
+
+  this->filter_index_.changed ();
 }
 
 void
@@ -244,6 +250,12 @@ TAO_Notify_Event_Manager::supplier_map ()
   return *this->supplier_map_;
 }
 
+TAO_Notify_Filter_Index&
+TAO_Notify_Event_Manager::filter_index ()
+{
+  return this->filter_index_;
+}
+
 const TAO_Notify_EventTypeSeq&
 TAO_Notify_Event_Manager::offered_types () const
 {
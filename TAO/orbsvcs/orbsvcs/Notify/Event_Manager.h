@@ -12,6 +12,7 @@
 #include "ace/Auto_Ptr.h"
 
 #include "orbsvcs/Notify/Refcountable.h"
+#include "orbsvcs/Notify/Filter_Index.h"
 
 #include "orbsvcs/Notify/notify_serv_export.h"
 
@@ -84,6 +85,9 @@ public:
   TAO_Notify_Consumer_Map& consumer_map ();
   TAO_Notify_Supplier_Map& supplier_map ();
 
+  /// The index of the consumer map's proxies by their filters.
+  TAO_Notify_Filter_Index& filter_index ();
+
   /// Offer change received on <proxy_consumer>.
   void offer_change (TAO_Notify_ProxyConsumer* proxy_consumer, const TAO_Notify_EventTypeSeq& added, const TAO_Notify_EventTypeSeq& removed);
 
@@ -120,6 +124,9 @@ private:
 
   /// Supplier Map
   ACE_Auto_Ptr< TAO_Notify_Supplier_Map > supplier_map_;
+
+  /// Filter index of the consumer map.
+  TAO_Notify_Filter_Index filter_index_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -10,6 +10,9 @@
 #include "orbsvcs/Notify/Properties.h"
 #include "orbsvcs/Notify/EventChannelFactory.h"
 #include "orbsvcs/Notify/FilterFactory.h"
+#include "orbsvcs/Notify/ETCL_Filter.h"
+#include "orbsvcs/Notify/Filter_Index.h"
+#include "orbsvcs/Notify/Event_Manager.h"
 #include "ace/Bound_Ptr.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -41,8 +44,10 @@ TAO_Notify_FilterAdmin::add_filter (CosNotifyFilter::Filter_ptr new_filter)
 
   if (this->filter_list_.bind (new_id, new_filter_var) == -1)
       throw CORBA::INTERNAL ();
-  else
-    return new_id;
+
+  this->filters_changed (new_filter);
+
+  return new_id;
 }
 
 void
@@ -53,6 +58,8 @@ TAO_Notify_FilterAdmin::remove_filter (CosNotifyFilter::FilterID filter_id)
 
   if (this->filter_list_.unbind (filter_id) == -1)
     throw CosNotifyFilter::FilterNotFound ();
+
+  this->filters_changed ();
 }
 
 CosNotifyFilter::Filter_ptr
@@ -110,6 +117,42 @@ TAO_Notify_FilterAdmin::remove_all_filters ()
                       CORBA::INTERNAL ());
 
   this->filter_list_.unbind_all ();
+
+  this->filters_changed ();
+}
+
+void
+TAO_Notify_FilterAdmin::filter_key (TAO_Notify_Filter_Key &key)
+{
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::INTERNAL ());
+
+  // Without filters every event matches.
+  key = TAO_Notify_Filter_Key (TAO_Notify_Filter_Key::ALL);
+
+  if (this->filter_list_.current_size () == 0)
+    return;
+
+  TAO_Notify_Filter_Key filters (TAO_Notify_Filter_Key::NONE);
+
+  FILTER_LIST::ITERATOR iter (this->filter_list_);
+  FILTER_LIST::ENTRY *entry = 0;
+
+  for (; iter.next (entry) != 0; iter.advance ())
+    {
+      // Only the filters of this process can be looked into.
+      TAO_Notify_ETCL_Filter *filter =
+        dynamic_cast<TAO_Notify_ETCL_Filter *> (entry->int_id_->_servant ());
+
+      if (filter == 0)
+        return;
+
+      TAO_Notify_Filter_Key filter_key;
+      filter->filter_key (filter_key);
+      filters.merge_or (filter_key);
+    }
+
+  key = filters;
 }
 
 void
@@ -168,6 +211,8 @@ TAO_Notify_FilterAdmin::load_child (const ACE_CString &type, CORBA::Long id,
       this->filter_ids_.set_last_used(id);
       if (this->filter_list_.bind (id, filter) != 0)
         throw CORBA::INTERNAL ();
+
+      this->filters_changed (filter.in ());
     }
   }
   return this;
@@ -185,5 +230,25 @@ TAO_Notify_FilterAdmin::event_channel (TAO_Notify_EventChannel* ec)
   this->ec_.reset (ec);
 }
 
+void
+TAO_Notify_FilterAdmin::filters_changed (CosNotifyFilter::Filter_ptr filter)
+{
+  if (this->ec_.get () == 0)
+    return;
+
+  TAO_Notify_Filter_Index &index = this->ec_->event_manager ().filter_index ();
+
+  if (!CORBA::is_nil (filter))
+    {
+      TAO_Notify_ETCL_Filter *servant =
+        dynamic_cast<TAO_Notify_ETCL_Filter *> (filter->_servant ());
+
+      if (servant != 0)
+        servant->add_index (index.changes ());
+    }
+
+  index.changed ();
+}
+
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -28,6 +28,8 @@ class TAO_Notify_EventChannel;
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+class TAO_Notify_Filter_Key;
+
 /**
  * @class TAO_Notify_FilterAdmin
  *
@@ -61,6 +63,10 @@ class TAO_Notify_Serv_Export TAO_Notify_FilterAdmin
 
   virtual void remove_all_filters ();
 
+  /// What the filters require of the events they accept, for the
+  /// TAO_Notify_Filter_Index.
+  void filter_key (TAO_Notify_Filter_Key &key);
+
 
   // TAO_Notify::Topology_Object
 
@@ -75,6 +81,10 @@ class TAO_Notify_Serv_Export TAO_Notify_FilterAdmin
 
   virtual void release ();
 
+  /// Drop the filter indexes of the channel.  A local @a filter is
+  /// told to drop them too when its constraints change.
+  void filters_changed (CosNotifyFilter::Filter_ptr filter = CosNotifyFilter::Filter::_nil ());
+
   /// Mutex to serialize access to data members.
   TAO_SYNCH_MUTEX lock_;
 
@@ -0,0 +1,354 @@
+#include "orbsvcs/Notify/Filter_Index.h"
+#include "orbsvcs/Notify/Event.h"
+#include "orbsvcs/Notify/ProxySupplier.h"
+#include "orbsvcs/Notify/Notify_Constraint_Interpreter.h"
+#include "orbsvcs/ESF/ESF_Proxy_Collection.h"
+#include "orbsvcs/ESF/ESF_Worker.h"
+#include "ace/Vector_T.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Notify_Filter_Key::TAO_Notify_Filter_Key (State state)
+  : state_ (state),
+    kind_ (0)
+{
+}
+
+void
+TAO_Notify_Filter_Key::set (CORBA::ULong kind,
+                            const char *name,
+                            const char *value)
+{
+  this->state_ = KEYED;
+  this->kind_ = kind;
+  this->name_ = name;
+  this->values_.reset ();
+  this->values_.insert (ACE_CString (value));
+}
+
+void
+TAO_Notify_Filter_Key::merge_or (const TAO_Notify_Filter_Key &other)
+{
+  if (this->state_ == ALL || other.state_ == NONE)
+    {
+      return;
+    }
+
+  if (this->state_ == NONE || other.state_ == ALL)
+    {
+      *this = other;
+      return;
+    }
+
+  if (this->kind_ != other.kind_ || this->name_ != other.name_)
+    {
+      *this = TAO_Notify_Filter_Key (ALL);
+      return;
+    }
+
+  ACE_Unbounded_Set<ACE_CString>::const_iterator i (other.values_);
+
+  for (; !i.done (); i.advance ())
+    {
+      this->values_.insert (*i);
+    }
+}
+
+void
+TAO_Notify_Filter_Key::merge_and (const TAO_Notify_Filter_Key &other)
+{
+  if (this->state_ == ALL || other.state_ == NONE)
+    {
+      *this = other;
+    }
+}
+
+TAO_Notify_Filter_Key::State
+TAO_Notify_Filter_Key::state () const
+{
+  return this->state_;
+}
+
+CORBA::ULong
+TAO_Notify_Filter_Key::kind () const
+{
+  return this->kind_;
+}
+
+const ACE_CString &
+TAO_Notify_Filter_Key::name () const
+{
+  return this->name_;
+}
+
+const ACE_Unbounded_Set<ACE_CString> &
+TAO_Notify_Filter_Key::values () const
+{
+  return this->values_;
+}
+
+// ****************************************************************
+
+/**
+ * The proxies of one collection, indexed as the collection hands
+ * them to work().  They are held here until the index is dropped, so
+ * that it can be used without locking the collection.
+ */
+class TAO_Notify_Filter_Index::Proxies : public WORKER
+{
+public:
+  ~Proxies () override;
+
+  /// Index @a proxy by the key of its filters.
+  void work (TAO_Notify_ProxySupplier *proxy) override;
+
+  /// Call @a worker for the proxies that may accept @a event.
+  void for_each (const CosNotification::StructuredEvent &event,
+                 WORKER *worker);
+
+private:
+  typedef ACE_Vector<TAO_Notify_ProxySupplier *> PROXIES;
+
+  typedef ACE_Hash_Map_Manager_Ex<ACE_CString,
+                                  PROXIES,
+                                  ACE_Hash<ACE_CString>,
+                                  ACE_Equal_To<ACE_CString>,
+                                  ACE_Null_Mutex> VALUE_MAP;
+
+  /// The proxies keyed on one field.
+  struct Field
+  {
+    CORBA::ULong kind_;
+    ACE_CString name_;
+
+    /// The proxies by the value they require.
+    VALUE_MAP values_;
+
+    /// All of them, for events where the field isn't a string.
+    PROXIES all_;
+  };
+
+  static void dispatch (const PROXIES &proxies, WORKER *worker);
+
+  ACE_Vector<Field *> fields_;
+
+  /// The proxies that could not be keyed.
+  PROXIES unkeyed_;
+
+  ACE_Vector<TAO_Notify_ProxySupplier::Ptr> refs_;
+};
+
+TAO_Notify_Filter_Index::Proxies::~Proxies ()
+{
+  for (size_t i = 0; i < this->fields_.size (); ++i)
+    {
+      delete this->fields_[i];
+    }
+}
+
+void
+TAO_Notify_Filter_Index::Proxies::work (TAO_Notify_ProxySupplier *proxy)
+{
+  TAO_Notify_Filter_Key key;
+  proxy->filter_key (key);
+
+  if (key.state () == TAO_Notify_Filter_Key::NONE)
+    {
+      return;
+    }
+
+  this->refs_.push_back (TAO_Notify_ProxySupplier::Ptr (proxy));
+
+  if (key.state () == TAO_Notify_Filter_Key::ALL)
+    {
+      this->unkeyed_.push_back (proxy);
+      return;
+    }
+
+  Field *field = 0;
+
+  for (size_t i = 0; i < this->fields_.size (); ++i)
+    {
+      if (this->fields_[i]->kind_ == key.kind ()
+          && this->fields_[i]->name_ == key.name ())
+        {
+          field = this->fields_[i];
+          break;
+        }
+    }
+
+  if (field == 0)
+    {
+      ACE_NEW_THROW_EX (field,
+                        Field,
+                        CORBA::NO_MEMORY ());
+      field->kind_ = key.kind ();
+      field->name_ = key.name ();
+      this->fields_.push_back (field);
+    }
+
+  field->all_.push_back (proxy);
+
+  ACE_Unbounded_Set<ACE_CString>::const_iterator i (key.values ());
+
+  for (; !i.done (); i.advance ())
+    {
+      VALUE_MAP::ENTRY *entry = 0;
+
+      if (field->values_.find (*i, entry) != 0
+          && field->values_.bind (*i, PROXIES (), entry) != 0)
+        {
+          throw CORBA::NO_MEMORY ();
+        }
+
+      entry->int_id_.push_back (proxy);
+    }
+}
+
+void
+TAO_Notify_Filter_Index::Proxies::for_each (
+    const CosNotification::StructuredEvent &event,
+    WORKER *worker)
+{
+  for (size_t i = 0; i < this->fields_.size (); ++i)
+    {
+      Field *field = this->fields_[i];
+      TAO_ETCL_Value value;
+
+      // Without the field none of the constraints holds.
+      if (TAO_Notify_Constraint_Interpreter::field (event,
+                                                    field->kind_,
+                                                    field->name_.c_str (),
+                                                    value) != 0)
+        {
+          continue;
+        }
+
+      const char *str = value.to_string ();
+
+      if (str == 0)
+        {
+          // The constraints may convert other types, don't guess.
+          dispatch (field->all_, worker);
+          continue;
+        }
+
+      VALUE_MAP::ENTRY *entry = 0;
+
+      if (field->values_.find (ACE_CString (str, 0, false), entry) == 0)
+        {
+          dispatch (entry->int_id_, worker);
+        }
+    }
+
+  dispatch (this->unkeyed_, worker);
+}
+
+void
+TAO_Notify_Filter_Index::Proxies::dispatch (const PROXIES &proxies,
+                                        WORKER *worker)
+{
+  for (size_t i = 0; i < proxies.size (); ++i)
+    {
+      worker->work (proxies[i]);
+    }
+}
+
+// ****************************************************************
+
+TAO_Notify_Filter_Index::TAO_Notify_Filter_Index ()
+  : generation_ (0)
+{
+  CHANGES *changes = 0;
+  ACE_NEW_THROW_EX (changes,
+                    CHANGES (0),
+                    CORBA::NO_MEMORY ());
+  this->changes_ = Changes_Ptr (changes);
+}
+
+TAO_Notify_Filter_Index::~TAO_Notify_Filter_Index ()
+{
+}
+
+void
+TAO_Notify_Filter_Index::changed ()
+{
+  ++*this->changes_;
+}
+
+TAO_Notify_Filter_Index::Changes_Ptr
+TAO_Notify_Filter_Index::changes () const
+{
+  return this->changes_;
+}
+
+void
+TAO_Notify_Filter_Index::for_each (COLLECTION *collection,
+                                   const TAO_Notify_Event *event,
+                                   WORKER *worker)
+{
+  const CosNotification::StructuredEvent *notification =
+    event->structured ();
+
+  if (notification == 0)
+    {
+      collection->for_each (worker);
+      return;
+    }
+
+  Proxies_Ptr proxies = this->find (collection);
+
+  if (proxies.null ())
+    {
+      collection->for_each (worker);
+      return;
+    }
+
+  proxies->for_each (*notification, worker);
+}
+
+TAO_Notify_Filter_Index::Proxies_Ptr
+TAO_Notify_Filter_Index::find (COLLECTION *collection)
+{
+  // The proxies of dropped indexes are released after the lock.
+  ACE_Vector<Proxies_Ptr> dropped;
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, Proxies_Ptr ());
+
+  unsigned long const generation = this->changes_->value ();
+
+  if (generation != this->generation_)
+    {
+      INDEX_MAP::ITERATOR iter (this->indexes_);
+
+      for (INDEX_MAP::ENTRY *entry = 0; iter.next (entry) != 0; iter.advance ())
+        {
+          dropped.push_back (entry->int_id_);
+        }
+
+      this->indexes_.unbind_all ();
+      this->generation_ = generation;
+    }
+
+  Proxies_Ptr proxies;
+
+  if (this->indexes_.find (collection, proxies) == 0)
+    {
+      return proxies;
+    }
+
+  Proxies *index = 0;
+  ACE_NEW_THROW_EX (index,
+                    Proxies,
+                    CORBA::NO_MEMORY ());
+  proxies = Proxies_Ptr (index);
+
+  collection->for_each (index);
+
+  // Unindexed, the next event builds it again.
+  this->indexes_.bind (collection, proxies);
+
+  return proxies;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,145 @@
+// -*- C++ -*-
+/**
+ *  @file Filter_Index.h
+ *
+ *  Index of the proxy suppliers by the values their filters require.
+ */
+
+#ifndef TAO_Notify_FILTER_INDEX_H
+#define TAO_Notify_FILTER_INDEX_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Notify/notify_serv_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Atomic_Op.h"
+#include "ace/Bound_Ptr.h"
+#include "ace/Containers_T.h"
+#include "ace/Hash_Map_Manager.h"
+#include "ace/Null_Mutex.h"
+#include "ace/SString.h"
+#include "tao/Basic_Types.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Notify_Event;
+class TAO_Notify_ProxySupplier;
+template <class PROXY> class TAO_ESF_Proxy_Collection;
+template <class Object> class TAO_ESF_Worker;
+
+/**
+ * @class TAO_Notify_Filter_Key
+ *
+ * @brief What a filter requires of the events it accepts.
+ *
+ * A keyed filter only accepts structured events whose field, named
+ * as by TAO_Notify_Constraint_Interpreter, is a string equal to one
+ * of the values.  NONE accepts no events, ALL may accept any.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Filter_Key
+{
+public:
+  enum State
+  {
+    NONE,
+    KEYED,
+    ALL
+  };
+
+  explicit TAO_Notify_Filter_Key (State state = ALL);
+
+  /// Require the field named by @a kind and @a name to be @a value.
+  void set (CORBA::ULong kind, const char *name, const char *value);
+
+  /// Accept the events either key accepts.  Keys on different fields
+  /// become ALL.
+  void merge_or (const TAO_Notify_Filter_Key &other);
+
+  /// Accept only the events both keys accept.  One key is kept, this
+  /// one unless @a other is narrower because this is ALL or @a other
+  /// is NONE.
+  void merge_and (const TAO_Notify_Filter_Key &other);
+
+  State state () const;
+  CORBA::ULong kind () const;
+  const ACE_CString &name () const;
+  const ACE_Unbounded_Set<ACE_CString> &values () const;
+
+private:
+  State state_;
+  CORBA::ULong kind_;
+  ACE_CString name_;
+  ACE_Unbounded_Set<ACE_CString> values_;
+};
+
+/**
+ * @class TAO_Notify_Filter_Index
+ *
+ * @brief Finds the proxy suppliers whose filters may accept an event.
+ *
+ * The proxy suppliers of each collection of the consumer map are
+ * indexed by the key of their filters, so that a structured event is
+ * only handed to the proxies keyed on one of its values, and to those
+ * that could not be keyed.  The indexes are built when first used and
+ * dropped whenever a filter, a filter admin or a subscription of the
+ * channel changes.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Filter_Index
+{
+public:
+  typedef TAO_ESF_Proxy_Collection<TAO_Notify_ProxySupplier> COLLECTION;
+  typedef TAO_ESF_Worker<TAO_Notify_ProxySupplier> WORKER;
+
+  /// Counts the changes of the channel.  The local filters added to
+  /// its proxies and admins share it, as they do not know the channel.
+  typedef ACE_Atomic_Op<TAO_SYNCH_MUTEX, unsigned long> CHANGES;
+  typedef ACE_Strong_Bound_Ptr<CHANGES, TAO_SYNCH_MUTEX> Changes_Ptr;
+
+  TAO_Notify_Filter_Index ();
+  ~TAO_Notify_Filter_Index ();
+
+  /// Call @a worker for the proxies of @a collection that may accept
+  /// @a event, or for all of them if @a event is not structured.
+  void for_each (COLLECTION *collection,
+                 const TAO_Notify_Event *event,
+                 WORKER *worker);
+
+  /// Drop the indexes, a filter or the proxies of a collection have
+  /// changed.
+  void changed ();
+
+  /// The counter changed() increments.
+  Changes_Ptr changes () const;
+
+private:
+  class Proxies;
+  typedef ACE_Strong_Bound_Ptr<Proxies, TAO_SYNCH_MUTEX> Proxies_Ptr;
+
+  /// The index of @a collection, built if there is none.
+  Proxies_Ptr find (COLLECTION *collection);
+
+  typedef ACE_Hash_Map_Manager_Ex<COLLECTION *,
+                                  Proxies_Ptr,
+                                  ACE_Pointer_Hash<COLLECTION *>,
+                                  ACE_Equal_To<COLLECTION *>,
+                                  ACE_Null_Mutex> INDEX_MAP;
+
+  TAO_SYNCH_MUTEX lock_;
+
+  /// The value of changes_ the indexes were built at.
+  unsigned long generation_;
+
+  INDEX_MAP indexes_;
+
+  Changes_Ptr changes_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_Notify_FILTER_INDEX_H */
@@ -75,7 +75,11 @@ int TAO_Notify_Method_Request_Lookup::execute_i ()
     return 0;
 
   // The map of subscriptions.
-  TAO_Notify_Consumer_Map& map = this->proxy_consumer_->event_manager ().consumer_map ();
+  TAO_Notify_Event_Manager& event_manager = this->proxy_consumer_->event_manager ();
+  TAO_Notify_Consumer_Map& map = event_manager.consumer_map ();
+
+  // Only the consumers whose filters may accept the event.
+  TAO_Notify_Filter_Index& index = event_manager.filter_index ();
 
   TAO_Notify_Consumer_Map::ENTRY* entry = map.find (this->event_->type ());
 
@@ -87,7 +91,7 @@ int TAO_Notify_Method_Request_Lookup::execute_i ()
 
     if (consumers != 0)
       {
-        consumers->for_each (this);
+        index.for_each (consumers, this->event_, this);
       }
 
     map.release (entry);
@@ -98,7 +102,7 @@ int TAO_Notify_Method_Request_Lookup::execute_i ()
 
   if (consumers != 0)
     {
-      consumers->for_each (this);
+      index.for_each (consumers, this->event_, this);
     }
   this->complete ();
   return 0;
@@ -3,9 +3,381 @@
 #include "orbsvcs/Notify/Notify_Constraint_Visitors.h"
 #include "orbsvcs/Notify/EventType.h"
 #include "tao/debug.h"
+#include "ace/ETCL/ETCL_Constraint.h"
+#include "ace/ETCL/ETCL_y.h"
+#include "ace/OS_NS_string.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+namespace
+{
+  /// The fields of a structured event a compiled constraint reads.
+  enum Structured_Event_Field
+  {
+    FILTERABLE_DATA,
+    VARIABLE_HEADER,
+    DOMAIN_NAME,
+    TYPE_NAME,
+    EVENT_NAME,
+    REMAINDER_OF_BODY,
+    HEADER,
+    FIXED_HEADER,
+    EVENT_TYPE,
+    EMPTY
+  };
+
+  /**
+   * Names the fields as TAO_Notify_Constraint_Visitor finds them: a
+   * bare or `$' name is a filterable_data property, `$.domain_name'
+   * and the other fixed header names may be reached through the
+   * enclosing implicit ids, and `(name)' looks up filterable_data or
+   * variable_header.  Nested values are left to the visitor.
+   */
+  class Structured_Event_Resolver : public TAO_ETCL_Field_Resolver
+  {
+  public:
+    int resolve (ETCL_Constraint *node,
+                 bool exist,
+                 CORBA::ULong &kind,
+                 ACE_CString &name) override
+    {
+      ETCL_Identifier *ident = dynamic_cast<ETCL_Identifier *> (node);
+
+      if (ident != 0)
+        {
+          kind = FILTERABLE_DATA;
+          name = ident->value ();
+          return 0;
+        }
+
+      return this->resolve (node, EMPTY, exist, kind, name);
+    }
+
+  private:
+    static Structured_Event_Field implicit_id (const char *name)
+    {
+      static const struct
+      {
+        const char *name_;
+        Structured_Event_Field field_;
+      } ids[] =
+        {
+          { "filterable_data", FILTERABLE_DATA },
+          { "header", HEADER },
+          { "remainder_of_body", REMAINDER_OF_BODY },
+          { "fixed_header", FIXED_HEADER },
+          { "variable_header", VARIABLE_HEADER },
+          { "event_name", EVENT_NAME },
+          { "event_type", EVENT_TYPE },
+          { "domain_name", DOMAIN_NAME },
+          { "type_name", TYPE_NAME }
+        };
+
+      for (size_t i = 0; i < sizeof ids / sizeof ids[0]; ++i)
+        {
+          if (ACE_OS::strcmp (name, ids[i].name_) == 0)
+            {
+              return ids[i].field_;
+            }
+        }
+
+      return EMPTY;
+    }
+
+    int resolve (ETCL_Constraint *node,
+                 Structured_Event_Field implicit,
+                 bool exist,
+                 CORBA::ULong &kind,
+                 ACE_CString &name)
+    {
+      ETCL_Dot *dot = dynamic_cast<ETCL_Dot *> (node);
+
+      if (dot != 0)
+        {
+          return this->resolve (dot->component (), implicit, exist, kind, name);
+        }
+
+      ETCL_Component_Assoc *assoc =
+        dynamic_cast<ETCL_Component_Assoc *> (node);
+
+      if (assoc != 0)
+        {
+          if (assoc->component () != 0
+              || (implicit != FILTERABLE_DATA && implicit != VARIABLE_HEADER))
+            {
+              return -1;
+            }
+
+          kind = implicit;
+          name = assoc->identifier ()->value ();
+          return 0;
+        }
+
+      ETCL_Component *component = dynamic_cast<ETCL_Component *> (node);
+
+      if (component == 0)
+        {
+          return -1;
+        }
+
+      const char *id = component->identifier ()->value ();
+      ETCL_Constraint *nested = component->component ();
+      Structured_Event_Field const field = implicit_id (id);
+
+      if (field == EMPTY)
+        {
+          // The visitor can't tell whether `exist $name' holds.
+          if (nested != 0 || exist)
+            {
+              return -1;
+            }
+
+          kind = FILTERABLE_DATA;
+          name = id;
+          return 0;
+        }
+
+      if (nested != 0)
+        {
+          return this->resolve (nested, field, exist, kind, name);
+        }
+
+      switch (field)
+        {
+        case DOMAIN_NAME:
+        case TYPE_NAME:
+        case EVENT_NAME:
+          break;
+        case REMAINDER_OF_BODY:
+          if (exist)
+            {
+              return -1;
+            }
+          break;
+        default:
+          return -1;
+        }
+
+      kind = field;
+      name.clear ();
+      return 0;
+    }
+  };
+
+  /// A structured event as the compiled constraint reads it.
+  class Structured_Event_Record : public TAO_ETCL_Record
+  {
+  public:
+    explicit Structured_Event_Record (
+        const CosNotification::StructuredEvent &event)
+      : event_ (event)
+    {
+    }
+
+    int field (CORBA::ULong kind,
+               const char *name,
+               TAO_ETCL_Value &value) const override
+    {
+      switch (kind)
+        {
+        case FILTERABLE_DATA:
+          return find (this->event_.filterable_data, name, value);
+        case VARIABLE_HEADER:
+          return find (this->event_.header.variable_header, name, value);
+        case DOMAIN_NAME:
+          value.set (
+            this->event_.header.fixed_header.event_type.domain_name.in ());
+          return 0;
+        case TYPE_NAME:
+          value.set (
+            this->event_.header.fixed_header.event_type.type_name.in ());
+          return 0;
+        case EVENT_NAME:
+          value.set (this->event_.header.fixed_header.event_name.in ());
+          return 0;
+        case REMAINDER_OF_BODY:
+          return value.set (this->event_.remainder_of_body);
+        default:
+          return -1;
+        }
+    }
+
+  private:
+    /// The property sequences are short, so a scan is cheaper than
+    /// the hash maps the visitor fills for every event.
+    static int find (const CosNotification::PropertySeq &properties,
+                     const char *name,
+                     TAO_ETCL_Value &value)
+    {
+      CORBA::ULong const length = properties.length ();
+
+      for (CORBA::ULong i = 0; i < length; ++i)
+        {
+          if (ACE_OS::strcmp (properties[i].name.in (), name) == 0)
+            {
+              return value.set (properties[i].value);
+            }
+        }
+
+      return -1;
+    }
+
+    const CosNotification::StructuredEvent &event_;
+  };
+
+  /// True if two of @a properties have the same name.
+  bool
+  duplicate_names (const CosNotification::PropertySeq &properties)
+  {
+    CORBA::ULong const length = properties.length ();
+
+    for (CORBA::ULong i = 1; i < length; ++i)
+      {
+        for (CORBA::ULong j = 0; j < i; ++j)
+          {
+            if (ACE_OS::strcmp (properties[i].name.in (),
+                                properties[j].name.in ()) == 0)
+              {
+                return true;
+              }
+          }
+      }
+
+    return false;
+  }
+
+  /**
+   * Finds the key of a constraint: the string values one field must
+   * take for the constraint to hold, from the `==' comparisons it
+   * can't hold without.
+   */
+  class Structured_Event_Key_Finder : private ETCL_Constraint
+  {
+  public:
+    explicit Structured_Event_Key_Finder (Structured_Event_Resolver &resolver)
+      : resolver_ (resolver)
+    {
+    }
+
+    TAO_Notify_Filter_Key key (ETCL_Constraint *node)
+    {
+      ETCL_Binary_Expr *binary = dynamic_cast<ETCL_Binary_Expr *> (node);
+
+      if (binary == 0)
+        {
+          return TAO_Notify_Filter_Key ();
+        }
+
+      switch (binary->type ())
+        {
+        case ETCL_AND:
+          {
+            TAO_Notify_Filter_Key lhs = this->key (binary->lhs ());
+            TAO_Notify_Filter_Key rhs = this->key (binary->rhs ());
+
+            if (better (rhs, lhs))
+              {
+                rhs.merge_and (lhs);
+                return rhs;
+              }
+
+            lhs.merge_and (rhs);
+            return lhs;
+          }
+        case ETCL_OR:
+          {
+            TAO_Notify_Filter_Key lhs = this->key (binary->lhs ());
+            lhs.merge_or (this->key (binary->rhs ()));
+            return lhs;
+          }
+        case ETCL_EQ:
+          {
+            TAO_Notify_Filter_Key key;
+
+            if (this->equal (binary->lhs (), binary->rhs (), key) != 0)
+              {
+                this->equal (binary->rhs (), binary->lhs (), key);
+              }
+
+            return key;
+          }
+        default:
+          return TAO_Notify_Filter_Key ();
+        }
+    }
+
+  private:
+    /// Key @a key on @a field being the string @a literal.
+    int equal (ETCL_Constraint *field,
+               ETCL_Constraint *literal,
+               TAO_Notify_Filter_Key &key)
+    {
+      ETCL_Literal_Constraint *str =
+        dynamic_cast<ETCL_Literal_Constraint *> (literal);
+
+      if (str == 0 || str->expr_type () != ACE_ETCL_STRING)
+        {
+          return -1;
+        }
+
+      ETCL_Eval *eval = dynamic_cast<ETCL_Eval *> (field);
+      ETCL_Constraint *node =
+        (eval != 0) ? eval->component () : dynamic_cast<ETCL_Identifier *> (field);
+
+      CORBA::ULong kind = 0;
+      ACE_CString name;
+
+      if (node == 0 || this->resolver_.resolve (node, false, kind, name) != 0)
+        {
+          return -1;
+        }
+
+      key.set (kind, name.c_str (), (const char *) *str);
+      return 0;
+    }
+
+    /// True if @a a, rather than @a b, is the key to keep of an
+    /// `and' of both.  The type name comes first, as it is what most
+    /// often tells the consumers of a channel apart.
+    static bool better (const TAO_Notify_Filter_Key &a,
+                        const TAO_Notify_Filter_Key &b)
+    {
+      if (a.state () != TAO_Notify_Filter_Key::KEYED
+          || b.state () != TAO_Notify_Filter_Key::KEYED)
+        {
+          return false;
+        }
+
+      if (rank (a.kind ()) != rank (b.kind ()))
+        {
+          return rank (a.kind ()) < rank (b.kind ());
+        }
+
+      return a.values ().size () < b.values ().size ();
+    }
+
+    static int rank (CORBA::ULong kind)
+    {
+      switch (kind)
+        {
+        case TYPE_NAME:
+          return 0;
+        case FILTERABLE_DATA:
+        case VARIABLE_HEADER:
+          return 1;
+        case EVENT_NAME:
+          return 2;
+        case DOMAIN_NAME:
+          return 3;
+        default:
+          return 4;
+        }
+    }
+
+    Structured_Event_Resolver &resolver_;
+  };
+}
+
 TAO_Notify_Constraint_Interpreter::TAO_Notify_Constraint_Interpreter ()
 {
 }
@@ -33,6 +405,20 @@ TAO_Notify_Constraint_Interpreter::build_tree (
           throw CosNotifyFilter::InvalidConstraint ();
         }
     }
+
+  Structured_Event_Resolver resolver;
+
+  if (this->program_.compile (this->root_, resolver) != 0
+      && TAO_debug_level > 0)
+    {
+      ORBSVCS_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("(%P|%t) Constraint is evaluated ")
+                      ACE_TEXT ("by the visitor: %C\n"),
+                      constraints));
+    }
+
+  Structured_Event_Key_Finder finder (resolver);
+  this->key_ = finder.key (this->root_);
 }
 
 void
@@ -113,4 +499,43 @@ TAO_Notify_Constraint_Interpreter::evaluate (TAO_Notify_Constraint_Visitor &eval
   return evaluator.evaluate_constraint (this->root_);
 }
 
+bool
+TAO_Notify_Constraint_Interpreter::compiled () const
+{
+  return this->program_.compiled ();
+}
+
+CORBA::Boolean
+TAO_Notify_Constraint_Interpreter::evaluate (
+    const CosNotification::StructuredEvent &event) const
+{
+  Structured_Event_Record const record (event);
+  return this->program_.evaluate (record);
+}
+
+const TAO_Notify_Filter_Key &
+TAO_Notify_Constraint_Interpreter::key () const
+{
+  return this->key_;
+}
+
+bool
+TAO_Notify_Constraint_Interpreter::bindable (
+    const CosNotification::StructuredEvent &event)
+{
+  return !duplicate_names (event.filterable_data)
+    && !duplicate_names (event.header.variable_header);
+}
+
+int
+TAO_Notify_Constraint_Interpreter::field (
+    const CosNotification::StructuredEvent &event,
+    CORBA::ULong kind,
+    const char *name,
+    TAO_ETCL_Value &value)
+{
+  Structured_Event_Record const record (event);
+  return record.field (kind, name, value);
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
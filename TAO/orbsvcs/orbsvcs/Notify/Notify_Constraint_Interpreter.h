@@ -20,8 +20,10 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "tao/ETCL/TAO_ETCL_Constraint.h"
+#include "tao/ETCL/TAO_ETCL_Program.h"
 
 #include "orbsvcs/CosNotifyFilterC.h"
+#include "orbsvcs/Notify/Filter_Index.h"
 #include "orbsvcs/Notify/notify_serv_export.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -54,8 +56,39 @@ public:
   /// the evaluator.
   CORBA::Boolean evaluate (TAO_Notify_Constraint_Visitor &evaluator);
 
+  /// True if build_tree() compiled the constraint, which can then be
+  /// evaluated without a visitor.
+  bool compiled () const;
+
+  /// Returns true if @a event satisfies the compiled constraint.
+  /// The caller checks bindable() first.
+  CORBA::Boolean evaluate (const CosNotification::StructuredEvent &event) const;
+
+  /// False if @a event has two filterable_data or two variable_header
+  /// properties of the same name.  The visitor does not bind such an
+  /// event, so no constraint accepts it.
+  static bool bindable (const CosNotification::StructuredEvent &event);
+
+  /// What the constraint requires of the events it accepts.
+  const TAO_Notify_Filter_Key &key () const;
+
+  /// Read the field of @a event a compiled constraint or a key names
+  /// with @a kind and @a name.  Returns -1 if @a event has no such
+  /// field.
+  static int field (const CosNotification::StructuredEvent &event,
+                    CORBA::ULong kind,
+                    const char *name,
+                    TAO_ETCL_Value &value);
+
 private:
   void build_tree (const char* constraints);
+
+  /// The constraint compiled, empty if it uses something that only
+  /// the visitor evaluates.
+  TAO_ETCL_Program program_;
+
+  /// Found by build_tree().
+  TAO_Notify_Filter_Key key_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,201 @@
+#include "orbsvcs/Notify/Pipeline.h"
+#include "orbsvcs/Notify/Consumer.h"
+#include "orbsvcs/Notify/Proxy.h"
+#include "orbsvcs/Notify/Method_Request_Event.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Notify_Pipeline::Handler::Handler (TAO_Notify_Consumer *consumer)
+  : consumer_ (consumer),
+    request_ (0),
+    order_ (0)
+{
+}
+
+TAO_Notify_Pipeline::Handler::~Handler ()
+{
+}
+
+void
+TAO_Notify_Pipeline::Handler::push ()
+{
+  this->replied (0);
+}
+
+void
+TAO_Notify_Pipeline::Handler::push_excep (
+  Messaging::ExceptionHolder *excep_holder)
+{
+  this->replied (excep_holder);
+}
+
+void
+TAO_Notify_Pipeline::Handler::push_structured_event ()
+{
+  this->replied (0);
+}
+
+void
+TAO_Notify_Pipeline::Handler::push_structured_event_excep (
+  Messaging::ExceptionHolder *excep_holder)
+{
+  this->replied (excep_holder);
+}
+
+Notify_Pipeline::AMI_ConsumerHandler_ptr
+TAO_Notify_Pipeline::Handler::reference () const
+{
+  return this->reference_.in ();
+}
+
+void
+TAO_Notify_Pipeline::Handler::replied (Messaging::ExceptionHolder *excep_holder)
+{
+  // Giving the handler back drops the guards of the request, the
+  // consumer may go with them.
+  TAO_Notify_Consumer::Ptr consumer (this->consumer_);
+  TAO_Notify_Proxy::Ptr proxy (this->proxy_guard_);
+
+  consumer->pipeline_reply (this, excep_holder);
+}
+
+// ****************************************************************
+
+TAO_Notify_Pipeline::TAO_Notify_Pipeline (TAO_Notify_Consumer *consumer,
+                                          CORBA::ULong depth,
+                                          PortableServer::POA_ptr poa)
+  : consumer_ (consumer),
+    depth_ (depth),
+    poa_ (PortableServer::POA::_duplicate (poa)),
+    sent_ (0)
+{
+}
+
+TAO_Notify_Pipeline::~TAO_Notify_Pipeline ()
+{
+  for (size_t i = 0; i < this->handlers_.size (); ++i)
+    {
+      PortableServer::ServantBase_var servant (this->handlers_[i]);
+
+      try
+        {
+          PortableServer::ObjectId_var id =
+            this->poa_->servant_to_id (servant.in ());
+          this->poa_->deactivate_object (id.in ());
+        }
+      catch (const CORBA::Exception&)
+        {
+          // The POA may already be gone.
+        }
+    }
+}
+
+bool
+TAO_Notify_Pipeline::full () const
+{
+  return this->held_.size () != 0
+    || (this->free_.size () == 0 && this->handlers_.size () >= this->depth_);
+}
+
+bool
+TAO_Notify_Pipeline::idle () const
+{
+  return this->held_.size () == 0 && this->in_flight () == 0;
+}
+
+size_t
+TAO_Notify_Pipeline::in_flight () const
+{
+  return this->handlers_.size () - this->free_.size ();
+}
+
+TAO_Notify_Pipeline::Handler *
+TAO_Notify_Pipeline::send (TAO_Notify_Method_Request_Event_Queueable *request)
+{
+  Handler *handler = 0;
+
+  if (this->free_.size () != 0)
+    {
+      handler = this->free_[this->free_.size () - 1];
+      this->free_.pop_back ();
+    }
+  else
+    {
+      ACE_NEW_THROW_EX (handler,
+                        Handler (this->consumer_),
+                        CORBA::NO_MEMORY ());
+      PortableServer::ServantBase_var servant (handler);
+
+      PortableServer::ObjectId_var id =
+        this->poa_->activate_object (handler);
+
+      CORBA::Object_var object =
+        this->poa_->id_to_reference (id.in ());
+      handler->reference_ =
+        Notify_Pipeline::AMI_ConsumerHandler::_narrow (object.in ());
+
+      // Kept until the pipeline goes.
+      handler->_add_ref ();
+      this->handlers_.push_back (handler);
+    }
+
+  handler->request_ = request;
+  handler->order_ = this->sent_++;
+  handler->consumer_guard_.reset (this->consumer_);
+  handler->proxy_guard_.reset (this->consumer_->proxy ());
+
+  return handler;
+}
+
+TAO_Notify_Method_Request_Event_Queueable *
+TAO_Notify_Pipeline::reply (Handler *handler, unsigned long &order)
+{
+  TAO_Notify_Method_Request_Event_Queueable *request = handler->request_;
+  order = handler->order_;
+
+  if (request != 0)
+    {
+      handler->request_ = 0;
+      handler->consumer_guard_.reset ();
+      handler->proxy_guard_.reset ();
+      this->free_.push_back (handler);
+    }
+
+  return request;
+}
+
+void
+TAO_Notify_Pipeline::hold (TAO_Notify_Method_Request_Event_Queueable *request,
+                           unsigned long order)
+{
+  // The replies may come in any order, keep the held requests sorted.
+  Held held;
+  held.request_ = request;
+  held.order_ = order;
+
+  size_t i = this->held_.size ();
+  this->held_.push_back (held);
+  for (; i > 0 && this->held_[i - 1].order_ > order; --i)
+    {
+      this->held_[i] = this->held_[i - 1];
+    }
+  this->held_[i] = held;
+}
+
+TAO_Notify_Method_Request_Event_Queueable *
+TAO_Notify_Pipeline::take_held ()
+{
+  size_t const size = this->held_.size ();
+
+  if (size == 0)
+    {
+      return 0;
+    }
+
+  TAO_Notify_Method_Request_Event_Queueable *request =
+    this->held_[size - 1].request_;
+  this->held_.pop_back ();
+  return request;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
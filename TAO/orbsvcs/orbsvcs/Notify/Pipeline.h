@@ -0,0 +1,153 @@
+// -*- C++ -*-
+/**
+ *  @file Pipeline.h
+ *
+ *  Asynchronous delivery to a push consumer.
+ */
+
+#ifndef TAO_Notify_PIPELINE_H
+#define TAO_Notify_PIPELINE_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Notify/notify_serv_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Notify_PipelineS.h"
+#include "orbsvcs/Notify/Refcountable_Guard_T.h"
+#include "ace/Vector_T.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Notify_Consumer;
+class TAO_Notify_Proxy;
+class TAO_Notify_Method_Request_Event_Queueable;
+
+/**
+ * @class TAO_Notify_Pipeline
+ *
+ * @brief The requests a consumer has sent with AMI and not yet had
+ *        the replies of.
+ *
+ * Each request in flight has a reply handler of its own, so that the
+ * replies find their request whatever order they come in.  The
+ * handlers are activated in the POA when first needed and reused for
+ * later requests.  The consumer and its proxy are kept around while
+ * a request is in flight.
+ *
+ * A request to be retried is held until the requests sent after it
+ * have their replies, so that the retries go out in the order the
+ * requests were first sent.  Nothing new is sent meanwhile.  The
+ * requests sent after it may still reach the consumer first.
+ *
+ * The pipeline is guarded by the proxy lock of the consumer.
+ */
+class TAO_Notify_Serv_Export TAO_Notify_Pipeline
+{
+public:
+  /**
+   * @class Handler
+   *
+   * @brief Hands the reply to a request back to the consumer.
+   */
+  class Handler : public POA_Notify_Pipeline::AMI_ConsumerHandler
+  {
+  public:
+    explicit Handler (TAO_Notify_Consumer *consumer);
+    ~Handler () override;
+
+    void push () override;
+    void push_excep (Messaging::ExceptionHolder *excep_holder) override;
+    void push_structured_event () override;
+    void push_structured_event_excep (
+      Messaging::ExceptionHolder *excep_holder) override;
+
+    /// The reference to pass to the sendc_ operations.
+    Notify_Pipeline::AMI_ConsumerHandler_ptr reference () const;
+
+  private:
+    friend class TAO_Notify_Pipeline;
+
+    void replied (Messaging::ExceptionHolder *excep_holder);
+
+    TAO_Notify_Consumer *consumer_;
+
+    Notify_Pipeline::AMI_ConsumerHandler_var reference_;
+
+    /// The request in flight, 0 if none.
+    TAO_Notify_Method_Request_Event_Queueable *request_;
+
+    /// When the request was sent, relative to the others.
+    unsigned long order_;
+
+    /// Held while a request is in flight.
+    TAO_Notify_Refcountable_Guard_T<TAO_Notify_Consumer> consumer_guard_;
+    TAO_Notify_Refcountable_Guard_T<TAO_Notify_Proxy> proxy_guard_;
+  };
+
+  /// Send at most @a depth requests to @a consumer before a reply,
+  /// with handlers activated in @a poa.
+  TAO_Notify_Pipeline (TAO_Notify_Consumer *consumer,
+                       CORBA::ULong depth,
+                       PortableServer::POA_ptr poa);
+
+  ~TAO_Notify_Pipeline ();
+
+  /// True if no more requests can be sent until a reply comes.
+  bool full () const;
+
+  /// True if no request is in flight nor held.
+  bool idle () const;
+
+  /// The number of requests in flight.
+  size_t in_flight () const;
+
+  /// Take a handler for the reply to @a request.
+  Handler *send (TAO_Notify_Method_Request_Event_Queueable *request);
+
+  /// Give @a handler back and return its request, or 0 if it had
+  /// none.  @a order is set to when the request was sent.
+  TAO_Notify_Method_Request_Event_Queueable *reply (Handler *handler,
+                                                    unsigned long &order);
+
+  /// Hold @a request, sent in @a order, to be retried.
+  void hold (TAO_Notify_Method_Request_Event_Queueable *request,
+             unsigned long order);
+
+  /// Take the last sent of the held requests, or 0 if none.
+  TAO_Notify_Method_Request_Event_Queueable *take_held ();
+
+private:
+  TAO_Notify_Consumer *consumer_;
+
+  CORBA::ULong depth_;
+
+  PortableServer::POA_var poa_;
+
+  /// The handlers activated in the POA.
+  ACE_Vector<Handler *> handlers_;
+
+  /// The handlers without a request in flight.
+  ACE_Vector<Handler *> free_;
+
+  struct Held
+  {
+    TAO_Notify_Method_Request_Event_Queueable *request_;
+    unsigned long order_;
+  };
+
+  /// The requests to be retried, in the order they were sent.
+  ACE_Vector<Held> held_;
+
+  /// The number of requests sent so far.
+  unsigned long sent_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_Notify_PIPELINE_H */
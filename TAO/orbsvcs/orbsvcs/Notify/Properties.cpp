@@ -18,6 +18,7 @@ TAO_Notify_Properties::TAO_Notify_Properties ()
   , allow_reconnect_ (false)
   , validate_client_ (false)
   , separate_dispatching_orb_ (false)
+  , pipeline_depth_ (0)
   , updates_ (1)
   , defaultConsumerAdminFilterOp_ (CosNotifyChannelAdmin::OR_OP)
   , defaultSupplierAdminFilterOp_ (CosNotifyChannelAdmin::OR_OP)
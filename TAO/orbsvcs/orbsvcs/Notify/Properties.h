@@ -82,6 +82,11 @@ public:
   bool separate_dispatching_orb ();
   void separate_dispatching_orb (bool b);
 
+  /// The number of events sent to a push consumer with AMI before
+  /// waiting for their replies, 0 pushes them synchronously.
+  CORBA::ULong pipeline_depth ();
+  void pipeline_depth (CORBA::ULong depth);
+
   // The QoS Property that must be applied to each newly created Event Channel
   const CosNotification::QoSProperties& default_event_channel_qos_properties ();
 
@@ -146,6 +151,9 @@ protected:
   /// True is separate dispatching orb
   bool separate_dispatching_orb_;
 
+  /// Events in flight per push consumer.
+  CORBA::ULong pipeline_depth_;
+
   /// True if updates are enabled (default).
   CORBA::Boolean updates_;
 
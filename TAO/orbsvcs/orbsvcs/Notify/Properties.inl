@@ -134,6 +134,18 @@ TAO_Notify_Properties::separate_dispatching_orb (bool b)
   this->separate_dispatching_orb_ = b;
 }
 
+ACE_INLINE CORBA::ULong
+TAO_Notify_Properties::pipeline_depth ()
+{
+  return this->pipeline_depth_;
+}
+
+ACE_INLINE void
+TAO_Notify_Properties::pipeline_depth (CORBA::ULong depth)
+{
+  this->pipeline_depth_ = depth;
+}
+
 ACE_INLINE CORBA::Boolean
 TAO_Notify_Properties::updates ()
 {
@@ -12,6 +12,7 @@
 #include "orbsvcs/Notify/Buffering_Strategy.h"
 #include "orbsvcs/Notify/Properties.h"
 #include "orbsvcs/Notify/ConsumerAdmin.h"
+#include "orbsvcs/Notify/Filter_Index.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -155,4 +156,25 @@ TAO_Notify_ProxySupplier::qos_changed (const TAO_Notify_QoSProperties& qos_prope
   TAO_Notify_Proxy::qos_changed (qos_properties);
 }
 
+void
+TAO_Notify_ProxySupplier::filter_key (TAO_Notify_Filter_Key& key)
+{
+  TAO_Notify_ConsumerAdmin& parent = this->consumer_admin ();
+
+  // As check_filters () combines the admin and proxy filters.
+  TAO_Notify_Filter_Key parent_key;
+  parent.filter_admin ().filter_key (parent_key);
+
+  this->filter_admin_.filter_key (key);
+
+  if (parent.filter_operator () == CosNotifyChannelAdmin::AND_OP)
+    {
+      key.merge_and (parent_key);
+    }
+  else
+    {
+      key.merge_or (parent_key);
+    }
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -26,6 +26,7 @@
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_Notify_Consumer;
+class TAO_Notify_Filter_Key;
 class TAO_Notify_Method_Request_Dispatch_No_Copy;
 /**
  * @class TAO_Notify_ProxySupplier
@@ -77,6 +78,10 @@ public:
   /// The CA parent.
   TAO_Notify_ConsumerAdmin& consumer_admin ();
 
+  /// What the admin and proxy filters require of the events that
+  /// pass them, for the TAO_Notify_Filter_Index.
+  void filter_key (TAO_Notify_Filter_Key& key);
+
 private:
   ///= Data Members.
   /// The CA parent.
@@ -24,6 +24,21 @@ Routing_Slip_Persistence_Manager::Routing_Slip_Persistence_Manager(
   this->next_manager_ = this;
 }
 
+Routing_Slip_Persistence_Manager::Routing_Slip_Persistence_Manager()
+  : removed_(false)
+  , serial_number_(0)
+  , allocator_(0)
+  , factory_(0)
+  , first_event_block_(0)
+  , first_routing_slip_block_(0)
+  , callback_(0)
+  , event_mb_ (0)
+  , routing_slip_mb_(0)
+{
+  this->prev_manager_ = this;
+  this->next_manager_ = this;
+}
+
 Routing_Slip_Persistence_Manager::~Routing_Slip_Persistence_Manager()
 {
   ACE_ASSERT(this->prev_manager_ == this);
@@ -78,6 +78,12 @@ TAO_Notify_StructuredEvent_No_Copy::convert (CosNotification::StructuredEvent& n
   notification = *this->notification_;
 }
 
+const CosNotification::StructuredEvent*
+TAO_Notify_StructuredEvent_No_Copy::structured () const
+{
+  return this->notification_;
+}
+
 void
 TAO_Notify_StructuredEvent_No_Copy::push (TAO_Notify_Consumer* consumer) const
 {
@@ -45,6 +45,9 @@ public:
   /// Convert to CosNotification::Structured type
   virtual void convert (CosNotification::StructuredEvent& notification) const;
 
+  /// The structured event.
+  virtual const CosNotification::StructuredEvent* structured () const;
+
   /// Get the event type.
   virtual const TAO_Notify_EventType& type () const;
 
@@ -32,6 +32,8 @@ TAO_Notify_StructuredPushConsumer::init (CosNotifyComm::StructuredPushConsumer_p
     {
       this->push_consumer_ = CosNotifyComm::StructuredPushConsumer::_duplicate (push_consumer);
       this->publish_ = CosNotifyComm::NotifyPublish::_duplicate (push_consumer);
+
+      this->init_pipeline (push_consumer);
     }
   else
     {
@@ -142,6 +144,27 @@ TAO_Notify_StructuredPushConsumer::push (const CosNotification::StructuredEvent&
   this->push_consumer_->push_structured_event (event);
 }
 
+void
+TAO_Notify_StructuredPushConsumer::sendc (const TAO_Notify_Event* event,
+                                          Notify_Pipeline::Consumer_ptr consumer,
+                                          Notify_Pipeline::AMI_ConsumerHandler_ptr handler)
+{
+  last_ping_ = ACE_OS::gettimeofday ();
+
+  const CosNotification::StructuredEvent* notification = event->structured ();
+
+  if (notification != 0)
+    {
+      consumer->sendc_push_structured_event (handler, *notification);
+    }
+  else
+    {
+      CosNotification::StructuredEvent converted;
+      event->convert (converted);
+      consumer->sendc_push_structured_event (handler, converted);
+    }
+}
+
 /// Push a batch of events to this consumer.
 void
 TAO_Notify_StructuredPushConsumer::push (const CosNotification::EventBatch& event)
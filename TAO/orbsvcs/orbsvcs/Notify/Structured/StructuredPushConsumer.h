@@ -63,6 +63,11 @@ public:
 protected:
   virtual CORBA::Object_ptr get_consumer ();
 
+  /// Push @a event with AMI.
+  virtual void sendc (const TAO_Notify_Event* event,
+                      Notify_Pipeline::Consumer_ptr consumer,
+                      Notify_Pipeline::AMI_ConsumerHandler_ptr handler);
+
   /// The Consumer
   CosNotifyComm::StructuredPushConsumer_var push_consumer_;
 
@@ -0,0 +1,1190 @@
+#include "orbsvcs/Log_Macros.h"
+#include "orbsvcs/Notify/WAL_Event_Persistence.h"
+#include "orbsvcs/Notify/Persistent_File_Allocator.h"
+#include "tao/debug.h"
+#include "ace/ACE.h"
+#include "ace/Dirent.h"
+#include "ace/Dynamic_Service.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_strings.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Truncate.h"
+#include "ace/Vector_T.h"
+#include <algorithm>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// A segment starts with the magic and its own number, so that a
+  /// renamed file is not taken for another segment.
+  const char SEGMENT_MAGIC[] = "TAO_NWAL";
+  const size_t SEGMENT_MAGIC_SIZE = 8;
+  const size_t SEGMENT_HEADER_SIZE = SEGMENT_MAGIC_SIZE + 4;
+
+  /// A record header is the data length, a CRC-32 of the rest of the
+  /// header and the data, the record type, the serial number and the
+  /// length of the event at the front of the data.
+  const size_t RECORD_HEADER_SIZE = 4 + 4 + 4 + 8 + 4;
+  const size_t CRC_OFFSET = 4;
+  const size_t CHECKED_OFFSET = 8;
+
+  const ACE_TCHAR SEGMENT_PREFIX[] = ACE_TEXT ("segment.");
+  const size_t SEGMENT_PREFIX_LENGTH = 8;
+
+  void
+  put_uint32 (unsigned char * data, ACE_UINT32 value)
+  {
+    data[0] = static_cast<unsigned char> ((value >> 24) & 0xff);
+    data[1] = static_cast<unsigned char> ((value >> 16) & 0xff);
+    data[2] = static_cast<unsigned char> ((value >> 8) & 0xff);
+    data[3] = static_cast<unsigned char> (value & 0xff);
+  }
+
+  void
+  put_uint64 (unsigned char * data, ACE_UINT64 value)
+  {
+    put_uint32 (data, static_cast<ACE_UINT32> (value >> 32));
+    put_uint32 (data + 4, static_cast<ACE_UINT32> (value & 0xffffffff));
+  }
+
+  ACE_UINT32
+  get_uint32 (const unsigned char * data)
+  {
+    ACE_UINT32 value = data[0];
+    value = (value << 8) + data[1];
+    value = (value << 8) + data[2];
+    value = (value << 8) + data[3];
+    return value;
+  }
+
+  ACE_UINT64
+  get_uint64 (const unsigned char * data)
+  {
+    ACE_UINT64 value = get_uint32 (data);
+    return (value << 32) + get_uint32 (data + 4);
+  }
+}
+
+namespace TAO_Notify
+{
+WAL_Routing_Slip_Persistence_Manager::WAL_Routing_Slip_Persistence_Manager (
+  WAL_Event_Persistence_Factory * factory,
+  ACE_UINT64 serial_number)
+  : factory_ (factory)
+  , serial_number_ (serial_number)
+  , callback_ (0)
+  , stored_ (false)
+  , removed_ (false)
+  , event_mb_ (0)
+  , routing_slip_mb_ (0)
+  , next_reload_ (0)
+{
+}
+
+WAL_Routing_Slip_Persistence_Manager::~WAL_Routing_Slip_Persistence_Manager ()
+{
+  delete this->event_mb_;
+  this->event_mb_ = 0;
+  delete this->routing_slip_mb_;
+  this->routing_slip_mb_ = 0;
+}
+
+void
+WAL_Routing_Slip_Persistence_Manager::set_callback (
+  Persistent_Callback* callback)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->callback_ = callback;
+}
+
+bool
+WAL_Routing_Slip_Persistence_Manager::store (
+  const ACE_Message_Block& event,
+  const ACE_Message_Block& routing_slip)
+{
+  bool result = false;
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
+  if (!this->removed_ && !this->stored_)
+  {
+    result = this->factory_->append (
+      WAL_Event_Persistence_Factory::RT_Store,
+      this->serial_number_,
+      &event,
+      &routing_slip,
+      this->callback_);
+    this->stored_ = result;
+  }
+  return result;
+}
+
+bool
+WAL_Routing_Slip_Persistence_Manager::update (
+  const ACE_Message_Block& routing_slip)
+{
+  bool result = false;
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
+  if (!this->removed_ && this->stored_)
+  {
+    result = this->factory_->append (
+      WAL_Event_Persistence_Factory::RT_Update,
+      this->serial_number_,
+      0,
+      &routing_slip,
+      this->callback_);
+  }
+  return result;
+}
+
+bool
+WAL_Routing_Slip_Persistence_Manager::remove ()
+{
+  bool result = false;
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, result);
+  if (!this->removed_)
+  {
+    // The callback is wanted even if nothing was stored.
+    this->removed_ = true;
+    result = this->factory_->append (
+      WAL_Event_Persistence_Factory::RT_Remove,
+      this->serial_number_,
+      0,
+      0,
+      this->callback_);
+  }
+  return result;
+}
+
+bool
+WAL_Routing_Slip_Persistence_Manager::reload (
+  ACE_Message_Block*& event,
+  ACE_Message_Block*& routing_slip)
+{
+  bool result = false;
+  if (this->event_mb_ != 0 && this->routing_slip_mb_ != 0)
+  {
+    event = this->event_mb_;
+    this->event_mb_ = 0;
+    routing_slip = this->routing_slip_mb_;
+    this->routing_slip_mb_ = 0;
+    result = true;
+  }
+  else
+  {
+    event = 0;
+    routing_slip = 0;
+  }
+  return result;
+}
+
+Routing_Slip_Persistence_Manager *
+WAL_Routing_Slip_Persistence_Manager::load_next ()
+{
+  WAL_Routing_Slip_Persistence_Manager * result = this->next_reload_;
+  this->next_reload_ = 0;
+  return result;
+}
+
+WAL_Event_Persistence::WAL_Event_Persistence ()
+  : dir_path_ (ACE_TEXT ("__PERSISTENT_EVENT_LOG__"))
+  , segment_size_ (16 * 1024 * 1024)
+  , commit_delay_ (ACE_Time_Value::zero)
+  , compact_ratio_ (2)
+  , factory_ (0)
+{
+}
+
+WAL_Event_Persistence::~WAL_Event_Persistence ()
+{
+}
+
+// get the current factory, creating it if necessary
+Event_Persistence_Factory *
+WAL_Event_Persistence::get_factory ()
+{
+  if (this->factory_ == 0)
+  {
+    ACE_NEW_NORETURN (
+      this->factory_,
+      WAL_Event_Persistence_Factory ());
+
+    if (this->factory_ != 0)
+    {
+      if (!this->factory_->open (this->dir_path_.c_str (),
+                                 this->segment_size_,
+                                 this->commit_delay_,
+                                 this->compact_ratio_))
+      {
+        delete this->factory_;
+        this->factory_ = 0;
+      }
+    }
+  }
+  return this->factory_;
+}
+
+// release the current factory so a new one can be created
+void
+WAL_Event_Persistence::reset ()
+{
+  delete this->factory_;
+  this->factory_ = 0;
+}
+
+int
+WAL_Event_Persistence::init (int argc, ACE_TCHAR *argv[])
+{
+  int result = 0;
+  bool verbose = false;
+  for (int narg = 0; narg < argc; ++narg)
+  {
+    ACE_TCHAR * av = argv[narg];
+    if (ACE_OS::strcasecmp (av, ACE_TEXT ("-v")) == 0)
+    {
+      verbose = true;
+      ORBSVCS_DEBUG ((LM_DEBUG,
+        ACE_TEXT ("(%P|%t) WAL_Event_Persistence: -verbose\n")
+        ));
+    }
+    else if (ACE_OS::strcasecmp (av, ACE_TEXT ("-dir_path")) == 0 && narg + 1 < argc)
+    {
+      this->dir_path_ = argv[narg + 1];
+      if (TAO_debug_level > 0 || verbose)
+      {
+        ORBSVCS_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Setting -dir_path: %s\n"),
+          this->dir_path_.c_str ()
+        ));
+      }
+      narg += 1;
+    }
+    else if (ACE_OS::strcasecmp (av, ACE_TEXT ("-segment_size")) == 0 && narg + 1 < argc)
+    {
+      this->segment_size_ = ACE_OS::strtoull (argv[narg + 1], 0, 10);
+      if (TAO_debug_level > 0 || verbose)
+      {
+        ORBSVCS_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Setting -segment_size: %Q\n"),
+          this->segment_size_
+        ));
+      }
+      narg += 1;
+    }
+    else if (ACE_OS::strcasecmp (av, ACE_TEXT ("-commit_delay")) == 0 && narg + 1 < argc)
+    {
+      this->commit_delay_ = ACE_Time_Value (0, ACE_OS::atoi (argv[narg + 1]));
+      if (TAO_debug_level > 0 || verbose)
+      {
+        ORBSVCS_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Setting -commit_delay: %d\n"),
+          ACE_OS::atoi (argv[narg + 1])
+        ));
+      }
+      narg += 1;
+    }
+    else if (ACE_OS::strcasecmp (av, ACE_TEXT ("-compact_ratio")) == 0 && narg + 1 < argc)
+    {
+      this->compact_ratio_ = ACE_OS::atoi (argv[narg + 1]);
+      if (TAO_debug_level > 0 || verbose)
+      {
+        ORBSVCS_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Setting -compact_ratio: %d\n"),
+          this->compact_ratio_
+        ));
+      }
+      narg += 1;
+    }
+    else
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+        ACE_TEXT ("(%P|%t) Unknown parameter to WAL Event Persistence: %s\n"),
+        argv[narg]
+        ));
+      result = -1;
+    }
+  }
+  return result;
+}
+
+int
+WAL_Event_Persistence::fini ()
+{
+  delete this->factory_;
+  this->factory_ = 0;
+  return 0;
+}
+
+WAL_Event_Persistence_Factory::WAL_Event_Persistence_Factory ()
+  : segment_size_ (0)
+  , commit_delay_ (ACE_Time_Value::zero)
+  , compact_ratio_ (0)
+  , wake_up_thread_ (lock_)
+  , next_serial_number_ (1)
+  , terminate_thread_ (false)
+  , thread_active_ (false)
+  , oldest_segment_ (0)
+  , active_segment_ (0)
+  , log_bytes_ (0)
+  , live_bytes_ (0)
+  , reload_ (0)
+{
+}
+
+WAL_Event_Persistence_Factory::~WAL_Event_Persistence_Factory ()
+{
+  if (TAO_debug_level > 0)
+  {
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence_Factory::~WAL_Event_Persistence_Factory\n")
+    ));
+  }
+  this->shutdown ();
+
+  while (this->reload_ != 0)
+  {
+    WAL_Routing_Slip_Persistence_Manager * next = this->reload_->next_reload_;
+    delete this->reload_;
+    this->reload_ = next;
+  }
+
+  for (Segment_Map::iterator i = this->segments_.begin ();
+       i != this->segments_.end ();
+       ++i)
+  {
+    ACE_OS::close ((*i).int_id_.handle);
+  }
+}
+
+bool
+WAL_Event_Persistence_Factory::open (const ACE_TCHAR* dir_path,
+                                     ACE_UINT64 segment_size,
+                                     const ACE_Time_Value & commit_delay,
+                                     ACE_UINT32 compact_ratio)
+{
+  this->dir_path_ = dir_path;
+  this->segment_size_ = segment_size;
+  this->commit_delay_ = commit_delay;
+  this->compact_ratio_ = compact_ratio;
+
+  if (ACE_OS::mkdir (dir_path) != 0 && errno != EEXIST)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot create %s: %p\n"),
+      dir_path,
+      ACE_TEXT ("mkdir")
+      ));
+    return false;
+  }
+
+  if (!this->recover ())
+  {
+    return false;
+  }
+  if (this->segments_.current_size () == 0)
+  {
+    this->oldest_segment_ = this->active_segment_ + 1;
+  }
+  if (!this->start_segment (this->active_segment_ + 1)
+      || !this->prepare_reload ())
+  {
+    return false;
+  }
+
+  this->thread_active_ = true;
+  if (this->thread_manager_.spawn (this->thr_func, this) == -1)
+  {
+    this->thread_active_ = false;
+    return false;
+  }
+  return true;
+}
+
+void
+WAL_Event_Persistence_Factory::shutdown ()
+{
+  if (this->thread_active_)
+  {
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+      this->terminate_thread_ = true;
+      this->wake_up_thread_.signal ();
+    }
+    this->thread_manager_.close ();
+    ACE_ASSERT (!this->terminate_thread_);
+    ACE_ASSERT (!this->thread_active_);
+  }
+}
+
+Routing_Slip_Persistence_Manager *
+WAL_Event_Persistence_Factory::create_routing_slip_persistence_manager (
+  Persistent_Callback* callback)
+{
+  ACE_UINT64 serial_number = 0;
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+    serial_number = this->next_serial_number_++;
+  }
+  WAL_Routing_Slip_Persistence_Manager* rspm = 0;
+  ACE_NEW_RETURN (rspm,
+    WAL_Routing_Slip_Persistence_Manager (this, serial_number),
+    rspm);
+  rspm->set_callback (callback);
+  return rspm;
+}
+
+Routing_Slip_Persistence_Manager *
+WAL_Event_Persistence_Factory::first_reload_manager ()
+{
+  WAL_Routing_Slip_Persistence_Manager * result = this->reload_;
+  this->reload_ = 0;
+  return result;
+}
+
+bool
+WAL_Event_Persistence_Factory::append (Record_Type type,
+                                       ACE_UINT64 serial_number,
+                                       const ACE_Message_Block * event,
+                                       const ACE_Message_Block * routing_slip,
+                                       Persistent_Callback * callback)
+{
+  // The copy and the CRC are done by the caller, the writer thread
+  // only writes.
+  Record record;
+  record.data = this->make_record (type, serial_number, event, routing_slip);
+  record.callback = callback;
+  if (record.data == 0)
+  {
+    return false;
+  }
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, false);
+  if (!this->thread_active_ || this->terminate_thread_
+      || this->queue_.enqueue_tail (record) != 0)
+  {
+    delete record.data;
+    return false;
+  }
+  this->wake_up_thread_.signal ();
+  return true;
+}
+
+ACE_Message_Block *
+WAL_Event_Persistence_Factory::make_record (
+  Record_Type type,
+  ACE_UINT64 serial_number,
+  const ACE_Message_Block * event,
+  const ACE_Message_Block * routing_slip)
+{
+  size_t const event_length = event == 0 ? 0 : event->total_length ();
+  size_t const routing_slip_length =
+    routing_slip == 0 ? 0 : routing_slip->total_length ();
+  size_t const length = event_length + routing_slip_length;
+
+  ACE_Message_Block * data = 0;
+  ACE_NEW_RETURN (data,
+    ACE_Message_Block (RECORD_HEADER_SIZE + length),
+    0);
+  unsigned char * header =
+    reinterpret_cast<unsigned char *> (data->wr_ptr ());
+  data->wr_ptr (RECORD_HEADER_SIZE);
+  for (const ACE_Message_Block * mb = event; mb != 0; mb = mb->cont ())
+  {
+    data->copy (mb->rd_ptr (), mb->length ());
+  }
+  for (const ACE_Message_Block * mb = routing_slip; mb != 0; mb = mb->cont ())
+  {
+    data->copy (mb->rd_ptr (), mb->length ());
+  }
+
+  put_uint32 (header, ACE_Utils::truncate_cast<ACE_UINT32> (length));
+  put_uint32 (header + 8, static_cast<ACE_UINT32> (type));
+  put_uint64 (header + 12, serial_number);
+  put_uint32 (header + 20, ACE_Utils::truncate_cast<ACE_UINT32> (event_length));
+  put_uint32 (header + CRC_OFFSET,
+    ACE::crc32 (header + CHECKED_OFFSET,
+                RECORD_HEADER_SIZE - CHECKED_OFFSET + length));
+  return data;
+}
+
+ACE_TString
+WAL_Event_Persistence_Factory::segment_path (ACE_UINT32 number) const
+{
+  ACE_TCHAR name[32];
+  ACE_OS::sprintf (name, ACE_TEXT ("%s%08u"), SEGMENT_PREFIX, number);
+  ACE_TString result (this->dir_path_);
+  result += ACE_DIRECTORY_SEPARATOR_STR;
+  result += name;
+  return result;
+}
+
+WAL_Event_Persistence_Factory::Segment *
+WAL_Event_Persistence_Factory::segment (ACE_UINT32 number)
+{
+  ACE_Hash_Map_Entry<ACE_UINT32, Segment> * entry = 0;
+  if (this->segments_.find (number, entry) != 0)
+  {
+    return 0;
+  }
+  return &entry->int_id_;
+}
+
+bool
+WAL_Event_Persistence_Factory::recover ()
+{
+  ACE_Dirent dir;
+  if (dir.open (this->dir_path_.c_str ()) == -1)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot read %s: %p\n"),
+      this->dir_path_.c_str (),
+      ACE_TEXT ("opendir")
+      ));
+    return false;
+  }
+
+  bool found = false;
+  ACE_UINT32 first = 0;
+  ACE_UINT32 last = 0;
+  for (ACE_DIRENT * entry = dir.read (); entry != 0; entry = dir.read ())
+  {
+    const ACE_TCHAR * name = entry->d_name;
+    if (ACE_OS::strncmp (name, SEGMENT_PREFIX, SEGMENT_PREFIX_LENGTH) != 0)
+    {
+      continue;
+    }
+    ACE_TCHAR * end = 0;
+    unsigned long const number =
+      ACE_OS::strtoul (name + SEGMENT_PREFIX_LENGTH, &end, 10);
+    if (end == name + SEGMENT_PREFIX_LENGTH || *end != 0)
+    {
+      continue;
+    }
+    ACE_UINT32 const n = static_cast<ACE_UINT32> (number);
+    if (!found || n < first)
+    {
+      first = n;
+    }
+    if (!found || n > last)
+    {
+      last = n;
+    }
+    found = true;
+  }
+  dir.close ();
+
+  if (!found)
+  {
+    return true;
+  }
+
+  // Segments are only ever deleted from the front, so the numbers
+  // found are contiguous.
+  this->oldest_segment_ = first;
+  this->active_segment_ = last;
+  for (ACE_UINT32 number = first; number - first <= last - first; ++number)
+  {
+    ACE_TString path = this->segment_path (number);
+    Segment segment;
+    segment.handle = ACE_OS::open (path.c_str (), O_RDWR | O_BINARY);
+    segment.size = 0;
+    segment.references = 0;
+    if (segment.handle == ACE_INVALID_HANDLE)
+    {
+      continue;
+    }
+    if (this->segments_.bind (number, segment) != 0
+        || !this->scan (number))
+    {
+      return false;
+    }
+  }
+
+  if (TAO_debug_level > 0)
+  {
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Recovered %B events from segments %u to %u\n"),
+      this->slips_.current_size (),
+      first,
+      last
+    ));
+  }
+  return true;
+}
+
+bool
+WAL_Event_Persistence_Factory::scan (ACE_UINT32 number)
+{
+  Segment * segment = this->segment (number);
+  ACE_OFF_T const file_size = ACE_OS::filesize (segment->handle);
+  if (file_size < 0)
+  {
+    return false;
+  }
+  size_t const size = ACE_Utils::truncate_cast<size_t> (file_size);
+  segment->size = size;
+  this->log_bytes_ += size;
+
+  ACE_Message_Block buffer (size);
+  if (size != 0
+      && ACE_OS::pread (segment->handle, buffer.wr_ptr (), size, 0)
+           != static_cast<ssize_t> (size))
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot read segment %u: %p\n"),
+      number,
+      ACE_TEXT ("pread")
+      ));
+    return false;
+  }
+  const unsigned char * data =
+    reinterpret_cast<const unsigned char *> (buffer.wr_ptr ());
+
+  // A segment cut short before its header was synced holds nothing.
+  if (size < SEGMENT_HEADER_SIZE
+      || ACE_OS::memcmp (data, SEGMENT_MAGIC, SEGMENT_MAGIC_SIZE) != 0
+      || get_uint32 (data + SEGMENT_MAGIC_SIZE) != number)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Segment %u has no header, ignored.\n"),
+      number
+      ));
+    return true;
+  }
+
+  size_t offset = SEGMENT_HEADER_SIZE;
+  while (offset + RECORD_HEADER_SIZE <= size)
+  {
+    const unsigned char * header = data + offset;
+    ACE_UINT32 const length = get_uint32 (header);
+    ACE_UINT32 const type = get_uint32 (header + 8);
+    if (length > size - offset - RECORD_HEADER_SIZE
+        || type < RT_Store || type > RT_Remove
+        || get_uint32 (header + 20) > length
+        || get_uint32 (header + CRC_OFFSET) !=
+             ACE::crc32 (header + CHECKED_OFFSET,
+                         RECORD_HEADER_SIZE - CHECKED_OFFSET + length))
+    {
+      break;
+    }
+    ACE_UINT64 const serial_number = get_uint64 (header + 12);
+    if (serial_number >= this->next_serial_number_)
+    {
+      this->next_serial_number_ = serial_number + 1;
+    }
+    this->apply (header, number, offset);
+    offset += RECORD_HEADER_SIZE + length;
+  }
+
+  if (offset != size && TAO_debug_level > 0)
+  {
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Ignoring %B bytes not synced at the end of segment %u\n"),
+      size - offset,
+      number
+    ));
+  }
+  return true;
+}
+
+bool
+WAL_Event_Persistence_Factory::prepare_reload ()
+{
+  ACE_Vector<ACE_UINT64> serial_numbers;
+  for (Slip_Map::iterator i = this->slips_.begin ();
+       i != this->slips_.end ();
+       ++i)
+  {
+    serial_numbers.push_back ((*i).ext_id_);
+  }
+  if (serial_numbers.size () == 0)
+  {
+    return true;
+  }
+
+  // Hand the events back in the order they were first stored.
+  std::sort (&serial_numbers[0], &serial_numbers[0] + serial_numbers.size ());
+
+  for (size_t n = serial_numbers.size (); n > 0; --n)
+  {
+    Slip slip;
+    this->slips_.find (serial_numbers[n - 1], slip);
+
+    WAL_Routing_Slip_Persistence_Manager * rspm = 0;
+    ACE_NEW_RETURN (rspm,
+      WAL_Routing_Slip_Persistence_Manager (this, serial_numbers[n - 1]),
+      false);
+    rspm->stored_ = true;
+    rspm->event_mb_ = this->read (slip.event);
+    rspm->routing_slip_mb_ = this->read (slip.routing_slip);
+    rspm->next_reload_ = this->reload_;
+    this->reload_ = rspm;
+  }
+  return true;
+}
+
+bool
+WAL_Event_Persistence_Factory::start_segment (ACE_UINT32 number)
+{
+  ACE_TString path = this->segment_path (number);
+  Segment segment;
+  segment.handle = ACE_OS::open (path.c_str (),
+                                 O_RDWR | O_CREAT | O_TRUNC | O_BINARY,
+                                 ACE_DEFAULT_FILE_PERMS);
+  segment.size = 0;
+  segment.references = 0;
+  if (segment.handle == ACE_INVALID_HANDLE)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot create %s: %p\n"),
+      path.c_str (),
+      ACE_TEXT ("open")
+      ));
+    return false;
+  }
+
+  unsigned char header[SEGMENT_HEADER_SIZE];
+  ACE_OS::memcpy (header, SEGMENT_MAGIC, SEGMENT_MAGIC_SIZE);
+  put_uint32 (header + SEGMENT_MAGIC_SIZE, number);
+  if (ACE::write_n (segment.handle, header, SEGMENT_HEADER_SIZE)
+        != static_cast<ssize_t> (SEGMENT_HEADER_SIZE)
+      || this->segments_.bind (number, segment) != 0)
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot start %s: %p\n"),
+      path.c_str (),
+      ACE_TEXT ("write")
+      ));
+    ACE_OS::close (segment.handle);
+    return false;
+  }
+  this->segment (number)->size = SEGMENT_HEADER_SIZE;
+  this->log_bytes_ += SEGMENT_HEADER_SIZE;
+  this->active_segment_ = number;
+  this->sync_directory ();
+  return true;
+}
+
+void
+WAL_Event_Persistence_Factory::sync_directory ()
+{
+#if !defined (ACE_WIN32)
+  ACE_HANDLE handle = ACE_OS::open (this->dir_path_.c_str (), O_RDONLY);
+  if (handle != ACE_INVALID_HANDLE)
+  {
+    ACE_OS::fsync (handle);
+    ACE_OS::close (handle);
+  }
+#endif /* !ACE_WIN32 */
+}
+
+size_t
+WAL_Event_Persistence_Factory::write_batch (ACE_Unbounded_Queue<Record> & batch)
+{
+  ACE_Message_Block * head = 0;
+  ACE_Message_Block * tail = 0;
+  ACE_UINT64 pending = 0;
+  size_t durable = 0;
+  size_t chained = 0;
+
+  Record * record = 0;
+  for (ACE_Unbounded_Queue_Iterator<Record> i (batch);
+       i.next (record) != 0;
+       i.advance ())
+  {
+    Segment * active = this->segment (this->active_segment_);
+    ACE_UINT64 const length = record->data->length ();
+    if (active->size + pending > SEGMENT_HEADER_SIZE
+        && active->size + pending + length > this->segment_size_)
+    {
+      if (!this->flush (head, pending))
+      {
+        return durable;
+      }
+      durable += chained;
+      chained = 0;
+      head = 0;
+      pending = 0;
+      if (!this->start_segment (this->active_segment_ + 1))
+      {
+        // Keep appending to the full segment.
+        ORBSVCS_ERROR ((LM_ERROR,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Segment %u grows past -segment_size.\n"),
+          this->active_segment_
+          ));
+      }
+    }
+
+    pending += length;
+    ++chained;
+    if (head == 0)
+    {
+      head = record->data;
+    }
+    else
+    {
+      tail->cont (record->data);
+    }
+    tail = record->data;
+  }
+
+  if (!this->flush (head, pending))
+  {
+    return durable;
+  }
+  return durable + chained;
+}
+
+bool
+WAL_Event_Persistence_Factory::flush (ACE_Message_Block * chain,
+                                      ACE_UINT64 length)
+{
+  if (chain == 0)
+  {
+    return true;
+  }
+
+  Segment * active = this->segment (this->active_segment_);
+  size_t written = 0;
+  bool const written_all =
+    ACE::write_n (active->handle, chain, &written) != -1 && written == length;
+  bool const synced = written_all && ACE_OS::fsync (active->handle) == 0;
+
+  if (synced)
+  {
+    // Only account for the records once they are on disk.
+    ACE_UINT64 offset = active->size;
+    for (ACE_Message_Block * mb = chain; mb != 0; mb = mb->cont ())
+    {
+      this->apply (reinterpret_cast<const unsigned char *> (mb->rd_ptr ()),
+                   this->active_segment_,
+                   offset);
+      offset += mb->length ();
+    }
+    active->size += length;
+    this->log_bytes_ += length;
+  }
+  else
+  {
+    ORBSVCS_ERROR ((LM_ERROR,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot append to segment %u: %p\n"),
+      this->active_segment_,
+      written_all ? ACE_TEXT ("fsync") : ACE_TEXT ("write")
+      ));
+
+    // Cut off whatever part of the chain reached the segment, so that
+    // no hole ends the scan of the records that follow.  After a failed
+    // sync the pages of the segment cannot be trusted, so carry on in a
+    // new one.
+    bool const truncated =
+      ACE_OS::ftruncate (active->handle,
+                         ACE_Utils::truncate_cast<ACE_OFF_T> (active->size)) == 0
+      && ACE_OS::lseek (active->handle,
+                        ACE_Utils::truncate_cast<ACE_OFF_T> (active->size),
+                        SEEK_SET) != -1;
+    if ((!truncated || written_all)
+        && !this->start_segment (this->active_segment_ + 1))
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+        ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Still appending to segment %u.\n"),
+        this->active_segment_
+        ));
+    }
+  }
+
+  while (chain != 0)
+  {
+    ACE_Message_Block * next = chain->cont ();
+    chain->cont (0);
+    chain = next;
+  }
+  return synced;
+}
+
+void
+WAL_Event_Persistence_Factory::apply (const unsigned char * header,
+                                      ACE_UINT32 number,
+                                      ACE_UINT64 offset)
+{
+  ACE_UINT32 const length = get_uint32 (header);
+  ACE_UINT32 const type = get_uint32 (header + 8);
+  ACE_UINT64 const serial_number = get_uint64 (header + 12);
+  ACE_UINT32 const event_length = get_uint32 (header + 20);
+
+  Extent data;
+  data.segment = number;
+  data.offset = offset + RECORD_HEADER_SIZE;
+  data.length = length;
+
+  Segment * segment = this->segment (number);
+  ACE_Hash_Map_Entry<ACE_UINT64, Slip> * entry = 0;
+  bool const found = this->slips_.find (serial_number, entry) == 0;
+
+  switch (type)
+  {
+    case RT_Store:
+    {
+      // A copy made by compaction replaces the original.
+      if (found)
+      {
+        this->release (entry->int_id_.event);
+        this->release (entry->int_id_.routing_slip);
+        this->slips_.unbind (entry);
+      }
+      Slip slip;
+      slip.event = data;
+      slip.event.length = event_length;
+      slip.routing_slip = data;
+      slip.routing_slip.offset += event_length;
+      slip.routing_slip.length -= event_length;
+      this->slips_.bind (serial_number, slip);
+      segment->references += 2;
+      this->live_bytes_ += length;
+      break;
+    }
+    case RT_Update:
+    {
+      if (found)
+      {
+        this->release (entry->int_id_.routing_slip);
+        entry->int_id_.routing_slip = data;
+        segment->references += 1;
+        this->live_bytes_ += length;
+      }
+      break;
+    }
+    case RT_Remove:
+    {
+      if (found)
+      {
+        this->release (entry->int_id_.event);
+        this->release (entry->int_id_.routing_slip);
+        this->slips_.unbind (entry);
+      }
+      break;
+    }
+  }
+}
+
+void
+WAL_Event_Persistence_Factory::release (const Extent & extent)
+{
+  Segment * segment = this->segment (extent.segment);
+  if (segment != 0)
+  {
+    --segment->references;
+  }
+  this->live_bytes_ -= extent.length;
+}
+
+ACE_Message_Block *
+WAL_Event_Persistence_Factory::read (const Extent & extent)
+{
+  Segment * segment = this->segment (extent.segment);
+  ACE_Message_Block * result = 0;
+  if (segment != 0)
+  {
+    ACE_NEW_RETURN (result, ACE_Message_Block (extent.length), 0);
+    if (ACE_OS::pread (segment->handle,
+                       result->wr_ptr (),
+                       extent.length,
+                       ACE_Utils::truncate_cast<ACE_OFF_T> (extent.offset))
+        == static_cast<ssize_t> (extent.length))
+    {
+      result->wr_ptr (extent.length);
+    }
+    else
+    {
+      ORBSVCS_ERROR ((LM_ERROR,
+        ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Cannot read segment %u: %p\n"),
+        extent.segment,
+        ACE_TEXT ("pread")
+        ));
+      delete result;
+      result = 0;
+    }
+  }
+  return result;
+}
+
+void
+WAL_Event_Persistence_Factory::drop_segments ()
+{
+  // Segments go strictly oldest first, so a remove record never
+  // outlives the store record it cancels.
+  bool dropped = false;
+  while (this->oldest_segment_ != this->active_segment_)
+  {
+    Segment * segment = this->segment (this->oldest_segment_);
+    if (segment != 0)
+    {
+      if (segment->references != 0)
+      {
+        break;
+      }
+      ACE_OS::close (segment->handle);
+      this->log_bytes_ -= segment->size;
+      this->segments_.unbind (this->oldest_segment_);
+      ACE_OS::unlink (this->segment_path (this->oldest_segment_).c_str ());
+      dropped = true;
+    }
+    ++this->oldest_segment_;
+  }
+  if (dropped)
+  {
+    this->sync_directory ();
+  }
+}
+
+void
+WAL_Event_Persistence_Factory::collect ()
+{
+  this->drop_segments ();
+
+  if (this->compact_ratio_ == 0
+      || this->oldest_segment_ == this->active_segment_
+      || this->log_bytes_ <= this->live_bytes_ * this->compact_ratio_)
+  {
+    return;
+  }
+
+  // Copy the events still in the oldest segment to the active one,
+  // with their latest routing slip.
+  ACE_Vector<ACE_UINT64> serial_numbers;
+  for (Slip_Map::iterator i = this->slips_.begin ();
+       i != this->slips_.end ();
+       ++i)
+  {
+    if ((*i).int_id_.event.segment == this->oldest_segment_
+        || (*i).int_id_.routing_slip.segment == this->oldest_segment_)
+    {
+      serial_numbers.push_back ((*i).ext_id_);
+    }
+  }
+
+  ACE_Unbounded_Queue<Record> copies;
+  for (size_t n = 0; n < serial_numbers.size (); ++n)
+  {
+    ACE_Hash_Map_Entry<ACE_UINT64, Slip> * entry = 0;
+    this->slips_.find (serial_numbers[n], entry);
+    ACE_Message_Block * event = this->read (entry->int_id_.event);
+    ACE_Message_Block * routing_slip = this->read (entry->int_id_.routing_slip);
+    Record record;
+    record.data = 0;
+    record.callback = 0;
+    if (event != 0 && routing_slip != 0)
+    {
+      record.data = this->make_record (RT_Store,
+                                       serial_numbers[n],
+                                       event,
+                                       routing_slip);
+    }
+    delete event;
+    delete routing_slip;
+    if (record.data != 0)
+    {
+      copies.enqueue_tail (record);
+    }
+  }
+
+  if (TAO_debug_level > 0)
+  {
+    ORBSVCS_DEBUG ((LM_DEBUG,
+      ACE_TEXT ("(%P|%t) WAL_Event_Persistence: Copying %B events out of segment %u\n"),
+      copies.size (),
+      this->oldest_segment_
+    ));
+  }
+
+  this->write_batch (copies);
+  Record record;
+  while (copies.dequeue_head (record) == 0)
+  {
+    delete record.data;
+  }
+  this->drop_segments ();
+}
+
+ACE_THR_FUNC_RETURN
+WAL_Event_Persistence_Factory::thr_func (void * arg)
+{
+  WAL_Event_Persistence_Factory* factory =
+    static_cast<WAL_Event_Persistence_Factory*> (arg);
+  factory->run ();
+  return 0;
+}
+
+void
+WAL_Event_Persistence_Factory::run ()
+{
+  bool do_more_work = true;
+  while (do_more_work)
+  {
+    ACE_Unbounded_Queue<Record> batch;
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+      while (this->queue_.is_empty () && !this->terminate_thread_)
+      {
+        this->wake_up_thread_.wait ();
+      }
+      if (this->commit_delay_ != ACE_Time_Value::zero
+          && !this->terminate_thread_)
+      {
+        // Let more records share the sync.
+        ace_mon.release ();
+        ACE_OS::sleep (this->commit_delay_);
+        ace_mon.acquire ();
+      }
+      Record record;
+      while (this->queue_.dequeue_head (record) == 0)
+      {
+        batch.enqueue_tail (record);
+      }
+      do_more_work = !this->terminate_thread_ || !batch.is_empty ();
+    }
+
+    if (!batch.is_empty ())
+    {
+      size_t const records = batch.size ();
+      size_t const durable = this->write_batch (batch);
+      if (durable != records)
+      {
+        // The callers of the records that did not make it to disk are
+        // never told that they are persistent.
+        ORBSVCS_ERROR ((LM_ERROR,
+          ACE_TEXT ("(%P|%t) WAL_Event_Persistence: %B of %B records were not persisted.\n"),
+          records - durable,
+          records
+          ));
+      }
+
+      Record record;
+      for (size_t n = 0; batch.dequeue_head (record) == 0; ++n)
+      {
+        delete record.data;
+        if (record.callback != 0 && n < durable)
+        {
+          record.callback->persist_complete ();
+        }
+      }
+
+      this->collect ();
+    }
+  }
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->terminate_thread_ = false;
+  this->thread_active_ = false;
+}
+
+} // End TAO_Notify_Namespace
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+ACE_FACTORY_NAMESPACE_DEFINE (TAO_Notify_Serv,
+                              TAO_Notify_WAL_Event_Persistence,
+                              TAO_Notify::WAL_Event_Persistence)
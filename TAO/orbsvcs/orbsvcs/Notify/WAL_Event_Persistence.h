@@ -0,0 +1,327 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  \file    WAL_Event_Persistence.h
+ *
+ *  An implementation of Event_Persistence_Strategy that appends event
+ *  and routing slip changes to a segmented write ahead log.
+ */
+//=============================================================================
+
+#ifndef WAL_EVENT_PERSISTENCE_H
+#define WAL_EVENT_PERSISTENCE_H
+#include /**/ "ace/pre.h"
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Notify/Event_Persistence_Strategy.h"
+#include "orbsvcs/Notify/Event_Persistence_Factory.h"
+#include "orbsvcs/Notify/Routing_Slip_Persistence_Manager.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/Hash_Map_Manager.h"
+#include "ace/Null_Mutex.h"
+#include "ace/SString.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Time_Value.h"
+#include "ace/Unbounded_Queue.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO_Notify
+{
+  class WAL_Event_Persistence_Factory;
+
+  /// \brief A Routing_Slip_Persistence_Manager for an event kept in the
+  /// log of a WAL_Event_Persistence_Factory.
+  ///
+  /// Each change is queued as a log record and the callback is called
+  /// once the record has been synced.
+  class TAO_Notify_Serv_Export WAL_Routing_Slip_Persistence_Manager :
+    public Routing_Slip_Persistence_Manager
+  {
+  public:
+    /// Constructor
+    WAL_Routing_Slip_Persistence_Manager (
+      WAL_Event_Persistence_Factory * factory,
+      ACE_UINT64 serial_number);
+    /// Destructor
+    virtual ~WAL_Routing_Slip_Persistence_Manager ();
+
+    /////////////////////////////////////////////////////////
+    // Override Routing_Slip_Persistence_Manager virtual methods.
+    virtual void set_callback (Persistent_Callback* callback);
+
+    virtual bool store (const ACE_Message_Block& event,
+      const ACE_Message_Block& routing_slip);
+
+    virtual bool update (const ACE_Message_Block& routing_slip);
+
+    virtual bool remove ();
+
+    virtual bool reload (ACE_Message_Block*& event,
+      ACE_Message_Block*& routing_slip);
+
+    virtual Routing_Slip_Persistence_Manager * load_next ();
+
+  private:
+    friend class WAL_Event_Persistence_Factory;
+
+    TAO_SYNCH_MUTEX lock_;
+    WAL_Event_Persistence_Factory * factory_;
+    ACE_UINT64 serial_number_;
+    Persistent_Callback * callback_;
+    bool stored_;
+    bool removed_;
+
+    /// Set during reload only.  If these are non-zero we own 'em
+    ACE_Message_Block * event_mb_;
+    ACE_Message_Block * routing_slip_mb_;
+    WAL_Routing_Slip_Persistence_Manager * next_reload_;
+  };
+
+  /**
+   * \brief An Event_Persistence_Factory that keeps events in an append
+   * only log.
+   *
+   * The log is a directory of segment files.  Stores, updates and
+   * removes of routing slips are appended to the newest segment by a
+   * writer thread, which syncs the segment once for all the records
+   * queued while the previous sync was in progress and only then calls
+   * their callbacks.
+   *
+   * A segment is deleted once it is the oldest one and holds nothing
+   * that is still needed.  When the log grows past a multiple of the
+   * data still needed, the events left in the oldest segment are
+   * copied to the newest one so that it can go.
+   *
+   * At startup the segments are scanned from oldest to newest.  A
+   * record that was not completely synced ends the scan of its segment.
+   */
+  class TAO_Notify_Serv_Export WAL_Event_Persistence_Factory :
+    public Event_Persistence_Factory
+  {
+  public:
+    /// The kinds of log record.
+    enum Record_Type
+    {
+      RT_Store = 1,
+      RT_Update,
+      RT_Remove
+    };
+
+    /// Constructor
+    WAL_Event_Persistence_Factory ();
+    /// Destructor
+    virtual ~WAL_Event_Persistence_Factory ();
+
+    /// Recover the log in a directory and start the writer thread.
+    /// \param dir_path the directory that holds the segments.  It is
+    ///        created if need be.
+    /// \param segment_size the size in bytes at which a new segment is
+    ///        started.
+    /// \param commit_delay how long the writer waits for more records
+    ///        before it syncs.
+    /// \param compact_ratio how many times the size of the events still
+    ///        needed the log may grow to.  Zero never copies events.
+    bool open (const ACE_TCHAR* dir_path,
+      ACE_UINT64 segment_size,
+      const ACE_Time_Value & commit_delay,
+      ACE_UINT32 compact_ratio);
+
+    /// \brief Wait for the queued records to be synced and terminate
+    /// the writer thread.
+    void shutdown ();
+
+    //////////////////////////////////////////////////////
+    // Implement Event_Persistence_Factory virtual methods.
+    virtual Routing_Slip_Persistence_Manager*
+      create_routing_slip_persistence_manager (Persistent_Callback* callback);
+
+    virtual Routing_Slip_Persistence_Manager * first_reload_manager ();
+
+    /// Queue a record and call @a callback once it has been synced.
+    /// Intended for use only by WAL_Routing_Slip_Persistence_Manager.
+    bool append (Record_Type type,
+      ACE_UINT64 serial_number,
+      const ACE_Message_Block * event,
+      const ACE_Message_Block * routing_slip,
+      Persistent_Callback * callback);
+
+  private:
+    /// A segment file.
+    struct Segment
+    {
+      ACE_HANDLE handle;
+      /// Bytes written so far.
+      ACE_UINT64 size;
+      /// How many events and routing slips still needed it holds.
+      size_t references;
+    };
+
+    /// Where some data is in the log.
+    struct Extent
+    {
+      ACE_UINT32 segment;
+      ACE_UINT64 offset;
+      ACE_UINT32 length;
+    };
+
+    /// Where the event and the latest routing slip of a live event are.
+    struct Slip
+    {
+      Extent event;
+      Extent routing_slip;
+    };
+
+    /// A record waiting for the writer thread.
+    struct Record
+    {
+      ACE_Message_Block * data;
+      Persistent_Callback * callback;
+    };
+
+    typedef ACE_Hash_Map_Manager_Ex<ACE_UINT32,
+                                    Segment,
+                                    ACE_Hash<ACE_UINT32>,
+                                    ACE_Equal_To<ACE_UINT32>,
+                                    ACE_Null_Mutex> Segment_Map;
+
+    typedef ACE_Hash_Map_Manager_Ex<ACE_UINT64,
+                                    Slip,
+                                    ACE_Hash<ACE_UINT64>,
+                                    ACE_Equal_To<ACE_UINT64>,
+                                    ACE_Null_Mutex> Slip_Map;
+
+    /// Build a record with its header in front of the data.
+    ACE_Message_Block * make_record (Record_Type type,
+      ACE_UINT64 serial_number,
+      const ACE_Message_Block * event,
+      const ACE_Message_Block * routing_slip);
+
+    /// The name of a segment file.
+    ACE_TString segment_path (ACE_UINT32 number) const;
+
+    /// The segment with this number, or 0.
+    Segment * segment (ACE_UINT32 number);
+
+    /// Read the segments found in the directory into slips_.
+    bool recover ();
+
+    /// Apply the records of a segment up to the first one that is not
+    /// complete.
+    bool scan (ACE_UINT32 number);
+
+    /// Make reload managers for the slips found by recover().
+    bool prepare_reload ();
+
+    /// Start a new segment to append to.
+    bool start_segment (ACE_UINT32 number);
+
+    /// Make file creations and deletions in the directory durable.
+    void sync_directory ();
+
+    /// Append records to the log and sync it.
+    /// \return how many records, from the head of @a batch, are on disk.
+    ///         The others were not written.
+    size_t write_batch (ACE_Unbounded_Queue<Record> & batch);
+
+    /// Write a chain of records linked through cont() at the end of the
+    /// active segment, sync it and account for the records.  On failure
+    /// the segment is cut back to its previous size, or a new segment
+    /// is started, and the records are not accounted for.
+    bool flush (ACE_Message_Block * chain, ACE_UINT64 length);
+
+    /// Account for the synced record with @a header written at
+    /// @a offset of segment @a number.
+    void apply (const unsigned char * header,
+      ACE_UINT32 number,
+      ACE_UINT64 offset);
+
+    /// A segment no longer holds an extent.
+    void release (const Extent & extent);
+
+    /// Read the data of an extent.
+    ACE_Message_Block * read (const Extent & extent);
+
+    /// Delete the oldest segments while nothing in them is needed.
+    void drop_segments ();
+
+    /// Drop the segments that are no longer needed, copying the live
+    /// events out of the oldest one if the log has grown too large.
+    void collect ();
+
+    /// Used during thread startup to cast us back to ourselves and call
+    /// the run() method.
+    static ACE_THR_FUNC_RETURN thr_func (void * arg);
+    /// The writer's execution thread.
+    void run ();
+
+  private:
+    ACE_TString dir_path_;
+    ACE_UINT64 segment_size_;
+    ACE_Time_Value commit_delay_;
+    ACE_UINT32 compact_ratio_;
+
+    /// Guards the serial numbers and the queue.
+    TAO_SYNCH_MUTEX lock_;
+    ACE_SYNCH_CONDITION wake_up_thread_;
+    ACE_Unbounded_Queue<Record> queue_;
+    ACE_UINT64 next_serial_number_;
+    bool terminate_thread_;
+    bool thread_active_;
+    ACE_Thread_Manager thread_manager_;
+
+    /// Used by the writer thread only once it runs.
+    Segment_Map segments_;
+    ACE_UINT32 oldest_segment_;
+    ACE_UINT32 active_segment_;
+    Slip_Map slips_;
+    ACE_UINT64 log_bytes_;
+    ACE_UINT64 live_bytes_;
+
+    /// The managers left to reload.
+    WAL_Routing_Slip_Persistence_Manager * reload_;
+  };
+
+  /// \brief The write ahead log implementation of the
+  /// Event_Persistence_Strategy interface.
+  class TAO_Notify_Serv_Export WAL_Event_Persistence :
+    public Event_Persistence_Strategy
+  {
+  public :
+    /// Constructor.
+    WAL_Event_Persistence ();
+    /// Destructor.
+    virtual ~WAL_Event_Persistence ();
+    /////////////////////////////////////////////
+    // Override Event_Persistent_Strategy methods
+    // Parse arguments and initialize.
+    virtual int init (int argc, ACE_TCHAR *argv[]);
+    // Prepare for shutdown
+    virtual int fini ();
+
+    // get the current factory, creating it if necessary
+    virtual Event_Persistence_Factory * get_factory ();
+
+  private:
+    // release the current factory so a new one can be created
+    virtual void reset ();
+
+    ACE_TString dir_path_;        // set via -dir_path
+    ACE_UINT64 segment_size_;     // set via -segment_size
+    ACE_Time_Value commit_delay_; // set via -commit_delay
+    ACE_UINT32 compact_ratio_;    // set via -compact_ratio
+    WAL_Event_Persistence_Factory * factory_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+ACE_FACTORY_DECLARE (TAO_Notify_Serv, TAO_Notify_WAL_Event_Persistence)
+
+#include /**/ "ace/post.h"
+#endif /* WAL_EVENT_PERSISTENCE_H */
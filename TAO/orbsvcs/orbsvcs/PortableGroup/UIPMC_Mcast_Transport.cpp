@@ -21,6 +21,9 @@ TAO_UIPMC_Mcast_Transport::TAO_UIPMC_Mcast_Transport (
   : TAO_Transport (IOP::TAG_UIPMC,
                    orb_core)
   , connection_handler_ (handler)
+  , recv_blocks_ (0)
+  , recv_addrs_ (0)
+  , recv_batch_size_ (0u)
 {
   // Replace the default wait strategy with our own
   // since we don't support waiting on anything.
@@ -45,6 +48,9 @@ TAO_UIPMC_Mcast_Transport::~TAO_UIPMC_Mcast_Transport ()
           delete packet;
         }
     }
+
+  delete [] this->recv_blocks_;
+  delete [] this->recv_addrs_;
 }
 
 void
@@ -146,33 +152,22 @@ int TAO_UIPMC_Mcast_Transport::send_message (
 }
 
 char *
-TAO_UIPMC_Mcast_Transport::recv_packet (
+TAO_UIPMC_Mcast_Transport::parse_packet (
   char *buf,
-  size_t len,
-  ACE_INET_Addr &from_addr,
+  size_t n,
   CORBA::UShort &packet_length,
   CORBA::ULong &packet_number,
   bool &stop_packet,
   u_long &id_hash) const
 {
-  // We read the whole MIOP packet which is not longer than MIOP_MAX_DGRAM_SIZE.
-  ssize_t const n =
-    this->connection_handler_->peer ().recv (buf,
-                                             len,
-                                             from_addr);
-
-  // There is nothing left in the socket buffer.
-  if (n <= 0)
-    return 0;
-
   // Make sure that we at least have a MIOP header.
-  if (static_cast<size_t> (n) < MIOP_MIN_HEADER_SIZE)
+  if (n < MIOP_MIN_HEADER_SIZE)
     {
       if (TAO_debug_level)
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet of size %d is ")
+                      ACE_TEXT ("parse_packet, packet of size %B is ")
                       ACE_TEXT ("too small\n"),
                       this->id (),
                       n));
@@ -197,7 +192,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet didn't contain ")
+                      ACE_TEXT ("parse_packet, packet didn't contain ")
                       ACE_TEXT ("magic bytes\n"),
                       this->id ()));
         }
@@ -215,7 +210,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet has wrong version ")
+                      ACE_TEXT ("parse_packet, packet has wrong version ")
                       ACE_TEXT ("%d.%d\n"),
                       this->id (),
                       (miop_version >> 4) & 0xf,
@@ -255,14 +250,14 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, malformed packet\n"),
+                      ACE_TEXT ("parse_packet, malformed packet\n"),
                       this->id ()));
         }
 
       return 0;
     }
 
-  ssize_t const miop_header_size =
+  size_t const miop_header_size =
     (MIOP_ID_CONTENT_OFFSET + id_length + 7) & ~0x7;
   if (miop_header_size > n)
     {
@@ -270,7 +265,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet not large enough ")
+                      ACE_TEXT ("parse_packet, packet not large enough ")
                       ACE_TEXT ("for padding\n"),
                       this->id ()));
         }
@@ -310,138 +305,189 @@ TAO_UIPMC_Mcast_Transport::recv_all (TAO_Resume_Handle &rh)
   // FUZZ: enable check_for_ACE_Guard
   if (recv_guard.locked ())
     {
-      // The buffer on the stack which will be used to hold the input
-      // messages.
-      char buf [MIOP_MAX_DGRAM_SIZE + ACE_CDR::MAX_ALIGNMENT];
-      char *aligned_buf = ACE_ptr_align_binary (buf, ACE_CDR::MAX_ALIGNMENT);
+      // The buffers which will be used to hold the input messages.
+      if (this->recv_batch_size_ == 0u)
+        {
+          u_long const batch_size = factory->fragment_batch_size ();
+          delete [] this->recv_blocks_;
+          this->recv_blocks_ = 0;
+          delete [] this->recv_addrs_;
+          this->recv_addrs_ = 0;
+          ACE_NEW_THROW_EX (this->recv_addrs_,
+                            ACE_INET_Addr[batch_size],
+                            CORBA::NO_MEMORY (
+                              CORBA::SystemException::_tao_minor_code (
+                                TAO::VMCID,
+                                ENOMEM),
+                              CORBA::COMPLETED_NO));
+          ACE_NEW_THROW_EX (this->recv_blocks_,
+                            ACE_Message_Block[batch_size],
+                            CORBA::NO_MEMORY (
+                              CORBA::SystemException::_tao_minor_code (
+                                TAO::VMCID,
+                                ENOMEM),
+                              CORBA::COMPLETED_NO));
+          for (u_long i = 0u; i < batch_size; ++i)
+            if (this->recv_blocks_[i].init (MIOP_MAX_DGRAM_SIZE +
+                                            ACE_CDR::MAX_ALIGNMENT) == -1)
+              throw CORBA::NO_MEMORY (
+                CORBA::SystemException::_tao_minor_code (
+                  TAO::VMCID,
+                  ENOMEM),
+                CORBA::COMPLETED_NO);
+          this->recv_batch_size_ = batch_size;
+        }
 
-#if defined (ACE_INITIALIZE_MEMORY_BEFORE_USE)
-      (void) ACE_OS::memset (buf, '\0', sizeof buf);
-#endif /* ACE_INITIALIZE_MEMORY_BEFORE_USE */
+      ACE_Message_Block *blocks[MIOP_MAX_FRAGMENT_BATCH_SIZE];
 
       while (true)
         {
-          // This guard will cleanup expired packets each iteration.
-          TAO_PG::UIPMC_Recv_Packet_Cleanup_Guard guard (this);
-
-          ACE_INET_Addr from_addr;
-          CORBA::UShort packet_length;
-          CORBA::ULong packet_number = 0;
-          bool stop_packet = false;
-          u_long id_hash;
+          for (u_long i = 0u; i < this->recv_batch_size_; ++i)
+            {
+              // The MIOP header is read with CDR so the data must be
+              // properly aligned.
+              this->recv_blocks_[i].reset ();
+              ACE_CDR::mb_align (&this->recv_blocks_[i]);
+              blocks[i] = &this->recv_blocks_[i];
+            }
 
-          char *start_data =
-            this->recv_packet (aligned_buf, MIOP_MAX_DGRAM_SIZE, from_addr,
-                               packet_length, packet_number, stop_packet, id_hash);
+          // We read whole MIOP packets which are not longer than
+          // MIOP_MAX_DGRAM_SIZE, as many as are waiting and fit.
+          ssize_t const count =
+            this->connection_handler_->peer ().recv_n_msgs (
+              blocks,
+              this->recv_batch_size_,
+              this->recv_addrs_);
 
           // The socket buffer is empty. Try to do other useful things.
-          if (start_data == 0)
+          if (count <= 0)
             {
               if (errno != EWOULDBLOCK && errno != EAGAIN)
                 {
                   ORBSVCS_DEBUG ((LM_DEBUG,
                               ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                              ACE_TEXT ("recv_all, unexpected failure of recv_packet (Errno: '%m')\n"),
+                              ACE_TEXT ("recv_all, unexpected failure of recv_n_msgs (Errno: '%m')\n"),
                               this->id ()));
                 }
               break;
             }
 
-          if (TAO_debug_level >= 9)
+          for (ssize_t i = 0; i < count; ++i)
             {
-              char tmp[INET6_ADDRSTRLEN];
-              from_addr.get_host_addr (tmp, sizeof tmp);
-              ORBSVCS_DEBUG ((LM_DEBUG,
-                          ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                          ACE_TEXT ("recv, received %d bytes from <%C:%u> ")
-                          ACE_TEXT ("(hash %d)\n"),
-                          this->id (),
-                          packet_length,
-                          tmp,
-                          from_addr.get_port_number (),
-                          id_hash));
-            }
+              // This guard will cleanup expired packets each iteration.
+              TAO_PG::UIPMC_Recv_Packet_Cleanup_Guard guard (this);
+
+              ACE_INET_Addr const &from_addr = this->recv_addrs_[i];
+              CORBA::UShort packet_length;
+              CORBA::ULong packet_number = 0;
+              bool stop_packet = false;
+              u_long id_hash;
+
+              // Malformed packets are simply dropped.
+              char *start_data =
+                this->parse_packet (blocks[i]->rd_ptr (), blocks[i]->length (),
+                                    packet_length, packet_number, stop_packet, id_hash);
+              if (start_data == 0)
+                continue;
 
-          TAO_PG::UIPMC_Recv_Packet *packet = 0;
-          if (this->incomplete_.find (id_hash, packet) == -1)
-            {
-              ACE_NEW_THROW_EX (packet,
-                                TAO_PG::UIPMC_Recv_Packet,
-                                CORBA::NO_MEMORY (
-                                  CORBA::SystemException::_tao_minor_code (
-                                    TAO::VMCID,
-                                    ENOMEM),
-                                  CORBA::COMPLETED_NO));
-
-              if (this->incomplete_.bind (id_hash, packet) != 0)
+              if (TAO_debug_level >= 9)
                 {
-                  // Cleanup the packet.
-                  delete packet;
+                  char tmp[INET6_ADDRSTRLEN];
+                  from_addr.get_host_addr (tmp, sizeof tmp);
                   ORBSVCS_DEBUG ((LM_DEBUG,
                               ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                              ACE_TEXT ("recv_all, could not queue fragment\n"),
-                              this->id ()));
-                  continue;
+                              ACE_TEXT ("recv, received %d bytes from <%C:%u> ")
+                              ACE_TEXT ("(hash %d)\n"),
+                              this->id (),
+                              packet_length,
+                              tmp,
+                              from_addr.get_port_number (),
+                              id_hash));
                 }
-            }
-
-          // We have incomplete packet so add the new data to it.
-          // add_fragment returns 1 iff the packet is complete.
-          if (1 == packet->add_fragment (start_data, packet_length,
-                                         packet_number, stop_packet))
-            {
-              // Remove this packet from incomplete packets.
-              this->incomplete_.unbind (id_hash);
 
-              // If there are no completed message ahead of us AND
-              // we only want a single message, just return it.
-              if (this->complete_.is_empty () && !eager_dequeue)
+              TAO_PG::UIPMC_Recv_Packet *packet = 0;
+              if (this->incomplete_.find (id_hash, packet) == -1)
                 {
-                  if (TAO_debug_level >= 9)
+                  ACE_NEW_THROW_EX (packet,
+                                    TAO_PG::UIPMC_Recv_Packet,
+                                    CORBA::NO_MEMORY (
+                                      CORBA::SystemException::_tao_minor_code (
+                                        TAO::VMCID,
+                                        ENOMEM),
+                                      CORBA::COMPLETED_NO));
+
+                  if (this->incomplete_.bind (id_hash, packet) != 0)
                     {
+                      // Cleanup the packet.
+                      delete packet;
                       ORBSVCS_DEBUG ((LM_DEBUG,
                                   ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                                  ACE_TEXT ("recv_all, completed MIOP message %@\n"),
-                                  this->id (), static_cast<void *> (packet)));
+                                  ACE_TEXT ("recv_all, could not queue fragment\n"),
+                                  this->id ()));
+                      continue;
                     }
-
-                  return packet;
                 }
-              ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
-                                guard,
-                                this->complete_lock_,
-                                packet);
-              if (this->complete_.is_empty () && !eager_dequeue)
+
+              // We have incomplete packet so add the new data to it.
+              // add_fragment returns 1 iff the packet is complete.
+              if (1 == packet->add_fragment (start_data, packet_length,
+                                             packet_number, stop_packet))
                 {
-                  // Another thread dequeued the waiting MIOP message before we got
-                  // the lock, simply return our single message, don't bother queueing
-                  // it after all.
+                  // Remove this packet from incomplete packets.
+                  this->incomplete_.unbind (id_hash);
+
+                  // If there are no completed message ahead of us AND
+                  // we only want a single message, just return it. The
+                  // rest of the batch must be processed first, though.
+                  bool const last_in_batch = (i + 1 == count);
+                  if (last_in_batch && this->complete_.is_empty () && !eager_dequeue)
+                    {
+                      if (TAO_debug_level >= 9)
+                        {
+                          ORBSVCS_DEBUG ((LM_DEBUG,
+                                      ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
+                                      ACE_TEXT ("recv_all, completed MIOP message %@\n"),
+                                      this->id (), static_cast<void *> (packet)));
+                        }
+
+                      return packet;
+                    }
+                  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                                    guard,
+                                    this->complete_lock_,
+                                    packet);
+                  if (last_in_batch && this->complete_.is_empty () && !eager_dequeue)
+                    {
+                      // Another thread dequeued the waiting MIOP message before we got
+                      // the lock, simply return our single message, don't bother queueing
+                      // it after all.
+                      if (TAO_debug_level >= 9)
+                        {
+                          ORBSVCS_DEBUG ((LM_DEBUG,
+                                      ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
+                                      ACE_TEXT ("recv_all, completed MIOP message %@\n"),
+                                      this->id (), static_cast<void *> (packet)));
+                        }
+
+                      return packet;
+                    }
+
                   if (TAO_debug_level >= 9)
                     {
                       ORBSVCS_DEBUG ((LM_DEBUG,
                                   ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                                  ACE_TEXT ("recv_all, completed MIOP message %@\n"),
+                                  ACE_TEXT ("recv_all, completed MIOP message %@ (QUEUED)\n"),
                                   this->id (), static_cast<void *> (packet)));
                     }
 
-                  return packet;
+                  // Add it to the complete queue.
+                  this->complete_.enqueue_tail (packet);
                 }
-
-              if (TAO_debug_level >= 9)
-                {
-                  ORBSVCS_DEBUG ((LM_DEBUG,
-                              ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                              ACE_TEXT ("recv_all, completed MIOP message %@ (QUEUED)\n"),
-                              this->id (), static_cast<void *> (packet)));
-                }
-
-              // Add it to the complete queue.
-              this->complete_.enqueue_tail (packet);
-
-              // Stop attempting to queue more messages if we are not in eager mode.
-              if (!eager_dequeue)
-                break;
             }
+
+          // Stop attempting to queue more messages if we are not in eager mode.
+          if (!eager_dequeue && !this->complete_.is_empty ())
+            break;
         }
       recv_guard.release ();
     }
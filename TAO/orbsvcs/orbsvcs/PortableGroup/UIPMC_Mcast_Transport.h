@@ -105,15 +105,14 @@ public:
   //@}
 
 private:
-  /// Receive a UDP message and extract all necessary info from the MIOP
-  /// header. If everything is fine return a pointer to the first byte of
-  /// the non-MIOP data.
-  char *recv_packet (char *buf, size_t len,
-                     ACE_INET_Addr &from_addr,
-                     CORBA::UShort &packet_length,
-                     CORBA::ULong &packet_number,
-                     bool &stop_packet,
-                     u_long &id_hash) const;
+  /// Extract all necessary info from the MIOP header of the @a n byte
+  /// UDP message in @a buf. If everything is fine return a pointer to
+  /// the first byte of the non-MIOP data.
+  char *parse_packet (char *buf, size_t n,
+                      CORBA::UShort &packet_length,
+                      CORBA::ULong &packet_number,
+                      bool &stop_packet,
+                      u_long &id_hash) const;
 
   /// Return the next complete MIOP packet, possibly dequeueing
   /// as many as are available first from the socket.
@@ -134,6 +133,13 @@ private:
   /// A lock for ensuring that only one thread is doing recv.
   TAO_SYNCH_MUTEX recv_lock_;
 
+  /// Buffers and sender addresses of the UDP messages received by a
+  /// single system call. Allocated on first use and only accessed
+  /// with recv_lock_ held.
+  ACE_Message_Block *recv_blocks_;
+  ACE_INET_Addr *recv_addrs_;
+  u_long recv_batch_size_;
+
   /// Complete packets.
   typedef ACE_Unbounded_Queue<TAO_PG::UIPMC_Recv_Packet *> Packets_Queue;
   Packets_Queue complete_;
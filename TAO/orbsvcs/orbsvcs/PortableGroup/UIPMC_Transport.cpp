@@ -280,88 +280,98 @@ TAO_UIPMC_Transport::send (
       return -1;
     }
 
-  // Attempt to partition up the payload data sending each of the MIOP fragments
-  iovec this_fragment_iov[ACE_IOV_MAX];
+  // Attempt to partition up the payload data sending the MIOP fragments
+  // in batches of up to "fragment_batch_size" datagrams per system call.
+  // Every fragment of a batch needs its own copy of the MIOP header.
+  iovec this_batch_iov[ACE_IOV_MAX];
+  int this_batch_iovcnt[MIOP_MAX_FRAGMENT_BATCH_SIZE];
+  char this_batch_headers[MIOP_MAX_FRAGMENT_BATCH_SIZE][MIOP_DEFAULT_HEADER_SIZE];
+  u_long const batch_size = factory->fragment_batch_size ();
   UIPMC_Message_Block_Data_Iterator mb_iter (iov, iovcnt);
   ACE_INET_Addr const &addr = this->connection_handler_->addr ();
-  for (*packet_number= 0u;
-       *packet_number < number_of_packets_required;
-       ++*packet_number)
+  *packet_number= 0u;
+  while (*packet_number < number_of_packets_required)
     {
-      // The first iov for each packet points at the static MIOP header.
-      this_fragment_iov[0].iov_base = miop_hdr.current ()->rd_ptr ();
-      this_fragment_iov[0].iov_len  = MIOP_DEFAULT_HEADER_SIZE;
-      int this_fragment_iovcnt = 1;   // Just the MIOP Header so far!
-      u_long this_fragment_size= 0uL; // Just the payload data length (for now)
-
-      // Obtain the next fragment's payload data.
-      while (mb_iter.next_block (max_fragment_payload - this_fragment_size,
-                                 this_fragment_iov[this_fragment_iovcnt]))
+      CORBA::ULong const first_packet_number = *packet_number;
+      u_long this_batch_fragments = 0u;
+      int this_batch_total_iovcnt = 0;
+      u_long this_batch_size = 0uL; // Including the MIOP headers
+      u_long this_batch_payload = 0uL;
+
+      // Keep adding fragments while there is room in the iovec for the
+      // worst case fragment, which needs one entry per input iovec plus
+      // the MIOP header.
+      do
         {
-          // Increment the fragments length and iovcnt.
-          this_fragment_size +=
-            this_fragment_iov[this_fragment_iovcnt++].iov_len;
+          iovec *const this_fragment_iov = &this_batch_iov[this_batch_total_iovcnt];
+          int this_fragment_iovcnt = 1;   // Just the MIOP Header so far!
+          u_long this_fragment_size= 0uL; // Just the payload data length (for now)
 
-          // Check if we have maxed out this fragment's payload.
-          if (this_fragment_size == max_fragment_payload)
-            break;
-
-          // Just a safety check for building iovec.
-          if (this_fragment_iovcnt >= ACE_IOV_MAX)
+          // Obtain the next fragment's payload data.
+          while (mb_iter.next_block (max_fragment_payload - this_fragment_size,
+                                     this_fragment_iov[this_fragment_iovcnt]))
             {
-              ORBSVCS_DEBUG ((LM_ERROR,
-                          ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
-                          ACE_TEXT ("Too many iovec to create fragment.\n"),
-                          this->id ()));
-              return -1;
-            }
-        } // While fragment is not complete
-
-      // Now we have the payload length for this fragment, update the MIOP header
-      *packet_length = static_cast<CORBA::UShort> (this_fragment_size);
-      if (*packet_number == number_of_packets_required-1uL)
-        *flags_field |= 0x02;
-
-      ssize_t already_sent = 0; // No data sent yet!
-      iovec *current_iov= this_fragment_iov;
-      for (this_fragment_size+= MIOP_DEFAULT_HEADER_SIZE; // Now includes MIOP header
-           this_fragment_size; // Still any data to send
-           this_fragment_size-= static_cast<u_long> (already_sent))
+              // Increment the fragments length and iovcnt.
+              this_fragment_size +=
+                this_fragment_iov[this_fragment_iovcnt++].iov_len;
+
+              // Check if we have maxed out this fragment's payload.
+              if (this_fragment_size == max_fragment_payload)
+                break;
+
+              // Just a safety check for building iovec.
+              if (this_batch_total_iovcnt + this_fragment_iovcnt >= ACE_IOV_MAX)
+                {
+                  ORBSVCS_DEBUG ((LM_ERROR,
+                              ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
+                              ACE_TEXT ("Too many iovec to create fragment.\n"),
+                              this->id ()));
+                  return -1;
+                }
+            } // While fragment is not complete
+
+          // Now we have the payload length for this fragment, update the
+          // MIOP header and take this fragment's copy of it.
+          *packet_length = static_cast<CORBA::UShort> (this_fragment_size);
+          if (*packet_number == number_of_packets_required-1uL)
+            *flags_field |= 0x02;
+          ACE_OS::memcpy (this_batch_headers[this_batch_fragments],
+                          miop_hdr.current ()->rd_ptr (),
+                          MIOP_DEFAULT_HEADER_SIZE);
+          this_fragment_iov[0].iov_base = this_batch_headers[this_batch_fragments];
+          this_fragment_iov[0].iov_len  = MIOP_DEFAULT_HEADER_SIZE;
+
+          this_batch_iovcnt[this_batch_fragments++] = this_fragment_iovcnt;
+          this_batch_total_iovcnt += this_fragment_iovcnt;
+          this_batch_payload += this_fragment_size;
+          this_batch_size += this_fragment_size + MIOP_DEFAULT_HEADER_SIZE;
+          ++*packet_number;
+        }
+      while (*packet_number < number_of_packets_required &&
+             this_batch_fragments < batch_size &&
+             this_batch_total_iovcnt + iovcnt + 1 <= ACE_IOV_MAX);
+
+      // Make sure we don't send our fragments too quickly
+      if (factory->enable_throttling ())
+        this->throttle_send_rate (
+          factory->max_fragment_rate (),
+          max_fragment_size,
+          this_batch_size);
+
+      // Ok now we attempt to actually send the fragments, resending
+      // those the socket did not take the first time around.
+      iovec *current_iov = this_batch_iov;
+      int *current_iovcnt = this_batch_iovcnt;
+      u_long unsent = this_batch_fragments;
+      while (unsent)
         {
-          // Make sure we don't send our fragments too quickly
-          if (factory->enable_throttling ())
-            this->throttle_send_rate (
-              factory->max_fragment_rate (),
-              max_fragment_size,
-              this_fragment_size);
-
-          // Haven't sent some of the data yet, we need to adjust the fragments iov's
-          // to skip the data we have actually manage to send so far.
-          while (already_sent)
-            if (static_cast<u_long> (current_iov->iov_len) <= static_cast<u_long> (already_sent))
-              {
-                // This whole iov has been sent, simply skip over it
-                already_sent-= current_iov->iov_len;
-                --this_fragment_iovcnt;
-                ++current_iov;
-              }
-            else
-              {
-                // This iov has been partially sent, adjust it's data
-                // to skip over those bytes already transmitted.
-                current_iov->iov_len -= static_cast<u_long> (already_sent);
-                current_iov->iov_base =
-                  &static_cast<char *> (current_iov->iov_base)[already_sent];
-                break; // already_sent= 0;
-              }
-
-          // Ok now we attempt to actually send the fragment.
-          already_sent =
-            this->connection_handler_->peer ().send (
+          ssize_t const sent =
+            this->connection_handler_->peer ().send_n_msgs (
               current_iov,
-              this_fragment_iovcnt,
+              current_iovcnt,
+              unsent,
               addr);
-          if (already_sent < 0)
+          if (sent < 0)
             {
               ORBSVCS_DEBUG ((LM_ERROR,
                           ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
@@ -369,25 +379,30 @@ TAO_UIPMC_Transport::send (
                           this->id ()));
               return -1;
             }
-          else if (TAO_debug_level &&
-                   static_cast<u_long> (already_sent) != this_fragment_size)
+
+          for (ssize_t i = 0; i < sent; ++i)
+            current_iov += current_iovcnt[i];
+          current_iovcnt += sent;
+          unsent -= static_cast<u_long> (sent);
+
+          if (TAO_debug_level && unsent)
             {
               ORBSVCS_DEBUG ((LM_DEBUG,
                           ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
-                          ACE_TEXT ("Partial fragment (%B/%u bytes), ")
+                          ACE_TEXT ("Partial batch (%B/%u fragments), ")
                           ACE_TEXT ("reattempting remainder.\n"),
                           this->id (),
-                          already_sent,
-                          this_fragment_size));
+                          sent,
+                          unsent + static_cast<u_long> (sent)));
             }
+        } // Keep sending the rest of the batch
 
-          // Keep a note of the number of bytes we have just buffered
-          if (factory->enable_throttling ())
-            this->total_bytes_outstanding_+= static_cast<u_long> (already_sent);
-        } // Keep sending the rest of the fragment
+      // Keep a note of the number of bytes we have just buffered
+      if (factory->enable_throttling ())
+        this->total_bytes_outstanding_+= this_batch_size;
 
       // Increment the number of bytes of payload transferred.
-      bytes_transferred += *packet_length;
+      bytes_transferred += this_batch_payload;
 
       if (9 <= TAO_debug_level)
         {
@@ -395,15 +410,16 @@ TAO_UIPMC_Transport::send (
           addr.get_host_addr (tmp, sizeof tmp);
           ORBSVCS_DEBUG ((LM_DEBUG,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Transport[%d]::send, ")
-                      ACE_TEXT ("Sent %u bytes payload (fragment %u/%u) to <%C:%u>\n"),
+                      ACE_TEXT ("Sent %u bytes payload (fragments %u-%u/%u) to <%C:%u>\n"),
                       this->id (),
-                      *packet_length,
-                      *packet_number + 1uL,
+                      this_batch_payload,
+                      first_packet_number + 1uL,
+                      static_cast<u_long> (*packet_number),
                       number_of_packets_required,
                       tmp,
                       addr.get_port_number ()));
         }
-    } // Send next fragment
+    } // Send next batch
 
   // Return total bytes transferred.
   return bytes_transferred;
@@ -21,6 +21,7 @@ TAO_MIOP_Resource_Factory::TAO_MIOP_Resource_Factory ()
   , receive_buffer_size_ (0u) // Zero is unspecified (-ORBRcvSock).
   , enable_throttling_    (!!(TAO_DEFAULT_MIOP_SEND_THROTTLING))  // Client-side SendRate throttling enabled.
   , enable_eager_dequeue_ (!!(TAO_DEFAULT_MIOP_EAGER_DEQUEUEING)) // Server-side Multiple message dequeueing.
+  , fragment_batch_size_ (TAO_DEFAULT_MIOP_FRAGMENT_BATCH_SIZE)
 {
 }
 
@@ -262,6 +263,32 @@ TAO_MIOP_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
                         ACE_TEXT ("%s missing 0 or 1 parameter.\n"),
                         argv[curarg-1]));
         }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-ORBFragmentBatchSize")) == 0)
+        {
+          if (++curarg < argc)
+            {
+              int const batch= ACE_OS::atoi (argv[curarg]);
+              if (batch < 1 ||
+                  batch > static_cast<int> (MIOP_MAX_FRAGMENT_BATCH_SIZE))
+                {
+                  ORBSVCS_DEBUG ((LM_ERROR,
+                              ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
+                              ACE_TEXT ("-ORBFragmentBatchSize %d is not within ")
+                              ACE_TEXT ("range 1 to %u (using %u).\n"),
+                              batch,
+                              MIOP_MAX_FRAGMENT_BATCH_SIZE,
+                              TAO_DEFAULT_MIOP_FRAGMENT_BATCH_SIZE));
+                  this->fragment_batch_size_ = TAO_DEFAULT_MIOP_FRAGMENT_BATCH_SIZE;
+                }
+              else
+                this->fragment_batch_size_ = static_cast<u_long> (batch);
+            }
+          else
+            ORBSVCS_DEBUG ((LM_ERROR,
+                        ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
+                        ACE_TEXT ("-ORBFragmentBatchSize missing limit.\n")));
+        }
       else if (ACE_OS::strncmp (argv[curarg], ACE_TEXT ("-ORB"), 4) == 0)
         {
           // Can we assume there is an argument after the option?
@@ -381,6 +408,12 @@ TAO_MIOP_Resource_Factory::enable_eager_dequeue () const
   return enable_eager_dequeue_;
 }
 
+u_long
+TAO_MIOP_Resource_Factory::fragment_batch_size () const
+{
+  return fragment_batch_size_;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
 
 // ****************************************************************
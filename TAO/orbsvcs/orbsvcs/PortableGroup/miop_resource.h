@@ -93,6 +93,10 @@ public:
   /// Get the server-side eager complete message dequeuing enable flag.
   bool enable_eager_dequeue () const;
 
+  /// Get the maximum number of fragments sent or received with a
+  /// single system call.
+  u_long fragment_batch_size () const;
+
 private:
   enum Fragments_Cleanup_Strategy_Type
     {
@@ -130,6 +134,10 @@ private:
 
   /// Get the server-side eager complete message dequeuing enable flag.
   bool enable_eager_dequeue_;
+
+  /// Maximum number of fragments sent or received with a single
+  /// system call.
+  u_long fragment_batch_size_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
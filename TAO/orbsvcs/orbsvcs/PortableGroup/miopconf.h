@@ -104,6 +104,13 @@ static bool const TAO_DEFAULT_MIOP_SEND_THROTTLING = true; // Enabled
 static bool const TAO_DEFAULT_MIOP_EAGER_DEQUEUEING = true; // Enabled
 #endif
 
+// Upper limit and default for the number of datagrams sent or received
+// with a single system call.  One disables batching.
+static u_long const MIOP_MAX_FRAGMENT_BATCH_SIZE   = 64u;
+#if !defined (TAO_DEFAULT_MIOP_FRAGMENT_BATCH_SIZE)
+static u_long const TAO_DEFAULT_MIOP_FRAGMENT_BATCH_SIZE = 16u;
+#endif
+
 static CORBA::Octet const miop_magic[4] = {
   0x4d, 0x49, 0x4f, 0x50
 }; // in ASCII this is 'M', 'I', 'O', 'P'
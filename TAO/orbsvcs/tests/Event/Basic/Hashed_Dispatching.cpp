@@ -0,0 +1,332 @@
+#include "Hashed_Dispatching.h"
+
+#include "ace/OS_NS_unistd.h"
+
+#include "orbsvcs/Event_Utilities.h"
+#include "orbsvcs/Event/EC_Event_Channel.h"
+#include "orbsvcs/Event/EC_Default_Factory.h"
+
+const int event_type = 20;
+const int first_source = 10;
+
+const int supplier_count = 4;
+const int consumer_count = 16;
+const int event_count = 2000;
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  TAO_EC_Default_Factory::init_svcs ();
+
+  int errors = 0;
+
+  try
+    {
+      // ORB initialization boiler plate...
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var object =
+        orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa =
+        PortableServer::POA::_narrow (object.in ());
+      PortableServer::POAManager_var poa_manager =
+        poa->the_POAManager ();
+      poa_manager->activate ();
+
+      // ****************************************************************
+
+      TAO_EC_Event_Channel_Attributes attributes (poa.in (),
+                                                  poa.in ());
+
+      TAO_EC_Event_Channel ec_impl (attributes);
+      ec_impl.activate ();
+
+      RtecEventChannelAdmin::EventChannel_var event_channel =
+        ec_impl._this ();
+
+      // ****************************************************************
+
+      RtecEventChannelAdmin::ConsumerAdmin_var consumer_admin =
+        event_channel->for_consumers ();
+
+      RtecEventChannelAdmin::SupplierAdmin_var supplier_admin =
+        event_channel->for_suppliers ();
+
+      // ****************************************************************
+
+      // Every consumer receives the events of every supplier.
+      ACE_ConsumerQOS_Factory consumer_qos;
+      consumer_qos.start_disjunction_group ();
+      consumer_qos.insert_type (event_type, 0);
+
+      Consumer *consumers[consumer_count];
+      for (int i = 0; i != consumer_count; ++i)
+        {
+          ACE_NEW_RETURN (consumers[i],
+                          Consumer ("Consumer", supplier_count),
+                          1);
+          consumers[i]->connect (consumer_admin.in (),
+                                 consumer_qos.get_ConsumerQOS ());
+        }
+
+      Supplier suppliers[supplier_count];
+      for (int i = 0; i != supplier_count; ++i)
+        {
+          suppliers[i].connect (supplier_admin.in (), first_source + i);
+        }
+
+      // ****************************************************************
+
+      Task task (suppliers, event_count);
+      if (task.activate (THR_NEW_LWP | THR_JOINABLE, supplier_count) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Cannot activate the supplier threads\n"),
+                            1);
+        }
+      task.wait ();
+
+      // ****************************************************************
+
+      // The dispatching threads may still be pushing, give them some
+      // time to drain their queues.
+      CORBA::ULong const expected = supplier_count * event_count;
+      ACE_Time_Value const deadline =
+        ACE_OS::gettimeofday () + ACE_Time_Value (60);
+      for (int i = 0; i != consumer_count; ++i)
+        {
+          while (consumers[i]->received () < expected
+                 && ACE_OS::gettimeofday () < deadline)
+            {
+              ACE_Time_Value tv (0, 10000);
+              ACE_OS::sleep (tv);
+            }
+        }
+
+      // ****************************************************************
+
+      for (int i = 0; i != supplier_count; ++i)
+        {
+          suppliers[i].disconnect ();
+        }
+
+      for (int i = 0; i != consumer_count; ++i)
+        {
+          consumers[i]->disconnect ();
+
+          CORBA::ULong const received = consumers[i]->received ();
+          if (received != expected)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "ERROR - consumer %d received %d events "
+                          "instead of %d\n",
+                          i, received, expected));
+              ++errors;
+            }
+          errors += consumers[i]->errors;
+        }
+
+      event_channel->destroy ();
+
+      for (int i = 0; i != consumer_count; ++i)
+        {
+          delete consumers[i];
+        }
+
+      poa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Service");
+      return 1;
+    }
+
+  if (errors != 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "ERROR - %d checks failed\n", errors),
+                        1);
+    }
+
+  ACE_DEBUG ((LM_DEBUG, "Hashed dispatching test passed\n"));
+  return 0;
+}
+
+// ****************************************************************
+
+Consumer::Consumer (const char* name,
+                    int suppliers)
+  : EC_Counting_Consumer (name),
+    errors (0),
+    expected_ (suppliers, 0),
+    thread_ (ACE_OS::NULL_thread),
+    first_ (true),
+    running_ (0)
+{
+}
+
+void
+Consumer::push (const RtecEventComm::EventSet& events)
+{
+  if (++this->running_ != 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR - %C (%t) concurrent push\n", this->name_));
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+      ++this->errors;
+    }
+
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+    ACE_thread_t const self = ACE_Thread::self ();
+    if (this->first_)
+      {
+        this->thread_ = self;
+        this->first_ = false;
+      }
+    else if (!ACE_OS::thr_equal (this->thread_, self))
+      {
+        ACE_ERROR ((LM_ERROR,
+                    "ERROR - %C (%t) pushed from a second thread\n",
+                    this->name_));
+        this->thread_ = self;
+        ++this->errors;
+      }
+
+    for (CORBA::ULong i = 0; i != events.length (); ++i)
+      {
+        const RtecEventComm::Event &e = events[i];
+        size_t const supplier =
+          static_cast<size_t> (e.header.source - first_source);
+
+        if (supplier >= this->expected_.size ())
+          {
+            ACE_ERROR ((LM_ERROR,
+                        "ERROR - %C unexpected source <%d>\n",
+                        this->name_, e.header.source));
+            ++this->errors;
+            continue;
+          }
+
+        if (e.data.pad1 != this->expected_[supplier])
+          {
+            ACE_ERROR ((LM_ERROR,
+                        "ERROR - %C event <%d> of source <%d> "
+                        "received instead of <%d>\n",
+                        this->name_,
+                        e.data.pad1,
+                        e.header.source,
+                        this->expected_[supplier]));
+            ++this->errors;
+          }
+        this->expected_[supplier] = e.data.pad1 + 1;
+        ++this->event_count;
+      }
+  }
+
+  --this->running_;
+}
+
+CORBA::ULong
+Consumer::received ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+  return this->event_count;
+}
+
+// ****************************************************************
+
+Supplier::Supplier ()
+  : source_ (0)
+{
+}
+
+void
+Supplier::connect (RtecEventChannelAdmin::SupplierAdmin_ptr supplier_admin,
+                   int source)
+{
+  this->source_ = source;
+
+  ACE_SupplierQOS_Factory supplier_qos;
+  supplier_qos.insert (source, event_type, 0, 1);
+
+  RtecEventComm::PushSupplier_var supplier =
+    this->_this ();
+
+  this->consumer_proxy_ =
+    supplier_admin->obtain_push_consumer ();
+
+  this->consumer_proxy_->connect_push_supplier (supplier.in (),
+                                                supplier_qos.get_SupplierQOS ());
+}
+
+void
+Supplier::disconnect ()
+{
+  if (!CORBA::is_nil (this->consumer_proxy_.in ()))
+    {
+      this->consumer_proxy_->disconnect_push_consumer ();
+      this->consumer_proxy_ =
+        RtecEventChannelAdmin::ProxyPushConsumer::_nil ();
+    }
+
+  PortableServer::POA_var poa =
+    this->_default_POA ();
+  PortableServer::ObjectId_var id =
+    poa->servant_to_id (this);
+  poa->deactivate_object (id.in ());
+}
+
+void
+Supplier::push (CORBA::Long sequence)
+{
+  RtecEventComm::EventSet event (1);
+  event.length (1);
+  event[0].header.type   = event_type;
+  event[0].header.source = this->source_;
+  event[0].header.ttl    = 1;
+  event[0].data.pad1     = sequence;
+
+  this->consumer_proxy_->push (event);
+}
+
+void
+Supplier::disconnect_push_supplier ()
+{
+  this->consumer_proxy_ =
+    RtecEventChannelAdmin::ProxyPushConsumer::_nil ();
+}
+
+// ****************************************************************
+
+Task::Task (Supplier *suppliers,
+            int events)
+  : suppliers_ (suppliers),
+    events_ (events),
+    next_ (0)
+{
+}
+
+int
+Task::svc ()
+{
+  Supplier &supplier = this->suppliers_[this->next_++];
+
+  try
+    {
+      for (int i = 0; i != this->events_; ++i)
+        {
+          supplier.push (i);
+        }
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Task::svc");
+      return -1;
+    }
+  return 0;
+}
@@ -0,0 +1,115 @@
+/* -*- C++ -*- */
+//=============================================================================
+/**
+ *  @file   Hashed_Dispatching.h
+ *
+ * Check that the hashed dispatching strategy pushes the events of each
+ * consumer in order, from a single thread, while several suppliers push
+ * concurrently.
+ */
+//=============================================================================
+
+
+#ifndef EC_HASHED_DISPATCHING_H
+#define EC_HASHED_DISPATCHING_H
+
+#include "Counting_Consumer.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Array_Base.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+/**
+ * @class Consumer
+ *
+ * @brief Checks the order and the thread of the events it receives.
+ */
+class Consumer : public EC_Counting_Consumer
+{
+public:
+  /// Constructor
+  Consumer (const char* name,
+            int suppliers);
+
+  // = The RtecEventComm::PushConsumer methods
+
+  virtual void push (const RtecEventComm::EventSet& events);
+
+  /// Number of events received so far.
+  CORBA::ULong received ();
+
+  /// Number of events out of order, pushed from a second thread or
+  /// pushed while another push was running.
+  int errors;
+
+private:
+  /// Synchronize access to the state
+  TAO_SYNCH_MUTEX lock_;
+
+  /// The sequence number expected next from each supplier.
+  ACE_Array_Base<CORBA::Long> expected_;
+
+  /// The thread the first event came from.
+  ACE_thread_t thread_;
+
+  /// Has an event been received?
+  bool first_;
+
+  /// Number of pushes running.
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, int> running_;
+};
+
+/**
+ * @class Supplier
+ *
+ * @brief Pushes numbered events of its own source.
+ */
+class Supplier : public POA_RtecEventComm::PushSupplier
+{
+public:
+  Supplier ();
+
+  void connect (RtecEventChannelAdmin::SupplierAdmin_ptr supplier_admin,
+                int source);
+  void disconnect ();
+
+  /// Push the event numbered @a sequence.
+  void push (CORBA::Long sequence);
+
+  /// The skeleton methods.
+  virtual void disconnect_push_supplier ();
+
+private:
+  /// The proxy
+  RtecEventChannelAdmin::ProxyPushConsumer_var consumer_proxy_;
+
+  int source_;
+};
+
+/**
+ * @class Task
+ *
+ * @brief Runs one supplier on each thread.
+ */
+class Task : public ACE_Task_Base
+{
+public:
+  Task (Supplier *suppliers,
+        int events);
+
+  // = Check the ACE_Task_Base documentation.
+  int svc ();
+
+private:
+  Supplier *suppliers_;
+
+  int events_;
+
+  /// The next supplier to run.
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, int> next_;
+};
+
+#endif /* EC_HASHED_DISPATCHING_H */
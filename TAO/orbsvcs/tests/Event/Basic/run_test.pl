@@ -21,6 +21,7 @@ $svc_conf         = $test->LocalFile ("svc$conf_suffix");
 $observer_conf    = $test->LocalFile ("observer$conf_suffix");
 $svc_complex_conf = $test->LocalFile ("svc.complex$conf_suffix");
 $mt_svc_conf      = $test->LocalFile ("mt.svc$conf_suffix");
+$hashed_svc_conf  = $test->LocalFile ("hashed.svc$conf_suffix");
 $svc_complex_conf = $test->LocalFile ("svc.complex$conf_suffix");
 $control_conf     = $test->LocalFile ("control$conf_suffix");
 
@@ -90,6 +91,10 @@ RunTest ("Atomic Reconnection test",
          "Atomic_Reconnect",
          "-ORBSvcConf $mt_svc_conf");
 
+RunTest ("Hashed dispatching test",
+         "Hashed_Dispatching",
+         "-ORBSvcConf $hashed_svc_conf");
+
 RunTest ("Complex filter",
          "Complex",
          "-ORBSvcConf $svc_complex_conf");
@@ -0,0 +1,405 @@
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "tao/debug.h"
+#include "FilterIndex.h"
+
+/***************************************************************************/
+
+FilterIndex_StructuredPushConsumer::FilterIndex_StructuredPushConsumer (const char *name)
+  : name_ (name)
+{
+}
+
+void
+FilterIndex_StructuredPushConsumer::push_structured_event (
+    const CosNotification::StructuredEvent & notification)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  this->received_ +=
+    notification.header.fixed_header.event_type.type_name.in ();
+
+  if (TAO_debug_level)
+    ACE_DEBUG ((LM_DEBUG, "%C received %C\n",
+                this->name_.c_str (),
+                notification.header.fixed_header.event_type.type_name.in ()));
+}
+
+ACE_CString
+FilterIndex_StructuredPushConsumer::take_received ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, ACE_CString ());
+
+  // The types are single letters, put them in order.
+  ACE_CString received;
+
+  for (char type = 'A'; type <= 'Z'; ++type)
+    {
+      for (size_t i = 0; i < this->received_.length (); ++i)
+        {
+          if (this->received_[i] == type)
+            received += type;
+        }
+    }
+
+  this->received_.clear ();
+
+  return received;
+}
+
+size_t
+FilterIndex_StructuredPushConsumer::received_count ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+
+  return this->received_.length ();
+}
+
+const char *
+FilterIndex_StructuredPushConsumer::name () const
+{
+  return this->name_.c_str ();
+}
+
+/***************************************************************************/
+
+FilterIndex::FilterIndex ()
+  : supplier_ (0),
+    supplier2_ (0),
+    errors_ (0)
+{
+  for (int i = 0; i < CONSUMER_COUNT; ++i)
+    this->consumers_[i] = 0;
+}
+
+FilterIndex::~FilterIndex ()
+{
+}
+
+int
+FilterIndex::init (int argc,
+                   ACE_TCHAR* argv [])
+{
+  // Initialize the base class.
+  Notify_Test_Client::init (argc,
+                            argv);
+
+  this->ec_ = this->create_EC ();
+  this->ec2_ = this->create_EC ();
+
+  this->ffact_ = this->ec_->default_filter_factory ();
+
+  CosNotifyChannelAdmin::AdminID adminid;
+
+  // With AND the filters of the proxies decide, as long as the admin
+  // has none.
+  this->and_admin_ =
+    this->ec_->new_for_consumers (CosNotifyChannelAdmin::AND_OP,
+                                  adminid);
+  this->or_admin_ =
+    this->ec_->new_for_consumers (CosNotifyChannelAdmin::OR_OP,
+                                  adminid);
+  this->and_admin2_ =
+    this->ec2_->new_for_consumers (CosNotifyChannelAdmin::AND_OP,
+                                   adminid);
+
+  this->consumers_[0] = this->create_consumer ("keyed", this->and_admin_.in ());
+  this->consumers_[1] = this->create_consumer ("all", this->and_admin_.in ());
+  this->consumers_[2] = this->create_consumer ("none", this->and_admin_.in ());
+  this->consumers_[3] = this->create_consumer ("two keys", this->and_admin_.in ());
+  this->consumers_[4] = this->create_consumer ("or admin", this->or_admin_.in ());
+  this->consumers_[5] = this->create_consumer ("other channel", this->and_admin2_.in ());
+
+  CosNotifyChannelAdmin::SupplierAdmin_var supplier_admin =
+    this->ec_->new_for_suppliers (this->ifgop_,
+                                  adminid);
+  this->supplier_ = new TAO_Notify_Tests_StructuredPushSupplier ();
+  this->supplier_->init (root_poa_.in ());
+  this->supplier_->connect (supplier_admin.in ());
+
+  CosNotifyChannelAdmin::SupplierAdmin_var supplier_admin2 =
+    this->ec2_->new_for_suppliers (this->ifgop_,
+                                   adminid);
+  this->supplier2_ = new TAO_Notify_Tests_StructuredPushSupplier ();
+  this->supplier2_->init (root_poa_.in ());
+  this->supplier2_->connect (supplier_admin2.in ());
+
+  return 0;
+}
+
+CosNotifyChannelAdmin::EventChannel_ptr
+FilterIndex::create_EC ()
+{
+  CosNotifyChannelAdmin::ChannelID id;
+
+  CosNotifyChannelAdmin::EventChannel_var ec =
+    notify_factory_->create_channel (this->initial_qos_,
+                                     this->initial_admin_,
+                                     id);
+
+  ACE_ASSERT (!CORBA::is_nil (ec.in ()));
+
+  return ec._retn ();
+}
+
+FilterIndex_StructuredPushConsumer *
+FilterIndex::create_consumer (const char *name,
+                              CosNotifyChannelAdmin::ConsumerAdmin_ptr admin)
+{
+  FilterIndex_StructuredPushConsumer *consumer =
+    new FilterIndex_StructuredPushConsumer (name);
+
+  consumer->init (root_poa_.in ());
+  consumer->connect (admin);
+
+  return consumer;
+}
+
+CosNotifyFilter::Filter_ptr
+FilterIndex::create_filter (const char *constraint)
+{
+  CosNotifyFilter::Filter_var filter =
+    this->ffact_->create_filter ("ETCL");
+
+  ACE_ASSERT (!CORBA::is_nil (filter.in ()));
+
+  if (constraint != 0)
+    {
+      CosNotifyFilter::ConstraintExpSeq constraint_list (1);
+      constraint_list.length (1);
+      constraint_list[0].event_types.length (0);
+      constraint_list[0].constraint_expr = CORBA::string_dup (constraint);
+
+      CosNotifyFilter::ConstraintInfoSeq_var info =
+        filter->add_constraints (constraint_list);
+    }
+
+  return filter._retn ();
+}
+
+void
+FilterIndex::send_events (TAO_Notify_Tests_StructuredPushSupplier *supplier)
+{
+  const char *const types[] = { "A", "B", "C" };
+
+  CosNotification::StructuredEvent event;
+  event.header.fixed_header.event_type.domain_name = CORBA::string_dup ("Test");
+  event.header.fixed_header.event_name = CORBA::string_dup ("event");
+
+  for (size_t i = 0; i < sizeof types / sizeof types[0]; ++i)
+    {
+      event.header.fixed_header.event_type.type_name =
+        CORBA::string_dup (types[i]);
+      supplier->send_event (event);
+    }
+}
+
+void
+FilterIndex::check (const char *step,
+                    const char *const expected[CONSUMER_COUNT])
+{
+  this->send_events (this->supplier_);
+  this->send_events (this->supplier2_);
+
+  // Wait for the events each consumer should get, then a little longer
+  // for those it should not.
+  ACE_Time_Value const deadline =
+    ACE_OS::gettimeofday () + ACE_Time_Value (10);
+
+  for (int i = 0; i < CONSUMER_COUNT; ++i)
+    {
+      while (this->consumers_[i]->received_count () < ACE_OS::strlen (expected[i])
+             && ACE_OS::gettimeofday () < deadline)
+        {
+          ACE_Time_Value tv (0, 100 * 1000);
+          this->orb_->run (tv);
+        }
+    }
+
+  ACE_Time_Value tv (0, 500 * 1000);
+  this->orb_->run (tv);
+
+  for (int i = 0; i < CONSUMER_COUNT; ++i)
+    {
+      ACE_CString const received = this->consumers_[i]->take_received ();
+
+      if (received != expected[i])
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "ERROR: %C: consumer <%C> received <%C>, expected <%C>\n",
+                      step,
+                      this->consumers_[i]->name (),
+                      received.c_str (),
+                      expected[i]));
+          ++this->errors_;
+        }
+    }
+}
+
+void
+FilterIndex::run_test ()
+{
+  CosNotifyFilter::FilterAdmin_ptr keyed = this->consumers_[0]->get_proxy ();
+  CosNotifyFilter::FilterAdmin_ptr none = this->consumers_[2]->get_proxy ();
+  CosNotifyFilter::FilterAdmin_ptr two_keys = this->consumers_[3]->get_proxy ();
+  CosNotifyFilter::FilterAdmin_ptr or_admin = this->consumers_[4]->get_proxy ();
+  CosNotifyFilter::FilterAdmin_ptr other = this->consumers_[5]->get_proxy ();
+
+  CosNotifyFilter::Filter_var keyed_filter =
+    this->create_filter ("$type_name == 'A'");
+  keyed->add_filter (keyed_filter.in ());
+
+  // A filter without constraints accepts nothing.
+  CosNotifyFilter::Filter_var none_filter = this->create_filter (0);
+  none->add_filter (none_filter.in ());
+
+  CosNotifyFilter::Filter_var a_filter =
+    this->create_filter ("$type_name == 'A'");
+  CosNotifyFilter::FilterID a_id = two_keys->add_filter (a_filter.in ());
+  CosNotifyFilter::Filter_var b_filter =
+    this->create_filter ("$type_name == 'B'");
+  two_keys->add_filter (b_filter.in ());
+
+  CosNotifyFilter::Filter_var or_admin_filter =
+    this->create_filter ("$type_name == 'A'");
+  this->or_admin_->add_filter (or_admin_filter.in ());
+  CosNotifyFilter::Filter_var or_proxy_filter =
+    this->create_filter ("$type_name == 'B'");
+  or_admin->add_filter (or_proxy_filter.in ());
+
+  // The second channel uses a filter made by the first.
+  CosNotifyFilter::Filter_var other_filter =
+    this->create_filter ("$type_name == 'A'");
+  other->add_filter (other_filter.in ());
+
+  {
+    const char *const expected[CONSUMER_COUNT] =
+      { "A", "ABC", "", "AB", "AB", "A" };
+    this->check ("added filters", expected);
+  }
+
+  // Modifying the filters drops the indexes, of the other channel too.
+  CosNotifyFilter::ConstraintInfoSeq_var info =
+    keyed_filter->get_all_constraints ();
+  info[0].constraint_expression.constraint_expr =
+    CORBA::string_dup ("$type_name == 'C'");
+  CosNotifyFilter::ConstraintIDSeq no_ids;
+  keyed_filter->modify_constraints (no_ids, info.in ());
+
+  info = other_filter->get_all_constraints ();
+  info[0].constraint_expression.constraint_expr =
+    CORBA::string_dup ("$type_name == 'B'");
+  other_filter->modify_constraints (no_ids, info.in ());
+
+  {
+    const char *const expected[CONSUMER_COUNT] =
+      { "C", "ABC", "", "AB", "AB", "B" };
+    this->check ("modified constraints", expected);
+  }
+
+  // NONE becomes KEYED.
+  CosNotifyFilter::ConstraintExpSeq constraint_list (1);
+  constraint_list.length (1);
+  constraint_list[0].event_types.length (0);
+  constraint_list[0].constraint_expr = CORBA::string_dup ("$type_name == 'B'");
+  info = none_filter->add_constraints (constraint_list);
+
+  // KEYED or a filter that cannot be keyed is ALL.
+  CosNotifyFilter::Filter_var unkeyed_filter =
+    this->create_filter ("$event_name != 'none'");
+  keyed->add_filter (unkeyed_filter.in ());
+
+  {
+    const char *const expected[CONSUMER_COUNT] =
+      { "ABC", "ABC", "B", "AB", "AB", "B" };
+    this->check ("added constraints", expected);
+  }
+
+  // The filters of an AND admin narrow those of every proxy.
+  CosNotifyFilter::Filter_var and_admin_filter =
+    this->create_filter ("$type_name == 'B'");
+  CosNotifyFilter::FilterID and_admin_id =
+    this->and_admin_->add_filter (and_admin_filter.in ());
+
+  {
+    const char *const expected[CONSUMER_COUNT] =
+      { "B", "B", "B", "B", "AB", "B" };
+    this->check ("admin filter", expected);
+  }
+
+  // Removing filters widens them again.  An OR admin without filters
+  // lets every event through.
+  this->and_admin_->remove_filter (and_admin_id);
+  two_keys->remove_filter (a_id);
+  this->or_admin_->remove_all_filters ();
+
+  {
+    const char *const expected[CONSUMER_COUNT] =
+      { "ABC", "ABC", "B", "B", "ABC", "B" };
+    this->check ("removed filters", expected);
+  }
+
+  keyed->remove_all_filters ();
+  none->remove_all_filters ();
+  two_keys->remove_all_filters ();
+  other->remove_all_filters ();
+
+  {
+    const char *const expected[CONSUMER_COUNT] =
+      { "ABC", "ABC", "ABC", "ABC", "ABC", "ABC" };
+    this->check ("removed all filters", expected);
+  }
+
+  if (this->errors_ == 0)
+    ACE_DEBUG ((LM_DEBUG, "FilterIndex test has run successfully!\n"));
+}
+
+int
+FilterIndex::check_results ()
+{
+  // Destroy the channels.
+  this->ec_->destroy ();
+  this->ec2_->destroy ();
+
+  return this->errors_ == 0 ? 0 : 1;
+}
+
+/***************************************************************************/
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  FilterIndex client;
+
+  if (client.parse_args (argc, argv) == -1)
+    {
+      return 1;
+    }
+
+  try
+    {
+      client.init (argc,
+                   argv);
+
+      client.run_test ();
+    }
+  catch (const CORBA::Exception& se)
+    {
+      se._tao_print_exception ("Error: ");
+      return 1;
+    }
+
+  int status = 0;
+
+  try
+    {
+      status = client.check_results ();
+    }
+  catch (const CORBA::Exception& se)
+    {
+      se._tao_print_exception ("Error: ");
+      status = 1;
+    }
+
+  return status;
+}
@@ -0,0 +1,123 @@
+/* -*- C++ -*- */
+//=============================================================================
+/**
+ *  @file   FilterIndex.h
+ *
+ * Check that structured events still reach the right consumers as the
+ * filters of their proxies and admins are added, modified and removed.
+ */
+//=============================================================================
+
+
+#ifndef NOTIFY_TESTS_FILTER_INDEX_H
+#define NOTIFY_TESTS_FILTER_INDEX_H
+
+#include "Notify_Test_Client.h"
+#include "Notify_StructuredPushConsumer.h"
+#include "Notify_StructuredPushSupplier.h"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4250)
+#endif /* _MSC_VER */
+
+class FilterIndex;
+
+/***************************************************************************/
+
+class FilterIndex_StructuredPushConsumer
+  : public TAO_Notify_Tests_StructuredPushConsumer
+{
+public:
+  FilterIndex_StructuredPushConsumer (const char *name);
+
+  // = StructuredPushConsumer methods
+  virtual void push_structured_event (const CosNotification::StructuredEvent & notification);
+
+  /// The types of the events received since the last call, sorted.
+  ACE_CString take_received ();
+
+  /// Number of events received since the last take_received().
+  size_t received_count ();
+
+  const char *name () const;
+
+protected:
+  ACE_CString name_;
+
+  TAO_SYNCH_MUTEX lock_;
+
+  ACE_CString received_;
+};
+
+/***************************************************************************/
+
+class FilterIndex : public Notify_Test_Client
+{
+public:
+  FilterIndex ();
+  virtual ~FilterIndex ();
+
+  /// initialization.
+  int init (int argc,
+            ACE_TCHAR *argv []);
+
+  /// Run the test.
+  void run_test ();
+
+  /// Destroy the channels, return the number of failed checks.
+  int check_results ();
+
+protected:
+  enum { CONSUMER_COUNT = 6 };
+
+  /// Create a channel.
+  CosNotifyChannelAdmin::EventChannel_ptr create_EC ();
+
+  /// Create a consumer connected to @a admin.
+  FilterIndex_StructuredPushConsumer *
+  create_consumer (const char *name,
+                   CosNotifyChannelAdmin::ConsumerAdmin_ptr admin);
+
+  /// Create a filter with @a constraint, none if it is 0.
+  CosNotifyFilter::Filter_ptr create_filter (const char *constraint);
+
+  /// Send an event of type A, B and C through @a supplier.
+  void send_events (TAO_Notify_Tests_StructuredPushSupplier *supplier);
+
+  /// Check that the consumers got the types in @a expected, in the
+  /// order of consumers_.
+  void check (const char *step, const char *const expected[CONSUMER_COUNT]);
+
+  /// The channel of the first five consumers.
+  CosNotifyChannelAdmin::EventChannel_var ec_;
+
+  /// A second channel, using a filter of the first.
+  CosNotifyChannelAdmin::EventChannel_var ec2_;
+
+  /// The default filter factory of ec_.
+  CosNotifyFilter::FilterFactory_var ffact_;
+
+  /// Admins whose filters are ANDed with those of their proxies.
+  CosNotifyChannelAdmin::ConsumerAdmin_var and_admin_;
+  CosNotifyChannelAdmin::ConsumerAdmin_var and_admin2_;
+
+  /// An admin whose filters are ORed with those of its proxies.
+  CosNotifyChannelAdmin::ConsumerAdmin_var or_admin_;
+
+  FilterIndex_StructuredPushConsumer *consumers_[CONSUMER_COUNT];
+
+  TAO_Notify_Tests_StructuredPushSupplier *supplier_;
+  TAO_Notify_Tests_StructuredPushSupplier *supplier2_;
+
+  /// Number of failed checks.
+  int errors_;
+};
+
+/***************************************************************************/
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif /* _MSC_VER */
+
+#endif /* NOTIFY_TESTS_FILTER_INDEX_H */
@@ -66,6 +66,9 @@ $nfs->DeleteFile ($nfsiorfile);
    }, {
     name => "Filter",
     args => "",
+   }, {
+    name => "FilterIndex",
+    args => "",
    }, {
     name => "Updates",
     args => "",
@@ -0,0 +1,369 @@
+// Checks that the constraints the Notification Service compiles into a
+// TAO_ETCL_Program give the same results as the visitor that evaluates
+// the constraint trees, on events built locally and on events that were
+// demarshaled, whose Anys are read in place.  Events with duplicate
+// property names, which the visitor refuses, must not match either way.
+
+#include "orbsvcs/Notify/Notify_Constraint_Interpreter.h"
+#include "orbsvcs/Notify/Notify_Constraint_Visitors.h"
+#include "orbsvcs/Notify/ETCL_Filter.h"
+#include "orbsvcs/CosNotifyChannelAdminC.h"
+#include "tao/CDR.h"
+#include "ace/Log_Msg.h"
+
+namespace
+{
+  enum Path
+  {
+    /// The constraint must be compiled, and both paths agree.
+    COMPILED,
+    /// The constraint is left to the visitor.
+    VISITOR
+  };
+
+  struct Constraint
+  {
+    const char *expr_;
+    Path path_;
+    bool result_;
+  };
+
+  const Constraint constraints[] =
+    {
+      // Literals and booleans
+      { "TRUE", COMPILED, true },
+      { "FALSE", COMPILED, false },
+      { "", COMPILED, true },
+      { "$b", COMPILED, true },
+      { "not $b", COMPILED, false },
+      { "$b and $l > 1", COMPILED, true },
+      { "$b or $missing", COMPILED, true },
+
+      // Numeric widening
+      { "$l == 5", COMPILED, true },
+      { "$l == 5.0", COMPILED, true },
+      { "$l + 1.5 == 6.5", COMPILED, true },
+      { "$s < 0", COMPILED, true },
+      { "$s == -3", COMPILED, true },
+      { "$ul > $l", COMPILED, true },
+      { "$ul - $l == 2", COMPILED, true },
+      { "$us * 2 == 4", COMPILED, true },
+      { "$us * $s == -6", COMPILED, true },
+      { "$f == 1.5", COMPILED, true },
+      { "$d > $f", COMPILED, true },
+      { "$d * 4.0 == 9.0", COMPILED, true },
+      { "$l / 2 == 2", COMPILED, true },
+      { "$l - 10 == -5", COMPILED, true },
+      { "$l < $us", COMPILED, false },
+      { "$e == 1", COMPILED, true },
+      { "$e != 2", COMPILED, true },
+
+      // Strings and `~'
+      { "$str == 'hello world'", COMPILED, true },
+      { "$str < 'help'", COMPILED, true },
+      { "'ell' ~ $str", COMPILED, true },
+      { "'xyz' ~ $str", COMPILED, false },
+      { "not ('xyz' ~ $str)", COMPILED, true },
+
+      // Header fields
+      { "$domain_name == 'Telecom'", COMPILED, true },
+      { "$type_name == 'CommunicationsAlarm'", COMPILED, true },
+      { "$event_name == 'alarm1'", COMPILED, true },
+      { "$.header.fixed_header.event_type.type_name == 'CommunicationsAlarm'",
+        COMPILED, true },
+      { "$.header.fixed_header.event_name != 'alarm1'", COMPILED, false },
+      { "$.header.variable_header(Priority) == 3", COMPILED, true },
+      { "$.filterable_data(l) == 5", COMPILED, true },
+      { "$.remainder_of_body == 42", COMPILED, true },
+
+      // exist
+      { "exist $.header.variable_header(Priority)", COMPILED, true },
+      { "exist $.header.variable_header(Timeout)", COMPILED, false },
+      { "exist $.filterable_data(l)", COMPILED, true },
+      { "exist $.header.fixed_header.event_type.domain_name", COMPILED, true },
+
+      // A missing field fails the whole constraint
+      { "$missing == 1", COMPILED, false },
+      { "$missing != 1", COMPILED, false },
+      { "not ($missing == 1)", COMPILED, false },
+      { "$missing == 1 or $l == 5", COMPILED, false },
+      { "$missing == 1 and $l == 5", COMPILED, false },
+      { "$.header.variable_header(Timeout) > 0", COMPILED, false },
+
+      // Types only the visitor reads compare unequal
+      { "$seq == 1", COMPILED, false },
+
+      // Constructs left to the visitor
+      { "exist $l", VISITOR, false },
+      { "exist $missing", VISITOR, false },
+      { "$seq._length == 3", VISITOR, true },
+      { "5 in $seq", VISITOR, false }
+    };
+
+  void
+  add (CosNotification::PropertySeq &properties,
+       const char *name,
+       const CORBA::Any &value)
+  {
+    CORBA::ULong const length = properties.length ();
+    properties.length (length + 1);
+    properties[length].name = name;
+    properties[length].value = value;
+  }
+
+  void
+  make_event (CosNotification::StructuredEvent &event)
+  {
+    event.header.fixed_header.event_type.domain_name = "Telecom";
+    event.header.fixed_header.event_type.type_name = "CommunicationsAlarm";
+    event.header.fixed_header.event_name = "alarm1";
+
+    CORBA::Any any;
+    any <<= static_cast<CORBA::Short> (3);
+    add (event.header.variable_header, "Priority", any);
+
+    any <<= static_cast<CORBA::Long> (5);
+    add (event.filterable_data, "l", any);
+    any <<= static_cast<CORBA::Short> (-3);
+    add (event.filterable_data, "s", any);
+    any <<= static_cast<CORBA::ULong> (7);
+    add (event.filterable_data, "ul", any);
+    any <<= static_cast<CORBA::UShort> (2);
+    add (event.filterable_data, "us", any);
+    any <<= static_cast<CORBA::Float> (1.5);
+    add (event.filterable_data, "f", any);
+    any <<= static_cast<CORBA::Double> (2.25);
+    add (event.filterable_data, "d", any);
+    any <<= CORBA::Any::from_boolean (true);
+    add (event.filterable_data, "b", any);
+    any <<= "hello world";
+    add (event.filterable_data, "str", any);
+    any <<= CosNotifyChannelAdmin::STRUCTURED_EVENT;
+    add (event.filterable_data, "e", any);
+
+    CORBA::ULongSeq seq (3);
+    seq.length (3);
+    seq[0] = 1;
+    seq[1] = 2;
+    seq[2] = 3;
+    any <<= seq;
+    add (event.filterable_data, "seq", any);
+
+    event.remainder_of_body <<= static_cast<CORBA::Long> (42);
+  }
+
+  int
+  check (const CosNotification::StructuredEvent &event, const char *which)
+  {
+    int errors = 0;
+
+    for (size_t i = 0; i < sizeof constraints / sizeof constraints[0]; ++i)
+      {
+        const Constraint &c = constraints[i];
+
+        CosNotifyFilter::ConstraintExp exp;
+        exp.constraint_expr = c.expr_;
+
+        TAO_Notify_Constraint_Interpreter interpreter;
+        try
+          {
+            interpreter.build_tree (exp);
+          }
+        catch (const CosNotifyFilter::InvalidConstraint&)
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("ERROR: <%C> is not a valid constraint\n"),
+                        c.expr_));
+            ++errors;
+            continue;
+          }
+
+        TAO_Notify_Constraint_Visitor visitor;
+        visitor.bind_structured_event (event);
+        bool const visited = interpreter.evaluate (visitor);
+
+        if ((c.path_ == COMPILED) != interpreter.compiled ())
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("ERROR: %C event: <%C> is %C\n"),
+                        which,
+                        c.expr_,
+                        interpreter.compiled () ? "compiled" : "not compiled"));
+            ++errors;
+          }
+
+        if (visited != c.result_)
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("ERROR: %C event: visitor gives %d for <%C>\n"),
+                        which,
+                        visited,
+                        c.expr_));
+            ++errors;
+          }
+
+        if (interpreter.compiled ())
+          {
+            bool const run = interpreter.evaluate (event);
+
+            if (run != visited)
+              {
+                ACE_ERROR ((LM_ERROR,
+                            ACE_TEXT ("ERROR: %C event: program gives %d, ")
+                            ACE_TEXT ("visitor %d for <%C>\n"),
+                            which,
+                            run,
+                            visited,
+                            c.expr_));
+                ++errors;
+              }
+          }
+      }
+
+    return errors;
+  }
+
+  /// Returns true if a filter with @a expr accepts @a event.
+  bool
+  match (const char *expr, const CosNotification::StructuredEvent &event)
+  {
+    TAO_Notify_ETCL_Filter *filter = 0;
+    ACE_NEW_THROW_EX (filter,
+                      TAO_Notify_ETCL_Filter (PortableServer::POA::_nil (),
+                                              "EXTENDED_TCL",
+                                              0),
+                      CORBA::NO_MEMORY ());
+    PortableServer::ServantBase_var owner_transfer (filter);
+
+    // The filter operations are public in the skeleton only.
+    POA_CosNotifyFilter::Filter &servant = *filter;
+
+    CosNotifyFilter::ConstraintExpSeq exps (1);
+    exps.length (1);
+    exps[0].constraint_expr = expr;
+    CosNotifyFilter::ConstraintInfoSeq_var info =
+      servant.add_constraints (exps);
+
+    bool const matched = servant.match_structured (event);
+    servant.remove_all_constraints ();
+    return matched;
+  }
+
+  int
+  check_duplicates (const CosNotification::StructuredEvent &event)
+  {
+    int errors = 0;
+
+    CosNotification::StructuredEvent duplicate_data (event);
+    CORBA::Any any;
+    any <<= static_cast<CORBA::Long> (6);
+    add (duplicate_data.filterable_data, "l", any);
+
+    CosNotification::StructuredEvent duplicate_header (event);
+    any <<= static_cast<CORBA::Short> (4);
+    add (duplicate_header.header.variable_header, "Priority", any);
+
+    const CosNotification::StructuredEvent *const events[] =
+      { &duplicate_data, &duplicate_header };
+    const char *const names[] = { "filterable_data", "variable_header" };
+
+    for (size_t i = 0; i < sizeof events / sizeof events[0]; ++i)
+      {
+        TAO_Notify_Constraint_Visitor visitor;
+        if (visitor.bind_structured_event (*events[i]) == 0)
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("ERROR: the visitor binds an event with ")
+                        ACE_TEXT ("duplicate %C\n"),
+                        names[i]));
+            ++errors;
+          }
+
+        for (size_t j = 0; j < sizeof constraints / sizeof constraints[0]; ++j)
+          {
+            const Constraint &c = constraints[j];
+
+            if (c.result_ && match (c.expr_, *events[i]))
+              {
+                ACE_ERROR ((LM_ERROR,
+                            ACE_TEXT ("ERROR: <%C> accepts an event with ")
+                            ACE_TEXT ("duplicate %C\n"),
+                            c.expr_,
+                            names[i]));
+                ++errors;
+              }
+          }
+      }
+
+    // Without the duplicates the same constraints accept the event.
+    for (size_t j = 0; j < sizeof constraints / sizeof constraints[0]; ++j)
+      {
+        const Constraint &c = constraints[j];
+
+        if (c.result_ && !match (c.expr_, event))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("ERROR: the filter with <%C> does not ")
+                        ACE_TEXT ("accept the event\n"),
+                        c.expr_));
+            ++errors;
+          }
+      }
+
+    return errors;
+  }
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int errors = 0;
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      CosNotification::StructuredEvent event;
+      make_event (event);
+      errors += check (event, "local");
+
+      // Demarshaled, the values are read from the CDR buffers.
+      TAO_OutputCDR out;
+      if (!(out << event))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("ERROR: cannot marshal the event\n")),
+                            1);
+        }
+
+      TAO_InputCDR in (out);
+      CosNotification::StructuredEvent decoded;
+      if (!(in >> decoded))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("ERROR: cannot demarshal the event\n")),
+                            1);
+        }
+      errors += check (decoded, "decoded");
+
+      errors += check_duplicates (event);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Compiled_Constraint: ");
+      return 1;
+    }
+
+  if (errors != 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("ERROR: %d checks failed\n"),
+                         errors),
+                        1);
+    }
+
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Compiled_Constraint test passed\n")));
+  return 0;
+}
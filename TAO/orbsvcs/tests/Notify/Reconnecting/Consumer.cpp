@@ -4,6 +4,7 @@
 #include "tao/TimeBaseC.h"
 #include "ace/OS_NS_strings.h"
 #include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_unistd.h"
 #include "tao/AnyTypeCode/Any.h"
 
 
@@ -61,6 +62,12 @@ StructuredPushConsumer_i::set_expectations (size_t expected, size_t fail, size_t
   this->verbose_ = verbose;
 }
 
+void
+StructuredPushConsumer_i::set_delay (const ACE_Time_Value & delay)
+{
+  this->delay_ = delay;
+}
+
 void
 StructuredPushConsumer_i::offer_change (
     const CosNotification::EventTypeSeq & added,
@@ -130,6 +137,10 @@ void
 StructuredPushConsumer_i::push_structured_event (
         const CosNotification::StructuredEvent & notification)
 {
+  if (this->delay_ != ACE_Time_Value::zero)
+  {
+    ACE_OS::sleep (this->delay_);
+  }
   this->received_ += 1;
   if (this->received_ == this->expect_ + 1)
   {
@@ -274,6 +285,12 @@ SequencePushConsumer_i::set_expectations (size_t expected, size_t fail,size_t se
   this->verbose_ = verbose;
 }
 
+void
+SequencePushConsumer_i::set_delay (const ACE_Time_Value & delay)
+{
+  this->delay_ = delay;
+}
+
 void
 SequencePushConsumer_i::offer_change (
     const CosNotification::EventTypeSeq & added,
@@ -343,6 +360,10 @@ SequencePushConsumer_i::push_structured_events (
       const CosNotification::EventBatch & notifications
     )
 {
+  if (this->delay_ != ACE_Time_Value::zero)
+  {
+    ACE_OS::sleep (this->delay_);
+  }
   CORBA::ULong batch_size = notifications.length();
   if (this->verbose_)
   {
@@ -487,6 +508,12 @@ AnyPushConsumer_i::set_expectations (size_t expected, size_t fail, size_t serial
   this->verbose_ = verbose;
 }
 
+void
+AnyPushConsumer_i::set_delay (const ACE_Time_Value & delay)
+{
+  this->delay_ = delay;
+}
+
 void
 AnyPushConsumer_i::offer_change (
     const CosNotification::EventTypeSeq & added,
@@ -556,6 +583,10 @@ AnyPushConsumer_i::push (
         const CORBA::Any & data
       )
 {
+  if (this->delay_ != ACE_Time_Value::zero)
+  {
+    ACE_OS::sleep (this->delay_);
+  }
   this->received_ += 1;
   if (this->received_ == this->expect_ + 1)
   {
@@ -838,6 +869,11 @@ Consumer_Main::parse_single_arg (int argc, ACE_TCHAR *argv[])
     this->serial_number_= ACE_OS::atoi (argv[1]);
     consumed = 2;
   }
+  else if (ACE_OS::strcasecmp (argv[0], ACE_TEXT("-delay")) == 0 && argc > 1)
+  {
+    this->delay_.msec (static_cast<long> (ACE_OS::atoi (argv[1])));
+    consumed = 2;
+  }
   else if (ACE_OS::strcasecmp (argv[0], ACE_TEXT("-nonamesvc")) == 0)
   {
     this->use_naming_service_ = false;
@@ -863,6 +899,7 @@ void Consumer_Main::usage(FILE * out)const
     ACE_TEXT ("  -fail n           Throw an exception every n events.\n")
     ACE_TEXT ("  -serial_number n  What serial number to start with\n")
     ACE_TEXT ("                    or -1 to disable serial number checking.\n")
+    ACE_TEXT ("  -delay msec       Take msec to handle each push.\n")
     ACE_TEXT ("  -v                Verbose output.\n")
     ACE_TEXT ("  -disconnect       Disconnect from channel on exit (prevents reconnect.)\n")
     ACE_TEXT ("  -nonamesvc        Don't use the name service to find EventChannelFactory\n")
@@ -929,6 +966,7 @@ int Consumer_Main::init (int argc, ACE_TCHAR *argv[])
           ));
       }
       this->structured_push_consumer_.set_expectations (this->expect_, this->fail_, this->serial_number_, this->verbose_);
+      this->structured_push_consumer_.set_delay (this->delay_);
       init_structured_proxy_supplier ();
       break;
     }
@@ -943,6 +981,7 @@ int Consumer_Main::init (int argc, ACE_TCHAR *argv[])
           ));
       }
       this->sequence_push_consumer_.set_expectations (this->expect_, this->fail_, this->serial_number_, this->verbose_);
+      this->sequence_push_consumer_.set_delay (this->delay_);
       init_sequence_proxy_supplier ();
       break;
     }
@@ -957,6 +996,7 @@ int Consumer_Main::init (int argc, ACE_TCHAR *argv[])
           ));
       }
       this->any_push_consumer_.set_expectations (this->expect_, this->fail_, this->serial_number_, this->verbose_);
+      this->any_push_consumer_.set_delay (this->delay_);
       init_any_proxy_supplier ();
       break;
     }
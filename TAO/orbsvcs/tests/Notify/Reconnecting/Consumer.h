@@ -38,6 +38,7 @@ public:
 
   size_t received () const;
   void set_expectations (size_t expecte, size_t fail, size_t serial_number, bool verbose);
+  void set_delay (const ACE_Time_Value & delay);
   bool has_problem () const;
   void set_connected (bool flag);
   bool is_connected () const;
@@ -55,6 +56,7 @@ private:
   size_t exceptions_thrown_;
   bool problem_;
   bool connected_;
+  ACE_Time_Value delay_;
 };
 
 class SequencePushConsumer_i : public virtual POA_CosNotifyComm::SequencePushConsumer
@@ -75,6 +77,7 @@ public:
 
   size_t received () const;
   void set_expectations (size_t expecte, size_t fail, size_t serial_number, bool verbose);
+  void set_delay (const ACE_Time_Value & delay);
   bool has_problem () const;
   void set_connected (bool flag);
   bool is_connected () const;
@@ -92,6 +95,7 @@ private:
   size_t exceptions_thrown_;
   bool problem_;
   bool connected_;
+  ACE_Time_Value delay_;
 };
 
 class AnyPushConsumer_i : public virtual POA_CosNotifyComm::PushConsumer
@@ -109,6 +113,7 @@ public:
 
   size_t received () const;
   void set_expectations (size_t expecte, size_t fail, size_t serial_number, bool verbose);
+  void set_delay (const ACE_Time_Value & delay);
   bool has_problem () const;
   void set_connected (bool flag);
   bool is_connected () const;
@@ -126,6 +131,7 @@ private:
   size_t exceptions_thrown_;
   bool problem_;
   bool connected_;
+  ACE_Time_Value delay_;
 };
 
 class ReconnectionCallback_i : public virtual POA_NotifyExt::ReconnectionCallback
@@ -213,6 +219,7 @@ class Consumer_Main
   size_t fail_;             // -fail n
   bool use_naming_service_; // -nonamesvc
   size_t serial_number_;    // -serial_number
+  ACE_Time_Value delay_;    // -delay msec
   bool disconnect_on_exit_; // -disconnect
   size_t structured_count_;
   size_t sequence_count_;
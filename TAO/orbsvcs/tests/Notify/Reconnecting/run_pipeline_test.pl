@@ -0,0 +1,160 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+# ******************************************************************
+# Pragma Section
+# ******************************************************************
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+my $nfs = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $sup = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+my $con = PerlACE::TestTarget::create_target (3) || die "Create target 3 failed\n";
+
+$sup->AddLibPath ('../lib');
+$con->AddLibPath ('../lib');
+
+# ******************************************************************
+# Data Section
+# ******************************************************************
+
+my $notify_port = $nfs->RandomPort ();
+my $notify_host = $nfs->HostName ();
+
+my $svcconf = "ns_st_pipeline.conf";
+# File used to detect notification service startup
+$nfsiorfile = "notify.ior";
+# File used to communicate channel # from consumer to supplier
+$channel_id = "channel_id";
+
+# Events sent for each event type, and how long the consumer takes
+# with each of them.
+my $events = 200;
+my $delay = 20;
+
+my $verbose = "";
+
+# Process command line arguments
+foreach my $i (@ARGV) {
+    if ($i eq '-v' or $i eq '-verbose') {
+        $verbose = '-v';
+    }
+    else {
+        print "TEST SCRIPT: unknown: $i\n";
+        print "TEST SCRIPT: usage: -v\n";
+        exit(-4);
+    }
+}
+
+my $nfs_nfsiorfile = $nfs->LocalFile ($nfsiorfile);
+my $con_channel_id = $con->LocalFile ($channel_id);
+my $sup_channel_id = $sup->LocalFile ($channel_id);
+my $nfs_svcconf = $nfs->LocalFile ($svcconf);
+
+sub cleanup {
+    $nfs->DeleteFile ($nfsiorfile);
+    $con->DeleteFile ($channel_id);
+    $sup->DeleteFile ($channel_id);
+}
+
+cleanup ();
+
+# ******************************************************************
+# Main Section
+# ******************************************************************
+
+my $client_args = "$verbose -NoNameSvc -ORBInitRef " .
+                   "NotifyEventChannelFactory=corbaloc::" .
+                   "$notify_host:$notify_port/NotifyEventChannelFactory ";
+my $ns_args = "-ORBSvcConf $nfs_svcconf -ORBObjRefStyle url -NoNameSvc -Boot " .
+              "-IORoutput $nfs_nfsiorfile " .
+              "-ORBEndpoint iiop://:$notify_port ";
+
+my $NFS = $nfs->CreateProcess ("$ENV{TAO_ROOT}/orbsvcs/Notify_Service/tao_cosnotification");
+my $CON = $con->CreateProcess ("Consumer");
+my $SUP = $sup->CreateProcess ("Supplier");
+
+$NFS->Arguments($ns_args);
+print "TEST SCRIPT: ", $NFS->CommandLine(), "\n" if ($verbose eq '-v');
+my $NFS_status = $NFS->Spawn ();
+if ($NFS_status != 0) {
+    print STDERR "ERROR: Notify Service returned $NFS_status\n";
+    exit 1;
+}
+if ($nfs->WaitForFileTimed ($nfsiorfile,$nfs->ProcessStartWaitInterval()) == -1) {
+    print STDERR "ERROR: cannot find file <$nfs_nfsiorfile>\n";
+    $NFS->Kill (); $NFS->TimedWait (1);
+    exit 1;
+}
+
+# The supplier sends faster than the consumer takes the events, so
+# they are pipelined.  The consumer checks that it gets each of them
+# once and in order.
+foreach my $eventType ('-any', '-structured') {
+    $con->DeleteFile ($channel_id);
+    $sup->DeleteFile ($channel_id);
+
+    $CON->Arguments("-channel $con_channel_id -expect $events " .
+                    "-delay $delay -disconnect $eventType $client_args");
+    print "TEST SCRIPT: ", $CON->CommandLine(), "\n" if ($verbose eq '-v');
+    $CON_status = $CON->Spawn ();
+    if ($CON_status != 0) {
+        print STDERR "ERROR: Consumer returned $CON_status\n";
+        $NFS->Kill (); $NFS->TimedWait (1);
+        exit 1;
+    }
+    if ($con->WaitForFileTimed ($channel_id,$con->ProcessStartWaitInterval()) == -1) {
+        print STDERR "ERROR: cannot find file <$con_channel_id>\n";
+        $CON->Kill (); $CON->TimedWait (1);
+        $NFS->Kill (); $NFS->TimedWait (1);
+        exit 1;
+    }
+    if ($con->GetFile ($channel_id) == -1) {
+        print STDERR "ERROR: cannot retrieve file <$con_channel_id>\n";
+        $CON->Kill (); $CON->TimedWait (1);
+        $NFS->Kill (); $NFS->TimedWait (1);
+        exit 1;
+    }
+    if ($sup->PutFile ($channel_id) == -1) {
+        print STDERR "ERROR: cannot set file <$sup_channel_id>\n";
+        $CON->Kill (); $CON->TimedWait (1);
+        $NFS->Kill (); $NFS->TimedWait (1);
+        exit 1;
+    }
+
+    $SUP->Arguments("-channel $sup_channel_id -send $events " .
+                    "-disconnect $eventType $client_args");
+    print "TEST SCRIPT: ", $SUP->CommandLine(), "\n" if ($verbose eq '-v');
+    $SUP_status = $SUP->SpawnWaitKill ($sup->ProcessStartWaitInterval()+45);
+    if ($SUP_status != 0) {
+        print STDERR "ERROR: Supplier returned $SUP_status\n";
+        $CON->Kill (); $CON->TimedWait (1);
+        $NFS->Kill (); $NFS->TimedWait (1);
+        exit 1;
+    }
+
+    $CON_status = $CON->WaitKill ($con->ProcessStopWaitInterval()+45);
+    if ($CON_status != 0) {
+        print STDERR "ERROR: Consumer returned $CON_status\n";
+        $status = 1;
+    }
+    else {
+        print "TEST SCRIPT: ****Passed: $eventType events delivered in order.\n";
+    }
+}
+
+$NFS_status = $NFS->Kill ($nfs->ProcessStopWaitInterval());
+if ($NFS_status != 0) {
+    print STDERR "ERROR: Notify Service returned $NFS_status\n";
+    $status = 1;
+}
+
+cleanup ();
+
+exit $status;
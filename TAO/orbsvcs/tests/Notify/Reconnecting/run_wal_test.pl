@@ -0,0 +1,238 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+# ******************************************************************
+# Pragma Section
+# ******************************************************************
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+use File::Path qw(rmtree);
+
+$status = 0;
+
+my $nfs = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $sup = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+my $con = PerlACE::TestTarget::create_target (3) || die "Create target 3 failed\n";
+
+$sup->AddLibPath ('../lib');
+$con->AddLibPath ('../lib');
+
+# ******************************************************************
+# Data Section
+# ******************************************************************
+
+my $eventType = '-any'; # your choice of -any -structured or -sequence
+my $notify_port = $nfs->RandomPort ();
+my $notify_host = $nfs->HostName ();
+
+my $svcconf = "ns_st_wal.conf";
+# File used to detect notification service startup
+$nfsiorfile = "notify.ior";
+# Hard coded file name in Consumer.cpp (for now)
+$conidsfile = "consumer.ids";
+ # Hard coded file name in Supplier.cpp (for now)
+$supidsfile = "supplier.ids";
+# File used to communicate channel # from consumer to supplier
+$channel_id = "channel_id";
+# File used to save configuration for reconnect test
+$save_xml = "reconnect_test.xml";
+# File names comes from svc.conf (+.xml & .000)
+$save_000 = "reconnect_test.000";
+# File names comes from svc.conf (+.xml & .001)
+$save_001 = "reconnect_test.001";
+# Event log directory (from svc.conf)
+$eventlog = "event_persist.wal";
+
+my $verbose = "";
+
+# Process command line arguments
+foreach my $i (@ARGV) {
+    if ($i eq '-any') {
+        $eventType = '-any';
+    }
+    elsif ($i eq '-str' or $i eq '-structured') {
+        $eventType = '-structured';
+    }
+    elsif ($i eq '-seq' or $i eq '-sequence') {
+        $eventType = '-sequence';
+    }
+    elsif ($i eq '-mt') {
+        $svcconf = 'ns_mt_wal.conf';
+    }
+    elsif ($i eq '-v' or $i eq '-verbose') {
+        $verbose = '-v';
+    }
+    else {
+        print "TEST SCRIPT: unknown: $i\n";
+        print "TEST SCRIPT: usage: [-any|-str|-seq] -mt -v\n";
+        exit(-4);
+    }
+}
+
+my $nfs_nfsiorfile = $nfs->LocalFile ($nfsiorfile);
+my $con_channel_id = $con->LocalFile ($channel_id);
+my $sup_channel_id = $sup->LocalFile ($channel_id);
+my $nfs_eventlog = $nfs->LocalFile ($eventlog);
+my $nfs_svcconf = $nfs->LocalFile ($svcconf);
+
+sub cleanup {
+    $nfs->DeleteFile ($nfsiorfile);
+    $con->DeleteFile ($conidsfile);
+    $sup->DeleteFile ($supidsfile);
+    $con->DeleteFile ($channel_id);
+    $sup->DeleteFile ($channel_id);
+    $nfs->DeleteFile ($save_xml);
+    $nfs->DeleteFile ($save_000);
+    $nfs->DeleteFile ($save_001);
+    rmtree ($nfs_eventlog);
+}
+
+cleanup ();
+
+# ******************************************************************
+# Main Section
+# ******************************************************************
+
+my $client_args = "$eventType $verbose -NoNameSvc -ORBInitRef " .
+                   "NotifyEventChannelFactory=corbaloc::" .
+                   "$notify_host:$notify_port/NotifyEventChannelFactory ";
+my $ns_args = "-ORBSvcConf $nfs_svcconf -ORBObjRefStyle url -NoNameSvc -Boot " .
+              "-IORoutput $nfs_nfsiorfile " .
+              "-ORBEndpoint iiop://:$notify_port ";
+
+my $NFS = $nfs->CreateProcess ("$ENV{TAO_ROOT}/orbsvcs/Notify_Service/tao_cosnotification");
+my $CON = $con->CreateProcess ("Consumer");
+my $SUP = $sup->CreateProcess ("Supplier");
+
+sub start_notify {
+    $NFS->Arguments($ns_args);
+    print "TEST SCRIPT: ", $NFS->CommandLine(), "\n" if ($verbose eq '-v');
+    my $NFS_status = $NFS->Spawn ();
+    if ($NFS_status != 0) {
+        print STDERR "ERROR: Notify Service returned $NFS_status\n";
+        exit 1;
+    }
+    if ($nfs->WaitForFileTimed ($nfsiorfile,$nfs->ProcessStartWaitInterval()) == -1) {
+        print STDERR "ERROR: cannot find file <$nfs_nfsiorfile>\n";
+        $NFS->Kill (); $NFS->TimedWait (1);
+        exit 1;
+    }
+}
+
+################
+# begin test 1
+################
+
+start_notify ();
+
+# The consumer takes the first batch of events and goes away without
+# disconnecting, so the proxy stays in the topology.
+my $expected = 10;
+$CON->Arguments("-channel $con_channel_id " .
+                "-expect $expected $client_args");
+print "TEST SCRIPT: ", $CON->CommandLine(), "\n" if ($verbose eq '-v');
+$CON_status = $CON->Spawn ();
+if ($CON_status != 0) {
+    print STDERR "ERROR: Consumer returned $CON_status\n";
+    $NFS->Kill (); $NFS->TimedWait (1);
+    exit 1;
+}
+if ($con->WaitForFileTimed ($channel_id,$con->ProcessStartWaitInterval()) == -1) {
+    print STDERR "ERROR: cannot find file <$con_channel_id>\n";
+    $CON->Kill (); $CON->TimedWait (1);
+    $NFS->Kill (); $NFS->TimedWait (1);
+    exit 1;
+}
+if ($con->GetFile ($channel_id) == -1) {
+    print STDERR "ERROR: cannot retrieve file <$con_channel_id>\n";
+    $CON->Kill (); $CON->TimedWait (1);
+    $NFS->Kill (); $NFS->TimedWait (1);
+    exit 1;
+}
+if ($sup->PutFile ($channel_id) == -1) {
+    print STDERR "ERROR: cannot set file <$sup_channel_id>\n";
+    $CON->Kill (); $CON->TimedWait (1);
+    $NFS->Kill (); $NFS->TimedWait (1);
+    exit 1;
+}
+
+$SUP->Arguments("-channel $sup_channel_id -send $expected $client_args");
+print "TEST SCRIPT: ", $SUP->CommandLine(), "\n" if ($verbose eq '-v');
+$SUP_status = $SUP->SpawnWaitKill ($sup->ProcessStartWaitInterval()+45);
+if ($SUP_status != 0) {
+    print STDERR "ERROR: Supplier returned $SUP_status\n";
+    $CON->Kill (); $CON->TimedWait (1);
+    $NFS->Kill (); $NFS->TimedWait (1);
+    exit 1;
+}
+
+$CON_status = $CON->WaitKill ($con->ProcessStopWaitInterval()+15);
+if ($CON_status != 0) {
+    print STDERR "ERROR: Consumer returned $CON_status\n";
+    $NFS->Kill (); $NFS->TimedWait (1);
+    exit 1;
+}
+
+print "TEST SCRIPT: ****Passed: Events delivered with the log.\n";
+
+################
+# end of test 1
+################
+
+################
+# begin test 2
+################
+
+# With the consumer gone these events can only be logged.  Send enough
+# of them for the log to use several segments.
+my $next_expected = 20;
+$SUP->Arguments("-channel $sup_channel_id -send $next_expected " .
+                "-serial_number $expected $client_args");
+print "TEST SCRIPT: ", $SUP->CommandLine(), "\n" if ($verbose eq '-v');
+$SUP_status = $SUP->SpawnWaitKill ($sup->ProcessStartWaitInterval()+45);
+if ($SUP_status != 0) {
+    print STDERR "ERROR: Supplier returned $SUP_status\n";
+    $NFS->Kill (); $NFS->TimedWait (1);
+    exit 1;
+}
+
+# Kill the Notification Service without giving it a chance to shut
+# down, then start it again from the topology and the log.
+print "TEST SCRIPT: Kill the Notification Service\n" if ($verbose eq '-v');
+$NFS->Kill (); $NFS->TimedWait (1);
+$nfs->DeleteFile ($nfsiorfile);
+
+# sleep to avoid socket-related problems
+sleep(10 * $nfs->ProcessStartWaitInterval());
+start_notify ();
+
+# The undelivered events must come back, in order.
+$CON->Arguments("-channel $con_channel_id -expect $next_expected " .
+                "-serial_number $expected $client_args");
+print "TEST SCRIPT: ", $CON->CommandLine(), "\n" if ($verbose eq '-v');
+$CON_status = $CON->SpawnWaitKill ($con->ProcessStartWaitInterval()+45);
+if ($CON_status != 0) {
+    print STDERR "ERROR: Consumer returned $CON_status\n";
+    $status = 1;
+}
+else {
+    print "TEST SCRIPT: ****Passed: Events delivered again after a restart.\n";
+}
+
+################
+# end of test 2
+################
+
+$NFS_status = $NFS->Kill ($nfs->ProcessStopWaitInterval());
+if ($NFS_status != 0) {
+    print STDERR "ERROR: Notify Service returned $NFS_status\n";
+    $status = 1;
+}
+
+cleanup ();
+
+exit $status;
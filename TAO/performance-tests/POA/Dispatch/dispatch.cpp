@@ -0,0 +1,212 @@
+//=============================================================================
+/**
+ *  @file    dispatch.cpp
+ *
+ *  Measures the throughput of POA dispatching from several threads.
+ *  Run with -ORBCollocationStrategy thru_poa so that every call goes
+ *  through the POA.
+ */
+//=============================================================================
+
+#include "testS.h"
+#include "ace/Get_Opt.h"
+#include "ace/Barrier.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_stdio.h"
+
+#include <atomic>
+
+/**
+ * @class Simple_i
+ *
+ * @brief Servant that does nothing
+ */
+class Simple_i : public POA_Test::Simple
+{
+public:
+  void ping () override
+  {
+  }
+};
+
+// Program statics
+static int nthreads = 4;
+static int niterations = 100000;
+static int nobjects = 16;
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:i:o:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 't':
+        nthreads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'o':
+        nobjects = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-t <nthreads> "
+                           "-i <niterations> "
+                           "-o <nobjects> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nthreads < 1 || niterations < 1 || nobjects < 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "threads, iterations and objects must be positive\n"),
+                      -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// State shared by the calling threads.
+struct Dispatch_Test
+{
+  Test::Simple_var *objects;
+  ACE_Barrier *barrier;
+  std::atomic<int> failures;
+};
+
+static ACE_THR_FUNC_RETURN
+call_objects (void *arg)
+{
+  Dispatch_Test *test = static_cast<Dispatch_Test *> (arg);
+
+  // Start together with the other threads.
+  test->barrier->wait ();
+
+  try
+    {
+      for (int i = 0; i != niterations; ++i)
+        test->objects[i % nobjects]->ping ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("ping");
+      ++test->failures;
+    }
+
+  test->barrier->wait ();
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references ("RootPOA");
+
+      if (CORBA::is_nil (poa_object.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Unable to initialize the POA.\n"),
+                          1);
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      poa_manager->activate ();
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      Simple_i *servants = new Simple_i[nobjects];
+      Test::Simple_var *objects = new Test::Simple_var[nobjects];
+
+      for (int i = 0; i != nobjects; ++i)
+        {
+          PortableServer::ObjectId_var id =
+            root_poa->activate_object (&servants[i]);
+
+          CORBA::Object_var object =
+            root_poa->id_to_reference (id.in ());
+
+          objects[i] = Test::Simple::_narrow (object.in ());
+        }
+
+      // One call per object outside the measurement, so that the
+      // dispatch cache (if enabled) is filled.
+      for (int i = 0; i != nobjects; ++i)
+        objects[i]->ping ();
+
+      ACE_Barrier barrier (nthreads + 1);
+      Dispatch_Test test;
+      test.objects = objects;
+      test.barrier = &barrier;
+      test.failures = 0;
+
+      if (ACE_Thread_Manager::instance ()->spawn_n (nthreads,
+                                                    call_objects,
+                                                    &test) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, "%p\n", "spawn_n"), 1);
+
+      ACE_High_Res_Timer timer;
+      barrier.wait ();
+      timer.start ();
+      barrier.wait ();
+      timer.stop ();
+
+      ACE_Thread_Manager::instance ()->wait ();
+
+      ACE_hrtime_t usecs;
+      timer.elapsed_microseconds (usecs);
+
+      double const calls =
+        static_cast<double> (nthreads) * niterations;
+      double const seconds =
+        usecs == 0 ? 1e-6 : static_cast<double> (usecs) / 1e6;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "%d threads, %d objects: %.0f calls in %.3f s, "
+                  "%.0f calls/s, %.3f usecs/call per thread\n",
+                  nthreads,
+                  nobjects,
+                  calls,
+                  seconds,
+                  calls / seconds,
+                  seconds * 1e6 / niterations));
+
+      delete [] objects;
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+
+      delete [] servants;
+
+      if (test.failures != 0)
+        return 1;
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
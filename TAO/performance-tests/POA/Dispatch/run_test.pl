@@ -0,0 +1,41 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$iterations = 100000;
+$status = 0;
+
+print STDERR "================ POA Dispatch Test\n";
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+$SV = $server->CreateProcess ("dispatch");
+
+$dispatch_cache_directive = "-ORBsvcconfdirective \"static Server_Strategy_Factory '-ORBPOADispatchCache 1'\"";
+
+foreach $cache ("", $dispatch_cache_directive) {
+    if ($cache eq "") {
+        print STDERR "\nDispatching with the object adapter lock\n";
+    }
+    else {
+        print STDERR "\nDispatching through the dispatch cache\n";
+    }
+
+    foreach $threads (1, 2, 4, 8) {
+        $SV->Arguments ("-ORBCollocationStrategy thru_poa -t $threads -i $iterations $cache");
+
+        $test_status = $SV->SpawnWaitKill ($server->ProcessStartWaitInterval() + 200);
+
+        if ($test_status != 0) {
+            print STDERR "ERROR: dispatch returned $test_status\n";
+            $status = 1;
+        }
+    }
+}
+
+exit $status;
@@ -0,0 +1,243 @@
+//=============================================================================
+/**
+ *  @file    object_map.cpp
+ *
+ *  Measures the memory used by the active object map and the time it
+ *  takes to activate, find and deactivate objects.  Select the map
+ *  with the demultiplexing options of the Server_Strategy_Factory.
+ *  Only one POA is filled per run, so that the memory it reports
+ *  is not hidden by what an earlier test freed.
+ */
+//=============================================================================
+
+#include "testS.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_sys_resource.h"
+
+/**
+ * @class test_i
+ *
+ * @brief Oversimplified servant class
+ */
+class test_i : public POA_test
+{
+};
+
+// Program statics
+static u_long nobjects = 100000;
+static u_long nlookups = 1000000;
+static bool system_ids = false;
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:l:s"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        nobjects = static_cast<u_long> (ACE_OS::atoi (get_opts.opt_arg ()));
+        break;
+
+      case 'l':
+        nlookups = static_cast<u_long> (ACE_OS::atoi (get_opts.opt_arg ()));
+        break;
+
+      case 's':
+        system_ids = true;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <nobjects> "
+                           "-l <nlookups> "
+                           "[-s [system ids in the RootPOA]] "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nobjects < 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "the number of objects must be positive\n"),
+                      -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Peak resident set size in kilobytes, 0 if unknown.
+static long
+peak_memory ()
+{
+#if defined (ACE_HAS_GETRUSAGE) && !defined (ACE_WIN32)
+  ACE_Rusage usage;
+  if (ACE_OS::getrusage (RUSAGE_SELF, &usage) == 0)
+    return usage.ru_maxrss;
+#endif /* ACE_HAS_GETRUSAGE && !ACE_WIN32 */
+  return 0;
+}
+
+/**
+ * @class stats
+ *
+ * @brief Prints the time per operation of a scope.
+ */
+class stats
+{
+public:
+  stats (const char *test_name, u_long operations)
+    : test_name_ (test_name),
+      operations_ (operations)
+  {
+    this->timer_.start ();
+  }
+
+  ~stats ()
+  {
+    this->timer_.stop ();
+
+    ACE_hrtime_t nsecs;
+    this->timer_.elapsed_time (nsecs);
+
+    ACE_DEBUG ((LM_DEBUG,
+                "\t%-24C %10.1f ns/call\n",
+                this->test_name_,
+                static_cast<double> (nsecs) / this->operations_));
+  }
+
+private:
+  ACE_High_Res_Timer timer_;
+  const char *test_name_;
+  u_long operations_;
+};
+
+/// Simple linear congruential generator, so that lookups do not go
+/// through the map in activation order.
+static u_long
+next_index (u_long &seed)
+{
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % nobjects;
+}
+
+static void
+test_poa (PortableServer::POA_ptr poa,
+          bool user_ids,
+          const char *title)
+{
+  test_i *servants = new test_i[nobjects];
+  PortableServer::ObjectId_var *ids =
+    new PortableServer::ObjectId_var[nobjects];
+
+  char id_buffer[32];
+  if (user_ids)
+    for (u_long i = 0; i != nobjects; ++i)
+      {
+        ACE_OS::snprintf (id_buffer, sizeof id_buffer, "device-%lu", i);
+        ids[i] = PortableServer::string_to_ObjectId (id_buffer);
+      }
+
+  ACE_DEBUG ((LM_DEBUG, "%C, %lu objects:\n", title, nobjects));
+
+  long const memory_before = peak_memory ();
+
+  {
+    stats s ("activate", nobjects);
+
+    for (u_long i = 0; i != nobjects; ++i)
+      if (user_ids)
+        poa->activate_object_with_id (ids[i].in (), &servants[i]);
+      else
+        ids[i] = poa->activate_object (&servants[i]);
+  }
+
+  long const memory_after = peak_memory ();
+  if (memory_before != 0)
+    ACE_DEBUG ((LM_DEBUG,
+                "\t%-24C %10.1f bytes/object\n",
+                "memory",
+                (memory_after - memory_before) * 1024.0 / nobjects));
+
+  u_long seed = 42;
+  {
+    stats s ("id_to_servant", nlookups);
+
+    for (u_long i = 0; i != nlookups; ++i)
+      {
+        PortableServer::ServantBase_var servant =
+          poa->id_to_servant (ids[next_index (seed)].in ());
+      }
+  }
+
+  {
+    stats s ("servant_to_id", nlookups);
+
+    for (u_long i = 0; i != nlookups; ++i)
+      {
+        PortableServer::ObjectId_var id =
+          poa->servant_to_id (&servants[next_index (seed)]);
+      }
+  }
+
+  {
+    stats s ("deactivate", nobjects);
+
+    for (u_long i = 0; i != nobjects; ++i)
+      poa->deactivate_object (ids[i].in ());
+  }
+
+  delete [] ids;
+  delete [] servants;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (obj.in ());
+
+      CORBA::PolicyList policies (1);
+      policies.length (1);
+      policies[0] =
+        root_poa->create_id_assignment_policy (PortableServer::USER_ID);
+
+      PortableServer::POA_var child_poa =
+        root_poa->create_POA ("child POA",
+                              PortableServer::POAManager::_nil (),
+                              policies);
+
+      policies[0]->destroy ();
+
+      if (system_ids)
+        test_poa (root_poa.in (), false, "system ids");
+      else
+        test_poa (child_poa.in (), true, "user ids");
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,45 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$objects = 100000;
+$lookups = 1000000;
+$status = 0;
+
+print STDERR "================ POA Object Map Test\n";
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+$SV = $server->CreateProcess ("object_map");
+
+sub run_object_map
+{
+    my $options = shift;
+    my $args = shift;
+
+    $SV->Arguments ("-ORBsvcconfdirective \"static Server_Strategy_Factory '$options'\" -n $objects -l $lookups $args");
+
+    $test_status = $SV->SpawnWaitKill ($server->ProcessStartWaitInterval() + 200);
+
+    if ($test_status != 0) {
+        print STDERR "ERROR: object_map returned $test_status\n";
+        $status = 1;
+    }
+}
+
+foreach $strategy ("dynamic", "flat") {
+    print STDERR "\n$strategy user id and reverse maps\n";
+    run_object_map ("-ORBUseridPolicyDemuxStrategy $strategy -ORBUniqueidPolicyReverseDemuxStrategy $strategy", "");
+}
+
+foreach $strategy ("active", "dynamic", "flat") {
+    print STDERR "\n$strategy system id map\n";
+    run_object_map ("-ORBSystemidPolicyDemuxStrategy $strategy", "-s");
+}
+
+exit $status;
@@ -18,9 +18,12 @@ TAO_Asynch_Queued_Message::TAO_Asynch_Queued_Message (
   TAO_ORB_Core *oc,
   ACE_Time_Value *timeout,
   ACE_Allocator *alloc,
-  bool is_heap_allocated)
+  bool is_heap_allocated,
+  size_t capacity)
   : TAO_Queued_Message (oc, alloc, is_heap_allocated)
   , size_ (contents->total_length ())
+  , capacity_ (capacity > size_ ? capacity : size_)
+  , count_ (1)
   , offset_ (0)
   , abs_timeout_ (ACE_Time_Value::zero)
 {
@@ -29,7 +32,7 @@ TAO_Asynch_Queued_Message::TAO_Asynch_Queued_Message (
       this->abs_timeout_ = ACE_High_Res_Timer::gettimeofday_hr () + *timeout;
     }
   // @@ Use a pool for these guys!!
-  ACE_NEW (this->buffer_, char[this->size_]);
+  ACE_NEW (this->buffer_, char[this->capacity_]);
 
   size_t copy_offset = 0;
   for (const ACE_Message_Block *i = contents;
@@ -51,6 +54,8 @@ TAO_Asynch_Queued_Message::TAO_Asynch_Queued_Message (char *buf,
                                                       bool is_heap_allocated)
   : TAO_Queued_Message (oc, alloc, is_heap_allocated)
   , size_ (size)
+  , capacity_ (size)
+  , count_ (1)
   , offset_ (0)
   , buffer_ (buf)
   , abs_timeout_ (abs_timeout)
@@ -165,6 +170,8 @@ TAO_Asynch_Queued_Message::clone (ACE_Allocator *alloc)
                       nullptr);
     }
 
+  qm->count_ = this->count_;
+
   return qm;
 }
 
@@ -207,4 +214,41 @@ TAO_Asynch_Queued_Message::copy_if_necessary (const ACE_Message_Block*)
   // It's never necessary for asynchronously queued messages
 }
 
+size_t
+TAO_Asynch_Queued_Message::message_count () const
+{
+  return this->count_;
+}
+
+bool
+TAO_Asynch_Queued_Message::append (const ACE_Message_Block *contents,
+                                   ACE_Time_Value *timeout)
+{
+  // Appending would give the message the timeout of one of them or
+  // keep it alive past the other's.
+  if (timeout != nullptr || this->abs_timeout_ != ACE_Time_Value::zero)
+    {
+      return false;
+    }
+
+  size_t const length = contents->total_length ();
+  if (length > this->capacity_ - this->size_)
+    {
+      return false;
+    }
+
+  for (const ACE_Message_Block *i = contents;
+       i != nullptr;
+       i = i->cont ())
+    {
+      ACE_OS::memcpy (this->buffer_ + this->size_,
+                      i->rd_ptr (),
+                      i->length ());
+      this->size_ += i->length ();
+    }
+
+  ++this->count_;
+  return true;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
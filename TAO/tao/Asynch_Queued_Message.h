@@ -45,6 +45,10 @@ public:
    * @param timeout The relative timeout after which this
    * message should be expired.
    *
+   * @param capacity Size of the buffer to allocate, so that later
+   * messages can be appended with append().  The buffer is never
+   * smaller than @a contents.
+   *
    * @todo I'm almost sure this class will require a callback
    *       interface for AMIs sent with SYNC_NONE policy.  Those guys
    *       need to hear when the connection timeouts or closes, but
@@ -54,7 +58,8 @@ public:
                              TAO_ORB_Core *oc,
                              ACE_Time_Value *timeout,
                              ACE_Allocator *alloc,
-                             bool is_heap_allocated);
+                             bool is_heap_allocated,
+                             size_t capacity = 0);
 
 
   /// Destructor
@@ -74,6 +79,9 @@ public:
   virtual void destroy ();
   virtual bool is_expired (const ACE_Time_Value &now) const;
   virtual void copy_if_necessary (const ACE_Message_Block* chain);
+  virtual size_t message_count () const;
+  virtual bool append (const ACE_Message_Block *contents,
+                       ACE_Time_Value *timeout);
   //@}
 
 protected:
@@ -106,7 +114,13 @@ private:
 
 private:
   /// The number of bytes in the buffer
-  size_t const size_;
+  size_t size_;
+
+  /// The number of bytes allocated for the buffer
+  size_t capacity_;
+
+  /// The number of messages in the buffer
+  size_t count_;
 
   /// The offset in the buffer
   /**
@@ -12,6 +12,7 @@
 #include "tao/orbconf.h"
 #include "tao/SystemException.h"
 #include "tao/Basic_Types_IDLv4.h"
+#include "tao/CDR_Native_Layout_T.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -330,9 +331,20 @@ namespace TAO {
     if ((new_length > strm.length()) || (new_length > target.maximum ())) {
       return false;
     }
+    bool const native = TAO::is_native_layout<value_t> (strm);
+    if (native && new_length > strm.length() / sizeof (value_t)) {
+      return false;
+    }
     sequence tmp;
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
+    if (native) {
+      if (!TAO::read_native_layout (strm, buffer, new_length)) {
+        return false;
+      }
+      tmp.swap(target);
+      return true;
+    }
     for(CORBA::ULong i = 0; i < new_length; ++i) {
       if (!(strm >> buffer[i])) {
         return false;
@@ -432,6 +444,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::SHORT_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::SHORT_SIZE,
+                                        ACE_CDR::SHORT_ALIGN,
+                                        length);
+    }
     return strm.write_short_array (source.get_buffer (), length);
   }
 
@@ -441,6 +459,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONG_SIZE,
+                                        ACE_CDR::LONG_ALIGN,
+                                        length);
+    }
     return strm.write_long_array (source.get_buffer (), length);
   }
 
@@ -450,6 +474,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONG_SIZE,
+                                        ACE_CDR::LONG_ALIGN,
+                                        length);
+    }
     return strm.write_ulong_array (source.get_buffer (), length);
   }
 
@@ -459,6 +489,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::SHORT_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::SHORT_SIZE,
+                                        ACE_CDR::SHORT_ALIGN,
+                                        length);
+    }
     return strm.write_ushort_array (source.get_buffer (), length);
   }
 
@@ -468,6 +504,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::OCTET_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::OCTET_SIZE,
+                                        ACE_CDR::OCTET_ALIGN,
+                                        length);
+    }
     return strm.write_octet_array (source.get_buffer (), length);
   }
 
@@ -497,6 +539,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONG_SIZE,
+                                        ACE_CDR::LONG_ALIGN,
+                                        length);
+    }
     return strm.write_float_array (source.get_buffer (), length);
   }
 
@@ -506,6 +554,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONGLONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONGLONG_SIZE,
+                                        ACE_CDR::LONGLONG_ALIGN,
+                                        length);
+    }
     return strm.write_double_array (source.get_buffer (), length);
   }
 
@@ -515,6 +569,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONGLONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONGLONG_SIZE,
+                                        ACE_CDR::LONGLONG_ALIGN,
+                                        length);
+    }
     return strm.write_longlong_array (source.get_buffer (), length);
   }
 
@@ -524,6 +584,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONGLONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONGLONG_SIZE,
+                                        ACE_CDR::LONGLONG_ALIGN,
+                                        length);
+    }
     return strm.write_ulonglong_array (source.get_buffer (), length);
   }
 
@@ -552,6 +618,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::OCTET_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::OCTET_SIZE,
+                                        ACE_CDR::OCTET_ALIGN,
+                                        length);
+    }
     return strm.write_uint8_array (source.get_buffer (), length);
   }
 
@@ -562,6 +634,12 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::OCTET_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::OCTET_SIZE,
+                                        ACE_CDR::OCTET_ALIGN,
+                                        length);
+    }
     return strm.write_int8_array (source.get_buffer (), length);
   }
 
@@ -571,6 +649,9 @@ namespace TAO {
     if (length > source.maximum () || !(strm << length)) {
       return false;
     }
+    if (TAO::is_native_layout<value_t> (strm)) {
+      return TAO::write_native_layout (strm, source.get_buffer (), length);
+    }
     for(CORBA::ULong i = 0; i < length; ++i) {
       if (!(strm << source[i])) {
         return false;
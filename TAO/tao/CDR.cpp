@@ -70,6 +70,7 @@ TAO_OutputCDR::TAO_OutputCDR (size_t size,
   , stub_ (nullptr)
   , message_semantics_ (TAO_Message_Semantics::TAO_TWOWAY_REQUEST)
   , timeout_ (nullptr)
+  , zero_copy_threshold_ (0)
 {
   ACE_FUNCTION_TIMEPROBE (TAO_OUTPUT_CDR_CTOR1_ENTER);
 
@@ -106,6 +107,7 @@ TAO_OutputCDR::TAO_OutputCDR (char *data,
   , stub_ (nullptr)
   , message_semantics_ (TAO_Message_Semantics::TAO_TWOWAY_REQUEST)
   , timeout_ (nullptr)
+  , zero_copy_threshold_ (0)
 {
   ACE_FUNCTION_TIMEPROBE (TAO_OUTPUT_CDR_CTOR2_ENTER);
 }
@@ -135,6 +137,7 @@ TAO_OutputCDR::TAO_OutputCDR (char *data,
   , stub_ (nullptr)
   , message_semantics_ (TAO_Message_Semantics::TAO_TWOWAY_REQUEST)
   , timeout_ (nullptr)
+  , zero_copy_threshold_ (0)
 {
   ACE_FUNCTION_TIMEPROBE (TAO_OUTPUT_CDR_CTOR3_ENTER);
 }
@@ -155,6 +158,7 @@ TAO_OutputCDR::TAO_OutputCDR (ACE_Message_Block *data,
   , stub_ (nullptr)
   , message_semantics_ (TAO_Message_Semantics::TAO_TWOWAY_REQUEST)
   , timeout_ (nullptr)
+  , zero_copy_threshold_ (0)
 {
   ACE_FUNCTION_TIMEPROBE (TAO_OUTPUT_CDR_CTOR4_ENTER);
 }
@@ -178,6 +182,7 @@ TAO_OutputCDR::TAO_OutputCDR (ACE_Data_Block *data_block,
   , stub_ (nullptr)
   , message_semantics_ (TAO_Message_Semantics::TAO_TWOWAY_REQUEST)
   , timeout_ (nullptr)
+  , zero_copy_threshold_ (0)
 {
   ACE_FUNCTION_TIMEPROBE (TAO_OUTPUT_CDR_CTOR5_ENTER);
 }
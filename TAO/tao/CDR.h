@@ -239,6 +239,25 @@ public:
   /// Calculate the offset between pos and current wr_ptr.
   int offset (char* pos);
 
+  /**
+   * @name Zero-copy Sequence Marshaling
+   *
+   * Sequences of octets and of fixed size integers and floating point
+   * numbers with at least zero_copy_threshold() bytes are appended
+   * with ACE_OutputCDR::write_array_external() instead of being
+   * copied.  The stream then refers to the sequence buffer, which
+   * must not change or go away before the stream is sent or reset.
+   * It is disabled (0) by default, the ORB enables it only for the
+   * stream requests are marshaled into.
+   */
+  //@{
+  size_t zero_copy_threshold () const;
+  void zero_copy_threshold (size_t threshold);
+
+  /// Should an array of @a nbytes be appended without a copy?
+  bool zero_copy_array (size_t nbytes) const;
+  //@}
+
 private:
   TAO_OutputCDR (const TAO_OutputCDR&rhs) = delete;
   TAO_OutputCDR& operator= (const TAO_OutputCDR&) = delete;
@@ -276,6 +295,9 @@ private:
   ACE_Time_Value * timeout_;
   //@}
 
+  /// Smallest sequence buffer that is not copied, 0 if all are.
+  size_t zero_copy_threshold_;
+
   /// These maps are used by valuetype indirection support.
   Repo_Id_Map_Handle repo_id_map_;
 #ifdef TAO_HAS_VALUETYPE_CODEBASE
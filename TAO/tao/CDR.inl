@@ -57,6 +57,25 @@ TAO_OutputCDR::timeout () const
   return this->timeout_;
 }
 
+ACE_INLINE size_t
+TAO_OutputCDR::zero_copy_threshold () const
+{
+  return this->zero_copy_threshold_;
+}
+
+ACE_INLINE void
+TAO_OutputCDR::zero_copy_threshold (size_t threshold)
+{
+  this->zero_copy_threshold_ = threshold;
+}
+
+ACE_INLINE bool
+TAO_OutputCDR::zero_copy_array (size_t nbytes) const
+{
+  return this->zero_copy_threshold_ != 0
+    && nbytes >= this->zero_copy_threshold_;
+}
+
 ACE_INLINE void
 TAO_OutputCDR::get_version (TAO_GIOP_Message_Version& giop_version)
 {
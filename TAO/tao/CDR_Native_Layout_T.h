@@ -0,0 +1,102 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    CDR_Native_Layout_T.h
+ *
+ *  Marshaling of fixed size structs whose CDR encoding is the same
+ *  as their layout in memory.
+ */
+//=============================================================================
+
+#ifndef TAO_CDR_NATIVE_LAYOUT_T_H
+#define TAO_CDR_NATIVE_LAYOUT_T_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/orbconf.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Basic_Types.h"
+
+#include <cstddef>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  /**
+   * @brief Tells whether the CDR encoding of @a T in the native byte
+   * order is the memory of @a T.
+   *
+   * The IDL compiler specializes it for the structs that hold only
+   * octets, integers, floating point numbers and arrays or structs of
+   * those, laid out so that CDR adds no padding between the members
+   * or between the elements of a sequence.  The specialization checks
+   * with sizeof and offsetof that the C++ compiler laid the struct out
+   * the same way, as it may not align 8 byte members to 8 bytes.
+   */
+  template<typename T>
+  struct CDR_Native_Layout
+  {
+    /// True if @a T can be copied as one block.
+    static constexpr bool value = false;
+
+    /// CDR alignment of the block, that of its first member.
+    static constexpr size_t alignment = 1;
+  };
+
+  /// True if @a T can be copied as one block into or out of @a strm.
+  template<typename T, typename stream>
+  bool is_native_layout (const stream &strm)
+  {
+#if defined (ACE_LACKS_CDR_ALIGNMENT)
+    ACE_UNUSED_ARG (strm);
+    return false;
+#else
+    return CDR_Native_Layout<T>::value && !strm.do_byte_swap ();
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+  }
+
+  /// Write @a length elements starting at @a x as one block, without
+  /// padding when @a length is 0.  Only valid if is_native_layout()
+  /// returned true for @a strm.
+  template<typename stream, typename T>
+  bool write_native_layout (stream &strm, const T *x, CORBA::ULong length)
+  {
+    if (length == 0)
+      {
+        return true;
+      }
+
+    return strm.align_write_ptr (CDR_Native_Layout<T>::alignment) == 0
+      && strm.write_octet_array (
+           reinterpret_cast<const CORBA::Octet *> (x),
+           sizeof (T) * length);
+  }
+
+  /// Read @a length elements into @a x as one block.  Only valid if
+  /// is_native_layout() returned true for @a strm.
+  template<typename stream, typename T>
+  bool read_native_layout (stream &strm, T *x, CORBA::ULong length)
+  {
+    if (length == 0)
+      {
+        return true;
+      }
+
+    return strm.align_read_ptr (CDR_Native_Layout<T>::alignment) == 0
+      && strm.read_octet_array (
+           reinterpret_cast<CORBA::Octet *> (x),
+           sizeof (T) * length);
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_CDR_NATIVE_LAYOUT_T_H */
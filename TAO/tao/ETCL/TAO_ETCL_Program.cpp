@@ -0,0 +1,981 @@
+// -*- C++ -*-
+#include "ace/ACE.h"
+#include "ace/ETCL/ETCL_Constraint_Visitor.h"
+#include "ace/ETCL/ETCL_y.h"
+#include "ace/OS_NS_string.h"
+
+#include "tao/AnyTypeCode/Any.h"
+#include "tao/AnyTypeCode/Any_Unknown_IDL_Type.h"
+#include "tao/AnyTypeCode/TypeCode.h"
+#include "tao/CDR.h"
+#include "tao/SystemException.h"
+
+#include "tao/ETCL/TAO_ETCL_Program.h"
+
+#if ! defined (__ACE_INLINE__)
+#include "tao/ETCL/TAO_ETCL_Program.inl"
+#endif /* __ACE_INLINE__ */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+CORBA::Long
+TAO_ETCL_Value::to_long () const
+{
+  switch (this->type_)
+  {
+    case SIGNED:
+      return this->op_.integer_;
+    case UNSIGNED:
+      return
+        (this->op_.uinteger_ > (CORBA::ULong) ACE_INT32_MAX) ?
+        ACE_INT32_MAX : (CORBA::Long) this->op_.uinteger_;
+    case DOUBLE:
+      return
+        (this->op_.double_ > 0) ?
+         ((this->op_.double_ > ACE_INT32_MAX) ?
+          ACE_INT32_MAX :
+          (CORBA::Long) this->op_.double_) :
+          ((this->op_.double_ < ACE_INT32_MIN) ?
+           ACE_INT32_MIN :
+           (CORBA::Long) this->op_.double_);
+    default:
+      return 0;
+  }
+}
+
+CORBA::ULong
+TAO_ETCL_Value::to_ulong () const
+{
+  switch (this->type_)
+  {
+    case UNSIGNED:
+      return this->op_.uinteger_;
+    case SIGNED:
+      return
+        (this->op_.integer_ > 0) ? (CORBA::ULong) this->op_.integer_ : 0;
+    case DOUBLE:
+      return
+        (this->op_.double_ > 0) ?
+        ((this->op_.double_ > ACE_UINT32_MAX) ?
+         ACE_UINT32_MAX :
+         (CORBA::ULong) this->op_.double_)
+        : 0;
+    default:
+      return 0;
+  }
+}
+
+CORBA::Double
+TAO_ETCL_Value::to_double () const
+{
+  switch (this->type_)
+  {
+    case DOUBLE:
+      return this->op_.double_;
+    case SIGNED:
+      return (CORBA::Double) this->op_.integer_;
+    case UNSIGNED:
+      return (CORBA::Double) this->op_.uinteger_;
+    default:
+      return 0.0;
+  }
+}
+
+int
+TAO_ETCL_Value::set (const CORBA::Any &any)
+{
+  TAO::Any_Impl *impl = any.impl ();
+
+  if (impl == 0)
+    {
+      return -1;
+    }
+
+  CORBA::TCKind kind = CORBA::tk_null;
+
+  try
+    {
+      CORBA::TypeCode_var tc =
+        CORBA::TypeCode::_duplicate (any._tao_get_typecode ());
+      kind = tc->kind ();
+
+      while (kind == CORBA::tk_alias)
+        {
+          tc = tc->content_type ();
+          kind = tc->kind ();
+        }
+    }
+  catch (const CORBA::Exception&)
+    {
+      return -1;
+    }
+
+  switch (kind)
+    {
+    case CORBA::tk_short:
+    case CORBA::tk_long:
+    case CORBA::tk_ushort:
+    case CORBA::tk_ulong:
+    case CORBA::tk_enum:
+    case CORBA::tk_float:
+    case CORBA::tk_double:
+    case CORBA::tk_boolean:
+    case CORBA::tk_string:
+      break;
+    case CORBA::tk_longlong:
+      // TAO_ETCL_Literal_Constraint reads 64 bit integers through a
+      // 32 bit extraction that fails and leaves 0; do the same, so
+      // that the visitors and the program agree.
+      this->set (static_cast<CORBA::Long> (0));
+      return 0;
+    case CORBA::tk_ulonglong:
+      this->set (static_cast<CORBA::ULong> (0));
+      return 0;
+    default:
+      this->type_ = COMPONENT;
+      this->op_.str_ = 0;
+      return 0;
+    }
+
+  // Values that came off the wire are read in place, as extracting
+  // them would replace the implementation of the Any.
+  TAO::Unknown_IDL_Type *unk = 0;
+
+  if (impl->encoded ())
+    {
+      unk = dynamic_cast<TAO::Unknown_IDL_Type *> (impl);
+    }
+
+  if (unk != 0)
+    {
+      // Copy the state, not the buffer, so that the Any is untouched.
+      TAO_InputCDR in (unk->_tao_get_cdr ());
+      bool good = true;
+
+      switch (kind)
+        {
+        case CORBA::tk_short:
+          {
+            CORBA::Short s = 0;
+            good = in.read_short (s);
+            this->set (static_cast<CORBA::Long> (s));
+          }
+          break;
+        case CORBA::tk_long:
+          {
+            CORBA::Long l = 0;
+            good = in.read_long (l);
+            this->set (l);
+          }
+          break;
+        case CORBA::tk_ushort:
+          {
+            CORBA::UShort s = 0;
+            good = in.read_ushort (s);
+            this->set (static_cast<CORBA::ULong> (s));
+          }
+          break;
+        case CORBA::tk_ulong:
+        case CORBA::tk_enum:
+          {
+            CORBA::ULong l = 0;
+            good = in.read_ulong (l);
+            this->set (l);
+          }
+          break;
+        case CORBA::tk_float:
+          {
+            CORBA::Float f = 0;
+            good = in.read_float (f);
+            this->set (static_cast<CORBA::Double> (f));
+          }
+          break;
+        case CORBA::tk_double:
+          {
+            CORBA::Double d = 0;
+            good = in.read_double (d);
+            this->set (d);
+          }
+          break;
+        case CORBA::tk_boolean:
+          {
+            CORBA::Boolean b = false;
+            good = in.read_boolean (b);
+            this->set (b);
+          }
+          break;
+        case CORBA::tk_string:
+          {
+            // The marshaled string keeps its terminating nul, so it
+            // can be used where it lies.
+            CORBA::ULong length = 0;
+            good = in.read_ulong (length)
+              && length != 0
+              && length <= in.length ()
+              && in.rd_ptr ()[length - 1] == '\0';
+
+            if (good)
+              {
+                this->set (static_cast<const char *> (in.rd_ptr ()));
+              }
+          }
+          break;
+        default:
+          break;
+        }
+
+      return good ? 0 : -1;
+    }
+
+  switch (kind)
+    {
+    case CORBA::tk_short:
+      {
+        CORBA::Short s = 0;
+        any >>= s;
+        this->set (static_cast<CORBA::Long> (s));
+      }
+      break;
+    case CORBA::tk_long:
+      {
+        CORBA::Long l = 0;
+        any >>= l;
+        this->set (l);
+      }
+      break;
+    case CORBA::tk_ushort:
+      {
+        CORBA::UShort s = 0;
+        any >>= s;
+        this->set (static_cast<CORBA::ULong> (s));
+      }
+      break;
+    case CORBA::tk_ulong:
+      {
+        CORBA::ULong l = 0;
+        any >>= l;
+        this->set (l);
+      }
+      break;
+    case CORBA::tk_enum:
+      {
+        // The value type is not known here, so the only way to the
+        // ordinal is through its encoding.  This allocates.
+        CORBA::ULong l = 0;
+        TAO_OutputCDR out;
+        impl->marshal_value (out);
+        TAO_InputCDR in (out);
+        in.read_ulong (l);
+        this->set (l);
+      }
+      break;
+    case CORBA::tk_float:
+      {
+        CORBA::Float f = 0;
+        any >>= f;
+        this->set (static_cast<CORBA::Double> (f));
+      }
+      break;
+    case CORBA::tk_double:
+      {
+        CORBA::Double d = 0;
+        any >>= d;
+        this->set (d);
+      }
+      break;
+    case CORBA::tk_boolean:
+      {
+        CORBA::Boolean b = false;
+        any >>= CORBA::Any::to_boolean (b);
+        this->set (b);
+      }
+      break;
+    case CORBA::tk_string:
+      {
+        const char *s = 0;
+        if (!(any >>= s))
+          {
+            return -1;
+          }
+        this->set (s);
+      }
+      break;
+    default:
+      break;
+    }
+
+  return 0;
+}
+
+// ****************************************************************
+
+TAO_ETCL_Field_Resolver::~TAO_ETCL_Field_Resolver ()
+{
+}
+
+bool
+TAO_ETCL_Field_Resolver::supports (int) const
+{
+  return true;
+}
+
+TAO_ETCL_Record::~TAO_ETCL_Record ()
+{
+}
+
+// ****************************************************************
+
+/**
+ * @class TAO_ETCL_Program_Compiler
+ *
+ * @brief Walks a constraint once, appending its instructions to a
+ * TAO_ETCL_Program.  Every visit returns -1 for what the program
+ * can't evaluate.
+ */
+class TAO_ETCL_Program_Compiler
+  : public ETCL_Constraint_Visitor,
+    private ETCL_Constraint // For the names of the literal types.
+{
+public:
+  TAO_ETCL_Program_Compiler (TAO_ETCL_Program &program,
+                             TAO_ETCL_Field_Resolver &resolver);
+
+  int visit_literal (ETCL_Literal_Constraint *) override;
+  int visit_identifier (ETCL_Identifier *) override;
+  int visit_union_value (ETCL_Union_Value *) override;
+  int visit_union_pos (ETCL_Union_Pos *) override;
+  int visit_component_pos (ETCL_Component_Pos *) override;
+  int visit_component_assoc (ETCL_Component_Assoc *) override;
+  int visit_component_array (ETCL_Component_Array *) override;
+  int visit_special (ETCL_Special *) override;
+  int visit_component (ETCL_Component *) override;
+  int visit_dot (ETCL_Dot *) override;
+  int visit_eval (ETCL_Eval *) override;
+  int visit_default (ETCL_Default *) override;
+  int visit_exist (ETCL_Exist *) override;
+  int visit_unary_expr (ETCL_Unary_Expr *) override;
+  int visit_binary_expr (ETCL_Binary_Expr *) override;
+  int visit_preference (ETCL_Preference *) override;
+
+  /// Deepest stack the instructions so far use.
+  size_t max_depth () const;
+
+private:
+  /// Append an instruction that changes the stack depth by @a push,
+  /// returning its index.
+  size_t emit (TAO_ETCL_Program::Opcode op,
+               int push,
+               CORBA::ULong arg = 0);
+
+  /// Append a load of the field @a node names.
+  int field (ETCL_Constraint *node, bool exist);
+
+  /// Compile a short-circuiting `and' or `or'.
+  int logical (ETCL_Binary_Expr *binary, TAO_ETCL_Program::Opcode jump);
+
+  TAO_ETCL_Program &program_;
+  TAO_ETCL_Field_Resolver &resolver_;
+  size_t depth_;
+  size_t max_depth_;
+};
+
+TAO_ETCL_Program_Compiler::TAO_ETCL_Program_Compiler (
+    TAO_ETCL_Program &program,
+    TAO_ETCL_Field_Resolver &resolver)
+  : program_ (program),
+    resolver_ (resolver),
+    depth_ (0),
+    max_depth_ (0)
+{
+}
+
+size_t
+TAO_ETCL_Program_Compiler::max_depth () const
+{
+  return this->max_depth_;
+}
+
+size_t
+TAO_ETCL_Program_Compiler::emit (TAO_ETCL_Program::Opcode op,
+                                 int push,
+                                 CORBA::ULong arg)
+{
+  TAO_ETCL_Program::Instruction i;
+  i.op_ = op;
+  i.value_.set (false);
+  i.arg_ = arg;
+  this->program_.code_.push_back (i);
+
+  this->depth_ += push;
+  if (this->depth_ > this->max_depth_)
+    {
+      this->max_depth_ = this->depth_;
+    }
+
+  return this->program_.code_.size () - 1;
+}
+
+int
+TAO_ETCL_Program_Compiler::field (ETCL_Constraint *node, bool exist)
+{
+  TAO_ETCL_Program::Field f;
+
+  if (node == 0
+      || this->resolver_.resolve (node, exist, f.kind_, f.name_) != 0)
+    {
+      return -1;
+    }
+
+  this->program_.fields_.push_back (f);
+  this->emit (exist ? TAO_ETCL_Program::OP_EXIST : TAO_ETCL_Program::OP_FIELD,
+              1,
+              static_cast<CORBA::ULong> (this->program_.fields_.size () - 1));
+  return 0;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_literal (ETCL_Literal_Constraint *literal)
+{
+  TAO_ETCL_Value value;
+
+  switch (literal->expr_type ())
+    {
+    case ACE_ETCL_STRING:
+      this->program_.strings_.push_back (
+        ACE_CString ((const char *) *literal));
+      this->emit (TAO_ETCL_Program::OP_PUSH_STRING,
+                  1,
+                  static_cast<CORBA::ULong> (
+                    this->program_.strings_.size () - 1));
+      return 0;
+    case ACE_ETCL_DOUBLE:
+      value.set ((CORBA::Double) *literal);
+      break;
+    case ACE_ETCL_UNSIGNED:
+      value.set ((CORBA::ULong) *literal);
+      break;
+    case ACE_ETCL_SIGNED:
+    case ACE_ETCL_INTEGER:
+      value.set ((CORBA::Long) *literal);
+      break;
+    case ACE_ETCL_BOOLEAN:
+      value.set ((CORBA::Boolean) *literal);
+      break;
+    default:
+      return -1;
+    }
+
+  size_t const i = this->emit (TAO_ETCL_Program::OP_PUSH, 1);
+  this->program_.code_[i].value_ = value;
+  return 0;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_identifier (ETCL_Identifier *ident)
+{
+  return this->field (ident, false);
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_union_value (ETCL_Union_Value *)
+{
+  return -1;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_union_pos (ETCL_Union_Pos *)
+{
+  return -1;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_component_pos (ETCL_Component_Pos *)
+{
+  return -1;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_component_assoc (ETCL_Component_Assoc *)
+{
+  // Components are only reached through visit_eval() and
+  // visit_exist(), which hand them to the resolver whole.
+  return -1;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_component_array (ETCL_Component_Array *)
+{
+  return -1;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_special (ETCL_Special *)
+{
+  return -1;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_component (ETCL_Component *)
+{
+  return -1;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_dot (ETCL_Dot *)
+{
+  return -1;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_eval (ETCL_Eval *eval)
+{
+  return this->field (eval->component (), false);
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_default (ETCL_Default *)
+{
+  return -1;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_exist (ETCL_Exist *exist)
+{
+  if (!this->resolver_.supports (ETCL_EXIST))
+    {
+      return -1;
+    }
+
+  return this->field (exist->component (), true);
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_unary_expr (ETCL_Unary_Expr *unary_expr)
+{
+  int const op_type = unary_expr->type ();
+
+  if (!this->resolver_.supports (op_type)
+      || unary_expr->subexpr ()->accept (this) != 0)
+    {
+      return -1;
+    }
+
+  switch (op_type)
+    {
+    case ETCL_NOT:
+      this->emit (TAO_ETCL_Program::OP_NOT, 0);
+      return 0;
+    case ETCL_MINUS:
+      this->emit (TAO_ETCL_Program::OP_NEGATE, 0);
+      return 0;
+    case ETCL_PLUS:
+      return 0;
+    default:
+      return -1;
+    }
+}
+
+int
+TAO_ETCL_Program_Compiler::logical (ETCL_Binary_Expr *binary,
+                                    TAO_ETCL_Program::Opcode jump)
+{
+  if (binary->lhs ()->accept (this) != 0)
+    {
+      return -1;
+    }
+
+  // The jump leaves the result of the left side on the stack when it
+  // decides the expression, and pops it otherwise.
+  size_t const i = this->emit (jump, -1);
+
+  if (binary->rhs ()->accept (this) != 0)
+    {
+      return -1;
+    }
+
+  this->emit (TAO_ETCL_Program::OP_BOOLEAN, 0);
+  this->program_.code_[i].arg_ =
+    static_cast<CORBA::ULong> (this->program_.code_.size ());
+  return 0;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_binary_expr (ETCL_Binary_Expr *binary_expr)
+{
+  int const op_type = binary_expr->type ();
+  TAO_ETCL_Program::Opcode op = TAO_ETCL_Program::OP_EQ;
+
+  if (!this->resolver_.supports (op_type))
+    {
+      return -1;
+    }
+
+  switch (op_type)
+    {
+    case ETCL_OR:
+      return this->logical (binary_expr, TAO_ETCL_Program::OP_OR_JUMP);
+    case ETCL_AND:
+      return this->logical (binary_expr, TAO_ETCL_Program::OP_AND_JUMP);
+    case ETCL_LT:
+      op = TAO_ETCL_Program::OP_LT;
+      break;
+    case ETCL_LE:
+      op = TAO_ETCL_Program::OP_LE;
+      break;
+    case ETCL_GT:
+      op = TAO_ETCL_Program::OP_GT;
+      break;
+    case ETCL_GE:
+      op = TAO_ETCL_Program::OP_GE;
+      break;
+    case ETCL_EQ:
+      op = TAO_ETCL_Program::OP_EQ;
+      break;
+    case ETCL_NE:
+      op = TAO_ETCL_Program::OP_NE;
+      break;
+    case ETCL_PLUS:
+      op = TAO_ETCL_Program::OP_PLUS;
+      break;
+    case ETCL_MINUS:
+      op = TAO_ETCL_Program::OP_MINUS;
+      break;
+    case ETCL_MULT:
+      op = TAO_ETCL_Program::OP_MULT;
+      break;
+    case ETCL_DIV:
+      op = TAO_ETCL_Program::OP_DIV;
+      break;
+    case ETCL_TWIDDLE:
+      op = TAO_ETCL_Program::OP_TWIDDLE;
+      break;
+    default:
+      // `in' looks inside components with DynAny.
+      return -1;
+    }
+
+  if (binary_expr->lhs ()->accept (this) != 0
+      || binary_expr->rhs ()->accept (this) != 0)
+    {
+      return -1;
+    }
+
+  this->emit (op, -1);
+  return 0;
+}
+
+int
+TAO_ETCL_Program_Compiler::visit_preference (ETCL_Preference *)
+{
+  return -1;
+}
+
+// ****************************************************************
+
+namespace
+{
+  /// The type both operands are converted to, as
+  /// TAO_ETCL_Literal_Constraint::widest_type() picks it.
+  TAO_ETCL_Value::Type
+  widest_type (const TAO_ETCL_Value &lhs, const TAO_ETCL_Value &rhs)
+  {
+    return (lhs.type () > rhs.type ()) ? lhs.type () : rhs.type ();
+  }
+
+  bool
+  equal (const TAO_ETCL_Value &lhs, const TAO_ETCL_Value &rhs)
+  {
+    switch (widest_type (lhs, rhs))
+      {
+      case TAO_ETCL_Value::STRING:
+        return ACE_OS::strcmp (lhs.to_string (), rhs.to_string ()) == 0;
+      case TAO_ETCL_Value::DOUBLE:
+        return ACE::is_equal (lhs.to_double (), rhs.to_double ());
+      case TAO_ETCL_Value::SIGNED:
+        return lhs.to_long () == rhs.to_long ();
+      case TAO_ETCL_Value::UNSIGNED:
+        return lhs.to_ulong () == rhs.to_ulong ();
+      case TAO_ETCL_Value::BOOLEAN:
+        return lhs.to_boolean () == rhs.to_boolean ();
+      default:
+        return false;
+      }
+  }
+
+  bool
+  less (const TAO_ETCL_Value &lhs, const TAO_ETCL_Value &rhs)
+  {
+    switch (widest_type (lhs, rhs))
+      {
+      case TAO_ETCL_Value::STRING:
+        return ACE_OS::strcmp (lhs.to_string (), rhs.to_string ()) < 0;
+      case TAO_ETCL_Value::DOUBLE:
+        return lhs.to_double () < rhs.to_double ();
+      case TAO_ETCL_Value::SIGNED:
+        return lhs.to_long () < rhs.to_long ();
+      case TAO_ETCL_Value::UNSIGNED:
+        return lhs.to_ulong () < rhs.to_ulong ();
+      case TAO_ETCL_Value::BOOLEAN:
+        return lhs.to_boolean () < rhs.to_boolean ();
+      default:
+        return false;
+      }
+  }
+
+  bool
+  greater (const TAO_ETCL_Value &lhs, const TAO_ETCL_Value &rhs)
+  {
+    // Booleans are not ordered this way round, as in
+    // ETCL_Literal_Constraint::operator>.
+    switch (widest_type (lhs, rhs))
+      {
+      case TAO_ETCL_Value::STRING:
+        return ACE_OS::strcmp (lhs.to_string (), rhs.to_string ()) > 0;
+      case TAO_ETCL_Value::DOUBLE:
+        return lhs.to_double () > rhs.to_double ();
+      case TAO_ETCL_Value::SIGNED:
+        return lhs.to_long () > rhs.to_long ();
+      case TAO_ETCL_Value::UNSIGNED:
+        return lhs.to_ulong () > rhs.to_ulong ();
+      default:
+        return false;
+      }
+  }
+
+  /// Apply @a op, one of + - * and /, a division by 0 giving 0.
+  template <typename T>
+  T
+  arithmetic (char op, T lhs, T rhs)
+  {
+    switch (op)
+      {
+      case '+':
+        return lhs + rhs;
+      case '-':
+        return lhs - rhs;
+      case '*':
+        return lhs * rhs;
+      default:
+        return (rhs == T (0)) ? T (0) : lhs / rhs;
+      }
+  }
+
+  /// Apply @a op in the widest type of the operands, leaving the
+  /// result in @a lhs.
+  void
+  arithmetic (char op, TAO_ETCL_Value &lhs, const TAO_ETCL_Value &rhs)
+  {
+    switch (widest_type (lhs, rhs))
+      {
+      case TAO_ETCL_Value::DOUBLE:
+        {
+          CORBA::Double const r = rhs.to_double ();
+
+          if (op == '/' && ACE::is_equal (r, 0.0))
+            {
+              lhs.set (0.0);
+            }
+          else
+            {
+              lhs.set (arithmetic<CORBA::Double> (op, lhs.to_double (), r));
+            }
+        }
+        break;
+      case TAO_ETCL_Value::SIGNED:
+        lhs.set (arithmetic<CORBA::Long> (op, lhs.to_long (), rhs.to_long ()));
+        break;
+      case TAO_ETCL_Value::UNSIGNED:
+        lhs.set (
+          arithmetic<CORBA::ULong> (op, lhs.to_ulong (), rhs.to_ulong ()));
+        break;
+      default:
+        lhs.set (static_cast<CORBA::Long> (0));
+        break;
+      }
+  }
+}
+
+TAO_ETCL_Program::TAO_ETCL_Program ()
+{
+}
+
+TAO_ETCL_Program::~TAO_ETCL_Program ()
+{
+}
+
+void
+TAO_ETCL_Program::reset ()
+{
+  this->code_.clear ();
+  this->fields_.clear ();
+  this->strings_.clear ();
+}
+
+int
+TAO_ETCL_Program::compile (ETCL_Constraint *root,
+                           TAO_ETCL_Field_Resolver &resolver)
+{
+  this->reset ();
+
+  if (root == 0)
+    {
+      return -1;
+    }
+
+  TAO_ETCL_Program_Compiler compiler (*this, resolver);
+
+  if (root->accept (&compiler) != 0
+      || compiler.max_depth () > TAO_ETCL_Program::max_stack)
+    {
+      this->reset ();
+      return -1;
+    }
+
+  return 0;
+}
+
+CORBA::Boolean
+TAO_ETCL_Program::evaluate (const TAO_ETCL_Record &record) const
+{
+  TAO_ETCL_Value stack[TAO_ETCL_Program::max_stack];
+  size_t top = 0;
+  size_t const length = this->code_.size ();
+  size_t pc = 0;
+
+  while (pc < length)
+    {
+      Instruction const &i = this->code_[pc++];
+
+      switch (i.op_)
+        {
+        case OP_PUSH:
+          stack[top++] = i.value_;
+          break;
+        case OP_PUSH_STRING:
+          stack[top++].set (this->strings_[i.arg_].c_str ());
+          break;
+        case OP_FIELD:
+        case OP_EXIST:
+          {
+            Field const &f = this->fields_[i.arg_];
+
+            // A missing field fails the constraint, even under
+            // `exist', as it does in the visitors.
+            if (record.field (f.kind_, f.name_.c_str (), stack[top]) != 0)
+              {
+                return false;
+              }
+
+            if (i.op_ == OP_EXIST)
+              {
+                stack[top].set (true);
+              }
+
+            ++top;
+          }
+          break;
+        case OP_NOT:
+          stack[top - 1].set (!stack[top - 1].to_boolean ());
+          break;
+        case OP_NEGATE:
+          {
+            TAO_ETCL_Value &v = stack[top - 1];
+
+            switch (v.type ())
+              {
+              case TAO_ETCL_Value::DOUBLE:
+                v.set (- v.to_double ());
+                break;
+              case TAO_ETCL_Value::SIGNED:
+                v.set (- v.to_long ());
+                break;
+              case TAO_ETCL_Value::UNSIGNED:
+                v.set (- (CORBA::Long) v.to_ulong ());
+                break;
+              default:
+                v.set (static_cast<CORBA::Long> (0));
+                break;
+              }
+          }
+          break;
+        case OP_BOOLEAN:
+          stack[top - 1].set (stack[top - 1].to_boolean ());
+          break;
+        case OP_AND_JUMP:
+        case OP_OR_JUMP:
+          {
+            CORBA::Boolean const b = stack[top - 1].to_boolean ();
+
+            if (b == (i.op_ == OP_OR_JUMP))
+              {
+                stack[top - 1].set (b);
+                pc = i.arg_;
+              }
+            else
+              {
+                --top;
+              }
+          }
+          break;
+        case OP_TWIDDLE:
+          {
+            --top;
+            const char *pattern = stack[top - 1].to_string ();
+            const char *str = stack[top].to_string ();
+
+            if (pattern == 0 || str == 0)
+              {
+                return false;
+              }
+
+            stack[top - 1].set (ACE_OS::strstr (str, pattern) != 0);
+          }
+          break;
+        default:
+          {
+            --top;
+            TAO_ETCL_Value &lhs = stack[top - 1];
+            TAO_ETCL_Value const &rhs = stack[top];
+
+            switch (i.op_)
+              {
+              case OP_LT:
+                lhs.set (less (lhs, rhs));
+                break;
+              case OP_LE:
+                lhs.set (!greater (lhs, rhs));
+                break;
+              case OP_GT:
+                lhs.set (greater (lhs, rhs));
+                break;
+              case OP_GE:
+                lhs.set (!less (lhs, rhs));
+                break;
+              case OP_EQ:
+                lhs.set (equal (lhs, rhs));
+                break;
+              case OP_NE:
+                lhs.set (!equal (lhs, rhs));
+                break;
+              case OP_PLUS:
+                arithmetic ('+', lhs, rhs);
+                break;
+              case OP_MINUS:
+                arithmetic ('-', lhs, rhs);
+                break;
+              case OP_MULT:
+                arithmetic ('*', lhs, rhs);
+                break;
+              default:
+                arithmetic ('/', lhs, rhs);
+                break;
+              }
+          }
+          break;
+        }
+    }
+
+  return top == 1 && stack[0].to_boolean ();
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
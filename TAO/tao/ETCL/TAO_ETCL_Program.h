@@ -0,0 +1,235 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    TAO_ETCL_Program.h
+ *
+ *  ETCL constraints compiled into a flat program, for the services
+ *  that evaluate the same constraint against many records.
+ */
+//=============================================================================
+
+#ifndef TAO_ETCL_PROGRAM_H
+#define TAO_ETCL_PROGRAM_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/ETCL/ETCL_Constraint.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Vector_T.h"
+#include "ace/SString.h"
+
+#include "tao/Basic_Types.h"
+
+#include "tao/ETCL/tao_etcl_export.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace CORBA
+{
+  class Any;
+}
+
+/**
+ * @class TAO_ETCL_Value
+ *
+ * @brief A value on the stack of a TAO_ETCL_Program.
+ *
+ * The types are ordered as in ETCL_Literal_Constraint, so that the
+ * operators pick the same widest type.  Strings are not copied, they
+ * point into the program or into the record being evaluated.
+ */
+class TAO_ETCL_Export TAO_ETCL_Value
+{
+public:
+  enum Type
+  {
+    STRING,
+    DOUBLE,
+    UNSIGNED,
+    SIGNED,
+    BOOLEAN,
+    COMPONENT
+  };
+
+  void set (CORBA::Boolean boolean);
+  void set (CORBA::Long integer);
+  void set (CORBA::ULong uinteger);
+  void set (CORBA::Double doub);
+  void set (const char *str);
+
+  /**
+   * Read the value held by @a any, without copying it.  Types other
+   * than the simple ones become a COMPONENT that only compares
+   * unequal.  Returns -1 if @a any is empty or can't be read.
+   */
+  int set (const CORBA::Any &any);
+
+  Type type () const;
+
+  // Conversions, as in ETCL_Literal_Constraint.
+  CORBA::Boolean to_boolean () const;
+  CORBA::Long to_long () const;
+  CORBA::ULong to_ulong () const;
+  CORBA::Double to_double () const;
+
+  /// The string, 0 if the value is not a string.
+  const char *to_string () const;
+
+private:
+  Type type_;
+
+  union
+  {
+    CORBA::Boolean bool_;
+    CORBA::Long integer_;
+    CORBA::ULong uinteger_;
+    CORBA::Double double_;
+    const char *str_;
+  } op_;
+};
+
+/**
+ * @class TAO_ETCL_Field_Resolver
+ *
+ * @brief Names the fields of a service's records for the compiler.
+ */
+class TAO_ETCL_Export TAO_ETCL_Field_Resolver
+{
+public:
+  virtual ~TAO_ETCL_Field_Resolver ();
+
+  /**
+   * Map @a node, an identifier or the component of a `$' or an
+   * `exist' expression, to a @a kind and @a name that the service's
+   * TAO_ETCL_Record understands.  @a exist is true for the operand of
+   * `exist'.  Return -1 if the field can't be named before the record
+   * is seen, which fails the compile.
+   */
+  virtual int resolve (ETCL_Constraint *node,
+                       bool exist,
+                       CORBA::ULong &kind,
+                       ACE_CString &name) = 0;
+
+  /// False if the service gives @a op, an ETCL_y.h token, a meaning
+  /// of its own, so that constraints using it are not compiled.
+  virtual bool supports (int op) const;
+};
+
+/**
+ * @class TAO_ETCL_Record
+ *
+ * @brief The record a TAO_ETCL_Program is evaluated against.
+ */
+class TAO_ETCL_Export TAO_ETCL_Record
+{
+public:
+  virtual ~TAO_ETCL_Record ();
+
+  /// Store the field named by the resolver in @a value.  Return -1 if
+  /// the record has no such field.
+  virtual int field (CORBA::ULong kind,
+                     const char *name,
+                     TAO_ETCL_Value &value) const = 0;
+};
+
+/**
+ * @class TAO_ETCL_Program
+ *
+ * @brief An ETCL constraint compiled into postfix instructions.
+ *
+ * Fields are resolved to a kind and a name when the constraint is
+ * compiled, and the instructions run on a fixed size stack, so
+ * evaluate() does not walk the tree.  Nor does it allocate, except
+ * to read an enum from an Any that was built locally rather than
+ * demarshaled, which has to be encoded first.  It gives the
+ * results of the Notify and Log visitors, an error making the
+ * constraint false.  Unions, positional and array components,
+ * `default', `in', the special members and preferences are not
+ * compiled; the services keep to their visitors for those.
+ */
+class TAO_ETCL_Export TAO_ETCL_Program
+{
+public:
+  /// Deepest stack a compiled program may use.
+  static const size_t max_stack = 32;
+
+  TAO_ETCL_Program ();
+  ~TAO_ETCL_Program ();
+
+  /// Compile the tree rooted at @a root.  Returns -1, leaving the
+  /// program empty, if the tree uses something it can't compile.
+  int compile (ETCL_Constraint *root, TAO_ETCL_Field_Resolver &resolver);
+
+  /// True if compile() succeeded.
+  bool compiled () const;
+
+  /// Empty the program.
+  void reset ();
+
+  /// Evaluate the program against @a record.
+  CORBA::Boolean evaluate (const TAO_ETCL_Record &record) const;
+
+private:
+  friend class TAO_ETCL_Program_Compiler;
+
+  enum Opcode
+  {
+    OP_PUSH,
+    OP_PUSH_STRING,
+    OP_FIELD,
+    OP_EXIST,
+    OP_NOT,
+    OP_NEGATE,
+    OP_BOOLEAN,
+    OP_AND_JUMP,
+    OP_OR_JUMP,
+    OP_LT,
+    OP_LE,
+    OP_GT,
+    OP_GE,
+    OP_EQ,
+    OP_NE,
+    OP_PLUS,
+    OP_MINUS,
+    OP_MULT,
+    OP_DIV,
+    OP_TWIDDLE
+  };
+
+  struct Instruction
+  {
+    Opcode op_;
+
+    /// The literal of OP_PUSH.
+    TAO_ETCL_Value value_;
+
+    /// The string of OP_PUSH_STRING, the field of OP_FIELD and
+    /// OP_EXIST, or the target of a jump.
+    CORBA::ULong arg_;
+  };
+
+  struct Field
+  {
+    CORBA::ULong kind_;
+    ACE_CString name_;
+  };
+
+  ACE_Vector<Instruction> code_;
+  ACE_Vector<Field> fields_;
+  ACE_Vector<ACE_CString> strings_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "tao/ETCL/TAO_ETCL_Program.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_ETCL_PROGRAM_H */
@@ -0,0 +1,65 @@
+// -*- C++ -*-
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE void
+TAO_ETCL_Value::set (CORBA::Boolean boolean)
+{
+  this->type_ = BOOLEAN;
+  this->op_.bool_ = boolean;
+}
+
+ACE_INLINE void
+TAO_ETCL_Value::set (CORBA::Long integer)
+{
+  this->type_ = SIGNED;
+  this->op_.integer_ = integer;
+}
+
+ACE_INLINE void
+TAO_ETCL_Value::set (CORBA::ULong uinteger)
+{
+  this->type_ = UNSIGNED;
+  this->op_.uinteger_ = uinteger;
+}
+
+ACE_INLINE void
+TAO_ETCL_Value::set (CORBA::Double doub)
+{
+  this->type_ = DOUBLE;
+  this->op_.double_ = doub;
+}
+
+ACE_INLINE void
+TAO_ETCL_Value::set (const char *str)
+{
+  this->type_ = STRING;
+  this->op_.str_ = str;
+}
+
+ACE_INLINE TAO_ETCL_Value::Type
+TAO_ETCL_Value::type () const
+{
+  return this->type_;
+}
+
+ACE_INLINE CORBA::Boolean
+TAO_ETCL_Value::to_boolean () const
+{
+  return (this->type_ == BOOLEAN) ? this->op_.bool_ : false;
+}
+
+ACE_INLINE const char *
+TAO_ETCL_Value::to_string () const
+{
+  return (this->type_ == STRING) ? this->op_.str_ : 0;
+}
+
+// ****************************************************************
+
+ACE_INLINE bool
+TAO_ETCL_Program::compiled () const
+{
+  return this->code_.size () != 0;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
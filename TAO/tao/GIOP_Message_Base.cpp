@@ -13,6 +13,7 @@
 #include "tao/SystemException.h"
 #include "tao/ZIOP_Adapter.h"
 #include "ace/Min_Max.h"
+#include "ace/OS_NS_string.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -32,6 +33,13 @@ TAO_GIOP_Message_Base::TAO_GIOP_Message_Base (TAO_ORB_Core *orb_core,
                  TAO_DEF_GIOP_MAJOR,
                  TAO_DEF_GIOP_MINOR)
 {
+  // Requests are sent or copied into the transport queue before the
+  // invocation returns, so their sequences need not be copied while
+  // marshaling.  Replies are sent after the skeleton has released
+  // the arguments, see process_request().
+  this->out_stream_.zero_copy_threshold (
+    orb_core->orb_params ()->cdr_zero_copy_threshold ());
+
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
   const int nibbles = 2 * sizeof (size_t);
   char hex_string[nibbles + 1];
@@ -1787,11 +1795,6 @@ TAO_GIOP_Message_Base::consolidate_fragmented_message (
   TAO_Queued_Data * qd,
   TAO_Queued_Data *& msg)
 {
-  TAO::Incoming_Message_Stack reverse_stack;
-
-  TAO_Queued_Data *tail = nullptr;
-  TAO_Queued_Data *head = nullptr;
-
   //
   // CONSOLIDATE FRAGMENTED MESSAGE
   //
@@ -1808,122 +1811,295 @@ TAO_GIOP_Message_Base::consolidate_fragmented_message (
       return -1; // error: GIOP-1.0 does not support fragments
     }
 
-  // If this is not the last fragment, push it onto stack for later processing
-  if (qd->more_fragments ())
+  msg = nullptr;   // no consolidated message available yet
+
+  // The first message of a fragmented message stays on the stack and
+  // the payload of each fragment is appended to it as it arrives, so
+  // that the message is contiguous once the last fragment is in.
+  TAO_Queued_Data *head = nullptr;
+
+  if (qd->msg_type () != GIOP::Fragment)
     {
       this->fragment_stack_.push (qd);
+      return 1;  // status: more messages expected.
+    }
+
+  switch (this->take_fragment_head (qd, head))
+    {
+    case -1:
+      TAO_Queued_Data::release (qd);
+      return -1;
 
-      msg = nullptr;   // no consolidated message available yet
+    case 1:
+      // No message to continue, keep the fragment as it is.
+      if (qd->more_fragments ())
+        {
+          this->fragment_stack_.push (qd);
+          return 1;
+        }
+
+      msg = qd;
+      return 0;
+    }
+
+  if (this->read_in_place (head, qd))
+    {
+      // The payload has been read behind the data of the head already.
+      head->msg_block ()->wr_ptr (qd->msg_block ()->length ());
+    }
+  else
+    {
+      // Skip the header(s) of the fragment
+      size_t const header_adjustment =
+        this->header_length () +
+        this->fragment_header_length (qd->giop_version ().major_version ());
+
+      size_t const payload = qd->msg_block ()->length () - header_adjustment;
+
+      if (this->reserve_fragment_space (head, payload) == -1 ||
+          head->msg_block ()->copy (qd->msg_block ()->rd_ptr () + header_adjustment,
+                                    payload) == -1)
+        {
+          // memory allocation failed
+          TAO_Queued_Data::release (head);
+          TAO_Queued_Data::release (qd);
+          return -1;
+        }
+    }
+
+  TAO_GIOP_Message_State state = head->state ();
+  state.more_fragments (qd->more_fragments ());
+  head->state (state);
+
+  TAO_Queued_Data::release (qd);
+
+  if (head->more_fragments ())
+    {
+      this->fragment_stack_.push (head);
       return 1;  // status: more messages expected.
     }
 
-  tail = qd;  // init
+  // set out value
+  msg = head;
+
+  return 0;
+}
+
+TAO_Queued_Data *
+TAO_GIOP_Message_Base::fragment_in_place (const TAO_Queued_Data &qd)
+{
+  if (qd.msg_type () != GIOP::Fragment ||
+      qd.missing_data () == 0 ||
+      qd.missing_data () == TAO_MISSING_DATA_UNDEFINED ||
+      (qd.giop_version ().major == 1 && qd.giop_version ().minor == 0))
+    {
+      return nullptr;
+    }
 
-  // Add the current message block to the end of the chain
-  // after adjusting the read pointer to skip the header(s)
   size_t const header_adjustment =
     this->header_length () +
-    this->fragment_header_length (tail->giop_version ().major_version ());
+    this->fragment_header_length (qd.giop_version ().major_version ());
 
-  if (tail->msg_block ()->length () < header_adjustment)
+  size_t const received = qd.msg_block ()->length ();
+
+  if (received < header_adjustment)
     {
-      // buffer length not sufficient
-      TAO_Queued_Data::release (qd);
-      return -1;
+      return nullptr;
     }
 
-  // duplicate code to speed up both processes, for GIOP-1.1 and GIOP-1.2
-  if (tail->giop_version ().major_version () == 1 && tail->giop_version ().minor_version () == 1)
+  TAO_Queued_Data *head = nullptr;
+
+  if (this->take_fragment_head (&qd, head) != 0)
     {
-      // GIOP-1.1
+      return nullptr;
+    }
 
-      while (this->fragment_stack_.pop (head) != -1)
-        {
-          if (head->more_fragments () &&
-              head->giop_version ().major_version () == 1 &&
-              head->giop_version ().minor_version () == 1 &&
-              head->msg_block ()->length () >= header_adjustment)
-            {
-              // adjust the read-pointer, skip the fragment header
-              tail->msg_block ()->rd_ptr(header_adjustment);
+  // Make room for the whole payload behind the data of the head, copy
+  // what has been received so far and let the node for the rest of
+  // the fragment share that buffer, so that it is read in place.
+  size_t const payload = qd.state ().message_size () - header_adjustment;
 
-              head->msg_block ()->cont (tail->msg_block ());
+  TAO_Queued_Data *nqd = nullptr;
 
-              tail->msg_block (nullptr);
+  if (this->reserve_fragment_space (head, payload) == 0)
+    {
+      nqd =
+        TAO_Queued_Data::make_queued_data (
+          this->orb_core_->transport_message_buffer_allocator ());
+    }
 
-              TAO_Queued_Data::release (tail);
+  if (nqd != nullptr)
+    {
+      ACE_Message_Block *mb = head->msg_block ();
 
-              tail = head;
-            }
-          else
-            {
-              reverse_stack.push (head);
-            }
+      ACE_OS::memcpy (mb->wr_ptr (),
+                      qd.msg_block ()->rd_ptr () + header_adjustment,
+                      received - header_adjustment);
+
+      nqd->msg_block (mb->duplicate ());
+
+      if (nqd->msg_block () == nullptr)
+        {
+          TAO_Queued_Data::release (nqd);
+          nqd = nullptr;
+        }
+      else
+        {
+          nqd->msg_block ()->rd_ptr (nqd->msg_block ()->wr_ptr ());
+          nqd->msg_block ()->wr_ptr (received - header_adjustment);
+          nqd->state (qd.state ());
+          nqd->missing_data (qd.missing_data ());
         }
     }
-  else
+
+  // The head stays on the stack in any case.
+  this->fragment_stack_.push (head);
+
+  return nqd;
+}
+
+int
+TAO_GIOP_Message_Base::take_fragment_head (const TAO_Queued_Data *fragment,
+                                           TAO_Queued_Data *&head)
+{
+  // A fragment read in place continues the head it shares the buffer
+  // with, its header is gone.
+  TAO_Queued_Data *in_place = nullptr;
+
+  for (this->fragment_stack_.top (in_place);
+       in_place != nullptr && !this->read_in_place (in_place, fragment);
+       in_place = in_place->next ())
     {
-      // > GIOP-1.2
+    }
 
-      CORBA::ULong tmp_request_id = 0;
-      if (this->parse_request_id (tail, tmp_request_id) == -1)
+  size_t const header_adjustment =
+    this->header_length () +
+    this->fragment_header_length (fragment->giop_version ().major_version ());
+
+  bool const giop_1_1 =
+    fragment->giop_version ().major_version () == 1 &&
+    fragment->giop_version ().minor_version () == 1;
+
+  CORBA::ULong request_id = 0;
+
+  if (in_place == nullptr)
+    {
+      if (fragment->msg_block ()->length () < header_adjustment)
         {
+          // buffer length not sufficient
           return -1;
         }
 
-      CORBA::ULong const request_id = tmp_request_id;
-
-      while (this->fragment_stack_.pop (head) != -1)
+      if (!giop_1_1 && this->parse_request_id (fragment, request_id) == -1)
         {
-          CORBA::ULong head_request_id = 0;
-          int parse_status = 0;
-
-          if (head->more_fragments () &&
-              head->giop_version ().major_version () >= 1 &&
-              head->giop_version ().minor_version () >= 2 &&
-              head->msg_block ()->length () >= header_adjustment &&
-              (parse_status = this->parse_request_id (head, head_request_id)) != -1 &&
-              request_id == head_request_id)
-            {
-              // adjust the read-pointer, skip the fragment header
-              tail->msg_block ()->rd_ptr(header_adjustment);
+          return -1;
+        }
+    }
 
-              head->msg_block ()->cont (tail->msg_block ());
+  TAO::Incoming_Message_Stack reverse_stack;
 
-              tail->msg_block (nullptr);
+  TAO_Queued_Data *candidate = nullptr;
+  int status = 1;
 
-              TAO_Queued_Data::release (tail);
+  while (status == 1 && this->fragment_stack_.pop (candidate) != -1)
+    {
+      bool match = false;
 
-              tail = head;
+      if (in_place != nullptr)
+        {
+          match = candidate == in_place;
+        }
+      else if (candidate->more_fragments () &&
+               candidate->msg_block ()->length () >= header_adjustment)
+        {
+          if (giop_1_1)
+            {
+              // GIOP-1.1
+              match = candidate->giop_version ().major_version () == 1 &&
+                      candidate->giop_version ().minor_version () == 1;
             }
-          else
+          else if (candidate->giop_version ().major_version () >= 1 &&
+                   candidate->giop_version ().minor_version () >= 2)
             {
-              if (parse_status == -1)
+              // > GIOP-1.2
+              CORBA::ULong candidate_request_id = 0;
+
+              if (this->parse_request_id (candidate, candidate_request_id) == -1)
                 {
-                  TAO_Queued_Data::release (head);
-                  return -1;
+                  TAO_Queued_Data::release (candidate);
+                  status = -1;
+                  break;
                 }
 
-              reverse_stack.push (head);
+              match = request_id == candidate_request_id;
             }
         }
+
+      if (match)
+        {
+          head = candidate;
+          status = 0;
+        }
+      else
+        {
+          reverse_stack.push (candidate);
+        }
     }
 
   // restore stack
-  while (reverse_stack.pop (head) != -1)
+  while (reverse_stack.pop (candidate) != -1)
     {
-      this->fragment_stack_.push (head);
+      this->fragment_stack_.push (candidate);
+    }
+
+  return status;
+}
+
+bool
+TAO_GIOP_Message_Base::read_in_place (const TAO_Queued_Data *head,
+                                      const TAO_Queued_Data *fragment) const
+{
+  return head->msg_block ()->data_block () ==
+           fragment->msg_block ()->data_block () &&
+         head->msg_block ()->wr_ptr () == fragment->msg_block ()->rd_ptr ();
+}
+
+int
+TAO_GIOP_Message_Base::reserve_fragment_space (TAO_Queued_Data *head,
+                                               size_t size)
+{
+  ACE_Message_Block *mb = head->msg_block ();
+
+  // The buffer may still be shared with the input buffer the head was
+  // parsed from.
+  if (mb->space () >= size && mb->data_block ()->reference_count () == 1)
+    {
+      return 0;
     }
 
-  if (tail->consolidate () == -1)
+  // Grow geometrically, so that a message of many fragments is not
+  // moved each time one comes in.
+  TAO_Queued_Data *grown =
+    this->make_queued_data (ace_max (mb->length () + size,
+                                     2 * mb->length ()));
+
+  if (grown == nullptr)
     {
-      // memory allocation failed
-      TAO_Queued_Data::release (tail);
       return -1;
     }
 
-  // set out value
-  msg = tail;
+  ACE_Message_Block *nb = grown->msg_block ();
+
+  if (nb->copy (mb->rd_ptr (), mb->length ()) == -1)
+    {
+      TAO_Queued_Data::release (grown);
+      return -1;
+    }
+
+  // Swap the blocks, releasing the old one with the node.
+  grown->msg_block (mb);
+  head->msg_block (nb);
+  TAO_Queued_Data::release (grown);
 
   return 0;
 }
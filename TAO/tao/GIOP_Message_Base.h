@@ -130,17 +130,24 @@ public:
   TAO_OutputCDR &out_stream ();
 
   /// Consolidate fragmented message with associated fragments, being
-  /// stored within this class.  If reliable transport is used (like
-  /// TCP) fragments are partially ordered on stack, last fragment on
-  /// top. Otherwise If un-reliable transport is used (like UDP)
-  /// fragments may be dis-ordered, and must be ordered before
-  /// consolidation.  @return 0 on success and @a msg points to
+  /// stored within this class.  The first message of a fragmented
+  /// message is kept on a stack and the payload of each fragment is
+  /// appended to its buffer, so the message is contiguous without a
+  /// final copy.  @return 0 on success and @a msg points to
   /// consolidated message, 1 if there are still fragments outstanding,
   /// in case of error -1 is being returned. In any case @a qd must be
   /// released by method implementation.
   int consolidate_fragmented_message (TAO_Queued_Data *qd,
                                       TAO_Queued_Data *&msg);
 
+  /// If @a qd is the start of a fragment whose payload is partly
+  /// missing, copy what has been received behind the message it
+  /// continues and return a node to read the rest into, directly
+  /// into the buffer of that message.  The node is passed to
+  /// consolidate_fragmented_message() once complete.  @return 0 if
+  /// @a qd has to be read as it is.
+  TAO_Queued_Data *fragment_in_place (const TAO_Queued_Data &qd);
+
   /// Discard all fragments associated to request-id encoded in
   /// cancel_request.  This operation will never be called
   /// concurrently by multiple threads nor concurrently to
@@ -228,6 +235,21 @@ private:
   /// node of size @a sz.
   TAO_Queued_Data *make_queued_data (size_t sz);
 
+  /// Remove from the stack the message that @a fragment continues.
+  /// @return 0 if found and returned in @a head, 1 if there is none,
+  /// -1 on error.
+  int take_fragment_head (const TAO_Queued_Data *fragment,
+                          TAO_Queued_Data *&head);
+
+  /// Was the payload of @a fragment read in place behind @a head?
+  bool read_in_place (const TAO_Queued_Data *head,
+                      const TAO_Queued_Data *fragment) const;
+
+  /// Make sure there are @a size bytes free behind the data of
+  /// @a head, in a buffer that it does not share.
+  /// @return 0 on success, otherwise -1
+  int reserve_fragment_space (TAO_Queued_Data *head, size_t size);
+
   /// Parse GIOP request-id of TAO_Queued_Data @a qd
   /// @return 0 on success, otherwise -1
   int parse_request_id (const TAO_Queued_Data *qd, CORBA::ULong &request_id) const;
@@ -251,8 +273,8 @@ private:
   /// All the implementations of GIOP message generator and parsers
   TAO_GIOP_Message_Generator_Parser_Impl tao_giop_impl_;
 
-  /// All Fragments being received are stored on stack in reverse
-  /// order, last top
+  /// The first messages of the fragmented messages being received,
+  /// each holding the payload of its fragments so far
   TAO::Incoming_Message_Stack fragment_stack_;
 
 protected:
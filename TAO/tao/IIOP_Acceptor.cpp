@@ -21,6 +21,37 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+TAO_IIOP_Accept_Strategy::TAO_IIOP_Accept_Strategy (TAO_ORB_Core *orb_core,
+                                                    bool reuse_port)
+  : TAO_Accept_Strategy<TAO_IIOP_Connection_Handler, ACE_SOCK_ACCEPTOR> (orb_core),
+    reuse_port_ (reuse_port)
+{
+}
+
+int
+TAO_IIOP_Accept_Strategy::open (const ACE_INET_Addr &local_addr,
+                                bool restart)
+{
+  if (!this->reuse_port_)
+    return this->TAO_Accept_Strategy<TAO_IIOP_Connection_Handler,
+                                     ACE_SOCK_ACCEPTOR>::open (local_addr,
+                                                               restart);
+
+  this->reuse_addr_ = restart;
+  this->peer_acceptor_addr_ = local_addr;
+  if (this->peer_acceptor_.open (local_addr,
+                                 restart,
+                                 PF_UNSPEC,
+                                 ACE_DEFAULT_BACKLOG,
+                                 0,
+                                 0,
+                                 1) == -1)
+    return -1;
+
+  // Non-blocking for the same reason as in ACE_Accept_Strategy::open().
+  return this->peer_acceptor_.enable (ACE_NONBLOCK);
+}
+
 TAO_IIOP_Acceptor::TAO_IIOP_Acceptor ()
   : TAO_Acceptor (IOP::TAG_INTERNET_IOP),
     addrs_ (nullptr),
@@ -31,6 +62,9 @@ TAO_IIOP_Acceptor::TAO_IIOP_Acceptor ()
     version_ (TAO_DEF_GIOP_MAJOR, TAO_DEF_GIOP_MINOR),
     orb_core_ (nullptr),
     reuse_addr_ (1),
+    reuse_port_ (false),
+    listeners_ (1),
+    accept_batch_ (0),
 #if defined (ACE_HAS_IPV6) && !defined (ACE_USES_IPV4_IPV6_MIGRATION)
     default_address_ (static_cast<unsigned short> (0), ACE_IPV6_ANY, AF_INET6),
 #else
@@ -60,6 +94,12 @@ TAO_IIOP_Acceptor::~TAO_IIOP_Acceptor ()
   delete this->concurrency_strategy_;
   delete this->accept_strategy_;
 
+  for (size_t i = 0; i != this->extra_acceptors_.size (); ++i)
+    {
+      delete this->extra_acceptors_[i];
+      delete this->extra_accept_strategies_[i];
+    }
+
   delete [] this->addrs_;
 
   for (CORBA::ULong i = 0; i < this->endpoint_count_; ++i)
@@ -254,7 +294,15 @@ TAO_IIOP_Acceptor::is_collocated (const TAO_Endpoint *endpoint)
 int
 TAO_IIOP_Acceptor::close ()
 {
-  return this->base_acceptor_.close ();
+  int result = this->base_acceptor_.close ();
+
+  for (size_t i = 0; i != this->extra_acceptors_.size (); ++i)
+    {
+      if (this->extra_acceptors_[i]->close () != 0)
+        result = -1;
+    }
+
+  return result;
 }
 
 int
@@ -443,20 +491,18 @@ TAO_IIOP_Acceptor::open_i (const ACE_INET_Addr& addr,
                   -1);
 
   ACE_NEW_RETURN (this->accept_strategy_,
-                  ACCEPT_STRATEGY (this->orb_core_),
+                  ACCEPT_STRATEGY (this->orb_core_,
+                                   this->reuse_port_ || this->listeners_ > 1),
                   -1);
 
   unsigned short const requested_port = addr.get_port_number ();
   if (requested_port == 0)
     {
       // don't care, i.e., let the OS choose an ephemeral port
-      if (this->base_acceptor_.open (addr,
-                                     reactor,
-                                     this->creation_strategy_,
-                                     this->accept_strategy_,
-                                     this->concurrency_strategy_,
-                                     nullptr, nullptr, nullptr, ACE_DEFAULT_ACCEPTOR_USE_SELECT,
-                                     this->reuse_addr_) == -1)
+      if (this->open_listener (this->base_acceptor_,
+                               this->accept_strategy_,
+                               addr,
+                               reactor) == -1)
         {
           if (TAO_debug_level > 0)
             TAOLIB_ERROR ((LM_ERROR,
@@ -483,13 +529,10 @@ TAO_IIOP_Acceptor::open_i (const ACE_INET_Addr& addr,
 
           // Now try to actually open on that port
           a.set_port_number ((u_short)p);
-          if (this->base_acceptor_.open (a,
-                                         reactor,
-                                         this->creation_strategy_,
-                                         this->accept_strategy_,
-                                         this->concurrency_strategy_,
-                                         nullptr, nullptr, nullptr, ACE_DEFAULT_ACCEPTOR_USE_SELECT,
-                                         this->reuse_addr_) != -1)
+          if (this->open_listener (this->base_acceptor_,
+                                   this->accept_strategy_,
+                                   a,
+                                   reactor) != -1)
             {
               found_a_port = true;
               break;
@@ -564,6 +607,11 @@ TAO_IIOP_Acceptor::open_i (const ACE_INET_Addr& addr,
   // denying the server the opportunity to restart on a well-known endpoint.
   // This does not affect the aberrent behavior on Win32 platforms.
 
+  ACE_INET_Addr extra_addr (addr);
+  extra_addr.set_port_number (port);
+  if (this->open_extra_listeners (extra_addr, reactor) == -1)
+    return -1;
+
   if (TAO_debug_level > 5)
     {
       for (CORBA::ULong i = 0; i < this->endpoint_count_; ++i)
@@ -586,6 +634,85 @@ TAO_IIOP_Acceptor::open_i (const ACE_INET_Addr& addr,
   return 0;
 }
 
+int
+TAO_IIOP_Acceptor::open_listener (BASE_ACCEPTOR &acceptor,
+                                  ACCEPT_STRATEGY *accept_strategy,
+                                  const ACE_INET_Addr &addr,
+                                  ACE_Reactor *reactor)
+{
+  // A batching acceptor checks for more connections by accepting
+  // until accept() would block, so it does not poll the socket.
+  acceptor.accept_batch (this->accept_batch_);
+
+  return acceptor.open (addr,
+                        reactor,
+                        this->creation_strategy_,
+                        accept_strategy,
+                        this->concurrency_strategy_,
+                        nullptr, nullptr, nullptr,
+                        this->accept_batch_ == 0
+                          ? ACE_DEFAULT_ACCEPTOR_USE_SELECT
+                          : 0,
+                        this->reuse_addr_);
+}
+
+int
+TAO_IIOP_Acceptor::open_extra_listeners (const ACE_INET_Addr &addr,
+                                         ACE_Reactor *reactor)
+{
+  if (this->listeners_ < 2)
+    return 0;
+
+  size_t const count = this->listeners_ - 1;
+  if (this->extra_acceptors_.size (count) != 0
+      || this->extra_accept_strategies_.size (count) != 0)
+    return -1;
+
+  for (size_t i = 0; i != count; ++i)
+    {
+      this->extra_acceptors_[i] = nullptr;
+      this->extra_accept_strategies_[i] = nullptr;
+    }
+
+  for (size_t i = 0; i != count; ++i)
+    {
+      ACE_NEW_RETURN (this->extra_accept_strategies_[i],
+                      ACCEPT_STRATEGY (this->orb_core_, true),
+                      -1);
+
+      ACE_NEW_RETURN (this->extra_acceptors_[i],
+                      BASE_ACCEPTOR (this),
+                      -1);
+
+      if (this->open_listener (*this->extra_acceptors_[i],
+                               this->extra_accept_strategies_[i],
+                               addr,
+                               reactor) == -1)
+        {
+          if (TAO_debug_level > 0)
+            TAOLIB_ERROR ((LM_ERROR,
+                        ACE_TEXT ("TAO (%P|%t) - IIOP_Acceptor::")
+                        ACE_TEXT ("open_extra_listeners, ")
+                        ACE_TEXT ("listener %B on port %d - %p\n"),
+                        i + 2,
+                        addr.get_port_number (),
+                        ACE_TEXT ("cannot open")));
+          return -1;
+        }
+
+      (void) this->extra_acceptors_[i]->acceptor ().enable (ACE_CLOEXEC);
+    }
+
+  if (TAO_debug_level > 5)
+    TAOLIB_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("TAO (%P|%t) - IIOP_Acceptor::open_extra_listeners, ")
+                ACE_TEXT ("%u listen sockets on port %d\n"),
+                this->listeners_,
+                addr.get_port_number ()));
+
+  return 0;
+}
+
 int
 TAO_IIOP_Acceptor::hostname (TAO_ORB_Core *orb_core,
                              const ACE_INET_Addr &addr,
@@ -1240,6 +1367,34 @@ TAO_IIOP_Acceptor::parse_options_i (int &argc,
         {
           this->reuse_addr_ = ACE_OS::atoi (value.c_str ());
         }
+      else if (name == "reuse_port")
+        {
+          this->reuse_port_ = ACE_OS::atoi (value.c_str ()) != 0;
+        }
+      else if (name == "listeners")
+        {
+          int const listeners = ACE_OS::atoi (value.c_str ());
+          if (listeners < 1)
+            TAOLIB_ERROR_RETURN ((LM_ERROR,
+                               ACE_TEXT ("TAO (%P|%t) Invalid IIOP endpoint ")
+                               ACE_TEXT ("listeners: <%C>\n"),
+                               value.c_str ()),
+                              -1);
+
+          this->listeners_ = static_cast<CORBA::ULong> (listeners);
+        }
+      else if (name == "accept_batch")
+        {
+          int const batch = ACE_OS::atoi (value.c_str ());
+          if (batch < 0)
+            TAOLIB_ERROR_RETURN ((LM_ERROR,
+                               ACE_TEXT ("TAO (%P|%t) Invalid IIOP endpoint ")
+                               ACE_TEXT ("accept_batch: <%C>\n"),
+                               value.c_str ()),
+                              -1);
+
+          this->accept_batch_ = static_cast<CORBA::ULong> (batch);
+        }
       else
         {
           // the name is not known, skip to the next option
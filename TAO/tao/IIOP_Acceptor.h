@@ -32,9 +32,31 @@
 
 #include "ace/SOCK_Acceptor.h"
 #include "ace/Acceptor.h"
+#include "ace/Array_Base.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+/**
+ * @class TAO_IIOP_Accept_Strategy
+ *
+ * @brief Accept strategy that can open its listen socket with
+ * SO_REUSEPORT, so that it shares the port with other listen sockets.
+ */
+class TAO_Export TAO_IIOP_Accept_Strategy
+  : public TAO_Accept_Strategy<TAO_IIOP_Connection_Handler, ACE_SOCK_ACCEPTOR>
+{
+public:
+  TAO_IIOP_Accept_Strategy (TAO_ORB_Core *orb_core, bool reuse_port);
+
+  /// Open the listen socket, with SO_REUSEPORT if requested.
+  int open (const ACE_INET_Addr &local_addr, bool restart = false) override;
+
+private:
+  /// Set SO_REUSEPORT on the listen socket.
+  bool const reuse_port_;
+};
+
+
 /**
  * @class TAO_IIOP_Acceptor
  *
@@ -67,7 +89,7 @@ public:
   typedef TAO_Strategy_Acceptor<TAO_IIOP_Connection_Handler, ACE_SOCK_ACCEPTOR> BASE_ACCEPTOR;
   typedef TAO_Creation_Strategy<TAO_IIOP_Connection_Handler> CREATION_STRATEGY;
   typedef TAO_Concurrency_Strategy<TAO_IIOP_Connection_Handler> CONCURRENCY_STRATEGY;
-  typedef TAO_Accept_Strategy<TAO_IIOP_Connection_Handler, ACE_SOCK_ACCEPTOR> ACCEPT_STRATEGY;
+  typedef TAO_IIOP_Accept_Strategy ACCEPT_STRATEGY;
 
   /**
    * The TAO_Acceptor methods, check the documentation in
@@ -147,6 +169,18 @@ protected:
   virtual int open_i (const ACE_INET_Addr &addr,
                       ACE_Reactor *reactor);
 
+  /// Open @a acceptor on @a addr with the strategies of this acceptor
+  /// and the given @a accept_strategy.
+  int open_listener (BASE_ACCEPTOR &acceptor,
+                     ACCEPT_STRATEGY *accept_strategy,
+                     const ACE_INET_Addr &addr,
+                     ACE_Reactor *reactor);
+
+  /// Open the listen sockets after the first one on @a addr, which
+  /// holds the port the first one was bound to.
+  int open_extra_listeners (const ACE_INET_Addr &addr,
+                            ACE_Reactor *reactor);
+
   /**
    * Probe the system for available network interfaces, and initialize
    * the <addrs_> array with an ACE_INET_Addr for each network
@@ -170,6 +204,16 @@ protected:
    *                for situations where you might normally use an ephemeral
    *                port but can't because you're behind a firewall and don't
    *                want to permit passage on all ephemeral ports)
+   *    reuse_port -- sets SO_REUSEPORT, so that other sockets, for
+   *                example of other lanes or processes, can listen on
+   *                the same port
+   *    listeners -- the number of listen sockets opened on the port with
+   *                SO_REUSEPORT, all registered with the reactor; the
+   *                kernel spreads the connections over them, so that
+   *                several threads can accept at the same time
+   *    accept_batch -- the maximum number of connections accepted each
+   *                time a listen socket is ready, without polling the
+   *                socket between them
    */
   int parse_options (const char *options);
 
@@ -245,6 +289,17 @@ protected:
   /// Enable socket option SO_REUSEADDR to be set
   int reuse_addr_;
 
+  /// Enable socket option SO_REUSEPORT to be set
+  bool reuse_port_;
+
+  /// Number of listen sockets opened on the endpoint, more than one
+  /// implies SO_REUSEPORT
+  CORBA::ULong listeners_;
+
+  /// Maximum number of connections accepted each time a listen
+  /// socket is ready, 0 to poll the socket after each connection
+  CORBA::ULong accept_batch_;
+
   /// Address for default endpoint
   ACE_INET_Addr default_address_;
 
@@ -256,6 +311,11 @@ private:
   CREATION_STRATEGY *creation_strategy_;
   CONCURRENCY_STRATEGY *concurrency_strategy_;
   ACCEPT_STRATEGY *accept_strategy_;
+
+  /// The listen sockets after the first one, and their accept
+  /// strategies, when the endpoint has more than one.
+  ACE_Array_Base<BASE_ACCEPTOR *> extra_acceptors_;
+  ACE_Array_Base<ACCEPT_STRATEGY *> extra_accept_strategies_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -68,6 +68,10 @@
 #include <cstring>
 #include <memory>
 
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+# include "ace/Monitor_Base.h"
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+
 #if TAO_HAS_INTERCEPTORS == 1
 # include "tao/ClientRequestInterceptor_Adapter.h"
 # include "tao/ClientRequestInterceptor_Adapter_Factory.h"
@@ -267,6 +271,10 @@ TAO_ORB_Core::TAO_ORB_Core (const char *orbid,
     sync_scope_hook_ (nullptr),
     default_sync_scope_ (Messaging::SYNC_WITH_TRANSPORT),
     timeout_hook_ (nullptr)
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+    , oneway_batches_monitor_ (nullptr)
+    , oneway_batched_monitor_ (nullptr)
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
 {
 #if (TAO_HAS_BUFFERING_CONSTRAINT_POLICY == 1)
 
@@ -301,6 +309,20 @@ TAO_ORB_Core::~TAO_ORB_Core ()
 
   delete this->flushing_strategy_;
 
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+  if (this->oneway_batches_monitor_ != nullptr)
+    {
+      this->oneway_batches_monitor_->remove_from_registry ();
+      this->oneway_batches_monitor_->remove_ref ();
+    }
+
+  if (this->oneway_batched_monitor_ != nullptr)
+    {
+      this->oneway_batched_monitor_->remove_from_registry ();
+      this->oneway_batched_monitor_->remove_ref ();
+    }
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+
   ACE_OS::free (this->orbid_);
 
 #if (TAO_HAS_BUFFERING_CONSTRAINT_POLICY == 1)
@@ -1086,6 +1108,22 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
         {
           this->use_local_memory_pool_ = (0 != ACE_OS::atoi (current_arg));
 
+          arg_shifter.consume_arg ();
+        }
+      else if (nullptr != (current_arg = arg_shifter.get_the_parameter
+                (ACE_TEXT("-ORBCDRZeroCopyThreshold"))))
+        {
+          this->orb_params_.cdr_zero_copy_threshold (
+            ACE_OS::strtoul (current_arg, nullptr, 10));
+
+          arg_shifter.consume_arg ();
+        }
+      else if (nullptr != (current_arg = arg_shifter.get_the_parameter
+                (ACE_TEXT("-ORBOnewayBatchSize"))))
+        {
+          this->orb_params_.oneway_batch_size (
+            ACE_OS::strtoul (current_arg, nullptr, 10));
+
           arg_shifter.consume_arg ();
         }
       else if (nullptr != (current_arg = arg_shifter.get_the_parameter
@@ -1310,6 +1348,55 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
 
   trf->use_local_memory_pool (this->use_local_memory_pool_);
 
+  // Split the ObjectKey table before any profile binds a key in it.
+  int const object_key_table_shards = trf->object_key_table_shards ();
+  if (object_key_table_shards > 0
+      && this->object_key_table_.open (object_key_table_shards) == -1)
+    {
+      TAOLIB_ERROR ((LM_ERROR,
+                  ACE_TEXT ("TAO (%P|%t) - %p\n"),
+                  ACE_TEXT ("ORB Core unable to initialize ")
+                  ACE_TEXT ("the ObjectKey table")));
+      throw ::CORBA::INITIALIZE (
+        CORBA::SystemException::_tao_minor_code (
+          TAO_ORB_CORE_INIT_LOCATION_CODE,
+          ENOMEM),
+        CORBA::COMPLETED_NO);
+    }
+
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+  if (this->orb_params_.oneway_batch_size () > 0)
+    {
+      ACE_CString batches_name ("Oneway_Batches_");
+      ACE_CString batched_name ("Oneway_Batched_");
+
+      batches_name += this->orbid_;
+      batched_name += this->orbid_;
+
+      ACE_NEW_THROW_EX (this->oneway_batches_monitor_,
+                        ACE::Monitor_Control::Monitor_Base (
+                          batches_name.c_str (),
+                          ACE::Monitor_Control::Monitor_Control_Types::MC_COUNTER),
+                        CORBA::NO_MEMORY (
+                          CORBA::SystemException::_tao_minor_code (
+                            TAO_ORB_CORE_INIT_LOCATION_CODE,
+                            ENOMEM),
+                          CORBA::COMPLETED_NO));
+      ACE_NEW_THROW_EX (this->oneway_batched_monitor_,
+                        ACE::Monitor_Control::Monitor_Base (
+                          batched_name.c_str (),
+                          ACE::Monitor_Control::Monitor_Control_Types::MC_COUNTER),
+                        CORBA::NO_MEMORY (
+                          CORBA::SystemException::_tao_minor_code (
+                            TAO_ORB_CORE_INIT_LOCATION_CODE,
+                            ENOMEM),
+                          CORBA::COMPLETED_NO));
+
+      this->oneway_batches_monitor_->add_to_registry ();
+      this->oneway_batched_monitor_->add_to_registry ();
+    }
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+
   // @@ ????
   // Make sure the reactor is initialized...
   ACE_Reactor *reactor = this->reactor ();
@@ -1509,6 +1596,22 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
 }
 
 
+void
+TAO_ORB_Core::oneway_queued (bool batched)
+{
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+  ACE::Monitor_Control::Monitor_Base *monitor =
+    batched ? this->oneway_batched_monitor_ : this->oneway_batches_monitor_;
+
+  if (monitor != nullptr)
+    {
+      monitor->receive (static_cast<size_t> (1));
+    }
+#else
+  ACE_UNUSED_ARG (batched);
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
+}
+
 int
 TAO_ORB_Core::fini ()
 {
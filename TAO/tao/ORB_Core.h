@@ -45,6 +45,16 @@
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Data_Block;
+
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+namespace ACE
+{
+  namespace Monitor_Control
+  {
+    class Monitor_Base;
+  }
+}
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
 ACE_END_VERSIONED_NAMESPACE_DECL
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -851,6 +861,12 @@ public:
   /// Acceessor to the table that stores the object_keys.
   TAO::ObjectKey_Table &object_key_table ();
 
+  /// Count a oneway a transport had to queue, @a batched if it was
+  /// appended to a message already in the queue.  Feeds the
+  /// Oneway_Batches_ and Oneway_Batched_ monitor points when
+  /// -ORBOnewayBatchSize is set.
+  void oneway_queued (bool batched);
+
   /// Return the current request dispatcher strategy.
   TAO_Request_Dispatcher *request_dispatcher ();
 
@@ -1269,6 +1285,14 @@ protected:
 
   /// The hook to be set for the RelativeRoundtripTimeoutPolicy.
   Timeout_Hook timeout_hook_;
+
+#if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
+  /// Counts the queued messages oneways are batched into.
+  ACE::Monitor_Control::Monitor_Base *oneway_batches_monitor_;
+
+  /// Counts the oneways appended to a queued message.
+  ACE::Monitor_Control::Monitor_Base *oneway_batched_monitor_;
+#endif /* TAO_HAS_MONITOR_POINTS==1 */
 };
 
 // ****************************************************************
@@ -1,6 +1,7 @@
 #include "tao/ObjectKey_Table.h"
 #include "tao/ORB_Core.h"
 #include "tao/Refcounted_ObjectKey.h"
+#include "ace/ACE.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/ObjectKey_Table.inl"
@@ -31,19 +32,143 @@ TAO::Less_Than_ObjectKey::operator () (const TAO::ObjectKey &lhs,
 }
 
 /********************************************************/
+namespace
+{
+  /// Number of buckets a shard starts with.
+  size_t const initial_bucket_count = 64;
+}
+
+TAO::ObjectKey_Table::Shard::Shard ()
+  : buckets_ (nullptr)
+  , bucket_count_ (0)
+  , current_size_ (0)
+{
+}
+
+TAO::ObjectKey_Table::Shard::~Shard ()
+{
+  delete [] this->buckets_;
+}
+
+int
+TAO::ObjectKey_Table::Shard::grow (size_t shard_count)
+{
+  size_t const new_count =
+    this->bucket_count_ == 0 ? initial_bucket_count : 2 * this->bucket_count_;
+
+  Refcounted_ObjectKey **new_buckets = nullptr;
+  ACE_NEW_RETURN (new_buckets,
+                  Refcounted_ObjectKey *[new_count](),
+                  -1);
+
+  // The keys remember their hash, so they can be moved without
+  // hashing them again.  What is left of the hash once the shard is
+  // chosen selects the bucket.
+  for (size_t i = 0; i != this->bucket_count_; ++i)
+    {
+      Refcounted_ObjectKey *key = this->buckets_[i];
+
+      while (key != nullptr)
+        {
+          Refcounted_ObjectKey *const next = key->next_;
+          Refcounted_ObjectKey *&head =
+            new_buckets[(key->hash_ / shard_count) & (new_count - 1)];
+          key->next_ = head;
+          head = key;
+          key = next;
+        }
+    }
+
+  delete [] this->buckets_;
+  this->buckets_ = new_buckets;
+  this->bucket_count_ = new_count;
+
+  return 0;
+}
+
 TAO::ObjectKey_Table::ObjectKey_Table ()
   : table_ ()
+  , shards_ (nullptr)
+  , shard_count_ (0)
 {
 }
 
 TAO::ObjectKey_Table::~ObjectKey_Table ()
 {
   this->table_.close ();
+  delete [] this->shards_;
+}
+
+CORBA::ULong
+TAO::ObjectKey_Table::hash (const TAO::ObjectKey &key)
+{
+  return ACE::hash_pjw (reinterpret_cast<const char *> (key.get_buffer ()),
+                        key.length ());
+}
+
+int
+TAO::ObjectKey_Table::open (size_t shards)
+{
+  if (this->shards_ != nullptr || this->table_.current_size () != 0)
+    {
+      errno = EBUSY;
+      return -1;
+    }
+
+  if (shards == 0)
+    {
+      return 0;
+    }
+
+  Shard *new_shards = nullptr;
+  ACE_NEW_RETURN (new_shards,
+                  Shard[shards],
+                  -1);
+
+  for (size_t i = 0; i != shards; ++i)
+    {
+      if (new_shards[i].grow (shards) == -1)
+        {
+          delete [] new_shards;
+          return -1;
+        }
+    }
+
+  this->shards_ = new_shards;
+  this->shard_count_ = shards;
+
+  return 0;
 }
 
 int
 TAO::ObjectKey_Table::destroy ()
 {
+  for (size_t i = 0; i != this->shard_count_; ++i)
+    {
+      Shard &s = this->shards_[i];
+
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                        ace_mon,
+                        s.lock_,
+                        0);
+
+      for (size_t j = 0; j != s.bucket_count_; ++j)
+        {
+          Refcounted_ObjectKey *key = s.buckets_[j];
+          s.buckets_[j] = nullptr;
+
+          while (key != nullptr)
+            {
+              Refcounted_ObjectKey *const next = key->next_;
+              key->next_ = nullptr;
+              key->decr_refcount ();
+              key = next;
+            }
+        }
+
+      s.current_size_ = 0;
+    }
+
   if (this->table_.current_size ())
     {
       ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
@@ -103,4 +228,97 @@ TAO::ObjectKey_Table::unbind_i (TAO::Refcounted_ObjectKey *&key_new)
   return 0;
 }
 
+int
+TAO::ObjectKey_Table::bind_shard (const TAO::ObjectKey &key,
+                                  TAO::Refcounted_ObjectKey *&key_new)
+{
+  // Hash before taking the lock.
+  CORBA::ULong const key_hash = TAO::ObjectKey_Table::hash (key);
+  CORBA::ULong const length = key.length ();
+  const CORBA::Octet *const buffer = key.get_buffer ();
+
+  Shard &s = this->shard (key_hash);
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                    ace_mon,
+                    s.lock_,
+                    -1);
+
+  Refcounted_ObjectKey *&head =
+    s.buckets_[(key_hash / this->shard_count_) & (s.bucket_count_ - 1)];
+
+  for (Refcounted_ObjectKey *k = head; k != nullptr; k = k->next_)
+    {
+      if (k->hash_ == key_hash
+          && k->object_key_.length () == length
+          && ACE_OS::memcmp (k->object_key_.get_buffer (),
+                             buffer,
+                             length) == 0)
+        {
+          k->incr_refcount ();
+          key_new = k;
+          return 0;
+        }
+    }
+
+  ACE_NEW_RETURN (key_new,
+                  TAO::Refcounted_ObjectKey (key, key_hash),
+                  -1);
+
+  // The table holds one reference, the caller the other.
+  key_new->incr_refcount ();
+  key_new->next_ = head;
+  head = key_new;
+
+  // Keep the chains short, a shard that cannot grow still works.
+  if (++s.current_size_ > s.bucket_count_)
+    {
+      (void) s.grow (this->shard_count_);
+    }
+
+  return 0;
+}
+
+int
+TAO::ObjectKey_Table::unbind_shard (TAO::Refcounted_ObjectKey *&key_new)
+{
+  if (key_new == nullptr)
+    {
+      return 0;
+    }
+
+  Shard &s = this->shard (key_new->hash_);
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                    ace_mon,
+                    s.lock_,
+                    0);
+
+  // If only the table holds the key now, remove it.
+  if (key_new->decr_refcount () != 1)
+    {
+      return 0;
+    }
+
+  // The key is not in the shard any more if the table was destroyed
+  // while it was in use.
+  for (Refcounted_ObjectKey **k =
+         &s.buckets_[(key_new->hash_ / this->shard_count_)
+                     & (s.bucket_count_ - 1)];
+       *k != nullptr;
+       k = &(*k)->next_)
+    {
+      if (*k == key_new)
+        {
+          *k = key_new->next_;
+          key_new->next_ = nullptr;
+          --s.current_size_;
+          (void) key_new->decr_refcount ();
+          break;
+        }
+    }
+
+  return 0;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
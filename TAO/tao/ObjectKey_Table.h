@@ -76,11 +76,13 @@ namespace TAO
    * table.
    *
    * @note The reasons to use RB_Tree are its good dynamic
-   * properties. We should try to strategize the class to use either a
-   * Hash_Map or a RB_Tree based on some runtime option. For that we
-   * need an adapter class in ACE, like an ACE_Lock_Adapter class. We
-   * will do that if our instrumentation shows the need for it.
-   *
+   * properties. With open () the table can instead be split into
+   * shards, each a chained hash table with its own lock. The hash of
+   * a key is computed once, outside of any lock, and kept in the
+   * Refcounted_ObjectKey, so that unbind () finds the shard and the
+   * bucket without looking at the key again. Threads demarshaling
+   * references with different keys then rarely wait for each other,
+   * and a lookup compares full keys only when their hashes match.
    */
   class TAO_Export ObjectKey_Table
   {
@@ -90,6 +92,14 @@ namespace TAO
 
     ~ObjectKey_Table ();
 
+    /// Split the table into @a shards hash tables.
+    /**
+     * With 0 shards the keys stay in a single RB_Tree under one
+     * lock. Has to be called before the first bind (). Returns 0 on
+     * success and -1 on failure.
+     */
+    int open (size_t shards);
+
     /// Iterates and unbinds the contents of the table.
     int destroy ();
 
@@ -107,6 +117,12 @@ namespace TAO
     /// Unbind an ObjectKey from the table.
     int unbind (TAO::Refcounted_ObjectKey *&key);
 
+    /// Number of shards, 0 if the table is a single RB_Tree.
+    size_t shard_count () const;
+
+    /// Hash of @a key, as kept in the Refcounted_ObjectKey.
+    static CORBA::ULong hash (const ObjectKey &key);
+
   protected:
     /// Implementation for bind ().
     int bind_i (const ObjectKey &key, Refcounted_ObjectKey *&key_new);
@@ -114,6 +130,12 @@ namespace TAO
     /// Implementation for unbind ().
     int unbind_i (Refcounted_ObjectKey *&key);
 
+    /// Implementation of bind () for the sharded table.
+    int bind_shard (const ObjectKey &key, Refcounted_ObjectKey *&key_new);
+
+    /// Implementation of unbind () for the sharded table.
+    int unbind_shard (Refcounted_ObjectKey *&key);
+
   private:
     ObjectKey_Table (const ObjectKey_Table &) = delete;
     ObjectKey_Table &operator= (const ObjectKey_Table &) = delete;
@@ -129,6 +151,37 @@ namespace TAO
 
     /// Table that contains the data
     TABLE table_;
+
+    /// One part of the sharded table.
+    struct Shard
+    {
+      Shard ();
+      ~Shard ();
+
+      /// Double the number of buckets of a shard of a table split
+      /// into @a shard_count shards.
+      int grow (size_t shard_count);
+
+      /// Lock for the shard.
+      TAO_SYNCH_MUTEX lock_;
+
+      /// Chains of keys, linked through Refcounted_ObjectKey::next_.
+      Refcounted_ObjectKey **buckets_;
+
+      /// Number of buckets, a power of two.
+      size_t bucket_count_;
+
+      /// Number of keys in the shard.
+      size_t current_size_;
+    };
+
+    /// Shard for keys of hash @a hash.
+    Shard &shard (CORBA::ULong hash) const;
+
+    /// The shards, 0 if the RB_Tree is used.
+    Shard *shards_;
+
+    size_t shard_count_;
   };
 }
 
@@ -10,6 +10,11 @@ TAO::ObjectKey_Table::bind (const TAO::ObjectKey &key,
 {
   key_new = 0;
 
+  if (this->shards_ != nullptr)
+    {
+      return this->bind_shard (key, key_new);
+    }
+
   int retval = 0;
 
   {
@@ -41,6 +46,11 @@ int
 TAO::ObjectKey_Table::unbind (TAO::Refcounted_ObjectKey *&key_new)
 
 {
+  if (this->shards_ != nullptr)
+    {
+      return this->unbind_shard (key_new);
+    }
+
   ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
                     ace_mon,
                     this->lock_,
@@ -56,4 +66,18 @@ TAO::ObjectKey_Table::unbind (TAO::Refcounted_ObjectKey *&key_new)
   return 0;
 }
 
+ACE_INLINE
+size_t
+TAO::ObjectKey_Table::shard_count () const
+{
+  return this->shard_count_;
+}
+
+ACE_INLINE
+TAO::ObjectKey_Table::Shard &
+TAO::ObjectKey_Table::shard (CORBA::ULong hash) const
+{
+  return this->shards_[hash % this->shard_count_];
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -7,6 +7,7 @@
 #include "tao/debug.h"
 
 #include "ace/Truncate.h"
+#include "ace/OS_NS_string.h"
 
 TAO_On_Demand_Fragmentation_Strategy::TAO_On_Demand_Fragmentation_Strategy (
   TAO_Transport * transport,
@@ -49,8 +50,7 @@ TAO_On_Demand_Fragmentation_Strategy::fragment (
         + pending_length);
 
   // Except for the last fragment, fragmented GIOP messages must
-  // always be aligned on an 8-byte boundary.  Padding will be added
-  // if necessary.
+  // always be aligned on an 8-byte boundary.
   ACE_CDR::ULong const aligned_length =
       ACE_Utils::truncate_cast<ACE_CDR::ULong> (
           ACE_align_binary (total_pending_length, ACE_CDR::MAX_ALIGNMENT));
@@ -62,9 +62,38 @@ TAO_On_Demand_Fragmentation_Strategy::fragment (
   // since fragments must be aligned on an 8 byte boundary.
   if (aligned_length > this->max_message_size_)
     {
-      // Pad the outgoing fragment if necessary.
-      if (cdr.align_write_ptr (ACE_CDR::MAX_ALIGNMENT) != 0)
-        return -1;
+      // The receiver joins the bodies of the fragments, so padding
+      // would be read as data.  Cut the outgoing fragment at the last
+      // 8-byte boundary instead, and move the bytes written since then
+      // to the next fragment, where they keep their alignment behind
+      // the fragment header.
+      size_t const boundary =
+        cdr.total_length () - cdr.total_length () % ACE_CDR::MAX_ALIGNMENT;
+
+      char tail[ACE_CDR::MAX_ALIGNMENT];
+      size_t tail_length = 0;
+      size_t offset = 0;
+
+      for (ACE_Message_Block * mb =
+             const_cast<ACE_Message_Block *> (cdr.begin ());
+           mb != cdr.end ();
+           mb = mb->cont ())
+        {
+          size_t const length = mb->length ();
+
+          if (offset + length > boundary)
+            {
+              size_t const keep = boundary > offset ? boundary - offset : 0;
+
+              ACE_OS::memcpy (tail + tail_length,
+                              mb->rd_ptr () + keep,
+                              length - keep);
+              tail_length += length - keep;
+              mb->wr_ptr (mb->rd_ptr () + keep);
+            }
+
+          offset += length;
+        }
 
       // More fragments to come.
       cdr.more_fragments (true);
@@ -87,7 +116,12 @@ TAO_On_Demand_Fragmentation_Strategy::fragment (
           // Now generate a fragment header.
           || this->transport_->messaging_object ()->generate_fragment_header (
                cdr,
-               cdr.request_id ()) != 0)
+               cdr.request_id ()) != 0
+
+          // The start of the next fragment.
+          || !cdr.write_octet_array (
+               reinterpret_cast<ACE_CDR::Octet *> (tail),
+               static_cast<ACE_CDR::ULong> (tail_length)))
         return -1;
     }
 
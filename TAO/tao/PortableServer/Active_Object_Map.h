@@ -21,6 +21,7 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "tao/PortableServer/Servant_Base.h"
+#include "tao/PortableServer/Flat_Map_T.h"
 #include "tao/Server_Strategy_Factory.h"
 #include "ace/Map_T.h"
 #include "ace/Auto_Ptr.h"
@@ -38,6 +39,30 @@ class TAO_Id_Assignment_Strategy;
 class TAO_Id_Hint_Strategy;
 struct TAO_Active_Object_Map_Entry;
 
+/**
+ * @class TAO_Active_Object_Map_Entry_User_Id
+ *
+ * @brief Gives the key of an entry in the id maps.
+ */
+class TAO_Active_Object_Map_Entry_User_Id
+{
+public:
+  const PortableServer::ObjectId &
+  operator () (TAO_Active_Object_Map_Entry *entry) const;
+};
+
+/**
+ * @class TAO_Active_Object_Map_Entry_Servant
+ *
+ * @brief Gives the key of an entry in the servant maps.
+ */
+class TAO_Active_Object_Map_Entry_Servant
+{
+public:
+  const PortableServer::Servant &
+  operator () (TAO_Active_Object_Map_Entry *entry) const;
+};
+
 /**
  * @class TAO_Active_Object_Map
  *
@@ -214,6 +239,17 @@ public:
     TAO_Active_Object_Map_Entry *,
     TAO_Ignore_Original_Key_Adapter> user_id_active_map;
 
+#if (TAO_HAS_MINIMUM_POA_MAPS == 0)
+  /// Id flat map, which takes the ids from the entries.
+  typedef TAO_Flat_Map<
+  PortableServer::ObjectId,
+    TAO_Active_Object_Map_Entry *,
+    TAO_Active_Object_Map_Entry_User_Id,
+    TAO_ObjectId_Hash,
+    ACE_Equal_To<PortableServer::ObjectId>,
+    TAO_Incremental_Key_Generator> user_id_flat_map;
+#endif /* TAO_HAS_MINIMUM_POA_MAPS == 0 */
+
   /// Base class of the servant map.
   typedef ACE_Map<
   PortableServer::Servant,
@@ -233,6 +269,15 @@ public:
   PortableServer::Servant,
     TAO_Active_Object_Map_Entry *,
     ACE_Noop_Key_Generator<PortableServer::Servant> > servant_linear_map;
+
+  /// Servant flat map, which takes the servants from the entries.
+  typedef TAO_Flat_Map<
+  PortableServer::Servant,
+    TAO_Active_Object_Map_Entry *,
+    TAO_Active_Object_Map_Entry_Servant,
+    TAO_Servant_Hash,
+    ACE_Equal_To<PortableServer::Servant>,
+    ACE_Noop_Key_Generator<PortableServer::Servant> > servant_flat_map;
 #endif /* TAO_HAS_MINIMUM_POA_MAPS == 0 */
 
   /// Id map.
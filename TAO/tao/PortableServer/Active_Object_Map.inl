@@ -3,6 +3,20 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+ACE_INLINE const PortableServer::ObjectId &
+TAO_Active_Object_Map_Entry_User_Id::operator () (
+  TAO_Active_Object_Map_Entry *entry) const
+{
+  return entry->user_id_;
+}
+
+ACE_INLINE const PortableServer::Servant &
+TAO_Active_Object_Map_Entry_Servant::operator () (
+  TAO_Active_Object_Map_Entry *entry) const
+{
+  return entry->servant_;
+}
+
 ACE_INLINE int
 TAO_Active_Object_Map::is_servant_in_map (PortableServer::Servant servant,
                                           bool &deactivated)
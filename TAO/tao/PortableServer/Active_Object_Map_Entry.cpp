@@ -8,7 +8,9 @@ TAO_Active_Object_Map_Entry::TAO_Active_Object_Map_Entry ()
     servant_ (0),
     reference_count_ (1),
     deactivated_ (false),
-    priority_ (-1)
+    priority_ (-1),
+    dispatch_cached_ (false),
+    dispatch_hash_ (0)
 {
 }
 
@@ -16,6 +16,8 @@
 
 #include "tao/PortableServer/PS_ForwardC.h"
 
+#include <atomic>
+
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 # pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
@@ -46,14 +48,22 @@ struct TAO_Active_Object_Map_Entry
   /// Servant.
   PortableServer::Servant servant_;
 
-  /// Reference count on outstanding requests on this servant.
-  CORBA::UShort reference_count_;
+  /// Reference count on outstanding requests on this servant.  Also
+  /// incremented by requests dispatched through the
+  /// TAO::Portable_Server::Dispatch_Cache, without the object adapter
+  /// lock.
+  std::atomic<CORBA::UShort> reference_count_;
 
   /// Has this servant been deactivated already?
   CORBA::Boolean deactivated_;
 
   /// Priority of this servant.
   CORBA::Short priority_;
+
+  /// Whether the dispatch cache has a key for this entry, and the
+  /// hash of that key.
+  bool dispatch_cached_;
+  u_long dispatch_hash_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
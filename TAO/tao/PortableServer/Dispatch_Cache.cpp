@@ -0,0 +1,299 @@
+#include "tao/PortableServer/Dispatch_Cache.h"
+#include "tao/PortableServer/Root_POA.h"
+#include "tao/PortableServer/Active_Object_Map_Entry.h"
+
+#include "ace/ACE.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_Thread.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  namespace Portable_Server
+  {
+    Dispatch_Cache::Node::Node (const TAO::ObjectKey &key,
+                                u_long hash,
+                                TAO_Root_POA *poa,
+                                TAO_Active_Object_Map_Entry *entry)
+      : next_ (0),
+        hash_ (hash),
+        key_ (key),
+        poa_ (poa),
+        entry_ (entry),
+        list_prev_ (0),
+        list_next_ (0)
+    {
+    }
+
+    Dispatch_Cache::Dispatch_Cache (size_t size)
+      : buckets_ (0),
+        mask_ (0),
+        epoch_ (1),
+        suspended_ (0),
+        list_ (0),
+        current_size_ (0)
+    {
+      for (size_t i = 0; i < READER_SLOTS; ++i)
+        this->slots_[i].epoch_.store (0);
+
+      size_t buckets = 64;
+      while (buckets < size)
+        buckets <<= 1;
+
+      ACE_NEW (this->buckets_, std::atomic<Node *>[buckets]);
+      if (this->buckets_ == 0)
+        return;
+
+      for (size_t i = 0; i < buckets; ++i)
+        this->buckets_[i].store (0);
+      this->mask_ = buckets - 1;
+    }
+
+    Dispatch_Cache::~Dispatch_Cache ()
+    {
+      while (this->list_ != 0)
+        {
+          Node *node = this->list_;
+          this->list_ = node->list_next_;
+          delete node;
+        }
+
+      delete [] this->buckets_;
+    }
+
+    u_long
+    Dispatch_Cache::hash (const TAO::ObjectKey &key)
+    {
+      return ACE::hash_pjw (reinterpret_cast<const char *> (key.get_buffer ()),
+                            key.length ());
+    }
+
+    Dispatch_Cache::Reader_Slot *
+    Dispatch_Cache::enter ()
+    {
+      // Threads start probing at different slots so that they rarely
+      // meet.
+      ACE_thread_t const self = ACE_OS::thr_self ();
+      size_t const first =
+        ACE::hash_pjw (reinterpret_cast<const char *> (&self), sizeof self);
+
+      ACE_UINT64 const epoch = this->epoch_.load ();
+      for (size_t i = 0; i < READER_PROBES; ++i)
+        {
+          Reader_Slot &slot = this->slots_[(first + i) & (READER_SLOTS - 1)];
+          ACE_UINT64 free_slot = 0;
+          if (slot.epoch_.compare_exchange_strong (free_slot, epoch))
+            return &slot;
+        }
+
+      return 0;
+    }
+
+    void
+    Dispatch_Cache::leave (Reader_Slot *slot)
+    {
+      slot->epoch_.store (0, std::memory_order_release);
+    }
+
+    void
+    Dispatch_Cache::synchronize ()
+    {
+      // A reader that claimed its slot with an older epoch may have
+      // read the chains before our changes; one with this epoch or a
+      // later one cannot.  A reader that loaded an older epoch but
+      // claims its slot after we looked at it also sees our changes,
+      // all of these operations are sequentially consistent.
+      ACE_UINT64 const epoch = ++this->epoch_;
+
+      for (size_t i = 0; i < READER_SLOTS; ++i)
+        {
+          for (;;)
+            {
+              ACE_UINT64 const reader = this->slots_[i].epoch_.load ();
+              if (reader == 0 || reader >= epoch)
+                break;
+              ACE_OS::thr_yield ();
+            }
+        }
+    }
+
+    bool
+    Dispatch_Cache::find (const TAO::ObjectKey &key,
+                          TAO_Root_POA *&poa,
+                          TAO_Active_Object_Map_Entry *&entry)
+    {
+      if (this->buckets_ == 0
+          || this->suspended_.load (std::memory_order_relaxed) != 0)
+        return false;
+
+      Reader_Slot *slot = this->enter ();
+      if (slot == 0)
+        return false;
+
+      bool found = false;
+
+      // suspend() waits for readers after it sets the flag, so this
+      // check in the epoch is the one that counts.
+      if (this->suspended_.load () == 0)
+        {
+          u_long const hash = Dispatch_Cache::hash (key);
+          CORBA::ULong const length = key.length ();
+
+          for (Node *node = this->buckets_[hash & this->mask_].load ();
+               node != 0;
+               node = node->next_.load ())
+            {
+              if (node->hash_ == hash
+                  && node->key_.length () == length
+                  && ACE_OS::memcmp (node->key_.get_buffer (),
+                                     key.get_buffer (),
+                                     length) == 0)
+                {
+                  poa = node->poa_;
+                  entry = node->entry_;
+
+                  // Writers wait for us to leave before they look at
+                  // these counts.
+                  poa->increment_outstanding_requests ();
+                  ++entry->reference_count_;
+
+                  found = true;
+                  break;
+                }
+            }
+        }
+
+      this->leave (slot);
+      return found;
+    }
+
+    int
+    Dispatch_Cache::bind (const TAO::ObjectKey &key,
+                          TAO_Root_POA *poa,
+                          TAO_Active_Object_Map_Entry *entry)
+    {
+      if (this->buckets_ == 0)
+        return -1;
+
+      if (entry->dispatch_cached_)
+        return 1;
+
+      u_long const hash = Dispatch_Cache::hash (key);
+      std::atomic<Node *> &bucket = this->buckets_[hash & this->mask_];
+
+      for (Node *node = bucket.load (); node != 0; node = node->next_.load ())
+        if (node->hash_ == hash
+            && node->key_.length () == key.length ()
+            && ACE_OS::memcmp (node->key_.get_buffer (),
+                               key.get_buffer (),
+                               key.length ()) == 0)
+          return 1;
+
+      Node *node = 0;
+      ACE_NEW_RETURN (node,
+                      Node (key, hash, poa, entry),
+                      -1);
+
+      node->list_next_ = this->list_;
+      if (this->list_ != 0)
+        this->list_->list_prev_ = node;
+      this->list_ = node;
+      ++this->current_size_;
+
+      entry->dispatch_cached_ = true;
+      entry->dispatch_hash_ = hash;
+
+      // Publish the node only once it is complete.
+      node->next_.store (bucket.load ());
+      bucket.store (node);
+
+      return 0;
+    }
+
+    void
+    Dispatch_Cache::unbind (TAO_Active_Object_Map_Entry *entry)
+    {
+      if (this->buckets_ == 0 || !entry->dispatch_cached_)
+        return;
+
+      std::atomic<Node *> *link =
+        &this->buckets_[entry->dispatch_hash_ & this->mask_];
+
+      for (Node *node = link->load ();
+           node != 0;
+           link = &node->next_, node = link->load ())
+        {
+          if (node->entry_ == entry)
+            {
+              // Readers still in the chain keep following the next
+              // pointer of the node, which stays as it is.
+              link->store (node->next_.load ());
+              entry->dispatch_cached_ = false;
+              this->list_remove (node);
+
+              this->synchronize ();
+
+              delete node;
+              return;
+            }
+        }
+    }
+
+    void
+    Dispatch_Cache::flush ()
+    {
+      if (this->current_size_ == 0)
+        return;
+
+      for (size_t i = 0; i <= this->mask_; ++i)
+        this->buckets_[i].store (0);
+
+      this->synchronize ();
+
+      while (this->list_ != 0)
+        {
+          Node *node = this->list_;
+          this->list_ = node->list_next_;
+          node->entry_->dispatch_cached_ = false;
+          delete node;
+        }
+      this->current_size_ = 0;
+    }
+
+    void
+    Dispatch_Cache::suspend ()
+    {
+      ++this->suspended_;
+      this->synchronize ();
+    }
+
+    void
+    Dispatch_Cache::resume ()
+    {
+      --this->suspended_;
+    }
+
+    size_t
+    Dispatch_Cache::current_size () const
+    {
+      return this->current_size_;
+    }
+
+    void
+    Dispatch_Cache::list_remove (Node *node)
+    {
+      if (node->list_prev_ != 0)
+        node->list_prev_->list_next_ = node->list_next_;
+      else
+        this->list_ = node->list_next_;
+
+      if (node->list_next_ != 0)
+        node->list_next_->list_prev_ = node->list_prev_;
+
+      --this->current_size_;
+    }
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
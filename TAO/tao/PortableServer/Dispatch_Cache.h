@@ -0,0 +1,187 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Dispatch_Cache.h
+ *
+ *  Lookup of POAs and active objects for requests that are dispatched
+ *  without the object adapter lock.
+ */
+//=============================================================================
+
+#ifndef TAO_DISPATCH_CACHE_H
+#define TAO_DISPATCH_CACHE_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/PortableServer/portableserver_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Object_KeyC.h"
+#include "ace/Basic_Types.h"
+
+#include <atomic>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Root_POA;
+struct TAO_Active_Object_Map_Entry;
+
+namespace TAO
+{
+  namespace Portable_Server
+  {
+    /**
+     * @class Dispatch_Cache
+     *
+     * @brief Maps the object keys of requests already dispatched once
+     * to their POA and active object map entry, so that following
+     * requests for the same objects find them without the object
+     * adapter lock.
+     *
+     * A request that Servant_Upcall dispatches the ordinary way,
+     * under the object adapter lock, and that finds its servant in
+     * the active object map is added with bind().  find() looks keys
+     * up without any lock: a reader announces the epoch it started in
+     * in one of a few reader slots, walks the hash chain, and on a
+     * hit counts the request as outstanding on the POA and adds a
+     * reference to the map entry before it leaves.  From then on the
+     * usual reference counting keeps the POA and the servant alive.
+     *
+     * Everything that changes the answer, i.e. deactivating an
+     * object, destroying a POA, a POA manager leaving the active
+     * state and non-servant upcalls, first removes the affected keys
+     * (unbind(), flush()) or stops lookups (suspend()) and then waits
+     * until every reader that may still see them has left.  Readers
+     * never block, so the wait is short; after it the writer sees all
+     * the reference counts readers added and proceeds as before.  All
+     * methods other than find() must be called with the object
+     * adapter lock held.
+     */
+    class TAO_PortableServer_Export Dispatch_Cache
+    {
+    public:
+      /// Create a cache with about @a size hash buckets.
+      explicit Dispatch_Cache (size_t size);
+
+      /// Frees the nodes without touching the entries, which may
+      /// already be gone.
+      ~Dispatch_Cache ();
+
+      /**
+       * Look up @a key.  On a hit the request is added to the
+       * outstanding requests of @a poa and to the reference count of
+       * @a entry, and true is returned.  Misses, also when no reader
+       * slot is free or lookups are suspended, return false and the
+       * request is dispatched the ordinary way.
+       */
+      bool find (const TAO::ObjectKey &key,
+                 TAO_Root_POA *&poa,
+                 TAO_Active_Object_Map_Entry *&entry);
+
+      /// Add @a key for @a entry of @a poa.  Returns 1 if the key or
+      /// the entry is already cached, -1 on failure.
+      int bind (const TAO::ObjectKey &key,
+                TAO_Root_POA *poa,
+                TAO_Active_Object_Map_Entry *entry);
+
+      /// Remove the key of @a entry, if it is cached, and wait for
+      /// readers that may have found it.
+      void unbind (TAO_Active_Object_Map_Entry *entry);
+
+      /// Remove all keys and wait for readers that may have found
+      /// them.
+      void flush ();
+
+      /// Make find() miss until resume() and wait for readers that
+      /// are looking up keys.  Calls nest.
+      void suspend ();
+      void resume ();
+
+      /// Number of cached keys.
+      size_t current_size () const;
+
+    private:
+      /// One cached key.
+      struct Node
+      {
+        Node (const TAO::ObjectKey &key,
+              u_long hash,
+              TAO_Root_POA *poa,
+              TAO_Active_Object_Map_Entry *entry);
+
+        /// Next node in the hash chain, read by find().
+        std::atomic<Node *> next_;
+
+        u_long const hash_;
+        TAO::ObjectKey const key_;
+        TAO_Root_POA * const poa_;
+        TAO_Active_Object_Map_Entry * const entry_;
+
+        /// List of all nodes, used only with the object adapter lock
+        /// held.
+        Node *list_prev_;
+        Node *list_next_;
+      };
+
+      enum
+      {
+        /// Number of readers that can be in find() at the same time;
+        /// further readers miss.  Must be a power of two.
+        READER_SLOTS = 64,
+
+        /// Slots a reader tries before giving up.
+        READER_PROBES = 4,
+
+        /// Slots are padded to this size so that readers do not
+        /// share cache lines.
+        CACHE_LINE = 64
+      };
+
+      /// The epoch the reader that uses the slot started in, 0 if the
+      /// slot is free.
+      struct Reader_Slot
+      {
+        std::atomic<ACE_UINT64> epoch_;
+        char pad_[CACHE_LINE - sizeof (std::atomic<ACE_UINT64>)];
+      };
+
+      static u_long hash (const TAO::ObjectKey &key);
+
+      /// Claim a reader slot, 0 if none is free.
+      Reader_Slot *enter ();
+      void leave (Reader_Slot *slot);
+
+      /// Start a new epoch and wait until no reader of an older one
+      /// is left.
+      void synchronize ();
+
+      /// Remove @a node from the list of all nodes.
+      void list_remove (Node *node);
+
+      Reader_Slot slots_[READER_SLOTS];
+
+      std::atomic<Node *> *buckets_;
+      size_t mask_;
+
+      std::atomic<ACE_UINT64> epoch_;
+      std::atomic<unsigned long> suspended_;
+
+      /// All nodes and their number.
+      Node *list_;
+      size_t current_size_;
+
+      Dispatch_Cache (const Dispatch_Cache &) = delete;
+      Dispatch_Cache &operator= (const Dispatch_Cache &) = delete;
+    };
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_DISPATCH_CACHE_H */
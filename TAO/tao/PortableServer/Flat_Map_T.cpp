@@ -0,0 +1,549 @@
+#ifndef TAO_FLAT_MAP_T_CPP
+#define TAO_FLAT_MAP_T_CPP
+
+#include "tao/PortableServer/Flat_Map_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+
+#include <utility>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class T, class MAP>
+TAO_Flat_Map_Iterator<T, MAP>::TAO_Flat_Map_Iterator (MAP &map,
+                                                     size_t index)
+  : map_ (map),
+    index_ (index)
+{
+  while (this->index_ < this->map_.capacity_
+         && this->map_.slots_[this->index_].distance_ == 0)
+    ++this->index_;
+}
+
+template <class T, class MAP> ACE_Iterator_Impl<T> *
+TAO_Flat_Map_Iterator<T, MAP>::clone () const
+{
+  ACE_Iterator_Impl<T> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  (TAO_Flat_Map_Iterator<T, MAP>) (*this),
+                  0);
+  return temp;
+}
+
+template <class T, class MAP> int
+TAO_Flat_Map_Iterator<T, MAP>::compare (const ACE_Iterator_Impl<T> &rhs_impl) const
+{
+  const TAO_Flat_Map_Iterator<T, MAP> &rhs =
+    dynamic_cast<const TAO_Flat_Map_Iterator<T, MAP> &> (rhs_impl);
+
+  return &this->map_ == &rhs.map_ && this->index_ == rhs.index_;
+}
+
+template <class T, class MAP> T
+TAO_Flat_Map_Iterator<T, MAP>::dereference () const
+{
+  typename MAP::Slot &slot = this->map_.slots_[this->index_];
+  return T (this->map_.key_of_value_ (slot.value_), slot.value_);
+}
+
+template <class T, class MAP> void
+TAO_Flat_Map_Iterator<T, MAP>::plus_plus ()
+{
+  do
+    ++this->index_;
+  while (this->index_ < this->map_.capacity_
+         && this->map_.slots_[this->index_].distance_ == 0);
+}
+
+template <class T, class MAP> void
+TAO_Flat_Map_Iterator<T, MAP>::minus_minus ()
+{
+  while (this->index_ > 0)
+    {
+      --this->index_;
+      if (this->map_.slots_[this->index_].distance_ != 0)
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <class T, class MAP>
+TAO_Flat_Map_Reverse_Iterator<T, MAP>::TAO_Flat_Map_Reverse_Iterator (MAP &map,
+                                                                     size_t index)
+  : map_ (map),
+    index_ (index)
+{
+  while (this->index_ > 0
+         && this->map_.slots_[this->index_ - 1].distance_ == 0)
+    --this->index_;
+}
+
+template <class T, class MAP> ACE_Reverse_Iterator_Impl<T> *
+TAO_Flat_Map_Reverse_Iterator<T, MAP>::clone () const
+{
+  ACE_Reverse_Iterator_Impl<T> *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  (TAO_Flat_Map_Reverse_Iterator<T, MAP>) (*this),
+                  0);
+  return temp;
+}
+
+template <class T, class MAP> int
+TAO_Flat_Map_Reverse_Iterator<T, MAP>::compare (const ACE_Reverse_Iterator_Impl<T> &rhs_impl) const
+{
+  const TAO_Flat_Map_Reverse_Iterator<T, MAP> &rhs =
+    dynamic_cast<const TAO_Flat_Map_Reverse_Iterator<T, MAP> &> (rhs_impl);
+
+  return &this->map_ == &rhs.map_ && this->index_ == rhs.index_;
+}
+
+template <class T, class MAP> T
+TAO_Flat_Map_Reverse_Iterator<T, MAP>::dereference () const
+{
+  typename MAP::Slot &slot = this->map_.slots_[this->index_ - 1];
+  return T (this->map_.key_of_value_ (slot.value_), slot.value_);
+}
+
+template <class T, class MAP> void
+TAO_Flat_Map_Reverse_Iterator<T, MAP>::plus_plus ()
+{
+  do
+    --this->index_;
+  while (this->index_ > 0
+         && this->map_.slots_[this->index_ - 1].distance_ == 0);
+}
+
+template <class T, class MAP> void
+TAO_Flat_Map_Reverse_Iterator<T, MAP>::minus_minus ()
+{
+  while (this->index_ < this->map_.capacity_)
+    {
+      ++this->index_;
+      if (this->map_.slots_[this->index_ - 1].distance_ != 0)
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR>
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::TAO_Flat_Map (size_t size,
+                                                                                           ACE_Allocator *alloc)
+  : slots_ (0),
+    capacity_ (0),
+    current_size_ (0)
+{
+  if (this->open (size, alloc) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("TAO_Flat_Map\n")));
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR>
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::~TAO_Flat_Map ()
+{
+  this->close ();
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::open (size_t length,
+                                                                                   ACE_Allocator *)
+{
+  this->close ();
+
+  // Enough slots for length entries below the maximum load.
+  size_t capacity = 16;
+  while (capacity / 8 * 7 < length)
+    capacity <<= 1;
+
+  return this->resize (capacity);
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::close ()
+{
+  delete [] this->slots_;
+  this->slots_ = 0;
+  this->capacity_ = 0;
+  this->current_size_ = 0;
+  return 0;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> ACE_UINT32
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::hash (const KEY &key) const
+{
+  ACE_UINT64 h = this->hash_key_ (key);
+
+  // Object id hashes of counters and servant addresses differ mostly
+  // in a few bits; spread them over the slot index.
+  h ^= h >> 33;
+  h *= ACE_UINT64_LITERAL (0xff51afd7ed558ccd);
+  h ^= h >> 33;
+
+  return static_cast<ACE_UINT32> (h);
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> ssize_t
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::lookup (const KEY &key,
+                                                                                     ACE_UINT32 hash) const
+{
+  if (this->current_size_ == 0)
+    return -1;
+
+  size_t const mask = this->capacity_ - 1;
+  size_t index = hash & mask;
+
+  // A key further from its slot than the one we look at would have
+  // displaced it, so the search stops there.
+  for (ACE_UINT32 distance = 1; ; ++distance)
+    {
+      const Slot &slot = this->slots_[index];
+
+      if (slot.distance_ < distance)
+        return -1;
+
+      if (slot.hash_ == hash
+          && this->compare_keys_ (this->key_of_value_ (slot.value_), key))
+        return static_cast<ssize_t> (index);
+
+      index = (index + 1) & mask;
+    }
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::insert (const VALUE &value,
+                                                                                     ACE_UINT32 hash)
+{
+  if ((this->current_size_ + 1) > this->capacity_ / 8 * 7
+      && this->resize (this->capacity_ * 2) == -1)
+    return -1;
+
+  size_t const mask = this->capacity_ - 1;
+  size_t index = hash & mask;
+
+  Slot moving;
+  moving.value_ = value;
+  moving.hash_ = hash;
+  moving.distance_ = 1;
+
+  // Take the slot of any entry that is closer to its own slot than
+  // we are to ours, and carry that entry on.
+  for (;;)
+    {
+      Slot &slot = this->slots_[index];
+
+      if (slot.distance_ == 0)
+        {
+          slot = moving;
+          break;
+        }
+
+      if (slot.distance_ < moving.distance_)
+        std::swap (slot, moving);
+
+      index = (index + 1) & mask;
+      ++moving.distance_;
+    }
+
+  ++this->current_size_;
+  return 0;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> void
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::erase (size_t index)
+{
+  size_t const mask = this->capacity_ - 1;
+  size_t next = (index + 1) & mask;
+
+  while (this->slots_[next].distance_ > 1)
+    {
+      this->slots_[index] = this->slots_[next];
+      --this->slots_[index].distance_;
+      index = next;
+      next = (next + 1) & mask;
+    }
+
+  this->slots_[index].value_ = VALUE ();
+  this->slots_[index].distance_ = 0;
+  --this->current_size_;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::resize (size_t capacity)
+{
+  Slot *slots = 0;
+  ACE_NEW_RETURN (slots,
+                  Slot[capacity],
+                  -1);
+
+  for (size_t i = 0; i < capacity; ++i)
+    {
+      slots[i].value_ = VALUE ();
+      slots[i].hash_ = 0;
+      slots[i].distance_ = 0;
+    }
+
+  Slot *const old_slots = this->slots_;
+  size_t const old_capacity = this->capacity_;
+
+  this->slots_ = slots;
+  this->capacity_ = capacity;
+  this->current_size_ = 0;
+
+  for (size_t i = 0; i < old_capacity; ++i)
+    if (old_slots[i].distance_ != 0)
+      this->insert (old_slots[i].value_, old_slots[i].hash_);
+
+  delete [] old_slots;
+  return 0;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::bind (const KEY &key,
+                                                                                   const VALUE &value)
+{
+  if (this->slots_ == 0
+      || !this->compare_keys_ (this->key_of_value_ (value), key))
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ACE_UINT32 const hash = this->hash (key);
+
+  if (this->lookup (key, hash) != -1)
+    return 1;
+
+  return this->insert (value, hash);
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::bind_modify_key (const VALUE &value,
+                                                                                              KEY &key)
+{
+  return this->bind (key, value);
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::create_key (KEY &key)
+{
+  // Invoke the user specified key generation functor.
+  return this->key_generator_ (key);
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::bind_create_key (const VALUE &value,
+                                                                                              KEY &key)
+{
+  // Invoke the user specified key generation functor.
+  int result = this->key_generator_ (key);
+
+  if (result == 0)
+    {
+      // Try to add.
+      result = this->bind (key, value);
+    }
+
+  return result;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::bind_create_key (const VALUE &)
+{
+  errno = ENOTSUP;
+  return -1;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::recover_key (const KEY &modified_key,
+                                                                                          KEY &original_key)
+{
+  original_key = modified_key;
+  return 0;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::rebind (const KEY &key,
+                                                                                     const VALUE &value)
+{
+  VALUE old_value;
+  return this->rebind (key, value, old_value);
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::rebind (const KEY &key,
+                                                                                     const VALUE &value,
+                                                                                     VALUE &old_value)
+{
+  if (this->slots_ == 0
+      || !this->compare_keys_ (this->key_of_value_ (value), key))
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ACE_UINT32 const hash = this->hash (key);
+  ssize_t const index = this->lookup (key, hash);
+
+  if (index == -1)
+    return this->insert (value, hash);
+
+  old_value = this->slots_[index].value_;
+  this->slots_[index].value_ = value;
+  return 1;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::rebind (const KEY &key,
+                                                                                     const VALUE &value,
+                                                                                     KEY &old_key,
+                                                                                     VALUE &old_value)
+{
+  int const result = this->rebind (key, value, old_value);
+
+  if (result == 1)
+    old_key = key;
+
+  return result;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::trybind (const KEY &key,
+                                                                                      VALUE &value)
+{
+  if (this->slots_ == 0
+      || !this->compare_keys_ (this->key_of_value_ (value), key))
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ACE_UINT32 const hash = this->hash (key);
+  ssize_t const index = this->lookup (key, hash);
+
+  if (index == -1)
+    return this->insert (value, hash);
+
+  value = this->slots_[index].value_;
+  return 1;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::find (const KEY &key,
+                                                                                   VALUE &value)
+{
+  ssize_t const index = this->lookup (key, this->hash (key));
+
+  if (index == -1)
+    return -1;
+
+  value = this->slots_[index].value_;
+  return 0;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::find (const KEY &key)
+{
+  return this->lookup (key, this->hash (key)) == -1 ? -1 : 0;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::unbind (const KEY &key)
+{
+  VALUE value;
+  return this->unbind (key, value);
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> int
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::unbind (const KEY &key,
+                                                                                     VALUE &value)
+{
+  ssize_t const index = this->lookup (key, this->hash (key));
+
+  if (index == -1)
+    return -1;
+
+  value = this->slots_[index].value_;
+  this->erase (static_cast<size_t> (index));
+  return 0;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> size_t
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::current_size () const
+{
+  return this->current_size_;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> size_t
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::total_size () const
+{
+  return this->capacity_;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> void
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("current_size_ = %B\ncapacity_ = %B\n"),
+                 this->current_size_,
+                 this->capacity_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> KEY_GENERATOR &
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::key_generator ()
+{
+  return this->key_generator_;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> ACE_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::begin_impl ()
+{
+  ACE_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  iterator_impl (*this, 0),
+                  0);
+  return temp;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> ACE_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::end_impl ()
+{
+  ACE_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  iterator_impl (*this, this->capacity_),
+                  0);
+  return temp;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> ACE_Reverse_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::rbegin_impl ()
+{
+  ACE_Reverse_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  reverse_iterator_impl (*this, this->capacity_),
+                  0);
+  return temp;
+}
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR> ACE_Reverse_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *
+TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>::rend_impl ()
+{
+  ACE_Reverse_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *temp = 0;
+  ACE_NEW_RETURN (temp,
+                  reverse_iterator_impl (*this, 0),
+                  0);
+  return temp;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_FLAT_MAP_T_CPP */
@@ -0,0 +1,294 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Flat_Map_T.h
+ *
+ *  Open addressing map for the active object map.
+ */
+//=============================================================================
+
+#ifndef TAO_FLAT_MAP_T_H
+#define TAO_FLAT_MAP_T_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/orbconf.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Map_T.h"
+#include "ace/Basic_Types.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR>
+class TAO_Flat_Map;
+
+/**
+ * @class TAO_Flat_Map_Iterator
+ *
+ * @brief Defines a iterator implementation for the TAO_Flat_Map.
+ */
+template <class T, class MAP>
+class TAO_Flat_Map_Iterator : public ACE_Iterator_Impl<T>
+{
+public:
+  /// Constructor, starts at the first used slot at or after
+  /// @a index.
+  TAO_Flat_Map_Iterator (MAP &map, size_t index);
+
+  /// Clone.
+  virtual ACE_Iterator_Impl<T> *clone () const;
+
+  /// Comparison.
+  virtual int compare (const ACE_Iterator_Impl<T> &rhs) const;
+
+  /// Dereference.
+  virtual T dereference () const;
+
+  /// Advance.
+  virtual void plus_plus ();
+
+  /// Reverse.
+  virtual void minus_minus ();
+
+protected:
+  MAP &map_;
+
+  /// Current slot, the capacity of the map at the end.
+  size_t index_;
+};
+
+/**
+ * @class TAO_Flat_Map_Reverse_Iterator
+ *
+ * @brief Defines a reverse iterator implementation for the
+ * TAO_Flat_Map.
+ */
+template <class T, class MAP>
+class TAO_Flat_Map_Reverse_Iterator : public ACE_Reverse_Iterator_Impl<T>
+{
+public:
+  /// Constructor, starts at the last used slot before @a index.
+  TAO_Flat_Map_Reverse_Iterator (MAP &map, size_t index);
+
+  /// Clone.
+  virtual ACE_Reverse_Iterator_Impl<T> *clone () const;
+
+  /// Comparison.
+  virtual int compare (const ACE_Reverse_Iterator_Impl<T> &rhs) const;
+
+  /// Dereference.
+  virtual T dereference () const;
+
+  /// Advance.
+  virtual void plus_plus ();
+
+  /// Reverse.
+  virtual void minus_minus ();
+
+protected:
+  MAP &map_;
+
+  /// One past the current slot, 0 at the end.
+  size_t index_;
+};
+
+/**
+ * @class TAO_Flat_Map
+ *
+ * @brief Map that keeps its values in a single array, with Robin Hood
+ * open addressing.
+ *
+ * The map is meant for values that contain their own key, like the
+ * entries of the active object map do: it stores only the value and
+ * the hash of the key in each slot and uses @c KEY_OF_VALUE to get
+ * the key back from the value.  So there is no allocation per entry
+ * and no second copy of the keys, and a lookup touches one or two
+ * adjacent slots and the value it finds.  Keys must therefore not
+ * change while their value is in the map, and bind() fails unless
+ * the key given is the one of the value.
+ *
+ * The table doubles when it is 7/8 full.  Removal shifts the
+ * following slots back instead of leaving tombstones, so lookups
+ * stay short as objects come and go.
+ */
+template <class KEY, class VALUE, class KEY_OF_VALUE, class HASH_KEY, class COMPARE_KEYS, class KEY_GENERATOR>
+class TAO_Flat_Map : public ACE_Map<KEY, VALUE>
+{
+public:
+  typedef TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR>
+          self_type;
+  typedef TAO_Flat_Map_Iterator<ACE_Reference_Pair<const KEY, VALUE>, self_type>
+          iterator_impl;
+  typedef TAO_Flat_Map_Reverse_Iterator<ACE_Reference_Pair<const KEY, VALUE>, self_type>
+          reverse_iterator_impl;
+
+  friend class TAO_Flat_Map_Iterator<ACE_Reference_Pair<const KEY, VALUE>, self_type>;
+  friend class TAO_Flat_Map_Reverse_Iterator<ACE_Reference_Pair<const KEY, VALUE>, self_type>;
+
+  /// Initialize with room for @a size entries.
+  TAO_Flat_Map (size_t size = ACE_DEFAULT_MAP_SIZE,
+                ACE_Allocator *alloc = nullptr);
+
+  /// Close down and release dynamically allocated resources.
+  virtual ~TAO_Flat_Map ();
+
+  /// Initialize a Map with room for @a length entries.  The allocator
+  /// is not used.
+  virtual int open (size_t length = ACE_DEFAULT_MAP_SIZE,
+                    ACE_Allocator *alloc = nullptr);
+
+  /// Close down a Map and release dynamically allocated resources.
+  virtual int close ();
+
+  /// Add @a key / @a value pair to the map.  Returns 1 if @a key is
+  /// already in the map, -1 if it is not the key of @a value or on
+  /// failure.
+  virtual int bind (const KEY &key,
+                    const VALUE &value);
+
+  /// Same as bind(), the key is not modified.
+  virtual int bind_modify_key (const VALUE &value,
+                               KEY &key);
+
+  /// Produce a key with the @c KEY_GENERATOR.
+  virtual int create_key (KEY &key);
+
+  /// Produce a key with the @c KEY_GENERATOR and bind @a value with
+  /// it.  @a key has to be the one @c KEY_OF_VALUE returns for
+  /// @a value.
+  virtual int bind_create_key (const VALUE &value,
+                               KEY &key);
+
+  /// Not supported, the value has to hold the key produced.
+  virtual int bind_create_key (const VALUE &value);
+
+  /// Recovers the original key, which is the same.
+  virtual int recover_key (const KEY &modified_key,
+                           KEY &original_key);
+
+  /// Reassociate @a key with @a value, or add it.  Returns 1 if
+  /// @a key was in the map.
+  virtual int rebind (const KEY &key,
+                      const VALUE &value);
+
+  /// Reassociate @a key with @a value, or add it, storing the old
+  /// value into @a old_value.
+  virtual int rebind (const KEY &key,
+                      const VALUE &value,
+                      VALUE &old_value);
+
+  /// Reassociate @a key with @a value, or add it, storing the old
+  /// key and value into @a old_key and @a old_value.
+  virtual int rebind (const KEY &key,
+                      const VALUE &value,
+                      KEY &old_key,
+                      VALUE &old_value);
+
+  /// Associate @a key with @a value if and only if @a key is not in
+  /// the map, else return the value in the map through @a value and
+  /// 1.
+  virtual int trybind (const KEY &key,
+                       VALUE &value);
+
+  /// Locate @a value associated with @a key.
+  virtual int find (const KEY &key,
+                    VALUE &value);
+
+  /// Is @a key in the map?
+  virtual int find (const KEY &key);
+
+  /// Remove @a key from the map.
+  virtual int unbind (const KEY &key);
+
+  /// Remove @a key from the map, and return the @a value associated
+  /// with @a key.
+  virtual int unbind (const KEY &key,
+                      VALUE &value);
+
+  /// Return the current size of the map.
+  virtual size_t current_size () const;
+
+  /// Return the number of slots of the map.
+  virtual size_t total_size () const;
+
+  /// Dump the state of an object.
+  virtual void dump () const;
+
+  /// Accessor to key generator.
+  KEY_GENERATOR &key_generator ();
+
+protected:
+  /// One slot of the table.
+  struct Slot
+  {
+    VALUE value_;
+
+    /// Hash of the key of the value.
+    ACE_UINT32 hash_;
+
+    /// Distance of the slot from the one the hash points to plus
+    /// one, 0 if the slot is free.
+    ACE_UINT32 distance_;
+  };
+
+  /// Hash of @a key, mixed so that the low bits that select the slot
+  /// depend on all of it.
+  ACE_UINT32 hash (const KEY &key) const;
+
+  /// Slot that holds @a key, or -1.
+  ssize_t lookup (const KEY &key, ACE_UINT32 hash) const;
+
+  /// Add @a value, which is not in the map yet.
+  int insert (const VALUE &value, ACE_UINT32 hash);
+
+  /// Free @a index and move the slots after it back.
+  void erase (size_t index);
+
+  /// Move the values into a table of @a capacity slots.
+  int resize (size_t capacity);
+
+  /// Return forward iterator.
+  virtual ACE_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *begin_impl ();
+  virtual ACE_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *end_impl ();
+
+  /// Return reverse iterator.
+  virtual ACE_Reverse_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *rbegin_impl ();
+  virtual ACE_Reverse_Iterator_Impl<ACE_Reference_Pair<const KEY, VALUE> > *rend_impl ();
+
+  Slot *slots_;
+
+  /// Number of slots, a power of two.
+  size_t capacity_;
+
+  size_t current_size_;
+
+  KEY_OF_VALUE key_of_value_;
+  HASH_KEY hash_key_;
+  COMPARE_KEYS compare_keys_;
+
+  /// Functor class used for generating key.
+  KEY_GENERATOR key_generator_;
+
+private:
+  void operator= (const TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR> &) = delete;
+  TAO_Flat_Map (const TAO_Flat_Map<KEY, VALUE, KEY_OF_VALUE, HASH_KEY, COMPARE_KEYS, KEY_GENERATOR> &) = delete;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "tao/PortableServer/Flat_Map_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Flat_Map_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_FLAT_MAP_T_H */
@@ -1,6 +1,7 @@
 #include "tao/PortableServer/Non_Servant_Upcall.h"
 #include "tao/PortableServer/Object_Adapter.h"
 #include "tao/PortableServer/Root_POA.h"
+#include "tao/PortableServer/Dispatch_Cache.h"
 
 #if !defined (__ACE_INLINE__)
 # include "tao/PortableServer/Non_Servant_Upcall.inl"
@@ -18,7 +19,14 @@ namespace TAO
         previous_ (0)
     {
       // Check if this is a nested non_servant_upcall.
-      if (this->object_adapter_.non_servant_upcall_nesting_level_ != 0)
+      if (this->object_adapter_.non_servant_upcall_nesting_level_ == 0)
+        {
+          // Servant upcalls wait for us, also those that would not
+          // need the lock.
+          if (this->object_adapter_.dispatch_cache () != 0)
+            this->object_adapter_.dispatch_cache ()->suspend ();
+        }
+      else
         {
           // Remember previous instance of non_servant_upcall.
           this->previous_ =
@@ -61,6 +69,9 @@ namespace TAO
           this->object_adapter_.non_servant_upcall_thread_ =
             ACE_OS::NULL_thread;
 
+          if (this->object_adapter_.dispatch_cache () != 0)
+            this->object_adapter_.dispatch_cache ()->resume ();
+
           // Check if all pending requests are over.
           if (this->poa_.waiting_destruction () &&
             this->poa_.outstanding_requests () == 0)
@@ -2,6 +2,7 @@
 #include "tao/PortableServer/Object_Adapter.h"
 #include "tao/PortableServer/Non_Servant_Upcall.h"
 #include "tao/PortableServer/Servant_Upcall.h"
+#include "tao/PortableServer/Dispatch_Cache.h"
 #include "tao/PortableServer/Root_POA.h"
 #include "tao/PortableServer/Regular_POA.h"
 #include "tao/PortableServer/Creation_Time.h"
@@ -144,6 +145,7 @@ TAO_Object_Adapter::TAO_Object_Adapter (const TAO_Server_Strategy_Factory::Activ
     thread_lock_ (),
     lock_ (TAO_Object_Adapter::create_lock (thread_lock_)),
     reverse_lock_ (*lock_),
+    dispatch_cache_ (0),
     non_servant_upcall_condition_ (thread_lock_),
     non_servant_upcall_in_progress_ (0),
     non_servant_upcall_nesting_level_ (0),
@@ -228,6 +230,11 @@ TAO_Object_Adapter::TAO_Object_Adapter (const TAO_Server_Strategy_Factory::Activ
   this->hint_strategy_ = new_hint_strategy.release ();
   this->persistent_poa_name_map_ = new_persistent_poa_name_map.release ();
   this->transient_poa_map_ = new_transient_poa_map.release ();
+
+  if (creation_parameters.use_dispatch_cache_)
+    ACE_NEW (this->dispatch_cache_,
+             TAO::Portable_Server::Dispatch_Cache (
+               creation_parameters.active_object_map_size_));
 }
 
 void
@@ -286,6 +293,7 @@ TAO_Object_Adapter::~TAO_Object_Adapter ()
   delete this->persistent_poa_name_map_;
   delete this->transient_poa_map_;
   delete this->lock_;
+  delete this->dispatch_cache_;
 
   delete this->servant_dispatcher_;
 
@@ -57,6 +57,7 @@ namespace TAO
   {
     class Non_Servant_Upcall;
     class Servant_Upcall;
+    class Dispatch_Cache;
     class POA_Current_Impl;
     class Temporary_Creation_Time;
   }
@@ -118,6 +119,10 @@ public:
 
   ACE_Reverse_Lock<ACE_Lock> &reverse_lock ();
 
+  /// Cache for dispatching requests without the lock, 0 unless
+  /// enabled with -ORBPOADispatchCache.
+  TAO::Portable_Server::Dispatch_Cache *dispatch_cache () const;
+
   /// Access the root poa.
   TAO_Root_POA *root_poa () const;
 
@@ -368,6 +373,8 @@ protected:
 
   ACE_Reverse_Lock<ACE_Lock> reverse_lock_;
 
+  TAO::Portable_Server::Dispatch_Cache *dispatch_cache_;
+
 public:
   /**
    * @class poa_name_iterator
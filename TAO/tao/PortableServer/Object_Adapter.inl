@@ -34,6 +34,12 @@ TAO_Object_Adapter::reverse_lock ()
   return this->reverse_lock_;
 }
 
+ACE_INLINE TAO::Portable_Server::Dispatch_Cache *
+TAO_Object_Adapter::dispatch_cache () const
+{
+  return this->dispatch_cache_;
+}
+
 /* static */
 ACE_INLINE CORBA::ULong
 TAO_Object_Adapter::transient_poa_name_size ()
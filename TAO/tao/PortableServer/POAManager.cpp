@@ -1,6 +1,7 @@
 #include "tao/PortableServer/POAManager.h"
 #include "tao/PortableServer/POAManagerFactory.h"
 #include "tao/PortableServer/Root_POA.h"
+#include "tao/PortableServer/Dispatch_Cache.h"
 #include "tao/PortableServer/poa_macros.h"
 #include "tao/Server_Strategy_Factory.h"
 #include "tao/ORB_Core.h"
@@ -104,6 +105,10 @@ TAO_POA_Manager::deactivate_i (CORBA::Boolean etherealize_objects,
       this->state_ = PortableServer::POAManager::INACTIVE;
     }
 
+  // Requests must go through check_state() again.
+  if (this->object_adapter_.dispatch_cache () != 0)
+    this->object_adapter_.dispatch_cache ()->flush ();
+
   // After changing the state, if the etherealize_objects parameter is:
   //
   // a) TRUE - the POA manager will cause all associated POAs that
@@ -191,6 +196,10 @@ TAO_POA_Manager::hold_requests_i (CORBA::Boolean wait_for_completion)
       this->state_ = PortableServer::POAManager::HOLDING;
     }
 
+  // Requests must go through check_state() again.
+  if (this->object_adapter_.dispatch_cache () != 0)
+    this->object_adapter_.dispatch_cache ()->flush ();
+
   // If the wait_for_completion parameter is FALSE, this operation
   // returns immediately after changing the state. If the parameter is
   // TRUE and the current thread is not in an invocation context
@@ -241,6 +250,10 @@ TAO_POA_Manager::discard_requests_i (CORBA::Boolean wait_for_completion)
       this->state_ = PortableServer::POAManager::DISCARDING;
     }
 
+  // Requests must go through check_state() again.
+  if (this->object_adapter_.dispatch_cache () != 0)
+    this->object_adapter_.dispatch_cache ()->flush ();
+
   // If the wait_for_completion parameter is FALSE, this operation
   // returns immediately after changing the state. If the
   // parameter is TRUE and the current thread is not in an
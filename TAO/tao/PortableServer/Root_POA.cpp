@@ -16,6 +16,7 @@
 #include "tao/PortableServer/Servant_Upcall.h"
 #include "tao/PortableServer/AdapterActivatorC.h"
 #include "tao/PortableServer/Non_Servant_Upcall.h"
+#include "tao/PortableServer/Dispatch_Cache.h"
 #include "tao/PortableServer/POAManager.h"
 #include "tao/PortableServer/POAManagerFactory.h"
 #include "tao/PortableServer/ServantManagerC.h"
@@ -811,6 +812,11 @@ TAO_Root_POA::destroy_i (CORBA::Boolean etherealize_objects,
 
   this->cleanup_in_progress_ = true;
 
+  // Requests must not reach this POA without the lock any more, and
+  // the ones that did are counted in <outstanding_requests_> now.
+  if (this->object_adapter ().dispatch_cache () != 0)
+    this->object_adapter ().dispatch_cache ()->flush ();
+
   // Inform the custom servant dispatching strategy to stop the working
   // threads when the poa is destroyed.
   this->poa_deactivated_hook ();
@@ -55,6 +55,8 @@
 #include "ace/Recursive_Thread_Mutex.h"
 #include "ace/Null_Mutex.h"
 
+#include <atomic>
+
 // This is to remove "inherits via dominance" warnings from MSVC.
 // MSVC is being a little too paranoid.
 #if defined(_MSC_VER)
@@ -92,6 +94,7 @@ namespace TAO
   namespace Portable_Server
   {
     class Servant_Upcall;
+    class Dispatch_Cache;
     class POA_Current_Impl;
     class Temporary_Creation_Time;
   }
@@ -118,6 +121,7 @@ public:
   friend class TAO_Object_Adapter;
   friend class TAO::Portable_Server::Servant_Upcall;
   friend class TAO::Portable_Server::Non_Servant_Upcall;
+  friend class TAO::Portable_Server::Dispatch_Cache;
   friend class TAO_POA_Manager;
   friend class TAO_RT_Collocation_Resolver;
   friend class TAO_IORInfo;
@@ -735,7 +739,10 @@ protected:
 
   CORBA::Boolean cleanup_in_progress_;
 
-  CORBA::ULong outstanding_requests_;
+  /// Requests in progress.  Requests dispatched through the
+  /// TAO::Portable_Server::Dispatch_Cache change it without the object
+  /// adapter lock, except for the last one.
+  std::atomic<CORBA::ULong> outstanding_requests_;
 
   TAO_SYNCH_CONDITION outstanding_requests_condition_;
 
@@ -15,6 +15,7 @@
 #include "tao/PortableServer/Root_POA.h"
 #include "tao/PortableServer/Active_Object_Map.h"
 #include "tao/PortableServer/Active_Object_Map_Entry.h"
+#include "tao/PortableServer/Dispatch_Cache.h"
 
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
 #include "ace/Monitor_Size.h"
@@ -87,6 +88,13 @@ namespace TAO
     ServantRetentionStrategyRetain::deactivate_map_entry (
       TAO_Active_Object_Map_Entry *active_object_map_entry)
     {
+      // Stop lock free dispatching to the servant; once this returns
+      // the reference count includes all requests that found it.
+      TAO::Portable_Server::Dispatch_Cache *dispatch_cache =
+        this->poa_->object_adapter ().dispatch_cache ();
+      if (dispatch_cache != 0)
+        dispatch_cache->unbind (active_object_map_entry);
+
       // Decrement the reference count.
       CORBA::UShort const new_count = --active_object_map_entry->reference_count_;
 
@@ -4,6 +4,7 @@
 #include "tao/PortableServer/Default_Servant_Dispatcher.h"
 #include "tao/PortableServer/Collocated_Object_Proxy_Broker.h"
 #include "tao/PortableServer/Active_Object_Map_Entry.h"
+#include "tao/PortableServer/Dispatch_Cache.h"
 #include "tao/PortableServer/ForwardRequestC.h"
 
 // -- TAO Include --
@@ -19,6 +20,23 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+namespace
+{
+  /// Decrement @a count unless that would make it zero; the last
+  /// decrement has to be made with the object adapter lock held.
+  template <typename T>
+  bool
+  decrement_unless_last (std::atomic<T> &count)
+  {
+    T current = count.load ();
+    while (current > 1)
+      if (count.compare_exchange_weak (current,
+                                       static_cast<T> (current - 1)))
+        return true;
+    return false;
+  }
+}
+
 namespace TAO
 {
   namespace Portable_Server
@@ -35,7 +53,8 @@ namespace TAO
         cookie_ (0),
         operation_ (0),
 #endif /* TAO_HAS_MINIMUM_POA == 0 */
-        active_object_map_entry_ (0)
+        active_object_map_entry_ (0),
+        dispatch_cached_ (false)
     {
       TAO_Object_Adapter *object_adapter =
         dynamic_cast<TAO_Object_Adapter *>(oc->poa_adapter ());
@@ -48,6 +67,11 @@ namespace TAO
       const char *operation,
       CORBA::Object_out forward_to)
     {
+      // Requests for objects that were dispatched before may not need
+      // the object adapter lock at all.
+      if (this->prepare_for_cached_upcall (key))
+        return TAO_Adapter::DS_OK;
+
       while (1)
         {
           bool wait_occurred_restart_call = false;
@@ -148,6 +172,18 @@ namespace TAO
       if (this->active_object_map_entry ())
         this->current_context_.priority (this->active_object_map_entry ()->priority_);
 
+      // Let the next requests for this object skip the lock.  Only
+      // servants from the active object map are cached, the others
+      // need the POA for every request.
+      TAO::Portable_Server::Dispatch_Cache *dispatch_cache =
+        this->object_adapter_->dispatch_cache ();
+      if (dispatch_cache != 0
+          && this->state_ == POA_CURRENT_SETUP
+          && this->active_object_map_entry_ != 0
+          && !this->active_object_map_entry_->deactivated_
+          && !this->poa_->cleanup_in_progress_)
+        dispatch_cache->bind (key, this->poa_, this->active_object_map_entry_);
+
       if (this->state_ != OBJECT_ADAPTER_LOCK_RELEASED)
         {
           // Release the object adapter lock.
@@ -168,6 +204,41 @@ namespace TAO
       return TAO_Adapter::DS_OK;
     }
 
+    bool
+    Servant_Upcall::prepare_for_cached_upcall (const TAO::ObjectKey &key)
+    {
+      TAO::Portable_Server::Dispatch_Cache *dispatch_cache =
+        this->object_adapter_->dispatch_cache ();
+
+      if (dispatch_cache == 0
+          || !dispatch_cache->find (key,
+                                    this->poa_,
+                                    this->active_object_map_entry_))
+        return false;
+
+      // find() counted the request on the POA and the servant, which
+      // is where prepare_for_upcall_i() releases the object adapter
+      // lock.  The cleanup is the same from here on.
+      this->dispatch_cached_ = true;
+      this->state_ = OBJECT_ADAPTER_LOCK_RELEASED;
+
+      this->current_context_.setup (this->poa_, key);
+      this->current_context_.object_id (
+        this->active_object_map_entry_->user_id_);
+      this->user_id_ = &this->current_context_.object_id ();
+      this->system_id_ = this->active_object_map_entry_->system_id_;
+
+      this->servant_ = this->active_object_map_entry_->servant_;
+      this->current_context_.servant (this->servant_);
+      this->current_context_.priority (
+        this->active_object_map_entry_->priority_);
+
+      this->single_threaded_poa_setup ();
+      this->state_ = SERVANT_LOCK_ACQUIRED;
+
+      return true;
+    }
+
     void
     Servant_Upcall::pre_invoke_remote_request (TAO_ServerRequest &req)
     {
@@ -249,6 +320,14 @@ namespace TAO
           // state, it is ok to call it outside the lock.
           this->post_invoke_servant_cleanup ();
 
+          // Requests from the dispatch cache only need the lock for the
+          // last references.
+          if (this->dispatch_cached_ && this->cached_upcall_cleanup ())
+            {
+              this->current_context_.teardown ();
+              break;
+            }
+
           // Since the object adapter lock was released, we must acquire
           // it.
           //
@@ -367,6 +446,22 @@ namespace TAO
         }
     }
 
+    bool
+    Servant_Upcall::cached_upcall_cleanup ()
+    {
+      if (this->active_object_map_entry_ != 0)
+        {
+          if (!decrement_unless_last (
+                 this->active_object_map_entry_->reference_count_))
+            return false;
+
+          // Released, servant_cleanup() has nothing left to do.
+          this->active_object_map_entry_ = 0;
+        }
+
+      return decrement_unless_last (this->poa_->outstanding_requests_);
+    }
+
     void
     Servant_Upcall::poa_cleanup ()
     {
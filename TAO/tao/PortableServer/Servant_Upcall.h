@@ -106,6 +106,11 @@ namespace TAO
                                 CORBA::Object_out forward_to,
                                 bool &wait_occurred_restart_call);
 
+      /// Locate POA and servant through the dispatch cache of the
+      /// object adapter, without its lock.  Returns false if the key
+      /// is not cached.
+      bool prepare_for_cached_upcall (const TAO::ObjectKey &key);
+
       /// Run pre_invoke for a remote request.
       void pre_invoke_remote_request (TAO_ServerRequest &req);
 
@@ -185,6 +190,12 @@ namespace TAO
       void servant_cleanup ();
       void poa_cleanup ();
 
+      /// Release the references of a request dispatched through the
+      /// dispatch cache without the object adapter lock.  Returns
+      /// false if the last reference to the servant or the last
+      /// outstanding request of the POA is left, those need the lock.
+      bool cached_upcall_cleanup ();
+
       /// Clean-up / reset state of this Servant_Upcall object.
       void upcall_cleanup ();
 
@@ -221,6 +232,9 @@ namespace TAO
       /// Preinvoke data for the upcall.
       Pre_Invoke_State pre_invoke_state_;
 
+      /// Whether the POA and servant came from the dispatch cache.
+      bool dispatch_cached_;
+
     private:
       Servant_Upcall (const Servant_Upcall &);
       void operator= (const Servant_Upcall &);
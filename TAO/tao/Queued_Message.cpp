@@ -93,4 +93,16 @@ TAO_Queued_Message::is_expired (const ACE_Time_Value &) const
   return false;
 }
 
+size_t
+TAO_Queued_Message::message_count () const
+{
+  return 1;
+}
+
+bool
+TAO_Queued_Message::append (const ACE_Message_Block *, ACE_Time_Value *)
+{
+  return false;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
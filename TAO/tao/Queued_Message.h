@@ -208,6 +208,20 @@ public:
    * This parameter must not be modified (through const_cast).
    */
   virtual void copy_if_necessary (const ACE_Message_Block* chain) = 0;
+
+  /// Number of GIOP messages held, 1 unless messages were appended.
+  virtual size_t message_count () const;
+
+  /// Append a copy of @a contents to the data still to be sent, so
+  /// that both go out in the same write.
+  /**
+   * @param timeout The relative timeout of @a contents, messages with
+   *  a timeout are never appended.
+   * @return false if the message cannot be appended, the caller
+   *  must then queue it on its own.
+   */
+  virtual bool append (const ACE_Message_Block *contents,
+                       ACE_Time_Value *timeout);
   //@}
 
 protected:
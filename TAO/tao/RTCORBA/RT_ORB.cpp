@@ -16,7 +16,8 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 TAO_RT_ORB::TAO_RT_ORB (TAO_ORB_Core *orb_core,
                         TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
-                        ACE_Time_Value const &dynamic_thread_time)
+                        ACE_Time_Value const &dynamic_thread_time,
+                        const char *lane_cpus)
   : orb_core_ (orb_core),
     mutex_mgr_ (),
     tp_manager_ (0),
@@ -34,6 +35,14 @@ TAO_RT_ORB::TAO_RT_ORB (TAO_ORB_Core *orb_core,
 
   this->tp_manager_ =
     &rt_thread_lane_resources_manager->tp_manager ();
+
+  if (this->tp_manager_->lane_cpus (lane_cpus) != 0)
+    {
+      TAOLIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("TAO (%P|%t) - RT_ORB, invalid lane CPUs <%C>\n"),
+                     lane_cpus));
+      throw CORBA::BAD_PARAM ();
+    }
 }
 
 TAO_RT_ORB::~TAO_RT_ORB ()
@@ -93,7 +93,8 @@ public:
   /// Constructor.
   TAO_RT_ORB (TAO_ORB_Core *orb_core,
               TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
-              ACE_Time_Value const &dynamic_thread_time);
+              ACE_Time_Value const &dynamic_thread_time,
+              const char *lane_cpus);
 
   /**
    * Create a new mutex.  Mutexes returned by this method
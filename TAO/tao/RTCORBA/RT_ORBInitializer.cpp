@@ -49,14 +49,16 @@ TAO_RT_ORBInitializer::TAO_RT_ORBInitializer (int priority_mapping_type,
                                               long sched_policy,
                                               long scope_policy,
                                               TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
-                                              ACE_Time_Value const &dynamic_thread_time)
+                                              ACE_Time_Value const &dynamic_thread_time,
+                                              const ACE_CString &lane_cpus)
   : priority_mapping_type_ (priority_mapping_type),
     network_priority_mapping_type_ (network_priority_mapping_type),
     ace_sched_policy_ (ace_sched_policy),
     sched_policy_ (sched_policy),
     scope_policy_ (scope_policy),
     lifespan_ (lifespan),
-    dynamic_thread_time_ (dynamic_thread_time)
+    dynamic_thread_time_ (dynamic_thread_time),
+    lane_cpus_ (lane_cpus)
 {
 }
 
@@ -181,7 +183,8 @@ TAO_RT_ORBInitializer::pre_init (PortableInterceptor::ORBInitInfo_ptr info)
   ACE_NEW_THROW_EX (rt_orb,
                     TAO_RT_ORB (tao_info->orb_core (),
                     lifespan_,
-                    dynamic_thread_time_),
+                    dynamic_thread_time_,
+                    lane_cpus_.c_str ()),
                     CORBA::NO_MEMORY (
                       CORBA::SystemException::_tao_minor_code (
                         TAO::VMCID,
@@ -26,6 +26,7 @@
 
 #include "tao/PI/PI.h"
 #include "tao/LocalObject.h"
+#include "ace/SString.h"
 
 // This is to remove "inherits via dominance" warnings from MSVC.
 // MSVC is being a little too paranoid.
@@ -77,7 +78,8 @@ public:
                          long sched_policy,
                          long scope_policy,
                          TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
-                         ACE_Time_Value const &dynamic_thread_time);
+                         ACE_Time_Value const &dynamic_thread_time,
+                         const ACE_CString &lane_cpus);
 
   virtual void pre_init (PortableInterceptor::ORBInitInfo_ptr info);
 
@@ -139,6 +141,10 @@ private:
    * a time can be specified
    */
   ACE_Time_Value const dynamic_thread_time_;
+
+  /// CPU sets of the thread pool lanes, from the -RTORBLaneCPUs
+  /// option.
+  ACE_CString const lane_cpus_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
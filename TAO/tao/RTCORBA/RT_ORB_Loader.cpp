@@ -57,6 +57,7 @@ TAO_RT_ORB_Loader::init (int argc, ACE_TCHAR* argv[])
   int curarg = 0;
   ACE_Time_Value dynamic_thread_time;
   TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan = TAO_RT_ORBInitializer::TAO_RTCORBA_DT_INFINITIVE;
+  ACE_CString lane_cpus;
 
   ACE_Arg_Shifter arg_shifter (argc, argv);
 
@@ -161,6 +162,12 @@ TAO_RT_ORB_Loader::init (int argc, ACE_TCHAR* argv[])
           lifespan = TAO_RT_ORBInitializer::TAO_RTCORBA_DT_FIXED;
           arg_shifter.consume_arg ();
         }
+      else if (0 != (current_arg = arg_shifter.get_the_parameter
+                                   (ACE_TEXT("-RTORBLaneCPUs"))))
+        {
+          lane_cpus = ACE_TEXT_ALWAYS_CHAR (current_arg);
+          arg_shifter.consume_arg ();
+        }
     else
       {
         arg_shifter.ignore_arg ();
@@ -188,7 +195,8 @@ TAO_RT_ORB_Loader::init (int argc, ACE_TCHAR* argv[])
                                                sched_policy,
                                                scope_policy,
                                                lifespan,
-                                               dynamic_thread_time),
+                                               dynamic_thread_time,
+                                               lane_cpus),
                         CORBA::NO_MEMORY (
                           CORBA::SystemException::_tao_minor_code (
                             TAO::VMCID,
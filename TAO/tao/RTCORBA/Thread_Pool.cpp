@@ -17,9 +17,135 @@
 #include "tao/LF_Follower.h"
 #include "tao/Leader_Follower.h"
 #include "ace/Auto_Ptr.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_strings.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+/// The handle that ACE_OS::thr_set_affinity() takes for the calling
+/// thread.
+static ACE_hthread_t
+calling_thread ()
+{
+#if defined (ACE_HAS_PTHREAD_SETAFFINITY_NP)
+  ACE_hthread_t self;
+  ACE_OS::thr_self (self);
+  return self;
+#else
+  // sched_setaffinity() applies to the calling thread for 0.
+  return 0;
+#endif /* ACE_HAS_PTHREAD_SETAFFINITY_NP */
+}
+
+/**
+ * @class TAO_Lane_CPUs_Guard
+ *
+ * @brief Runs the calling thread on the CPUs of a lane while in
+ * scope.
+ *
+ * Memory is allocated on the NUMA node of the CPU that first touches
+ * it, so the resources of a lane are created under this guard.
+ */
+class TAO_Lane_CPUs_Guard
+{
+public:
+  explicit TAO_Lane_CPUs_Guard (const cpu_set_t *cpus)
+    : restore_ (false)
+  {
+    if (cpus != 0 &&
+        ACE_OS::thr_get_affinity (calling_thread (),
+                                  sizeof this->saved_,
+                                  &this->saved_) == 0 &&
+        ACE_OS::thr_set_affinity (calling_thread (),
+                                  sizeof (cpu_set_t),
+                                  cpus) == 0)
+      this->restore_ = true;
+  }
+
+  ~TAO_Lane_CPUs_Guard ()
+  {
+    if (this->restore_)
+      ACE_OS::thr_set_affinity (calling_thread (),
+                                sizeof this->saved_,
+                                &this->saved_);
+  }
+
+private:
+  bool restore_;
+  cpu_set_t saved_;
+};
+
+/// Parse a list of CPUs and CPU ranges like "0-3,8" into @a cpus, up
+/// to the end of the string, a colon or a newline.  Returns where it
+/// stopped, 0 if the list is empty or not valid.
+static const char *
+parse_cpu_list (const char *list, cpu_set_t &cpus)
+{
+#if defined (ACE_HAS_CPU_SET_T)
+  CPU_ZERO (&cpus);
+
+  const char *p = list;
+  bool empty = true;
+
+  while (*p != '\0' && *p != ':' && *p != '\n')
+    {
+      char *end = 0;
+      unsigned long const first = ACE_OS::strtoul (p, &end, 10);
+      if (end == p)
+        return 0;
+
+      unsigned long last = first;
+      p = end;
+      if (*p == '-')
+        {
+          ++p;
+          last = ACE_OS::strtoul (p, &end, 10);
+          if (end == p)
+            return 0;
+          p = end;
+        }
+
+      if (last < first || last >= CPU_SETSIZE)
+        return 0;
+
+      for (unsigned long cpu = first; cpu <= last; ++cpu)
+        CPU_SET (cpu, &cpus);
+      empty = false;
+
+      if (*p == ',')
+        ++p;
+      else if (*p != '\0' && *p != ':' && *p != '\n')
+        return 0;
+    }
+
+  return empty ? 0 : p;
+#else
+  ACE_UNUSED_ARG (list);
+  ACE_UNUSED_ARG (cpus);
+  return 0;
+#endif /* ACE_HAS_CPU_SET_T */
+}
+
+/// Parse the list in the first line of the sysfs file @a path into
+/// @a set.  Returns false if there is no such file or no valid list.
+static bool
+read_sysfs_list (const char *path, cpu_set_t &set)
+{
+  FILE *file = ACE_OS::fopen (path, "r");
+  if (file == 0)
+    return false;
+
+  char line[4096];
+  bool const valid =
+    ACE_OS::fgets (line, sizeof line, file) != 0 &&
+    parse_cpu_list (line, set) != 0;
+  ACE_OS::fclose (file);
+
+  return valid;
+}
+
 TAO_RT_New_Leader_Generator::TAO_RT_New_Leader_Generator (
   TAO_Thread_Lane &lane)
   : lane_ (lane)
@@ -48,6 +174,14 @@ TAO_Thread_Pool_Threads::svc ()
   if (orb_core.has_shutdown ())
     return 0;
 
+  // Run on the CPUs of the lane, before the thread allocates anything.
+  if (this->lane_.run_on_cpus () == -1 && TAO_debug_level > 0)
+    TAOLIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("TAO (%P|%t) - Pool %d Lane %d Thread %t: ")
+                   ACE_TEXT ("cannot bind thread to the lane CPUs\n"),
+                   this->lane_.pool ().id (),
+                   this->lane_.id ()));
+
   // Set TSS resources for this thread.
   TAO_Thread_Pool_Threads::set_tss_resources (orb_core, this->lane_);
 
@@ -157,7 +291,8 @@ TAO_Thread_Lane::TAO_Thread_Lane (TAO_Thread_Pool &pool,
                                   CORBA::ULong static_threads,
                                   CORBA::ULong dynamic_threads,
                                   TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
-                                  ACE_Time_Value const &dynamic_thread_time)
+                                  ACE_Time_Value const &dynamic_thread_time,
+                                  const cpu_set_t *cpus)
   : pool_ (pool),
     id_ (id),
     lane_priority_ (lane_priority),
@@ -171,8 +306,22 @@ TAO_Thread_Lane::TAO_Thread_Lane (TAO_Thread_Pool &pool,
                 &new_thread_generator_),
     native_priority_ (TAO_INVALID_PRIORITY),
     lifespan_ (lifespan),
-    dynamic_thread_time_ (dynamic_thread_time)
+    dynamic_thread_time_ (dynamic_thread_time),
+    has_cpus_ (cpus != 0)
 {
+  if (cpus != 0)
+    this->cpus_ = *cpus;
+}
+
+int
+TAO_Thread_Lane::run_on_cpus () const
+{
+  if (!this->has_cpus_)
+    return 0;
+
+  return ACE_OS::thr_set_affinity (calling_thread (),
+                                   sizeof this->cpus_,
+                                   &this->cpus_);
 }
 
 bool
@@ -283,6 +432,9 @@ TAO_Thread_Lane::validate_and_map_priority ()
 void
 TAO_Thread_Lane::open ()
 {
+  // Create the reactor and the acceptors of the lane on its CPUs.
+  TAO_Lane_CPUs_Guard const cpus_guard (this->cpus ());
+
   // Validate and map priority.
   this->validate_and_map_priority ();
 
@@ -509,14 +661,12 @@ TAO_Thread_Pool::TAO_Thread_Pool (TAO_Thread_Pool_Manager &manager,
   // Create one lane.
   ACE_NEW (this->lanes_,
            TAO_Thread_Lane *[this->number_of_lanes_]);
-  ACE_NEW (this->lanes_[0],
-           TAO_Thread_Lane (*this,
-                            0,
-                            default_priority,
-                            static_threads,
-                            dynamic_threads,
-                            lifespan,
-                            dynamic_thread_time));
+  this->create_lane (0,
+                     default_priority,
+                     static_threads,
+                     dynamic_threads,
+                     lifespan,
+                     dynamic_thread_time);
 }
 
 TAO_Thread_Pool::TAO_Thread_Pool (TAO_Thread_Pool_Manager &manager,
@@ -553,14 +703,40 @@ TAO_Thread_Pool::TAO_Thread_Pool (TAO_Thread_Pool_Manager &manager,
   for (CORBA::ULong i = 0;
        i != this->number_of_lanes_;
        ++i)
-    ACE_NEW (this->lanes_[i],
-             TAO_Thread_Lane (*this,
-                              i,
-                              lanes[i].lane_priority,
-                              lanes[i].static_threads,
-                              lanes[i].dynamic_threads,
-                              lifespan,
-                              dynamic_thread_time));
+    this->create_lane (i,
+                       lanes[i].lane_priority,
+                       lanes[i].static_threads,
+                       lanes[i].dynamic_threads,
+                       lifespan,
+                       dynamic_thread_time);
+}
+
+void
+TAO_Thread_Pool::create_lane (CORBA::ULong id,
+                              CORBA::Short lane_priority,
+                              CORBA::ULong static_threads,
+                              CORBA::ULong dynamic_threads,
+                              TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
+                              ACE_Time_Value const &dynamic_thread_time)
+{
+  cpu_set_t cpus;
+  const cpu_set_t *lane_cpus = 0;
+
+  if (this->manager_.next_lane_cpus (cpus))
+    lane_cpus = &cpus;
+
+  // Allocate the lane and its transport cache on its CPUs.
+  TAO_Lane_CPUs_Guard const cpus_guard (lane_cpus);
+
+  ACE_NEW (this->lanes_[id],
+           TAO_Thread_Lane (*this,
+                            id,
+                            lane_priority,
+                            static_threads,
+                            dynamic_threads,
+                            lifespan,
+                            dynamic_thread_time,
+                            lane_cpus));
 }
 
 void
@@ -679,7 +855,9 @@ TAO_Thread_Pool_Manager::TAO_Thread_Pool_Manager (TAO_ORB_Core &orb_core)
   : orb_core_ (orb_core),
     thread_pools_ (),
     thread_pool_id_counter_ (1),
-    lock_ ()
+    lock_ (),
+    lane_cpus_ (),
+    next_lane_cpus_ (0)
 {
 }
 
@@ -941,6 +1119,78 @@ TAO_Thread_Pool_Manager::get_threadpool (RTCORBA::ThreadpoolId thread_pool_id )
   return thread_pool;
 }
 
+int
+TAO_Thread_Pool_Manager::lane_cpus (const char *spec)
+{
+  ACE_Array_Base<cpu_set_t> sets;
+  cpu_set_t cpus;
+
+  if (ACE_OS::strcasecmp (spec, "numa") == 0)
+    {
+#if defined (ACE_HAS_CPU_SET_T)
+      // Linux lists the nodes online, which need not be numbered
+      // without gaps, and the CPUs of each node in sysfs.
+      cpu_set_t nodes;
+      if (read_sysfs_list ("/sys/devices/system/node/online", nodes))
+        {
+          for (unsigned int node = 0; node != CPU_SETSIZE; ++node)
+            {
+              if (!CPU_ISSET (node, &nodes))
+                continue;
+
+              char path[64];
+              ACE_OS::snprintf (path,
+                                sizeof path,
+                                "/sys/devices/system/node/node%u/cpulist",
+                                node);
+
+              // Skip the nodes that have memory only.
+              if (read_sysfs_list (path, cpus))
+                {
+                  sets.size (sets.size () + 1);
+                  sets[sets.size () - 1] = cpus;
+                }
+            }
+        }
+#endif /* ACE_HAS_CPU_SET_T */
+
+      if (sets.size () == 0 && TAO_debug_level > 0)
+        TAOLIB_DEBUG ((LM_DEBUG,
+                       ACE_TEXT ("TAO (%P|%t) - Thread_Pool_Manager::lane_cpus, ")
+                       ACE_TEXT ("no NUMA nodes found, lanes are not bound\n")));
+    }
+  else
+    {
+      for (const char *p = spec; *p != '\0'; )
+        {
+          p = parse_cpu_list (p, cpus);
+          if (p == 0)
+            return -1;
+
+          sets.size (sets.size () + 1);
+          sets[sets.size () - 1] = cpus;
+
+          if (*p == ':')
+            ++p;
+        }
+    }
+
+  this->lane_cpus_ = sets;
+  this->next_lane_cpus_ = 0;
+
+  return 0;
+}
+
+bool
+TAO_Thread_Pool_Manager::next_lane_cpus (cpu_set_t &cpus)
+{
+  if (this->lane_cpus_.size () == 0)
+    return false;
+
+  cpus = this->lane_cpus_[this->next_lane_cpus_++ % this->lane_cpus_.size ()];
+  return true;
+}
+
 TAO_ORB_Core &
 TAO_Thread_Pool_Manager::orb_core () const
 {
@@ -28,6 +28,8 @@
 #include "tao/New_Leader_Generator.h"
 #include "ace/Task.h"
 #include "ace/Null_Mutex.h"
+#include "ace/Array_Base.h"
+#include "ace/os_include/os_sched.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -128,7 +130,8 @@ public:
                    CORBA::ULong static_threads,
                    CORBA::ULong dynamic_threads,
                    TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
-                   ACE_Time_Value const &dynamic_thread_time);
+                   ACE_Time_Value const &dynamic_thread_time,
+                   const cpu_set_t *cpus = 0);
 
   /// Destructor.
   ~TAO_Thread_Lane ();
@@ -168,6 +171,10 @@ public:
    */
   bool new_dynamic_thread ();
 
+  /// Run the calling thread on the CPUs of the lane, if it has any.
+  /// @return 0 on success, -1 on failure
+  int run_on_cpus () const;
+
   /// @name Accessors
   // @{
   TAO_Thread_Pool &pool () const;
@@ -186,6 +193,9 @@ public:
   TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan () const;
 
   ACE_Time_Value const &dynamic_thread_time () const;
+
+  /// The CPUs of the lane, 0 if its threads may run anywhere.
+  const cpu_set_t *cpus () const;
   // @}
 
 private:
@@ -234,6 +244,12 @@ private:
 
   ACE_Time_Value const dynamic_thread_time_;
 
+  /// Are the threads of the lane bound to @c cpus_?
+  bool const has_cpus_;
+
+  /// CPUs the threads of the lane run on, see -RTORBLaneCPUs.
+  cpu_set_t cpus_;
+
   /// Lock to guard all members of the lane
   mutable TAO_SYNCH_MUTEX lock_;
 };
@@ -320,6 +336,15 @@ public:
   // @}
 
 private:
+  /// Create lane @a id on the next CPUs of the manager, so that the
+  /// memory of its resources is allocated near them.
+  void create_lane (CORBA::ULong id,
+                    CORBA::Short lane_priority,
+                    CORBA::ULong static_threads,
+                    CORBA::ULong dynamic_threads,
+                    TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan lifespan,
+                    ACE_Time_Value const &dynamic_thread_time);
+
   TAO_Thread_Pool_Manager &manager_;
   CORBA::ULong id_;
 
@@ -394,6 +419,19 @@ public:
 
   TAO_Thread_Pool *get_threadpool (RTCORBA::ThreadpoolId thread_pool_id);
 
+  /// Bind the lanes created from now on to the CPU sets in @a spec,
+  /// in turn.  @a spec lists the sets separated by colons, each a
+  /// comma separated list of CPUs and CPU ranges, for example
+  /// "0-7,16-23:8-15,24-31".  "numa" takes the CPUs of each NUMA node
+  /// and an empty @a spec leaves the lanes unbound.
+  /// @return 0 on success, -1 if @a spec is not valid.
+  int lane_cpus (const char *spec);
+
+  /// Get the CPU set of the next lane into @a cpus, called while a
+  /// thread pool is created.  @return false if lanes are not bound
+  /// to CPUs.
+  bool next_lane_cpus (cpu_set_t &cpus);
+
   /// Collection of thread pools.
   typedef ACE_Hash_Map_Manager<RTCORBA::ThreadpoolId, TAO_Thread_Pool *, ACE_Null_Mutex> THREAD_POOLS;
 
@@ -436,6 +474,12 @@ private:
   THREAD_POOLS thread_pools_;
   RTCORBA::ThreadpoolId thread_pool_id_counter_;
   TAO_SYNCH_MUTEX lock_;
+
+  /// CPU sets to bind the lanes to, in turn.
+  ACE_Array_Base<cpu_set_t> lane_cpus_;
+
+  /// Index in @c lane_cpus_ of the set of the next lane.
+  size_t next_lane_cpus_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
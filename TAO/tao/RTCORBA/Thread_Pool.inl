@@ -57,6 +57,13 @@ TAO_Thread_Lane::resources ()
   return this->resources_;
 }
 
+ACE_INLINE
+const cpu_set_t *
+TAO_Thread_Lane::cpus () const
+{
+  return this->has_cpus_ ? &this->cpus_ : 0;
+}
+
 ACE_INLINE
 TAO_RT_ORBInitializer::TAO_RTCORBA_DT_LifeSpan
 TAO_Thread_Lane::lifespan () const
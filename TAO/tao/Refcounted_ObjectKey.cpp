@@ -8,9 +8,12 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
-TAO::Refcounted_ObjectKey::Refcounted_ObjectKey (const TAO::ObjectKey &key)
+TAO::Refcounted_ObjectKey::Refcounted_ObjectKey (const TAO::ObjectKey &key,
+                                                 CORBA::ULong hash)
   : object_key_ (key)
   , refcount_ (1)
+  , hash_ (hash)
+  , next_ (nullptr)
 {
 }
 
@@ -38,12 +38,16 @@ namespace TAO
   class TAO_Export Refcounted_ObjectKey
   {
   public:
-    /// Constructor
-    Refcounted_ObjectKey (const ObjectKey &ref);
+    /// Constructor, @a hash is the ObjectKey_Table::hash () of @a ref
+    /// or 0 if it is not known.
+    Refcounted_ObjectKey (const ObjectKey &ref, CORBA::ULong hash = 0);
 
     /// Accessor for the underlying ObjectKey.
     const ObjectKey &object_key () const;
 
+    /// Accessor for the hash of the ObjectKey.
+    CORBA::ULong hash () const;
+
   protected:
     friend class ObjectKey_Table;
 
@@ -63,6 +67,12 @@ namespace TAO
 
     /// The refcount on the object key..
     CORBA::ULong refcount_;
+
+    /// Hash of the object key, computed once by the table.
+    CORBA::ULong const hash_;
+
+    /// Next key in the same bucket of a sharded ObjectKey_Table.
+    Refcounted_ObjectKey *next_;
   };
 }
 
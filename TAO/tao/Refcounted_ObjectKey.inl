@@ -13,6 +13,12 @@ TAO::Refcounted_ObjectKey::object_key () const
   return this->object_key_;
 }
 
+ACE_INLINE CORBA::ULong
+TAO::Refcounted_ObjectKey::hash () const
+{
+  return this->hash_;
+}
+
 ACE_INLINE CORBA::ULong
 TAO::Refcounted_ObjectKey::decr_refcount ()
 {
@@ -175,6 +175,18 @@ TAO_Resource_Factory::max_muxed_connections () const
   return 0;
 }
 
+int
+TAO_Resource_Factory::transport_cache_shards () const
+{
+  return TAO_TRANSPORT_CACHE_SHARDS;
+}
+
+int
+TAO_Resource_Factory::object_key_table_shards () const
+{
+  return TAO_OBJECTKEY_TABLE_SHARDS;
+}
+
 
 int
 TAO_Resource_Factory::get_parser_names (char **&, int &)
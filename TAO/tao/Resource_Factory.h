@@ -211,6 +211,13 @@ public:
   /// remote endpoint
   virtual int max_muxed_connections () const;
 
+  /// Number of independently locked shards of the transport cache.
+  virtual int transport_cache_shards () const;
+
+  /// Number of hash shards of the ObjectKey table, 0 for a single
+  /// RB_Tree.
+  virtual int object_key_table_shards () const;
+
   virtual int get_parser_names (char **&names,
                                 int &number_of_names);
 
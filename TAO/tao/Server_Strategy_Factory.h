@@ -31,6 +31,7 @@ enum TAO_Demux_Strategy
   TAO_LINEAR,
   TAO_DYNAMIC_HASH,
   TAO_ACTIVE_DEMUX,
+  TAO_FLAT_HASH,
   TAO_USER_DEFINED
 };
 
@@ -81,6 +82,11 @@ public:
     TAO_Demux_Strategy poa_lookup_strategy_for_persistent_id_policy_;
 
     int use_active_hint_in_poa_names_;
+
+    /// Flag to indicate whether requests for objects already in the
+    /// active object map are dispatched without the object adapter
+    /// lock.
+    int use_dispatch_cache_;
   };
 
   /// Constructor.
@@ -25,9 +25,15 @@ TAO_DIOP_Transport::TAO_DIOP_Transport (TAO_DIOP_Connection_Handler *handler,
                    orb_core,
                    ACE_MAX_DGRAM_SIZE)
   , connection_handler_ (handler)
+  , recv_blocks_ (0)
 {
 }
 
+TAO_DIOP_Transport::~TAO_DIOP_Transport ()
+{
+  delete [] this->recv_blocks_;
+}
+
 ACE_Event_Handler *
 TAO_DIOP_Transport::event_handler_i ()
 {
@@ -114,7 +120,7 @@ TAO_DIOP_Transport::recv (char *buf,
 
 int
 TAO_DIOP_Transport::handle_input (TAO_Resume_Handle &rh,
-                                  ACE_Time_Value *max_wait_time)
+                                  ACE_Time_Value *)
 {
   // If there are no messages then we can go ahead to read from the
   // handle for further reading..
@@ -148,26 +154,122 @@ TAO_DIOP_Transport::handle_input (TAO_Resume_Handle &rh,
   ACE_CDR::mb_align (&message_block);
 
 
-  // Read the message into the  message block that we have created on
-  // the stack.
-  ssize_t n = this->recv (message_block.rd_ptr (),
-                          message_block.space (),
-                          max_wait_time);
+  // Read the message into the message block that we have created on
+  // the stack, together with up to TAO_DIOP_RECV_BATCH_SIZE - 1 more
+  // datagrams that are already waiting on the socket.  The additional
+  // ones are copied out of recv_blocks_ before the first message is
+  // processed, which may let another thread into handle_input().
+  ACE_Message_Block *blocks[TAO_DIOP_RECV_BATCH_SIZE];
+  ACE_Message_Block *copies[TAO_DIOP_RECV_BATCH_SIZE];
+  ACE_INET_Addr from_addr[TAO_DIOP_RECV_BATCH_SIZE];
+  ssize_t count = 0;
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->recv_lock_, -1);
+
+    if (this->recv_blocks_ == 0 && TAO_DIOP_RECV_BATCH_SIZE > 1)
+      {
+        ACE_NEW_RETURN (this->recv_blocks_,
+                        ACE_Message_Block[TAO_DIOP_RECV_BATCH_SIZE - 1],
+                        -1);
+        for (size_t i = 0; i < TAO_DIOP_RECV_BATCH_SIZE - 1; ++i)
+          if (this->recv_blocks_[i].init (ACE_MAX_DGRAM_SIZE +
+                                          ACE_CDR::MAX_ALIGNMENT) == -1)
+            {
+              delete [] this->recv_blocks_;
+              this->recv_blocks_ = 0;
+              return -1;
+            }
+      }
+
+    blocks[0] = &message_block;
+    for (size_t i = 1; i < TAO_DIOP_RECV_BATCH_SIZE; ++i)
+      {
+        this->recv_blocks_[i - 1].reset ();
+        ACE_CDR::mb_align (&this->recv_blocks_[i - 1]);
+        blocks[i] = &this->recv_blocks_[i - 1];
+      }
+
+    count = this->connection_handler_->peer ().recv_n_msgs (
+      blocks,
+      TAO_DIOP_RECV_BATCH_SIZE,
+      from_addr);
+
+    if (count == -1)
+      {
+        if (TAO_debug_level > 4)
+          {
+            TAOLIB_DEBUG ((LM_DEBUG,
+                        ACE_TEXT ("TAO (%P|%t) - DIOP_Transport::handle_input, %p\n"),
+                        ACE_TEXT ("TAO - read message failure ")
+                        ACE_TEXT ("recv_n_msgs ()\n")));
+          }
+
+        if (errno == EWOULDBLOCK)
+          return 0;
+
+        this->tms_->connection_closed ();
+        return -1;
+      }
+
+    for (ssize_t i = 1; i < count; ++i)
+      {
+        size_t const len = blocks[i]->length ();
+        copies[i] = 0;
+        if (len == 0)
+          continue;
+
+        ACE_NEW_NORETURN (copies[i],
+                          ACE_Message_Block (len + ACE_CDR::MAX_ALIGNMENT));
+        if (copies[i] != 0)
+          {
+            ACE_CDR::mb_align (copies[i]);
+            copies[i]->copy (blocks[i]->rd_ptr (), len);
+          }
+      }
+  }
+
+  if (TAO_debug_level > 0)
+    {
+      for (ssize_t i = 0; i < count; ++i)
+        TAOLIB_DEBUG ((LM_DEBUG,
+                    "TAO (%P|%t) - DIOP_Transport::handle_input, received %B bytes from %C:%d\n",
+                    blocks[i]->length (),
+                    from_addr[i].get_host_name (),
+                    from_addr[i].get_port_number ()));
+    }
+
+  int result = 0;
+  if (message_block.length () == 0)
+    {
+      // @@ What are the other error handling here??
+      this->tms_->connection_closed ();
+      result = -1;
+    }
+  else
+    {
+      // Remember the from addr to eventually use it as remote
+      // addr for the reply.
+      this->connection_handler_->addr (from_addr[0]);
+      result = this->process_datagram (message_block, rh);
+    }
 
-  // If there is an error return to the reactor..
-  if (n <= 0)
+  for (ssize_t i = 1; i < count; ++i)
     {
-      if (n == -1)
+      if (result != -1 && copies[i] != 0)
         {
-          this->tms_->connection_closed ();
+          this->connection_handler_->addr (from_addr[i]);
+          result = this->process_datagram (*copies[i], rh);
         }
-
-      return static_cast<int> (n);
+      ACE_Message_Block::release (copies[i]);
     }
 
-  // Set the write pointer in the stack buffer
-  message_block.wr_ptr (n);
+  return result;
+}
 
+int
+TAO_DIOP_Transport::process_datagram (ACE_Message_Block &message_block,
+                                      TAO_Resume_Handle &rh)
+{
   // Make a node of the message block..
   TAO_Queued_Data qd (&message_block);
   size_t mesg_length = 0;
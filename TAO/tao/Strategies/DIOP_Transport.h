@@ -26,6 +26,12 @@
 #include "ace/SOCK_Dgram.h"
 #include "ace/Svc_Handler.h"
 
+#if !defined (TAO_DIOP_RECV_BATCH_SIZE)
+/// Maximum number of datagrams read with a single system call; one
+/// disables batching.
+#  define TAO_DIOP_RECV_BATCH_SIZE 8
+#endif /* TAO_DIOP_RECV_BATCH_SIZE */
+
 #if defined ACE_HAS_EXPLICIT_TEMPLATE_INSTANTIATION_EXPORT
 template class TAO_Strategies_Export ACE_Svc_Handler<ACE_SOCK_DGRAM, ACE_NULL_SYNCH>;
 #endif /* ACE_HAS_EXPLICIT_TEMPLATE_INSTANTIATION_EXPORT */
@@ -56,7 +62,7 @@ public:
                       TAO_ORB_Core *orb_core);
 
   /// Default destructor.
-  ~TAO_DIOP_Transport () = default;
+  ~TAO_DIOP_Transport ();
 
   /// Look for the documentation in Transport.h.
   virtual int handle_input (TAO_Resume_Handle &rh,
@@ -99,9 +105,20 @@ public:
                             ACE_Time_Value *max_time_wait = 0);
 
 private:
+  /// Parse and process the single GIOP message held by @a message_block.
+  int process_datagram (ACE_Message_Block &message_block,
+                        TAO_Resume_Handle &rh);
+
   /// The connection service handler used for accessing lower layer
   /// communication protocols.
   TAO_DIOP_Connection_Handler *connection_handler_;
+
+  /// Buffers for the datagrams read together with the first one;
+  /// allocated on first use.
+  ACE_Message_Block *recv_blocks_;
+
+  /// Serializes access to recv_blocks_.
+  TAO_SYNCH_MUTEX recv_lock_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -24,7 +24,8 @@ TAO_SHMIOP_Acceptor::TAO_SHMIOP_Acceptor ()
     concurrency_strategy_ (0),
     accept_strategy_ (0),
     mmap_file_prefix_ (0),
-    mmap_size_ (1024 * 1024)
+    mmap_size_ (1024 * 1024),
+    ring_buffers_ (false)
 {
 }
 
@@ -223,6 +224,12 @@ TAO_SHMIOP_Acceptor::set_mmap_options (const ACE_TCHAR *prefix, ACE_OFF_T size)
   return 0;
 }
 
+void
+TAO_SHMIOP_Acceptor::ring_buffers (bool use_rings)
+{
+  this->ring_buffers_ = use_rings;
+}
+
 int
 TAO_SHMIOP_Acceptor::open_i (TAO_ORB_Core* orb_core, ACE_Reactor *reactor)
 {
@@ -258,7 +265,8 @@ TAO_SHMIOP_Acceptor::open_i (TAO_ORB_Core* orb_core, ACE_Reactor *reactor)
   this->base_acceptor_.acceptor().init_buffer_size (this->mmap_size_);
 
   if (orb_core->server_factory ()->activate_server_connections () != 0)
-    this->base_acceptor_.acceptor().preferred_strategy (ACE_MEM_IO::MT);
+    this->base_acceptor_.acceptor().preferred_strategy (
+      this->ring_buffers_ ? ACE_MEM_IO::Ring : ACE_MEM_IO::MT);
 
   // @@ Should this be a catastrophic error???
   if (this->base_acceptor_.acceptor ().get_local_addr (this->address_) != 0)
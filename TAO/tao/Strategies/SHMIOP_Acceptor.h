@@ -85,6 +85,10 @@ public:
   int set_mmap_options (const ACE_TCHAR *prefix,
                         ACE_OFF_T size);
 
+  /// Exchange data through rings in the mmap file on connections
+  /// served by their own thread.
+  void ring_buffers (bool use_rings);
+
 private:
   /// Implement the common part of the open*() methods.
   int open_i (TAO_ORB_Core* orb_core,
@@ -136,6 +140,9 @@ private:
   /// Determine the minimum size of mmap file.  This dictate the
   /// maximum size of a CORBA method invocation.
   ACE_OFF_T mmap_size_;
+
+  /// Prefer the ring signaling strategy to the multithreaded one.
+  bool ring_buffers_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -20,7 +20,8 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 TAO_SHMIOP_Connector::TAO_SHMIOP_Connector ()
   : TAO_Connector (TAO_TAG_SHMEM_PROFILE),
     connect_strategy_ (),
-    base_connector_ (0)
+    base_connector_ (0),
+    ring_buffers_ (false)
 {
 }
 
@@ -62,12 +63,20 @@ TAO_SHMIOP_Connector::open (TAO_ORB_Core *orb_core)
   else if (orb_core->client_factory ()->allow_callback () == 0)
 
     {
-      this->base_connector_.connector ().preferred_strategy (ACE_MEM_IO::MT);
-      this->connect_strategy_.connector ().preferred_strategy (ACE_MEM_IO::MT);
+      ACE_MEM_IO::Signal_Strategy const strategy =
+        this->ring_buffers_ ? ACE_MEM_IO::Ring : ACE_MEM_IO::MT;
+      this->base_connector_.connector ().preferred_strategy (strategy);
+      this->connect_strategy_.connector ().preferred_strategy (strategy);
     }
   return 0;
 }
 
+void
+TAO_SHMIOP_Connector::ring_buffers (bool use_rings)
+{
+  this->ring_buffers_ = use_rings;
+}
+
 int
 TAO_SHMIOP_Connector::close ()
 {
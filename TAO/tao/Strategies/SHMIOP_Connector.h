@@ -71,6 +71,10 @@ public:
   virtual char object_key_delimiter () const;
   //@}
 
+  /// Exchange data through rings in the mmap file when the client
+  /// blocks on read.
+  void ring_buffers (bool use_rings);
+
 public:
   typedef TAO_Connect_Concurrency_Strategy<TAO_SHMIOP_Connection_Handler>
           TAO_SHMIOP_CONNECT_CONCURRENCY_STRATEGY;
@@ -118,6 +122,9 @@ private:
 
   /// The connector initiating connection requests for SHMIOP.
   TAO_SHMIOP_BASE_CONNECTOR base_connector_;
+
+  /// Prefer the ring signaling strategy to the multithreaded one.
+  bool ring_buffers_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
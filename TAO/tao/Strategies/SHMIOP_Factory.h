@@ -78,6 +78,10 @@ private:
 
   /// Minimum bytes of the mmap files.
   ACE_OFF_T min_bytes_;
+
+  /// Use the ring signaling strategy where connections block on
+  /// read.
+  bool ring_buffers_;
 };
 
 
@@ -120,28 +120,51 @@ TAO_Synch_Queued_Message::clone (ACE_Allocator *alloc)
   // have already been sent on the wire. Waste of memory and
   // associated copying.
   ACE_Message_Block *mb = 0;
-  ACE_NEW_NORETURN (mb,
-                    ACE_Message_Block (0, // size
-                                       ACE_Message_Block::ACE_Message_Type (0), // type
-                                       0, // cont
-                                       0, // data
-                                       0, // allocator
-                                       0, // locking strategy
-                                       this->current_block_->msg_priority(), // priority
-                                       this->current_block_->msg_execution_time(), // execution time
-                                       this->current_block_->msg_deadline_time(), // absolute time to deadline
-                                       this->current_block_->data_block()->data_block_allocator (),
-                                       0));
-  if (!mb)
+
+  // Buffers appended with ACE_OutputCDR::write_array_external() are
+  // shared rather than copied, so keep the chain if there are any.
+  bool external = false;
+  for (const ACE_Message_Block *i = this->current_block_;
+       i != nullptr && !external;
+       i = i->cont ())
     {
-      return 0;
+      external =
+        dynamic_cast<ACE_External_Data_Block *> (i->data_block ()) != nullptr;
     }
- 
-  int result = ACE_CDR::consolidate (mb, this->current_block_);
-  if (result == -1)
+
+  if (external)
     {
-      mb->release ();
-      return 0;
+      mb = this->current_block_->clone ();
+      if (!mb)
+        {
+          return 0;
+        }
+    }
+  else
+    {
+      ACE_NEW_NORETURN (mb,
+                        ACE_Message_Block (0, // size
+                                           ACE_Message_Block::ACE_Message_Type (0), // type
+                                           0, // cont
+                                           0, // data
+                                           0, // allocator
+                                           0, // locking strategy
+                                           this->current_block_->msg_priority(), // priority
+                                           this->current_block_->msg_execution_time(), // execution time
+                                           this->current_block_->msg_deadline_time(), // absolute time to deadline
+                                           this->current_block_->data_block()->data_block_allocator (),
+                                           0));
+      if (!mb)
+        {
+          return 0;
+        }
+
+      int result = ACE_CDR::consolidate (mb, this->current_block_);
+      if (result == -1)
+        {
+          mb->release ();
+          return 0;
+        }
     }
 
 
@@ -599,7 +599,8 @@ TAO_Transport::format_queue_message (TAO_OutputCDR &stream,
   if (this->messaging_object ()->format_message (stream, stub, nullptr) != 0)
     return -1;
 
-  if (this->queue_message_i (stream.begin (), max_wait_time) != 0)
+  // Only oneways are queued before the connection completes.
+  if (this->queue_message_i (stream.begin (), max_wait_time, true, true) != 0)
     return -1;
 
   // check the buffering constraints to see what must be done in post_open()
@@ -1285,7 +1286,7 @@ TAO_Transport::check_buffering_constraints_i (TAO_Stub *stub, bool &must_flush)
 
   for (TAO_Queued_Message *i = this->head_; i != nullptr; i = i->next ())
     {
-      ++msg_count;
+      msg_count += i->message_count ();
       total_bytes += i->message_length ();
     }
 
@@ -1392,6 +1393,7 @@ TAO_Transport::send_message_shared_i (TAO_Stub *stub,
 
       case TAO_Message_Semantics::TAO_ONEWAY_REQUEST:
         ret = this->send_asynchronous_message_i (stub,
+                                                 message_semantics,
                                                  message_block,
                                                  max_wait_time);
         break;
@@ -1408,6 +1410,7 @@ TAO_Transport::send_message_shared_i (TAO_Stub *stub,
 
 int
 TAO_Transport::send_asynchronous_message_i (TAO_Stub *stub,
+                                            TAO_Message_Semantics message_semantics,
                                             const ACE_Message_Block *message_block,
                                             ACE_Time_Value *max_wait_time)
 {
@@ -1545,8 +1548,13 @@ TAO_Transport::send_asynchronous_message_i (TAO_Stub *stub,
   // ... either the message must be queued or we need to queue it
   // because it was not completely sent out ...
 
+  // AMI requests are not batched, a reply is waited for and they
+  // would give the oneways queued after them their latency.
+  bool const batch =
+    message_semantics.mode_ == TAO_Message_Semantics::TAO_SYNCH_MODE;
+
   ACE_Time_Value *wait_time = (partially_sent ? nullptr: max_wait_time);
-  if (this->queue_message_i (message_block, wait_time, !partially_sent)
+  if (this->queue_message_i (message_block, wait_time, !partially_sent, batch)
       == -1)
     {
       if (TAO_debug_level > 0)
@@ -1659,15 +1667,32 @@ TAO_Transport::send_asynchronous_message_i (TAO_Stub *stub,
 
 int
 TAO_Transport::queue_message_i (const ACE_Message_Block *message_block,
-                                ACE_Time_Value *max_wait_time, bool back)
+                                ACE_Time_Value *max_wait_time, bool back,
+                                bool batch)
 {
+  // With -ORBOnewayBatchSize a oneway is appended to the last message
+  // in the queue if it fits, so that both are sent in the same write.
+  // A oneway that starts a batch gets a buffer of the batch size.
+  size_t const batch_size =
+    back && batch ? this->orb_core_->orb_params ()->oneway_batch_size () : 0;
+
+  if (batch_size > 0
+      && this->tail_ != nullptr
+      && this->tail_->append (message_block, max_wait_time))
+    {
+      this->orb_core_->oneway_queued (true);
+      return 0;
+    }
+
   TAO_Queued_Message *queued_message = nullptr;
   ACE_NEW_RETURN (queued_message,
                   TAO_Asynch_Queued_Message (message_block,
                                              this->orb_core_,
                                              max_wait_time,
                                              nullptr,
-                                             true),
+                                             true,
+                                             max_wait_time == nullptr
+                                               ? batch_size : 0),
                   -1);
   if (back) {
     queued_message->push_back (this->head_, this->tail_);
@@ -1676,6 +1701,11 @@ TAO_Transport::queue_message_i (const ACE_Message_Block *message_block,
     queued_message->push_front (this->head_, this->tail_);
   }
 
+  if (batch_size > 0)
+    {
+      this->orb_core_->oneway_queued (false);
+    }
+
   return 0;
 }
 
@@ -2005,6 +2035,16 @@ TAO_Transport::handle_input_parse_extra_messages (
         }
       else  // incomplete message read, probably the last message in buffer
         {
+          // Read the rest of a fragment behind the message it continues
+          TAO_Queued_Data *in_place =
+            this->messaging_object ()->fragment_in_place (*q_data);
+
+          if (in_place != nullptr)
+            {
+              TAO_Queued_Data::release (q_data);
+              q_data = in_place;
+            }
+
           // can not fail
           this->incoming_message_stack_.push (q_data);
         }
@@ -2321,23 +2361,30 @@ TAO_Transport::handle_input_parse_data  (TAO_Resume_Handle &rh,
             {
               // Incomplete message, must be the last one in buffer
 
-              if (qd.missing_data () != TAO_MISSING_DATA_UNDEFINED &&
-                  qd.missing_data () > message_block.space ())
+              // Read the rest of a fragment behind the message it
+              // continues, else into a buffer of the message size
+              TAO_Queued_Data *nqd =
+                this->messaging_object ()->fragment_in_place (qd);
+
+              if (nqd == nullptr)
                 {
-                  // Re-Allocate correct size on heap
-                  if (ACE_CDR::grow (qd.msg_block (),
-                                     message_block.length ()
-                                     + qd.missing_data ()) == -1)
+                  if (qd.missing_data () > message_block.space ())
                     {
-                      return -1;
+                      // Re-Allocate correct size on heap
+                      if (ACE_CDR::grow (qd.msg_block (),
+                                         message_block.length ()
+                                         + qd.missing_data ()) == -1)
+                        {
+                          return -1;
+                        }
                     }
-                }
 
-              TAO_Queued_Data *nqd = TAO_Queued_Data::duplicate (qd);
+                  nqd = TAO_Queued_Data::duplicate (qd);
 
-              if (nqd == nullptr)
-                {
-                  return -1;
+                  if (nqd == nullptr)
+                    {
+                      return -1;
+                    }
                 }
 
               // move read-pointer to end of buffer
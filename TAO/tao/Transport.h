@@ -782,8 +782,11 @@ protected:
   ///            block, used in the implementation of timeouts.
   /// @param back If true, the message will be pushed to the back of the queue.
   ///        If false, the message will be pushed to the front of the queue.
+  /// @param batch If true, the message is a oneway that may be appended
+  ///        to the last message of the queue, see -ORBOnewayBatchSize.
   int queue_message_i (const ACE_Message_Block *message_block,
-                       ACE_Time_Value *max_wait_time, bool back=true);
+                       ACE_Time_Value *max_wait_time, bool back=true,
+                       bool batch=false);
 
   /**
    * @brief Re-factor computation of I/O timeouts based on operation
@@ -965,8 +968,10 @@ private:
                             ACE_Time_Value *max_wait_time);
 
   /// Send an asynchronous message, i.e. do not block until the message is on
-  /// the wire
+  /// the wire.  Only oneways, not AMI requests, are batched when they
+  /// have to be queued.
   int send_asynchronous_message_i (TAO_Stub *stub,
+                                   TAO_Message_Semantics message_semantics,
                                    const ACE_Message_Block *message_block,
                                    ACE_Time_Value *max_wait_time);
 
@@ -169,12 +169,44 @@ class TAO_Strategy_Acceptor:
 {
 public:
   TAO_Strategy_Acceptor (TAO_Acceptor* acceptor)
-   : acceptor_ (acceptor)
+   : acceptor_ (acceptor),
+     accept_batch_ (0),
+     accept_failed_ (false)
   {
   }
 
+  /// Accept up to @a batch connections each time the listen socket is
+  /// ready, stopping when accept() would block, instead of polling the
+  /// socket after each one.  Only meant for an acceptor opened without
+  /// use_select; 0 keeps the ACE_Strategy_Acceptor behavior.
+  void accept_batch (u_long batch)
+  {
+    this->accept_batch_ = batch;
+  }
+
+  virtual int handle_input (ACE_HANDLE listener)
+  {
+    if (this->accept_batch_ == 0)
+      return this->ACE_Strategy_Acceptor<SVC_HANDLER, ACE_PEER_ACCEPTOR_2>::handle_input (listener);
+
+    // Without use_select each call accepts one connection.  The listen
+    // socket is non-blocking, so an empty queue ends the batch through
+    // handle_accept_error().
+    this->accept_failed_ = false;
+    for (u_long i = 0;
+         i != this->accept_batch_ && !this->accept_failed_;
+         ++i)
+      {
+        if (this->ACE_Strategy_Acceptor<SVC_HANDLER, ACE_PEER_ACCEPTOR_2>::handle_input (listener) == -1)
+          return -1;
+      }
+
+    return 0;
+  }
+
   virtual int handle_accept_error ()
   {
+    this->accept_failed_ = true;
     return this->acceptor_->handle_accept_error (this);
   }
 
@@ -185,6 +217,12 @@ public:
 
 private:
   TAO_Acceptor* acceptor_;
+
+  /// Maximum number of connections accepted per handle_input() call.
+  u_long accept_batch_;
+
+  /// Set when an accept() in the current batch failed.
+  bool accept_failed_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
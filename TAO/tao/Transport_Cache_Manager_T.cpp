@@ -22,33 +22,59 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace TAO
 {
+  template <typename TT, typename TRDT, typename PSTRAT>
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard::Shard ()
+    : cache_lock_ (0)
+    , size_ (0)
+    , hits_ (0)
+    , misses_ (0)
+    , contended_ (0)
+  {
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard::~Shard ()
+  {
+    delete this->cache_lock_;
+    this->cache_lock_ = 0;
+  }
+
   template <typename TT, typename TRDT, typename PSTRAT>
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Transport_Cache_Manager_T (
     int percent,
     purging_strategy* purging_strategy,
     size_t cache_maximum,
     bool locked,
-    const char *orbid)
+    const char *orbid,
+    size_t shards)
     : percent_ (percent)
     , purging_strategy_ (purging_strategy)
-    , cache_map_ (cache_maximum)
+    , shards_ (0)
+    , shard_count_ (shards == 0 ? 1 : shards)
     , cache_size_ (0)
-    , cache_lock_ (0)
     , cache_maximum_ (cache_maximum)
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
     , purge_monitor_ (0)
     , size_monitor_ (0)
 #endif /* TAO_HAS_MONITOR_POINTS==1 */
   {
-    if (locked)
-      {
-        ACE_NEW (this->cache_lock_,
-                 ACE_Lock_Adapter <TAO_SYNCH_MUTEX> (this->cache_map_mutex_));
-      }
-    else
+    ACE_NEW (this->shards_, Shard[this->shard_count_]);
+
+    for (size_t i = 0; i < this->shard_count_; ++i)
       {
-        ACE_NEW (this->cache_lock_,
-                 ACE_Lock_Adapter<ACE_SYNCH_NULL_MUTEX>);
+        Shard &shard = this->shards_[i];
+        shard.cache_map_.open (cache_maximum / this->shard_count_ + 1);
+
+        if (locked)
+          {
+            ACE_NEW (shard.cache_lock_,
+                     ACE_Lock_Adapter <TAO_SYNCH_MUTEX> (shard.cache_map_mutex_));
+          }
+        else
+          {
+            ACE_NEW (shard.cache_lock_,
+                     ACE_Lock_Adapter<ACE_SYNCH_NULL_MUTEX>);
+          }
       }
 
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
@@ -76,8 +102,24 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::~Transport_Cache_Manager_T ()
   {
-    delete this->cache_lock_;
-    this->cache_lock_ = 0;
+    if (TAO_debug_level > 4 && this->shards_ != 0)
+      {
+        for (size_t i = 0; i < this->shard_count_; ++i)
+          {
+            Shard const &shard = this->shards_[i];
+            TAOLIB_DEBUG ((LM_INFO,
+              ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::")
+              ACE_TEXT ("~Transport_Cache_Manager_T, shard %B: ")
+              ACE_TEXT ("%B hits, %B misses, %B contended\n"),
+              i,
+              shard.hits_,
+              shard.misses_,
+              shard.contended_));
+          }
+      }
+
+    delete [] this->shards_;
+    this->shards_ = 0;
 
     delete this->purging_strategy_;
     this->purging_strategy_ = 0;
@@ -95,7 +137,9 @@ namespace TAO
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::set_entry_state (HASH_MAP_ENTRY &entry,
                                             TAO::Cache_Entries_State state)
   {
-    ACE_MT (ACE_GUARD (ACE_Lock, guard, *this->cache_lock_));
+    Shard_Guard guard;
+    if (this->lock_entry_shard (entry, guard) == -1)
+      return;
     if (entry != 0)
       {
         entry.item->recycle_state (state);
@@ -106,9 +150,52 @@ namespace TAO
       }
   }
 
+  template <typename TT, typename TRDT, typename PSTRAT>
+  int
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::lock_entry_shard (
+    HASH_MAP_ENTRY &entry,
+    Shard_Guard &guard)
+  {
+    for (;;)
+      {
+        size_t const shard = entry.shard;
+        if (shard >= this->shard_count_
+            || guard.acquire (this->shards_[shard]) == -1)
+          return -1;
+
+        // Bound or purged by another thread before we got the lock?
+        if (entry == 0 || entry.shard == shard)
+          return 0;
+
+        guard.release ();
+      }
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  int
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::shard_statistics (
+    size_t shard,
+    Shard_Statistics &stats)
+  {
+    if (shard >= this->shard_count_)
+      return -1;
+
+    Shard &s = this->shards_[shard];
+    Shard_Guard guard (s);
+    if (!guard.locked ())
+      return -1;
+
+    stats.size = s.size_;
+    stats.hits = s.hits_;
+    stats.misses = s.misses_;
+    stats.contended = s.contended_;
+    return 0;
+  }
+
   template <typename TT, typename TRDT, typename PSTRAT>
   int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::bind_i (
+    size_t shard,
     Cache_ExtId &ext_id,
     Cache_IntId_Node &int_id)
   {
@@ -123,14 +210,18 @@ namespace TAO
 
     // Get the entry too
     HASH_MAP_ELEM *entry = 0;
+    Shard &s = this->shards_[shard];
 
     // Update the purging strategy information while we
     // are holding our lock
     this->purging_strategy_->update_item (*(int_id.transport ()));
     int retval = 0;
       {
-        if (this->cache_size_ >= cache_maximum_)
+        // Reserve the room for a new entry first, other shards may be
+        // binding at the same time.
+        if (++this->cache_size_ > cache_maximum_)
           {
+            --this->cache_size_;
             retval = -1;
             if (TAO_debug_level > 0)
               {
@@ -141,7 +232,7 @@ namespace TAO
           }
         else
           {
-            retval = this->cache_map_.bind (ext_id, Cache_IntId (), entry);
+            retval = s.cache_map_.bind (ext_id, Cache_IntId (), entry);
             if (retval >= 0)
               {
                 Cache_IntId_Node *node = entry->item ().head ();
@@ -158,10 +249,21 @@ namespace TAO
                   if (node)
                   {
                     entry->item ().push_back (node);
-                    this->cache_size_++;
+                    ++s.size_;
                     // The entry has been added to cache successfully
                     // Add the cache_map_entry to the transport
-                    node->transport ()->cache_map_entry (HASH_MAP_ENTRY (entry, node));
+                    node->transport ()->cache_map_entry (
+                      HASH_MAP_ENTRY (entry, node, shard));
+
+                    // The connection may have completed since int_id
+                    // was made, when the transport did not know its
+                    // entry yet and could not mark it connected.
+                    if (node->recycle_state () == ENTRY_CONNECTING &&
+                        node->transport ()->is_connected ())
+                      {
+                        node->recycle_state (ENTRY_IDLE_AND_PURGABLE);
+                        node->is_connected (true);
+                      }
 
                     retval = 0;
                   }
@@ -174,6 +276,7 @@ namespace TAO
                           ACE_TEXT("ERROR: unable to bind transport\n")));
                       }
 
+                    --this->cache_size_;
                     retval = -1;
                   }
                 }
@@ -192,10 +295,14 @@ namespace TAO
 
                     node->is_connected (int_id.is_connected ());
                     retval = 0;
+
+                    // Nothing was added after all.
+                    --this->cache_size_;
                 }
               }
             else
               {
+                --this->cache_size_;
                 if (TAO_debug_level > 0)
                   {
                     TAOLIB_ERROR ((LM_ERROR,
@@ -212,16 +319,16 @@ namespace TAO
             TAOLIB_DEBUG ((LM_INFO,
               ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::bind_i: ")
               ACE_TEXT ("Success Transport[%d] @ hash{%d}. ")
-              ACE_TEXT ("Cache size is [%d]\n"),
+              ACE_TEXT ("Cache size is [%B]\n"),
               int_id.transport ()->id (),
               ext_id.hash (),
-              this->cache_size_
+              this->cache_size_.value ()
               ));
           }
       }
 
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
-    this->size_monitor_->receive (this->cache_size_);
+    this->size_monitor_->receive (this->cache_size_.value ());
 #endif /* TAO_HAS_MONITOR_POINTS==1 */
 
     return retval;
@@ -278,6 +385,7 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   typename Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Find_Result
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::find_i (
+    Shard &shard,
     transport_descriptor_type *prop,
     transport_type *&transport,
     size_t &busy_count)
@@ -292,7 +400,7 @@ namespace TAO
     int cache_status = 0;
     Cache_IntId_Node *found_entry = 0;
 
-    cache_status = this->cache_map_.find (key, entry);
+    cache_status = shard.cache_map_.find (key, entry);
     if (cache_status == 0 && entry)
     {
           // loop until we find a usable transport, or until we've checked
@@ -380,6 +488,12 @@ namespace TAO
           this->purging_strategy_->update_item (*transport);
         }
     }
+
+    if (found == CACHE_FOUND_AVAILABLE)
+      ++shard.hits_;
+    else
+      ++shard.misses_;
+
     return found;
   }
 
@@ -396,9 +510,9 @@ namespace TAO
   int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::update_entry (HASH_MAP_ENTRY &entry)
   {
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                              guard,
-                              *this->cache_lock_, -1));
+    Shard_Guard guard;
+    if (this->lock_entry_shard (entry, guard) == -1)
+      return -1;
 
     if (entry == 0)
       return -1;
@@ -411,11 +525,13 @@ namespace TAO
 
   template <typename TT, typename TRDT, typename PSTRAT>
   int
-  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::close_i (Connection_Handler_Set &handlers)
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::close_i (
+    Shard &shard,
+    Connection_Handler_Set &handlers)
   {
-    HASH_MAP_ITER end_iter = this->cache_map_.end ();
+    HASH_MAP_ITER end_iter = shard.cache_map_.end ();
 
-    for (HASH_MAP_ITER iter = this->cache_map_.begin ();
+    for (HASH_MAP_ITER iter = shard.cache_map_.begin ();
          iter != end_iter;
          ++iter)
       {
@@ -433,8 +549,9 @@ namespace TAO
       }
 
     // Unbind all the entries in the map
-    this->cache_map_.unbind_all ();
-    this->cache_size_ = 0;
+    shard.cache_map_.unbind_all ();
+    this->cache_size_ -= shard.size_;
+    shard.size_ = 0;
 
     return 0;
   }
@@ -442,11 +559,12 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   bool
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::blockable_client_transports_i (
+    Shard &shard,
     Connection_Handler_Set &h)
   {
-    HASH_MAP_ITER end_iter = this->cache_map_.end ();
+    HASH_MAP_ITER end_iter = shard.cache_map_.end ();
 
-    for (HASH_MAP_ITER iter = this->cache_map_.begin ();
+    for (HASH_MAP_ITER iter = shard.cache_map_.begin ();
          iter != end_iter;
          ++iter)
       {
@@ -471,14 +589,16 @@ namespace TAO
   int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::purge_entry_i (HASH_MAP_ENTRY &entry)
   {
+    Shard &shard = this->shards_[entry.shard];
     entry.elem->item ().remove (entry.item);
     delete entry.item;
-    this->cache_size_--;
+    --shard.size_;
+    --this->cache_size_;
     // Remove the entry from the Map
-    int retval = entry.elem->item ().is_empty () ? this->cache_map_.unbind (entry.elem) : 0;
+    int retval = entry.elem->item ().is_empty () ? shard.cache_map_.unbind (entry.elem) : 0;
 
 #if defined (TAO_HAS_MONITOR_POINTS) && (TAO_HAS_MONITOR_POINTS == 1)
-    this->size_monitor_->receive (this->cache_size_);
+    this->size_monitor_->receive (this->cache_size_.value ());
 #endif /* TAO_HAS_MONITOR_POINTS==1 */
 
     return retval;
@@ -589,76 +709,102 @@ namespace TAO
     typedef ACE_Unbounded_Set<transport_type*> transport_set_type;
     transport_set_type transports_to_be_closed;
 
-    {
-      ACE_MT (ACE_GUARD_RETURN (ACE_Lock, ace_mon, *this->cache_lock_, 0));
+    int const cache_maximum = this->purging_strategy_->cache_maximum ();
+    int const total_size = static_cast<int> (this->cache_size_.value ());
 
-      DESCRIPTOR_SET sorted_set = 0;
-      int const sorted_size = this->fill_set_i (sorted_set);
+    if (TAO_debug_level > 6)
+      {
+        TAOLIB_DEBUG ((LM_DEBUG,
+          ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
+          ACE_TEXT ("current_size [%d], cache_maximum [%d]\n"),
+          total_size, cache_maximum));
+      }
 
-      // Only call close_entries () if sorted_set != 0.  It takes
-      // control of sorted_set and cleans up any allocated memory.  If
-      // sorted_set == 0, then there is nothing to de-allocate.
-      if (sorted_set != 0)
-        {
-          // BEGIN FORMER close_entries
-          // Calculate the number of entries to purge, when we have
-          // to purge try to at least to purge minimal of 1 entry
-          // which is needed if we have a very small cache maximum
-          int const amount = (sorted_size * this->percent_) / 100;
+    // Do we need to worry about cache purging?
+    if (cache_maximum < 0 || total_size < cache_maximum)
+      return 0;
 
-          if (TAO_debug_level > 4)
-            {
-              TAOLIB_DEBUG ((LM_INFO,
-                ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
-                ACE_TEXT ("Trying to purge %d of %d cache entries\n"),
-                amount,
-                sorted_size));
-            }
+    // Each shard gives up its share of the entries to purge, the
+    // remainder is carried over so that with a single shard this is
+    // exactly <percent_> of the cache.  A shard holding too few
+    // purgable entries leaves the rest of its share to the next ones.
+    int carry = 0;
 
-          int count = 0;
+    for (size_t s = 0; s < this->shard_count_; ++s)
+      {
+        Shard_Guard guard (this->shards_[s]);
+        if (!guard.locked ())
+          return 0;
 
-          for (int i = 0; count < amount && i < sorted_size; ++i)
-            {
-              if (this->is_entry_purgable_i (sorted_set[i].item))
-                {
-                  transport_type* transport =
-                    sorted_set[i].item->transport ();
-                  sorted_set[i].item->recycle_state (ENTRY_BUSY);
-                  transport->add_reference ();
-
-                  if (TAO_debug_level > 4)
-                    {
-                      TAOLIB_DEBUG ((LM_INFO,
-                        ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
-                        ACE_TEXT ("Purgable Transport[%d] found in ")
-                        ACE_TEXT ("cache\n"),
-                        transport->id ()));
-                    }
-
-                  if (transports_to_be_closed.insert_tail (transport) != 0)
-                    {
-                      if (TAO_debug_level > 0)
-                        {
-                          TAOLIB_ERROR ((LM_ERROR,
-                            ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T")
-                            ACE_TEXT ("::purge, Unable to add transport[%d] ")
-                            ACE_TEXT ("on the to-be-closed set, so ")
-                            ACE_TEXT ("it will not be purged\n"),
-                            transport->id ()));
-                        }
-                      transport->remove_reference ();
-                    }
-
-                  // Count this as a successful purged entry
-                  ++count;
-                }
-            }
+        DESCRIPTOR_SET sorted_set = 0;
+        int const sorted_size = this->fill_set_i (this->shards_[s], sorted_set);
 
-          delete [] sorted_set;
-          sorted_set = 0;
-          // END FORMER close_entries
-        }
-    }
+        // Only close entries if sorted_set != 0.  If sorted_set == 0,
+        // then there is nothing to de-allocate.
+        if (sorted_set != 0)
+          {
+            // Calculate the number of entries to purge
+            carry += sorted_size * this->percent_;
+            int const amount = carry / 100;
+            carry %= 100;
+
+            if (TAO_debug_level > 4)
+              {
+                TAOLIB_DEBUG ((LM_INFO,
+                  ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
+                  ACE_TEXT ("Trying to purge %d of %d entries of shard %B\n"),
+                  amount,
+                  sorted_size,
+                  s));
+              }
+
+            int count = 0;
+
+            for (int i = 0; count < amount && i < sorted_size; ++i)
+              {
+                if (this->is_entry_purgable_i (sorted_set[i].item))
+                  {
+                    transport_type* transport =
+                      sorted_set[i].item->transport ();
+                    sorted_set[i].item->recycle_state (ENTRY_BUSY);
+                    transport->add_reference ();
+
+                    if (TAO_debug_level > 4)
+                      {
+                        TAOLIB_DEBUG ((LM_INFO,
+                          ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
+                          ACE_TEXT ("Purgable Transport[%d] found in ")
+                          ACE_TEXT ("cache\n"),
+                          transport->id ()));
+                      }
+
+                    if (transports_to_be_closed.insert_tail (transport) != 0)
+                      {
+                        if (TAO_debug_level > 0)
+                          {
+                            TAOLIB_ERROR ((LM_ERROR,
+                              ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T")
+                              ACE_TEXT ("::purge, Unable to add transport[%d] ")
+                              ACE_TEXT ("on the to-be-closed set, so ")
+                              ACE_TEXT ("it will not be purged\n"),
+                              transport->id ()));
+                          }
+                        transport->remove_reference ();
+                      }
+
+                    // Count this as a successful purged entry
+                    ++count;
+                  }
+              }
+
+            carry += (amount - count) * 100;
+
+            delete [] sorted_set;
+            sorted_set = 0;
+          }
+      }
+
+    int const closed = static_cast<int> (transports_to_be_closed.size ());
 
     // Now, without the lock held, lets go through and close all the transports.
     if (! transports_to_be_closed.is_empty ())
@@ -682,8 +828,8 @@ namespace TAO
       {
         TAOLIB_DEBUG ((LM_INFO,
           ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::purge, ")
-          ACE_TEXT ("Cache size after purging is [%d]\n"),
-          this->cache_size_
+          ACE_TEXT ("Cache size after purging is [%B]\n"),
+          this->cache_size_.value ()
           ));
       }
 
@@ -692,10 +838,10 @@ namespace TAO
     /// which is added automatically.
     this->purge_monitor_->receive (static_cast<size_t> (0UL));
     /// And update the size monitor as well.
-    this->size_monitor_->receive (this->cache_size_);
+    this->size_monitor_->receive (this->cache_size_.value ());
 #endif /* TAO_HAS_MONITOR_POINTS==1 */
 
-    return 0;
+    return closed;
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
@@ -731,43 +877,29 @@ namespace TAO
   template <typename TT, typename TRDT, typename PSTRAT>
   int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::
-    fill_set_i (DESCRIPTOR_SET& sorted_set)
+    fill_set_i (Shard &shard, DESCRIPTOR_SET& sorted_set)
   {
-    int current_size = 0;
-    int const cache_maximum = this->purging_strategy_->cache_maximum ();
+    int const current_size = static_cast<int> (shard.size_);
 
     // set sorted_set to 0.  This signifies nothing to purge.
     sorted_set = 0;
 
-    // Do we need to worry about cache purging?
-    if (cache_maximum >= 0)
+    if (current_size > 0)
       {
-        current_size = static_cast<int> (this->cache_size_);
+        ACE_NEW_RETURN (sorted_set, HASH_MAP_ENTRY[current_size], 0);
 
-        if (TAO_debug_level > 6)
-          {
-            TAOLIB_DEBUG ((LM_DEBUG,
-              ACE_TEXT ("TAO (%P|%t) - Transport_Cache_Manager_T::fill_set_i, ")
-              ACE_TEXT ("current_size [%d], cache_maximum [%d]\n"),
-              current_size, cache_maximum));
-          }
+        size_t const index = &shard - this->shards_;
+        HASH_MAP_ITER iter = shard.cache_map_.begin ();
 
-        if (current_size >= cache_maximum)
+        for (int i = 0; i < current_size; ++iter)
           {
-            ACE_NEW_RETURN (sorted_set, HASH_MAP_ENTRY[current_size], 0);
-
-            HASH_MAP_ITER iter = this->cache_map_.begin ();
-
-            for (int i = 0; i < current_size; ++iter)
-              {
-                for (Cache_IntId_Node *node (iter->item ().head ()); node; node = node->next (), ++i)
-                {
-                  sorted_set[i] = HASH_MAP_ENTRY(&(*iter), node);
-                }
-              }
-
-            this->sort_set (sorted_set, current_size);
+            for (Cache_IntId_Node *node (iter->item ().head ()); node; node = node->next (), ++i)
+            {
+              sorted_set[i] = HASH_MAP_ENTRY(&(*iter), node, index);
+            }
           }
+
+        this->sort_set (sorted_set, current_size);
       }
 
     return current_size;
@@ -20,6 +20,7 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "ace/Hash_Map_Manager_T.h"
+#include "ace/Atomic_Op.h"
 
 #include "tao/Cache_Entries_T.h"
 #include "tao/orbconf.h"
@@ -54,6 +55,11 @@ namespace TAO
    * map is updated only by holding the lock. The more compeling reason
    * to have the lock in this class and not in the Hash_Map is that, we
    * do quite a bit of work in this class for which we need a lock.
+   *
+   * The cache can be split into several shards, each with its own
+   * map and lock; an endpoint always goes to the shard selected by
+   * its hash.  Threads invoking on different endpoints then rarely
+   * wait for each other.  Purging works shard by shard.
    */
   template <typename TT, typename TRDT, typename PSTRAT>
   class Transport_Cache_Manager_T
@@ -94,24 +100,49 @@ namespace TAO
     struct HASH_MAP_ENTRY
     {
       HASH_MAP_ENTRY (void);
-      HASH_MAP_ENTRY (HASH_MAP_ELEM *elem, Cache_IntId_Node *item);
+      HASH_MAP_ENTRY (HASH_MAP_ELEM *elem,
+                      Cache_IntId_Node *item,
+                      size_t shard = 0);
 
       operator bool (void) const;
 
       HASH_MAP_ELEM *elem;
       Cache_IntId_Node *item;
+
+      /// The shard the entry is cached in.
+      size_t shard;
+    };
+
+    /// Counters of one shard, see shard_statistics().
+    struct Shard_Statistics
+    {
+      /// Number of transports in the shard.
+      size_t size;
+
+      /// Lookups that found an available transport.
+      size_t hits;
+
+      /// Lookups that did not.
+      size_t misses;
+
+      /// Times a thread had to wait for the shard lock.
+      size_t contended;
     };
 
     typedef TAO_Condition<TAO_SYNCH_MUTEX> CONDITION;
 
     // == Public methods
     /// Constructor
+    /**
+     * @param shards Number of independently locked parts of the cache.
+     */
     Transport_Cache_Manager_T (
       int percent,
       purging_strategy* purging_strategy,
       size_t cache_maximum,
       bool locked,
-      const char *orbid);
+      const char *orbid,
+      size_t shards = 1);
 
     /// Destructor
     ~Transport_Cache_Manager_T ();
@@ -135,6 +166,7 @@ namespace TAO
       size_t & busy_count);
 
     /// Remove entries from the cache depending upon the strategy.
+    /// Returns the number of transports closed.
     int purge ();
 
     /// Purge the entry from the Cache Map
@@ -170,7 +202,78 @@ namespace TAO
      */
     bool blockable_client_transports (Connection_Handler_Set &handlers);
 
+    /// Number of shards of the cache.
+    size_t shard_count () const;
+
+    /// Get the counters of @a shard.  Returns -1 if there is no such
+    /// shard.
+    int shard_statistics (size_t shard, Shard_Statistics &stats);
+
+    /// Number of transports in the cache.
+    size_t current_size () const;
+
   private:
+    /// One part of the cache.
+    struct Shard
+    {
+      Shard ();
+      ~Shard ();
+
+      /// The hash map that has the connections
+      HASH_MAP cache_map_;
+
+      TAO_SYNCH_MUTEX cache_map_mutex_;
+
+      /// The lock that is used by the cache map
+      ACE_Lock *cache_lock_;
+
+      /// Number of connections in this shard.
+      size_t size_;
+
+      /// Counters, updated while holding the lock.
+      size_t hits_;
+      size_t misses_;
+      size_t contended_;
+    };
+
+    /**
+     * @class Shard_Guard
+     *
+     * @brief Holds the lock of a shard, counting the times it was
+     * busy.
+     */
+    class Shard_Guard
+    {
+    public:
+      Shard_Guard ();
+      explicit Shard_Guard (Shard &shard);
+      ~Shard_Guard ();
+
+      /// Lock @a shard, releasing the shard held before.  Returns -1
+      /// on failure.
+      int acquire (Shard &shard);
+      void release ();
+      bool locked () const;
+
+    private:
+      Shard *shard_;
+
+      Shard_Guard (const Shard_Guard &) = delete;
+      Shard_Guard &operator= (const Shard_Guard &) = delete;
+    };
+
+    /// Shard for transports with descriptors of hash @a hash.
+    size_t shard_index (u_long hash) const;
+
+    /**
+     * Lock the shard @a entry is cached in.  The entry belongs to a
+     * transport and may be bound or purged by other threads, so the
+     * shard is checked again once its lock is held.  When this
+     * returns 0 either @a entry is in the locked shard or it is not
+     * cached at all.
+     */
+    int lock_entry_shard (HASH_MAP_ENTRY &entry, Shard_Guard &guard);
+
     /// Lookup entry<key,value> in the cache. Grabs the lock and calls the
     /// implementation function find_i.
     Find_Result find (
@@ -184,7 +287,7 @@ namespace TAO
      * bind succeeds, it adds the Hash_Map_Entry in to the
      * Transport for its reference.
      */
-    int bind_i (Cache_ExtId &ext_id, Cache_IntId_Node &int_id);
+    int bind_i (size_t shard, Cache_ExtId &ext_id, Cache_IntId_Node &int_id);
 
     /**
      * Non-locking version and actual implementation of find ()
@@ -193,6 +296,7 @@ namespace TAO
      * get_idle_transport ().
      */
     Find_Result find_i (
+      Shard &shard,
       transport_descriptor_type *prop,
       transport_type *&transport,
       size_t & busy_count);
@@ -201,7 +305,7 @@ namespace TAO
     int make_idle_i (HASH_MAP_ENTRY &entry);
 
     /// Non-locking version and actual implementation of close ()
-    int close_i (Connection_Handler_Set &handlers);
+    int close_i (Shard &shard, Connection_Handler_Set &handlers);
 
     /// Purge the entry from the Cache Map
     int purge_entry_i (HASH_MAP_ENTRY &entry);
@@ -232,12 +336,13 @@ namespace TAO
     /// Sort the list of entries
     void sort_set (DESCRIPTOR_SET& entries, int size);
 
-    /// Fill sorted_set in with the transport_descriptor_type's in
-    /// a sorted order.
-    int fill_set_i (DESCRIPTOR_SET& sorted_set);
+    /// Fill sorted_set in with the transport_descriptor_type's of
+    /// @a shard in a sorted order.
+    int fill_set_i (Shard &shard, DESCRIPTOR_SET& sorted_set);
 
     /// Non-locking version of blockable_client_transports ().
-    bool blockable_client_transports_i (Connection_Handler_Set &handlers);
+    bool blockable_client_transports_i (Shard &shard,
+                                        Connection_Handler_Set &handlers);
 
   private:
     /// The percentage of the cache to purge at one time
@@ -246,16 +351,12 @@ namespace TAO
     /// The underlying connection purging strategy
     purging_strategy *purging_strategy_;
 
-    /// The hash map that has the connections
-    HASH_MAP cache_map_;
-
-    /// Total number of connections in the hash map
-    size_t cache_size_;
-
-    TAO_SYNCH_MUTEX cache_map_mutex_;
+    /// The parts of the cache.
+    Shard *shards_;
+    size_t shard_count_;
 
-    /// The lock that is used by the cache map
-    ACE_Lock *cache_lock_;
+    /// Total number of connections in all shards
+    ACE_Atomic_Op<TAO_SYNCH_MUTEX, size_t> cache_size_;
 
     /// Maximum size of the cache
     size_t cache_maximum_;
@@ -8,16 +8,18 @@ namespace TAO
   ACE_INLINE
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::HASH_MAP_ENTRY::HASH_MAP_ENTRY (void)
     : elem(0),
-      item(0)
+      item(0),
+      shard(0)
   {
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::HASH_MAP_ENTRY::HASH_MAP_ENTRY (
-    HASH_MAP_ELEM *elem, Cache_IntId_Node *item)
+    HASH_MAP_ELEM *elem, Cache_IntId_Node *item, size_t shard)
     : elem(elem),
-      item(item)
+      item(item),
+      shard(shard)
   {
   }
 
@@ -28,6 +30,94 @@ namespace TAO
     return item;
   }
 
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard_Guard::Shard_Guard ()
+    : shard_ (0)
+  {
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard_Guard::Shard_Guard (
+    Shard &shard)
+    : shard_ (0)
+  {
+    this->acquire (shard);
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard_Guard::~Shard_Guard ()
+  {
+    this->release ();
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE int
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard_Guard::acquire (
+    Shard &shard)
+  {
+    this->release ();
+
+    if (shard.cache_lock_->tryacquire () == -1)
+      {
+        if (shard.cache_lock_->acquire () == -1)
+          return -1;
+        ++shard.contended_;
+      }
+
+    this->shard_ = &shard;
+    return 0;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE void
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard_Guard::release ()
+  {
+    if (this->shard_ != 0)
+      {
+        this->shard_->cache_lock_->release ();
+        this->shard_ = 0;
+      }
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE bool
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::Shard_Guard::locked () const
+  {
+    return this->shard_ != 0;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE size_t
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::shard_index (u_long hash) const
+  {
+    if (this->shard_count_ == 1)
+      return 0;
+
+    // The low bits of an endpoint hash hardly vary, the servers on a
+    // host often all listen on odd ports, so mix in the high bits.
+    ACE_UINT32 h = static_cast<ACE_UINT32> (hash);
+    h ^= h >> 16;
+    h *= 0x45d9f3bU;
+    h ^= h >> 16;
+    return h % this->shard_count_;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE size_t
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::shard_count () const
+  {
+    return this->shard_count_;
+  }
+
+  template <typename TT, typename TRDT, typename PSTRAT>
+  ACE_INLINE size_t
+  Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::current_size () const
+  {
+    return this->cache_size_.value ();
+  }
 
   template <typename TT, typename TRDT, typename PSTRAT>
   ACE_INLINE int
@@ -38,22 +128,42 @@ namespace TAO
   {
     // Compose the ExternId & Intid
     Cache_ExtId ext_id (prop);
+    size_t const shard = this->shard_index (ext_id.hash ());
     int retval = 0;
-    {
-      ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                                guard,
-                                *this->cache_lock_,
-                                -1));
-      Cache_IntId_Node int_id (transport);
-
-      // If it has already connected, go directly to the IDLE_BNP state
-      if (int_id.is_connected () && state == ENTRY_CONNECTING)
-        int_id.recycle_state (ENTRY_IDLE_AND_PURGABLE);
-      else
-        int_id.recycle_state (state);
-
-      retval = this->bind_i (ext_id, int_id);
-    }
+
+    // The connector purges the cache before it connects, but other
+    // threads may have filled it since.  Purge it again rather than
+    // fail the connection, as long as that, or another thread, makes
+    // room.
+    bool retried = false;
+    for (;;)
+      {
+        {
+          Shard_Guard guard (this->shards_[shard]);
+          if (!guard.locked ())
+            return -1;
+
+          Cache_IntId_Node int_id (transport);
+
+          // If it has already connected, go directly to the IDLE_BNP state
+          if (int_id.is_connected () && state == ENTRY_CONNECTING)
+            int_id.recycle_state (ENTRY_IDLE_AND_PURGABLE);
+          else
+            int_id.recycle_state (state);
+
+          retval = this->bind_i (shard, ext_id, int_id);
+        }
+
+        if (retval == 0)
+          break;
+
+        if (this->purge () == 0)
+          {
+            if (retried)
+              break;
+            retried = true;
+          }
+      }
 
     return retval;
   }
@@ -67,7 +177,9 @@ namespace TAO
     if (entry != 0)
     {
       HASH_MAP_ENTRY cached_entry;
-      ACE_MT (ACE_GUARD_RETURN (ACE_Lock, guard, *this->cache_lock_, -1));
+      Shard_Guard guard;
+      if (this->lock_entry_shard (entry, guard) == -1)
+        return -1;
       if (entry != 0) // in case someone beat us to it (entry is reference to transport member)
       {
         // Store the entry in a temporary and zero out the reference.
@@ -89,8 +201,8 @@ namespace TAO
   ACE_INLINE void
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::mark_connected (HASH_MAP_ENTRY &entry, bool state)
   {
-    ACE_MT (ACE_GUARD (ACE_Lock, guard, *this->cache_lock_));
-    if (entry == 0)
+    Shard_Guard guard;
+    if (this->lock_entry_shard (entry, guard) == -1 || entry == 0)
       return;
 
     if (TAO_debug_level > 9 && state != entry.item->is_connected ())
@@ -105,7 +217,9 @@ namespace TAO
   ACE_INLINE int
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::make_idle (HASH_MAP_ENTRY &entry)
   {
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock, guard, *this->cache_lock_, -1));
+    Shard_Guard guard;
+    if (this->lock_entry_shard (entry, guard) == -1)
+      return -1;
     if (entry == 0) // in case someone beat us to it (entry is reference to transport member)
       return -1;
 
@@ -118,12 +232,12 @@ namespace TAO
                                  transport_type *&transport,
                                  size_t &busy_count)
   {
-    ACE_MT (ACE_GUARD_RETURN  (ACE_Lock,
-                               guard,
-                               *this->cache_lock_,
-                               CACHE_FOUND_NONE));
+    Shard &shard = this->shards_[this->shard_index (prop->hash ())];
+    Shard_Guard guard (shard);
+    if (!guard.locked ())
+      return CACHE_FOUND_NONE;
 
-    return this->find_i (prop, transport, busy_count);
+    return this->find_i (shard, prop, transport, busy_count);
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
@@ -131,19 +245,21 @@ namespace TAO
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::
     close (Connection_Handler_Set &handlers)
   {
-    // The cache lock pointer should only be zero if
-    // Transport_Cache_Manager_T::open() was never called.  Note that
-    // only one thread opens the Transport_Cache_Manager_T at any given
-    // time, so it is safe to check for a non-zero lock pointer.
-    if (this->cache_lock_ == 0)
+    // The shards should only be missing if the constructor failed to
+    // allocate them.
+    if (this->shards_ == 0)
       return -1;
 
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                              guard,
-                              *this->cache_lock_,
-                              -1));
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      {
+        Shard_Guard guard (this->shards_[i]);
+        if (!guard.locked ())
+          return -1;
+
+        this->close_i (this->shards_[i], handlers);
+      }
 
-    return this->close_i (handlers);
+    return 0;
   }
 
   template <typename TT, typename TRDT, typename PSTRAT>
@@ -151,12 +267,16 @@ namespace TAO
   Transport_Cache_Manager_T<TT, TRDT, PSTRAT>::blockable_client_transports (
     Connection_Handler_Set &handlers)
   {
-    ACE_MT (ACE_GUARD_RETURN (ACE_Lock,
-                              guard,
-                              *this->cache_lock_,
-                              false));
+    for (size_t i = 0; i < this->shard_count_; ++i)
+      {
+        Shard_Guard guard (this->shards_[i]);
+        if (!guard.locked ())
+          return false;
+
+        this->blockable_client_transports_i (this->shards_[i], handlers);
+      }
 
-    return this->blockable_client_transports_i (handlers);
+    return true;
   }
 }
 
@@ -13,6 +13,7 @@
 #include "tao/CORBA_String.h"
 #include "tao/SystemException.h"
 #include "tao/Basic_Types_IDLv4.h"
+#include "tao/CDR_Native_Layout_T.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -366,9 +367,20 @@ namespace TAO {
     if (new_length > strm.length()) {
       return false;
     }
+    bool const native = TAO::is_native_layout<value_t> (strm);
+    if (native && new_length > strm.length() / sizeof (value_t)) {
+      return false;
+    }
     sequence tmp(new_length);
     tmp.length(new_length);
     typename sequence::value_type * buffer = tmp.get_buffer();
+    if (native) {
+      if (!TAO::read_native_layout (strm, buffer, new_length)) {
+        return false;
+      }
+      tmp.swap(target);
+      return true;
+    }
     for(CORBA::ULong i = 0; i < new_length; ++i) {
       if (!(strm >> buffer[i])) {
         return false;
@@ -468,6 +480,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::SHORT_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::SHORT_SIZE,
+                                        ACE_CDR::SHORT_ALIGN,
+                                        length);
+    }
     return strm.write_short_array (source.get_buffer (), length);
   }
 
@@ -477,6 +495,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONG_SIZE,
+                                        ACE_CDR::LONG_ALIGN,
+                                        length);
+    }
     return strm.write_long_array (source.get_buffer (), length);
   }
 
@@ -486,6 +510,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONG_SIZE,
+                                        ACE_CDR::LONG_ALIGN,
+                                        length);
+    }
     return strm.write_ulong_array (source.get_buffer (), length);
   }
 
@@ -495,6 +525,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::SHORT_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::SHORT_SIZE,
+                                        ACE_CDR::SHORT_ALIGN,
+                                        length);
+    }
     return strm.write_ushort_array (source.get_buffer (), length);
   }
 
@@ -508,6 +544,12 @@ namespace TAO {
     if (source.mb ()) {
       return strm.write_octet_array_mb (source.mb ());
     }
+    if (strm.zero_copy_array (length * ACE_CDR::OCTET_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::OCTET_SIZE,
+                                        ACE_CDR::OCTET_ALIGN,
+                                        length);
+    }
     return strm.write_octet_array (source.get_buffer (), length);
   }
 #else
@@ -517,6 +559,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::OCTET_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::OCTET_SIZE,
+                                        ACE_CDR::OCTET_ALIGN,
+                                        length);
+    }
     return strm.write_octet_array (source.get_buffer (), length);
   }
 #endif
@@ -547,6 +595,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONG_SIZE,
+                                        ACE_CDR::LONG_ALIGN,
+                                        length);
+    }
     return strm.write_float_array (source.get_buffer (), length);
   }
 
@@ -556,6 +610,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONGLONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONGLONG_SIZE,
+                                        ACE_CDR::LONGLONG_ALIGN,
+                                        length);
+    }
     return strm.write_double_array (source.get_buffer (), length);
   }
 
@@ -565,6 +625,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONGLONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONGLONG_SIZE,
+                                        ACE_CDR::LONGLONG_ALIGN,
+                                        length);
+    }
     return strm.write_longlong_array (source.get_buffer (), length);
   }
 
@@ -574,6 +640,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::LONGLONG_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::LONGLONG_SIZE,
+                                        ACE_CDR::LONGLONG_ALIGN,
+                                        length);
+    }
     return strm.write_ulonglong_array (source.get_buffer (), length);
   }
 
@@ -602,6 +674,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::OCTET_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::OCTET_SIZE,
+                                        ACE_CDR::OCTET_ALIGN,
+                                        length);
+    }
     return strm.write_uint8_array (source.get_buffer (), length);
   }
 
@@ -612,6 +690,12 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (strm.zero_copy_array (length * ACE_CDR::OCTET_SIZE)) {
+      return strm.write_array_external (source.get_buffer (),
+                                        ACE_CDR::OCTET_SIZE,
+                                        ACE_CDR::OCTET_ALIGN,
+                                        length);
+    }
     return strm.write_int8_array (source.get_buffer (), length);
   }
 
@@ -621,6 +705,15 @@ namespace TAO {
     if (!(strm << length)) {
       return false;
     }
+    if (TAO::is_native_layout<value_t> (strm)) {
+      if (strm.zero_copy_array (length * sizeof (value_t))) {
+        return strm.write_array_external (source.get_buffer (),
+                                          sizeof (value_t),
+                                          TAO::CDR_Native_Layout<value_t>::alignment,
+                                          length);
+      }
+      return TAO::write_native_layout (strm, source.get_buffer (), length);
+    }
     for(CORBA::ULong i = 0; i < length; ++i) {
       if (!(strm << source[i])) {
         return false;
@@ -0,0 +1,144 @@
+#include "tao/Wait_On_Busy_Poll.h"
+#include "tao/Leader_Follower.h"
+#include "tao/Transport.h"
+#include "tao/Synch_Reply_Dispatcher.h"
+#include "tao/ORB_Core.h"
+#include "tao/ORB_Time_Policy.h"
+#include "tao/debug.h"
+
+#include "ace/ACE.h"
+#include "ace/Event_Handler.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Min_Max.h"
+#include "ace/OS_NS_sys_socket.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Wait_On_Busy_Poll::TAO_Wait_On_Busy_Poll (TAO_Transport *transport,
+                                              ACE_UINT32 max_poll_time)
+  : TAO_Wait_On_Leader_Follower (transport)
+  , max_poll_time_ (max_poll_time)
+  , poll_time_ (max_poll_time)
+  , socket_busy_poll_ (false)
+{
+}
+
+int
+TAO_Wait_On_Busy_Poll::sending_request (TAO_ORB_Core *orb_core,
+                                        TAO_Message_Semantics msg_semantics)
+{
+#if defined (SO_BUSY_POLL)
+  if (!this->socket_busy_poll_ && this->max_poll_time_ > 0)
+    {
+      // Only try once, transports that are not sockets and kernels
+      // that refuse the option keep waiting on the reactor alone.
+      this->socket_busy_poll_ = true;
+
+      int busy_poll = static_cast<int> (this->max_poll_time_);
+      ACE_HANDLE const handle =
+        this->transport_->event_handler_i ()->get_handle ();
+
+      if (ACE_OS::setsockopt (handle,
+                              SOL_SOCKET,
+                              SO_BUSY_POLL,
+                              reinterpret_cast<const char *> (&busy_poll),
+                              sizeof busy_poll) == -1
+          && TAO_debug_level > 5)
+        {
+          TAOLIB_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - Wait_On_Busy_Poll[%d]::")
+                      ACE_TEXT ("sending_request, SO_BUSY_POLL not set - %m\n"),
+                      this->transport_->id ()));
+        }
+    }
+#endif /* SO_BUSY_POLL */
+
+  return this->TAO_Wait_On_Leader_Follower::sending_request (orb_core,
+                                                            msg_semantics);
+}
+
+int
+TAO_Wait_On_Busy_Poll::wait (ACE_Time_Value *max_wait_time,
+                             TAO_Synch_Reply_Dispatcher &rd)
+{
+  ACE_Time_Value const start = ACE_High_Res_Timer::gettimeofday_hr ();
+  ACE_UINT64 const poll_time = this->poll_time_.load (std::memory_order_relaxed);
+
+  if (poll_time > 0)
+    {
+      TAO::ORB_Countdown_Time countdown (max_wait_time);
+      this->poll (max_wait_time, rd, poll_time);
+    }
+
+  // Returns right away if the reply came while polling.
+  TAO_Leader_Follower &leader_follower =
+    this->transport_->orb_core ()->leader_follower ();
+  int const result =
+    leader_follower.wait_for_event (&rd, this->transport_, max_wait_time);
+
+  if (result == 0)
+    {
+      // Move the window towards twice the round trip, or towards
+      // zero if spinning that long is not worth it.
+      ACE_UINT64 round_trip = 0;
+      (ACE_High_Res_Timer::gettimeofday_hr () - start).to_usec (round_trip);
+
+      ACE_UINT64 const target =
+        round_trip > this->max_poll_time_
+          ? 0
+          : ace_min (2 * round_trip, this->max_poll_time_);
+
+      this->poll_time_.store ((3 * poll_time + target) / 4,
+                              std::memory_order_relaxed);
+    }
+
+  return result;
+}
+
+void
+TAO_Wait_On_Busy_Poll::poll (ACE_Time_Value *max_wait_time,
+                             TAO_Synch_Reply_Dispatcher &rd,
+                             ACE_UINT64 poll_time)
+{
+  TAO_Leader_Follower &leader_follower =
+    this->transport_->orb_core ()->leader_follower ();
+
+  ACE_Time_Value const now = ACE_High_Res_Timer::gettimeofday_hr ();
+  ACE_Time_Value window (0, static_cast<suseconds_t> (poll_time));
+  if (max_wait_time != nullptr && *max_wait_time < window)
+    {
+      window = *max_wait_time;
+    }
+  ACE_Time_Value const deadline = now + window;
+
+  ACE_HANDLE const handle =
+    this->transport_->event_handler_i ()->get_handle ();
+
+  while (rd.keep_waiting (leader_follower))
+    {
+      // Data for a connection nobody reads: become the leader now
+      // instead of spinning until the window closes.
+      int const ready =
+        ACE::handle_read_ready (handle, &ACE_Time_Value::zero);
+      if (ready == -1 && errno != ETIME)
+        {
+          return;
+        }
+
+      if (ready == 1)
+        {
+          ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, leader_follower.lock ());
+          if (!leader_follower.leader_available ())
+            {
+              return;
+            }
+        }
+
+      if (ACE_High_Res_Timer::gettimeofday_hr () >= deadline)
+        {
+          return;
+        }
+    }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,86 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Wait_On_Busy_Poll.h
+ */
+//=============================================================================
+
+#ifndef TAO_WAIT_ON_BUSY_POLL_H
+#define TAO_WAIT_ON_BUSY_POLL_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/Wait_On_Leader_Follower.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Basic_Types.h"
+
+#include <atomic>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Wait_On_Busy_Poll
+ *
+ * @brief Poll for the reply for a short while before waiting
+ * according to the Leader-Follower model.
+ *
+ * The waiting thread first spins, checking whether the reply has
+ * been dispatched by the leader thread and whether the connection
+ * has become readable.  A reply that arrives in that window does
+ * not cost a thread wakeup: the leader completes the event while
+ * the client is still running, and if there is no leader the
+ * client becomes one with the data already waiting.  After the
+ * window the thread waits in TAO_Leader_Follower::wait_for_event()
+ * as TAO_Wait_On_Leader_Follower does.
+ *
+ * The window adapts to the round-trip times seen on the transport:
+ * it moves towards twice the last round trip, and towards zero when
+ * the round trip is longer than the configured maximum, so that slow
+ * servers do not cost a spinning CPU.  Where the platform provides
+ * SO_BUSY_POLL the socket is also asked to busy poll the device
+ * queue for the maximum time.
+ */
+class TAO_Wait_On_Busy_Poll : public TAO_Wait_On_Leader_Follower
+{
+public:
+  /// Constructor, spin for at most @a max_poll_time microseconds.
+  TAO_Wait_On_Busy_Poll (TAO_Transport *transport,
+                         ACE_UINT32 max_poll_time);
+
+  /// Destructor.
+  ~TAO_Wait_On_Busy_Poll () override = default;
+
+   /*! @copydoc TAO_Wait_Strategy::sending_request() */
+  int sending_request (TAO_ORB_Core *orb_core, TAO_Message_Semantics msg_semantics) override;
+
+   /*! @copydoc TAO_Wait_Strategy::wait() */
+  int wait (ACE_Time_Value *max_wait_time, TAO_Synch_Reply_Dispatcher &rd) override;
+
+private:
+  /// Spin until the reply is dispatched, the connection is readable
+  /// with no leader to read it, or @a poll_time microseconds pass.
+  void poll (ACE_Time_Value *max_wait_time,
+             TAO_Synch_Reply_Dispatcher &rd,
+             ACE_UINT64 poll_time);
+
+  /// Configured maximum in microseconds.
+  ACE_UINT64 const max_poll_time_;
+
+  /// Current window in microseconds.  Several threads may wait on a
+  /// muxed transport, the window is only a hint.
+  std::atomic<ACE_UINT64> poll_time_;
+
+  /// Has SO_BUSY_POLL been set on the socket?
+  bool socket_busy_poll_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_WAIT_ON_BUSY_POLL_H */
@@ -4,6 +4,7 @@
 #include "tao/Wait_On_Reactor.h"
 #include "tao/Wait_On_Leader_Follower.h"
 #include "tao/Wait_On_LF_No_Upcall.h"
+#include "tao/Wait_On_Busy_Poll.h"
 #include "tao/Exclusive_TMS.h"
 #include "tao/Muxed_TMS.h"
 #include "tao/Blocked_Connect_Strategy.h"
@@ -24,6 +25,7 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 TAO_Default_Client_Strategy_Factory::TAO_Default_Client_Strategy_Factory ()
   : transport_mux_strategy_ (TAO_MUXED_TMS)
   , wait_strategy_ (TAO_WAIT_ON_LEADER_FOLLOWER)
+  , busy_poll_time_ (TAO_DEFAULT_BUSY_POLL_TIME)
   , connect_strategy_ (TAO_LEADER_FOLLOWER_CONNECT)
   , rd_table_size_ (TAO_RD_TABLE_SIZE)
   , muxed_strategy_lock_type_ (TAO_THREAD_LOCK)
@@ -99,6 +101,9 @@ TAO_Default_Client_Strategy_Factory::parse_args (int argc, ACE_TCHAR* argv[])
               else if (ACE_OS::strcasecmp (name,
                                            ACE_TEXT("MT_NOUPCALL")) == 0)
                 this->wait_strategy_ = TAO_WAIT_ON_LF_NO_UPCALL;
+              else if (ACE_OS::strcasecmp (name,
+                                           ACE_TEXT("BUSY_POLL")) == 0)
+                this->wait_strategy_ = TAO_WAIT_ON_BUSY_POLL;
               else
                 this->report_option_value_error (
                   ACE_TEXT("-ORBClientConnectionHandler"), name);
@@ -204,6 +209,22 @@ TAO_Default_Client_Strategy_Factory::parse_args (int argc, ACE_TCHAR* argv[])
 
           }
       }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT("-ORBBusyPollTime")) == 0)
+        {
+          curarg++;
+          if (curarg < argc)
+            {
+              ACE_TCHAR* value = argv[curarg];
+              int const usecs = ACE_OS::atoi (value);
+
+              if (usecs >= 0)
+                this->busy_poll_time_ = static_cast<ACE_UINT32> (usecs);
+              else
+                this->report_option_value_error (
+                  ACE_TEXT("-ORBBusyPollTime"), value);
+            }
+        }
       else if (ACE_OS::strcasecmp (argv[curarg],
                                    ACE_TEXT("-ORBReplyDispatcherTableSize"))
                == 0)
@@ -459,6 +480,14 @@ TAO_Default_Client_Strategy_Factory::create_wait_strategy (
                           nullptr);
           break;
         }
+      case TAO_WAIT_ON_BUSY_POLL:
+        {
+          ACE_NEW_RETURN (ws,
+                          TAO_Wait_On_Busy_Poll (transport,
+                                                 this->busy_poll_time_),
+                          nullptr);
+          break;
+        }
     }
 
   return ws;
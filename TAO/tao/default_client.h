@@ -87,12 +87,17 @@ private:
     TAO_WAIT_ON_LEADER_FOLLOWER,
     TAO_WAIT_ON_REACTOR,
     TAO_WAIT_ON_READ,
-    TAO_WAIT_ON_LF_NO_UPCALL
+    TAO_WAIT_ON_LF_NO_UPCALL,
+    TAO_WAIT_ON_BUSY_POLL
   };
 
   /// The wait-for-reply strategy.
   Wait_Strategy wait_strategy_;
 
+  /// Longest time in microseconds the BUSY_POLL wait strategy spins
+  /// before it waits on the leader follower.
+  ACE_UINT32 busy_poll_time_;
+
   /// The connection initiation strategy.
   Connect_Strategy connect_strategy_;
 
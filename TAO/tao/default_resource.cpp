@@ -24,6 +24,7 @@
 #include "ace/Reactor.h"
 #include "ace/Malloc_T.h"
 #include "ace/Local_Memory_Pool.h"
+#include "ace/Thread_Caching_Allocator_T.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_strings.h"
 
@@ -110,6 +111,8 @@ TAO_Default_Resource_Factory::TAO_Default_Resource_Factory ()
   , cache_maximum_ (TAO_CONNECTION_CACHE_MAXIMUM)
   , purge_percentage_ (TAO_PURGE_PERCENT)
   , max_muxed_connections_ (0)
+  , transport_cache_shards_ (TAO_TRANSPORT_CACHE_SHARDS)
+  , object_key_table_shards_ (TAO_OBJECTKEY_TABLE_SHARDS)
   , reactor_mask_signals_ (1)
   , dynamically_allocated_reactor_ (false)
   , options_processed_ (0)
@@ -124,6 +127,7 @@ TAO_Default_Resource_Factory::TAO_Default_Resource_Factory ()
 #else
   , use_local_memory_pool_ (false)
 #endif
+  , cdr_allocator_thread_cache_ (TAO_CDR_ALLOCATOR_THREAD_CACHE)
   , cached_connection_lock_type_ (TAO_THREAD_LOCK)
 #if defined (TAO_USE_BLOCKING_FLUSHING)
   , flushing_strategy_type_ (TAO_BLOCKING_FLUSHING)
@@ -324,6 +328,26 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
           this->report_option_value_error (ACE_TEXT("-ORBConnectionCacheMax"), argv[curarg]);
       }
 
+   else if (ACE_OS::strcasecmp (argv[curarg],
+                                ACE_TEXT("-ORBConnectionCacheShards")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc && ACE_OS::atoi (argv[curarg]) > 0)
+            this->transport_cache_shards_ = ACE_OS::atoi (argv[curarg]);
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBConnectionCacheShards"), argv[curarg]);
+      }
+
+   else if (ACE_OS::strcasecmp (argv[curarg],
+                                ACE_TEXT("-ORBObjectKeyTableShards")) == 0)
+      {
+        ++curarg;
+        if (curarg < argc && ACE_OS::atoi (argv[curarg]) >= 0)
+            this->object_key_table_shards_ = ACE_OS::atoi (argv[curarg]);
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBObjectKeyTableShards"), argv[curarg]);
+      }
+
    else if (ACE_OS::strcasecmp (argv[curarg],
                                 ACE_TEXT("-ORBConnectionCachePurgePercentage")) == 0)
       {
@@ -475,6 +499,24 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
               }
           }
       }
+    else if (0 == ACE_OS::strcasecmp (argv[curarg],
+                                      ACE_TEXT("-ORBCDRAllocatorThreadCache")))
+      {
+        ++curarg;
+        if (curarg < argc)
+          {
+            int const tmp = ACE_OS::atoi (argv[curarg]);
+
+            if (tmp < 0)
+              this->report_option_value_error (
+                ACE_TEXT("-ORBCDRAllocatorThreadCache"), argv[curarg]);
+            else
+              this->cdr_allocator_thread_cache_ = static_cast<size_t> (tmp);
+          }
+        else
+          this->report_option_value_error (
+            ACE_TEXT("-ORBCDRAllocatorThreadCache"), argv[curarg]);
+      }
     else if (0 == ACE_OS::strcasecmp (argv[curarg],
                                       ACE_TEXT("-ORBZeroCopyWrite")))
       {
@@ -830,6 +872,29 @@ typedef ACE_Malloc<ACE_LOCAL_MEMORY_POOL,TAO_SYNCH_MUTEX> LOCKED_MALLOC;
 typedef ACE_Allocator_Adapter<LOCKED_MALLOC> LOCKED_ALLOCATOR_POOL;
 typedef ACE_New_Allocator LOCKED_ALLOCATOR_NO_POOL;
 
+typedef ACE_Thread_Caching_Allocator<TAO_SYNCH_MUTEX> THREAD_CACHED_ALLOCATOR;
+
+ACE_Allocator *
+TAO_Default_Resource_Factory::thread_cached_allocator (
+  ACE_Allocator *allocator) const
+{
+  if (allocator == nullptr || this->cdr_allocator_thread_cache_ == 0)
+    return allocator;
+
+  ACE_Allocator *cached = nullptr;
+  ACE_NEW_NORETURN (cached,
+                    THREAD_CACHED_ALLOCATOR (
+                      ACE_DEFAULT_THREAD_CACHE_MAX_SIZE,
+                      this->cdr_allocator_thread_cache_,
+                      ACE_DEFAULT_THREAD_CACHE_DEPOT_SIZE,
+                      allocator,
+                      true));
+  if (cached == nullptr)
+    delete allocator;
+
+  return cached;
+}
+
 void
 TAO_Default_Resource_Factory::use_local_memory_pool (bool flag)
 {
@@ -856,7 +921,7 @@ TAO_Default_Resource_Factory::input_cdr_dblock_allocator ()
                     nullptr);
   }
 
-  return allocator;
+  return this->thread_cached_allocator (allocator);
 }
 
 ACE_Allocator *
@@ -876,7 +941,7 @@ TAO_Default_Resource_Factory::input_cdr_buffer_allocator ()
                     nullptr);
   }
 
-  return allocator;
+  return this->thread_cached_allocator (allocator);
 }
 
 ACE_Allocator *
@@ -896,7 +961,7 @@ TAO_Default_Resource_Factory::input_cdr_msgblock_allocator ()
                     nullptr);
   }
 
-  return allocator;
+  return this->thread_cached_allocator (allocator);
 }
 
 int
@@ -922,7 +987,7 @@ TAO_Default_Resource_Factory::output_cdr_dblock_allocator ()
                     nullptr);
   }
 
-  return allocator;
+  return this->thread_cached_allocator (allocator);
 }
 
 ACE_Allocator *
@@ -945,7 +1010,8 @@ TAO_Default_Resource_Factory::output_cdr_buffer_allocator ()
                       TAO_MMAP_Allocator,
                       nullptr);
 
-      break;
+      // Not cached, sendfile() needs to find the chunks in the mapping.
+      return allocator;
 #endif  /* TAO_HAS_SENDFILE==1 */
 
     case DEFAULT:
@@ -957,7 +1023,7 @@ TAO_Default_Resource_Factory::output_cdr_buffer_allocator ()
       break;
     }
 
-  return allocator;
+  return this->thread_cached_allocator (allocator);
 }
 
 ACE_Allocator*
@@ -977,7 +1043,7 @@ TAO_Default_Resource_Factory::output_cdr_msgblock_allocator ()
                     nullptr);
   }
 
-  return allocator;
+  return this->thread_cached_allocator (allocator);
 }
 
 ACE_Allocator*
@@ -1038,6 +1104,18 @@ TAO_Default_Resource_Factory::max_muxed_connections () const
   return this->max_muxed_connections_;
 }
 
+int
+TAO_Default_Resource_Factory::transport_cache_shards () const
+{
+  return this->transport_cache_shards_;
+}
+
+int
+TAO_Default_Resource_Factory::object_key_table_shards () const
+{
+  return this->object_key_table_shards_;
+}
+
 
 ACE_Lock *
 TAO_Default_Resource_Factory::create_cached_connection_lock ()
@@ -173,6 +173,8 @@ public:
   virtual int cache_maximum () const;
   virtual int purge_percentage () const;
   virtual int max_muxed_connections () const;
+  virtual int transport_cache_shards () const;
+  virtual int object_key_table_shards () const;
   virtual ACE_Lock *create_cached_connection_lock ();
   virtual int locked_transport_cache ();
   virtual TAO_Flushing_Strategy *create_flushing_strategy ();
@@ -206,6 +208,10 @@ protected:
   void report_option_value_error (const ACE_TCHAR* option_name,
                                   const ACE_TCHAR* option_value);
 
+  /// Wrap @a allocator in a per-thread cache if
+  /// <cdr_allocator_thread_cache_> is set, deleting it on failure.
+  ACE_Allocator *thread_cached_allocator (ACE_Allocator *allocator) const;
+
 protected:
   /// The type of data blocks that the ORB should use
   int use_locked_data_blocks_;
@@ -239,6 +245,13 @@ protected:
   /// limit
   int max_muxed_connections_;
 
+  /// Specifies the number of independently locked shards of the
+  /// transport cache.
+  int transport_cache_shards_;
+
+  /// Specifies the number of hash shards of the ObjectKey table.
+  int object_key_table_shards_;
+
   /// If 0 then we create reactors with signal handling disabled.
   int reactor_mask_signals_;
 
@@ -283,6 +296,10 @@ protected:
   /// should use the local memory pool or not.
   bool use_local_memory_pool_;
 
+  /// Magazine size of the per-thread cache put in front of the CDR
+  /// allocators, 0 if they are not cached.
+  size_t cdr_allocator_thread_cache_;
+
 private:
   enum Lock_Type
   {
@@ -105,6 +105,12 @@ const size_t TAO_DEFAULT_ADAPTER_REGISTRY_SIZE = 16;
 const size_t TAO_RD_TABLE_SIZE = 16;
 #endif  /* !TAO_RD_TABLE_SIZE */
 
+// The longest time, in microseconds, the BUSY_POLL wait strategy
+// spins for a reply before it blocks.  See -ORBBusyPollTime.
+#if !defined (TAO_DEFAULT_BUSY_POLL_TIME)
+# define TAO_DEFAULT_BUSY_POLL_TIME 50
+#endif /* TAO_DEFAULT_BUSY_POLL_TIME */
+
 // The default size of TAO's policy factory registry, i.e. the map
 // used as the underlying implementation for the
 // PortableInterceptor::ORBInitInfo::register_policy_factory() method.
@@ -151,6 +157,12 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
 #  define TAO_DEFAULT_SERVER_POA_MAP_SIZE 24
 #endif /* ! TAO_DEFAULT_SERVER_POA_MAP_SIZE */
 
+// Whether the POA dispatches requests for active objects it has seen
+// before without the object adapter lock (-ORBPOADispatchCache).
+#if !defined (TAO_POA_DISPATCH_CACHE)
+#  define TAO_POA_DISPATCH_CACHE 0
+#endif /* ! TAO_POA_DISPATCH_CACHE */
+
 // The default timeout receiving the location request to the TAO
 // Naming, Trading and other servicesService.
 #if !defined (TAO_DEFAULT_SERVICE_RESOLUTION_TIMEOUT)
@@ -186,6 +198,17 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
 # define TAO_CONNECTION_CACHE_MAXIMUM (ACE::max_handles () / 2)
 #endif /* TAO_CONNECTION_CACHE_MAXIMUM */
 
+/// Number of independently locked shards of the transport cache.
+#if !defined (TAO_TRANSPORT_CACHE_SHARDS)
+# define TAO_TRANSPORT_CACHE_SHARDS 1
+#endif /* TAO_TRANSPORT_CACHE_SHARDS */
+
+/// Number of hash shards of the ObjectKey table, 0 keeps the keys in
+/// a single RB_Tree.
+#if !defined (TAO_OBJECTKEY_TABLE_SHARDS)
+# define TAO_OBJECTKEY_TABLE_SHARDS 0
+#endif /* TAO_OBJECTKEY_TABLE_SHARDS */
+
 #if !defined(TAO_NO_COPY_OCTET_SEQUENCES)
 # define TAO_NO_COPY_OCTET_SEQUENCES 1
 #endif /* TAO_NO_COPY_OCTET_SEQUENCES */
@@ -820,6 +843,26 @@ enum TAO_Policy_Scope
 #  define TAO_USE_OUTPUT_CDR_MMAP_MEMORY_POOL 0
 #endif /* TAO_USE_LOCAL_MEMORY_POOL */
 
+/// Magazine size of the per-thread cache in front of the CDR
+/// allocators, 0 disables the cache.  See -ORBCDRAllocatorThreadCache.
+#if !defined (TAO_CDR_ALLOCATOR_THREAD_CACHE)
+#  define TAO_CDR_ALLOCATOR_THREAD_CACHE 0
+#endif /* TAO_CDR_ALLOCATOR_THREAD_CACHE */
+
+/// Octet and primitive sequences of at least this many bytes are not
+/// copied into outgoing requests, 0 disables it.  See
+/// -ORBCDRZeroCopyThreshold.
+#if !defined (TAO_DEFAULT_CDR_ZERO_COPY_THRESHOLD)
+#  define TAO_DEFAULT_CDR_ZERO_COPY_THRESHOLD 65536
+#endif /* TAO_DEFAULT_CDR_ZERO_COPY_THRESHOLD */
+
+/// Oneways queued on a transport are appended to the last queued
+/// message as long as it stays below this many bytes, 0 disables it.
+/// See -ORBOnewayBatchSize.
+#if !defined (TAO_DEFAULT_ONEWAY_BATCH_SIZE)
+#  define TAO_DEFAULT_ONEWAY_BATCH_SIZE 0
+#endif /* TAO_DEFAULT_ONEWAY_BATCH_SIZE */
+
 /// Enable TransportCurrent by default
 #if !defined (TAO_HAS_TRANSPORT_CURRENT)
 #    define TAO_HAS_TRANSPORT_CURRENT 1
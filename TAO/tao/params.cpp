@@ -30,6 +30,8 @@ TAO_ORB_Parameters::TAO_ORB_Parameters ()
   , iiop_client_port_base_ (0)
   , iiop_client_port_span_ (0)
   , cdr_memcpy_tradeoff_ (ACE_DEFAULT_CDR_MEMCPY_TRADEOFF)
+  , cdr_zero_copy_threshold_ (TAO_DEFAULT_CDR_ZERO_COPY_THRESHOLD)
+  , oneway_batch_size_ (TAO_DEFAULT_ONEWAY_BATCH_SIZE)
   , max_message_size_ (0) // Disable outgoing GIOP fragments by default
   , use_dotted_decimal_addresses_ (0)
   , cache_incoming_by_dotted_decimal_address_ (0)
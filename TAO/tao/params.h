@@ -115,6 +115,22 @@ public:
   int cdr_memcpy_tradeoff () const;
   void cdr_memcpy_tradeoff (int);
 
+  /**
+   * Octet and primitive sequences of at least this many bytes are
+   * not copied into outgoing requests, the request refers to the
+   * sequence buffer until it is sent.  0 disables it.
+   */
+  size_t cdr_zero_copy_threshold () const;
+  void cdr_zero_copy_threshold (size_t);
+
+  /**
+   * Oneways that have to be queued are appended to the last message
+   * in the transport queue while it holds less than this many bytes,
+   * so that they are sent in one write.  0 disables it.
+   */
+  size_t oneway_batch_size () const;
+  void oneway_batch_size (size_t);
+
   /**
    * Maximum size of a GIOP message before outgoing fragmentation
    * kicks in.
@@ -341,6 +357,12 @@ private:
   /// CDR streams.
   int cdr_memcpy_tradeoff_;
 
+  /// Smallest sequence that is marshaled into requests without a copy.
+  size_t cdr_zero_copy_threshold_;
+
+  /// Size of the buffer oneways are batched into.
+  size_t oneway_batch_size_;
+
   /// Maximum GIOP message size to be sent over a given transport.
   /**
    * Setting a maximum message size will cause outgoing GIOP
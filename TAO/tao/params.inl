@@ -37,6 +37,30 @@ TAO_ORB_Parameters::cdr_memcpy_tradeoff (int x)
   this->cdr_memcpy_tradeoff_ = x;
 }
 
+ACE_INLINE size_t
+TAO_ORB_Parameters::cdr_zero_copy_threshold () const
+{
+  return this->cdr_zero_copy_threshold_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::cdr_zero_copy_threshold (size_t x)
+{
+  this->cdr_zero_copy_threshold_ = x;
+}
+
+ACE_INLINE size_t
+TAO_ORB_Parameters::oneway_batch_size () const
+{
+  return this->oneway_batch_size_;
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::oneway_batch_size (size_t x)
+{
+  this->oneway_batch_size_ = x;
+}
+
 ACE_INLINE ACE_CDR::ULong
 TAO_ORB_Parameters::max_message_size () const
 {
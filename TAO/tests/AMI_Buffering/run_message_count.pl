@@ -9,11 +9,15 @@ use PerlACE::TestTarget;
 
 $status = 0;
 $debug_level = '0';
+$client_args = '';
 
 foreach $i (@ARGV) {
     if ($i eq '-debug') {
         $debug_level = '10';
     }
+    elsif ($i eq '-batch') {
+        $client_args = '-ORBOnewayBatchSize 4096 ';
+    }
 }
 
 my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
@@ -49,6 +53,7 @@ $SV = $server->CreateProcess ("server",
                               "-k file://$server_iorfile_admin");
 
 $CL = $client->CreateProcess ("client",
+                              $client_args .
                               "-k file://$client_iorfile " .
                               "-a file://$client_iorfile_admin " .
                               "-c ");
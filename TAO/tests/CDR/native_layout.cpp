@@ -0,0 +1,261 @@
+//=============================================================================
+/**
+ *  @file   native_layout.cpp
+ *
+ * Verifies that structs whose C++ layout is their CDR encoding, and
+ * sequences of them, are marshaled as one block to the same bytes as
+ * member by member, and that byte swapped streams still decode.
+ */
+//=============================================================================
+
+#include "native_layoutC.h"
+#include "tao/CDR.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_string.h"
+
+static void
+write_members (TAO_OutputCDR &cdr, const Native_Layout::Point &p)
+{
+  cdr << p.x;
+  cdr << p.y;
+  cdr << p.z;
+}
+
+static void
+write_members (TAO_OutputCDR &cdr, const Native_Layout::Sample &s)
+{
+  cdr << s.id;
+  cdr << s.count;
+  cdr << s.flags;
+  cdr << s.channel;
+  write_members (cdr, s.where);
+  cdr.write_octet_array (s.tag, sizeof s.tag);
+}
+
+/// @a x in the other byte order.
+template<typename T>
+static T
+swapped (T x)
+{
+  T result;
+  char const *from = reinterpret_cast<char const *> (&x);
+  char *to = reinterpret_cast<char *> (&result);
+  switch (sizeof (T))
+    {
+    case 2:
+      ACE_CDR::swap_2 (from, to);
+      break;
+    case 4:
+      ACE_CDR::swap_4 (from, to);
+      break;
+    default:
+      ACE_CDR::swap_8 (from, to);
+      break;
+    }
+  return result;
+}
+
+static Native_Layout::Sample
+make_sample (CORBA::Long i)
+{
+  Native_Layout::Sample s;
+  s.id = ACE_UINT64_LITERAL (0x0102030405060708) * i;
+  s.count = 1000 + i;
+  s.flags = static_cast<CORBA::Short> (-i);
+  s.channel = static_cast<CORBA::UShort> (2809 + i);
+  s.where.x = 1.5 * i;
+  s.where.y = -2.25 * i;
+  s.where.z = 1e10 * i;
+  for (CORBA::ULong j = 0; j != sizeof s.tag; ++j)
+    s.tag[j] = static_cast<CORBA::Octet> (i + j);
+  return s;
+}
+
+static bool
+same (const Native_Layout::Sample &a, const Native_Layout::Sample &b)
+{
+  return a.id == b.id
+    && a.count == b.count
+    && a.flags == b.flags
+    && a.channel == b.channel
+    && a.where.x == b.where.x
+    && a.where.y == b.where.y
+    && a.where.z == b.where.z
+    && ACE_OS::memcmp (a.tag, b.tag, sizeof a.tag) == 0;
+}
+
+/// Compare the bytes of two streams, each with a single block.
+static int
+compare (const char *test, const TAO_OutputCDR &lhs, const TAO_OutputCDR &rhs)
+{
+  if (lhs.total_length () != rhs.total_length ()
+      || ACE_OS::memcmp (lhs.begin ()->rd_ptr (),
+                         rhs.begin ()->rd_ptr (),
+                         lhs.total_length ()) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: %C encodes differently, %B and %B bytes\n",
+                  test,
+                  lhs.total_length (),
+                  rhs.total_length ()));
+      return 1;
+    }
+
+  return 0;
+}
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  int status = 0;
+
+  ACE_DEBUG ((LM_DEBUG,
+              "Point native: %d, Sample native: %d\n",
+              TAO::CDR_Native_Layout<Native_Layout::Point>::value,
+              TAO::CDR_Native_Layout<Native_Layout::Sample>::value));
+
+  if (TAO::CDR_Native_Layout<Native_Layout::Outer::Inner>::value
+      != TAO::CDR_Native_Layout<Native_Layout::Outer>::value)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "ERROR: Outer and its nested Inner disagree\n"));
+      status = 1;
+    }
+
+  if (TAO::CDR_Native_Layout<Native_Layout::Mixed>::value)
+    {
+      ACE_ERROR ((LM_ERROR, "ERROR: Mixed must not be copied as a block\n"));
+      status = 1;
+    }
+
+  // A struct, after an octet so that the stream has to pad it.
+  Native_Layout::Sample const sample = make_sample (3);
+  {
+    // Zeroed buffers, so that the padding compares equal.
+    char block_buffer[1024] = {};
+    char members_buffer[1024] = {};
+    TAO_OutputCDR block (block_buffer, sizeof block_buffer);
+    TAO_OutputCDR members (members_buffer, sizeof members_buffer);
+    block << ACE_OutputCDR::from_octet (7);
+    members << ACE_OutputCDR::from_octet (7);
+    block << sample;
+    write_members (members, sample);
+    status += compare ("struct", block, members);
+
+    TAO_InputCDR input (block);
+    CORBA::Octet o = 0;
+    Native_Layout::Sample result;
+    if (!(input >> ACE_InputCDR::to_octet (o))
+        || !(input >> result)
+        || !same (sample, result))
+      {
+        ACE_ERROR ((LM_ERROR, "ERROR: struct does not decode\n"));
+        status = 1;
+      }
+  }
+
+  // A struct declared in another one.
+  {
+    Native_Layout::Outer outer;
+    outer.first.a = 2809;
+    outer.b = -17;
+
+    char block_buffer[64] = {};
+    char members_buffer[64] = {};
+    TAO_OutputCDR block (block_buffer, sizeof block_buffer);
+    TAO_OutputCDR members (members_buffer, sizeof members_buffer);
+    block << outer;
+    members << outer.first.a;
+    members << outer.b;
+    status += compare ("nested struct", block, members);
+
+    TAO_InputCDR input (block);
+    Native_Layout::Outer result;
+    if (!(input >> result)
+        || result.first.a != outer.first.a
+        || result.b != outer.b)
+      {
+        ACE_ERROR ((LM_ERROR, "ERROR: nested struct does not decode\n"));
+        status = 1;
+      }
+  }
+
+  // Unbounded and bounded sequences.
+  {
+    Native_Layout::SampleSeq samples (5);
+    samples.length (5);
+    for (CORBA::ULong i = 0; i != samples.length (); ++i)
+      samples[i] = make_sample (i);
+
+    Native_Layout::PointSeq points;
+    points.length (3);
+    for (CORBA::ULong i = 0; i != points.length (); ++i)
+      points[i] = samples[i].where;
+
+    char block_buffer[1024] = {};
+    char members_buffer[1024] = {};
+    TAO_OutputCDR block (block_buffer, sizeof block_buffer);
+    TAO_OutputCDR members (members_buffer, sizeof members_buffer);
+    block << samples;
+    block << points;
+    members << samples.length ();
+    for (CORBA::ULong i = 0; i != samples.length (); ++i)
+      write_members (members, samples[i]);
+    members << points.length ();
+    for (CORBA::ULong i = 0; i != points.length (); ++i)
+      write_members (members, points[i]);
+    status += compare ("sequences", block, members);
+
+    TAO_InputCDR input (block);
+    Native_Layout::SampleSeq samples_result;
+    Native_Layout::PointSeq points_result;
+    bool ok = (input >> samples_result) && (input >> points_result)
+      && samples_result.length () == samples.length ()
+      && points_result.length () == points.length ();
+    for (CORBA::ULong i = 0; ok && i != samples.length (); ++i)
+      ok = same (samples[i], samples_result[i]);
+    for (CORBA::ULong i = 0; ok && i != points.length (); ++i)
+      ok = points[i].x == points_result[i].x
+        && points[i].y == points_result[i].y
+        && points[i].z == points_result[i].z;
+    if (!ok)
+      {
+        ACE_ERROR ((LM_ERROR, "ERROR: sequences do not decode\n"));
+        status = 1;
+      }
+
+    // A sequence longer than the data left is rejected.
+    TAO_OutputCDR truncated;
+    truncated << CORBA::ULong (1000);
+    write_members (truncated, sample);
+    TAO_InputCDR truncated_input (truncated);
+    if (truncated_input >> samples_result)
+      {
+        ACE_ERROR ((LM_ERROR, "ERROR: truncated sequence decodes\n"));
+        status = 1;
+      }
+  }
+
+  // The other byte order is decoded member by member.
+  {
+    TAO_OutputCDR members;
+    members << swapped (sample.id);
+    members << swapped (sample.count);
+    members << swapped (sample.flags);
+    members << swapped (sample.channel);
+    members << swapped (sample.where.x);
+    members << swapped (sample.where.y);
+    members << swapped (sample.where.z);
+    members.write_octet_array (sample.tag, sizeof sample.tag);
+
+    TAO_InputCDR input (members.begin (), !ACE_CDR_BYTE_ORDER);
+    Native_Layout::Sample result;
+    if (!(input >> result) || !same (sample, result))
+      {
+        ACE_ERROR ((LM_ERROR, "ERROR: swapped struct does not decode\n"));
+        status = 1;
+      }
+  }
+
+  return status;
+}
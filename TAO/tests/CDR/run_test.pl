@@ -14,7 +14,8 @@ $brace="\#\#\#\#\#";
           "tc" => "",
           "growth" => "-l 64 -h 256 -s 4 -n 10 -q",
           "alignment" => "",
-          "allocator" => "-q");
+          "allocator" => "-q",
+          "native_layout" => "");
 $test = "";
 $args = "";
 $status = 0;
@@ -0,0 +1,35 @@
+#include "Echo.h"
+#include "Payload.h"
+
+Echo::Echo (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+Test::Payload *
+Echo::echo_payload (const Test::Payload &the_payload)
+{
+  CORBA::ULong const length = payload_length (the_payload);
+  CORBA::ULong const good = check_payload (the_payload);
+  if (good != length)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: byte %u of %u is %u instead of %u\n",
+                  good, length,
+                  static_cast<unsigned int> (payload_at (the_payload, good)),
+                  static_cast<unsigned int> (payload_byte (good, length))));
+      throw Test::Echo::Invalid_Payload ();
+    }
+
+  Test::Payload *reply = 0;
+  ACE_NEW_THROW_EX (reply,
+                    Test::Payload (the_payload),
+                    CORBA::NO_MEMORY ());
+  return reply;
+}
+
+void
+Echo::shutdown ()
+{
+  this->orb_->shutdown (false);
+}
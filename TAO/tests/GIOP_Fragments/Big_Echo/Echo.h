@@ -0,0 +1,29 @@
+#ifndef BIG_ECHO_ECHO_H
+#define BIG_ECHO_ECHO_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Implement the Test::Echo interface
+/**
+ * Check that the payload is the expected pattern, byte for byte, and
+ * send it back.
+ */
+class Echo
+  : public virtual POA_Test::Echo
+{
+public:
+  /// Constructor
+  Echo (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual Test::Payload *echo_payload (const Test::Payload &the_payload);
+
+  virtual void shutdown ();
+
+private:
+  CORBA::ORB_var orb_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* BIG_ECHO_ECHO_H */
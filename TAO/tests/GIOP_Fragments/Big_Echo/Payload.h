@@ -0,0 +1,84 @@
+#ifndef BIG_ECHO_PAYLOAD_H
+#define BIG_ECHO_PAYLOAD_H
+#include /**/ "ace/pre.h"
+
+#include "TestC.h"
+
+/// The size of the blocks a payload is cut into.
+const CORBA::ULong block_size = 100;
+
+/// The value of byte @a i of a payload of @a length bytes.  The
+/// pattern differs from one payload to the next, and repeats with a
+/// period that divides no fragment size.
+inline CORBA::Octet
+payload_byte (CORBA::ULong i, CORBA::ULong length)
+{
+  return static_cast<CORBA::Octet> ((i * 7 + length) % 251);
+}
+
+/// The number of bytes in all the blocks of @a payload.
+inline CORBA::ULong
+payload_length (const Test::Payload &payload)
+{
+  CORBA::ULong length = 0;
+  for (CORBA::ULong b = 0; b != payload.length (); ++b)
+    {
+      length += payload[b].length ();
+    }
+  return length;
+}
+
+/// Fill @a payload with @a length bytes of the pattern.
+inline void
+fill_payload (Test::Payload &payload, CORBA::ULong length)
+{
+  payload.length ((length + block_size - 1) / block_size);
+  for (CORBA::ULong b = 0; b != payload.length (); ++b)
+    {
+      CORBA::ULong const first = b * block_size;
+      Test::Block &block = payload[b];
+      block.length (ACE_MIN (block_size, length - first));
+      for (CORBA::ULong i = 0; i != block.length (); ++i)
+        {
+          block[i] = payload_byte (first + i, length);
+        }
+    }
+}
+
+/// The index of the first byte of @a payload that isn't the pattern,
+/// or its length if all are.
+inline CORBA::ULong
+check_payload (const Test::Payload &payload)
+{
+  CORBA::ULong const length = payload_length (payload);
+  CORBA::ULong first = 0;
+  for (CORBA::ULong b = 0; b != payload.length (); ++b)
+    {
+      const Test::Block &block = payload[b];
+      for (CORBA::ULong i = 0; i != block.length (); ++i)
+        {
+          if (block[i] != payload_byte (first + i, length))
+            {
+              return first + i;
+            }
+        }
+      first += block.length ();
+    }
+  return length;
+}
+
+/// Byte @a i of @a payload.
+inline CORBA::Octet
+payload_at (const Test::Payload &payload, CORBA::ULong i)
+{
+  CORBA::ULong b = 0;
+  while (i >= payload[b].length ())
+    {
+      i -= payload[b].length ();
+      ++b;
+    }
+  return payload[b][i];
+}
+
+#include /**/ "ace/post.h"
+#endif /* BIG_ECHO_PAYLOAD_H */
@@ -0,0 +1,122 @@
+#include "TestC.h"
+#include "Payload.h"
+#include "ace/Get_Opt.h"
+
+const ACE_TCHAR *ior = ACE_TEXT("file://server.ior");
+bool shutdown_server = false;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:x"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+      case 'x':
+        shutdown_server = true;
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-x"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  // Around the fragment sizes, and much larger.
+  const CORBA::ULong lengths[] =
+    {
+      0, 1, 7, 8, 9, 1000, 1023, 1024, 1025, 4096, 65535, 65536, 65537,
+      1000000, 4 * 1024 * 1024 + 3
+    };
+
+  int errors = 0;
+
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var tmp =
+        orb->string_to_object (ior);
+
+      Test::Echo_var echo =
+        Test::Echo::_narrow (tmp.in ());
+
+      if (CORBA::is_nil (echo.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_DEBUG,
+                             "Nil Test::Echo reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      for (size_t i = 0; i != sizeof lengths / sizeof lengths[0]; ++i)
+        {
+          Test::Payload payload;
+          fill_payload (payload, lengths[i]);
+
+          try
+            {
+              Test::Payload_var reply = echo->echo_payload (payload);
+
+              CORBA::ULong const length = payload_length (reply.in ());
+              CORBA::ULong const good = check_payload (reply.in ());
+              if (length != lengths[i] || good != lengths[i])
+                {
+                  ACE_ERROR ((LM_ERROR,
+                              "(%P|%t) ERROR: reply of %u bytes to %u, "
+                              "%u good\n",
+                              length, lengths[i], good));
+                  ++errors;
+                }
+            }
+          catch (const Test::Echo::Invalid_Payload&)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "(%P|%t) ERROR: the server got a bad payload "
+                          "of %u bytes\n",
+                          lengths[i]));
+              ++errors;
+            }
+        }
+
+      if (shutdown_server)
+        {
+          echo->shutdown ();
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  if (errors != 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%P|%t) ERROR: %d payloads failed\n", errors),
+                        1);
+    }
+
+  return 0;
+}
@@ -0,0 +1,221 @@
+eval '(exit $?0)' && eval 'exec perl -w -S $0 ${1+"$@"}'
+    & eval 'exec perl -w -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+# Sends echo requests as GIOP 1.2 fragments, a few bytes at a time, so
+# that the server reads fragments, and their headers, split in every
+# possible way.  The replies, fragmented by the server, must bring the
+# payloads back byte for byte.
+
+use strict;
+use Getopt::Long;
+use IO::Socket::INET;
+use Socket qw(IPPROTO_TCP TCP_NODELAY);
+use Time::HiRes qw(usleep);
+
+my $host = '127.0.0.1';
+my $port = 12345;
+my $keyfile = 'server.key';
+my $verbose = 0;
+my $max_message_size = 1024;
+
+GetOptions ('host|h=s' => \$host,
+            'port|p=i' => \$port,
+            'key|k=s'  => \$keyfile,
+            'max|m=i'  => \$max_message_size,
+            'verbose|v' => \$verbose)
+  or die "Usage: $0 [--host <host>] [--port <port>] [--key <keyfile>] "
+       . "[--max <server max message size>] [-v]\n";
+
+open (my $kf, '<', $keyfile) or die "ERROR: cannot open <$keyfile>: $!\n";
+my $hex = <$kf>;
+close ($kf);
+$hex =~ s/\s+//g;
+my $key = pack ('H*', $hex);
+
+my $sock = IO::Socket::INET->new (PeerAddr => $host,
+                                  PeerPort => $port,
+                                  Proto    => 'tcp')
+  or die "ERROR: cannot connect to $host:$port: $!\n";
+setsockopt ($sock, IPPROTO_TCP, TCP_NODELAY, 1);
+binmode ($sock);
+
+sub payload {
+  my $length = shift;
+  return pack ('C*', map { ($_ * 7 + $length) % 251 } 0 .. $length - 1);
+}
+
+# The payload cut into blocks, as Test::Payload is marshaled.
+my $block_size = 100;
+sub blocks {
+  my $data = shift;
+  my $count = int ((length ($data) + $block_size - 1) / $block_size);
+  my $body = pack ('V', $count);
+  for (my $pos = 0; $pos < length ($data); $pos += $block_size) {
+    $body .= "\0" x ((- length ($body)) % 4);
+    my $block = substr ($data, $pos, $block_size);
+    $body .= pack ('V', length ($block)) . $block;
+  }
+  return $body;
+}
+
+sub align {
+  my ($buf, $n) = @_;
+  $$buf .= "\0" x ((- length ($$buf)) % $n);
+}
+
+sub giop_header {
+  my ($flags, $type, $size) = @_;
+  return 'GIOP' . pack ('CCCCV', 1, 2, $flags, $type, $size);
+}
+
+# The request, cut into a first message and fragments of at most
+# $max bytes each.  All but the last end on an 8 byte boundary.
+sub request {
+  my ($id, $data, $max) = @_;
+
+  my $msg = giop_header (1, 0, 0);
+  $msg .= pack ('VC', $id, 3) . "\0\0\0";
+  $msg .= pack ('v', 0);
+  align (\$msg, 4);
+  $msg .= pack ('V', length ($key)) . $key;
+  align (\$msg, 4);
+  $msg .= pack ('V', 13) . "echo_payload\0";
+  align (\$msg, 4);
+  $msg .= pack ('V', 0);
+  align (\$msg, 8);
+  $msg .= blocks ($data);
+
+  if (length ($msg) <= $max) {
+    substr ($msg, 8, 4) = pack ('V', length ($msg) - 12);
+    return $msg;
+  }
+
+  my $first = $max - $max % 8;
+  my $wire = giop_header (3, 0, $first - 12) . substr ($msg, 12, $first - 12);
+  my $chunk = ($max - 16) - ($max - 16) % 8;
+  for (my $pos = $first; $pos < length ($msg); $pos += $chunk) {
+    my $part = substr ($msg, $pos, $chunk);
+    my $more = $pos + $chunk < length ($msg) ? 2 : 0;
+    $wire .= giop_header (1 | $more, 7, 4 + length ($part));
+    $wire .= pack ('V', $id) . $part;
+  }
+  return $wire;
+}
+
+# Write $wire in pieces of a few bytes, letting the server read each.
+my @pieces = (1, 2, 3, 5, 11, 12, 13, 16, 100, 700, 4000);
+sub dribble {
+  my $wire = shift;
+  my $i = 0;
+  for (my $pos = 0; $pos < length ($wire); ) {
+    my $piece = substr ($wire, $pos, $pieces[$i++ % @pieces]);
+    defined (syswrite ($sock, $piece)) or die "ERROR: write failed: $!\n";
+    $pos += length ($piece);
+    usleep (100);
+  }
+}
+
+sub read_exact {
+  my $n = shift;
+  my $buf = '';
+  while (length ($buf) < $n) {
+    my $r = sysread ($sock, $buf, $n - length ($buf), length ($buf));
+    die "ERROR: read failed: " . (defined $r ? "connection closed" : $!) . "\n"
+      unless $r;
+  }
+  return $buf;
+}
+
+# The reply stream, with the fragment headers removed, and its byte
+# order.
+sub read_reply {
+  my $stream = '';
+  my $little;
+  my $fragments = 0;
+  while (1) {
+    my $header = read_exact (12);
+    my ($magic, $major, $minor, $flags, $type) = unpack ('a4CCCC', $header);
+    die "ERROR: bad GIOP header\n" unless $magic eq 'GIOP';
+    $little = $flags & 1;
+    my $size = unpack ($little ? 'V' : 'N', substr ($header, 8, 4));
+    my $body = read_exact ($size);
+    if ($stream eq '') {
+      die "ERROR: expected a reply, got message type $type\n" unless $type == 1;
+      $stream = $header . $body;
+    }
+    else {
+      die "ERROR: expected a fragment, got message type $type\n" unless $type == 7;
+      $stream .= substr ($body, 4);
+      ++$fragments;
+    }
+    last unless $flags & 2;
+  }
+  return ($stream, $little, $fragments);
+}
+
+sub check_reply {
+  my ($id, $data) = @_;
+  my ($stream, $little, $fragments) = read_reply ();
+  my $u32 = $little ? 'V' : 'N';
+  my $pos = 12;
+  my $get = sub {
+    $pos += (- $pos) % 4;
+    my $v = unpack ($u32, substr ($stream, $pos, 4));
+    $pos += 4;
+    return $v;
+  };
+
+  my $reply_id = $get->();
+  my $status = $get->();
+  my $contexts = $get->();
+  for (my $i = 0; $i < $contexts; ++$i) {
+    $get->();
+    $pos += $get->();
+  }
+  if ($reply_id != $id || $status != 0) {
+    print STDERR "ERROR: reply $reply_id to $id with status $status\n";
+    return 1;
+  }
+  $pos += (- $pos) % 8;
+  my $echo = '';
+  my $count = $get->();
+  for (my $i = 0; $i < $count; ++$i) {
+    my $length = $get->();
+    $echo .= substr ($stream, $pos, $length);
+    $pos += $length;
+  }
+  if ($echo ne $data) {
+    my $i = 0;
+    ++$i while ($i < length ($data) && $i < length ($echo)
+                && substr ($echo, $i, 1) eq substr ($data, $i, 1));
+    print STDERR "ERROR: echo of ", length ($echo), " bytes to ",
+                 length ($data), " differs at byte $i\n";
+    return 1;
+  }
+  if ($fragments == 0 && length ($stream) > 2 * $max_message_size) {
+    print STDERR "ERROR: reply of ", length ($stream),
+                 " bytes not fragmented\n";
+    return 1;
+  }
+  print "echoed ", length ($data), " bytes in ", $fragments + 1,
+        " messages\n" if $verbose;
+  return 0;
+}
+
+my $errors = 0;
+my $id = 1;
+foreach my $length (100, 5000, 100000) {
+  foreach my $max (256, 1024, 8192) {
+    my $data = payload ($length);
+    dribble (request ($id, $data, $max));
+    $errors += check_reply ($id, $data);
+    ++$id;
+  }
+}
+
+close ($sock);
+
+exit ($errors == 0 ? 0 : 1);
@@ -0,0 +1,97 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+
+foreach $i (@ARGV) {
+    if ($i eq '-debug') {
+        $debug_level = '10';
+    }
+}
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $client = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+
+my $hostname = $server->HostName ();
+my $port = $server->RandomPort ();
+
+my $iorbase = "server.ior";
+my $keybase = "server.key";
+my $server_iorfile = $server->LocalFile ($iorbase);
+my $server_keyfile = $server->LocalFile ($keybase);
+my $client_iorfile = $client->LocalFile ($iorbase);
+$server->DeleteFile($iorbase);
+$server->DeleteFile($keybase);
+$client->DeleteFile($iorbase);
+
+# Both sides fragment whatever is larger than 1024 bytes.
+$SV = $server->CreateProcess ("server",
+                              "-ORBEndpoint iiop://$hostname:$port " .
+                              "-ORBMaxMessageSize 1024 " .
+                              "-ORBDebugLevel $debug_level " .
+                              "-o $server_iorfile -k $server_keyfile");
+$CL = $client->CreateProcess ("client",
+                              "-ORBMaxMessageSize 1024 " .
+                              "-ORBDebugLevel $debug_level " .
+                              "-k file://$client_iorfile -x");
+
+$server_status = $SV->Spawn ();
+
+if ($server_status != 0) {
+    print STDERR "ERROR: server returned $server_status\n";
+    exit 1;
+}
+
+if ($server->WaitForFileTimed ($iorbase,
+                               $server->ProcessStartWaitInterval()) == -1) {
+    print STDERR "ERROR: cannot find file <$server_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+if ($server->GetFile ($iorbase) == -1) {
+    print STDERR "ERROR: cannot retrieve file <$server_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+if ($client->PutFile ($iorbase) == -1) {
+    print STDERR "ERROR: cannot set file <$client_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+# Fragments split across reads.
+my $DR = system ("$^X dribble.pl --host=$hostname --port=$port " .
+                 "--key=$server_keyfile");
+if ($DR != 0) {
+    print STDERR "ERROR: dribble.pl returned $DR\n";
+    $status = 1;
+}
+
+# Large fragmented requests and replies.
+$client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 45);
+
+if ($client_status != 0) {
+    print STDERR "ERROR: client returned $client_status\n";
+    $status = 1;
+}
+
+$server_status = $SV->WaitKill ($server->ProcessStopWaitInterval());
+
+if ($server_status != 0) {
+    print STDERR "ERROR: server returned $server_status\n";
+    $status = 1;
+}
+
+$server->DeleteFile($iorbase);
+$server->DeleteFile($keybase);
+$client->DeleteFile($iorbase);
+
+exit $status;
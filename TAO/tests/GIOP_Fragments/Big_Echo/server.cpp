@@ -0,0 +1,123 @@
+#include "Echo.h"
+#include "tao/Stub.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdio.h"
+
+const ACE_TCHAR *ior_output_file = ACE_TEXT("server.ior");
+const ACE_TCHAR *key_output_file = 0;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("o:k:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'o':
+        ior_output_file = get_opts.opt_arg ();
+        break;
+      case 'k':
+        key_output_file = get_opts.opt_arg ();
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-o <iorfile> "
+                           "-k <keyfile>"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      if (CORBA::is_nil (root_poa.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Panic: nil RootPOA\n"),
+                          1);
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      Echo *echo_impl = 0;
+      ACE_NEW_RETURN (echo_impl,
+                      Echo (orb.in ()),
+                      1);
+      PortableServer::ServantBase_var owner_transfer (echo_impl);
+
+      PortableServer::ObjectId_var id =
+        root_poa->activate_object (echo_impl);
+
+      CORBA::Object_var object = root_poa->id_to_reference (id.in ());
+
+      CORBA::String_var ior = orb->object_to_string (object.in ());
+
+      // If the ior_output_file exists, output the ior to it
+      FILE *output_file= ACE_OS::fopen (ior_output_file, "w");
+      if (output_file == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Cannot open output file for writing IOR: %s\n",
+                           ior_output_file),
+                           1);
+      ACE_OS::fprintf (output_file, "%s", ior.in ());
+      ACE_OS::fclose (output_file);
+
+      // The object key in hex, for the clients that build their own
+      // requests.
+      if (key_output_file != 0)
+        {
+          const TAO::ObjectKey &key = object->_stubobj ()->object_key ();
+
+          output_file = ACE_OS::fopen (key_output_file, "w");
+          if (output_file == 0)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "Cannot open output file for writing key: %s\n",
+                               key_output_file),
+                               1);
+          for (CORBA::ULong i = 0; i != key.length (); ++i)
+            {
+              ACE_OS::fprintf (output_file, "%02x",
+                               static_cast<unsigned int> (key[i]));
+            }
+          ACE_OS::fclose (output_file);
+        }
+
+      poa_manager->activate ();
+
+      orb->run ();
+
+      ACE_DEBUG ((LM_DEBUG, "(%P|%t) server - event loop finished\n"));
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
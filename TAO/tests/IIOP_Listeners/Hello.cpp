@@ -0,0 +1,25 @@
+#include "Hello.h"
+
+Hello::Hello (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+  , calls_ (0)
+{
+}
+
+CORBA::Long
+Hello::call ()
+{
+  return ++this->calls_;
+}
+
+CORBA::Long
+Hello::calls ()
+{
+  return this->calls_.value ();
+}
+
+void
+Hello::shutdown ()
+{
+  this->orb_->shutdown (false);
+}
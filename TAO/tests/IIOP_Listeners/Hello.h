@@ -0,0 +1,32 @@
+#ifndef HELLO_H
+#define HELLO_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+#include "ace/Atomic_Op.h"
+
+/// Implement the Test::Hello interface
+class Hello
+  : public virtual POA_Test::Hello
+{
+public:
+  /// Constructor
+  Hello (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual CORBA::Long call ();
+
+  virtual CORBA::Long calls ();
+
+  virtual void shutdown ();
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+
+  /// The calls made, from all the server threads.
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, CORBA::Long> calls_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* HELLO_H */
@@ -0,0 +1,185 @@
+#include "TestC.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+
+const ACE_TCHAR *ior = ACE_TEXT ("file://test.ior");
+int thread_count = 16;
+int iterations = 10;
+int calls = 3;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:t:i:c:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+      case 't':
+        thread_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'c':
+        calls = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-t <threads> "
+                           "-i <iterations> "
+                           "-c <calls per connection>"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Each thread connects again and again with an ORB of its own, so
+/// that the server accepts many connections at the same time.
+class Client_Task : public ACE_Task_Base
+{
+public:
+  Client_Task ()
+    : next_ (0)
+    , errors_ (0)
+  {
+  }
+
+  int errors () const
+  {
+    return this->errors_.value ();
+  }
+
+  virtual int svc ()
+  {
+    int const thread = this->next_++;
+
+    for (int i = 0; i != iterations; ++i)
+      {
+        char orb_id[64];
+        ACE_OS::snprintf (orb_id, sizeof orb_id,
+                          "client_%d_%d", thread, i);
+
+        int argc = 0;
+
+        try
+          {
+            CORBA::ORB_var orb =
+              CORBA::ORB_init (argc, 0, orb_id);
+
+            CORBA::Object_var tmp = orb->string_to_object (ior);
+
+            Test::Hello_var hello = Test::Hello::_narrow (tmp.in ());
+
+            if (CORBA::is_nil (hello.in ()))
+              {
+                ACE_ERROR ((LM_ERROR,
+                            "(%P|%t) ERROR: nil Test::Hello reference <%s>\n",
+                            ior));
+                ++this->errors_;
+              }
+            else
+              {
+                for (int k = 0; k != calls; ++k)
+                  hello->call ();
+              }
+
+            orb->destroy ();
+          }
+        catch (const CORBA::Exception& ex)
+          {
+            ex._tao_print_exception ("Client_Task::svc");
+            ++this->errors_;
+          }
+      }
+
+    return 0;
+  }
+
+private:
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, int> next_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, int> errors_;
+};
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int errors = 0;
+
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var tmp =
+        orb->string_to_object (ior);
+
+      Test::Hello_var hello = Test::Hello::_narrow (tmp.in ());
+
+      if (CORBA::is_nil (hello.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_DEBUG,
+                             "Nil Test::Hello reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      Client_Task task;
+      if (task.activate (THR_NEW_LWP | THR_JOINABLE, thread_count) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "(%P|%t) ERROR: cannot activate the client "
+                             "threads\n"),
+                            1);
+        }
+      task.wait ();
+
+      errors += task.errors ();
+
+      CORBA::Long const made = hello->calls ();
+      CORBA::Long const expected = thread_count * iterations * calls;
+      if (made != expected)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: the server got %d calls instead "
+                      "of %d\n",
+                      made, expected));
+          ++errors;
+        }
+
+      hello->shutdown ();
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  if (errors != 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%P|%t) ERROR: %d checks failed\n", errors),
+                        1);
+    }
+
+  return 0;
+}
@@ -0,0 +1,88 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+
+foreach $i (@ARGV) {
+    if ($i eq '-debug') {
+        $debug_level = '10';
+    }
+}
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $client = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+
+my $iorbase = "server.ior";
+my $server_iorfile = $server->LocalFile ($iorbase);
+my $client_iorfile = $client->LocalFile ($iorbase);
+
+# Four listen sockets sharing the port, then a single one that lets
+# other sockets share it, both accepting several connections at once.
+my @endpoint_options = ("listeners=4&reuse_port=1&accept_batch=8",
+                        "reuse_port=1&accept_batch=2");
+
+foreach $options (@endpoint_options) {
+    print "========== Endpoint options $options =========\n";
+
+    $server->DeleteFile ($iorbase);
+    $client->DeleteFile ($iorbase);
+
+    my $port = $server->RandomPort ();
+
+    $SV = $server->CreateProcess ("server", "-ORBdebuglevel $debug_level " .
+                                            "-ORBListenEndpoints iiop://:$port/$options " .
+                                            "-o $server_iorfile -p $port");
+    $CL = $client->CreateProcess ("client", "-ORBdebuglevel $debug_level " .
+                                            "-k file://$client_iorfile");
+
+    $server_status = $SV->Spawn ();
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server returned $server_status\n";
+        exit 1;
+    }
+
+    if ($server->WaitForFileTimed ($iorbase,
+                                   $server->ProcessStartWaitInterval()) == -1) {
+        print STDERR "ERROR: cannot find file <$server_iorfile>\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    if ($server->GetFile ($iorbase) == -1) {
+        print STDERR "ERROR: cannot retrieve file <$server_iorfile>\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+    if ($client->PutFile ($iorbase) == -1) {
+        print STDERR "ERROR: cannot set file <$client_iorfile>\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 45);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+
+    $server_status = $SV->WaitKill ($server->ProcessStopWaitInterval());
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server returned $server_status\n";
+        $status = 1;
+    }
+}
+
+$server->DeleteFile ($iorbase);
+$client->DeleteFile ($iorbase);
+
+exit $status;
@@ -0,0 +1,190 @@
+#include "Hello.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/SOCK_Acceptor.h"
+#include "ace/INET_Addr.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+
+const ACE_TCHAR *ior_output_file = ACE_TEXT ("test.ior");
+int thread_count = 4;
+u_short port = 0;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("o:t:p:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'o':
+        ior_output_file = get_opts.opt_arg ();
+        break;
+
+      case 't':
+        thread_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'p':
+        port = static_cast<u_short> (ACE_OS::atoi (get_opts.opt_arg ()));
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-o <iorfile> "
+                           "-t <threads> "
+                           "-p <port of the endpoint, checked for SO_REUSEPORT>"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Run the ORB, so that several threads wait on the listen sockets.
+class Worker : public ACE_Task_Base
+{
+public:
+  Worker (CORBA::ORB_ptr orb)
+    : orb_ (CORBA::ORB::_duplicate (orb))
+  {
+  }
+
+  virtual int svc ()
+  {
+    try
+      {
+        this->orb_->run ();
+      }
+    catch (const CORBA::Exception& ex)
+      {
+        ex._tao_print_exception ("Worker::svc");
+      }
+    return 0;
+  }
+
+private:
+  CORBA::ORB_var orb_;
+};
+
+/// The listen sockets of the endpoint have SO_REUSEPORT when another
+/// socket with it can listen on @a port too, while one without it
+/// cannot.  Returns the number of failed checks.
+int
+check_port ()
+{
+  int errors = 0;
+
+#if defined (SO_REUSEPORT)
+#if defined (ACE_HAS_IPV6) && !defined (ACE_USES_IPV4_IPV6_MIGRATION)
+  ACE_INET_Addr const addr (port, ACE_IPV6_ANY, AF_INET6);
+#else
+  ACE_INET_Addr const addr (port, static_cast<ACE_UINT32> (INADDR_ANY));
+#endif /* ACE_HAS_IPV6 && !ACE_USES_IPV4_IPV6_MIGRATION */
+
+  ACE_SOCK_Acceptor shared;
+  if (shared.open (addr, 1, PF_UNSPEC, ACE_DEFAULT_BACKLOG, 0, 0, 1) == -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: cannot listen on port %d "
+                  "with SO_REUSEPORT - %m\n",
+                  port));
+      ++errors;
+    }
+  shared.close ();
+
+  ACE_SOCK_Acceptor exclusive;
+  if (exclusive.open (addr, 1) != -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: port %d is not in use\n",
+                  port));
+      ++errors;
+    }
+  exclusive.close ();
+#endif /* SO_REUSEPORT */
+
+  return errors;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      if (CORBA::is_nil (root_poa.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Panic: nil RootPOA\n"),
+                          1);
+
+      PortableServer::POAManager_var poa_manager = root_poa->the_POAManager ();
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      // Before the IOR is written, so that no client connects to the
+      // socket opened by the check.
+      if (port != 0 && check_port () != 0)
+        return 1;
+
+      Hello *hello_impl = 0;
+      ACE_NEW_RETURN (hello_impl,
+                      Hello (orb.in ()),
+                      1);
+      PortableServer::ServantBase_var owner_transfer(hello_impl);
+
+      PortableServer::ObjectId_var id =
+        root_poa->activate_object (hello_impl);
+
+      CORBA::Object_var object = root_poa->id_to_reference (id.in ());
+
+      Test::Hello_var hello = Test::Hello::_narrow (object.in ());
+
+      CORBA::String_var ior = orb->object_to_string (hello.in ());
+
+      // Output the IOR to the <ior_output_file>
+      FILE *output_file= ACE_OS::fopen (ior_output_file, "w");
+      if (output_file == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Cannot open output file for writing IOR: %s\n",
+                           ior_output_file),
+                           1);
+      ACE_OS::fprintf (output_file, "%s", ior.in ());
+      ACE_OS::fclose (output_file);
+
+      poa_manager->activate ();
+
+      Worker worker (orb.in ());
+      if (worker.activate (THR_NEW_LWP | THR_JOINABLE, thread_count) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) ERROR: cannot activate the server "
+                           "threads\n"),
+                          1);
+      worker.wait ();
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
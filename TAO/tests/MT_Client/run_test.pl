@@ -19,12 +19,15 @@ $server_conf = "server" . $conf;
 
 $threads = '4';
 $iterations = '1000';
+$client_args = '';
 
 foreach $i (@ARGV) {
     if ($i eq '-debug') {
         $debug_level = '10';
     } elsif ($i eq '-creation') {
         $client_process = 'orb_creation';
+    } elsif ($i eq '-busy_poll') {
+        $client_conf = "client_busy_poll" . $conf;
     }
 }
 
@@ -45,6 +48,15 @@ if ($server->PutFile ($server_conf) == -1) {
     exit 1;
 }
 
+if ($client_conf ne "client" . $conf) {
+    my $client_conf1 = $client->LocalFile ($client_conf);
+    if ($client->PutFile ($client_conf) == -1) {
+        print STDERR "ERROR: cannot set file <$client_conf1>\n";
+        exit 1;
+    }
+    $client_args = "-ORBsvcconf $client_conf1 ";
+}
+
 $SV = $server->CreateProcess ("server",
                               "-ORBdebuglevel $debug_level " .
                               "-ORBsvcconf $server_conf1 " .
@@ -52,6 +64,7 @@ $SV = $server->CreateProcess ("server",
 
 $CL = $client->CreateProcess ($client_process,
                               "-ORBdebuglevel $debug_level " .
+                              $client_args .
                               "-k file://$client_iorfile " .
                               "-n $threads " .
                               "-i $iterations " .
@@ -0,0 +1,267 @@
+#include "tao/ORB_Core.h"
+#include "tao/ObjectKey_Table.h"
+#include "tao/Stub.h"
+#include "tao/Object.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/Array_Base.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+int thread_count = 8;
+int iterations = 100;
+int key_count = 32;
+int expected_shards = -1;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:i:k:s:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 't':
+        thread_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'k':
+        key_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 's':
+        expected_shards = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-t <threads> "
+                           "-i <iterations> "
+                           "-k <keys> "
+                           "-s <expected shards> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// A reference to an object of key @a name, as a corbaloc string.
+void
+corbaloc (char *buf, size_t size, const char *name)
+{
+  ACE_OS::snprintf (buf, size, "corbaloc:iiop:127.0.0.1:12345/%s", name);
+}
+
+/// Does @a obj have the key @a name?
+bool
+has_key (CORBA::Object_ptr obj, const char *name)
+{
+  const TAO::ObjectKey &key = obj->_stubobj ()->object_key ();
+  size_t const length = ACE_OS::strlen (name);
+
+  return key.length () == length
+    && ACE_OS::memcmp (key.get_buffer (), name, length) == 0;
+}
+
+/// Each thread demarshals references with the keys all threads use,
+/// with keys only it uses, and with keys it drops again right away.
+/// References with the same key must share the key of the table.
+class Demarshal_Task : public ACE_Task_Base
+{
+public:
+  Demarshal_Task (CORBA::ORB_ptr orb,
+                  ACE_Array_Base<CORBA::Object_var> &shared,
+                  ACE_Array_Base<CORBA::Object_var> &distinct)
+    : orb_ (CORBA::ORB::_duplicate (orb))
+    , shared_ (shared)
+    , distinct_ (distinct)
+    , next_ (0)
+    , errors_ (0)
+  {
+  }
+
+  int errors () const
+  {
+    return this->errors_.value ();
+  }
+
+  virtual int svc ()
+  {
+    int const thread = this->next_++;
+
+    try
+      {
+        ACE_Array_Base<CORBA::Object_var> refs (2 * key_count);
+
+        for (int i = 0; i != iterations; ++i)
+          {
+            for (int k = 0; k != key_count; ++k)
+              {
+                int const d = thread * key_count + k;
+
+                refs[k] = this->demarshal (this->shared_[k].in ());
+                refs[key_count + k] = this->demarshal (this->distinct_[d].in ());
+
+                this->check (refs[k].in (), this->shared_[k].in ());
+                this->check (refs[key_count + k].in (), this->distinct_[d].in ());
+              }
+
+            // A key no other reference holds, it leaves the table
+            // when the reference is released.
+            char name[64];
+            ACE_OS::snprintf (name, sizeof name, "transient_%d_%d", thread, i);
+            char loc[128];
+            corbaloc (loc, sizeof loc, name);
+
+            CORBA::Object_var transient =
+              this->orb_->string_to_object (loc);
+
+            if (!has_key (transient.in (), name))
+              {
+                ACE_ERROR ((LM_ERROR,
+                            "(%P|%t) ERROR: wrong key for <%C>\n", name));
+                ++this->errors_;
+              }
+          }
+      }
+    catch (const CORBA::Exception& ex)
+      {
+        ex._tao_print_exception ("Demarshal_Task::svc");
+        ++this->errors_;
+      }
+
+    return 0;
+  }
+
+private:
+  /// Make a new reference to @a obj through its IOR.
+  CORBA::Object_ptr demarshal (CORBA::Object_ptr obj)
+  {
+    CORBA::String_var ior = this->orb_->object_to_string (obj);
+    return this->orb_->string_to_object (ior.in ());
+  }
+
+  /// @a obj has to use the key of @a original.
+  void check (CORBA::Object_ptr obj, CORBA::Object_ptr original)
+  {
+    if (&obj->_stubobj ()->object_key ()
+        != &original->_stubobj ()->object_key ())
+      {
+        ACE_ERROR ((LM_ERROR,
+                    "(%P|%t) ERROR: a reference does not share its key\n"));
+        ++this->errors_;
+      }
+  }
+
+  CORBA::ORB_var orb_;
+  ACE_Array_Base<CORBA::Object_var> &shared_;
+  ACE_Array_Base<CORBA::Object_var> &distinct_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, int> next_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, int> errors_;
+};
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int errors = 0;
+
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      size_t const shards =
+        orb->orb_core ()->object_key_table ().shard_count ();
+
+      if (expected_shards >= 0
+          && shards != static_cast<size_t> (expected_shards))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "(%P|%t) ERROR: %B shards instead of %d\n",
+                             shards, expected_shards),
+                            1);
+        }
+
+      ACE_Array_Base<CORBA::Object_var> shared (key_count);
+      ACE_Array_Base<CORBA::Object_var> distinct (thread_count * key_count);
+
+      char name[64];
+      char loc[128];
+
+      for (int k = 0; k != key_count; ++k)
+        {
+          ACE_OS::snprintf (name, sizeof name, "shared_%d", k);
+          corbaloc (loc, sizeof loc, name);
+          shared[k] = orb->string_to_object (loc);
+        }
+
+      for (int d = 0; d != thread_count * key_count; ++d)
+        {
+          ACE_OS::snprintf (name, sizeof name, "distinct_%d_%d",
+                            d / key_count, d % key_count);
+          corbaloc (loc, sizeof loc, name);
+          distinct[d] = orb->string_to_object (loc);
+        }
+
+      Demarshal_Task task (orb.in (), shared, distinct);
+      if (task.activate (THR_NEW_LWP | THR_JOINABLE, thread_count) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "(%P|%t) ERROR: cannot activate the threads\n"),
+                            1);
+        }
+      task.wait ();
+
+      errors += task.errors ();
+
+      // The keys have to have survived all the threads.
+      for (int k = 0; k != key_count; ++k)
+        {
+          ACE_OS::snprintf (name, sizeof name, "shared_%d", k);
+          if (!has_key (shared[k].in (), name))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "(%P|%t) ERROR: wrong key for <%C>\n", name));
+              ++errors;
+            }
+        }
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "(%P|%t) %d threads demarshaled %d references each "
+                  "using %B shards\n",
+                  thread_count, iterations * (2 * key_count + 1), shards));
+
+      // Keep a few keys in the table until the ORB goes away.
+      for (int d = key_count; d < thread_count * key_count; ++d)
+        {
+          distinct[d] = CORBA::Object::_nil ();
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  if (errors != 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%P|%t) ERROR: %d checks failed\n", errors),
+                        1);
+    }
+
+  return 0;
+}
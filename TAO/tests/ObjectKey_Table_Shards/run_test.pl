@@ -0,0 +1,53 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+
+foreach $i (@ARGV) {
+    if ($i eq '-debug') {
+        $debug_level = '10';
+    }
+}
+
+my $client = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+# The table split into four shards, then the single RB_Tree.
+my @clients_conf = ("shards$PerlACE::svcconf_ext", "");
+my @clients_args = ("-s 4", "-s 0");
+
+for ($i = 0; $i <= $#clients_conf; $i++) {
+    my $conf = "";
+    if ($clients_conf[$i] ne "") {
+        print "========== Client using $clients_conf[$i] =========\n";
+
+        my $client_conf_file = $client->LocalFile ($clients_conf[$i]);
+        if ($client->PutFile ($clients_conf[$i]) == -1) {
+            print STDERR "ERROR: cannot set file <$client_conf_file>\n";
+            $status = 1;
+            next;
+        }
+        $conf = "-ORBSvcConf $client_conf_file";
+    }
+    else {
+        print "========== Client using no shards =========\n";
+    }
+
+    my $CL = $client->CreateProcess ("client", "-ORBdebuglevel $debug_level " .
+                                               "$conf $clients_args[$i]");
+
+    my $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 45);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+}
+
+exit $status;
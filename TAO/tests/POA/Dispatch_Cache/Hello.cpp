@@ -0,0 +1,12 @@
+#include "Hello.h"
+
+Hello::Hello (CORBA::Long id)
+  : id_ (id)
+{
+}
+
+CORBA::Long
+Hello::servant_id ()
+{
+  return this->id_;
+}
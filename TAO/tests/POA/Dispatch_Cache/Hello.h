@@ -0,0 +1,24 @@
+#ifndef HELLO_H
+#define HELLO_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Implement the Test::Hello interface
+class Hello
+  : public virtual POA_Test::Hello
+{
+public:
+  /// Constructor
+  Hello (CORBA::Long id);
+
+  // = The skeleton methods
+  virtual CORBA::Long servant_id ();
+
+private:
+  /// Tells the servants of an object apart.
+  CORBA::Long const id_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* HELLO_H */
@@ -0,0 +1,241 @@
+#include "Hello.h"
+#include "tao/PortableServer/Root_POA.h"
+#include "tao/PortableServer/Object_Adapter.h"
+#include "tao/PortableServer/Dispatch_Cache.h"
+
+static int errors = 0;
+
+/// What call() returns instead of a servant id.
+enum
+{
+  NOT_EXIST = -1,
+  TRANSIENT = -2
+};
+
+/// Call @a hello, returns the id of the servant that handled the
+/// request.
+static CORBA::Long
+call (Test::Hello_ptr hello)
+{
+  try
+    {
+      return hello->servant_id ();
+    }
+  catch (const CORBA::OBJECT_NOT_EXIST &)
+    {
+      return NOT_EXIST;
+    }
+  catch (const CORBA::TRANSIENT &)
+    {
+      return TRANSIENT;
+    }
+}
+
+/// Call @a hello twice, the second call is dispatched through the
+/// cache when the first one added the object to it.
+static void
+expect (Test::Hello_ptr hello, CORBA::Long expected, const char *what)
+{
+  for (int i = 0; i != 2; ++i)
+    {
+      CORBA::Long const id = call (hello);
+      if (id != expected)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %C: call %d got %d instead of %d\n",
+                      what, i + 1, id, expected));
+          ++errors;
+        }
+    }
+}
+
+/// The size of @a cache has to be below @a size.
+static void
+expect_removed (TAO::Portable_Server::Dispatch_Cache &cache,
+                size_t size,
+                const char *what)
+{
+  if (cache.current_size () >= size)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: %C: still %B objects cached\n",
+                  what, cache.current_size ()));
+      ++errors;
+    }
+}
+
+static Test::Hello_ptr
+activate (PortableServer::POA_ptr poa, const char *id, CORBA::Long servant_id)
+{
+  Hello *hello_impl = 0;
+  ACE_NEW_THROW_EX (hello_impl,
+                    Hello (servant_id),
+                    CORBA::NO_MEMORY ());
+  PortableServer::ServantBase_var owner_transfer (hello_impl);
+
+  PortableServer::ObjectId_var oid =
+    PortableServer::string_to_ObjectId (id);
+
+  poa->activate_object_with_id (oid.in (), hello_impl);
+
+  CORBA::Object_var obj = poa->id_to_reference (oid.in ());
+
+  return Test::Hello::_narrow (obj.in ());
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      if (CORBA::is_nil (root_poa.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Panic: nil RootPOA\n"),
+                          1);
+
+      TAO_Root_POA *tao_poa = dynamic_cast<TAO_Root_POA *> (root_poa.in ());
+      TAO::Portable_Server::Dispatch_Cache *cache =
+        tao_poa->object_adapter ().dispatch_cache ();
+
+      if (cache == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) ERROR: no dispatch cache, "
+                           "-ORBPOADispatchCache 1 missing\n"),
+                          1);
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      poa_manager->activate ();
+
+      CORBA::PolicyList policies (2);
+      policies.length (2);
+      policies[0] =
+        root_poa->create_id_assignment_policy (PortableServer::USER_ID);
+      policies[1] =
+        root_poa->create_lifespan_policy (PortableServer::PERSISTENT);
+
+      // deactivate_object() removes the object, a new servant for the
+      // same id handles the following requests.
+      CORBA::PolicyList user_id (1);
+      user_id.length (1);
+      user_id[0] = CORBA::Policy::_duplicate (policies[0]);
+
+      PortableServer::POA_var poa =
+        root_poa->create_POA ("user_id", poa_manager.in (), user_id);
+
+      Test::Hello_var a = activate (poa.in (), "a", 1);
+      expect (a.in (), 1, "first servant of a");
+
+      size_t size = cache->current_size ();
+      if (size == 0)
+        {
+          ACE_ERROR ((LM_ERROR, "(%P|%t) ERROR: a was not cached\n"));
+          ++errors;
+        }
+
+      PortableServer::ObjectId_var oid =
+        PortableServer::string_to_ObjectId ("a");
+      poa->deactivate_object (oid.in ());
+      expect_removed (*cache, size, "a deactivated");
+      expect (a.in (), NOT_EXIST, "a deactivated");
+
+      Test::Hello_var again = activate (poa.in (), "a", 2);
+      expect (a.in (), 2, "second servant of a");
+
+      // Destroying a POA removes its objects.  A persistent POA of
+      // the same name takes over the references.
+      PortableServer::POA_var persistent =
+        root_poa->create_POA ("persistent", poa_manager.in (), policies);
+
+      Test::Hello_var b = activate (persistent.in (), "b", 3);
+      expect (b.in (), 3, "first servant of b");
+
+      size = cache->current_size ();
+      persistent->destroy (false, true);
+      expect_removed (*cache, size, "POA of b destroyed");
+      expect (b.in (), NOT_EXIST, "POA of b destroyed");
+
+      persistent =
+        root_poa->create_POA ("persistent", poa_manager.in (), policies);
+
+      Test::Hello_var b_again = activate (persistent.in (), "b", 4);
+      expect (b.in (), 4, "servant of b in the new POA");
+
+      // The POA manager has to let the requests for cached objects
+      // through in the active state only.
+      PortableServer::POA_var managed =
+        root_poa->create_POA ("managed",
+                              PortableServer::POAManager::_nil (),
+                              user_id);
+
+      PortableServer::POAManager_var manager = managed->the_POAManager ();
+      manager->activate ();
+
+      Test::Hello_var c = activate (managed.in (), "c", 5);
+      expect (c.in (), 5, "c active");
+
+      size = cache->current_size ();
+      manager->hold_requests (false);
+      expect_removed (*cache, size, "c holding");
+      expect (c.in (), TRANSIENT, "c holding");
+      expect (a.in (), 2, "a while c is holding");
+
+      manager->activate ();
+      expect (c.in (), 5, "c active again");
+
+      size = cache->current_size ();
+      manager->discard_requests (false);
+      expect_removed (*cache, size, "c discarding");
+      expect (c.in (), TRANSIENT, "c discarding");
+      expect (b.in (), 4, "b while c is discarding");
+
+      manager->activate ();
+      expect (c.in (), 5, "c active once more");
+
+      size = cache->current_size ();
+      manager->deactivate (false, true);
+      expect_removed (*cache, size, "c inactive");
+      expect (c.in (), NOT_EXIST, "c inactive");
+      expect (a.in (), 2, "a while c is inactive");
+
+      for (CORBA::ULong i = 0; i != policies.length (); ++i)
+        policies[i]->destroy ();
+
+      root_poa->destroy (true, true);
+
+      if (cache->current_size () != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %B objects cached after the RootPOA "
+                      "was destroyed\n",
+                      cache->current_size ()));
+          ++errors;
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  if (errors != 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%P|%t) ERROR: %d checks failed\n", errors),
+                        1);
+    }
+
+  return 0;
+}
@@ -0,0 +1,582 @@
+//=============================================================================
+/**
+ *  @file     Flat_Map.cpp
+ *
+ *   This program tests the Robin Hood map behind the flat demux
+ *   strategies, first directly with keys whose hashes collide, then
+ *   through POAs that activate, deactivate and etherealize many
+ *   objects.
+ */
+//=============================================================================
+
+#include "testS.h"
+#include "tao/PortableServer/Flat_Map_T.h"
+#include "tao/PortableServer/ServantActivatorC.h"
+#include "tao/ORB_Core.h"
+#include "tao/Server_Strategy_Factory.h"
+#include "ace/Array_Base.h"
+#include "ace/Functor_T.h"
+#include "ace/OS_NS_stdio.h"
+
+static int errors = 0;
+
+/// An entry of the maps tested directly, it holds its own key.
+struct Entry
+{
+  ACE_UINT32 key_;
+};
+
+class Entry_Key
+{
+public:
+  const ACE_UINT32 &operator () (Entry *entry) const
+  {
+    return entry->key_;
+  }
+};
+
+/// Gives five hashes, so the keys collide in long runs of slots.
+class Five_Hashes
+{
+public:
+  unsigned long operator () (ACE_UINT32 key) const
+  {
+    return key % 5;
+  }
+};
+
+/// Gives one hash, so all keys probe from the same slot and the run
+/// wraps around the end of the table.
+class One_Hash
+{
+public:
+  unsigned long operator () (ACE_UINT32) const
+  {
+    return 0;
+  }
+};
+
+/// Check that @a map holds the bound entries, and only those, and
+/// that its iterators visit each of them once.
+template <class MAP>
+static void
+check_map (MAP &map,
+           ACE_Array_Base<Entry> &entries,
+           ACE_Array_Base<bool> &bound,
+           const char *what)
+{
+  size_t count = 0;
+
+  for (size_t i = 0; i != entries.size (); ++i)
+    {
+      Entry *found = 0;
+      int const result = map.find (entries[i].key_, found);
+
+      if (bound[i] ? (result != 0 || found != &entries[i]) : result != -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %C: key %u %C\n",
+                      what, entries[i].key_,
+                      bound[i] ? "lost" : "still found"));
+          ++errors;
+        }
+
+      if (bound[i])
+        ++count;
+    }
+
+  if (map.current_size () != count)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: %C: %B entries instead of %B\n",
+                  what, map.current_size (), count));
+      ++errors;
+    }
+
+  // Forward iteration counts one for each entry, reverse two.
+  ACE_Array_Base<int> seen (entries.size (), 0);
+
+  for (typename MAP::iterator iter = map.begin ();
+       iter != map.end ();
+       ++iter)
+    {
+      Entry *entry = (*iter).second ();
+      if ((*iter).first () != entry->key_)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %C: key %u iterated as %u\n",
+                      what, entry->key_, (*iter).first ()));
+          ++errors;
+        }
+      seen[entry - &entries[0]] += 1;
+    }
+
+  for (typename MAP::reverse_iterator iter = map.rbegin ();
+       iter != map.rend ();
+       ++iter)
+    {
+      seen[(*iter).second () - &entries[0]] += 2;
+    }
+
+  for (size_t i = 0; i != entries.size (); ++i)
+    {
+      if (seen[i] != (bound[i] ? 3 : 0))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %C: key %u iterated wrongly (%d)\n",
+                      what, entries[i].key_, seen[i]));
+          ++errors;
+        }
+    }
+}
+
+template <class HASH>
+static void
+test_map (const char *what, ACE_UINT32 count)
+{
+  typedef TAO_Flat_Map<ACE_UINT32,
+                       Entry *,
+                       Entry_Key,
+                       HASH,
+                       ACE_Equal_To<ACE_UINT32>,
+                       ACE_Noop_Key_Generator<ACE_UINT32> > Map;
+
+  // The smallest table, so that it has to grow.
+  Map map (0);
+
+  ACE_Array_Base<Entry> entries (count);
+  ACE_Array_Base<bool> bound (count, false);
+
+  for (ACE_UINT32 i = 0; i != count; ++i)
+    {
+      entries[i].key_ = i * 7 + 3;
+      if (map.bind (entries[i].key_, &entries[i]) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %C: cannot bind key %u\n",
+                      what, entries[i].key_));
+          ++errors;
+        }
+      bound[i] = true;
+    }
+
+  check_map (map, entries, bound, what);
+
+  if (map.bind (entries[0].key_, &entries[0]) != 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: %C: key bound twice\n", what));
+      ++errors;
+    }
+
+  if (map.bind (entries[0].key_, &entries[1]) != -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: %C: bound with the key of another "
+                  "entry\n", what));
+      ++errors;
+    }
+
+  // Remove every third entry, then the one after each, so that the
+  // runs of colliding keys shift back over the freed slots.
+  for (ACE_UINT32 first = 0; first != 2; ++first)
+    {
+      for (ACE_UINT32 i = first; i < count; i += 3)
+        {
+          Entry *entry = 0;
+          if (map.unbind (entries[i].key_, entry) != 0
+              || entry != &entries[i])
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "(%P|%t) ERROR: %C: cannot unbind key %u\n",
+                          what, entries[i].key_));
+              ++errors;
+            }
+          bound[i] = false;
+          check_map (map, entries, bound, what);
+        }
+    }
+
+  // The holes are filled again.
+  for (ACE_UINT32 i = 0; i < count; i += 3)
+    {
+      if (map.bind (entries[i].key_, &entries[i]) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %C: cannot bind key %u again\n",
+                      what, entries[i].key_));
+          ++errors;
+        }
+      bound[i] = true;
+    }
+
+  check_map (map, entries, bound, what);
+
+  // Bind and unbind keys in a fixed pseudo random order.
+  ACE_UINT32 seed = 1;
+  for (ACE_UINT32 n = 0; n != count * 4; ++n)
+    {
+      seed = seed * 1103515245 + 12345;
+      ACE_UINT32 const i = (seed >> 16) % count;
+
+      int const result = bound[i]
+        ? map.unbind (entries[i].key_)
+        : map.bind (entries[i].key_, &entries[i]);
+
+      if (result != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %C: cannot %C key %u\n",
+                      what, bound[i] ? "unbind" : "bind",
+                      entries[i].key_));
+          ++errors;
+        }
+      bound[i] = !bound[i];
+
+      if (n % 16 == 0)
+        check_map (map, entries, bound, what);
+    }
+
+  for (ACE_UINT32 i = 0; i != count; ++i)
+    {
+      if (bound[i])
+        map.unbind (entries[i].key_);
+      bound[i] = false;
+    }
+
+  check_map (map, entries, bound, what);
+}
+
+class test_i : public POA_test
+{
+public:
+  test_i (CORBA::ULong number)
+    : number_ (number)
+  {
+  }
+
+  void method ()
+  {
+  }
+
+  CORBA::ULong number () const
+  {
+    return this->number_;
+  }
+
+  PortableServer::ObjectId id_;
+
+private:
+  CORBA::ULong const number_;
+};
+
+/// Counts how often each servant is etherealized.
+class Servant_Activator : public PortableServer::ServantActivator
+{
+public:
+  Servant_Activator (CORBA::ULong servants)
+    : etherealized_ (servants, 0)
+    , cleanups_ (0)
+  {
+  }
+
+  PortableServer::Servant incarnate (const PortableServer::ObjectId &,
+                                     PortableServer::POA_ptr)
+  {
+    throw CORBA::OBJECT_NOT_EXIST ();
+  }
+
+  void etherealize (const PortableServer::ObjectId &oid,
+                    PortableServer::POA_ptr,
+                    PortableServer::Servant servant,
+                    CORBA::Boolean cleanup_in_progress,
+                    CORBA::Boolean)
+  {
+    test_i *test = dynamic_cast<test_i *> (servant);
+
+    if (!(oid == test->id_))
+      {
+        ACE_ERROR ((LM_ERROR,
+                    "(%P|%t) ERROR: servant %u etherealized for the "
+                    "wrong id\n",
+                    test->number ()));
+        ++errors;
+      }
+
+    ++this->etherealized_[test->number ()];
+    if (cleanup_in_progress)
+      ++this->cleanups_;
+
+    servant->_remove_ref ();
+  }
+
+  int etherealized (CORBA::ULong number) const
+  {
+    return this->etherealized_[number];
+  }
+
+  CORBA::ULong cleanups () const
+  {
+    return this->cleanups_;
+  }
+
+private:
+  ACE_Array_Base<int> etherealized_;
+  CORBA::ULong cleanups_;
+};
+
+static CORBA::ULong const object_count = 1000;
+static CORBA::ULong const rounds = 4;
+
+/// Objects are activated in each round, plus the initial ones, in
+/// two POAs.
+static CORBA::ULong const servant_count = 2 * object_count * (rounds + 1);
+
+static CORBA::ULong next_servant = 0;
+
+/// Activate object @a index in @a poa, with the index as its id when
+/// @a user_id.
+static test_i *
+activate (PortableServer::POA_ptr poa, CORBA::ULong index, bool user_id)
+{
+  test_i *servant = 0;
+  ACE_NEW_THROW_EX (servant,
+                    test_i (next_servant++),
+                    CORBA::NO_MEMORY ());
+  PortableServer::ServantBase_var owner_transfer (servant);
+
+  if (user_id)
+    {
+      char name[16];
+      ACE_OS::snprintf (name, sizeof name, "%u", index);
+
+      PortableServer::ObjectId_var oid =
+        PortableServer::string_to_ObjectId (name);
+      servant->id_ = oid.in ();
+      poa->activate_object_with_id (oid.in (), servant);
+    }
+  else
+    {
+      PortableServer::ObjectId_var oid = poa->activate_object (servant);
+      servant->id_ = oid.in ();
+    }
+
+  return servant;
+}
+
+/// Check that @a poa finds the active objects by id and by servant,
+/// and no others.
+static void
+check_objects (PortableServer::POA_ptr poa,
+               ACE_Array_Base<test_i *> &active,
+               ACE_Array_Base<PortableServer::ObjectId> &ids,
+               const char *what)
+{
+  for (CORBA::ULong i = 0; i != object_count; ++i)
+    {
+      try
+        {
+          PortableServer::ServantBase_var servant =
+            poa->id_to_servant (ids[i]);
+
+          if (active[i] == 0 || servant.in () != active[i])
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "(%P|%t) ERROR: %C: wrong servant for object %u\n",
+                          what, i));
+              ++errors;
+            }
+        }
+      catch (const PortableServer::POA::ObjectNotActive &)
+        {
+          if (active[i] != 0)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "(%P|%t) ERROR: %C: object %u lost\n",
+                          what, i));
+              ++errors;
+            }
+        }
+
+      if (active[i] == 0)
+        continue;
+
+      PortableServer::ObjectId_var oid = poa->servant_to_id (active[i]);
+      if (!(oid.in () == ids[i]))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %C: wrong id for the servant of "
+                      "object %u\n",
+                      what, i));
+          ++errors;
+        }
+    }
+}
+
+/// Activate and deactivate many objects in @a poa, then destroy it.
+static void
+test_poa (PortableServer::POA_ptr poa,
+          Servant_Activator &activator,
+          bool user_id,
+          const char *what)
+{
+  ACE_Array_Base<test_i *> active (object_count, static_cast<test_i *> (0));
+  ACE_Array_Base<PortableServer::ObjectId> ids (object_count);
+
+  for (CORBA::ULong round = 0; round != rounds; ++round)
+    {
+      for (CORBA::ULong i = 0; i != object_count; ++i)
+        {
+          if (active[i] == 0)
+            {
+              active[i] = activate (poa, i, user_id);
+              ids[i] = active[i]->id_;
+            }
+        }
+
+      check_objects (poa, active, ids, what);
+
+      // Deactivate objects next to each other, a different set each
+      // round, so that removals shift the runs after them back.
+      for (CORBA::ULong i = round; i < object_count; i += round + 2)
+        {
+          for (CORBA::ULong k = i; k != i + 2 && k != object_count; ++k)
+            {
+              if (active[k] == 0)
+                continue;
+
+              CORBA::ULong const number = active[k]->number ();
+              poa->deactivate_object (ids[k]);
+              active[k] = 0;
+
+              if (activator.etherealized (number) != 1)
+                {
+                  ACE_ERROR ((LM_ERROR,
+                              "(%P|%t) ERROR: %C: servant %u of object %u "
+                              "etherealized %d times\n",
+                              what, number, k,
+                              activator.etherealized (number)));
+                  ++errors;
+                }
+            }
+        }
+
+      check_objects (poa, active, ids, what);
+    }
+
+  // Destruction iterates over the map to etherealize each of the
+  // remaining objects once.
+  CORBA::ULong remaining = 0;
+  for (CORBA::ULong i = 0; i != object_count; ++i)
+    {
+      if (active[i] != 0)
+        ++remaining;
+    }
+
+  CORBA::ULong const cleanups = activator.cleanups ();
+
+  poa->destroy (true, true);
+
+  if (activator.cleanups () - cleanups != remaining)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: %C: %u objects etherealized by destroy, "
+                  "%u were active\n",
+                  what, activator.cleanups () - cleanups, remaining));
+      ++errors;
+    }
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  test_map<Five_Hashes> ("five hashes", 500);
+  test_map<One_Hash> ("one hash", 100);
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      const TAO_Server_Strategy_Factory::Active_Object_Map_Creation_Parameters &
+        parameters =
+          orb->orb_core ()->server_factory ()->active_object_map_creation_parameters ();
+
+      if (parameters.object_lookup_strategy_for_user_id_policy_ != TAO_FLAT_HASH
+          || parameters.object_lookup_strategy_for_system_id_policy_ != TAO_FLAT_HASH
+          || parameters.reverse_object_lookup_strategy_for_unique_id_policy_ != TAO_FLAT_HASH)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "(%P|%t) ERROR: the flat demux strategies "
+                             "are not set\n"),
+                            1);
+        }
+
+      CORBA::Object_var object =
+        orb->resolve_initial_references ("RootPOA");
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (object.in ());
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      poa_manager->activate ();
+
+      Servant_Activator activator (servant_count);
+
+      CORBA::PolicyList policies (2);
+      policies.length (2);
+      policies[0] =
+        root_poa->create_request_processing_policy (PortableServer::USE_SERVANT_MANAGER);
+      policies[1] =
+        root_poa->create_id_assignment_policy (PortableServer::USER_ID);
+
+      PortableServer::POA_var user_id_poa =
+        root_poa->create_POA ("user_id", poa_manager.in (), policies);
+      user_id_poa->set_servant_manager (&activator);
+
+      test_poa (user_id_poa.in (), activator, true, "user id");
+
+      policies[1]->destroy ();
+      policies.length (1);
+
+      PortableServer::POA_var system_id_poa =
+        root_poa->create_POA ("system_id", poa_manager.in (), policies);
+      system_id_poa->set_servant_manager (&activator);
+
+      test_poa (system_id_poa.in (), activator, false, "system id");
+
+      // Every servant is etherealized once, by deactivate_object() or
+      // by destroy().
+      for (CORBA::ULong i = 0; i != next_servant; ++i)
+        {
+          if (activator.etherealized (i) != 1)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "(%P|%t) ERROR: servant %u etherealized %d times\n",
+                          i, activator.etherealized (i)));
+              ++errors;
+            }
+        }
+
+      policies[0]->destroy ();
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  if (errors != 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%P|%t) ERROR: %d checks failed\n", errors),
+                        1);
+    }
+
+  return 0;
+}
@@ -0,0 +1,360 @@
+#include "ace/Get_Opt.h"
+#include "ace/Event_Handler.h"
+#include "ace/Reactor.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_strings.h"
+#include "tao/ORB.h"
+#include "tao/Leader_Follower.h"
+#include "tao/Thread_Lane_Resources.h"
+#include "tao/RTCORBA/RTCORBA.h"
+#include "tao/RTCORBA/RT_ORB.h"
+#include "tao/RTCORBA/Thread_Pool.h"
+#include "../check_supported_priorities.cpp"
+
+static const char *spec = 0;
+static RTCORBA::Priority default_thread_priority;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("c:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'c':
+        spec = ACE_TEXT_ALWAYS_CHAR (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-c <the -RTORBLaneCPUs of the svc.conf> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (spec == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, "(%P|%t) ERROR: no -c given\n"), -1);
+
+  return 0;
+}
+
+#if defined (ACE_HAS_CPU_SET_T)
+
+/// The handle that ACE_OS::thr_get_affinity() takes for the calling
+/// thread.
+static ACE_hthread_t
+self ()
+{
+#if defined (ACE_HAS_PTHREAD_SETAFFINITY_NP)
+  ACE_hthread_t thread;
+  ACE_OS::thr_self (thread);
+  return thread;
+#else
+  return 0;
+#endif /* ACE_HAS_PTHREAD_SETAFFINITY_NP */
+}
+
+/// Parse a list like "0-3,8" up to a colon or the end of the line.
+static bool
+parse_list (const char *&p, cpu_set_t &set)
+{
+  CPU_ZERO (&set);
+  bool empty = true;
+
+  while (*p != '\0' && *p != ':' && *p != '\n')
+    {
+      char *end = 0;
+      unsigned long const first = ACE_OS::strtoul (p, &end, 10);
+      unsigned long last = first;
+      if (end == p)
+        return false;
+      p = end;
+      if (*p == '-')
+        {
+          last = ACE_OS::strtoul (p + 1, &end, 10);
+          p = end;
+        }
+      if (last >= CPU_SETSIZE)
+        return false;
+      for (unsigned long cpu = first; cpu <= last; ++cpu)
+        CPU_SET (cpu, &set);
+      empty = false;
+      if (*p == ',')
+        ++p;
+    }
+
+  if (*p == ':')
+    ++p;
+
+  return !empty;
+}
+
+/// Read the list in the sysfs file @a path.
+static bool
+read_list (const char *path, cpu_set_t &set)
+{
+  FILE *file = ACE_OS::fopen (path, "r");
+  if (file == 0)
+    return false;
+
+  char line[4096];
+  const char *p = ACE_OS::fgets (line, sizeof line, file);
+  ACE_OS::fclose (file);
+
+  return p != 0 && parse_list (p, set);
+}
+
+/// The CPU sets the lanes should take in turn.
+static ACE_Array_Base<cpu_set_t> sets;
+
+static int
+expected_sets ()
+{
+  cpu_set_t set;
+
+  if (ACE_OS::strcasecmp (spec, "numa") == 0)
+    {
+      cpu_set_t nodes;
+      if (!read_list ("/sys/devices/system/node/online", nodes))
+        return 0;
+
+      for (unsigned int node = 0; node != CPU_SETSIZE; ++node)
+        {
+          char path[64];
+          ACE_OS::snprintf (path, sizeof path,
+                            "/sys/devices/system/node/node%u/cpulist",
+                            node);
+          if (CPU_ISSET (node, &nodes) && read_list (path, set))
+            {
+              sets.size (sets.size () + 1);
+              sets[sets.size () - 1] = set;
+            }
+        }
+    }
+  else
+    {
+      for (const char *p = spec; *p != '\0'; )
+        {
+          if (!parse_list (p, set))
+            return -1;
+          sets.size (sets.size () + 1);
+          sets[sets.size () - 1] = set;
+        }
+    }
+
+  return 0;
+}
+
+/// Notified through the reactor of a lane, records the CPUs of the
+/// lane thread that handles the notification.
+class Affinity_Check : public ACE_Event_Handler
+{
+public:
+  Affinity_Check ()
+    : cond_ (lock_)
+    , done_ (false)
+    , result_ (-1)
+  {
+    CPU_ZERO (&this->cpus_);
+  }
+
+  virtual int handle_exception (ACE_HANDLE)
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, -1);
+    this->result_ = ACE_OS::thr_get_affinity (self (),
+                                              sizeof this->cpus_,
+                                              &this->cpus_);
+    this->done_ = true;
+    this->cond_.signal ();
+    return 0;
+  }
+
+  /// Wait for a lane thread, returns -1 if none came or it did not
+  /// know its CPUs.
+  int wait (cpu_set_t &cpus)
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, -1);
+    ACE_Time_Value const deadline = ACE_OS::gettimeofday () + ACE_Time_Value (10);
+    while (!this->done_)
+      if (this->cond_.wait (&deadline) == -1)
+        return -1;
+    cpus = this->cpus_;
+    return this->result_;
+  }
+
+private:
+  TAO_SYNCH_MUTEX lock_;
+  TAO_SYNCH_CONDITION cond_;
+  bool done_;
+  int result_;
+  cpu_set_t cpus_;
+};
+
+/// Check that the threads of the lanes of pool @a id run on their
+/// CPUs, the lanes before them took the first @a lane_count sets.
+static int
+check_pool (TAO_Thread_Pool_Manager &manager,
+            RTCORBA::ThreadpoolId id,
+            cpu_set_t const &process_cpus,
+            size_t &lane_count)
+{
+  int errors = 0;
+  TAO_Thread_Pool *pool = manager.get_threadpool (id);
+
+  for (CORBA::ULong i = 0; i != pool->number_of_lanes (); ++i, ++lane_count)
+    {
+      TAO_Thread_Lane *lane = pool->lanes ()[i];
+
+      cpu_set_t expected = process_cpus;
+      if (sets.size () != 0)
+        expected = sets[lane_count % sets.size ()];
+
+      Affinity_Check check;
+      cpu_set_t cpus;
+      if (lane->resources ().leader_follower ().reactor ()->notify (&check) == -1
+          || check.wait (cpus) == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: no CPUs for lane %u of pool %u\n",
+                      i, id));
+          ++errors;
+        }
+      else if (!CPU_EQUAL (&cpus, &expected))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: lane %u of pool %u runs on %d CPUs, "
+                      "not on the %d of set %B\n",
+                      i, id, CPU_COUNT (&cpus), CPU_COUNT (&expected),
+                      sets.size () == 0 ? 0 : lane_count % sets.size ()));
+          ++errors;
+        }
+    }
+
+  return errors;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int errors = 0;
+
+  try
+    {
+      cpu_set_t process_cpus;
+      if (ACE_OS::thr_get_affinity (self (),
+                                    sizeof process_cpus,
+                                    &process_cpus) == -1)
+        {
+          ACE_DEBUG ((LM_DEBUG,
+                      "(%P|%t) Cannot get the thread affinity, "
+                      "test skipped\n"));
+          return 0;
+        }
+
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc,
+                         argv);
+
+      CORBA::Object_var object =
+        orb->resolve_initial_references ("RTORB");
+
+      RTCORBA::RTORB_var rt_orb =
+        RTCORBA::RTORB::_narrow (object.in ());
+
+      default_thread_priority =
+        get_implicit_thread_CORBA_priority (orb.in ());
+
+      int result =
+        parse_args (argc, argv);
+      if (result != 0)
+        return result;
+
+      if (expected_sets () != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) ERROR: bad CPU list <%C>\n", spec),
+                          1);
+
+      for (size_t i = 0; i != sets.size (); ++i)
+        {
+          cpu_set_t both;
+          CPU_AND (&both, &sets[i], &process_cpus);
+          if (!CPU_EQUAL (&both, &sets[i]))
+            {
+              ACE_DEBUG ((LM_DEBUG,
+                          "(%P|%t) Set %B has CPUs the test may not use, "
+                          "test skipped\n",
+                          i));
+              orb->destroy ();
+              return 0;
+            }
+        }
+
+      // Three lanes take the sets in turn, then a pool without lanes
+      // takes the next one.
+      RTCORBA::ThreadpoolLanes lanes (3);
+      lanes.length (3);
+
+      for (CORBA::ULong i = 0; i != lanes.length (); ++i)
+        {
+          lanes[i].lane_priority = default_thread_priority;
+          lanes[i].static_threads = 1;
+          lanes[i].dynamic_threads = 0;
+        }
+
+      RTCORBA::ThreadpoolId const with_lanes =
+        rt_orb->create_threadpool_with_lanes (0, lanes, 0, 0, 0, 0);
+
+      RTCORBA::ThreadpoolId const without_lanes =
+        rt_orb->create_threadpool (0, 2, 0, default_thread_priority, 0, 0, 0);
+
+      TAO_RT_ORB *tao_rt_orb = dynamic_cast<TAO_RT_ORB *> (rt_orb.in ());
+      TAO_Thread_Pool_Manager &manager = tao_rt_orb->tp_manager ();
+
+      size_t lane_count = 0;
+      errors += check_pool (manager, with_lanes, process_cpus, lane_count);
+      errors += check_pool (manager, without_lanes, process_cpus, lane_count);
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "(%P|%t) Checked %B lanes with <%C>, %B CPU sets\n",
+                  lane_count, spec, sets.size ()));
+
+      rt_orb->destroy_threadpool (with_lanes);
+      rt_orb->destroy_threadpool (without_lanes);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return -1;
+    }
+
+  if (errors != 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%P|%t) ERROR: %d checks failed\n", errors),
+                        1);
+    }
+
+  return 0;
+}
+
+#else
+
+int
+ACE_TMAIN(int, ACE_TCHAR *[])
+{
+  ACE_DEBUG ((LM_DEBUG,
+              "(%P|%t) No CPU sets on this platform, test skipped\n"));
+  return 0;
+}
+
+#endif /* ACE_HAS_CPU_SET_T */
@@ -0,0 +1,40 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+$status = 0;
+
+print STDERR "\n********** RTCORBA Lane_CPUs Unit Test **********\n\n";
+
+# Each configuration with the -RTORBLaneCPUs it sets.
+my %configurations = ("lanes" => "0:1",
+                      "numa" => "numa");
+
+foreach $conf (sort keys %configurations) {
+    my $conf_file = $server->LocalFile ("$conf$PerlACE::svcconf_ext");
+    if ($server->PutFile ("$conf$PerlACE::svcconf_ext") == -1) {
+        print STDERR "ERROR: cannot set file <$conf_file>\n";
+        $status = 1;
+        next;
+    }
+
+    $SV = $server->CreateProcess ("Lane_CPUs",
+                                  "-ORBSvcConf $conf_file " .
+                                  "-c $configurations{$conf}");
+
+    $server_status = $SV->SpawnWaitKill ($server->ProcessStartWaitInterval());
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: test with $conf returned $server_status\n";
+        $status = 1;
+    }
+}
+
+exit $status;
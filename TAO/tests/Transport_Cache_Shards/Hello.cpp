@@ -0,0 +1,19 @@
+#include "Hello.h"
+
+Hello::Hello (CORBA::ORB_ptr orb, CORBA::Long id)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+  , id_ (id)
+{
+}
+
+CORBA::Long
+Hello::server_id ()
+{
+  return this->id_;
+}
+
+void
+Hello::shutdown ()
+{
+  this->orb_->shutdown (false);
+}
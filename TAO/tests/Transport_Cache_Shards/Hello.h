@@ -0,0 +1,29 @@
+#ifndef HELLO_H
+#define HELLO_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+/// Implement the Test::Hello interface
+class Hello
+  : public virtual POA_Test::Hello
+{
+public:
+  /// Constructor
+  Hello (CORBA::ORB_ptr orb, CORBA::Long id);
+
+  // = The skeleton methods
+  virtual CORBA::Long server_id ();
+
+  virtual void shutdown ();
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+
+  /// The number the server was started with.
+  CORBA::Long id_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* HELLO_H */
@@ -0,0 +1,292 @@
+#include "TestC.h"
+#include "tao/ORB_Core.h"
+#include "tao/Thread_Lane_Resources.h"
+#include "tao/Transport_Cache_Manager.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/Vector_T.h"
+#include "ace/Array_Base.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_stdlib.h"
+
+ACE_Vector<const ACE_TCHAR *> iors;
+int thread_count = 4;
+int iterations = 50;
+size_t expected_shards = 0;
+size_t cache_maximum = 0;
+bool shutdown_servers = false;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:t:i:s:m:x"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        iors.push_back (get_opts.opt_arg ());
+        break;
+      case 't':
+        thread_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 's':
+        expected_shards = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'm':
+        cache_maximum = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+      case 'x':
+        shutdown_servers = true;
+        break;
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> [-k <ior> ...] "
+                           "-t <threads> "
+                           "-i <iterations> "
+                           "-s <expected shards> "
+                           "-m <cache maximum, the cache is purged> "
+                           "-x"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (iors.size () == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, "(%P|%t) ERROR: no server given\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Each thread calls every server in turn, starting from a different
+/// one, so that the threads look up different transports at the same
+/// time.
+class Client_Task : public ACE_Task_Base
+{
+public:
+  Client_Task (ACE_Array_Base<Test::Hello_var> &servers)
+    : servers_ (servers)
+    , next_ (0)
+    , errors_ (0)
+  {
+  }
+
+  int errors () const
+  {
+    return this->errors_.value ();
+  }
+
+  virtual int svc ()
+  {
+    size_t const count = this->servers_.size ();
+    size_t const first = this->next_++;
+
+    try
+      {
+        for (int i = 0; i != iterations; ++i)
+          {
+            for (size_t k = 0; k != count; ++k)
+              {
+                size_t const s = (first + k) % count;
+                CORBA::Long const id = this->servers_[s]->server_id ();
+                if (id != static_cast<CORBA::Long> (s))
+                  {
+                    ACE_ERROR ((LM_ERROR,
+                                "(%P|%t) ERROR: server %d answered as %d\n",
+                                static_cast<int> (s), id));
+                    ++this->errors_;
+                  }
+              }
+          }
+      }
+    catch (const CORBA::Exception& ex)
+      {
+        ex._tao_print_exception ("Client_Task::svc");
+        ++this->errors_;
+      }
+
+    return 0;
+  }
+
+private:
+  ACE_Array_Base<Test::Hello_var> &servers_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, size_t> next_;
+  ACE_Atomic_Op<TAO_SYNCH_MUTEX, int> errors_;
+};
+
+/// Check the counters of the shards of @a cache against what the
+/// threads did.  Returns the number of failed checks.
+int
+check_cache (TAO::Transport_Cache_Manager &cache, size_t server_count)
+{
+  int errors = 0;
+
+  size_t const shards = cache.shard_count ();
+  if (expected_shards != 0 && shards != expected_shards)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: %B shards instead of %B\n",
+                  shards, expected_shards));
+      ++errors;
+    }
+
+  TAO::Transport_Cache_Manager::Shard_Statistics stats;
+  size_t size = 0;
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t used = 0;
+
+  for (size_t i = 0; i != shards; ++i)
+    {
+      if (cache.shard_statistics (i, stats) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: no statistics for shard %B\n", i));
+          ++errors;
+          continue;
+        }
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "(%P|%t) shard %B: %B transports, %B hits, %B misses, "
+                  "%B contended\n",
+                  i, stats.size, stats.hits, stats.misses, stats.contended));
+
+      size += stats.size;
+      hits += stats.hits;
+      misses += stats.misses;
+      if (stats.hits + stats.misses != 0)
+        ++used;
+    }
+
+  if (cache.shard_statistics (shards, stats) != -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: statistics for shard %B of %B\n",
+                  shards, shards));
+      ++errors;
+    }
+
+  if (size != cache.current_size ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: the shards hold %B transports, "
+                  "the cache %B\n",
+                  size, cache.current_size ()));
+      ++errors;
+    }
+
+  if (hits == 0)
+    {
+      ACE_ERROR ((LM_ERROR, "(%P|%t) ERROR: no transport was reused\n"));
+      ++errors;
+    }
+
+  if (shards > 1 && used < 2)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) ERROR: %B servers in a single shard\n",
+                  server_count));
+      ++errors;
+    }
+
+  if (cache_maximum != 0)
+    {
+      if (cache.current_size () > cache_maximum)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %B transports cached, at most %B "
+                      "expected\n",
+                      cache.current_size (), cache_maximum));
+          ++errors;
+        }
+
+      // A purged transport is missed when its server is called again.
+      if (misses <= server_count)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "(%P|%t) ERROR: %B misses for %B servers, "
+                      "nothing was purged\n",
+                      misses, server_count));
+          ++errors;
+        }
+    }
+
+  return errors;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int errors = 0;
+
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      ACE_Array_Base<Test::Hello_var> servers (iors.size ());
+      for (size_t i = 0; i != iors.size (); ++i)
+        {
+          CORBA::Object_var tmp =
+            orb->string_to_object (iors[i]);
+
+          servers[i] = Test::Hello::_narrow (tmp.in ());
+
+          if (CORBA::is_nil (servers[i].in ()))
+            {
+              ACE_ERROR_RETURN ((LM_DEBUG,
+                                 "Nil Test::Hello reference <%s>\n",
+                                 iors[i]),
+                                1);
+            }
+        }
+
+      Client_Task task (servers);
+      if (task.activate (THR_NEW_LWP | THR_JOINABLE, thread_count) == -1)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "(%P|%t) ERROR: cannot activate the client "
+                             "threads\n"),
+                            1);
+        }
+      task.wait ();
+
+      errors += task.errors ();
+      errors += check_cache (orb->orb_core ()->lane_resources ().transport_cache (),
+                             servers.size ());
+
+      if (shutdown_servers)
+        {
+          for (size_t i = 0; i != servers.size (); ++i)
+            {
+              servers[i]->shutdown ();
+            }
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  if (errors != 0)
+    {
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "(%P|%t) ERROR: %d checks failed\n", errors),
+                        1);
+    }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+
+foreach $i (@ARGV) {
+    if ($i eq '-debug') {
+        $debug_level = '10';
+    }
+}
+
+#constants
+my $iorbase = "server.ior";
+my $server_count = 8;
+
+# The client configurations and the options checking them: four
+# shards, then four shards holding at most 8 transports, as many as the
+# client threads may keep busy and connecting at once.
+my @clients_conf = ("client$PerlACE::svcconf_ext",
+                    "client.purge$PerlACE::svcconf_ext");
+my @clients_args = ("-s 4",
+                    "-s 4 -m 8");
+
+my @servers = ();
+for ($i = 0; $i < $server_count; $i++) {
+    $servers[$i] = PerlACE::TestTarget::create_target ($i + 1) || die "Create target $i+1 failed\n";
+}
+
+my $client = PerlACE::TestTarget::create_target ($server_count + 1) || die "Create target client failed\n";
+
+my @servers_iorfile = ();
+my @clients_iorfile = ();
+my @SVS = ();
+
+for ($i = 0; $i < $server_count; $i++) {
+    $servers_iorfile[$i] = $servers[$i]->LocalFile ("$iorbase.$i");
+    $clients_iorfile[$i] = $client->LocalFile ("$iorbase.$i");
+    $servers[$i]->DeleteFile ("$iorbase.$i");
+    $client->DeleteFile ("$iorbase.$i");
+
+    $SVS[$i] = $servers[$i]->CreateProcess ("server", "-ORBdebuglevel $debug_level " .
+                                                      "-o $servers_iorfile[$i] -n $i");
+
+    my $server_status = $SVS[$i]->Spawn ();
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server Spawn $i returned $server_status\n";
+    }
+    elsif ($servers[$i]->WaitForFileTimed ("$iorbase.$i",
+                                           $servers[$i]->ProcessStartWaitInterval()) == -1) {
+        print STDERR "ERROR: server $i cannot find file <$servers_iorfile[$i]>\n";
+        $server_status = 1;
+    }
+    elsif ($servers[$i]->GetFile ("$iorbase.$i") == -1
+           || $client->PutFile ("$iorbase.$i") == -1) {
+        print STDERR "ERROR: cannot copy file <$servers_iorfile[$i]>\n";
+        $server_status = 1;
+    }
+
+    if ($server_status != 0) {
+        for ($j = 0; $j <= $i; $j++) {
+            $SVS[$j]->Kill (); $SVS[$j]->TimedWait (1);
+        }
+        exit 1;
+    }
+}
+
+my $iors = join (' ', map { "-k file://$_" } @clients_iorfile);
+
+for ($i = 0; $i <= $#clients_conf; $i++) {
+    print "========== Client using $clients_conf[$i] =========\n";
+
+    my $client_conf_file = $client->LocalFile ($clients_conf[$i]);
+    if ($client->PutFile ($clients_conf[$i]) == -1) {
+        print STDERR "ERROR: cannot set file <$client_conf_file>\n";
+        $status = 1;
+        next;
+    }
+
+    my $shutdown = $i == $#clients_conf ? "-x" : "";
+    my $CL = $client->CreateProcess ("client", "-ORBdebuglevel $debug_level " .
+                                               "-ORBSvcConf $client_conf_file " .
+                                               "$iors $clients_args[$i] $shutdown");
+
+    my $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 45);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+}
+
+for ($i = 0; $i < $server_count; $i++) {
+    my $server_status = $SVS[$i]->WaitKill ($servers[$i]->ProcessStopWaitInterval());
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server $i returned $server_status\n";
+        $status = 1;
+    }
+
+    $servers[$i]->DeleteFile ("$iorbase.$i");
+    $client->DeleteFile ("$iorbase.$i");
+}
+
+exit $status;